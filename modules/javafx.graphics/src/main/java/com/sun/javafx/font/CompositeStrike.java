@@ -25,6 +25,7 @@
 
 package com.sun.javafx.font;
 
+import java.util.BitSet;
 import com.sun.javafx.scene.text.GlyphList;
 import com.sun.javafx.geom.transform.Affine2D;
 import com.sun.javafx.geom.transform.BaseTransform;
@@ -174,6 +175,24 @@ public class CompositeStrike implements FontStrike {
         return getStrikeSlot(slot).getGlyph(slotglyphCode);
     }
 
+    @Override
+    public void prepareGlyphs(int[] glyphCodes, int count) {
+        int[] slotCodes = new int[count];
+        BitSet slots = new BitSet();
+        for (int i = 0; i < count; i++) {
+            int slot = (glyphCodes[i] >>> 24);
+            if (slots.get(slot)) continue;
+            slots.set(slot);
+            int n = 0;
+            for (int j = i; j < count; j++) {
+                if ((glyphCodes[j] >>> 24) == slot) {
+                    slotCodes[n++] = glyphCodes[j] & CompositeGlyphMapper.GLYPHMASK;
+                }
+            }
+            getStrikeSlot(slot).prepareGlyphs(slotCodes, n);
+        }
+    }
+
      /**
      * Access to individual character advances are frequently needed for layout
      * understand that advance may vary for single glyph if ligatures or kerning
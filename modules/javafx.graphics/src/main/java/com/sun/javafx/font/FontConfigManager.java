@@ -42,6 +42,7 @@ public class FontConfigManager {
     static boolean useFontConfig = true;
     static boolean fontConfigFailed = false;
     static boolean useEmbeddedFontSupport = false;
+    static String fontCacheFile = null;
 
     static {
         @SuppressWarnings("removal")
@@ -53,6 +54,10 @@ public class FontConfigManager {
                     useFontConfig = "true".equals(ufc);
                     String emb = System.getProperty("prism.embeddedfonts", "");
                     useEmbeddedFontSupport = "true".equals(emb);
+                    String cache = System.getProperty("prism.fontconfigCache", "true");
+                    if ("true".equals(cache)) {
+                        fontCacheFile = getFontCacheFile();
+                    }
                     return null;
                 }
         );
@@ -224,11 +229,33 @@ public class FontConfigManager {
         }
     }
 
+    /*
+     * The fonts found by fontconfig are cached in this file, so that
+     * startup does not enumerate all installed fonts again unless the
+     * fontconfig configuration or caches, or any directory under the
+     * standard font directories, have changed. Fonts in directories that
+     * the configuration adds elsewhere are only picked up once fc-cache
+     * has run, or with -Dprism.fontconfigCache=false.
+     * The directory is created by the native code when the cache is
+     * written, so applications that never enumerate the fontconfig fonts
+     * leave nothing behind.
+     */
+    private static String getFontCacheFile() {
+        String home = System.getProperty("user.home");
+        if (home == null) {
+            return null;
+        }
+        File dir = new File(home, ".openjfx/cache/fontconfig");
+        String arch = System.getProperty("os.arch");
+        return new File(dir, "fonts-" + arch + ".cache").getPath();
+    }
+
     private static native boolean populateMapsNative
         (HashMap<String,String> fontToFileMap,
          HashMap<String,String> fontToFamilyNameMap,
          HashMap<String,ArrayList<String>> familyToFontListMap,
-         Locale locale);
+         Locale locale,
+         String cacheFile);
 
     public static void populateMaps
         (HashMap<String,String> fontToFileMap,
@@ -239,7 +266,7 @@ public class FontConfigManager {
         boolean pnm = false;
         if (useFontConfig && !fontConfigFailed) {
             pnm = populateMapsNative(fontToFileMap, fontToFamilyNameMap,
-                                familyToFontListMap, locale);
+                                familyToFontListMap, locale, fontCacheFile);
 
         }
 
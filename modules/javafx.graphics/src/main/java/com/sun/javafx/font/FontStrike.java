@@ -54,4 +54,12 @@ public interface FontStrike {
     public float getCharAdvance(char ch);
     public Shape getOutline(GlyphList gl,
                             BaseTransform transform);
+
+    /**
+     * Tells the strike that the glyphs with the given codes are about to be
+     * rendered, so that any of them not yet rasterized can be prepared in a
+     * single batch rather than one by one. The default does nothing.
+     */
+    public default void prepareGlyphs(int[] glyphCodes, int count) {
+    }
 }
@@ -25,6 +25,7 @@
 
 package com.sun.javafx.font.freetype;
 
+import java.nio.ByteBuffer;
 import com.sun.javafx.font.Disposer;
 import com.sun.javafx.font.FontResource;
 import com.sun.javafx.font.FontStrikeDesc;
@@ -52,6 +53,11 @@ class FTFontFile extends PrismFontFile {
     private long face;
     private FTDisposer disposer;
 
+    /* Initial and maximum size of the scratch buffer used by loadGlyphs */
+    private static final int GLYPH_BUFFER_SIZE = 64 * 1024;
+    private static final int GLYPH_BUFFER_LIMIT = 16 * 1024 * 1024;
+    private ByteBuffer glyphBuffer;
+
     FTFontFile(String name, String filename, int fIndex, boolean register,
                boolean embedded, boolean copy, boolean tracked) throws Exception {
         super(name, filename, fIndex, register, embedded, copy, tracked);
@@ -118,23 +124,31 @@ class FTFontFile extends PrismFontFile {
     }
 
     synchronized void initGlyph(FTGlyph glyph, FTFontStrike strike) {
+        initGlyphs(new FTGlyph[] {glyph}, 1, strike);
+    }
+
+    /*
+     * Rasterizes the glyphs with a single native call per buffer full,
+     * instead of loading each glyph and fetching its slot and bitmap
+     * separately.
+     */
+    synchronized void initGlyphs(FTGlyph[] glyphs, int count, FTFontStrike strike) {
         float size = strike.getSize();
         if (size == 0) {
-            glyph.buffer = new byte[0];
-            glyph.bitmap = new FT_Bitmap();
+            for (int i = 0; i < count; i++) {
+                glyphs[i].buffer = new byte[0];
+                glyphs[i].bitmap = new FT_Bitmap();
+            }
             return;
         }
         int size26dot6 = (int)(size * 64);
-        OSFreetype.FT_Set_Char_Size(face, 0, size26dot6, 72, 72);
 
         boolean lcd = strike.getAAMode() == FontResource.AA_LCD &&
                       FTFactory.LCD_SUPPORT;
 
         int flags = OSFreetype.FT_LOAD_RENDER | OSFreetype.FT_LOAD_NO_HINTING | OSFreetype.FT_LOAD_NO_BITMAP;
         FT_Matrix matrix = strike.matrix;
-        if (matrix != null) {
-            OSFreetype.FT_Set_Transform(face, matrix, 0, 0);
-        } else {
+        if (matrix == null) {
             flags |= OSFreetype.FT_LOAD_IGNORE_TRANSFORM;
         }
         if (lcd) {
@@ -143,67 +157,81 @@ class FTFontFile extends PrismFontFile {
             flags |= OSFreetype.FT_LOAD_TARGET_NORMAL;
         }
 
-        int glyphCode = glyph.getGlyphCode();
-        int error = OSFreetype.FT_Load_Glyph(face, glyphCode, flags);
-        if (error != 0) {
-            if (PrismFontFactory.debugFonts) {
-                System.err.println("FT_Load_Glyph failed " + error +
-                                   " glyph code " + glyphCode +
-                                   " load falgs " + flags);
+        int[] glyphCodes = new int[count];
+        for (int i = 0; i < count; i++) {
+            glyphCodes[i] = glyphs[i].getGlyphCode();
+        }
+        int[] metrics = new int[count * OSFreetype.GLYPH_METRICS_SIZE];
+        if (glyphBuffer == null) {
+            glyphBuffer = ByteBuffer.allocateDirect(GLYPH_BUFFER_SIZE);
+        }
+        int start = 0;
+        while (start < count) {
+            int done = OSFreetype.loadGlyphs(face, size26dot6, matrix, flags,
+                                             glyphCodes, start, count - start,
+                                             glyphBuffer, 0, metrics);
+            if (done < 0) {
+                if (PrismFontFactory.debugFonts) {
+                    System.err.println("loadGlyphs failed for size " + size);
+                }
+                return;
             }
-            return;
+            if (done == 0) {
+                /* The next glyph does not fit in the scratch buffer */
+                int capacity = glyphBuffer.capacity() * 2;
+                if (capacity > GLYPH_BUFFER_LIMIT) return;
+                glyphBuffer = ByteBuffer.allocateDirect(capacity);
+                continue;
+            }
+            for (int i = start; i < start + done; i++) {
+                setGlyph(glyphs[i], metrics, i * OSFreetype.GLYPH_METRICS_SIZE, flags, lcd);
+            }
+            start += done;
         }
+    }
 
-        FT_GlyphSlotRec glyphRec = OSFreetype.getGlyphSlot(face);
-        if (glyphRec == null) return;
-        FT_Bitmap bitmap = glyphRec.bitmap;
-        if (bitmap == null) return;
-        int pixelMode = bitmap.pixel_mode;
-        int width = bitmap.width;
-        int height = bitmap.rows;
-        int pitch = bitmap.pitch;
-        if (pixelMode != OSFreetype.FT_PIXEL_MODE_GRAY && pixelMode != OSFreetype.FT_PIXEL_MODE_LCD) {
-            /* This procedure only requests FT_RENDER_MODE_NORMAL and FT_RENDER_MODE_LCD,
-             * and for its output is expects FT_PIXEL_MODE_GRAY and FT_PIXEL_MODE_LCD, respectively.
-             * But it is possible the requested rendering mode is not supported and a different
-             * output is returned by Freetype. For example, a FT_PIXEL_MODE_MONO can be returned
-             * if the font contains a bitmap for the given glyph code.
-             */
+    private void setGlyph(FTGlyph glyph, int[] metrics, int index, int flags, boolean lcd) {
+        int offset = metrics[index + OSFreetype.GLYPH_OFFSET];
+        if (offset < 0) {
             if (PrismFontFactory.debugFonts) {
-                System.err.println("Unexpected pixel mode: " + pixelMode +
-                                   " glyph code " + glyphCode +
-                                   " load falgs " + flags);
+                int error = metrics[index + OSFreetype.GLYPH_ERROR];
+                if (error != 0) {
+                    System.err.println("FT_Load_Glyph failed " + error +
+                                       " glyph code " + glyph.getGlyphCode() +
+                                       " load falgs " + flags);
+                } else {
+                    /* Only FT_PIXEL_MODE_GRAY and FT_PIXEL_MODE_LCD are
+                     * expected, see FT_LOAD_TARGET_NORMAL and
+                     * FT_LOAD_TARGET_LCD. A FT_PIXEL_MODE_MONO can be
+                     * returned if the font contains a bitmap for the glyph.
+                     */
+                    System.err.println("Unexpected pixel mode: " +
+                                       metrics[index + OSFreetype.GLYPH_PIXEL_MODE] +
+                                       " glyph code " + glyph.getGlyphCode() +
+                                       " load falgs " + flags);
+                }
             }
             return;
         }
-        byte[] buffer;
-        if (width != 0 && height != 0) {
-            buffer = OSFreetype.getBitmapData(face);
-            if (buffer != null && pitch != width) {
-                /* Common for LCD glyphs */
-                byte[] newBuffer = new byte[width * height];
-                int src = 0, dst = 0;
-                for (int y = 0; y < height; y++) {
-                    for (int x = 0; x < width; x++) {
-                        newBuffer[dst + x] = buffer[src + x];
-                    }
-                    dst += width;
-                    src += pitch;
-                }
-                buffer = newBuffer;
-            }
-        } else {
-            /* white space */
-            buffer = new byte[0];
+        FT_Bitmap bitmap = new FT_Bitmap();
+        bitmap.width = metrics[index + OSFreetype.GLYPH_WIDTH];
+        bitmap.rows = metrics[index + OSFreetype.GLYPH_HEIGHT];
+        bitmap.pitch = bitmap.width;
+        bitmap.pixel_mode = (byte)metrics[index + OSFreetype.GLYPH_PIXEL_MODE];
+
+        /* The bitmap is copied without row padding, empty for white space */
+        byte[] buffer = new byte[bitmap.width * bitmap.rows];
+        if (buffer.length != 0) {
+            glyphBuffer.get(offset, buffer);
         }
 
         glyph.buffer = buffer;
         glyph.bitmap = bitmap;
-        glyph.bitmap_left = glyphRec.bitmap_left;
-        glyph.bitmap_top = glyphRec.bitmap_top;
-        glyph.advanceX = glyphRec.advance_x / 64f;    /* Fixed 26.6*/
-        glyph.advanceY = glyphRec.advance_y / 64f;
-        glyph.userAdvance = glyphRec.linearHoriAdvance / 65536.0f; /* Fixed 16.16 */
+        glyph.bitmap_left = metrics[index + OSFreetype.GLYPH_LEFT];
+        glyph.bitmap_top = metrics[index + OSFreetype.GLYPH_TOP];
+        glyph.advanceX = metrics[index + OSFreetype.GLYPH_ADVANCE_X] / 64f;    /* Fixed 26.6*/
+        glyph.advanceY = metrics[index + OSFreetype.GLYPH_ADVANCE_Y] / 64f;
+        glyph.userAdvance = metrics[index + OSFreetype.GLYPH_USER_ADVANCE] / 65536.0f; /* Fixed 16.16 */
         glyph.lcd = lcd;
     }
 }
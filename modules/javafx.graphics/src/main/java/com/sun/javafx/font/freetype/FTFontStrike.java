@@ -25,6 +25,7 @@
 
 package com.sun.javafx.font.freetype;
 
+import java.util.Arrays;
 import com.sun.javafx.font.DisposerRecord;
 import com.sun.javafx.font.FontStrikeDesc;
 import com.sun.javafx.font.Glyph;
@@ -83,4 +84,24 @@ class FTFontStrike extends PrismFontStrike<FTFontFile> {
         fontResource.initGlyph(glyph, this);
     }
 
+    @Override
+    public void prepareGlyphs(int[] glyphCodes, int count) {
+        if (drawShapes || count == 0) return;
+        int[] codes = Arrays.copyOf(glyphCodes, count);
+        Arrays.sort(codes);
+        FTGlyph[] glyphs = new FTGlyph[count];
+        int pending = 0;
+        for (int i = 0; i < count; i++) {
+            if (i > 0 && codes[i] == codes[i - 1]) continue;
+            FTGlyph glyph = (FTGlyph)getGlyph(codes[i]);
+            if (glyph.bitmap == null) {
+                glyphs[pending++] = glyph;
+            }
+        }
+        if (pending > 0) {
+            FTFontFile fontResource = getFontResource();
+            fontResource.initGlyphs(glyphs, pending, this);
+        }
+    }
+
 }
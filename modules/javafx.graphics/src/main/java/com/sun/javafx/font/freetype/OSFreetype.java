@@ -25,6 +25,7 @@
 
 package com.sun.javafx.font.freetype;
 
+import java.nio.ByteBuffer;
 import java.security.AccessController;
 import java.security.PrivilegedAction;
 import com.sun.glass.utils.NativeLibLoader;
@@ -94,6 +95,19 @@ class OSFreetype {
     static final int FT_LCD_FILTER_LIGHT   = 2;
     static final int FT_LCD_FILTER_LEGACY  = 16;
 
+    /* Layout of the per glyph record written by loadGlyphs */
+    static final int GLYPH_ERROR         = 0;
+    static final int GLYPH_PIXEL_MODE    = 1;
+    static final int GLYPH_OFFSET        = 2;
+    static final int GLYPH_WIDTH         = 3;
+    static final int GLYPH_HEIGHT        = 4;
+    static final int GLYPH_LEFT          = 5;
+    static final int GLYPH_TOP           = 6;
+    static final int GLYPH_ADVANCE_X     = 7;
+    static final int GLYPH_ADVANCE_Y     = 8;
+    static final int GLYPH_USER_ADVANCE  = 9;
+    static final int GLYPH_METRICS_SIZE  = 10;
+
     static final int FT_LOAD_TARGET_MODE(int x) {
         return (x >> 16 ) & 15;
     }
@@ -111,6 +125,9 @@ class OSFreetype {
     static final native void FT_Set_Transform(long face, FT_Matrix matrix, long delta_x, long delta_y);
     static final native FT_GlyphSlotRec getGlyphSlot(long face);
     static final native byte[] getBitmapData(long face);
+    static final native int loadGlyphs(long face, long size26dot6, FT_Matrix matrix, int load_flags,
+                                       int[] glyphs, int start, int count,
+                                       ByteBuffer dst, int dstOffset, int[] metrics);
     static final native boolean isPangoEnabled();
     static final native boolean isHarfbuzzEnabled();
 }
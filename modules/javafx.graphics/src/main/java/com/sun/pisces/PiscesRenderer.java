@@ -439,6 +439,25 @@ public final class PiscesRenderer {
         }
     }
 
+    /**
+     * Sets the number of threads, the rendering thread included, that large
+     * fills and image draws are split across. The output does not depend on
+     * it. 0 uses one thread per processor, up to 8, and 1 renders everything
+     * on the rendering thread. It may be called from any thread. Once a fill
+     * has been split the number of threads is fixed, and only 1 still has an
+     * effect.
+     *
+     * @param threads the number of threads, or 0
+     */
+    public static void setRenderThreads(int threads) {
+        if (threads < 0) {
+            throw new IllegalArgumentException("THREADS must not be negative");
+        }
+        setRenderThreadsImpl(threads);
+    }
+
+    private static native void setRenderThreadsImpl(int threads);
+
     private static native void disposeNative(long nativeHandle);
 
     private static class PiscesRendererDisposerRecord implements Disposer.Record {
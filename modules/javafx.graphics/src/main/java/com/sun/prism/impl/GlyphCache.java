@@ -81,6 +81,10 @@ public class GlyphCache {
 
     private boolean isLCDCache;
 
+    /* Glyph list being rendered whose uncached glyphs have not yet been
+     * handed to FontStrike.prepareGlyphs(), null once they have been. */
+    private GlyphList pendingGlyphs;
+
     /* Share a RectanglePacker and its associated texture cache
      * for all uses on a particular screen.
      */
@@ -133,6 +137,7 @@ public class GlyphCache {
         int len = gl.getGlyphCount();
         Color currentColor = null;
         Point2D pt = new Point2D();
+        pendingGlyphs = gl;
 
         for (int gi = 0; gi < len; gi++) {
             int gc = gl.getGlyphCode(gi);
@@ -173,6 +178,26 @@ public class GlyphCache {
                 addDataToQuad(data, vb, tex, pt.x, pt.y, dstw, dsth);
             }
         }
+        pendingGlyphs = null;
+    }
+
+    /*
+     * Called on the first cache miss of a render, lets the strike rasterize
+     * every glyph of the list in one batch.
+     */
+    private void prepareGlyphs() {
+        GlyphList gl = pendingGlyphs;
+        pendingGlyphs = null;
+        int len = gl.getGlyphCount();
+        int[] glyphCodes = new int[len];
+        int count = 0;
+        for (int gi = 0; gi < len; gi++) {
+            int gc = gl.getGlyphCode(gi);
+            if ((gc & CompositeGlyphMapper.GLYPHMASK) != CharToGlyphMapper.INVISIBLE_GLYPH_ID) {
+                glyphCodes[count++] = gc;
+            }
+        }
+        strike.prepareGlyphs(glyphCodes, count);
     }
 
     private void addDataToQuad(GlyphData data, VertexBuffer vb,
@@ -254,6 +279,9 @@ public class GlyphCache {
 
         // Render the glyph and insert it in the cache
         GlyphData data = null;
+        if (pendingGlyphs != null) {
+            prepareGlyphs();
+        }
         Glyph glyph = strike.getGlyph(glyphCode);
         if (glyph != null) {
             byte[] glyphImage = glyph.getPixelData(subPixel);
@@ -85,6 +85,7 @@ public final class PrismSettings {
     public static final boolean forceUploadingPainter;
     public static final boolean forceAlphaTestShader;
     public static final boolean forceNonAntialiasedShape;
+    public static final int swRenderThreads;
 
     public static enum RasterizerType {
         DoubleMarlin("Double Precision Marlin Rasterizer");
@@ -355,6 +356,14 @@ public final class PrismSettings {
         // Force non anti-aliasing (not smooth) shape rendering
         forceNonAntialiasedShape = getBoolean(systemProperties, "prism.forceNonAntialiasedShape", false);
 
+        /*
+         * Number of threads the software pipeline splits large fills and
+         * image draws across, the render thread included. The default of 0
+         * uses one per processor, 1 renders on the render thread alone.
+         */
+        swRenderThreads = getInt(systemProperties, "prism.sw.threads", 0,
+                                 "Try -Dprism.sw.threads=<number>");
+
     }
 
     private static int parseInt(String s, int dflt, int trueDflt,
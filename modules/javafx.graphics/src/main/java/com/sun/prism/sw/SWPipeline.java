@@ -27,8 +27,10 @@ package com.sun.prism.sw;
 
 import com.sun.glass.ui.Screen;
 import com.sun.glass.utils.NativeLibLoader;
+import com.sun.pisces.PiscesRenderer;
 import com.sun.prism.GraphicsPipeline;
 import com.sun.prism.ResourceFactory;
+import com.sun.prism.impl.PrismSettings;
 
 import java.security.AccessController;
 import java.security.PrivilegedAction;
@@ -43,6 +45,7 @@ public final class SWPipeline extends GraphicsPipeline {
             NativeLibLoader.loadLibrary("prism_sw");
             return null;
         });
+        PiscesRenderer.setRenderThreads(Math.max(PrismSettings.swRenderThreads, 0));
     }
 
     @Override public boolean init() {
@@ -0,0 +1,1165 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <stddef.h>
+#include "SSEFilters.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define ENABLE_SIMD_X86 1
+#else
+#define ENABLE_SIMD_X86 0
+#endif
+
+#if ENABLE_SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SSE41_TARGET
+#define AVX2_TARGET
+#else
+#define SSE41_TARGET __attribute__((target("sse4.1")))
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif // ENABLE_SIMD_X86
+
+#define cmin 1.0f
+#define cmax (255.0f - 1.0f/32.0f)
+
+#define MAX_KERNEL_SIZE 128
+
+/*
+ * Scalar passes, the reference for the SIMD versions below. They also handle
+ * the rows and columns left over by the SIMD groups.
+ */
+
+static void boxBlurRows_c(jint *dstPixels, jint dstw, jint dstscan,
+                          jint *srcPixels, jint srcw, jint srcscan,
+                          jint y0, jint y1)
+{
+    jint hsize = dstw - srcw + 1;
+    jint kscale = 0x7fffffff / (hsize * 255);
+    jint srcoff = y0 * srcscan;
+    jint dstoff = y0 * dstscan;
+    for (jint y = y0; y < y1; y++) {
+        jint suma = 0;
+        jint sumr = 0;
+        jint sumg = 0;
+        jint sumb = 0;
+        for (jint x = 0; x < dstw; x++) {
+            jint rgb;
+            // Un-accumulate the data for col-hsize location into the sums.
+            rgb = (x >= hsize) ? srcPixels[srcoff + x - hsize] : 0;
+            suma -= (rgb >> 24) & 0xff;
+            sumr -= (rgb >> 16) & 0xff;
+            sumg -= (rgb >>  8) & 0xff;
+            sumb -= (rgb      ) & 0xff;
+            // Accumulate the data for this col location into the sums.
+            rgb = (x < srcw) ? srcPixels[srcoff + x] : 0;
+            suma += (rgb >> 24) & 0xff;
+            sumr += (rgb >> 16) & 0xff;
+            sumg += (rgb >>  8) & 0xff;
+            sumb += (rgb      ) & 0xff;
+            dstPixels[dstoff + x] =
+                (((suma * kscale) >> 23) << 24) +
+                (((sumr * kscale) >> 23) << 16) +
+                (((sumg * kscale) >> 23) <<  8) +
+                (((sumb * kscale) >> 23)      );
+        }
+        srcoff += srcscan;
+        dstoff += dstscan;
+    }
+}
+
+static void boxBlurColumns_c(jint *dstPixels, jint dsth, jint dstscan,
+                             jint *srcPixels, jint srch, jint srcscan,
+                             jint x0, jint x1)
+{
+    jint vsize = dsth - srch + 1;
+    jint kscale = 0x7fffffff / (vsize * 255);
+    jint voff = vsize * srcscan;
+    for (jint x = x0; x < x1; x++) {
+        jint suma = 0;
+        jint sumr = 0;
+        jint sumg = 0;
+        jint sumb = 0;
+        jint srcoff = x;
+        jint dstoff = x;
+        for (jint y = 0; y < dsth; y++) {
+            jint rgb;
+            // Un-accumulate the data for row-vsize location into the sums.
+            rgb = (srcoff >= voff) ? srcPixels[srcoff - voff] : 0;
+            suma -= (rgb >> 24) & 0xff;
+            sumr -= (rgb >> 16) & 0xff;
+            sumg -= (rgb >>  8) & 0xff;
+            sumb -= (rgb      ) & 0xff;
+            // Accumulate the data for this col location into the sums.
+            rgb = (y < srch) ? srcPixels[srcoff] : 0;
+            suma += (rgb >> 24) & 0xff;
+            sumr += (rgb >> 16) & 0xff;
+            sumg += (rgb >>  8) & 0xff;
+            sumb += (rgb      ) & 0xff;
+            dstPixels[dstoff] =
+                (((suma * kscale) >> 23) << 24) +
+                (((sumr * kscale) >> 23) << 16) +
+                (((sumg * kscale) >> 23) <<  8) +
+                (((sumb * kscale) >> 23)      );
+            srcoff += srcscan;
+            dstoff += dstscan;
+        }
+    }
+}
+
+// The alpha sum scale of the shadow passes, amax goes from size*255 to 255
+// as spread goes from 0 to 1
+static jint shadowAmax(jint size, jfloat spread)
+{
+    jint amax = size * 255;
+    amax += (jint) ((255 - amax) * spread);
+    return amax;
+}
+
+static inline jint shadowBlack(jint suma, jint amin, jint amax, jint kscale)
+{
+    return ((suma < amin) ? 0
+            : ((suma >= amax) ? 0xff000000
+               : (((suma * kscale) >> 23) << 24)));
+}
+
+static void boxShadowRowsBlack_c(jint *dstPixels, jint dstw, jint dstscan,
+                                 jint *srcPixels, jint srcw, jint srcscan,
+                                 jfloat spread, jint y0, jint y1)
+{
+    jint hsize = dstw - srcw + 1;
+    jint amax = shadowAmax(hsize, spread);
+    jint kscale = 0x7fffffff / amax;
+    jint amin = (amax / 255);
+    jint srcoff = y0 * srcscan;
+    jint dstoff = y0 * dstscan;
+    for (jint y = y0; y < y1; y++) {
+        jint suma = 0;
+        for (jint x = 0; x < dstw; x++) {
+            jint rgb;
+            // Un-accumulate the data for col-hsize location into the sums.
+            rgb = (x >= hsize) ? srcPixels[srcoff + x - hsize] : 0;
+            suma -= (rgb >> 24) & 0xff;
+            // Accumulate the data for this col location into the sums.
+            rgb = (x < srcw) ? srcPixels[srcoff + x] : 0;
+            suma += (rgb >> 24) & 0xff;
+            // Clamp, scale and convert the sum into a color.
+            dstPixels[dstoff + x] = shadowBlack(suma, amin, amax, kscale);
+        }
+        srcoff += srcscan;
+        dstoff += dstscan;
+    }
+}
+
+static void boxShadowColumns_c(jint *dstPixels, jint dsth, jint dstscan,
+                               jint *srcPixels, jint srch, jint srcscan,
+                               jfloat spread, const jfloat *shadowColor,
+                               jint x0, jint x1)
+{
+    jint vsize = dsth - srch + 1;
+    jint amax = shadowAmax(vsize, spread);
+    jint kscalea = 0x7fffffff / amax;
+    jint amin = (amax / 255);
+    jint voff = vsize * srcscan;
+    jint kscaler = 0;
+    jint kscaleg = 0;
+    jint kscaleb = 0;
+    jint shadowRGB = 0;
+    if (shadowColor != NULL) {
+        kscaler = (jint) (kscalea * shadowColor[0]);
+        kscaleg = (jint) (kscalea * shadowColor[1]);
+        kscaleb = (jint) (kscalea * shadowColor[2]);
+        kscalea = (jint) (kscalea * shadowColor[3]);
+        shadowRGB =
+            (((jint) (shadowColor[0] * 255)) << 16) |
+            (((jint) (shadowColor[1] * 255)) <<  8) |
+            (((jint) (shadowColor[2] * 255))      ) |
+            (((jint) (shadowColor[3] * 255)) << 24);
+    }
+    for (jint x = x0; x < x1; x++) {
+        jint suma = 0;
+        jint srcoff = x;
+        jint dstoff = x;
+        for (jint y = 0; y < dsth; y++) {
+            jint rgb;
+            // Un-accumulate the data for row-vsize location into the sums.
+            rgb = (srcoff >= voff) ? srcPixels[srcoff - voff] : 0;
+            suma -= (rgb >> 24) & 0xff;
+            // Accumulate the data for this row location into the sums.
+            rgb = (y < srch) ? srcPixels[srcoff] : 0;
+            suma += (rgb >> 24) & 0xff;
+            // Clamp, scale and convert the sum into a color.
+            if (shadowColor == NULL) {
+                dstPixels[dstoff] = shadowBlack(suma, amin, amax, kscalea);
+            } else {
+                dstPixels[dstoff] =
+                    ((suma < amin) ? 0
+                     : ((suma >= amax) ? shadowRGB
+                        : ((((suma * kscalea) >> 23) << 24) |
+                           (((suma * kscaler) >> 23) << 16) |
+                           (((suma * kscaleg) >> 23) <<  8) |
+                           (((suma * kscaleb) >> 23)      ))));
+            }
+            srcoff += srcscan;
+            dstoff += dstscan;
+        }
+    }
+}
+
+static inline jint convolveByte(jfloat sum)
+{
+    return (sum < cmin) ? 0 : ((sum > cmax) ? 255 : ((jint) sum));
+}
+
+static void convolveRows_c(jint *dstPixels, jint dstcols, jint dcolinc, jint drowinc,
+                           jint *srcPixels, jint srccols, jint scolinc, jint srowinc,
+                           const jfloat *kvals, jint kernelSize, jint r0, jint r1)
+{
+    // cvals stores the component values from the surrounding K pixels
+    // from x-r to x+r
+    jfloat cvals[MAX_KERNEL_SIZE*4];
+    jint dstrow = r0 * drowinc;
+    jint srcrow = r0 * srowinc;
+    for (jint r = r0; r < r1; r++) {
+        jint dstoff = dstrow;
+        jint srcoff = srcrow;
+        // Must clear out the array at the start of every line
+        for (jint i = 0; i < kernelSize*4; i++) {
+            cvals[i] = 0.0f;
+        }
+        jint koff = kernelSize;
+        for (jint c = 0; c < dstcols; c++) {
+            // Load the data for this x location into the array.
+            jint i = (kernelSize - koff) * 4;
+            jint rgb = (c < srccols) ? srcPixels[srcoff] : 0;
+            cvals[i+0] = (jfloat) ((rgb >> 24) & 0xff);
+            cvals[i+1] = (jfloat) ((rgb >> 16) & 0xff);
+            cvals[i+2] = (jfloat) ((rgb >>  8) & 0xff);
+            cvals[i+3] = (jfloat) ((rgb      ) & 0xff);
+            // Bump the koff to the next spot to align the coefficients.
+            if (--koff <= 0) {
+                koff += kernelSize;
+            }
+            jfloat suma = 0.0f;
+            jfloat sumr = 0.0f;
+            jfloat sumg = 0.0f;
+            jfloat sumb = 0.0f;
+            for (i = 0; i < kernelSize*4; i += 4) {
+                jfloat factor = kvals[koff + (i>>2)];
+                suma += cvals[i+0] * factor;
+                sumr += cvals[i+1] * factor;
+                sumg += cvals[i+2] * factor;
+                sumb += cvals[i+3] * factor;
+            }
+            dstPixels[dstoff] =
+                (convolveByte(suma) << 24) +
+                (convolveByte(sumr) << 16) +
+                (convolveByte(sumg) <<  8) +
+                (convolveByte(sumb)      );
+            dstoff += dcolinc;
+            srcoff += scolinc;
+        }
+        dstrow += drowinc;
+        srcrow += srowinc;
+    }
+}
+
+static inline jint convolveShadow(jfloat sum, const jint *shadowRGBs)
+{
+    return ((sum < 0.0f) ? 0
+            : ((sum >= 254.0f) ? shadowRGBs[255]
+               : shadowRGBs[((jint) sum) + 1]));
+}
+
+static void convolveShadowRows_c(jint *dstPixels, jint dstcols, jint dcolinc, jint drowinc,
+                                 jint *srcPixels, jint srccols, jint scolinc, jint srowinc,
+                                 const jfloat *kvals, jint kernelSize, const jint *shadowRGBs,
+                                 jint r0, jint r1)
+{
+    // avals stores the alpha values from the surrounding K pixels
+    // from x-r to x+r
+    jfloat avals[MAX_KERNEL_SIZE];
+    jint dstrow = r0 * drowinc;
+    jint srcrow = r0 * srowinc;
+    for (jint r = r0; r < r1; r++) {
+        jint dstoff = dstrow;
+        jint srcoff = srcrow;
+        // Must clear out the array at the start of every line
+        for (jint i = 0; i < kernelSize; i++) {
+            avals[i] = 0.0f;
+        }
+        jint koff = kernelSize;
+        for (jint c = 0; c < dstcols; c++) {
+            // Load the data for this x location into the array.
+            jint rgb = (c < srccols) ? srcPixels[srcoff] : 0;
+            avals[kernelSize - koff] = (jfloat) ((rgb >> 24) & 0xff);
+            // Bump the koff to the next spot to align the coefficients.
+            if (--koff <= 0) {
+                koff += kernelSize;
+            }
+            jfloat sum = -0.5f;
+            for (jint i = 0; i < kernelSize; i++) {
+                sum += avals[i] * kvals[koff + i];
+            }
+            dstPixels[dstoff] = convolveShadow(sum, shadowRGBs);
+            dstoff += dcolinc;
+            srcoff += scolinc;
+        }
+        dstrow += drowinc;
+        srcrow += srowinc;
+    }
+}
+
+#if ENABLE_SIMD_X86
+/*
+ * SSE4.1 and AVX2 passes. The running sums of the box filters are exact
+ * integers, so they are kept per channel in vector lanes. The convolutions
+ * sum the taps of each lane in the same order as the scalar loops, and gain
+ * their speed from filtering several rows at once, one row per lane group.
+ */
+
+SSE41_TARGET static inline __m128i sse41_unpack(jint pixel)
+{
+    return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(pixel));
+}
+
+SSE41_TARGET static inline __m128i sse41_scale(__m128i sum, __m128i kscale)
+{
+    return _mm_srai_epi32(_mm_mullo_epi32(sum, kscale), 23);
+}
+
+SSE41_TARGET static inline jint sse41_pack(__m128i v)
+{
+    v = _mm_packus_epi32(v, v);
+    return _mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+}
+
+// Blurs two rows at a time, one running sum per row and channel
+SSE41_TARGET static void boxBlurRows_sse41(jint *dstPixels, jint dstw, jint dstscan,
+                                           jint *srcPixels, jint srcw, jint srcscan,
+                                           jint y0, jint y1)
+{
+    jint hsize = dstw - srcw + 1;
+    __m128i kscale = _mm_set1_epi32(0x7fffffff / (hsize * 255));
+    jint y = y0;
+    for (; y + 2 <= y1; y += 2) {
+        const jint *src0 = srcPixels + y * srcscan;
+        const jint *src1 = src0 + srcscan;
+        jint *dst0 = dstPixels + y * dstscan;
+        jint *dst1 = dst0 + dstscan;
+        __m128i sum0 = _mm_setzero_si128();
+        __m128i sum1 = _mm_setzero_si128();
+        for (jint x = 0; x < dstw; x++) {
+            if (x >= hsize) {
+                sum0 = _mm_sub_epi32(sum0, sse41_unpack(src0[x - hsize]));
+                sum1 = _mm_sub_epi32(sum1, sse41_unpack(src1[x - hsize]));
+            }
+            if (x < srcw) {
+                sum0 = _mm_add_epi32(sum0, sse41_unpack(src0[x]));
+                sum1 = _mm_add_epi32(sum1, sse41_unpack(src1[x]));
+            }
+            dst0[x] = sse41_pack(sse41_scale(sum0, kscale));
+            dst1[x] = sse41_pack(sse41_scale(sum1, kscale));
+        }
+    }
+    boxBlurRows_c(dstPixels, dstw, dstscan, srcPixels, srcw, srcscan, y, y1);
+}
+
+// Four pixels, one channel per lane, to four vectors
+SSE41_TARGET static inline void sse41_unpack4(const jint *pixels, __m128i *p)
+{
+    __m128i v = _mm_loadu_si128((const __m128i *) pixels);
+    p[0] = _mm_cvtepu8_epi32(v);
+    p[1] = _mm_cvtepu8_epi32(_mm_srli_si128(v, 4));
+    p[2] = _mm_cvtepu8_epi32(_mm_srli_si128(v, 8));
+    p[3] = _mm_cvtepu8_epi32(_mm_srli_si128(v, 12));
+}
+
+// Walks the rows once per block of columns, keeping the sums of the block
+SSE41_TARGET static void boxBlurColumns_sse41(jint *dstPixels, jint dsth, jint dstscan,
+                                              jint *srcPixels, jint srch, jint srcscan,
+                                              jint x0, jint x1)
+{
+    jint vsize = dsth - srch + 1;
+    __m128i kscale = _mm_set1_epi32(0x7fffffff / (vsize * 255));
+    __m128i sums[FILTER_COLUMN_BLOCK];
+    for (jint bx = x0; bx < x1; bx += FILTER_COLUMN_BLOCK) {
+        jint groups = ((x1 - bx < FILTER_COLUMN_BLOCK) ? x1 - bx : FILTER_COLUMN_BLOCK) / 4;
+        for (jint i = 0; i < groups * 4; i++) {
+            sums[i] = _mm_setzero_si128();
+        }
+        for (jint y = 0; y < dsth; y++) {
+            const jint *sub = (y >= vsize) ? srcPixels + (y - vsize) * srcscan + bx : NULL;
+            const jint *add = srcPixels + y * srcscan + bx;
+            jint *dst = dstPixels + y * dstscan + bx;
+            for (jint g = 0; g < groups; g++) {
+                __m128i *s = sums + g * 4;
+                __m128i p[4];
+                if (y >= vsize) {
+                    sse41_unpack4(sub + g * 4, p);
+                    s[0] = _mm_sub_epi32(s[0], p[0]);
+                    s[1] = _mm_sub_epi32(s[1], p[1]);
+                    s[2] = _mm_sub_epi32(s[2], p[2]);
+                    s[3] = _mm_sub_epi32(s[3], p[3]);
+                }
+                if (y < srch) {
+                    sse41_unpack4(add + g * 4, p);
+                    s[0] = _mm_add_epi32(s[0], p[0]);
+                    s[1] = _mm_add_epi32(s[1], p[1]);
+                    s[2] = _mm_add_epi32(s[2], p[2]);
+                    s[3] = _mm_add_epi32(s[3], p[3]);
+                }
+                __m128i lo = _mm_packus_epi32(sse41_scale(s[0], kscale), sse41_scale(s[1], kscale));
+                __m128i hi = _mm_packus_epi32(sse41_scale(s[2], kscale), sse41_scale(s[3], kscale));
+                _mm_storeu_si128((__m128i *) (dst + g * 4), _mm_packus_epi16(lo, hi));
+            }
+        }
+        jint done = bx + groups * 4;
+        if (done < bx + FILTER_COLUMN_BLOCK && done < x1) {
+            boxBlurColumns_c(dstPixels, dsth, dstscan, srcPixels, srch, srcscan,
+                             done, (x1 < bx + FILTER_COLUMN_BLOCK) ? x1 : bx + FILTER_COLUMN_BLOCK);
+        }
+    }
+}
+
+// Inclusive prefix sum of four lanes
+SSE41_TARGET static inline __m128i sse41_prefix(__m128i v)
+{
+    v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+    return _mm_add_epi32(v, _mm_slli_si128(v, 8));
+}
+
+SSE41_TARGET static inline __m128i sse41_alpha(const jint *pixels)
+{
+    return _mm_srli_epi32(_mm_loadu_si128((const __m128i *) pixels), 24);
+}
+
+SSE41_TARGET static inline __m128i sse41_shadow_black(__m128i suma, __m128i amin,
+                                                      __m128i amax, __m128i kscale)
+{
+    __m128i v = _mm_slli_epi32(sse41_scale(suma, kscale), 24);
+    v = _mm_blendv_epi8(v, _mm_set1_epi32((jint) 0xff000000), _mm_cmpgt_epi32(suma, _mm_sub_epi32(amax, _mm_set1_epi32(1))));
+    return _mm_andnot_si128(_mm_cmpgt_epi32(amin, suma), v);
+}
+
+/*
+ * Computes the window sums of four columns at a time as a prefix sum of
+ * the alpha values entering minus the ones leaving the window. Steps where
+ * the window edges cross the source bounds are done one column at a time.
+ */
+SSE41_TARGET static void boxShadowRowsBlack_sse41(jint *dstPixels, jint dstw, jint dstscan,
+                                                  jint *srcPixels, jint srcw, jint srcscan,
+                                                  jfloat spread, jint y0, jint y1)
+{
+    jint hsize = dstw - srcw + 1;
+    jint amax = shadowAmax(hsize, spread);
+    jint kscale = 0x7fffffff / amax;
+    jint amin = (amax / 255);
+    __m128i vamax = _mm_set1_epi32(amax);
+    __m128i vamin = _mm_set1_epi32(amin);
+    __m128i vkscale = _mm_set1_epi32(kscale);
+    for (jint y = y0; y < y1; y++) {
+        const jint *src = srcPixels + y * srcscan;
+        jint *dst = dstPixels + y * dstscan;
+        jint suma = 0;
+        jint x = 0;
+        while (x < dstw) {
+            bool add = x + 4 <= srcw;
+            bool sub = x >= hsize;
+            if (x + 4 <= dstw && (add || x >= srcw) && (sub || x + 4 <= hsize)) {
+                __m128i d = add ? sse41_alpha(src + x) : _mm_setzero_si128();
+                if (sub) {
+                    d = _mm_sub_epi32(d, sse41_alpha(src + x - hsize));
+                }
+                __m128i s = _mm_add_epi32(sse41_prefix(d), _mm_set1_epi32(suma));
+                suma = _mm_extract_epi32(s, 3);
+                _mm_storeu_si128((__m128i *) (dst + x), sse41_shadow_black(s, vamin, vamax, vkscale));
+                x += 4;
+            } else {
+                if (x >= hsize) {
+                    suma -= (src[x - hsize] >> 24) & 0xff;
+                }
+                if (x < srcw) {
+                    suma += (src[x] >> 24) & 0xff;
+                }
+                dst[x] = shadowBlack(suma, amin, amax, kscale);
+                x++;
+            }
+        }
+    }
+}
+
+SSE41_TARGET static void boxShadowColumns_sse41(jint *dstPixels, jint dsth, jint dstscan,
+                                                jint *srcPixels, jint srch, jint srcscan,
+                                                jfloat spread, const jfloat *shadowColor,
+                                                jint x0, jint x1)
+{
+    jint vsize = dsth - srch + 1;
+    jint amax = shadowAmax(vsize, spread);
+    jint kscale = 0x7fffffff / amax;
+    jint amin = (amax / 255);
+    __m128i vamax = _mm_set1_epi32(amax);
+    __m128i vamin = _mm_set1_epi32(amin);
+    __m128i ka = _mm_set1_epi32(kscale);
+    __m128i kr = _mm_setzero_si128();
+    __m128i kg = _mm_setzero_si128();
+    __m128i kb = _mm_setzero_si128();
+    __m128i shadowRGB = _mm_setzero_si128();
+    if (shadowColor != NULL) {
+        kr = _mm_set1_epi32((jint) (kscale * shadowColor[0]));
+        kg = _mm_set1_epi32((jint) (kscale * shadowColor[1]));
+        kb = _mm_set1_epi32((jint) (kscale * shadowColor[2]));
+        ka = _mm_set1_epi32((jint) (kscale * shadowColor[3]));
+        shadowRGB = _mm_set1_epi32(
+            (((jint) (shadowColor[0] * 255)) << 16) |
+            (((jint) (shadowColor[1] * 255)) <<  8) |
+            (((jint) (shadowColor[2] * 255))      ) |
+            (((jint) (shadowColor[3] * 255)) << 24));
+    }
+    __m128i sums[FILTER_COLUMN_BLOCK / 4];
+    for (jint bx = x0; bx < x1; bx += FILTER_COLUMN_BLOCK) {
+        jint groups = ((x1 - bx < FILTER_COLUMN_BLOCK) ? x1 - bx : FILTER_COLUMN_BLOCK) / 4;
+        for (jint g = 0; g < groups; g++) {
+            sums[g] = _mm_setzero_si128();
+        }
+        for (jint y = 0; y < dsth; y++) {
+            const jint *sub = (y >= vsize) ? srcPixels + (y - vsize) * srcscan + bx : NULL;
+            const jint *add = srcPixels + y * srcscan + bx;
+            jint *dst = dstPixels + y * dstscan + bx;
+            for (jint g = 0; g < groups; g++) {
+                __m128i s = sums[g];
+                if (y >= vsize) {
+                    s = _mm_sub_epi32(s, sse41_alpha(sub + g * 4));
+                }
+                if (y < srch) {
+                    s = _mm_add_epi32(s, sse41_alpha(add + g * 4));
+                }
+                sums[g] = s;
+                __m128i v;
+                if (shadowColor == NULL) {
+                    v = sse41_shadow_black(s, vamin, vamax, ka);
+                } else {
+                    v = _mm_or_si128(
+                            _mm_or_si128(_mm_slli_epi32(sse41_scale(s, ka), 24),
+                                         _mm_slli_epi32(sse41_scale(s, kr), 16)),
+                            _mm_or_si128(_mm_slli_epi32(sse41_scale(s, kg), 8),
+                                         sse41_scale(s, kb)));
+                    v = _mm_blendv_epi8(v, shadowRGB, _mm_cmpgt_epi32(s, _mm_sub_epi32(vamax, _mm_set1_epi32(1))));
+                    v = _mm_andnot_si128(_mm_cmpgt_epi32(vamin, s), v);
+                }
+                _mm_storeu_si128((__m128i *) (dst + g * 4), v);
+            }
+        }
+        jint done = bx + groups * 4;
+        if (done < bx + FILTER_COLUMN_BLOCK && done < x1) {
+            boxShadowColumns_c(dstPixels, dsth, dstscan, srcPixels, srch, srcscan,
+                               spread, shadowColor,
+                               done, (x1 < bx + FILTER_COLUMN_BLOCK) ? x1 : bx + FILTER_COLUMN_BLOCK);
+        }
+    }
+}
+
+// Four rows at a time, one row with its four channels per vector
+SSE41_TARGET static void convolveRows_sse41(jint *dstPixels, jint dstcols, jint dcolinc, jint drowinc,
+                                            jint *srcPixels, jint srccols, jint scolinc, jint srowinc,
+                                            const jfloat *kvals, jint kernelSize, jint r0, jint r1)
+{
+    __m128 cvals[MAX_KERNEL_SIZE][4];
+    __m128 vmin = _mm_set1_ps(cmin);
+    __m128 vmax = _mm_set1_ps(cmax);
+    __m128i v255 = _mm_set1_epi32(255);
+    jint r = r0;
+    for (; r + 4 <= r1; r += 4) {
+        jint dstoff = r * drowinc;
+        jint srcoff = r * srowinc;
+        for (jint i = 0; i < kernelSize; i++) {
+            for (jint j = 0; j < 4; j++) {
+                cvals[i][j] = _mm_setzero_ps();
+            }
+        }
+        jint koff = kernelSize;
+        for (jint c = 0; c < dstcols; c++) {
+            jint i = kernelSize - koff;
+            for (jint j = 0; j < 4; j++) {
+                jint rgb = (c < srccols) ? srcPixels[srcoff + j * srowinc] : 0;
+                cvals[i][j] = _mm_cvtepi32_ps(sse41_unpack(rgb));
+            }
+            if (--koff <= 0) {
+                koff += kernelSize;
+            }
+            __m128 sum0 = _mm_setzero_ps();
+            __m128 sum1 = _mm_setzero_ps();
+            __m128 sum2 = _mm_setzero_ps();
+            __m128 sum3 = _mm_setzero_ps();
+            for (i = 0; i < kernelSize; i++) {
+                __m128 factor = _mm_set1_ps(kvals[koff + i]);
+                sum0 = _mm_add_ps(sum0, _mm_mul_ps(cvals[i][0], factor));
+                sum1 = _mm_add_ps(sum1, _mm_mul_ps(cvals[i][1], factor));
+                sum2 = _mm_add_ps(sum2, _mm_mul_ps(cvals[i][2], factor));
+                sum3 = _mm_add_ps(sum3, _mm_mul_ps(cvals[i][3], factor));
+            }
+            __m128 sums[4] = { sum0, sum1, sum2, sum3 };
+            for (jint j = 0; j < 4; j++) {
+                __m128i v = _mm_cvttps_epi32(sums[j]);
+                v = _mm_andnot_si128(_mm_castps_si128(_mm_cmplt_ps(sums[j], vmin)), v);
+                v = _mm_blendv_epi8(v, v255, _mm_castps_si128(_mm_cmpgt_ps(sums[j], vmax)));
+                dstPixels[dstoff + j * drowinc] = sse41_pack(v);
+            }
+            dstoff += dcolinc;
+            srcoff += scolinc;
+        }
+    }
+    convolveRows_c(dstPixels, dstcols, dcolinc, drowinc,
+                   srcPixels, srccols, scolinc, srowinc,
+                   kvals, kernelSize, r, r1);
+}
+
+// Eight rows at a time, one row per lane
+SSE41_TARGET static void convolveShadowRows_sse41(jint *dstPixels, jint dstcols, jint dcolinc, jint drowinc,
+                                                  jint *srcPixels, jint srccols, jint scolinc, jint srowinc,
+                                                  const jfloat *kvals, jint kernelSize, const jint *shadowRGBs,
+                                                  jint r0, jint r1)
+{
+    __m128 avals[MAX_KERNEL_SIZE][2];
+    jint r = r0;
+    for (; r + 8 <= r1; r += 8) {
+        jint dstoff = r * drowinc;
+        jint srcoff = r * srowinc;
+        for (jint i = 0; i < kernelSize; i++) {
+            avals[i][0] = _mm_setzero_ps();
+            avals[i][1] = _mm_setzero_ps();
+        }
+        jint koff = kernelSize;
+        for (jint c = 0; c < dstcols; c++) {
+            jint rgb[8];
+            for (jint j = 0; j < 8; j++) {
+                rgb[j] = (c < srccols) ? srcPixels[srcoff + j * srowinc] : 0;
+            }
+            jint i = kernelSize - koff;
+            avals[i][0] = _mm_cvtepi32_ps(_mm_srli_epi32(_mm_loadu_si128((const __m128i *) rgb), 24));
+            avals[i][1] = _mm_cvtepi32_ps(_mm_srli_epi32(_mm_loadu_si128((const __m128i *) (rgb + 4)), 24));
+            if (--koff <= 0) {
+                koff += kernelSize;
+            }
+            __m128 sum0 = _mm_set1_ps(-0.5f);
+            __m128 sum1 = sum0;
+            for (i = 0; i < kernelSize; i++) {
+                __m128 factor = _mm_set1_ps(kvals[koff + i]);
+                sum0 = _mm_add_ps(sum0, _mm_mul_ps(avals[i][0], factor));
+                sum1 = _mm_add_ps(sum1, _mm_mul_ps(avals[i][1], factor));
+            }
+            jfloat sums[8];
+            _mm_storeu_ps(sums, sum0);
+            _mm_storeu_ps(sums + 4, sum1);
+            for (jint j = 0; j < 8; j++) {
+                dstPixels[dstoff + j * drowinc] = convolveShadow(sums[j], shadowRGBs);
+            }
+            dstoff += dcolinc;
+            srcoff += scolinc;
+        }
+    }
+    convolveShadowRows_c(dstPixels, dstcols, dcolinc, drowinc,
+                         srcPixels, srccols, scolinc, srowinc,
+                         kvals, kernelSize, shadowRGBs, r, r1);
+}
+
+AVX2_TARGET static inline __m256i avx2_unpack2(jint pixel0, jint pixel1)
+{
+    return _mm256_cvtepu8_epi32(_mm_unpacklo_epi32(_mm_cvtsi32_si128(pixel0),
+                                                   _mm_cvtsi32_si128(pixel1)));
+}
+
+AVX2_TARGET static inline __m256i avx2_scale(__m256i sum, __m256i kscale)
+{
+    return _mm256_srai_epi32(_mm256_mullo_epi32(sum, kscale), 23);
+}
+
+// Packs the channels of the two 128-bit lanes into one pixel each
+AVX2_TARGET static inline void avx2_pack2(__m256i v, jint *pixel0, jint *pixel1)
+{
+    v = _mm256_packus_epi32(v, v);
+    v = _mm256_packus_epi16(v, v);
+    *pixel0 = _mm_cvtsi128_si32(_mm256_castsi256_si128(v));
+    *pixel1 = _mm_cvtsi128_si32(_mm256_extracti128_si256(v, 1));
+}
+
+// Blurs four rows at a time, two rows per vector
+AVX2_TARGET static void boxBlurRows_avx2(jint *dstPixels, jint dstw, jint dstscan,
+                                         jint *srcPixels, jint srcw, jint srcscan,
+                                         jint y0, jint y1)
+{
+    jint hsize = dstw - srcw + 1;
+    __m256i kscale = _mm256_set1_epi32(0x7fffffff / (hsize * 255));
+    jint y = y0;
+    for (; y + 4 <= y1; y += 4) {
+        const jint *src0 = srcPixels + y * srcscan;
+        const jint *src1 = src0 + srcscan;
+        const jint *src2 = src1 + srcscan;
+        const jint *src3 = src2 + srcscan;
+        jint *dst0 = dstPixels + y * dstscan;
+        jint *dst1 = dst0 + dstscan;
+        jint *dst2 = dst1 + dstscan;
+        jint *dst3 = dst2 + dstscan;
+        __m256i sum01 = _mm256_setzero_si256();
+        __m256i sum23 = _mm256_setzero_si256();
+        for (jint x = 0; x < dstw; x++) {
+            if (x >= hsize) {
+                jint k = x - hsize;
+                sum01 = _mm256_sub_epi32(sum01, avx2_unpack2(src0[k], src1[k]));
+                sum23 = _mm256_sub_epi32(sum23, avx2_unpack2(src2[k], src3[k]));
+            }
+            if (x < srcw) {
+                sum01 = _mm256_add_epi32(sum01, avx2_unpack2(src0[x], src1[x]));
+                sum23 = _mm256_add_epi32(sum23, avx2_unpack2(src2[x], src3[x]));
+            }
+            avx2_pack2(avx2_scale(sum01, kscale), dst0 + x, dst1 + x);
+            avx2_pack2(avx2_scale(sum23, kscale), dst2 + x, dst3 + x);
+        }
+    }
+    boxBlurRows_sse41(dstPixels, dstw, dstscan, srcPixels, srcw, srcscan, y, y1);
+}
+
+// Eight pixels, one channel per lane, to four vectors of two pixels
+AVX2_TARGET static inline void avx2_unpack8(const jint *pixels, __m256i *p)
+{
+    __m256i v = _mm256_loadu_si256((const __m256i *) pixels);
+    __m128i lo = _mm256_castsi256_si128(v);
+    __m128i hi = _mm256_extracti128_si256(v, 1);
+    p[0] = _mm256_cvtepu8_epi32(lo);
+    p[1] = _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8));
+    p[2] = _mm256_cvtepu8_epi32(hi);
+    p[3] = _mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8));
+}
+
+AVX2_TARGET static void boxBlurColumns_avx2(jint *dstPixels, jint dsth, jint dstscan,
+                                            jint *srcPixels, jint srch, jint srcscan,
+                                            jint x0, jint x1)
+{
+    jint vsize = dsth - srch + 1;
+    __m256i kscale = _mm256_set1_epi32(0x7fffffff / (vsize * 255));
+    // The packs interleave the lanes, this puts the pixels back in order
+    __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    __m256i sums[FILTER_COLUMN_BLOCK / 2];
+    for (jint bx = x0; bx < x1; bx += FILTER_COLUMN_BLOCK) {
+        jint groups = ((x1 - bx < FILTER_COLUMN_BLOCK) ? x1 - bx : FILTER_COLUMN_BLOCK) / 8;
+        for (jint i = 0; i < groups * 4; i++) {
+            sums[i] = _mm256_setzero_si256();
+        }
+        for (jint y = 0; y < dsth; y++) {
+            const jint *sub = (y >= vsize) ? srcPixels + (y - vsize) * srcscan + bx : NULL;
+            const jint *add = srcPixels + y * srcscan + bx;
+            jint *dst = dstPixels + y * dstscan + bx;
+            for (jint g = 0; g < groups; g++) {
+                __m256i *s = sums + g * 4;
+                __m256i p[4];
+                if (y >= vsize) {
+                    avx2_unpack8(sub + g * 8, p);
+                    s[0] = _mm256_sub_epi32(s[0], p[0]);
+                    s[1] = _mm256_sub_epi32(s[1], p[1]);
+                    s[2] = _mm256_sub_epi32(s[2], p[2]);
+                    s[3] = _mm256_sub_epi32(s[3], p[3]);
+                }
+                if (y < srch) {
+                    avx2_unpack8(add + g * 8, p);
+                    s[0] = _mm256_add_epi32(s[0], p[0]);
+                    s[1] = _mm256_add_epi32(s[1], p[1]);
+                    s[2] = _mm256_add_epi32(s[2], p[2]);
+                    s[3] = _mm256_add_epi32(s[3], p[3]);
+                }
+                __m256i lo = _mm256_packus_epi32(avx2_scale(s[0], kscale), avx2_scale(s[1], kscale));
+                __m256i hi = _mm256_packus_epi32(avx2_scale(s[2], kscale), avx2_scale(s[3], kscale));
+                __m256i v = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(lo, hi), order);
+                _mm256_storeu_si256((__m256i *) (dst + g * 8), v);
+            }
+        }
+        jint done = bx + groups * 8;
+        if (done < bx + FILTER_COLUMN_BLOCK && done < x1) {
+            boxBlurColumns_sse41(dstPixels, dsth, dstscan, srcPixels, srch, srcscan,
+                                 done, (x1 < bx + FILTER_COLUMN_BLOCK) ? x1 : bx + FILTER_COLUMN_BLOCK);
+        }
+    }
+}
+
+// Inclusive prefix sum of eight lanes
+AVX2_TARGET static inline __m256i avx2_prefix(__m256i v)
+{
+    v = _mm256_add_epi32(v, _mm256_slli_si256(v, 4));
+    v = _mm256_add_epi32(v, _mm256_slli_si256(v, 8));
+    // Carry the total of the low lane into the high lane
+    __m256i carry = _mm256_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm256_add_epi32(v, _mm256_permute2x128_si256(carry, carry, 0x08));
+}
+
+AVX2_TARGET static inline __m256i avx2_alpha(const jint *pixels)
+{
+    return _mm256_srli_epi32(_mm256_loadu_si256((const __m256i *) pixels), 24);
+}
+
+AVX2_TARGET static inline __m256i avx2_shadow_black(__m256i suma, __m256i amin,
+                                                    __m256i amax, __m256i kscale)
+{
+    __m256i v = _mm256_slli_epi32(avx2_scale(suma, kscale), 24);
+    v = _mm256_blendv_epi8(v, _mm256_set1_epi32((jint) 0xff000000), _mm256_cmpgt_epi32(suma, _mm256_sub_epi32(amax, _mm256_set1_epi32(1))));
+    return _mm256_andnot_si256(_mm256_cmpgt_epi32(amin, suma), v);
+}
+
+AVX2_TARGET static void boxShadowRowsBlack_avx2(jint *dstPixels, jint dstw, jint dstscan,
+                                                jint *srcPixels, jint srcw, jint srcscan,
+                                                jfloat spread, jint y0, jint y1)
+{
+    jint hsize = dstw - srcw + 1;
+    jint amax = shadowAmax(hsize, spread);
+    jint kscale = 0x7fffffff / amax;
+    jint amin = (amax / 255);
+    __m256i vamax = _mm256_set1_epi32(amax);
+    __m256i vamin = _mm256_set1_epi32(amin);
+    __m256i vkscale = _mm256_set1_epi32(kscale);
+    for (jint y = y0; y < y1; y++) {
+        const jint *src = srcPixels + y * srcscan;
+        jint *dst = dstPixels + y * dstscan;
+        jint suma = 0;
+        jint x = 0;
+        while (x < dstw) {
+            bool add = x + 8 <= srcw;
+            bool sub = x >= hsize;
+            if (x + 8 <= dstw && (add || x >= srcw) && (sub || x + 8 <= hsize)) {
+                __m256i d = add ? avx2_alpha(src + x) : _mm256_setzero_si256();
+                if (sub) {
+                    d = _mm256_sub_epi32(d, avx2_alpha(src + x - hsize));
+                }
+                __m256i s = _mm256_add_epi32(avx2_prefix(d), _mm256_set1_epi32(suma));
+                suma = _mm256_extract_epi32(s, 7);
+                _mm256_storeu_si256((__m256i *) (dst + x), avx2_shadow_black(s, vamin, vamax, vkscale));
+                x += 8;
+            } else {
+                if (x >= hsize) {
+                    suma -= (src[x - hsize] >> 24) & 0xff;
+                }
+                if (x < srcw) {
+                    suma += (src[x] >> 24) & 0xff;
+                }
+                dst[x] = shadowBlack(suma, amin, amax, kscale);
+                x++;
+            }
+        }
+    }
+}
+
+AVX2_TARGET static void boxShadowColumns_avx2(jint *dstPixels, jint dsth, jint dstscan,
+                                              jint *srcPixels, jint srch, jint srcscan,
+                                              jfloat spread, const jfloat *shadowColor,
+                                              jint x0, jint x1)
+{
+    jint vsize = dsth - srch + 1;
+    jint amax = shadowAmax(vsize, spread);
+    jint kscale = 0x7fffffff / amax;
+    jint amin = (amax / 255);
+    __m256i vamax = _mm256_set1_epi32(amax);
+    __m256i vamin = _mm256_set1_epi32(amin);
+    __m256i ka = _mm256_set1_epi32(kscale);
+    __m256i kr = _mm256_setzero_si256();
+    __m256i kg = _mm256_setzero_si256();
+    __m256i kb = _mm256_setzero_si256();
+    __m256i shadowRGB = _mm256_setzero_si256();
+    if (shadowColor != NULL) {
+        kr = _mm256_set1_epi32((jint) (kscale * shadowColor[0]));
+        kg = _mm256_set1_epi32((jint) (kscale * shadowColor[1]));
+        kb = _mm256_set1_epi32((jint) (kscale * shadowColor[2]));
+        ka = _mm256_set1_epi32((jint) (kscale * shadowColor[3]));
+        shadowRGB = _mm256_set1_epi32(
+            (((jint) (shadowColor[0] * 255)) << 16) |
+            (((jint) (shadowColor[1] * 255)) <<  8) |
+            (((jint) (shadowColor[2] * 255))      ) |
+            (((jint) (shadowColor[3] * 255)) << 24));
+    }
+    __m256i sums[FILTER_COLUMN_BLOCK / 8];
+    for (jint bx = x0; bx < x1; bx += FILTER_COLUMN_BLOCK) {
+        jint groups = ((x1 - bx < FILTER_COLUMN_BLOCK) ? x1 - bx : FILTER_COLUMN_BLOCK) / 8;
+        for (jint g = 0; g < groups; g++) {
+            sums[g] = _mm256_setzero_si256();
+        }
+        for (jint y = 0; y < dsth; y++) {
+            const jint *sub = (y >= vsize) ? srcPixels + (y - vsize) * srcscan + bx : NULL;
+            const jint *add = srcPixels + y * srcscan + bx;
+            jint *dst = dstPixels + y * dstscan + bx;
+            for (jint g = 0; g < groups; g++) {
+                __m256i s = sums[g];
+                if (y >= vsize) {
+                    s = _mm256_sub_epi32(s, avx2_alpha(sub + g * 8));
+                }
+                if (y < srch) {
+                    s = _mm256_add_epi32(s, avx2_alpha(add + g * 8));
+                }
+                sums[g] = s;
+                __m256i v;
+                if (shadowColor == NULL) {
+                    v = avx2_shadow_black(s, vamin, vamax, ka);
+                } else {
+                    v = _mm256_or_si256(
+                            _mm256_or_si256(_mm256_slli_epi32(avx2_scale(s, ka), 24),
+                                            _mm256_slli_epi32(avx2_scale(s, kr), 16)),
+                            _mm256_or_si256(_mm256_slli_epi32(avx2_scale(s, kg), 8),
+                                            avx2_scale(s, kb)));
+                    v = _mm256_blendv_epi8(v, shadowRGB, _mm256_cmpgt_epi32(s, _mm256_sub_epi32(vamax, _mm256_set1_epi32(1))));
+                    v = _mm256_andnot_si256(_mm256_cmpgt_epi32(vamin, s), v);
+                }
+                _mm256_storeu_si256((__m256i *) (dst + g * 8), v);
+            }
+        }
+        jint done = bx + groups * 8;
+        if (done < bx + FILTER_COLUMN_BLOCK && done < x1) {
+            boxShadowColumns_sse41(dstPixels, dsth, dstscan, srcPixels, srch, srcscan,
+                                   spread, shadowColor,
+                                   done, (x1 < bx + FILTER_COLUMN_BLOCK) ? x1 : bx + FILTER_COLUMN_BLOCK);
+        }
+    }
+}
+
+// Eight rows at a time, two rows with their four channels per vector
+AVX2_TARGET static void convolveRows_avx2(jint *dstPixels, jint dstcols, jint dcolinc, jint drowinc,
+                                          jint *srcPixels, jint srccols, jint scolinc, jint srowinc,
+                                          const jfloat *kvals, jint kernelSize, jint r0, jint r1)
+{
+    __m256 cvals[MAX_KERNEL_SIZE][4];
+    __m256 vmin = _mm256_set1_ps(cmin);
+    __m256 vmax = _mm256_set1_ps(cmax);
+    __m256i v255 = _mm256_set1_epi32(255);
+    jint r = r0;
+    for (; r + 8 <= r1; r += 8) {
+        jint dstoff = r * drowinc;
+        jint srcoff = r * srowinc;
+        for (jint i = 0; i < kernelSize; i++) {
+            for (jint j = 0; j < 4; j++) {
+                cvals[i][j] = _mm256_setzero_ps();
+            }
+        }
+        jint koff = kernelSize;
+        for (jint c = 0; c < dstcols; c++) {
+            jint i = kernelSize - koff;
+            for (jint j = 0; j < 4; j++) {
+                jint rgb0 = 0;
+                jint rgb1 = 0;
+                if (c < srccols) {
+                    rgb0 = srcPixels[srcoff + (2 * j) * srowinc];
+                    rgb1 = srcPixels[srcoff + (2 * j + 1) * srowinc];
+                }
+                cvals[i][j] = _mm256_cvtepi32_ps(avx2_unpack2(rgb0, rgb1));
+            }
+            if (--koff <= 0) {
+                koff += kernelSize;
+            }
+            __m256 sum0 = _mm256_setzero_ps();
+            __m256 sum1 = _mm256_setzero_ps();
+            __m256 sum2 = _mm256_setzero_ps();
+            __m256 sum3 = _mm256_setzero_ps();
+            for (i = 0; i < kernelSize; i++) {
+                __m256 factor = _mm256_set1_ps(kvals[koff + i]);
+                sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(cvals[i][0], factor));
+                sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(cvals[i][1], factor));
+                sum2 = _mm256_add_ps(sum2, _mm256_mul_ps(cvals[i][2], factor));
+                sum3 = _mm256_add_ps(sum3, _mm256_mul_ps(cvals[i][3], factor));
+            }
+            __m256 sums[4] = { sum0, sum1, sum2, sum3 };
+            for (jint j = 0; j < 4; j++) {
+                __m256i v = _mm256_cvttps_epi32(sums[j]);
+                v = _mm256_andnot_si256(_mm256_castps_si256(_mm256_cmp_ps(sums[j], vmin, _CMP_LT_OQ)), v);
+                v = _mm256_blendv_epi8(v, v255, _mm256_castps_si256(_mm256_cmp_ps(sums[j], vmax, _CMP_GT_OQ)));
+                avx2_pack2(v, dstPixels + dstoff + (2 * j) * drowinc,
+                              dstPixels + dstoff + (2 * j + 1) * drowinc);
+            }
+            dstoff += dcolinc;
+            srcoff += scolinc;
+        }
+    }
+    convolveRows_sse41(dstPixels, dstcols, dcolinc, drowinc,
+                       srcPixels, srccols, scolinc, srowinc,
+                       kvals, kernelSize, r, r1);
+}
+
+// Sixteen rows at a time, one row per lane
+AVX2_TARGET static void convolveShadowRows_avx2(jint *dstPixels, jint dstcols, jint dcolinc, jint drowinc,
+                                                jint *srcPixels, jint srccols, jint scolinc, jint srowinc,
+                                                const jfloat *kvals, jint kernelSize, const jint *shadowRGBs,
+                                                jint r0, jint r1)
+{
+    __m256 avals[MAX_KERNEL_SIZE][2];
+    jint r = r0;
+    for (; r + 16 <= r1; r += 16) {
+        jint dstoff = r * drowinc;
+        jint srcoff = r * srowinc;
+        for (jint i = 0; i < kernelSize; i++) {
+            avals[i][0] = _mm256_setzero_ps();
+            avals[i][1] = _mm256_setzero_ps();
+        }
+        jint koff = kernelSize;
+        for (jint c = 0; c < dstcols; c++) {
+            jint rgb[16];
+            for (jint j = 0; j < 16; j++) {
+                rgb[j] = (c < srccols) ? srcPixels[srcoff + j * srowinc] : 0;
+            }
+            jint i = kernelSize - koff;
+            avals[i][0] = _mm256_cvtepi32_ps(_mm256_srli_epi32(_mm256_loadu_si256((const __m256i *) rgb), 24));
+            avals[i][1] = _mm256_cvtepi32_ps(_mm256_srli_epi32(_mm256_loadu_si256((const __m256i *) (rgb + 8)), 24));
+            if (--koff <= 0) {
+                koff += kernelSize;
+            }
+            __m256 sum0 = _mm256_set1_ps(-0.5f);
+            __m256 sum1 = sum0;
+            for (i = 0; i < kernelSize; i++) {
+                __m256 factor = _mm256_set1_ps(kvals[koff + i]);
+                sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(avals[i][0], factor));
+                sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(avals[i][1], factor));
+            }
+            jfloat sums[16];
+            _mm256_storeu_ps(sums, sum0);
+            _mm256_storeu_ps(sums + 8, sum1);
+            for (jint j = 0; j < 16; j++) {
+                dstPixels[dstoff + j * drowinc] = convolveShadow(sums[j], shadowRGBs);
+            }
+            dstoff += dcolinc;
+            srcoff += scolinc;
+        }
+    }
+    convolveShadowRows_sse41(dstPixels, dstcols, dcolinc, drowinc,
+                             srcPixels, srccols, scolinc, srowinc,
+                             kvals, kernelSize, shadowRGBs, r, r1);
+}
+
+static jint cpuSIMDLevel()
+{
+#if defined(_MSC_VER)
+    int info[4];
+
+    __cpuid(info, 0);
+    jint maxLeaf = info[0];
+    if (maxLeaf < 1) {
+        return DECORA_SIMD_C;
+    }
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 19)) == 0) {
+        return DECORA_SIMD_C;
+    }
+    // AVX and OSXSAVE, and the OS saves the YMM registers
+    if (maxLeaf < 7 || (info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 ||
+        (_xgetbv(0) & 6) != 6) {
+        return DECORA_SIMD_SSE41;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) ? DECORA_SIMD_AVX2 : DECORA_SIMD_SSE41;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return DECORA_SIMD_AVX2;
+    }
+    return __builtin_cpu_supports("sse4.1") ? DECORA_SIMD_SSE41 : DECORA_SIMD_C;
+#endif
+}
+#else
+static jint cpuSIMDLevel()
+{
+    return DECORA_SIMD_C;
+}
+#endif // ENABLE_SIMD_X86
+
+static volatile jint simdLevel = -1;
+
+jint getSIMDLevel()
+{
+    jint level = simdLevel;
+    if (level < 0) {
+        level = cpuSIMDLevel();
+        simdLevel = level;
+    }
+    return level;
+}
+
+void setSIMDLevel(jint level)
+{
+    jint cpuLevel = cpuSIMDLevel();
+    simdLevel = (level < cpuLevel) ? level : cpuLevel;
+}
+
+#if ENABLE_SIMD_X86
+#define DISPATCH(name, args)                        \
+    switch (getSIMDLevel()) {                       \
+        case DECORA_SIMD_AVX2:  name##_avx2 args;  break; \
+        case DECORA_SIMD_SSE41: name##_sse41 args; break; \
+        default:                name##_c args;     break; \
+    }
+#else
+#define DISPATCH(name, args) name##_c args;
+#endif
+
+void boxBlurRows(jint *dstPixels, jint dstw, jint dstscan,
+                 jint *srcPixels, jint srcw, jint srcscan,
+                 jint y0, jint y1)
+{
+    DISPATCH(boxBlurRows, (dstPixels, dstw, dstscan, srcPixels, srcw, srcscan, y0, y1))
+}
+
+void boxBlurColumns(jint *dstPixels, jint dsth, jint dstscan,
+                    jint *srcPixels, jint srch, jint srcscan,
+                    jint x0, jint x1)
+{
+    DISPATCH(boxBlurColumns, (dstPixels, dsth, dstscan, srcPixels, srch, srcscan, x0, x1))
+}
+
+void boxShadowRowsBlack(jint *dstPixels, jint dstw, jint dstscan,
+                        jint *srcPixels, jint srcw, jint srcscan,
+                        jfloat spread, jint y0, jint y1)
+{
+    DISPATCH(boxShadowRowsBlack, (dstPixels, dstw, dstscan, srcPixels, srcw, srcscan,
+                                  spread, y0, y1))
+}
+
+void boxShadowColumns(jint *dstPixels, jint dsth, jint dstscan,
+                      jint *srcPixels, jint srch, jint srcscan,
+                      jfloat spread, const jfloat *shadowColor,
+                      jint x0, jint x1)
+{
+    DISPATCH(boxShadowColumns, (dstPixels, dsth, dstscan, srcPixels, srch, srcscan,
+                                spread, shadowColor, x0, x1))
+}
+
+void convolveRows(jint *dstPixels, jint dstcols, jint dcolinc, jint drowinc,
+                  jint *srcPixels, jint srccols, jint scolinc, jint srowinc,
+                  const jfloat *kvals, jint kernelSize, jint r0, jint r1)
+{
+    DISPATCH(convolveRows, (dstPixels, dstcols, dcolinc, drowinc,
+                            srcPixels, srccols, scolinc, srowinc,
+                            kvals, kernelSize, r0, r1))
+}
+
+void convolveShadowRows(jint *dstPixels, jint dstcols, jint dcolinc, jint drowinc,
+                        jint *srcPixels, jint srccols, jint scolinc, jint srowinc,
+                        const jfloat *kvals, jint kernelSize, const jint *shadowRGBs,
+                        jint r0, jint r1)
+{
+    DISPATCH(convolveShadowRows, (dstPixels, dstcols, dcolinc, drowinc,
+                                  srcPixels, srccols, scolinc, srowinc,
+                                  kvals, kernelSize, shadowRGBs, r0, r1))
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef _Included_SSEFilters
+#define _Included_SSEFilters
+
+#include <jni.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*
+ * The separable blur and shadow filters of the SSE peers, working on raw
+ * pixel arrays. Each function handles a range of the independent rows or
+ * columns of one pass so that a pass can be split across the worker pool
+ * with parallelFor. The SIMD versions are picked at runtime and produce
+ * the same pixels as the scalar loops.
+ */
+
+/*
+ * Split sizes for parallelFor: the vertical passes keep the sums of blocks
+ * of this many columns, and the SIMD convolutions filter groups of up to
+ * this many rows.
+ */
+#define FILTER_COLUMN_BLOCK 64
+#define FILTER_ROW_GROUP    16
+
+#define DECORA_SIMD_C     0
+#define DECORA_SIMD_SSE41 1
+#define DECORA_SIMD_AVX2  2
+
+/* Returns the best SIMD level of this CPU, or the level set last. */
+jint getSIMDLevel();
+
+/* Caps the SIMD level, for testing and benchmarking. */
+void setSIMDLevel(jint level);
+
+/*
+ * Calls body for consecutive subranges of [0, count), on the calling thread
+ * and on a small pool of native worker threads, and returns when all of them
+ * are done. Subranges start at multiples of grain. When work, a rough count
+ * of the basic operations, is small the whole range runs on the caller.
+ */
+typedef void (*ParallelBody)(void *ctx, jint start, jint end);
+
+void parallelFor(jint count, jint grain, jlong work, ParallelBody body, void *ctx);
+
+/* Box blur along rows y0 to y1 - 1, hsize is dstw - srcw + 1. */
+void boxBlurRows(jint *dstPixels, jint dstw, jint dstscan,
+                 jint *srcPixels, jint srcw, jint srcscan,
+                 jint y0, jint y1);
+
+/* Box blur along columns x0 to x1 - 1, vsize is dsth - srch + 1. */
+void boxBlurColumns(jint *dstPixels, jint dsth, jint dstscan,
+                    jint *srcPixels, jint srch, jint srcscan,
+                    jint x0, jint x1);
+
+/* Box shadow along rows y0 to y1 - 1, producing black with the blurred alpha. */
+void boxShadowRowsBlack(jint *dstPixels, jint dstw, jint dstscan,
+                        jint *srcPixels, jint srcw, jint srcscan,
+                        jfloat spread, jint y0, jint y1);
+
+/*
+ * Box shadow along columns x0 to x1 - 1. With a NULL shadowColor the result
+ * is black, otherwise the blurred alpha scales the color.
+ */
+void boxShadowColumns(jint *dstPixels, jint dsth, jint dstscan,
+                      jint *srcPixels, jint srch, jint srcscan,
+                      jfloat spread, const jfloat *shadowColor,
+                      jint x0, jint x1);
+
+/*
+ * Convolves rows r0 to r1 - 1 with the kernel kvals, which holds the
+ * kernelSize weights twice. Rows and columns are as in the filterHV
+ * methods of the peers.
+ */
+void convolveRows(jint *dstPixels, jint dstcols, jint dcolinc, jint drowinc,
+                  jint *srcPixels, jint srccols, jint scolinc, jint srowinc,
+                  const jfloat *kvals, jint kernelSize, jint r0, jint r1);
+
+/* As convolveRows on the alpha channel, mapping the result through shadowRGBs. */
+void convolveShadowRows(jint *dstPixels, jint dstcols, jint dcolinc, jint drowinc,
+                        jint *srcPixels, jint srccols, jint scolinc, jint srowinc,
+                        const jfloat *kvals, jint kernelSize, const jint *shadowRGBs,
+                        jint r0, jint r1);
+
+#ifdef __cplusplus
+};
+#endif /* __cplusplus */
+
+#endif /* _Included_SSEFilters */
@@ -31,6 +31,7 @@
 #include <jni.h>
 #include <math.h>
 #include "SSEUtils.h"
+#include "SSEFilters.h"
 #include "com_sun_scenario_effect_impl_sw_sse_SSELinearConvolvePeer.h"
 
 #define cmin 1.0f
@@ -38,6 +39,87 @@
 
 #define fvaltobyte(f) (((f) < cmin) ? 0 : (((f) > cmax) ? 255 : ((jint) (f))))
 
+struct VectorPass {
+    jint *dstPixels;
+    jint dstw, dstscan;
+    jint *srcPixels;
+    jint srcw, srch, srcscan;
+    jfloat *weights;
+    jint count;
+    jfloat srcx0, srcy0;
+    jfloat offsetx, offsety;
+    jfloat deltax, deltay;
+    jfloat dxcol, dycol, dxrow, dyrow;
+};
+
+static void filterVectorRows(void *ctx, jint dy0, jint dy1)
+{
+    VectorPass *pass = (VectorPass *) ctx;
+    jint *srcPixels = pass->srcPixels;
+    jint *dstPixels = pass->dstPixels;
+    jint srcw = pass->srcw;
+    jint srch = pass->srch;
+    jint srcscan = pass->srcscan;
+    jint count = pass->count;
+    jfloat *weights = pass->weights;
+    jfloat offsetx = pass->offsetx;
+    jfloat offsety = pass->offsety;
+    jfloat deltax = pass->deltax;
+    jfloat deltay = pass->deltay;
+    jfloat dxcol = pass->dxcol;
+    jfloat dycol = pass->dycol;
+    // Step to the first row the same way as a single pass would
+    jfloat srcx0 = pass->srcx0;
+    jfloat srcy0 = pass->srcy0;
+    for (jint dy = 0; dy < dy0; dy++) {
+        srcx0 += pass->dxrow;
+        srcy0 += pass->dyrow;
+    }
+    jint dstrow = dy0 * pass->dstscan;
+    for (jint dy = dy0; dy < dy1; dy++) {
+        jfloat srcx = srcx0;
+        jfloat srcy = srcy0;
+        for (jint dx = 0; dx < pass->dstw; dx++) {
+            jfloat fvals[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            jfloat sampx = srcx + offsetx;
+            jfloat sampy = srcy + offsety;
+            for (jint i = 0; i < count; ++i) {
+                laccumsample(srcPixels, sampx, sampy, srcw, srch, srcscan,
+                             weights[i], fvals);
+                sampx += deltax;
+                sampy += deltay;
+            }
+            dstPixels[dstrow + dx] =
+                (fvaltobyte(fvals[FVAL_A]) << 24) +
+                (fvaltobyte(fvals[FVAL_R]) << 16) +
+                (fvaltobyte(fvals[FVAL_G]) <<  8) +
+                (fvaltobyte(fvals[FVAL_B])      );
+            srcx += dxcol;
+            srcy += dycol;
+        }
+        srcx0 += pass->dxrow;
+        srcy0 += pass->dyrow;
+        dstrow += pass->dstscan;
+    }
+}
+
+struct ConvolvePass {
+    jint *dstPixels;
+    jint dstcols, dcolinc, drowinc;
+    jint *srcPixels;
+    jint srccols, scolinc, srowinc;
+    jfloat *kvals;
+    jint kernelSize;
+};
+
+static void filterHVRows(void *ctx, jint r0, jint r1)
+{
+    ConvolvePass *pass = (ConvolvePass *) ctx;
+    convolveRows(pass->dstPixels, pass->dstcols, pass->dcolinc, pass->drowinc,
+                 pass->srcPixels, pass->srccols, pass->scolinc, pass->srowinc,
+                 pass->kvals, pass->kernelSize, r0, r1);
+}
+
 JNIEXPORT void JNICALL
 Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolvePeer_filterVector
     (JNIEnv *env, jobject lcpthis,
@@ -61,35 +143,13 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolvePeer_filterVector
         return;
     }
 
-    jint dstrow = 0;
     // srcxy0 point at UL corner, shift them to center of 1st dest pixel:
     srcx0 += (dxrow + dxcol) * 0.5f;
     srcy0 += (dyrow + dycol) * 0.5f;
-    for (jint dy = 0; dy < dsth; dy++) {
-        jfloat srcx = srcx0;
-        jfloat srcy = srcy0;
-        for (jint dx = 0; dx < dstw; dx++) {
-            jfloat fvals[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
-            jfloat sampx = srcx + offsetx;
-            jfloat sampy = srcy + offsety;
-            for (jint i = 0; i < count; ++i) {
-                laccumsample(srcPixels, sampx, sampy, srcw, srch, srcscan,
-                             weights[i], fvals);
-                sampx += deltax;
-                sampy += deltay;
-            }
-            dstPixels[dstrow + dx] =
-                (fvaltobyte(fvals[FVAL_A]) << 24) +
-                (fvaltobyte(fvals[FVAL_R]) << 16) +
-                (fvaltobyte(fvals[FVAL_G]) <<  8) +
-                (fvaltobyte(fvals[FVAL_B])      );
-            srcx += dxcol;
-            srcy += dycol;
-        }
-        srcx0 += dxrow;
-        srcy0 += dyrow;
-        dstrow += dstscan;
-    }
+    VectorPass pass = { dstPixels, dstw, dstscan, srcPixels, srcw, srch, srcscan,
+                        weights, count, srcx0, srcy0, offsetx, offsety,
+                        deltax, deltay, dxcol, dycol, dxrow, dyrow };
+    parallelFor(dsth, 1, (jlong) dstw * dsth * count, filterVectorRows, &pass);
 
     env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
     env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
@@ -130,55 +190,11 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolvePeer_filterHV
         return;
     }
 
-    // cvals stores the component values from the surrounding K pixels
-    // from x-r to x+r
-    jfloat cvals[128*4];
-    jint dstrow = 0;
-    jint srcrow = 0;
-    for (jint r = 0; r < dstrows; r++) {
-        jint dstoff = dstrow;
-        jint srcoff = srcrow;
-        // Must clear out the array at the start of every line
-        // Might be able to rely on the fact that the previous line must
-        // have run out of data towards the end of the scan line, though.
-        for (jint i = 0; i < kernelSize*4; i++) {
-            cvals[i] = 0.0f;
-        }
-        jint koff = kernelSize;
-        for (jint c = 0; c < dstcols; c++) {
-            // Load the data for this x location into the array.
-            jint i = (kernelSize - koff) * 4;
-            jint rgb = (c < srccols) ? srcPixels[srcoff] : 0;
-            cvals[i+0] = (jfloat) ((rgb >> 24) & 0xff);
-            cvals[i+1] = (jfloat) ((rgb >> 16) & 0xff);
-            cvals[i+2] = (jfloat) ((rgb >>  8) & 0xff);
-            cvals[i+3] = (jfloat) ((rgb      ) & 0xff);
-            // Bump the koff to the next spot to align the coefficients.
-            if (--koff <= 0) {
-                koff += kernelSize;
-            }
-            jfloat suma = 0.0f;
-            jfloat sumr = 0.0f;
-            jfloat sumg = 0.0f;
-            jfloat sumb = 0.0f;
-            for (i = 0; i < kernelSize*4; i += 4) {
-                jfloat factor = kvals[koff + (i>>2)];
-                suma += cvals[i+0] * factor;
-                sumr += cvals[i+1] * factor;
-                sumg += cvals[i+2] * factor;
-                sumb += cvals[i+3] * factor;
-            }
-            dstPixels[dstoff] =
-                (((suma < cmin) ? 0 : ((suma > cmax) ? 255 : ((jint) suma))) << 24) +
-                (((sumr < cmin) ? 0 : ((sumr > cmax) ? 255 : ((jint) sumr))) << 16) +
-                (((sumg < cmin) ? 0 : ((sumg > cmax) ? 255 : ((jint) sumg))) <<  8) +
-                (((sumb < cmin) ? 0 : ((sumb > cmax) ? 255 : ((jint) sumb)))      );
-            dstoff += dcolinc;
-            srcoff += scolinc;
-        }
-        dstrow += drowinc;
-        srcrow += srowinc;
-    }
+    // Rows are independent, they are convolved in parallel
+    ConvolvePass pass = { dstPixels, dstcols, dcolinc, drowinc,
+                          srcPixels, srccols, scolinc, srowinc, kvals, kernelSize };
+    parallelFor(dstrows, FILTER_ROW_GROUP, (jlong) dstcols * dstrows * kernelSize,
+                filterHVRows, &pass);
 
     env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
     env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
@@ -31,45 +31,55 @@
 #include <jni.h>
 #include <math.h>
 #include "SSEUtils.h"
+#include "SSEFilters.h"
 #include "com_sun_scenario_effect_impl_sw_sse_SSELinearConvolveShadowPeer.h"
 
 #define cmin 1.0f
 #define cmax (255.0f - 1.0f/32.0f)
 
-JNIEXPORT void JNICALL
-Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolveShadowPeer_filterVector
-    (JNIEnv *env, jclass klass,
-     jintArray dstPixels_arr, jint dstw, jint dsth, jint dstscan,
-     jintArray srcPixels_arr, jint srcw, jint srch, jint srcscan,
-     jfloatArray weights_arr, jint count,
-     jfloat srcx0, jfloat srcy0,
-     jfloat offsetx, jfloat offsety,
-     jfloat deltax, jfloat deltay,
-     jfloatArray shadowColor_arr,
-     jfloat dxcol, jfloat dycol, jfloat dxrow, jfloat dyrow)
-{
-    if (count > 128) return;
-    jfloat weights[128];
-    env->GetFloatArrayRegion(weights_arr, 0, count, weights);
-    jfloat shadowColor[4];
-    env->GetFloatArrayRegion(shadowColor_arr, 0, 4, shadowColor);
+struct VectorPass {
+    jint *dstPixels;
+    jint dstw, dstscan;
+    jint *srcPixels;
+    jint srcw, srch, srcscan;
+    jfloat *weights;
+    jint count;
+    jfloat srcx0, srcy0;
+    jfloat offsetx, offsety;
+    jfloat deltax, deltay;
+    jfloat *shadowColor;
+    jfloat dxcol, dycol, dxrow, dyrow;
+};
 
-    jint *srcPixels = (jint *)env->GetPrimitiveArrayCritical(srcPixels_arr, 0);
-    if (srcPixels == NULL) return;
-    jint *dstPixels = (jint *)env->GetPrimitiveArrayCritical(dstPixels_arr, 0);
-    if (dstPixels == NULL) {
-        env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
-        return;
+static void filterVectorRows(void *ctx, jint dy0, jint dy1)
+{
+    VectorPass *pass = (VectorPass *) ctx;
+    jint *srcPixels = pass->srcPixels;
+    jint *dstPixels = pass->dstPixels;
+    jint srcw = pass->srcw;
+    jint srch = pass->srch;
+    jint srcscan = pass->srcscan;
+    jint count = pass->count;
+    jfloat *weights = pass->weights;
+    jfloat *shadowColor = pass->shadowColor;
+    jfloat offsetx = pass->offsetx;
+    jfloat offsety = pass->offsety;
+    jfloat deltax = pass->deltax;
+    jfloat deltay = pass->deltay;
+    jfloat dxcol = pass->dxcol;
+    jfloat dycol = pass->dycol;
+    // Step to the first row the same way as a single pass would
+    jfloat srcx0 = pass->srcx0;
+    jfloat srcy0 = pass->srcy0;
+    for (jint dy = 0; dy < dy0; dy++) {
+        srcx0 += pass->dxrow;
+        srcy0 += pass->dyrow;
     }
-
-    jint dstrow = 0;
-    // srcxy0 point at UL corner, shift them to center of 1st dest pixel:
-    srcx0 += (dxrow + dxcol) * 0.5f;
-    srcy0 += (dyrow + dycol) * 0.5f;
-    for (jint dy = 0; dy < dsth; dy++) {
+    jint dstrow = dy0 * pass->dstscan;
+    for (jint dy = dy0; dy < dy1; dy++) {
         jfloat srcx = srcx0;
         jfloat srcy = srcy0;
-        for (jint dx = 0; dx < dstw; dx++) {
+        for (jint dx = 0; dx < pass->dstw; dx++) {
             jfloat sum = 0.0f;
             jfloat sampx = srcx + offsetx;
             jfloat sampy = srcy + offsety;
@@ -94,11 +104,64 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolveShadowPeer_filterVecto
             srcx += dxcol;
             srcy += dycol;
         }
-        srcx0 += dxrow;
-        srcy0 += dyrow;
-        dstrow += dstscan;
+        srcx0 += pass->dxrow;
+        srcy0 += pass->dyrow;
+        dstrow += pass->dstscan;
+    }
+}
+
+struct ConvolveShadowPass {
+    jint *dstPixels;
+    jint dstcols, dcolinc, drowinc;
+    jint *srcPixels;
+    jint srccols, scolinc, srowinc;
+    jfloat *kvals;
+    jint kernelSize;
+    jint *shadowRGBs;
+};
+
+static void filterHVRows(void *ctx, jint r0, jint r1)
+{
+    ConvolveShadowPass *pass = (ConvolveShadowPass *) ctx;
+    convolveShadowRows(pass->dstPixels, pass->dstcols, pass->dcolinc, pass->drowinc,
+                       pass->srcPixels, pass->srccols, pass->scolinc, pass->srowinc,
+                       pass->kvals, pass->kernelSize, pass->shadowRGBs, r0, r1);
+}
+
+JNIEXPORT void JNICALL
+Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolveShadowPeer_filterVector
+    (JNIEnv *env, jclass klass,
+     jintArray dstPixels_arr, jint dstw, jint dsth, jint dstscan,
+     jintArray srcPixels_arr, jint srcw, jint srch, jint srcscan,
+     jfloatArray weights_arr, jint count,
+     jfloat srcx0, jfloat srcy0,
+     jfloat offsetx, jfloat offsety,
+     jfloat deltax, jfloat deltay,
+     jfloatArray shadowColor_arr,
+     jfloat dxcol, jfloat dycol, jfloat dxrow, jfloat dyrow)
+{
+    if (count > 128) return;
+    jfloat weights[128];
+    env->GetFloatArrayRegion(weights_arr, 0, count, weights);
+    jfloat shadowColor[4];
+    env->GetFloatArrayRegion(shadowColor_arr, 0, 4, shadowColor);
+
+    jint *srcPixels = (jint *)env->GetPrimitiveArrayCritical(srcPixels_arr, 0);
+    if (srcPixels == NULL) return;
+    jint *dstPixels = (jint *)env->GetPrimitiveArrayCritical(dstPixels_arr, 0);
+    if (dstPixels == NULL) {
+        env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
+        return;
     }
 
+    // srcxy0 point at UL corner, shift them to center of 1st dest pixel:
+    srcx0 += (dxrow + dxcol) * 0.5f;
+    srcy0 += (dyrow + dycol) * 0.5f;
+    VectorPass pass = { dstPixels, dstw, dstscan, srcPixels, srcw, srch, srcscan,
+                        weights, count, srcx0, srcy0, offsetx, offsety,
+                        deltax, deltay, shadowColor, dxcol, dycol, dxrow, dyrow };
+    parallelFor(dsth, 1, (jlong) dstw * dsth * count, filterVectorRows, &pass);
+
     env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
     env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
 }
@@ -147,43 +210,12 @@ Java_com_sun_scenario_effect_impl_sw_sse_SSELinearConvolveShadowPeer_filterHV
         return;
     }
 
-    // avals stores the alpha values from the surrounding K pixels
-    // from x-r to x+r
-    jfloat avals[128];
-    jint dstrow = 0;
-    jint srcrow = 0;
-    for (jint r = 0; r < dstrows; r++) {
-        jint dstoff = dstrow;
-        jint srcoff = srcrow;
-        // Must clear out the array at the start of every line
-        // Might be able to rely on the fact that the previous line must
-        // have run out of data towards the end of the scan line, though.
-        for (jint i = 0; i < kernelSize; i++) {
-            avals[i] = 0.0f;
-        }
-        jint koff = kernelSize;
-        for (jint c = 0; c < dstcols; c++) {
-            // Load the data for this x location into the array.
-            jint rgb = (c < srccols) ? srcPixels[srcoff] : 0;
-            avals[kernelSize - koff] = (jfloat) ((rgb >> 24) & 0xff);
-            // Bump the koff to the next spot to align the coefficients.
-            if (--koff <= 0) {
-                koff += kernelSize;
-            }
-            jfloat sum = -0.5f;
-            for (jint i = 0; i < kernelSize; i++) {
-                sum += avals[i] * kvals[koff + i];
-            }
-            dstPixels[dstoff] =
-                ((sum < 0.0f) ? 0
-                 : ((sum >= 254.0f) ? shadowRGBs[255]
-                    : shadowRGBs[((jint) sum) + 1]));
-            dstoff += dcolinc;
-            srcoff += scolinc;
-        }
-        dstrow += drowinc;
-        srcrow += srowinc;
-    }
+    // Rows are independent, they are convolved in parallel
+    ConvolveShadowPass pass = { dstPixels, dstcols, dcolinc, drowinc,
+                                srcPixels, srccols, scolinc, srowinc,
+                                kvals, kernelSize, shadowRGBs };
+    parallelFor(dstrows, FILTER_ROW_GROUP, (jlong) dstcols * dstrows * kernelSize,
+                filterHVRows, &pass);
 
     env->ReleasePrimitiveArrayCritical(dstPixels_arr, dstPixels, 0);
     env->ReleasePrimitiveArrayCritical(srcPixels_arr, srcPixels, JNI_ABORT);
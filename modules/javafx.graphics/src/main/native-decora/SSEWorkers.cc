@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "SSEFilters.h"
+
+/*
+ * A small pool of native threads sharing the rows or columns of one filter
+ * pass with the calling thread. Passes are rendered one at a time; a pass
+ * started while another one runs, which is rare, runs on its caller alone.
+ */
+
+// Workers besides the calling thread
+#define MAX_WORKERS 7
+
+// Less work than this is not worth waking the workers
+#define MIN_PARALLEL_WORK (1 << 18)
+
+// Subranges per thread, so that uneven progress still balances out
+#define CHUNKS_PER_THREAD 4
+
+namespace {
+
+struct Job {
+    ParallelBody body;
+    void *ctx;
+    jint count;
+    jint chunk;
+    std::atomic<jint> next;
+};
+
+class WorkerPool {
+public:
+    // Never destroyed, the detached workers still wait on it at exit
+    static WorkerPool &instance() {
+        static WorkerPool *pool = new WorkerPool();
+        return *pool;
+    }
+
+    jint threads() const {
+        return workers + 1;
+    }
+
+    void run(Job *job) {
+        std::unique_lock<std::mutex> passLock(passMutex, std::try_to_lock);
+        if (!passLock.owns_lock()) {
+            runChunks(job);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            current = job;
+            generation++;
+        }
+        wake.notify_all();
+
+        runChunks(job);
+
+        // Workers that have not picked the job up yet find it gone and skip it
+        std::unique_lock<std::mutex> guard(mutex);
+        idle.wait(guard, [this] { return busy == 0; });
+        current = NULL;
+    }
+
+private:
+    WorkerPool() : current(NULL), generation(0), busy(0), workers(0) {
+        unsigned int cpus = std::thread::hardware_concurrency();
+        jint count = (cpus > 1) ? (jint) cpus - 1 : 0;
+        if (count > MAX_WORKERS) {
+            count = MAX_WORKERS;
+        }
+        for (jint i = 0; i < count; i++) {
+            try {
+                std::thread(&WorkerPool::work, this).detach();
+                workers++;
+            } catch (...) {
+                break;
+            }
+        }
+    }
+
+    static void runChunks(Job *job) {
+        jint start;
+        while ((start = job->next.fetch_add(job->chunk)) < job->count) {
+            jint end = (job->count - start > job->chunk) ? start + job->chunk : job->count;
+            job->body(job->ctx, start, end);
+        }
+    }
+
+    void work() {
+        unsigned int seen = 0;
+        std::unique_lock<std::mutex> guard(mutex);
+        for (;;) {
+            wake.wait(guard, [this, seen] { return generation != seen; });
+            seen = generation;
+            Job *job = current;
+            if (job == NULL) {
+                continue;
+            }
+            busy++;
+            guard.unlock();
+            runChunks(job);
+            guard.lock();
+            if (--busy == 0) {
+                idle.notify_all();
+            }
+        }
+    }
+
+    std::mutex passMutex;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    Job *current;
+    unsigned int generation;
+    jint busy;
+    jint workers;
+};
+
+} // namespace
+
+void parallelFor(jint count, jint grain, jlong work, ParallelBody body, void *ctx)
+{
+    if (count <= 0) {
+        return;
+    }
+    if (work < MIN_PARALLEL_WORK || count <= grain) {
+        body(ctx, 0, count);
+        return;
+    }
+
+    WorkerPool &pool = WorkerPool::instance();
+    jint chunks = pool.threads() * CHUNKS_PER_THREAD;
+    jint chunk = (count + chunks - 1) / chunks;
+    chunk = ((chunk + grain - 1) / grain) * grain;
+    if (pool.threads() == 1 || chunk >= count) {
+        body(ctx, 0, count);
+        return;
+    }
+
+    Job job;
+    job.body = body;
+    job.ctx = ctx;
+    job.count = count;
+    job.chunk = chunk;
+    job.next = 0;
+    pool.run(&job);
+}
@@ -34,8 +34,11 @@
 #include <sys/mman.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <errno.h>
 #include <limits.h>
+#include <stdint.h>
 
+#include <dirent.h>
 #include <dlfcn.h>
 #include <fontconfig/fontconfig.h>
 
@@ -170,6 +173,7 @@ typedef FcCharSet* (*FcCharSetUnionFuncType)(const FcCharSet *a,
                                              const FcCharSet *b);
 typedef FcChar32 (*FcCharSetSubtractCountFuncType)(const FcCharSet *a,
                                                    const FcCharSet *b);
+typedef int (*FcGetVersionFuncType)();
 
 JNIEXPORT jboolean JNICALL
 Java_com_sun_javafx_font_FontConfigManager_getFontConfig
@@ -319,7 +323,7 @@ Java_com_sun_javafx_font_FontConfigManager_getFontConfig
         FcFontSetDestroy     == NULL ||
         FcCharSetUnion       == NULL ||
         FcCharSetSubtractCount == NULL) {/* problem with the library: return.*/
-        closeFontConfig(libfontconfig, JNI_FALSE);
+        closeFontConfig(libfontconfig, hashPath);
         return JNI_FALSE;
     }
 
@@ -347,7 +351,7 @@ Java_com_sun_javafx_font_FontConfigManager_getFontConfig
         pattern = (*FcNameParse)((FcChar8 *)fcName);
         if (pattern == NULL) {
             (*env)->ReleaseStringUTFChars(env, fcNameStr, (const char*)fcName);
-            closeFontConfig(libfontconfig, JNI_FALSE);
+            closeFontConfig(libfontconfig, hashPath);
             return JNI_FALSE;
         }
 
@@ -365,7 +369,7 @@ Java_com_sun_javafx_font_FontConfigManager_getFontConfig
         if (fontset == NULL) {
             (*FcPatternDestroy)(pattern);
             (*env)->ReleaseStringUTFChars(env, fcNameStr, (const char*)fcName);
-            closeFontConfig(libfontconfig, JNI_FALSE);
+            closeFontConfig(libfontconfig, hashPath);
             return JNI_FALSE;
         }
 
@@ -397,7 +401,7 @@ Java_com_sun_javafx_font_FontConfigManager_getFontConfig
             (*FcPatternDestroy)(pattern);
             (*FcFontSetDestroy)(fontset);
             (*env)->ReleaseStringUTFChars(env, fcNameStr, (const char*)fcName);
-            closeFontConfig(libfontconfig, JNI_FALSE);
+            closeFontConfig(libfontconfig, hashPath);
             return JNI_FALSE;
         }
         fontCount = 0;
@@ -426,7 +430,7 @@ Java_com_sun_javafx_font_FontConfigManager_getFontConfig
                 (*FcFontSetDestroy)(fontset);
                 (*env)->ReleaseStringUTFChars(env,
                                               fcNameStr, (const char*)fcName);
-                closeFontConfig(libfontconfig, JNI_FALSE);
+                closeFontConfig(libfontconfig, hashPath);
                 return JNI_FALSE;
             }
 
@@ -537,18 +541,527 @@ Java_com_sun_javafx_font_FontConfigManager_getFontConfig
     if (locale) {
         (*env)->ReleaseStringUTFChars (env, localeStr, (const char*)locale);
     }
-    closeFontConfig(libfontconfig, JNI_TRUE);
+    closeFontConfig(libfontconfig, hashFontTree);
     return JNI_TRUE;
 }
 
 
+/*
+ * State needed to add a font to the maps passed to populateMapsNative.
+ */
+typedef struct {
+    jobject fontToFileMap;
+    jobject fontToFamilyNameMap;
+    jobject familyToFontListMap;
+    jobject locale;
+    jclass arrayListClass;
+    jmethodID arrayListCtr, addMID, getMID, putMID, toLowerCaseMID;
+    jboolean debugFC;
+} FontMaps;
+
+/*
+ * Adds one font to the maps. Returns JNI_FALSE only if a Java exception
+ * is pending, fonts that cannot be added are skipped.
+ */
+static jboolean addFontToMaps(JNIEnv *env, FontMaps *maps,
+                              const char *file, const char *family,
+                              const char *fullName)
+{
+    jstring jFileStr;
+    jstring jFamilyStr, jFamilyStrLC;
+    jstring jFullNameStr, jFullNameStrLC;
+    jobject jList;
+    jboolean debugFC = maps->debugFC;
+
+    jFileStr = (*env)->NewStringUTF(env, file);
+    jFamilyStr = (*env)->NewStringUTF(env, family);
+    jFullNameStr = (*env)->NewStringUTF(env, fullName);
+
+    if (jFileStr == NULL || jFamilyStr == NULL || jFullNameStr == NULL) {
+        if (debugFC) {
+            fprintf(stderr,"Failed to create string object");
+        }
+        return JNI_TRUE;
+    }
+
+    jFamilyStrLC = (*env)->CallObjectMethod(env, jFamilyStr,
+                                            maps->toLowerCaseMID, maps->locale);
+    if ((*env)->ExceptionOccurred(env)) {
+        return JNI_FALSE;
+    }
+    jFullNameStrLC = (*env)->CallObjectMethod(env, jFullNameStr,
+                                              maps->toLowerCaseMID, maps->locale);
+    if ((*env)->ExceptionOccurred(env)) {
+        return JNI_FALSE;
+    }
+    if (jFamilyStrLC == NULL || jFullNameStrLC == NULL) {
+        if (debugFC) {
+            fprintf(stderr,"Failed to create lower case string object");
+            fflush(stderr);
+        }
+        return JNI_TRUE;
+    }
+
+    (*env)->CallObjectMethod(env, maps->fontToFileMap, maps->putMID,
+                             jFullNameStrLC, jFileStr);
+    if ((*env)->ExceptionOccurred(env)) {
+        return JNI_FALSE;
+    }
+    (*env)->CallObjectMethod(env, maps->fontToFamilyNameMap, maps->putMID,
+                             jFullNameStrLC, jFamilyStr);
+    if ((*env)->ExceptionOccurred(env)) {
+        return JNI_FALSE;
+    }
+    jList = (*env)->CallObjectMethod(env, maps->familyToFontListMap,
+                                     maps->getMID, jFamilyStrLC);
+    if ((*env)->ExceptionOccurred(env)) {
+        return JNI_FALSE;
+    }
+    if (jList == NULL) {
+        jList = (*env)->NewObject(env, maps->arrayListClass,
+                                  maps->arrayListCtr, 4);
+        if ((*env)->ExceptionOccurred(env)) {
+            return JNI_FALSE;
+        }
+        (*env)->CallObjectMethod(env, maps->familyToFontListMap,
+                                 maps->putMID, jFamilyStrLC, jList);
+        if ((*env)->ExceptionOccurred(env)) {
+            return JNI_FALSE;
+        }
+    }
+    if (jList == NULL) {
+        if (debugFC) {
+            fprintf(stderr,"Fontconfig: List is null\n");
+            fflush(stderr);
+        }
+        return JNI_TRUE;
+    }
+    (*env)->CallObjectMethod(env, jList, maps->addMID, jFullNameStr);
+    if ((*env)->ExceptionOccurred(env)) {
+        return JNI_FALSE;
+    }
+    /* Now referenced from the passed in maps, so can delete local refs. */
+    (*env)->DeleteLocalRef(env, jFileStr);
+    (*env)->DeleteLocalRef(env, jFamilyStr);
+    (*env)->DeleteLocalRef(env, jFamilyStrLC);
+    (*env)->DeleteLocalRef(env, jFullNameStr);
+    (*env)->DeleteLocalRef(env, jFullNameStrLC);
+    (*env)->DeleteLocalRef(env, jList);
+    return JNI_TRUE;
+}
+
+/*
+ * The fonts found by FcFontList are saved to a cache file, so that later
+ * runs can fill the maps from it without asking fontconfig to load its
+ * configuration and enumerate every installed font.
+ *
+ * The file is a header followed by 'count' records, each being the file,
+ * family and full name of a font as NUL terminated UTF-8 strings. It is
+ * only used if its stamp matches a hash of the fontconfig version and of
+ * the modification times of the fontconfig configuration, the fontconfig
+ * cache directories and the standard font directories with all their
+ * subdirectories. Like fontconfig, which rescans a directory when its
+ * mtime changes, this notices fonts added to or removed from any of them.
+ * Directories added by a <dir> element elsewhere are only noticed through
+ * the fontconfig caches, so after fc-cache has run. The font files
+ * themselves are not checked here, they are checked when opened.
+ */
+#define FONT_CACHE_MAGIC    0x4346464a /* "JFFC" */
+#define FONT_CACHE_VERSION  1
+#define FONT_CACHE_SEED     0xcbf29ce484222325ULL
+#define FONT_DIR_MAX_DEPTH  8
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+    uint64_t stamp;
+    uint64_t size;
+} FontCacheHeader;
+
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+    uint32_t count;
+    jboolean failed;
+} FontCacheWriter;
+
+static uint64_t hashBytes(uint64_t hash, const void *bytes, size_t length) {
+    const unsigned char *p = (const unsigned char *)bytes;
+    size_t i;
+    /* FNV-1a */
+    for (i = 0; i < length; i++) {
+        hash ^= p[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static uint64_t hashPath(uint64_t hash, const char *path) {
+    struct stat st;
+    hash = hashBytes(hash, path, strlen(path) + 1);
+    if (stat(path, &st) == 0) {
+        int64_t values[5];
+        values[0] = (int64_t)st.st_dev;
+        values[1] = (int64_t)st.st_ino;
+        values[2] = (int64_t)st.st_size;
+        values[3] = (int64_t)st.st_mtim.tv_sec;
+        values[4] = (int64_t)st.st_mtim.tv_nsec;
+        hash = hashBytes(hash, values, sizeof(values));
+    }
+    return hash;
+}
+
+/*
+ * Hashes a font directory and, below it, every subdirectory up to
+ * FONT_DIR_MAX_DEPTH levels, which also stops symbolic link loops.
+ */
+static uint64_t hashFontDir(uint64_t hash, const char *path, int depth) {
+    char child[PATH_MAX+1];
+    uint64_t children = 0;
+    struct dirent *entry;
+    struct stat st;
+    DIR *dir;
+    int len;
+
+    hash = hashPath(hash, path);
+    if (depth >= FONT_DIR_MAX_DEPTH || (dir = opendir(path)) == NULL) {
+        return hash;
+    }
+    while ((entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+        if (entry->d_type != DT_DIR && entry->d_type != DT_LNK &&
+            entry->d_type != DT_UNKNOWN) {
+            continue;
+        }
+        len = snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+        if (len < 0 || len >= (int)sizeof(child) ||
+            stat(child, &st) != 0 || !S_ISDIR(st.st_mode)) {
+            continue;
+        }
+        /* Summed, as readdir does not return the entries in a set order. */
+        children += hashFontDir(FONT_CACHE_SEED, child, depth + 1);
+    }
+    closedir(dir);
+    return hashBytes(hash, &children, sizeof(children));
+}
+
+static uint64_t hashFontTree(uint64_t hash, const char *path) {
+    return hashFontDir(hash, path, 0);
+}
+
+/*
+ * Hashes a configuration directory and the file behind each of its
+ * entries. conf.d entries are mostly symbolic links into
+ * /usr/share/fontconfig/conf.avail, so editing or replacing a target
+ * does not change the directory itself.
+ */
+static uint64_t hashConfDir(uint64_t hash, const char *path) {
+    char child[PATH_MAX+1];
+    uint64_t children = 0;
+    struct dirent *entry;
+    DIR *dir;
+    int len;
+
+    hash = hashPath(hash, path);
+    if ((dir = opendir(path)) == NULL) {
+        return hash;
+    }
+    while ((entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+        len = snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+        if (len < 0 || len >= (int)sizeof(child)) {
+            continue;
+        }
+        /* stat() follows the link, so the target is what gets hashed. */
+        children += hashPath(FONT_CACHE_SEED, child);
+    }
+    closedir(dir);
+    return hashBytes(hash, &children, sizeof(children));
+}
+
+/*
+ * Hashes $xdgVar/name, or $HOME/homeDir/name if xdgVar is not set, using
+ * the same rules as fontconfig for the user directories, with hashFn.
+ */
+static uint64_t hashUserPath(uint64_t hash, const char *xdgVar,
+                             const char *homeDir, const char *name,
+                             uint64_t (*hashFn)(uint64_t, const char *)) {
+    char path[PATH_MAX+1];
+    const char *xdg = xdgVar != NULL ? getenv(xdgVar) : NULL;
+    const char *home = getenv("HOME");
+    int len;
+    if (xdg != NULL && xdg[0] != '\0') {
+        len = snprintf(path, sizeof(path), "%s/%s", xdg, name);
+    } else if (home != NULL && home[0] != '\0') {
+        len = snprintf(path, sizeof(path), "%s/%s%s%s", home, homeDir,
+                       homeDir[0] != '\0' ? "/" : "", name);
+    } else {
+        return hash;
+    }
+    if (len < 0 || len >= (int)sizeof(path)) {
+        return hash;
+    }
+    return (*hashFn)(hash, path);
+}
+
+static uint64_t getFontCacheStamp(int fcVersion) {
+    uint64_t hash = FONT_CACHE_SEED;
+    const char *env;
+
+    hash = hashBytes(hash, &fcVersion, sizeof(fcVersion));
+
+    /* Configuration */
+    env = getenv("FONTCONFIG_FILE");
+    if (env != NULL) {
+        hash = hashPath(hash, env);
+    }
+    env = getenv("FONTCONFIG_PATH");
+    if (env != NULL) {
+        hash = hashBytes(hash, env, strlen(env) + 1);
+    }
+    hash = hashPath(hash, "/etc/fonts/fonts.conf");
+    hash = hashPath(hash, "/etc/fonts/local.conf");
+    hash = hashConfDir(hash, "/etc/fonts/conf.d");
+    hash = hashUserPath(hash, "XDG_CONFIG_HOME", ".config", "fontconfig/fonts.conf", hashPath);
+    hash = hashUserPath(hash, "XDG_CONFIG_HOME", ".config", "fontconfig/conf.d", hashConfDir);
+    hash = hashUserPath(hash, NULL, "", ".fonts.conf", hashPath);
+
+    /* Fontconfig caches */
+    hash = hashPath(hash, "/var/cache/fontconfig");
+    hash = hashPath(hash, "/usr/lib/fontconfig/cache");
+    hash = hashUserPath(hash, "XDG_CACHE_HOME", ".cache", "fontconfig", hashPath);
+    hash = hashUserPath(hash, NULL, "", ".fontconfig", hashPath);
+
+    /* Font directories */
+    hash = hashFontDir(hash, "/usr/share/fonts", 0);
+    hash = hashFontDir(hash, "/usr/local/share/fonts", 0);
+    hash = hashUserPath(hash, "XDG_DATA_HOME", ".local/share", "fonts", hashFontTree);
+    hash = hashUserPath(hash, NULL, "", ".fonts", hashFontTree);
+
+    return hash;
+}
+
+/*
+ * Fills the maps from the cache file. Returns 1 if it did, 0 if the file
+ * is missing, stale or malformed, in which case the maps are untouched,
+ * and -1 if a Java exception is pending.
+ */
+static int loadFontCache(JNIEnv *env, const char *cacheFile, uint64_t stamp,
+                       FontMaps *maps) {
+    int fd, rc = 1;
+    struct stat st;
+    void *map;
+    const FontCacheHeader *header;
+    const char *start, *end, *p;
+    uint32_t i, n;
+
+    fd = open(cacheFile, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return 0;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(FontCacheHeader)) {
+        close(fd);
+        return 0;
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return 0;
+    }
+
+    header = (const FontCacheHeader *)map;
+    start = (const char *)map + sizeof(FontCacheHeader);
+    end = (const char *)map + st.st_size;
+    if (header->magic != FONT_CACHE_MAGIC ||
+        header->version != FONT_CACHE_VERSION ||
+        header->stamp != stamp ||
+        header->size != (uint64_t)st.st_size ||
+        header->count > (uint64_t)(end - start) / 3)
+    {
+        munmap(map, (size_t)st.st_size);
+        return 0;
+    }
+
+    /* Check every string is terminated before adding anything. */
+    p = start;
+    n = header->count * 3;
+    for (i = 0; i < n && p < end; i++) {
+        const char *nul = memchr(p, '\0', end - p);
+        if (nul == NULL) {
+            break;
+        }
+        p = nul + 1;
+    }
+    if (i != n || p != end) {
+        munmap(map, (size_t)st.st_size);
+        return 0;
+    }
+
+    p = start;
+    for (i = 0; i < header->count; i++) {
+        const char *file = p;
+        const char *family = file + strlen(file) + 1;
+        const char *fullName = family + strlen(family) + 1;
+        p = fullName + strlen(fullName) + 1;
+        if (maps->debugFC) {
+            fprintf(stderr,"Cached FC font family=%s fullname=%s file=%s\n",
+                    family, fullName, file);
+            fflush(stderr);
+        }
+        if (!addFontToMaps(env, maps, file, family, fullName)) {
+            rc = -1;
+            break;
+        }
+    }
+    munmap(map, (size_t)st.st_size);
+    return rc;
+}
+
+static void appendFontCacheString(FontCacheWriter *writer, const char *str) {
+    size_t len = strlen(str) + 1;
+    if (writer->failed) {
+        return;
+    }
+    if (writer->length + len > writer->capacity) {
+        size_t capacity = writer->capacity == 0 ? 64 * 1024 : writer->capacity;
+        char *data;
+        while (writer->length + len > capacity) {
+            capacity *= 2;
+        }
+        data = (char *)realloc(writer->data, capacity);
+        if (data == NULL) {
+            writer->failed = JNI_TRUE;
+            return;
+        }
+        writer->data = data;
+        writer->capacity = capacity;
+    }
+    memcpy(writer->data + writer->length, str, len);
+    writer->length += len;
+}
+
+static void addFontCacheFont(FontCacheWriter *writer, const char *file,
+                           const char *family, const char *fullName) {
+    appendFontCacheString(writer, file);
+    appendFontCacheString(writer, family);
+    appendFontCacheString(writer, fullName);
+    writer->count++;
+}
+
+static jboolean writeAll(int fd, const void *data, size_t length) {
+    const char *p = (const char *)data;
+    while (length > 0) {
+        ssize_t n = write(fd, p, length);
+        if (n < 0) {
+            return JNI_FALSE;
+        }
+        p += n;
+        length -= (size_t)n;
+    }
+    return JNI_TRUE;
+}
+
+/*
+ * Creates the directories above path that do not exist yet. The cache
+ * directory is only created here, when there is a cache to write.
+ */
+static jboolean makeParentDirs(const char *path) {
+    char dir[PATH_MAX+1];
+    char *p;
+    size_t len = strlen(path);
+
+    if (len >= sizeof(dir)) {
+        return JNI_FALSE;
+    }
+    memcpy(dir, path, len + 1);
+    p = strrchr(dir, '/');
+    if (p == NULL || p == dir) {
+        return JNI_TRUE;
+    }
+    *p = '\0';
+    for (p = dir + 1; ; p++) {
+        if (*p == '/' || *p == '\0') {
+            char c = *p;
+            *p = '\0';
+            if (mkdir(dir, 0755) != 0 && errno != EEXIST) {
+                return JNI_FALSE;
+            }
+            *p = c;
+            if (c == '\0') {
+                return JNI_TRUE;
+            }
+        }
+    }
+}
+
+/*
+ * Writes the cache to a temporary file which is then renamed, so other
+ * processes never see a partially written cache.
+ */
+static void writeFontCache(const char *cacheFile, uint64_t stamp,
+                         FontCacheWriter *writer, jboolean debugFC) {
+    char tmpFile[PATH_MAX+1];
+    FontCacheHeader header;
+    int fd, len;
+    jboolean ok;
+
+    if (writer->failed) {
+        return;
+    }
+    len = snprintf(tmpFile, sizeof(tmpFile), "%s.%d", cacheFile, (int)getpid());
+    if (len < 0 || len >= (int)sizeof(tmpFile)) {
+        return;
+    }
+    if (!makeParentDirs(cacheFile)) {
+        if (debugFC) {
+            fprintf(stderr,"Could not create fontconfig cache directory for %s\n",
+                    cacheFile);
+        }
+        return;
+    }
+    fd = open(tmpFile, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        if (debugFC) {
+            fprintf(stderr,"Could not create fontconfig cache %s\n", tmpFile);
+        }
+        return;
+    }
+    memset(&header, 0, sizeof(header));
+    header.magic = FONT_CACHE_MAGIC;
+    header.version = FONT_CACHE_VERSION;
+    header.count = writer->count;
+    header.stamp = stamp;
+    header.size = sizeof(header) + writer->length;
+    ok = writeAll(fd, &header, sizeof(header)) &&
+         writeAll(fd, writer->data, writer->length);
+    if (close(fd) != 0) {
+        ok = JNI_FALSE;
+    }
+    if (!ok || rename(tmpFile, cacheFile) != 0) {
+        unlink(tmpFile);
+        return;
+    }
+    if (debugFC) {
+        fprintf(stderr,"Wrote %u fonts to fontconfig cache %s\n",
+                writer->count, cacheFile);
+    }
+}
+
 JNIEXPORT jboolean JNICALL
 Java_com_sun_javafx_font_FontConfigManager_populateMapsNative
 (JNIEnv *env, jclass obj,
  jobject fontToFileMap,
  jobject fontToFamilyNameMap,
  jobject familyToFontListMap,
- jobject locale
+ jobject locale,
+ jstring cacheFileStr
  )
 {
     void *libfontconfig;
@@ -559,6 +1072,7 @@ Java_com_sun_javafx_font_FontConfigManager_populateMapsNative
     FcFontListFuncType FcFontList;
     FcPatternGetStringFuncType FcPatternGetString;
     FcFontSetDestroyFuncType FcFontSetDestroy;
+    FcGetVersionFuncType FcGetVersion;
     FcPattern *pattern;
     FcObjectSet *objset;
     FcFontSet *fontSet;
@@ -566,6 +1080,11 @@ Java_com_sun_javafx_font_FontConfigManager_populateMapsNative
     jmethodID arrayListCtr, addMID, getMID;
     jmethodID toLowerCaseMID;
     jmethodID putMID, containsKeyMID;
+    FontMaps maps;
+    const char *cacheFile = NULL;
+    uint64_t stamp = 0;
+    FontCacheWriter writer;
+    jboolean result = JNI_TRUE;
     jboolean debugFC = getenv("PRISM_FONTCONFIG_DEBUG") != NULL;
 
     if (fontToFileMap == NULL ||
@@ -595,6 +1114,9 @@ Java_com_sun_javafx_font_FontConfigManager_populateMapsNative
         (FcPatternGetStringFuncType)dlsym(libfontconfig, "FcPatternGetString");
     FcFontSetDestroy   =
         (FcFontSetDestroyFuncType)dlsym(libfontconfig, "FcFontSetDestroy");
+    /* Optional, only used to stamp the cache */
+    FcGetVersion       =
+        (FcGetVersionFuncType)dlsym(libfontconfig, "FcGetVersion");
 
     if (FcPatternBuild     == NULL ||
         FcObjectSetBuild   == NULL ||
@@ -604,7 +1126,7 @@ Java_com_sun_javafx_font_FontConfigManager_populateMapsNative
         if (debugFC) {
            fprintf(stderr,"Could not find symbols in libfontconfig\n");
         }
-        closeFontConfig(libfontconfig, JNI_FALSE);
+        closeFontConfig(libfontconfig, hashPath);
         return JNI_FALSE;
     }
 
@@ -660,6 +1182,39 @@ Java_com_sun_javafx_font_FontConfigManager_populateMapsNative
     if ((*env)->ExceptionOccurred(env) || toLowerCaseMID == NULL) {
         return JNI_FALSE;
     }
+
+    maps.fontToFileMap = fontToFileMap;
+    maps.fontToFamilyNameMap = fontToFamilyNameMap;
+    maps.familyToFontListMap = familyToFontListMap;
+    maps.locale = locale;
+    maps.arrayListClass = arrayListClass;
+    maps.arrayListCtr = arrayListCtr;
+    maps.addMID = addMID;
+    maps.getMID = getMID;
+    maps.putMID = putMID;
+    maps.toLowerCaseMID = toLowerCaseMID;
+    maps.debugFC = debugFC;
+    memset(&writer, 0, sizeof(writer));
+
+    if (cacheFileStr != NULL) {
+        cacheFile = (*env)->GetStringUTFChars(env, cacheFileStr, 0);
+    }
+    if (cacheFile != NULL) {
+        int rc;
+        stamp = getFontCacheStamp(FcGetVersion != NULL ? (*FcGetVersion)() : 0);
+        rc = loadFontCache(env, cacheFile, stamp, &maps);
+        if (rc != 0) {
+            if (debugFC && rc > 0) {
+                fprintf(stderr,"Loaded fonts from fontconfig cache %s\n",
+                        cacheFile);
+                fflush(stderr);
+            }
+            (*env)->ReleaseStringUTFChars(env, cacheFileStr, cacheFile);
+            closeFontConfig(libfontconfig, hashFontTree);
+            return rc > 0 ? JNI_TRUE : JNI_FALSE;
+        }
+    }
+
     pattern = (*FcPatternBuild)(NULL, FC_OUTLINE, FcTypeBool, FcTrue, NULL);
     objset = (*FcObjectSetBuild)(FC_FAMILY, FC_FAMILYLANG,
                                  FC_FULLNAME, FC_FULLNAMELANG,
@@ -682,10 +1237,6 @@ Java_com_sun_javafx_font_FontConfigManager_populateMapsNative
         FcChar8 *fullNameLang = NULL;
         FcChar8 *file;
         FcResult res;
-        jstring jFileStr;
-        jstring jFamilyStr, jFamilyStrLC;
-        jstring jFullNameStr, jFullNameStrLC;
-        jobject jList;
         FcChar8 *format = NULL;
 
         /* We only want TrueType & OpenType fonts for Java FX */
@@ -763,79 +1314,15 @@ Java_com_sun_javafx_font_FontConfigManager_populateMapsNative
             continue;
         }
 
-        jFileStr = (*env)->NewStringUTF(env, (const char*)file);
-        jFamilyStr = (*env)->NewStringUTF(env, (const char*)familyEN);
-        jFullNameStr = (*env)->NewStringUTF(env, (const char*)fullNameEN);
-
-        if (jFileStr == NULL || jFamilyStr == NULL || jFullNameStr == NULL) {
-            if (debugFC) {
-                fprintf(stderr,"Failed to create string object");
-            }
-            continue;
-        }
-
-        jFamilyStrLC = (*env)->CallObjectMethod(env, jFamilyStr,
-                                                toLowerCaseMID, locale);
-        if ((*env)->ExceptionOccurred(env)) {
-            return JNI_FALSE;
-        }
-        jFullNameStrLC = (*env)->CallObjectMethod(env, jFullNameStr,
-                                                  toLowerCaseMID, locale);
-        if ((*env)->ExceptionOccurred(env)) {
-            return JNI_FALSE;
-        }
-        if (jFamilyStrLC == NULL || jFullNameStrLC == NULL) {
-            if (debugFC) {
-                fprintf(stderr,"Failed to create lower case string object");
-                fflush(stderr);
-            }
-            continue;
-        }
-
-        (*env)->CallObjectMethod(env, fontToFileMap, putMID,
-                                 jFullNameStrLC, jFileStr);
-        if ((*env)->ExceptionOccurred(env)) {
-            return JNI_FALSE;
-        }
-        (*env)->CallObjectMethod(env, fontToFamilyNameMap, putMID,
-                                 jFullNameStrLC, jFamilyStr);
-        if ((*env)->ExceptionOccurred(env)) {
-            return JNI_FALSE;
+        if (cacheFile != NULL) {
+            addFontCacheFont(&writer, (const char*)file,
+                           (const char*)familyEN, (const char*)fullNameEN);
         }
-        jList = (*env)->CallObjectMethod(env, familyToFontListMap,
-                                         getMID, jFamilyStrLC);
-        if ((*env)->ExceptionOccurred(env)) {
-            return JNI_FALSE;
+        if (!addFontToMaps(env, &maps, (const char*)file,
+                           (const char*)familyEN, (const char*)fullNameEN)) {
+            result = JNI_FALSE;
+            break;
         }
-        if (jList == NULL) {
-            jList = (*env)->NewObject(env, arrayListClass, arrayListCtr, 4);
-            if ((*env)->ExceptionOccurred(env)) {
-                return JNI_FALSE;
-            }
-            (*env)->CallObjectMethod(env, familyToFontListMap,
-                                     putMID, jFamilyStrLC, jList);
-            if ((*env)->ExceptionOccurred(env)) {
-                return JNI_FALSE;
-            }
-        }
-        if (jList == NULL) {
-            if (debugFC) {
-                fprintf(stderr,"Fontconfig: List is null\n");
-                fflush(stderr);
-            }
-            continue;
-        }
-        (*env)->CallObjectMethod(env, jList, addMID, jFullNameStr);
-        if ((*env)->ExceptionOccurred(env)) {
-            return JNI_FALSE;
-        }
-        /* Now referenced from the passed in maps, so can delete local refs. */
-        (*env)->DeleteLocalRef(env, jFileStr);
-        (*env)->DeleteLocalRef(env, jFamilyStr);
-        (*env)->DeleteLocalRef(env, jFamilyStrLC);
-        (*env)->DeleteLocalRef(env, jFullNameStr);
-        (*env)->DeleteLocalRef(env, jFullNameStrLC);
-        (*env)->DeleteLocalRef(env, jList);
 
     }
     if (debugFC) {
@@ -843,9 +1330,17 @@ Java_com_sun_javafx_font_FontConfigManager_populateMapsNative
         fflush(stderr);
     }
     (*FcFontSetDestroy)(fontSet);
-    closeFontConfig(libfontconfig, JNI_TRUE);
+    closeFontConfig(libfontconfig, hashFontTree);
 
-    return JNI_TRUE;
+    if (cacheFile != NULL) {
+        if (result) {
+            writeFontCache(cacheFile, stamp, &writer, debugFC);
+        }
+        (*env)->ReleaseStringUTFChars(env, cacheFileStr, cacheFile);
+    }
+    free(writer.data);
+
+    return result;
 }
 
 
@@ -387,6 +387,110 @@ JNIEXPORT jbyteArray JNICALL OS_NATIVE(getBitmapData)(JNIEnv *env, jclass that,
     return result;
 }
 
+/*
+ * Layout of the per glyph record written by loadGlyphs, must match the
+ * GLYPH_* constants in OSFreetype.java.
+ */
+#define GLYPH_ERROR         0
+#define GLYPH_PIXEL_MODE    1
+#define GLYPH_OFFSET        2
+#define GLYPH_WIDTH         3
+#define GLYPH_HEIGHT        4
+#define GLYPH_LEFT          5
+#define GLYPH_TOP           6
+#define GLYPH_ADVANCE_X     7
+#define GLYPH_ADVANCE_Y     8
+#define GLYPH_USER_ADVANCE  9
+#define GLYPH_METRICS_SIZE  10
+
+/*
+ * Renders glyphs[start..start+count) at the given size and transform and
+ * copies each bitmap, without row padding, into the direct buffer dst
+ * starting at dstOffset. Stops at the first glyph whose bitmap does not fit
+ * in the remaining space and returns the number of glyphs processed, or -1
+ * if the arguments are invalid or the size cannot be set. Glyphs that fail
+ * to load, or are not rendered as GRAY or LCD, get an offset of -1.
+ */
+JNIEXPORT jint JNICALL OS_NATIVE(loadGlyphs)
+    (JNIEnv *env, jclass that, jlong facePtr, jlong size26dot6, jobject matrix,
+     jint flags, jintArray glyphs, jint start, jint count, jobject dst,
+     jint dstOffset, jintArray metrics)
+{
+    jint *lpGlyphs = NULL;
+    jint *lpMetrics = NULL;
+    jint done = 0;
+    if (!facePtr || !glyphs || !dst || !metrics || count <= 0) return -1;
+    FT_Face face = (FT_Face)facePtr;
+    unsigned char *base = (unsigned char *)(*env)->GetDirectBufferAddress(env, dst);
+    jlong capacity = (*env)->GetDirectBufferCapacity(env, dst);
+    if (!base || capacity < 0 || dstOffset < 0 || dstOffset > capacity) return -1;
+    if (start < 0 || start + count > (*env)->GetArrayLength(env, glyphs)) return -1;
+    if ((start + count) * GLYPH_METRICS_SIZE > (*env)->GetArrayLength(env, metrics)) return -1;
+
+    if (FT_Set_Char_Size(face, 0, (FT_F26Dot6)size26dot6, 72, 72)) return -1;
+    if (matrix) {
+        FT_Matrix m;
+        FT_Set_Transform(face, getFT_MatrixFields(env, matrix, &m), NULL);
+    }
+
+    done = -1;
+    if ((lpGlyphs = (*env)->GetIntArrayElements(env, glyphs, NULL)) == NULL) goto fail;
+    if ((lpMetrics = (*env)->GetIntArrayElements(env, metrics, NULL)) == NULL) goto fail;
+    done = 0;
+
+    jlong offset = dstOffset;
+    for (; done < count; done++) {
+        jint i = start + done;
+        jint *m = lpMetrics + i * GLYPH_METRICS_SIZE;
+        memset(m, 0, GLYPH_METRICS_SIZE * sizeof(jint));
+        m[GLYPH_OFFSET] = -1;
+        FT_Error error = FT_Load_Glyph(face, (FT_UInt)lpGlyphs[i], (FT_Int32)flags);
+        if (error) {
+            m[GLYPH_ERROR] = (jint)error;
+            continue;
+        }
+        FT_GlyphSlot slot = face->glyph;
+        FT_Bitmap *bitmap = &slot->bitmap;
+        m[GLYPH_PIXEL_MODE] = bitmap->pixel_mode;
+        if (bitmap->pixel_mode != FT_PIXEL_MODE_GRAY &&
+            bitmap->pixel_mode != FT_PIXEL_MODE_LCD) {
+            continue;
+        }
+        int width = bitmap->width;
+        int rows = bitmap->rows;
+        /* White space glyphs have no buffer, or a zero width or height */
+        jlong size = bitmap->buffer ? (jlong)width * rows : 0;
+        if (offset + size > capacity) break;
+        int pitch = bitmap->pitch < 0 ? -bitmap->pitch : bitmap->pitch;
+        unsigned char *src = bitmap->buffer;
+        unsigned char *out = base + offset;
+        if (size > 0 && pitch == width) {
+            memcpy(out, src, (size_t)size);
+        } else if (size > 0) {
+            /* Common for LCD glyphs */
+            int y;
+            for (y = 0; y < rows; y++) {
+                memcpy(out, src, width);
+                out += width;
+                src += pitch;
+            }
+        }
+        m[GLYPH_OFFSET] = (jint)offset;
+        m[GLYPH_WIDTH] = width;
+        m[GLYPH_HEIGHT] = rows;
+        m[GLYPH_LEFT] = slot->bitmap_left;
+        m[GLYPH_TOP] = slot->bitmap_top;
+        m[GLYPH_ADVANCE_X] = (jint)slot->advance.x;
+        m[GLYPH_ADVANCE_Y] = (jint)slot->advance.y;
+        m[GLYPH_USER_ADVANCE] = (jint)slot->linearHoriAdvance;
+        offset += size;
+    }
+fail:
+    if (lpMetrics) (*env)->ReleaseIntArrayElements(env, metrics, lpMetrics, 0);
+    if (lpGlyphs) (*env)->ReleaseIntArrayElements(env, glyphs, lpGlyphs, JNI_ABORT);
+    return done;
+}
+
 JNIEXPORT void JNICALL OS_NATIVE(FT_1Set_1Transform)
     (JNIEnv *env, jclass that, jlong arg0, jobject arg1, jlong arg2, jlong arg3)
 {
@@ -31,6 +31,7 @@
 
 #include <PiscesBlit.h>
 #include <PiscesSysutils.h>
+#include <PiscesWorkers.h>
 
 #include <PiscesRenderer.inl>
 
@@ -364,6 +365,93 @@ toPiscesCoords(unsigned int ff) {
     return (int)gg;
 }
 
+/*
+ * The full rows of a fillRect or of a fillAlphaMask, split into bands that
+ * render with private copies of the renderer. Each copy has its own
+ * position and paint buffer and shares everything else, which the paint
+ * and blit functions only read.
+ */
+typedef struct _RectBands {
+    Renderer* rdr;
+    jint x, y;
+    jint rowNum;
+    jint surfaceWidth;
+} RectBands;
+
+typedef struct _MaskBands {
+    Renderer* rdr;
+    jint minX, x, y;
+    jint surfaceWidth;
+    jint maskOffset, maskWidth;
+} MaskBands;
+
+static void
+renderRectBand(void *ctx, jint start, jint end)
+{
+    RectBands* bands = (RectBands*)ctx;
+    Renderer band = *bands->rdr;
+    jint rows_being_rendered;
+
+    band._paint = NULL;
+    band._paint_length = 0;
+    band._currY = bands->y + start;
+    band._rowNum = bands->rowNum + start;
+
+    while (start < end) {
+        rows_being_rendered = MIN(end - start, NUM_ALPHA_ROWS);
+
+        band._currX = bands->x;
+        band._currImageOffset = band._currY * bands->surfaceWidth;
+        if (band._genPaint) {
+            size_t l = band._alphaWidth * rows_being_rendered;
+            ALLOC3(band._paint, jint, l);
+            if (band._paint == NULL) {
+                setMemErrorFlag();
+                break;
+            }
+            band._genPaint(&band, rows_being_rendered);
+        }
+        band._emitLine(&band, rows_being_rendered, 0x10000);
+
+        start += rows_being_rendered;
+        band._currY += rows_being_rendered;
+        band._rowNum += rows_being_rendered;
+    }
+    my_free(band._paint);
+}
+
+static void
+renderMaskBand(void *ctx, jint start, jint end)
+{
+    MaskBands* bands = (MaskBands*)ctx;
+    Renderer band = *bands->rdr;
+    jint row;
+
+    band._paint = NULL;
+    band._paint_length = 0;
+
+    for (row = start; row < end; row++) {
+        // rows after the first start their paint at the mask origin, as
+        // they do in the loop of fillAlphaMask
+        band._currX = (row == 0) ? bands->minX : bands->x;
+        band._currY = bands->y + row;
+        band._currImageOffset = band._currY * bands->surfaceWidth;
+        band._maskOffset = bands->maskOffset + row * bands->maskWidth;
+        band._rowNum = row;
+        if (band._genPaint) {
+            size_t l = band._alphaWidth;
+            ALLOC3(band._paint, jint, l);
+            if (band._paint == NULL) {
+                setMemErrorFlag();
+                break;
+            }
+            band._genPaint(&band, 1);
+        }
+        band._emitRows(&band, 1);
+    }
+    my_free(band._paint);
+}
+
 static void
 fillRect(JNIEnv *env, jobject this, Renderer* rdr,
     jint x, jint y, jint w, jint h,
@@ -502,7 +590,26 @@ fillRect(JNIEnv *env, jobject this, Renderer* rdr,
             rdr->_rowNum++;
         }
 
-        // emit "full" lines that are in the middle
+        // emit "full" lines that are in the middle, in bands on the workers
+        // when there are enough of them
+        if (rows_to_render_by_loop > 0) {
+            RectBands bands;
+            bands.rdr = rdr;
+            bands.x = x_from;
+            bands.y = rdr->_currY;
+            bands.rowNum = rdr->_rowNum;
+            bands.surfaceWidth = surface->width;
+            if (piscesworkers_renderBands(rows_to_render_by_loop, NUM_ALPHA_ROWS,
+                    (jlong)rdr->_alphaWidth * rows_to_render_by_loop,
+                    renderRectBand, &bands))
+            {
+                rdr->_currX = x_from;
+                rdr->_currY += rows_to_render_by_loop;
+                rdr->_currImageOffset = rdr->_currY * surface->width;
+                rdr->_rowNum += rows_to_render_by_loop;
+                rows_to_render_by_loop = 0;
+            }
+        }
         while (rows_to_render_by_loop > 0) {
             rows_being_rendered = MIN(rows_to_render_by_loop, NUM_ALPHA_ROWS);
 
@@ -629,6 +736,17 @@ JNIEXPORT void JNICALL Java_com_sun_pisces_PiscesRenderer_emitAndClearAlphaRowIm
     }
 }
 
+/*
+ * Class:     com_sun_pisces_PiscesRenderer
+ * Method:    setRenderThreadsImpl
+ * Signature: (I)V
+ */
+JNIEXPORT void JNICALL Java_com_sun_pisces_PiscesRenderer_setRenderThreadsImpl
+  (JNIEnv *env, jclass cls, jint threads)
+{
+    piscesworkers_setThreads(threads);
+}
+
 /*
  * Class:     com_sun_pisces_PiscesRenderer
  * Method:    drawImageImpl
@@ -821,6 +939,22 @@ static void fillAlphaMask(Renderer* rdr, jint minX, jint minY, jint maxX, jint m
 
             rowsToBeRendered = height;
 
+            if (rowsToBeRendered > 0) {
+                MaskBands bands;
+                bands.rdr = rdr;
+                bands.minX = minX;
+                bands.x = x;
+                bands.y = minY;
+                bands.surfaceWidth = surface->width;
+                bands.maskOffset = offset;
+                bands.maskWidth = maskWidth;
+                if (piscesworkers_renderBands(rowsToBeRendered, NUM_ALPHA_ROWS,
+                        (jlong)width * rowsToBeRendered, renderMaskBand, &bands))
+                {
+                    rowsToBeRendered = 0;
+                }
+            }
+
             while (rowsToBeRendered > 0) {
                 rowsBeingRendered = 1; //MIN(rowsToBeRendered, NUM_ALPHA_ROWS);
 
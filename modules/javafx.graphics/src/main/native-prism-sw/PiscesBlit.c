@@ -30,6 +30,7 @@
 
 #include <PiscesSysutils.h>
 #include <PiscesMath.h>
+#include <PiscesSIMD.h>
 
 #include <limits.h>
 
@@ -75,6 +76,819 @@ static INLINE jint B(jint x) {
     return x & 0xFF;
 }
 
+/* SIMD blend routines START */
+
+// Rows of coverage converted at a time by the blits of _rowAAInt
+#define COVERAGE_CHUNK 256
+
+// Pixels of the paint blends, like the scalar loops, with mask or frac
+static void
+blendSrcOverPaintPixels(jint *intData, jint *paint, jbyte *mask, jint frac,
+                        jint w) {
+    jint i, cval, palpha, malpha, aval;
+
+    for (i = 0; i < w; i++) {
+        cval = paint[i];
+        palpha = A(cval);
+        if (mask != NULL) {
+            malpha = mask[i] & 0xff;
+            aval = ((malpha+1) * palpha) >> 8;
+            if (aval == MAX_ALPHA) {
+                intData[i] = cval;
+            } else if (aval > 0) {
+                blendSrcOver8888_pre_pre(&intData[i], malpha+1, palpha, R(cval), G(cval), B(cval));
+            }
+        } else if (frac == 256) {
+            switch (palpha) {
+            case 0:
+                break;
+            case MAX_ALPHA:
+                intData[i] = cval;
+                break;
+            default:
+                blendSrcOver8888_pre_pre_fullFrac(&intData[i], palpha, R(cval), G(cval), B(cval));
+                break;
+            }
+        } else {
+            blendSrcOver8888_pre_pre(&intData[i], frac, palpha, R(cval), G(cval), B(cval));
+        }
+    }
+}
+
+// Pixels of the Src blends, like the scalar loops of blitSrcMask8888_pre
+static void
+blendSrcColorPixels(jint *intData, jbyte *mask, jint w,
+                    jint calpha, jint cred, jint cgreen, jint cblue) {
+    jint i, aval, acoverage;
+
+    for (i = 0; i < w; i++) {
+        acoverage = mask[i] & 0xff;
+        if (acoverage == MAX_ALPHA) {
+            intData[i] = (calpha << 24) | (cred << 16) | (cgreen << 8) | cblue;
+        } else if (acoverage > 0) {
+            aval = ((acoverage+1) * calpha) >> 8;
+            blendSrc8888_pre(&intData[i], aval, 255 - acoverage, cred, cgreen, cblue);
+        }
+    }
+}
+
+// and of blitPTSrcMask8888_pre
+static void
+blendSrcPaintPixels(jint *intData, jint *paint, jbyte *mask, jint w) {
+    jint i, cval, aval, acoverage;
+
+    for (i = 0; i < w; i++) {
+        cval = paint[i];
+        acoverage = mask[i] & 0xff;
+        if (acoverage == MAX_ALPHA) {
+            intData[i] = cval;
+        } else if (acoverage > 0) {
+            aval = ((acoverage+1) * A(cval)) >> 8;
+            blendSrc8888_pre_pre(&intData[i], aval, 255 - acoverage, R(cval), G(cval), B(cval));
+        }
+    }
+}
+
+// Pixels of the LCD blend, like the scalar loop of blitSrcOverLCDMask8888_pre
+static void
+blendLCDPixels(jint *intData, jbyte *mask, jint w,
+               jint calpha, jint cred, jint cgreen, jint cblue) {
+    jint i, ared, agreen, ablue;
+
+    for (i = 0; i < w; i++) {
+        ared = *mask++ & 0xff;
+        agreen = *mask++ & 0xff;
+        ablue = *mask++ & 0xff;
+        if (calpha < MAX_ALPHA) {
+            ared = ((ared+1) * calpha) >> 8;
+            agreen = ((agreen+1) * calpha) >> 8;
+            ablue = ((ablue+1) * calpha) >> 8;
+        }
+        if ((ared & agreen & ablue) == MAX_ALPHA) {
+            intData[i] = 0xff000000 | (cred << 16) | (cgreen << 8) | cblue;
+        } else {
+            blendLCDSrcOver8888_pre(&intData[i], ared, agreen, ablue,
+                cred, cgreen, cblue);
+        }
+    }
+}
+
+#if PISCES_SIMD_X86
+
+/*
+ * The SIMD blends keep one channel per 16 bit lane. All products of two
+ * channels, and the sums of div255(), fit in 16 unsigned bits, and
+ * div255(x) is the high half of (x + 1) * 257.
+ */
+
+SSE2_TARGET static INLINE __m128i
+sse2_div255(__m128i x) {
+    return _mm_mulhi_epu16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_set1_epi16(257));
+}
+
+// Repeats the 16 bit values 0 and 1 over the channels of pixels 0, 1 in lo,
+// and the values 2 and 3 over pixels 2, 3 in hi
+SSE2_TARGET static INLINE void
+sse2_spread(__m128i v, __m128i *lo, __m128i *hi) {
+    __m128i t = _mm_unpacklo_epi16(v, v);
+    *lo = _mm_unpacklo_epi32(t, t);
+    *hi = _mm_unpackhi_epi32(t, t);
+}
+
+// blendSrcOver8888_pre() of two unpacked pixels
+SSE2_TARGET static INLINE __m128i
+sse2_blendColor(__m128i d, __m128i color, __m128i aval) {
+    __m128i oneminusaval = _mm_sub_epi16(_mm_set1_epi16(255), aval);
+    return sse2_div255(_mm_add_epi16(_mm_mullo_epi16(color, aval),
+                                     _mm_mullo_epi16(oneminusaval, d)));
+}
+
+// blendSrcOver8888_pre_pre() of two unpacked pixels, s already scaled by frac
+SSE2_TARGET static INLINE __m128i
+sse2_blendPaint(__m128i d, __m128i s) {
+    __m128i aval = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, 0xff), 0xff);
+    __m128i oneminusaval = _mm_sub_epi16(_mm_set1_epi16(255), aval);
+    return _mm_add_epi16(s, sse2_div255(_mm_mullo_epi16(oneminusaval, d)));
+}
+
+// Whether a color channel of the unpacked pixels is above their alpha
+SSE2_TARGET static INLINE jboolean
+sse2_notPremultiplied(__m128i slo, __m128i shi) {
+    __m128i alo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(slo, 0xff), 0xff);
+    __m128i ahi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(shi, 0xff), 0xff);
+    return _mm_movemask_epi8(_mm_or_si128(_mm_cmpgt_epi16(slo, alo),
+                                          _mm_cmpgt_epi16(shi, ahi))) != 0;
+}
+
+SSE2_TARGET static jint
+blendSrcOverColorRow_sse2(jint *intData, jbyte *mask, jint alpha, jint w,
+                          jint calpha, jint cred, jint cgreen, jint cblue) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i opaque = _mm_set1_epi16(MAX_ALPHA);
+    const __m128i color = _mm_set_epi16(MAX_ALPHA, cred, cgreen, cblue,
+                                        MAX_ALPHA, cred, cgreen, cblue);
+    const __m128i solid = _mm_set1_epi32(0xff000000 | (cred << 16) | (cgreen << 8) | cblue);
+    const __m128i ca = _mm_set1_epi16((short)calpha);
+    __m128i aval = _mm_set1_epi16((short)alpha);
+    __m128i alo = aval, ahi = aval;
+    jint i;
+
+    for (i = 0; i + 4 <= w; i += 4) {
+        __m128i d, lo, hi;
+        if (mask != NULL) {
+            jint m;
+            memcpy(&m, mask + i, sizeof(m));
+            if (m == 0) {
+                continue;
+            }
+            aval = _mm_unpacklo_epi8(_mm_cvtsi32_si128(m), zero);
+            aval = _mm_srli_epi16(_mm_mullo_epi16(_mm_add_epi16(aval, one), ca), 8);
+            if ((_mm_movemask_epi8(_mm_cmpeq_epi16(aval, opaque)) & 0xff) == 0xff) {
+                _mm_storeu_si128((__m128i *)(intData + i), solid);
+                continue;
+            }
+            sse2_spread(aval, &alo, &ahi);
+        }
+        d = _mm_loadu_si128((__m128i *)(intData + i));
+        lo = sse2_blendColor(_mm_unpacklo_epi8(d, zero), color, alo);
+        hi = sse2_blendColor(_mm_unpackhi_epi8(d, zero), color, ahi);
+        _mm_storeu_si128((__m128i *)(intData + i), _mm_packus_epi16(lo, hi));
+    }
+    return i;
+}
+
+SSE2_TARGET static jint
+blendSrcOverPaintRow_sse2(jint *intData, jint *paint, jbyte *mask, jint frac,
+                          jint w) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i alphaMask = _mm_set1_epi32(0xff000000);
+    __m128i f = _mm_set1_epi16((short)frac);
+    __m128i flo = f, fhi = f;
+    jint i;
+
+    for (i = 0; i + 4 <= w; i += 4) {
+        __m128i s = _mm_loadu_si128((__m128i *)(paint + i));
+        __m128i d, slo, shi;
+        if (mask != NULL) {
+            jint m;
+            memcpy(&m, mask + i, sizeof(m));
+            if (m == 0) {
+                continue;
+            }
+            f = _mm_add_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(m), zero), one);
+            sse2_spread(f, &flo, &fhi);
+        } else if (frac == 256) {
+            __m128i a = _mm_and_si128(s, alphaMask);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(a, alphaMask)) == 0xffff) {
+                _mm_storeu_si128((__m128i *)(intData + i), s);
+                continue;
+            }
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(a, zero)) == 0xffff) {
+                continue;
+            }
+        }
+        slo = _mm_unpacklo_epi8(s, zero);
+        shi = _mm_unpackhi_epi8(s, zero);
+        if (sse2_notPremultiplied(slo, shi)) {
+            // the scalar blend lets such channels spill into the next one
+            blendSrcOverPaintPixels(intData + i, paint + i,
+                                    (mask != NULL) ? mask + i : NULL, frac, 4);
+            continue;
+        }
+        if (mask != NULL || frac != 256) {
+            slo = _mm_srli_epi16(_mm_mullo_epi16(slo, flo), 8);
+            shi = _mm_srli_epi16(_mm_mullo_epi16(shi, fhi), 8);
+        }
+        d = _mm_loadu_si128((__m128i *)(intData + i));
+        slo = sse2_blendPaint(_mm_unpacklo_epi8(d, zero), slo);
+        shi = sse2_blendPaint(_mm_unpackhi_epi8(d, zero), shi);
+        _mm_storeu_si128((__m128i *)(intData + i), _mm_packus_epi16(slo, shi));
+    }
+    return i;
+}
+
+// Picks the pixels of a where sel is set and those of b elsewhere
+SSE2_TARGET static INLINE __m128i
+sse2_select(__m128i sel, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(sel, a), _mm_andnot_si128(sel, b));
+}
+
+// Clears the unpacked pixels where aval and the destination alpha are both
+// 0, which the scalar Src blends turn into transparent black
+SSE2_TARGET static INLINE __m128i
+sse2_clearTransparent(__m128i o, __m128i d, __m128i aval) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i da = _mm_shufflehi_epi16(_mm_shufflelo_epi16(d, 0xff), 0xff);
+    return _mm_andnot_si128(_mm_and_si128(_mm_cmpeq_epi16(aval, zero),
+                                          _mm_cmpeq_epi16(da, zero)), o);
+}
+
+// blendSrc8888_pre() of two unpacked pixels. As aval <= coverage, the sums
+// aval * color + raaval * d stay within 255 * 255.
+SSE2_TARGET static INLINE __m128i
+sse2_blendSrcColor(__m128i d, __m128i color, __m128i aval, __m128i raaval) {
+    __m128i o = sse2_div255(_mm_add_epi16(_mm_mullo_epi16(color, aval),
+                                          _mm_mullo_epi16(raaval, d)));
+    return sse2_clearTransparent(o, d, aval);
+}
+
+// blendSrc8888_pre_pre() of two unpacked pixels, with cov1 the coverage + 1
+SSE2_TARGET static INLINE __m128i
+sse2_blendSrcPaint(__m128i d, __m128i s, __m128i cov1, __m128i raaval) {
+    const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    __m128i pa = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, 0xff), 0xff);
+    __m128i aval = _mm_srli_epi16(_mm_mullo_epi16(cov1, pa), 8);
+    __m128i x = _mm_add_epi16(_mm_mullo_epi16(raaval, d),
+                              _mm_and_si128(alphaLanes,
+                                            _mm_mullo_epi16(aval, _mm_set1_epi16(255))));
+    __m128i o = _mm_add_epi16(sse2_div255(x), _mm_andnot_si128(alphaLanes, s));
+    return sse2_clearTransparent(o, d, aval);
+}
+
+SSE2_TARGET static jint
+blendSrcColorRow_sse2(jint *intData, jbyte *mask, jint w,
+                      jint calpha, jint cred, jint cgreen, jint cblue) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i full = _mm_set1_epi16(MAX_ALPHA);
+    const __m128i full32 = _mm_set1_epi32(0x00ff00ff);
+    const __m128i color = _mm_set_epi16(MAX_ALPHA, cred, cgreen, cblue,
+                                        MAX_ALPHA, cred, cgreen, cblue);
+    const __m128i solid = _mm_set1_epi32((calpha << 24) | (cred << 16) | (cgreen << 8) | cblue);
+    const __m128i ca = _mm_set1_epi16((short)calpha);
+    jint i;
+
+    for (i = 0; i + 4 <= w; i += 4) {
+        __m128i cov, cov32, aval, alo, ahi, rlo, rhi, d, lo, hi, o;
+        jint m;
+        memcpy(&m, mask + i, sizeof(m));
+        if (m == 0) {
+            continue;
+        }
+        if (m == -1) {
+            _mm_storeu_si128((__m128i *)(intData + i), solid);
+            continue;
+        }
+        cov = _mm_unpacklo_epi8(_mm_cvtsi32_si128(m), zero);
+        aval = _mm_srli_epi16(_mm_mullo_epi16(_mm_add_epi16(cov, one), ca), 8);
+        sse2_spread(aval, &alo, &ahi);
+        sse2_spread(_mm_sub_epi16(full, cov), &rlo, &rhi);
+        d = _mm_loadu_si128((__m128i *)(intData + i));
+        lo = sse2_blendSrcColor(_mm_unpacklo_epi8(d, zero), color, alo, rlo);
+        hi = sse2_blendSrcColor(_mm_unpackhi_epi8(d, zero), color, ahi, rhi);
+        o = _mm_packus_epi16(lo, hi);
+        // pixels with full coverage are set, those without any are kept
+        cov32 = _mm_unpacklo_epi16(cov, cov);
+        o = sse2_select(_mm_cmpeq_epi32(cov32, full32), solid, o);
+        o = sse2_select(_mm_cmpeq_epi32(cov32, zero), d, o);
+        _mm_storeu_si128((__m128i *)(intData + i), o);
+    }
+    return i;
+}
+
+SSE2_TARGET static jint
+blendSrcPaintRow_sse2(jint *intData, jint *paint, jbyte *mask, jint w) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i full = _mm_set1_epi16(MAX_ALPHA);
+    const __m128i full32 = _mm_set1_epi32(0x00ff00ff);
+    jint i;
+
+    for (i = 0; i + 4 <= w; i += 4) {
+        __m128i s, cov, cov32, clo, chi, rlo, rhi, d, lo, hi, o;
+        jint m;
+        memcpy(&m, mask + i, sizeof(m));
+        if (m == 0) {
+            continue;
+        }
+        s = _mm_loadu_si128((__m128i *)(paint + i));
+        if (m == -1) {
+            _mm_storeu_si128((__m128i *)(intData + i), s);
+            continue;
+        }
+        cov = _mm_unpacklo_epi8(_mm_cvtsi32_si128(m), zero);
+        sse2_spread(_mm_add_epi16(cov, one), &clo, &chi);
+        sse2_spread(_mm_sub_epi16(full, cov), &rlo, &rhi);
+        d = _mm_loadu_si128((__m128i *)(intData + i));
+        lo = sse2_blendSrcPaint(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(s, zero), clo, rlo);
+        hi = sse2_blendSrcPaint(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(s, zero), chi, rhi);
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpgt_epi16(lo, full),
+                                           _mm_cmpgt_epi16(hi, full))) != 0) {
+            // the scalar blend lets such channels spill into the next one
+            blendSrcPaintPixels(intData + i, paint + i, mask + i, 4);
+            continue;
+        }
+        o = _mm_packus_epi16(lo, hi);
+        cov32 = _mm_unpacklo_epi16(cov, cov);
+        o = sse2_select(_mm_cmpeq_epi32(cov32, full32), s, o);
+        o = sse2_select(_mm_cmpeq_epi32(cov32, zero), d, o);
+        _mm_storeu_si128((__m128i *)(intData + i), o);
+    }
+    return i;
+}
+
+AVX2_TARGET static INLINE __m256i
+avx2_div255(__m256i x) {
+    return _mm256_mulhi_epu16(_mm256_add_epi16(x, _mm256_set1_epi16(1)), _mm256_set1_epi16(257));
+}
+
+// Repeats 8 16 bit values over the channels of the unpacked pixels 0, 1, 4, 5
+// in lo and 2, 3, 6, 7 in hi
+AVX2_TARGET static INLINE void
+avx2_spread(__m128i v, __m256i *lo, __m256i *hi) {
+    __m128i t0 = _mm_unpacklo_epi16(v, v);
+    __m128i t1 = _mm_unpackhi_epi16(v, v);
+    *lo = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi32(t0, t0)),
+                                  _mm_unpacklo_epi32(t1, t1), 1);
+    *hi = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpackhi_epi32(t0, t0)),
+                                  _mm_unpackhi_epi32(t1, t1), 1);
+}
+
+AVX2_TARGET static INLINE __m256i
+avx2_blendColor(__m256i d, __m256i color, __m256i aval) {
+    __m256i oneminusaval = _mm256_sub_epi16(_mm256_set1_epi16(255), aval);
+    return avx2_div255(_mm256_add_epi16(_mm256_mullo_epi16(color, aval),
+                                        _mm256_mullo_epi16(oneminusaval, d)));
+}
+
+AVX2_TARGET static INLINE __m256i
+avx2_blendPaint(__m256i d, __m256i s) {
+    __m256i aval = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, 0xff), 0xff);
+    __m256i oneminusaval = _mm256_sub_epi16(_mm256_set1_epi16(255), aval);
+    return _mm256_add_epi16(s, avx2_div255(_mm256_mullo_epi16(oneminusaval, d)));
+}
+
+AVX2_TARGET static INLINE jboolean
+avx2_notPremultiplied(__m256i slo, __m256i shi) {
+    __m256i alo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(slo, 0xff), 0xff);
+    __m256i ahi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(shi, 0xff), 0xff);
+    return _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpgt_epi16(slo, alo),
+                                                _mm256_cmpgt_epi16(shi, ahi))) != 0;
+}
+
+AVX2_TARGET static jint
+blendSrcOverColorRow_avx2(jint *intData, jbyte *mask, jint alpha, jint w,
+                          jint calpha, jint cred, jint cgreen, jint cblue) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i opaque = _mm_set1_epi16(MAX_ALPHA);
+    const __m256i color = _mm256_set_epi16(MAX_ALPHA, cred, cgreen, cblue,
+                                           MAX_ALPHA, cred, cgreen, cblue,
+                                           MAX_ALPHA, cred, cgreen, cblue,
+                                           MAX_ALPHA, cred, cgreen, cblue);
+    const __m256i solid = _mm256_set1_epi32(0xff000000 | (cred << 16) | (cgreen << 8) | cblue);
+    const __m128i ca = _mm_set1_epi16((short)calpha);
+    __m256i alo = _mm256_set1_epi16((short)alpha), ahi = alo;
+    jint i;
+
+    for (i = 0; i + 8 <= w; i += 8) {
+        __m256i d, lo, hi;
+        if (mask != NULL) {
+            __m128i aval = _mm_loadl_epi64((__m128i *)(mask + i));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(aval, _mm_setzero_si128())) == 0xffff) {
+                continue;
+            }
+            aval = _mm_cvtepu8_epi16(aval);
+            aval = _mm_srli_epi16(_mm_mullo_epi16(_mm_add_epi16(aval, one), ca), 8);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(aval, opaque)) == 0xffff) {
+                _mm256_storeu_si256((__m256i *)(intData + i), solid);
+                continue;
+            }
+            avx2_spread(aval, &alo, &ahi);
+        }
+        d = _mm256_loadu_si256((__m256i *)(intData + i));
+        lo = avx2_blendColor(_mm256_unpacklo_epi8(d, zero), color, alo);
+        hi = avx2_blendColor(_mm256_unpackhi_epi8(d, zero), color, ahi);
+        _mm256_storeu_si256((__m256i *)(intData + i), _mm256_packus_epi16(lo, hi));
+    }
+    return i;
+}
+
+AVX2_TARGET static jint
+blendSrcOverPaintRow_avx2(jint *intData, jint *paint, jbyte *mask, jint frac,
+                          jint w) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m256i alphaMask = _mm256_set1_epi32(0xff000000);
+    __m256i flo = _mm256_set1_epi16((short)frac), fhi = flo;
+    jint i;
+
+    for (i = 0; i + 8 <= w; i += 8) {
+        __m256i s = _mm256_loadu_si256((__m256i *)(paint + i));
+        __m256i d, slo, shi;
+        if (mask != NULL) {
+            __m128i f = _mm_loadl_epi64((__m128i *)(mask + i));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(f, _mm_setzero_si128())) == 0xffff) {
+                continue;
+            }
+            avx2_spread(_mm_add_epi16(_mm_cvtepu8_epi16(f), one), &flo, &fhi);
+        } else if (frac == 256) {
+            __m256i a = _mm256_and_si256(s, alphaMask);
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(a, alphaMask)) == -1) {
+                _mm256_storeu_si256((__m256i *)(intData + i), s);
+                continue;
+            }
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(a, zero)) == -1) {
+                continue;
+            }
+        }
+        slo = _mm256_unpacklo_epi8(s, zero);
+        shi = _mm256_unpackhi_epi8(s, zero);
+        if (avx2_notPremultiplied(slo, shi)) {
+            blendSrcOverPaintPixels(intData + i, paint + i,
+                                    (mask != NULL) ? mask + i : NULL, frac, 8);
+            continue;
+        }
+        if (mask != NULL || frac != 256) {
+            slo = _mm256_srli_epi16(_mm256_mullo_epi16(slo, flo), 8);
+            shi = _mm256_srli_epi16(_mm256_mullo_epi16(shi, fhi), 8);
+        }
+        d = _mm256_loadu_si256((__m256i *)(intData + i));
+        slo = avx2_blendPaint(_mm256_unpacklo_epi8(d, zero), slo);
+        shi = avx2_blendPaint(_mm256_unpackhi_epi8(d, zero), shi);
+        _mm256_storeu_si256((__m256i *)(intData + i), _mm256_packus_epi16(slo, shi));
+    }
+    return i;
+}
+
+AVX2_TARGET static INLINE __m256i
+avx2_select(__m256i sel, __m256i a, __m256i b) {
+    return _mm256_blendv_epi8(b, a, sel);
+}
+
+AVX2_TARGET static INLINE __m256i
+avx2_clearTransparent(__m256i o, __m256i d, __m256i aval) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i da = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(d, 0xff), 0xff);
+    return _mm256_andnot_si256(_mm256_and_si256(_mm256_cmpeq_epi16(aval, zero),
+                                                _mm256_cmpeq_epi16(da, zero)), o);
+}
+
+AVX2_TARGET static INLINE __m256i
+avx2_blendSrcColor(__m256i d, __m256i color, __m256i aval, __m256i raaval) {
+    __m256i o = avx2_div255(_mm256_add_epi16(_mm256_mullo_epi16(color, aval),
+                                             _mm256_mullo_epi16(raaval, d)));
+    return avx2_clearTransparent(o, d, aval);
+}
+
+AVX2_TARGET static INLINE __m256i
+avx2_blendSrcPaint(__m256i d, __m256i s, __m256i cov1, __m256i raaval) {
+    const __m256i alphaLanes = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0,
+                                                -1, 0, 0, 0, -1, 0, 0, 0);
+    __m256i pa = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, 0xff), 0xff);
+    __m256i aval = _mm256_srli_epi16(_mm256_mullo_epi16(cov1, pa), 8);
+    __m256i x = _mm256_add_epi16(_mm256_mullo_epi16(raaval, d),
+                                 _mm256_and_si256(alphaLanes,
+                                                  _mm256_mullo_epi16(aval, _mm256_set1_epi16(255))));
+    __m256i o = _mm256_add_epi16(avx2_div255(x), _mm256_andnot_si256(alphaLanes, s));
+    return avx2_clearTransparent(o, d, aval);
+}
+
+AVX2_TARGET static jint
+blendSrcColorRow_avx2(jint *intData, jbyte *mask, jint w,
+                      jint calpha, jint cred, jint cgreen, jint cblue) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i full = _mm_set1_epi16(MAX_ALPHA);
+    const __m256i full32 = _mm256_set1_epi32(MAX_ALPHA);
+    const __m256i color = _mm256_set_epi16(MAX_ALPHA, cred, cgreen, cblue,
+                                           MAX_ALPHA, cred, cgreen, cblue,
+                                           MAX_ALPHA, cred, cgreen, cblue,
+                                           MAX_ALPHA, cred, cgreen, cblue);
+    const __m256i solid = _mm256_set1_epi32((calpha << 24) | (cred << 16) | (cgreen << 8) | cblue);
+    const __m128i ca = _mm_set1_epi16((short)calpha);
+    jint i;
+
+    for (i = 0; i + 8 <= w; i += 8) {
+        __m128i m8, cov, aval;
+        __m256i cov32, alo, ahi, rlo, rhi, d, lo, hi, o;
+        jlong m;
+        memcpy(&m, mask + i, sizeof(m));
+        if (m == 0) {
+            continue;
+        }
+        if (m == -1) {
+            _mm256_storeu_si256((__m256i *)(intData + i), solid);
+            continue;
+        }
+        m8 = _mm_loadl_epi64((__m128i *)(mask + i));
+        cov = _mm_cvtepu8_epi16(m8);
+        aval = _mm_srli_epi16(_mm_mullo_epi16(_mm_add_epi16(cov, one), ca), 8);
+        avx2_spread(aval, &alo, &ahi);
+        avx2_spread(_mm_sub_epi16(full, cov), &rlo, &rhi);
+        d = _mm256_loadu_si256((__m256i *)(intData + i));
+        lo = avx2_blendSrcColor(_mm256_unpacklo_epi8(d, zero), color, alo, rlo);
+        hi = avx2_blendSrcColor(_mm256_unpackhi_epi8(d, zero), color, ahi, rhi);
+        o = _mm256_packus_epi16(lo, hi);
+        cov32 = _mm256_cvtepu8_epi32(m8);
+        o = avx2_select(_mm256_cmpeq_epi32(cov32, full32), solid, o);
+        o = avx2_select(_mm256_cmpeq_epi32(cov32, zero), d, o);
+        _mm256_storeu_si256((__m256i *)(intData + i), o);
+    }
+    return i;
+}
+
+AVX2_TARGET static jint
+blendSrcPaintRow_avx2(jint *intData, jint *paint, jbyte *mask, jint w) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i full = _mm_set1_epi16(MAX_ALPHA);
+    const __m256i full16 = _mm256_set1_epi16(MAX_ALPHA);
+    const __m256i full32 = _mm256_set1_epi32(MAX_ALPHA);
+    jint i;
+
+    for (i = 0; i + 8 <= w; i += 8) {
+        __m128i m8, cov;
+        __m256i s, cov32, clo, chi, rlo, rhi, d, lo, hi, o;
+        jlong m;
+        memcpy(&m, mask + i, sizeof(m));
+        if (m == 0) {
+            continue;
+        }
+        s = _mm256_loadu_si256((__m256i *)(paint + i));
+        if (m == -1) {
+            _mm256_storeu_si256((__m256i *)(intData + i), s);
+            continue;
+        }
+        m8 = _mm_loadl_epi64((__m128i *)(mask + i));
+        cov = _mm_cvtepu8_epi16(m8);
+        avx2_spread(_mm_add_epi16(cov, one), &clo, &chi);
+        avx2_spread(_mm_sub_epi16(full, cov), &rlo, &rhi);
+        d = _mm256_loadu_si256((__m256i *)(intData + i));
+        lo = avx2_blendSrcPaint(_mm256_unpacklo_epi8(d, zero), _mm256_unpacklo_epi8(s, zero), clo, rlo);
+        hi = avx2_blendSrcPaint(_mm256_unpackhi_epi8(d, zero), _mm256_unpackhi_epi8(s, zero), chi, rhi);
+        if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpgt_epi16(lo, full16),
+                                                 _mm256_cmpgt_epi16(hi, full16))) != 0) {
+            blendSrcPaintPixels(intData + i, paint + i, mask + i, 8);
+            continue;
+        }
+        o = _mm256_packus_epi16(lo, hi);
+        cov32 = _mm256_cvtepu8_epi32(m8);
+        o = avx2_select(_mm256_cmpeq_epi32(cov32, full32), s, o);
+        o = avx2_select(_mm256_cmpeq_epi32(cov32, zero), d, o);
+        _mm256_storeu_si256((__m256i *)(intData + i), o);
+    }
+    return i;
+}
+
+/*
+ * The LCD blend works on one channel per 32 bit lane and gathers the mask
+ * and the gamma tables, which SSE2 cannot do. div255() of a sum that fits
+ * in 16 bits is computed in the low half of each lane.
+ */
+AVX2_TARGET static INLINE __m256i
+avx2_blendLCDChannel(__m256i a, __m256i s, __m256i d) {
+    const __m256i full = _mm256_set1_epi32(MAX_ALPHA);
+    __m256i x = _mm256_add_epi32(_mm256_mullo_epi16(a, s),
+                                 _mm256_mullo_epi16(_mm256_sub_epi32(full, a),
+                                                    _mm256_i32gather_epi32((const int *)invGammaArray, d, 4)));
+    x = _mm256_mulhi_epu16(_mm256_add_epi32(x, _mm256_set1_epi32(1)), _mm256_set1_epi32(257));
+    return _mm256_i32gather_epi32((const int *)gammaArray, x, 4);
+}
+
+AVX2_TARGET static jint
+blendLCDRow_avx2(jint *intData, jbyte *mask, jint w,
+                 jint calpha, jint cred, jint cgreen, jint cblue) {
+    const __m256i full = _mm256_set1_epi32(MAX_ALPHA);
+    const __m256i index = _mm256_set_epi32(21, 18, 15, 12, 9, 6, 3, 0);
+    const __m256i ca = _mm256_set1_epi32(calpha);
+    const __m256i solid = _mm256_set1_epi32(0xff000000 | (cred << 16) | (cgreen << 8) | cblue);
+    jint i;
+
+    // Each gather reads 4 bytes, so the last one of a row stays scalar.
+    for (i = 0; i + 9 <= w; i += 8) {
+        const int *m = (const int *)(mask + 3 * i);
+        __m256i ar = _mm256_and_si256(_mm256_i32gather_epi32(m, index, 1), full);
+        __m256i ag = _mm256_and_si256(_mm256_i32gather_epi32((const int *)((const char *)m + 1), index, 1), full);
+        __m256i ab = _mm256_and_si256(_mm256_i32gather_epi32((const int *)((const char *)m + 2), index, 1), full);
+        __m256i d, o, ismax;
+        if (calpha < MAX_ALPHA) {
+            const __m256i one = _mm256_set1_epi32(1);
+            ar = _mm256_srli_epi32(_mm256_mullo_epi16(_mm256_add_epi32(ar, one), ca), 8);
+            ag = _mm256_srli_epi32(_mm256_mullo_epi16(_mm256_add_epi32(ag, one), ca), 8);
+            ab = _mm256_srli_epi32(_mm256_mullo_epi16(_mm256_add_epi32(ab, one), ca), 8);
+        }
+        ismax = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_and_si256(ar, ag), ab), full);
+        d = _mm256_loadu_si256((__m256i *)(intData + i));
+        o = _mm256_slli_epi32(avx2_blendLCDChannel(ar, _mm256_set1_epi32(cred),
+                                  _mm256_and_si256(_mm256_srli_epi32(d, 16), full)), 16);
+        o = _mm256_or_si256(o, _mm256_slli_epi32(avx2_blendLCDChannel(ag, _mm256_set1_epi32(cgreen),
+                                  _mm256_and_si256(_mm256_srli_epi32(d, 8), full)), 8));
+        o = _mm256_or_si256(o, avx2_blendLCDChannel(ab, _mm256_set1_epi32(cblue),
+                                  _mm256_and_si256(d, full)));
+        o = _mm256_or_si256(o, _mm256_set1_epi32(0xff000000));
+        _mm256_storeu_si256((__m256i *)(intData + i), avx2_select(ismax, solid, o));
+    }
+    return i;
+}
+
+#endif
+
+/*
+ * SrcOver of the color over the w pixels at intData, with the coverage of
+ * mask, or alpha when mask is NULL, as in blitSrcOverMask8888_pre and
+ * emitLineSourceOver8888_pre. Returns XNI_FALSE without blending when there
+ * is no SIMD version for this CPU, leaving the pixels to the scalar loop.
+ */
+static jboolean
+blendSrcOverColorRow(jint *intData, jbyte *mask, jint alpha, jint w,
+                     jint calpha, jint cred, jint cgreen, jint cblue) {
+    jint i, aval;
+
+    switch (piscessimd_getLevel()) {
+#if PISCES_SIMD_X86
+    case PISCES_SIMD_AVX2:
+        i = blendSrcOverColorRow_avx2(intData, mask, alpha, w, calpha, cred, cgreen, cblue);
+        break;
+    case PISCES_SIMD_SSE2:
+        i = blendSrcOverColorRow_sse2(intData, mask, alpha, w, calpha, cred, cgreen, cblue);
+        break;
+#endif
+    default:
+        return XNI_FALSE;
+    }
+
+    for (; i < w; i++) {
+        aval = (mask != NULL) ? (((mask[i] & 0xff) + 1) * calpha) >> 8 : alpha;
+        if (aval == MAX_ALPHA) {
+            intData[i] = 0xff000000 | (cred << 16) | (cgreen << 8) | cblue;
+        } else if (aval > 0) {
+            blendSrcOver8888_pre(&intData[i], aval, cred, cgreen, cblue);
+        }
+    }
+    return XNI_TRUE;
+}
+
+/*
+ * SrcOver of the w premultiplied paint pixels over those at intData. The
+ * paint is scaled by the coverage of mask as in blitPTSrcOverMask8888_pre,
+ * or by frac / 256 as in emitLinePTSourceOver8888_pre when mask is NULL.
+ * Returns XNI_FALSE when there is no SIMD version for this CPU.
+ */
+static jboolean
+blendSrcOverPaintRow(jint *intData, jint *paint, jbyte *mask, jint frac, jint w) {
+    jint i;
+
+    switch (piscessimd_getLevel()) {
+#if PISCES_SIMD_X86
+    case PISCES_SIMD_AVX2:
+        i = blendSrcOverPaintRow_avx2(intData, paint, mask, frac, w);
+        break;
+    case PISCES_SIMD_SSE2:
+        i = blendSrcOverPaintRow_sse2(intData, paint, mask, frac, w);
+        break;
+#endif
+    default:
+        return XNI_FALSE;
+    }
+
+    blendSrcOverPaintPixels(intData + i, paint + i, (mask != NULL) ? mask + i : NULL,
+                            frac, w - i);
+    return XNI_TRUE;
+}
+
+/*
+ * Src of the color, with the coverage of mask, into the w pixels at intData,
+ * as in blitSrcMask8888_pre. Returns XNI_FALSE without blending when there is
+ * no SIMD version for this CPU.
+ */
+static jboolean
+blendSrcColorRow(jint *intData, jbyte *mask, jint w,
+                 jint calpha, jint cred, jint cgreen, jint cblue) {
+    jint i;
+
+    switch (piscessimd_getLevel()) {
+#if PISCES_SIMD_X86
+    case PISCES_SIMD_AVX2:
+        i = blendSrcColorRow_avx2(intData, mask, w, calpha, cred, cgreen, cblue);
+        break;
+    case PISCES_SIMD_SSE2:
+        i = blendSrcColorRow_sse2(intData, mask, w, calpha, cred, cgreen, cblue);
+        break;
+#endif
+    default:
+        return XNI_FALSE;
+    }
+
+    blendSrcColorPixels(intData + i, mask + i, w - i, calpha, cred, cgreen, cblue);
+    return XNI_TRUE;
+}
+
+/*
+ * Src of the w paint pixels, with the coverage of mask, as in
+ * blitPTSrcMask8888_pre. Returns XNI_FALSE when there is no SIMD version
+ * for this CPU.
+ */
+static jboolean
+blendSrcPaintRow(jint *intData, jint *paint, jbyte *mask, jint w) {
+    jint i;
+
+    switch (piscessimd_getLevel()) {
+#if PISCES_SIMD_X86
+    case PISCES_SIMD_AVX2:
+        i = blendSrcPaintRow_avx2(intData, paint, mask, w);
+        break;
+    case PISCES_SIMD_SSE2:
+        i = blendSrcPaintRow_sse2(intData, paint, mask, w);
+        break;
+#endif
+    default:
+        return XNI_FALSE;
+    }
+
+    blendSrcPaintPixels(intData + i, paint + i, mask + i, w - i);
+    return XNI_TRUE;
+}
+
+/*
+ * LCD SrcOver of the color, already through invGammaArray, with the three
+ * coverage bytes per pixel of mask, as in blitSrcOverLCDMask8888_pre.
+ * Returns XNI_FALSE when there is no SIMD version for this CPU, which is
+ * below AVX2 as the blend needs gathers for the gamma tables.
+ */
+static jboolean
+blendLCDRow(jint *intData, jbyte *mask, jint w,
+            jint calpha, jint cred, jint cgreen, jint cblue) {
+    jint i;
+
+    switch (piscessimd_getLevel()) {
+#if PISCES_SIMD_X86
+    case PISCES_SIMD_AVX2:
+        i = blendLCDRow_avx2(intData, mask, w, calpha, cred, cgreen, cblue);
+        break;
+#endif
+    default:
+        return XNI_FALSE;
+    }
+
+    blendLCDPixels(intData + i, mask + 3 * i, w - i, calpha, cred, cgreen, cblue);
+    return XNI_TRUE;
+}
+
+/*
+ * Converts w entries of the _rowAAInt deltas at alpha to the coverage of
+ * alphaMap, clearing them, and continues the running sum in *aval_relative.
+ * A zero sum is mapped too when mapZero is set, as the Src blits do, and
+ * is no coverage otherwise, as for SrcOver.
+ */
+static INLINE void
+coverageFromDeltas(jbyte *coverage, jint *alpha, jint w, jbyte *alphaMap,
+                   jint *aval_relative, jboolean mapZero) {
+    jint i;
+    jint sum = *aval_relative;
+
+    for (i = 0; i < w; i++) {
+        sum += alpha[i];
+        alpha[i] = 0;
+        coverage[i] = (sum || mapZero) ? alphaMap[sum] : 0;
+    }
+    *aval_relative = sum;
+}
+
+/* SIMD blend routines END */
+
 void
 emitLineSource8888_pre(Renderer *rdr, jint height, jint frac) {
     jint j, minX, maxX, w, iidx;
@@ -265,9 +1079,15 @@ emitLineSourceOver8888_pre(Renderer *rdr, jint height, jint frac) {
                 a += imagePixelStride;
             }
             am = a + w;
-            while (a < am) {
-                blendSrcOver8888_pre(a, alpha, cred, cgreen, cblue);
-                a += imagePixelStride;
+            if (w > 0 && imagePixelStride == 1 &&
+                blendSrcOverColorRow(a, NULL, alpha, w, calpha, cred, cgreen, cblue))
+            {
+                a = am;
+            } else {
+                while (a < am) {
+                    blendSrcOver8888_pre(a, alpha, cred, cgreen, cblue);
+                    a += imagePixelStride;
+                }
             }
             if (rfrac) {
                 blendSrcOver8888_pre(a, ralpha, cred, cgreen, cblue);
@@ -313,7 +1133,12 @@ emitLinePTSourceOver8888_pre(Renderer *rdr, jint height, jint frac) {
             aidx++;
         }
         am = a + w;
-        if (frac == 0x10000) { // full coverage
+        if (w > 0 && imagePixelStride == 1 &&
+            blendSrcOverPaintRow(a, paint + aidx, NULL, frac >> 8, w))
+        {
+            a = am;
+            aidx += w;
+        } else if (frac == 0x10000) { // full coverage
             while (a < am) {
                 cval = paint[aidx];
                 palpha = A(cval);
@@ -381,6 +1206,17 @@ blitSrc8888_pre(Renderer *rdr, jint height) {
         aval_relative = 0;
         a = alpha;
         am = a + w;
+        if (imagePixelStride == 1 && piscessimd_getLevel() != PISCES_SIMD_C) {
+            jbyte coverage[COVERAGE_CHUNK];
+            jint n;
+            while (a < am) {
+                n = MIN((jint)(am - a), COVERAGE_CHUNK);
+                coverageFromDeltas(coverage, a, n, alphaMap, &aval_relative, XNI_TRUE);
+                blendSrcColorRow(&intData[iidx], coverage, n, calpha, cred, cgreen, cblue);
+                a += n;
+                iidx += n;
+            }
+        }
         while (a < am) {
             aval_relative += *a;
             *a++ = 0;
@@ -430,6 +1266,11 @@ blitSrcMask8888_pre(Renderer *rdr, jint height) {
 
         a = alpha + alphaOffset;
         am = a + w;
+        if (imagePixelStride == 1 &&
+            blendSrcColorRow(&intData[iidx], a, w, calpha, cred, cgreen, cblue))
+        {
+            a = am;
+        }
         while (a < am) {
             acoverage = *a++ & 0xff;
             // run in integers otherwise it overflows
@@ -479,6 +1320,18 @@ blitPTSrc8888_pre(Renderer *rdr, jint height) {
         aval_relative = 0;
         a = alpha;
         am = a + w;
+        if (imagePixelStride == 1 && piscessimd_getLevel() != PISCES_SIMD_C) {
+            jbyte coverage[COVERAGE_CHUNK];
+            jint n;
+            while (a < am) {
+                n = MIN((jint)(am - a), COVERAGE_CHUNK);
+                coverageFromDeltas(coverage, a, n, alphaMap, &aval_relative, XNI_TRUE);
+                blendSrcPaintRow(&intData[iidx], paint + aidx, coverage, n);
+                a += n;
+                iidx += n;
+                aidx += n;
+            }
+        }
         while (a < am) {
             assert(aidx >= 0);
             assert(aidx < rdr->_paint_length);
@@ -532,6 +1385,9 @@ blitPTSrcMask8888_pre(Renderer *rdr, jint height) {
 
         a = alpha + alphaOffset;
         am = a + w;
+        if (imagePixelStride == 1 && blendSrcPaintRow(&intData[iidx], paint, a, w)) {
+            a = am;
+        }
         while (a < am) {
             cval = paint[aidx];
             palpha = A(cval);
@@ -585,6 +1441,18 @@ blitSrcOver8888_pre(Renderer *rdr, jint height) {
         aval_relative = 0;
         a = alpha;
         am = a + w;
+        if (imagePixelStride == 1 && piscessimd_getLevel() != PISCES_SIMD_C) {
+            jbyte coverage[COVERAGE_CHUNK];
+            jint n;
+            while (a < am) {
+                n = MIN((jint)(am - a), COVERAGE_CHUNK);
+                coverageFromDeltas(coverage, a, n, alphaMap, &aval_relative, XNI_FALSE);
+                blendSrcOverColorRow(&intData[iidx], coverage, 0, n,
+                                     calpha, cred, cgreen, cblue);
+                a += n;
+                iidx += n;
+            }
+        }
         while (a < am) {
             aval_relative += *a;
             *a++ = 0;
@@ -635,6 +1503,11 @@ blitSrcOverMask8888_pre(Renderer *rdr, jint height) {
 
         a = alpha + alphaOffset;
         am = a + w;
+        if (imagePixelStride == 1 &&
+            blendSrcOverColorRow(&intData[iidx], a, 0, w, calpha, cred, cgreen, cblue))
+        {
+            a = am;
+        }
         while (a < am) {
             if (*a) {
                 aval = *a & 0xff;
@@ -685,6 +1558,11 @@ blitSrcOverLCDMask8888_pre(Renderer *rdr, jint height) {
 
         a = alpha + alphaOffset;
         am = a + 3*w;
+        if (imagePixelStride == 1 &&
+            blendLCDRow(&intData[iidx], a, w, calpha, cred, cgreen, cblue))
+        {
+            a = am;
+        }
         while (a < am) {
             ared = *a++ & 0xff;
             agreen = *a++ & 0xff;
@@ -740,6 +1618,18 @@ blitPTSrcOver8888_pre(Renderer *rdr, jint height) {
         aval_relative = 0;
         a = alpha;
         am = a + w;
+        if (imagePixelStride == 1 && piscessimd_getLevel() != PISCES_SIMD_C) {
+            jbyte coverage[COVERAGE_CHUNK];
+            jint n;
+            while (a < am) {
+                n = MIN((jint)(am - a), COVERAGE_CHUNK);
+                coverageFromDeltas(coverage, a, n, alphaMap, &aval_relative, XNI_FALSE);
+                blendSrcOverPaintRow(&intData[iidx], paint + aidx, coverage, 0, n);
+                a += n;
+                iidx += n;
+                aidx += n;
+            }
+        }
         while (a < am) {
             assert(aidx >= 0);
             assert(aidx < rdr->_paint_length);
@@ -795,6 +1685,11 @@ blitPTSrcOverMask8888_pre(Renderer *rdr, jint height) {
 
         a = alpha + alphaOffset;
         am = a + w;
+        if (imagePixelStride == 1 &&
+            blendSrcOverPaintRow(&intData[iidx], paint, a, 0, w))
+        {
+            a = am;
+        }
         while (a < am) {
             if (*a) {
                 cval = paint[aidx];
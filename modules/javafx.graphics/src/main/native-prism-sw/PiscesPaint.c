@@ -28,6 +28,7 @@
 
 #include <PiscesSysutils.h>
 #include <PiscesMath.h>
+#include <PiscesSIMD.h>
 
 #define NO_REPEAT_NO_INTERPOLATE        0
 #define REPEAT_NO_INTERPOLATE           1
@@ -89,6 +90,193 @@ pad(jint ifrac, jint cycleMethod) {
     return ifrac;
 }
 
+// Gradient pixels computed at a time by the SIMD versions
+#define GRADIENT_CHUNK 256
+
+#if PISCES_SIMD_X86
+
+SSE2_TARGET static INLINE __m128i
+sse2_select(__m128i mask, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// pad() of 4 fractions, shifted to indices into the gradient colors
+SSE2_TARGET static INLINE __m128i
+sse2_padIndex(__m128i ifrac, jint cycleMethod) {
+    const __m128i max = _mm_set1_epi32(0xffff);
+    __m128i sign;
+
+    switch (cycleMethod) {
+    case CYCLE_NONE:
+        ifrac = _mm_and_si128(ifrac, _mm_cmpgt_epi32(ifrac, _mm_setzero_si128()));
+        ifrac = sse2_select(_mm_cmpgt_epi32(ifrac, max), max, ifrac);
+        break;
+    case CYCLE_REPEAT:
+        ifrac = _mm_and_si128(ifrac, max);
+        break;
+    case CYCLE_REFLECT:
+        sign = _mm_srai_epi32(ifrac, 31);
+        ifrac = _mm_sub_epi32(_mm_xor_si128(ifrac, sign), sign);
+        ifrac = _mm_and_si128(ifrac, _mm_set1_epi32(0x1ffff));
+        ifrac = sse2_select(_mm_cmpgt_epi32(ifrac, max),
+                            _mm_sub_epi32(_mm_set1_epi32(0x1ffff), ifrac), ifrac);
+        break;
+    }
+    return _mm_srai_epi32(ifrac, 16 - LG_GRADIENT_MAP_SIZE);
+}
+
+SSE2_TARGET static jint
+radialGradientColors_sse2(jint *paint, jfloat *u, jfloat *v, jint count,
+                          jint cycleMethod, jint *colors) {
+    jint idx[4];
+    jint i;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        __m128 uf = _mm_loadu_ps(u + i);
+        __m128 vf = _mm_loadu_ps(v + i);
+        // the same double precision sum as (jint)(U + PISCESsqrt(V))
+        __m128d lo = _mm_add_pd(_mm_cvtps_pd(uf), _mm_sqrt_pd(_mm_cvtps_pd(vf)));
+        __m128d hi = _mm_add_pd(_mm_cvtps_pd(_mm_movehl_ps(uf, uf)),
+                                _mm_sqrt_pd(_mm_cvtps_pd(_mm_movehl_ps(vf, vf))));
+        __m128i ifrac = _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi));
+        _mm_storeu_si128((__m128i *)idx, sse2_padIndex(ifrac, cycleMethod));
+        paint[i] = colors[idx[0]];
+        paint[i + 1] = colors[idx[1]];
+        paint[i + 2] = colors[idx[2]];
+        paint[i + 3] = colors[idx[3]];
+    }
+    return i;
+}
+
+SSE2_TARGET static void
+linearGradientRows_sse2(jint *paint, jint stride, jfloat *frac, jint count,
+                        jfloat mx, jint cycleMethod, jint *colors) {
+    __m128 f = _mm_loadu_ps(frac);
+    __m128 dx = _mm_set1_ps(mx);
+    jint idx[4];
+    jint i;
+
+    for (i = 0; i < count; i++) {
+        _mm_storeu_si128((__m128i *)idx, sse2_padIndex(_mm_cvttps_epi32(f), cycleMethod));
+        paint[i] = colors[idx[0]];
+        paint[i + stride] = colors[idx[1]];
+        paint[i + 2 * stride] = colors[idx[2]];
+        paint[i + 3 * stride] = colors[idx[3]];
+        f = _mm_add_ps(f, dx);
+    }
+}
+
+AVX2_TARGET static INLINE __m256i
+avx2_padIndex(__m256i ifrac, jint cycleMethod) {
+    const __m256i max = _mm256_set1_epi32(0xffff);
+
+    switch (cycleMethod) {
+    case CYCLE_NONE:
+        ifrac = _mm256_min_epi32(_mm256_max_epi32(ifrac, _mm256_setzero_si256()), max);
+        break;
+    case CYCLE_REPEAT:
+        ifrac = _mm256_and_si256(ifrac, max);
+        break;
+    case CYCLE_REFLECT:
+        ifrac = _mm256_and_si256(_mm256_abs_epi32(ifrac), _mm256_set1_epi32(0x1ffff));
+        ifrac = _mm256_blendv_epi8(ifrac, _mm256_sub_epi32(_mm256_set1_epi32(0x1ffff), ifrac),
+                                   _mm256_cmpgt_epi32(ifrac, max));
+        break;
+    }
+    return _mm256_srai_epi32(ifrac, 16 - LG_GRADIENT_MAP_SIZE);
+}
+
+AVX2_TARGET static jint
+radialGradientColors_avx2(jint *paint, jfloat *u, jfloat *v, jint count,
+                          jint cycleMethod, jint *colors) {
+    jint i;
+
+    for (i = 0; i + 8 <= count; i += 8) {
+        __m256d lo = _mm256_add_pd(_mm256_cvtps_pd(_mm_loadu_ps(u + i)),
+                                   _mm256_sqrt_pd(_mm256_cvtps_pd(_mm_loadu_ps(v + i))));
+        __m256d hi = _mm256_add_pd(_mm256_cvtps_pd(_mm_loadu_ps(u + i + 4)),
+                                   _mm256_sqrt_pd(_mm256_cvtps_pd(_mm_loadu_ps(v + i + 4))));
+        __m256i ifrac = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm256_cvttpd_epi32(lo)),
+                                                _mm256_cvttpd_epi32(hi), 1);
+        _mm256_storeu_si256((__m256i *)(paint + i),
+            _mm256_i32gather_epi32(colors, avx2_padIndex(ifrac, cycleMethod), 4));
+    }
+    return i;
+}
+
+AVX2_TARGET static void
+linearGradientRows_avx2(jint *paint, jint stride, jfloat *frac, jint count,
+                        jfloat mx, jint cycleMethod, jint *colors) {
+    __m256 f = _mm256_loadu_ps(frac);
+    __m256 dx = _mm256_set1_ps(mx);
+    jint cval[8];
+    jint i, k;
+
+    for (i = 0; i < count; i++) {
+        __m256i ifrac = avx2_padIndex(_mm256_cvttps_epi32(f), cycleMethod);
+        _mm256_storeu_si256((__m256i *)cval, _mm256_i32gather_epi32(colors, ifrac, 4));
+        for (k = 0; k < 8; k++) {
+            paint[i + k * stride] = cval[k];
+        }
+        f = _mm256_add_ps(f, dx);
+    }
+}
+
+#endif
+
+/*
+ * Fills count pixels of each of the rows of a linear gradient, the rows
+ * starting stride apart with the fractions in frac. The SIMD versions step
+ * several rows at once, one per lane, so each row sees the same sequence of
+ * float sums as the scalar loop. Returns the number of rows done, 0 when
+ * there is no SIMD version for this CPU.
+ */
+static jint
+linearGradientRows(jint *paint, jint stride, jfloat *frac, jint rows, jint count,
+                   jfloat mx, jint cycleMethod, jint *colors) {
+    jint j = 0;
+
+    switch (piscessimd_getLevel()) {
+#if PISCES_SIMD_X86
+    case PISCES_SIMD_AVX2:
+        for (; j + 8 <= rows; j += 8) {
+            linearGradientRows_avx2(paint + j * stride, stride, frac + j, count,
+                                    mx, cycleMethod, colors);
+        }
+        /* NO BREAK */
+    case PISCES_SIMD_SSE2:
+        for (; j + 4 <= rows; j += 4) {
+            linearGradientRows_sse2(paint + j * stride, stride, frac + j, count,
+                                    mx, cycleMethod, colors);
+        }
+        break;
+#endif
+    default:
+        break;
+    }
+    return j;
+}
+
+/*
+ * Sets count pixels to the radial gradient colors of the fixed point U and V
+ * of each pixel. Returns the number of pixels done, the rest are left to the
+ * scalar loop.
+ */
+static jint
+radialGradientColors(jint *paint, jfloat *u, jfloat *v, jint count,
+                     jint cycleMethod, jint *colors) {
+    switch (piscessimd_getLevel()) {
+#if PISCES_SIMD_X86
+    case PISCES_SIMD_AVX2:
+        return radialGradientColors_avx2(paint, u, v, count, cycleMethod, colors);
+    case PISCES_SIMD_SSE2:
+        return radialGradientColors_sse2(paint, u, v, count, cycleMethod, colors);
+#endif
+    default:
+        return 0;
+    }
+}
+
 void
 genLinearGradientPaint(Renderer *rdr, jint height) {
     jint paintOffset = 0;
@@ -96,10 +284,11 @@ genLinearGradientPaint(Renderer *rdr, jint height) {
 
     jint minX, maxX;
     jfloat frac;
+    jfloat rowFrac[8];
     jint pidx;
 
     jint x, y;
-    jint i, j;
+    jint i, j, k, rows, done;
 
     jint cycleMethod = rdr->_gradient_cycleMethod;
     jfloat mx = rdr->_lg_mx;
@@ -112,21 +301,31 @@ genLinearGradientPaint(Renderer *rdr, jint height) {
     minX = rdr->_minTouched;
     maxX = rdr->_maxTouched;
 
+    x = rdr->_currX;
     y = rdr->_currY;
-    for (j = 0; j < height; j++, y++) {
-        x = rdr->_currX;
-        pidx = paintOffset;
+    for (j = 0; j < height; j += rows, y += rows) {
+        rows = MIN(height - j, 8);
+        for (k = 0; k < rows; k++) {
+            rowFrac[k] = x * mx + (y + k) * my + b;
+        }
+        done = linearGradientRows(paint + paintOffset, width, rowFrac, rows, width,
+                                  mx, cycleMethod, colors);
+        paintOffset += done * width;
 
-        frac = x * mx + y * my + b;
-        for (i = 0; i < width; i++, pidx++) {
-            jint ifrac = pad((jint)frac, cycleMethod);
-            ifrac >>= 16 - LG_GRADIENT_MAP_SIZE;
-            paint[pidx] = colors[ifrac];
+        for (k = done; k < rows; k++) {
+            pidx = paintOffset;
 
-            frac += mx;
-        }
+            frac = rowFrac[k];
+            for (i = 0; i < width; i++, pidx++) {
+                jint ifrac = pad((jint)frac, cycleMethod);
+                ifrac >>= 16 - LG_GRADIENT_MAP_SIZE;
+                paint[pidx] = colors[ifrac];
 
-        paintOffset += width;
+                frac += mx;
+            }
+
+            paintOffset += width;
+        }
     }
 }
 
@@ -137,7 +336,7 @@ genRadialGradientPaint(Renderer *rdr, jint height) {
     jint minX, maxX;
     jint paintOffset = 0;
     jint pidx;
-    jint i, j;
+    jint i, j, k, n;
     jint x, y;
 
     jfloat a00, a01, a02, a10, a11, a12;
@@ -149,6 +348,7 @@ genRadialGradientPaint(Renderer *rdr, jint height) {
     float A, B, B2, C, C2, U, dU, V, dV, ddV, tmp;
     float _Csq, _C;
     jint ifrac;
+    jfloat us[GRADIENT_CHUNK], vs[GRADIENT_CHUNK];
 
     jint* paint = rdr->_paint;
     jint* colors = rdr->_gradient_colors;
@@ -211,20 +411,28 @@ genRadialGradientPaint(Renderer *rdr, jint height) {
         dU  = (65536.0f * dU);
         dV  = (65536.0f * 65536.0f * dV);
         ddV = (65536.0f * 65536.0f * ddV);
-        for (i = 0; i < width; i++, pidx++) {
-            if (V < 0) {
-                V = 0;
-            }
+        for (i = 0; i < width; i += n, pidx += n) {
+            n = MIN(width - i, GRADIENT_CHUNK);
+            for (k = 0; k < n; k++) {
+                if (V < 0) {
+                    V = 0;
+                }
 
-            ifrac = (jint)(U + PISCESsqrt(V));
+                us[k] = U;
+                vs[k] = V;
 
-            U += dU;
-            V += dV ;
-            dV += ddV;
+                U += dU;
+                V += dV ;
+                dV += ddV;
+            }
 
-            ifrac = pad(ifrac, cycleMethod);
-            ifrac >>= (16 - LG_GRADIENT_MAP_SIZE);
-            paint[pidx] = colors[ifrac];
+            k = radialGradientColors(paint + pidx, us, vs, n, cycleMethod, colors);
+            for (; k < n; k++) {
+                ifrac = (jint)(us[k] + PISCESsqrt(vs[k]));
+                ifrac = pad(ifrac, cycleMethod);
+                ifrac >>= (16 - LG_GRADIENT_MAP_SIZE);
+                paint[pidx + k] = colors[ifrac];
+            }
         }
 
         paintOffset += width;
@@ -348,6 +556,227 @@ static INLINE jint interpolate4pointsNoAlpha(jint p00, jint p01, jint p10, jint
     return (0xff000000) | (rr << 16) | (gg << 8) | bb;
 }
 
+// Texels collected by the texture loops before they are filtered
+#define INTERPOLATE_BATCH 64
+
+/*
+ * The texels of consecutive paint pixels waiting to be filtered, with p01
+ * right of p00, p10 below it and p11 below right.
+ */
+typedef struct _InterpolateBatch {
+    jint p00[INTERPOLATE_BATCH];
+    jint p01[INTERPOLATE_BATCH];
+    jint p10[INTERPOLATE_BATCH];
+    jint p11[INTERPOLATE_BATCH];
+    jint hfrac[INTERPOLATE_BATCH];
+    jint vfrac[INTERPOLATE_BATCH];
+    jint *dst;
+    jint count;
+    jboolean hasAlpha;
+} InterpolateBatch;
+
+static INLINE jint
+interpolatePixel(InterpolateBatch *batch, jint i) {
+    jint p00 = batch->p00[i];
+    jint hfrac = batch->hfrac[i];
+    jint vfrac = batch->vfrac[i];
+
+    if (batch->hasAlpha) {
+        if (hfrac && vfrac) {
+            return interpolate4points(p00, batch->p01[i], batch->p10[i], batch->p11[i], hfrac, vfrac);
+        } else if (hfrac) {
+            return interpolate2points(p00, batch->p01[i], hfrac);
+        } else if (vfrac) {
+            return interpolate2points(p00, batch->p10[i], vfrac);
+        }
+    } else {
+        if (hfrac && vfrac) {
+            return interpolate4pointsNoAlpha(p00, batch->p01[i], batch->p10[i], batch->p11[i], hfrac, vfrac);
+        } else if (hfrac) {
+            return interpolate2pointsNoAlpha(p00, batch->p01[i], hfrac);
+        } else if (vfrac) {
+            return interpolate2pointsNoAlpha(p00, batch->p10[i], vfrac);
+        }
+    }
+    return p00;
+}
+
+#if PISCES_SIMD_X86
+
+/*
+ * interp() of unpacked channels. With d = x1 - x0 and the 16 bit fraction f,
+ * (d * f + 0x8000) >> 16 is the signed high half of d * f, plus d when f is
+ * negative as a signed short, plus the top bit of the low half.
+ */
+SSE2_TARGET static INLINE __m128i
+sse2_interp(__m128i x0, __m128i x1, __m128i frac) {
+    __m128i d = _mm_sub_epi16(x1, x0);
+    __m128i t = _mm_mulhi_epi16(d, frac);
+    t = _mm_add_epi16(t, _mm_and_si128(_mm_srai_epi16(frac, 15), d));
+    t = _mm_add_epi16(t, _mm_srli_epi16(_mm_mullo_epi16(d, frac), 15));
+    return _mm_add_epi16(x0, t);
+}
+
+// interpolate4points() of the unpacked pixels, the fractions repeated over
+// the channels of each pixel
+SSE2_TARGET static INLINE __m128i
+sse2_interpolate4points(__m128i p00, __m128i p01, __m128i p10, __m128i p11,
+                        __m128i hfrac, __m128i vfrac) {
+    return sse2_interp(sse2_interp(p00, p01, hfrac), sse2_interp(p10, p11, hfrac), vfrac);
+}
+
+SSE2_TARGET static jint
+interpolateBatch_sse2(InterpolateBatch *batch) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32(0xff000000);
+    jint i;
+
+    for (i = 0; i + 4 <= batch->count; i += 4) {
+        __m128i p00 = _mm_loadu_si128((__m128i *)(batch->p00 + i));
+        __m128i p01 = _mm_loadu_si128((__m128i *)(batch->p01 + i));
+        __m128i p10 = _mm_loadu_si128((__m128i *)(batch->p10 + i));
+        __m128i p11 = _mm_loadu_si128((__m128i *)(batch->p11 + i));
+        __m128i h = _mm_loadu_si128((__m128i *)(batch->hfrac + i));
+        __m128i v = _mm_loadu_si128((__m128i *)(batch->vfrac + i));
+        __m128i hlo, hhi, vlo, vhi, lo, hi, cval;
+
+        // the fractions of pixels 0, 1 and of pixels 2, 3 over their channels
+        hlo = _mm_shufflelo_epi16(h, 0xa0);
+        hhi = _mm_shufflehi_epi16(h, 0xa0);
+        vlo = _mm_shufflelo_epi16(v, 0xa0);
+        vhi = _mm_shufflehi_epi16(v, 0xa0);
+        hlo = _mm_unpacklo_epi32(hlo, hlo);
+        hhi = _mm_unpackhi_epi32(hhi, hhi);
+        vlo = _mm_unpacklo_epi32(vlo, vlo);
+        vhi = _mm_unpackhi_epi32(vhi, vhi);
+
+        lo = sse2_interpolate4points(_mm_unpacklo_epi8(p00, zero), _mm_unpacklo_epi8(p01, zero),
+                                     _mm_unpacklo_epi8(p10, zero), _mm_unpacklo_epi8(p11, zero),
+                                     hlo, vlo);
+        hi = sse2_interpolate4points(_mm_unpackhi_epi8(p00, zero), _mm_unpackhi_epi8(p01, zero),
+                                     _mm_unpackhi_epi8(p10, zero), _mm_unpackhi_epi8(p11, zero),
+                                     hhi, vhi);
+        cval = _mm_packus_epi16(lo, hi);
+        if (!batch->hasAlpha) {
+            // opaque, except for the pixels that are not filtered
+            __m128i unfiltered = _mm_cmpeq_epi32(_mm_or_si128(h, v), zero);
+            cval = _mm_or_si128(_mm_and_si128(unfiltered, p00),
+                                _mm_andnot_si128(unfiltered, _mm_or_si128(cval, alphaMask)));
+        }
+        _mm_storeu_si128((__m128i *)(batch->dst + i), cval);
+    }
+    return i;
+}
+
+AVX2_TARGET static INLINE __m256i
+avx2_interp(__m256i x0, __m256i x1, __m256i frac) {
+    __m256i d = _mm256_sub_epi16(x1, x0);
+    __m256i t = _mm256_mulhi_epi16(d, frac);
+    t = _mm256_add_epi16(t, _mm256_and_si256(_mm256_srai_epi16(frac, 15), d));
+    t = _mm256_add_epi16(t, _mm256_srli_epi16(_mm256_mullo_epi16(d, frac), 15));
+    return _mm256_add_epi16(x0, t);
+}
+
+AVX2_TARGET static INLINE __m256i
+avx2_interpolate4points(__m256i p00, __m256i p01, __m256i p10, __m256i p11,
+                        __m256i hfrac, __m256i vfrac) {
+    return avx2_interp(avx2_interp(p00, p01, hfrac), avx2_interp(p10, p11, hfrac), vfrac);
+}
+
+AVX2_TARGET static jint
+interpolateBatch_avx2(InterpolateBatch *batch) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i alphaMask = _mm256_set1_epi32(0xff000000);
+    jint i;
+
+    for (i = 0; i + 8 <= batch->count; i += 8) {
+        __m256i p00 = _mm256_loadu_si256((__m256i *)(batch->p00 + i));
+        __m256i p01 = _mm256_loadu_si256((__m256i *)(batch->p01 + i));
+        __m256i p10 = _mm256_loadu_si256((__m256i *)(batch->p10 + i));
+        __m256i p11 = _mm256_loadu_si256((__m256i *)(batch->p11 + i));
+        __m256i h = _mm256_loadu_si256((__m256i *)(batch->hfrac + i));
+        __m256i v = _mm256_loadu_si256((__m256i *)(batch->vfrac + i));
+        __m256i hlo, hhi, vlo, vhi, lo, hi, cval;
+
+        hlo = _mm256_shufflelo_epi16(h, 0xa0);
+        hhi = _mm256_shufflehi_epi16(h, 0xa0);
+        vlo = _mm256_shufflelo_epi16(v, 0xa0);
+        vhi = _mm256_shufflehi_epi16(v, 0xa0);
+        hlo = _mm256_unpacklo_epi32(hlo, hlo);
+        hhi = _mm256_unpackhi_epi32(hhi, hhi);
+        vlo = _mm256_unpacklo_epi32(vlo, vlo);
+        vhi = _mm256_unpackhi_epi32(vhi, vhi);
+
+        lo = avx2_interpolate4points(_mm256_unpacklo_epi8(p00, zero), _mm256_unpacklo_epi8(p01, zero),
+                                     _mm256_unpacklo_epi8(p10, zero), _mm256_unpacklo_epi8(p11, zero),
+                                     hlo, vlo);
+        hi = avx2_interpolate4points(_mm256_unpackhi_epi8(p00, zero), _mm256_unpackhi_epi8(p01, zero),
+                                     _mm256_unpackhi_epi8(p10, zero), _mm256_unpackhi_epi8(p11, zero),
+                                     hhi, vhi);
+        cval = _mm256_packus_epi16(lo, hi);
+        if (!batch->hasAlpha) {
+            __m256i unfiltered = _mm256_cmpeq_epi32(_mm256_or_si256(h, v), zero);
+            cval = _mm256_blendv_epi8(_mm256_or_si256(cval, alphaMask), p00, unfiltered);
+        }
+        _mm256_storeu_si256((__m256i *)(batch->dst + i), cval);
+    }
+    return i;
+}
+
+#endif
+
+/*
+ * Filters the texels of the batch into their paint pixels. The SIMD versions
+ * use interpolate4points() for every pixel: with a zero fraction it gives
+ * the same channels as interpolate2points(), or p00.
+ */
+static void
+flushInterpolation(InterpolateBatch *batch) {
+    jint i = 0;
+
+    switch (piscessimd_getLevel()) {
+#if PISCES_SIMD_X86
+    case PISCES_SIMD_AVX2:
+        i = interpolateBatch_avx2(batch);
+        break;
+    case PISCES_SIMD_SSE2:
+        i = interpolateBatch_sse2(batch);
+        break;
+#endif
+    default:
+        break;
+    }
+    for (; i < batch->count; i++) {
+        batch->dst[i] = interpolatePixel(batch, i);
+    }
+    batch->count = 0;
+}
+
+/*
+ * Adds the texels of the paint pixel at dst to the batch, filtering the
+ * batch first when it is full or when dst does not follow its last pixel.
+ */
+static INLINE void
+queueInterpolation(InterpolateBatch *batch, jint *dst, jint p00, jint *pts,
+                   jint hfrac, jint vfrac) {
+    jint n = batch->count;
+
+    if (n > 0 && (n == INTERPOLATE_BATCH || dst != batch->dst + n)) {
+        flushInterpolation(batch);
+        n = 0;
+    }
+    if (n == 0) {
+        batch->dst = dst;
+    }
+    batch->p00[n] = p00;
+    batch->p01[n] = pts[0];
+    batch->p10[n] = pts[1];
+    batch->p11[n] = pts[2];
+    batch->hfrac[n] = hfrac;
+    batch->vfrac[n] = vfrac;
+    batch->count = n + 1;
+}
+
 static INLINE jboolean isInBoundsNoRepeat(jint *a, jlong *la, jint min, jint max) {
     jboolean inBounds = XNI_TRUE;
     jint aval = *a;
@@ -418,6 +847,10 @@ genTexturePaintTarget(Renderer *rdr, jint *paint, jint height) {
     jint txMax = rdr->_texture_txMax;
     jint tyMax = rdr->_texture_tyMax;
     jint repeatInterpolateMode;
+    InterpolateBatch batch;
+
+    batch.count = 0;
+    batch.hasAlpha = rdr->_texture_hasAlpha;
 
     if (rdr->_texture_interpolate) {
         if (rdr->_texture_hasAlpha) {
@@ -448,7 +881,7 @@ genTexturePaintTarget(Renderer *rdr, jint *paint, jint height) {
     // just TRANSLATION
     case TEXTURE_TRANSFORM_TRANSLATE:
         {
-        jint cval, pidx;
+        jint pidx;
         jint *a, *am;
         jlong ltx, lty;
         jint tx, ty, vfrac, hfrac;
@@ -527,18 +960,9 @@ genTexturePaintTarget(Renderer *rdr, jint *paint, jint height) {
                     getPointsToInterpolate(pts, txtData, sidx, txtStride, p00,
                         tx, txtWidth-1, ty, txtHeight-1);
                     PISCES_DEBUG("cols[%x, %x, %x, %x] ", p00, pts[0], pts[1], pts[2]);
-                    if (hfrac && vfrac) {
-                        cval = interpolate4points(p00, pts[0], pts[1], pts[2], hfrac, vfrac);
-                    } else if (hfrac) {
-                        cval = interpolate2points(p00, pts[0], hfrac);
-                    } else if (vfrac) {
-                        cval = interpolate2points(p00, pts[1], vfrac);
-                    } else {
-                        cval = p00;
-                    }
                     assert(pidx >= 0);
                     assert(pidx < rdr->_paint_length);
-                    paint[pidx] = cval;
+                    queueInterpolation(&batch, paint + pidx, p00, pts, hfrac, vfrac);
                     ++a;
                     ++pidx;
                     ltx += 0x10000;
@@ -554,18 +978,9 @@ genTexturePaintTarget(Renderer *rdr, jint *paint, jint height) {
                     getPointsToInterpolateRepeat(pts, txtData, sidx, txtStride, p00,
                         tx, txtWidth-1, ty, txtHeight-1);
                     PISCES_DEBUG("cols[%x, %x, %x, %x] ", p00, pts[0], pts[1], pts[2]);
-                    if (hfrac && vfrac) {
-                        cval = interpolate4points(p00, pts[0], pts[1], pts[2], hfrac, vfrac);
-                    } else if (hfrac) {
-                        cval = interpolate2points(p00, pts[0], hfrac);
-                    } else if (vfrac) {
-                        cval = interpolate2points(p00, pts[1], vfrac);
-                    } else {
-                        cval = p00;
-                    }
                     assert(pidx >= 0);
                     assert(pidx < rdr->_paint_length);
-                    paint[pidx] = cval;
+                    queueInterpolation(&batch, paint + pidx, p00, pts, hfrac, vfrac);
                     ++a;
                     ++pidx;
                     ltx += 0x10000;
@@ -581,18 +996,9 @@ genTexturePaintTarget(Renderer *rdr, jint *paint, jint height) {
                     getPointsToInterpolate(pts, txtData, sidx, txtStride, p00,
                         tx, txtWidth-1, ty, txtHeight-1);
                     PISCES_DEBUG("cols[%x, %x, %x, %x] ", p00, pts[0], pts[1], pts[2]);
-                    if (hfrac && vfrac) {
-                        cval = interpolate4pointsNoAlpha(p00, pts[0], pts[1], pts[2], hfrac, vfrac);
-                    } else if (hfrac) {
-                        cval = interpolate2pointsNoAlpha(p00, pts[0], hfrac);
-                    } else if (vfrac) {
-                        cval = interpolate2pointsNoAlpha(p00, pts[1], vfrac);
-                    } else {
-                        cval = p00;
-                    }
                     assert(pidx >= 0);
                     assert(pidx < rdr->_paint_length);
-                    paint[pidx] = cval;
+                    queueInterpolation(&batch, paint + pidx, p00, pts, hfrac, vfrac);
                     ++a;
                     ++pidx;
                     ltx += 0x10000;
@@ -608,18 +1014,9 @@ genTexturePaintTarget(Renderer *rdr, jint *paint, jint height) {
                     getPointsToInterpolateRepeat(pts, txtData, sidx, txtStride, p00,
                         tx, txtWidth-1, ty, txtHeight-1);
                     PISCES_DEBUG("cols[%x, %x, %x, %x] ", p00, pts[0], pts[1], pts[2]);
-                    if (hfrac && vfrac) {
-                        cval = interpolate4pointsNoAlpha(p00, pts[0], pts[1], pts[2], hfrac, vfrac);
-                    } else if (hfrac) {
-                        cval = interpolate2pointsNoAlpha(p00, pts[0], hfrac);
-                    } else if (vfrac) {
-                        cval = interpolate2pointsNoAlpha(p00, pts[1], vfrac);
-                    } else {
-                        cval = p00;
-                    }
                     assert(pidx >= 0);
                     assert(pidx < rdr->_paint_length);
-                    paint[pidx] = cval;
+                    queueInterpolation(&batch, paint + pidx, p00, pts, hfrac, vfrac);
                     ++a;
                     ++pidx;
                     ltx += 0x10000;
@@ -635,7 +1032,7 @@ genTexturePaintTarget(Renderer *rdr, jint *paint, jint height) {
     // scale transform
     case TEXTURE_TRANSFORM_SCALE_TRANSLATE:
         {
-        jint cval, pidx;
+        jint pidx;
         jint *a, *am;
         jlong ltx, lty;
         jint tx, ty, vfrac, hfrac;
@@ -711,18 +1108,9 @@ genTexturePaintTarget(Renderer *rdr, jint *paint, jint height) {
                     getPointsToInterpolate(pts, txtData, sidx, txtStride, p00,
                         tx, txtWidth-1, ty, txtHeight-1);
                     PISCES_DEBUG("cols[%x, %x, %x, %x] ", p00, pts[0], pts[1], pts[2]);
-                    if (hfrac && vfrac) {
-                        cval = interpolate4points(p00, pts[0], pts[1], pts[2], hfrac, vfrac);
-                    } else if (hfrac) {
-                        cval = interpolate2points(p00, pts[0], hfrac);
-                    } else if (vfrac) {
-                        cval = interpolate2points(p00, pts[1], vfrac);
-                    } else {
-                        cval = p00;
-                    }
                     assert(pidx >= 0);
                     assert(pidx < rdr->_paint_length);
-                    paint[pidx] = cval;
+                    queueInterpolation(&batch, paint + pidx, p00, pts, hfrac, vfrac);
 
                     ++a;
                     ++pidx;
@@ -744,18 +1132,9 @@ genTexturePaintTarget(Renderer *rdr, jint *paint, jint height) {
                     getPointsToInterpolateRepeat(pts, txtData, sidx, txtStride, p00,
                         tx, txtWidth-1, ty, txtHeight-1);
                     PISCES_DEBUG("cols[%x, %x, %x, %x] ", p00, pts[0], pts[1], pts[2]);
-                    if (hfrac && vfrac) {
-                        cval = interpolate4points(p00, pts[0], pts[1], pts[2], hfrac, vfrac);
-                    } else if (hfrac) {
-                        cval = interpolate2points(p00, pts[0], hfrac);
-                    } else if (vfrac) {
-                        cval = interpolate2points(p00, pts[1], vfrac);
-                    } else {
-                        cval = p00;
-                    }
                     assert(pidx >= 0);
                     assert(pidx < rdr->_paint_length);
-                    paint[pidx] = cval;
+                    queueInterpolation(&batch, paint + pidx, p00, pts, hfrac, vfrac);
 
                     ++a;
                     ++pidx;
@@ -777,18 +1156,9 @@ genTexturePaintTarget(Renderer *rdr, jint *paint, jint height) {
                     getPointsToInterpolate(pts, txtData, sidx, txtStride, p00,
                         tx, txtWidth-1, ty, txtHeight-1);
                     PISCES_DEBUG("cols[%x, %x, %x, %x] ", p00, pts[0], pts[1], pts[2]);
-                    if (hfrac && vfrac) {
-                        cval = interpolate4pointsNoAlpha(p00, pts[0], pts[1], pts[2], hfrac, vfrac);
-                    } else if (hfrac) {
-                        cval = interpolate2pointsNoAlpha(p00, pts[0], hfrac);
-                    } else if (vfrac) {
-                        cval = interpolate2pointsNoAlpha(p00, pts[1], vfrac);
-                    } else {
-                        cval = p00;
-                    }
                     assert(pidx >= 0);
                     assert(pidx < rdr->_paint_length);
-                    paint[pidx] = cval;
+                    queueInterpolation(&batch, paint + pidx, p00, pts, hfrac, vfrac);
 
                     ++a;
                     ++pidx;
@@ -810,18 +1180,9 @@ genTexturePaintTarget(Renderer *rdr, jint *paint, jint height) {
                     getPointsToInterpolateRepeat(pts, txtData, sidx, txtStride, p00,
                         tx, txtWidth-1, ty, txtHeight-1);
                     PISCES_DEBUG("cols[%x, %x, %x, %x] ", p00, pts[0], pts[1], pts[2]);
-                    if (hfrac && vfrac) {
-                        cval = interpolate4pointsNoAlpha(p00, pts[0], pts[1], pts[2], hfrac, vfrac);
-                    } else if (hfrac) {
-                        cval = interpolate2pointsNoAlpha(p00, pts[0], hfrac);
-                    } else if (vfrac) {
-                        cval = interpolate2pointsNoAlpha(p00, pts[1], vfrac);
-                    } else {
-                        cval = p00;
-                    }
                     assert(pidx >= 0);
                     assert(pidx < rdr->_paint_length);
-                    paint[pidx] = cval;
+                    queueInterpolation(&batch, paint + pidx, p00, pts, hfrac, vfrac);
 
                     ++a;
                     ++pidx;
@@ -839,7 +1200,7 @@ genTexturePaintTarget(Renderer *rdr, jint *paint, jint height) {
     // generic transform
     case TEXTURE_TRANSFORM_GENERIC:
         {
-        jint cval, pidx;
+        jint pidx;
         jint *a, *am;
         jlong ltx, lty;
         jint tx, ty, vfrac, hfrac;
@@ -930,18 +1291,9 @@ genTexturePaintTarget(Renderer *rdr, jint *paint, jint height) {
                         getPointsToInterpolate(pts, txtData, sidx, txtStride, p00,
                             tx, txtWidth-1, ty, txtHeight-1);
                         PISCES_DEBUG("cols[%x, %x, %x, %x] ", p00, pts[0], pts[1], pts[2]);
-                        if (hfrac && vfrac) {
-                            cval = interpolate4points(p00, pts[0], pts[1], pts[2], hfrac, vfrac);
-                        } else if (hfrac) {
-                            cval = interpolate2points(p00, pts[0], hfrac);
-                        } else if (vfrac) {
-                            cval = interpolate2points(p00, pts[1], vfrac);
-                        } else {
-                            cval = p00;
-                        }
                         assert(pidx >= 0);
                         assert(pidx < rdr->_paint_length);
-                        paint[pidx] = cval;
+                        queueInterpolation(&batch, paint + pidx, p00, pts, hfrac, vfrac);
                     } else {
                         assert(pidx >= 0);
                         assert(pidx < rdr->_paint_length);
@@ -967,18 +1319,9 @@ genTexturePaintTarget(Renderer *rdr, jint *paint, jint height) {
                     getPointsToInterpolateRepeat(pts, txtData, sidx, txtStride, p00,
                         tx, txtWidth-1, ty, txtHeight-1);
                     PISCES_DEBUG("cols[%x, %x, %x, %x] ", p00, pts[0], pts[1], pts[2]);
-                    if (hfrac && vfrac) {
-                        cval = interpolate4points(p00, pts[0], pts[1], pts[2], hfrac, vfrac);
-                    } else if (hfrac) {
-                        cval = interpolate2points(p00, pts[0], hfrac);
-                    } else if (vfrac) {
-                        cval = interpolate2points(p00, pts[1], vfrac);
-                    } else {
-                        cval = p00;
-                    }
                     assert(pidx >= 0);
                     assert(pidx < rdr->_paint_length);
-                    paint[pidx] = cval;
+                    queueInterpolation(&batch, paint + pidx, p00, pts, hfrac, vfrac);
                     ++a;
                     ++pidx;
                     ltx += rdr->_texture_m00;
@@ -1003,18 +1346,9 @@ genTexturePaintTarget(Renderer *rdr, jint *paint, jint height) {
                         getPointsToInterpolate(pts, txtData, sidx, txtStride, p00,
                             tx, txtWidth-1, ty, txtHeight-1);
                         PISCES_DEBUG("cols[%x, %x, %x, %x] ", p00, pts[0], pts[1], pts[2]);
-                        if (hfrac && vfrac) {
-                            cval = interpolate4pointsNoAlpha(p00, pts[0], pts[1], pts[2], hfrac, vfrac);
-                        } else if (hfrac) {
-                            cval = interpolate2pointsNoAlpha(p00, pts[0], hfrac);
-                        } else if (vfrac) {
-                            cval = interpolate2pointsNoAlpha(p00, pts[1], vfrac);
-                        } else {
-                            cval = p00;
-                        }
                         assert(pidx >= 0);
                         assert(pidx < rdr->_paint_length);
-                        paint[pidx] = cval;
+                        queueInterpolation(&batch, paint + pidx, p00, pts, hfrac, vfrac);
                     } else {
                         assert(pidx >= 0);
                         assert(pidx < rdr->_paint_length);
@@ -1040,18 +1374,9 @@ genTexturePaintTarget(Renderer *rdr, jint *paint, jint height) {
                     getPointsToInterpolateRepeat(pts, txtData, sidx, txtStride, p00,
                         tx, txtWidth-1, ty, txtHeight-1);
                     PISCES_DEBUG("cols[%x, %x, %x, %x] ", p00, pts[0], pts[1], pts[2]);
-                    if (hfrac && vfrac) {
-                        cval = interpolate4pointsNoAlpha(p00, pts[0], pts[1], pts[2], hfrac, vfrac);
-                    } else if (hfrac) {
-                        cval = interpolate2pointsNoAlpha(p00, pts[0], hfrac);
-                    } else if (vfrac) {
-                        cval = interpolate2pointsNoAlpha(p00, pts[1], vfrac);
-                    } else {
-                        cval = p00;
-                    }
                     assert(pidx >= 0);
                     assert(pidx < rdr->_paint_length);
-                    paint[pidx] = cval;
+                    queueInterpolation(&batch, paint + pidx, p00, pts, hfrac, vfrac);
                     ++a;
                     ++pidx;
                     ltx += rdr->_texture_m00;
@@ -1065,6 +1390,8 @@ genTexturePaintTarget(Renderer *rdr, jint *paint, jint height) {
         }
         break;
     }
+
+    flushInterpolation(&batch);
 }
 
 void
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <PiscesSIMD.h>
+
+#if PISCES_SIMD_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+
+static jint cpuSIMDLevel() {
+    int info[4];
+    jint maxLeaf;
+
+    __cpuid(info, 0);
+    maxLeaf = info[0];
+    if (maxLeaf < 1) {
+        return PISCES_SIMD_C;
+    }
+    __cpuid(info, 1);
+    if ((info[3] & (1 << 26)) == 0) {
+        return PISCES_SIMD_C;
+    }
+    // AVX and OSXSAVE, and the OS saves the YMM registers
+    if (maxLeaf < 7 || (info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 ||
+        (_xgetbv(0) & 6) != 6) {
+        return PISCES_SIMD_SSE2;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) ? PISCES_SIMD_AVX2 : PISCES_SIMD_SSE2;
+}
+#else
+static jint cpuSIMDLevel() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return PISCES_SIMD_AVX2;
+    }
+    return __builtin_cpu_supports("sse2") ? PISCES_SIMD_SSE2 : PISCES_SIMD_C;
+}
+#endif
+#else
+static jint cpuSIMDLevel() {
+    return PISCES_SIMD_C;
+}
+#endif
+
+static volatile jint simdLevel = -1;
+
+jint
+piscessimd_getLevel() {
+    jint level = simdLevel;
+    if (level < 0) {
+        level = cpuSIMDLevel();
+        simdLevel = level;
+    }
+    return level;
+}
+
+void
+piscessimd_setLevel(jint level) {
+    jint cpuLevel = cpuSIMDLevel();
+    simdLevel = (level < cpuLevel) ? level : cpuLevel;
+}
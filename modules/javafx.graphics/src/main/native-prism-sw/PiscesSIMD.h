@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef PISCES_SIMD_H
+#define PISCES_SIMD_H
+
+#include <PiscesDefs.h>
+
+/**
+ * Runtime selection of the SIMD versions of the blend, gradient and texture
+ * filtering loops in PiscesBlit.c and PiscesPaint.c. The SIMD versions
+ * produce the same pixels as the scalar loops, which remain the reference
+ * and run on other CPUs.
+ */
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define PISCES_SIMD_X86 1
+#else
+#define PISCES_SIMD_X86 0
+#endif
+
+#if PISCES_SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#define SSE2_TARGET
+#define AVX2_TARGET
+#else
+#define SSE2_TARGET __attribute__((target("sse2")))
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+#define PISCES_SIMD_C    0
+#define PISCES_SIMD_SSE2 1
+#define PISCES_SIMD_AVX2 2
+
+/**
+ * Returns the best SIMD level of this CPU, or the level set last.
+ */
+jint piscessimd_getLevel();
+
+/**
+ * Caps the SIMD level, for testing and benchmarking.
+ */
+void piscessimd_setLevel(jint level);
+
+#endif
@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <PiscesWorkers.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+// Smallest fill, in touched pixels, that is split. Waking the pool costs
+// about as much as rendering a few thousand pixels.
+#define MIN_PARALLEL_WORK (1 << 16)
+
+// A fill is cut into this many bands per thread. A thread done with its
+// first band takes the next unclaimed one, so a thread that was slow to
+// start or got descheduled holds up the fill by one band at most.
+#define BANDS_PER_THREAD 4
+
+typedef struct _Job {
+    PiscesBandRenderer *render;
+    void *ctx;
+    jint count;
+    jint band;
+    jint next;
+} Job;
+
+#ifdef _WIN32
+typedef CRITICAL_SECTION Mutex;
+typedef CONDITION_VARIABLE Condition;
+#define mutex_lock(m) EnterCriticalSection(m)
+#define mutex_tryLock(m) TryEnterCriticalSection(m)
+#define mutex_unlock(m) LeaveCriticalSection(m)
+#define condition_wait(c, m) SleepConditionVariableCS((c), (m), INFINITE)
+#define condition_signalAll(c) WakeAllConditionVariable(c)
+#define atomic_loadInt(p) InterlockedCompareExchange((volatile LONG *)(p), 0, 0)
+#define atomic_storeInt(p, v) InterlockedExchange((volatile LONG *)(p), (v))
+#else
+typedef pthread_mutex_t Mutex;
+typedef pthread_cond_t Condition;
+#define mutex_lock(m) pthread_mutex_lock(m)
+#define mutex_tryLock(m) (pthread_mutex_trylock(m) == 0)
+#define mutex_unlock(m) pthread_mutex_unlock(m)
+#define condition_wait(c, m) pthread_cond_wait((c), (m))
+#define condition_signalAll(c) pthread_cond_broadcast(c)
+#define atomic_loadInt(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define atomic_storeInt(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#endif
+
+// Held while a fill is split; a fill that cannot take it is not split
+static Mutex fillMutex;
+// Guards everything below
+static Mutex poolMutex;
+static Condition wakeCondition;
+static Condition idleCondition;
+
+static Job *currentJob = NULL;
+static unsigned int generation = 0;
+static jint busyWorkers = 0;
+static jint workers = 0;
+
+// Set from any thread, so only accessed through atomic_loadInt and
+// atomic_storeInt. poolMutex cannot guard it, it is created by the first
+// split fill.
+static volatile jint requestedThreads = 0;
+
+static void
+renderJob(Job *job) {
+    jint start, end;
+
+    for (;;) {
+        mutex_lock(&poolMutex);
+        start = job->next;
+        if (start < job->count) {
+            job->next += job->band;
+        }
+        mutex_unlock(&poolMutex);
+
+        if (start >= job->count) {
+            break;
+        }
+        end = (job->count - start > job->band) ? start + job->band : job->count;
+        job->render(job->ctx, start, end);
+    }
+}
+
+static void
+workerLoop() {
+    unsigned int seen = 0;
+    Job *job;
+
+    mutex_lock(&poolMutex);
+    for (;;) {
+        while (generation == seen) {
+            condition_wait(&wakeCondition, &poolMutex);
+        }
+        seen = generation;
+        job = currentJob;
+        if (job == NULL) {
+            continue;
+        }
+        busyWorkers++;
+        mutex_unlock(&poolMutex);
+        renderJob(job);
+        mutex_lock(&poolMutex);
+        if (--busyWorkers == 0) {
+            condition_signalAll(&idleCondition);
+        }
+    }
+}
+
+static jint
+processorCount() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (jint)info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (jint)count : 1;
+#endif
+}
+
+#ifdef _WIN32
+static DWORD WINAPI
+workerMain(LPVOID arg) {
+    workerLoop();
+    return 0;
+}
+#else
+static void *
+workerMain(void *arg) {
+    workerLoop();
+    return NULL;
+}
+#endif
+
+/*
+ * Starts the workers. They are never stopped, they only wait for the next
+ * fill, and the pool lives as long as the library.
+ */
+static void
+startWorkers() {
+    jint threads = atomic_loadInt(&requestedThreads);
+    jint i;
+
+    if (threads <= 0) {
+        threads = processorCount();
+    }
+
+    if (threads > PISCES_MAX_THREADS) {
+        threads = PISCES_MAX_THREADS;
+    }
+
+#ifdef _WIN32
+    InitializeCriticalSection(&fillMutex);
+    InitializeCriticalSection(&poolMutex);
+    InitializeConditionVariable(&wakeCondition);
+    InitializeConditionVariable(&idleCondition);
+
+    for (i = 1; i < threads; i++) {
+        HANDLE thread = CreateThread(NULL, 0, workerMain, NULL, 0, NULL);
+        if (thread == NULL) {
+            break;
+        }
+        CloseHandle(thread);
+        workers++;
+    }
+#else
+    pthread_mutex_init(&fillMutex, NULL);
+    pthread_mutex_init(&poolMutex, NULL);
+    pthread_cond_init(&wakeCondition, NULL);
+    pthread_cond_init(&idleCondition, NULL);
+
+    for (i = 1; i < threads; i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, workerMain, NULL) != 0) {
+            break;
+        }
+        pthread_detach(thread);
+        workers++;
+    }
+#endif
+}
+
+#ifdef _WIN32
+static INIT_ONCE workersOnce = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK
+startWorkersOnce(PINIT_ONCE once, PVOID param, PVOID *context) {
+    startWorkers();
+    return TRUE;
+}
+#else
+static pthread_once_t workersOnce = PTHREAD_ONCE_INIT;
+#endif
+
+void
+piscesworkers_setThreads(jint threads) {
+    atomic_storeInt(&requestedThreads, threads);
+}
+
+jboolean
+piscesworkers_renderBands(jint count, jint grain, jlong work,
+                          PiscesBandRenderer *render, void *ctx)
+{
+    Job job;
+    jint bands, band;
+
+    if (atomic_loadInt(&requestedThreads) == 1 || work < MIN_PARALLEL_WORK || count <= grain) {
+        return XNI_FALSE;
+    }
+
+#ifdef _WIN32
+    InitOnceExecuteOnce(&workersOnce, startWorkersOnce, NULL, NULL);
+#else
+    pthread_once(&workersOnce, startWorkers);
+#endif
+    if (workers == 0) {
+        return XNI_FALSE;
+    }
+
+    bands = (workers + 1) * BANDS_PER_THREAD;
+    band = (count + bands - 1) / bands;
+    band = ((band + grain - 1) / grain) * grain;
+    if (band >= count || !mutex_tryLock(&fillMutex)) {
+        return XNI_FALSE;
+    }
+
+    job.render = render;
+    job.ctx = ctx;
+    job.count = count;
+    job.band = band;
+    job.next = 0;
+
+    mutex_lock(&poolMutex);
+    currentJob = &job;
+    generation++;
+    condition_signalAll(&wakeCondition);
+    mutex_unlock(&poolMutex);
+
+    renderJob(&job);
+
+    // Only workers already counted in busyWorkers touch the job. One that
+    // wakes up after currentJob is cleared sees NULL and goes back to wait.
+    mutex_lock(&poolMutex);
+    while (busyWorkers > 0) {
+        condition_wait(&idleCondition, &poolMutex);
+    }
+    currentJob = NULL;
+    mutex_unlock(&poolMutex);
+
+    mutex_unlock(&fillMutex);
+    return XNI_TRUE;
+}
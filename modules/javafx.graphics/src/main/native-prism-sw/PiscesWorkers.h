@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef PISCES_WORKERS_H
+#define PISCES_WORKERS_H
+
+#include <PiscesDefs.h>
+
+/**
+ * Renders the bands of one large fill on the calling thread and on a small
+ * pool of native worker threads. The bands are independent, so the pixels
+ * are the same as when the fill is rendered on the calling thread alone.
+ */
+
+/**
+ * @def PISCES_MAX_THREADS
+ * Largest number of threads, the calling thread included, sharing a fill.
+ */
+#define PISCES_MAX_THREADS 8
+
+/**
+ * Renders rows start to end - 1 of a fill described by ctx.
+ */
+typedef void PiscesBandRenderer(void *ctx, jint start, jint end);
+
+/**
+ * Sets the number of threads, the calling thread included, that fills are
+ * split across. 0 uses one thread per processor and 1 disables the workers.
+ * May be called from any thread. The number of workers is fixed when the
+ * first fill is split, after that only 1 still has an effect.
+ */
+void piscesworkers_setThreads(jint threads);
+
+/**
+ * Renders rows 0 to count - 1 in bands starting at multiples of grain, and
+ * returns when all of them are done. Returns XNI_FALSE without rendering
+ * anything when the fill is too small to split, work being a rough count of
+ * the pixels touched, when there are no workers, or when the workers are
+ * busy with a fill of another renderer.
+ */
+jboolean piscesworkers_renderBands(jint count, jint grain, jlong work,
+                                   PiscesBandRenderer *render, void *ctx);
+
+#endif
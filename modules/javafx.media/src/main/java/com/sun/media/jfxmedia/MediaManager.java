@@ -25,7 +25,9 @@
 
 package com.sun.media.jfxmedia;
 
+import com.sun.media.jfxmedia.control.VideoFramePoolStatistics;
 import com.sun.media.jfxmedia.events.MediaErrorListener;
+import com.sun.media.jfxmedia.locator.HLSStatistics;
 import com.sun.media.jfxmedia.locator.Locator;
 import com.sun.media.jfxmediaimpl.NativeMediaManager;
 import java.util.List;
@@ -165,4 +167,26 @@ public class MediaManager {
     public static List<MediaPlayer> getAllMediaPlayers() {
         return NativeMediaManager.getDefaultInstance().getAllMediaPlayers();
     }
+
+    /**
+     * Gets the counters of the pool that converted video frames are taken
+     * from. Comparing two snapshots taken during playback shows whether
+     * conversions still allocate memory.
+     *
+     * @return a snapshot of the frame pool counters
+     */
+    public static VideoFramePoolStatistics getVideoFramePoolStatistics() {
+        return NativeMediaManager.getDefaultInstance().getVideoFramePoolStatistics();
+    }
+
+    /**
+     * Gets the counters of HLS segment loading: how many segments were
+     * fetched ahead, how long the most recent stream took to start and how
+     * often reads waited for the network.
+     *
+     * @return a snapshot of the HLS counters
+     */
+    public static HLSStatistics getHLSStatistics() {
+        return Locator.getHLSStatistics();
+    }
 }
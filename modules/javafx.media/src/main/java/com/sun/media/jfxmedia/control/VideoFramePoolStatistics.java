@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.media.jfxmedia.control;
+
+/**
+ * A snapshot of the counters of the native pool that recycles the memory of
+ * converted video frames. While a stream plays at a constant size the number
+ * of bytes allocated stays flat and nearly every conversion is a pool hit.
+ */
+public final class VideoFramePoolStatistics {
+    private final long framesConverted;
+    private final long poolHits;
+    private final long bytesAllocated;
+
+    public VideoFramePoolStatistics(long framesConverted, long poolHits, long bytesAllocated) {
+        this.framesConverted = framesConverted;
+        this.poolHits = poolHits;
+        this.bytesAllocated = bytesAllocated;
+    }
+
+    /**
+     * Gets the number of frames converted into pooled memory.
+     * @return the number of converted frames
+     */
+    public long getFramesConverted() {
+        return framesConverted;
+    }
+
+    /**
+     * Gets the number of conversions that reused a released frame.
+     * @return the number of pool hits
+     */
+    public long getPoolHits() {
+        return poolHits;
+    }
+
+    /**
+     * Gets the number of bytes the pool has taken from the native heap.
+     * @return the number of bytes allocated
+     */
+    public long getBytesAllocated() {
+        return bytesAllocated;
+    }
+
+    @Override
+    public String toString() {
+        return "[VideoFramePoolStatistics framesConverted=" + framesConverted
+                + ", poolHits=" + poolHits + ", bytesAllocated=" + bytesAllocated + "]";
+    }
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.media.jfxmedia.locator;
+
+import java.io.IOException;
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.VarHandle;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.channels.ClosedChannelException;
+import java.nio.channels.ReadableByteChannel;
+import java.util.concurrent.BlockingQueue;
+import java.util.concurrent.LinkedBlockingQueue;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.locks.LockSupport;
+
+/**
+ * Reads a {@link ConnectionHolder} channel ahead on its own thread into a ring
+ * of direct buffers owned by the native source, which hands them downstream
+ * without copying.
+ *
+ * The ring is filled and consumed strictly in slot order. Each slot has a state
+ * word in native memory: the reader only fills a slot whose state is
+ * {@link #SLOT_FREE} and marks it {@link #SLOT_FILLED}; native code sets it back
+ * to free once the last reference to the data is gone.
+ */
+final class BlockPrefetcher {
+    static final int SLOT_FREE = 0;
+    static final int SLOT_FILLED = 1;
+    static final int DEFAULT_DEPTH = 8;
+
+    private static final int END_OF_STREAM = -1;
+    private static final int READ_ERROR = -2;
+    private static final long WAIT_NANOS = TimeUnit.MILLISECONDS.toNanos(1);
+
+    private static final VarHandle STATE =
+            MethodHandles.byteBufferViewVarHandle(int[].class, ByteOrder.nativeOrder());
+
+    private final ConnectionHolder holder;
+    private final ByteBuffer states;
+    private final ByteBuffer[] blocks;
+    private final int depth;
+    // Sizes of the filled blocks in slot order, or a negative end code.
+    private final BlockingQueue<Integer> filled = new LinkedBlockingQueue<>();
+
+    private Thread thread;
+    private volatile boolean running;
+    private int fillSlot;           // accessed by the reader thread, and by stop() after it ended
+    private volatile int takeSlot;
+    private volatile int endCode;
+
+    /**
+     * Gets the number of blocks to read ahead from the
+     * {@code jfxmedia.prefetch} system property. Zero disables read-ahead.
+     * The native ring holds {@value #DEFAULT_DEPTH} blocks, larger values
+     * are limited to its size.
+     */
+    static int getDefaultDepth() {
+        Integer depth = Integer.getInteger("jfxmedia.prefetch", DEFAULT_DEPTH);
+        return Math.max(0, depth);
+    }
+
+    /**
+     * @param depth the maximum number of blocks read but not taken yet,
+     * limited to the number of slots in the ring
+     */
+    BlockPrefetcher(ConnectionHolder holder, ByteBuffer states, ByteBuffer blocks, int blockSize, int depth) {
+        int slots = states.capacity() / Integer.BYTES;
+        if (slots <= 0 || depth <= 0 || blockSize <= 0 || blocks.capacity() < (long)blockSize * slots) {
+            throw new IllegalArgumentException("Invalid prefetch ring");
+        }
+
+        this.holder = holder;
+        this.states = states;
+        this.blocks = new ByteBuffer[slots];
+        for (int i = 0; i < slots; i++) {
+            this.blocks[i] = blocks.slice(i * blockSize, blockSize);
+        }
+        this.depth = Math.min(depth, slots);
+    }
+
+    void start() {
+        running = true;
+        thread = new Thread(this::run);
+        thread.setName("JFXMedia Prefetch Thread");
+        thread.setDaemon(true);
+        thread.start();
+    }
+
+    /**
+     * Stops reading ahead and gives back the slots which were read but not
+     * taken yet, so the next {@link #start()} continues with the slot native
+     * code expects. A read in progress is completed and dropped.
+     */
+    void stop() {
+        Thread t = thread;
+        running = false;
+        if (t == null) {
+            return;
+        }
+
+        boolean interrupted = false;
+        while (t.isAlive()) {
+            try {
+                t.join();
+            } catch (InterruptedException ex) {
+                interrupted = true;
+            }
+        }
+        if (interrupted) {
+            Thread.currentThread().interrupt();
+        }
+        thread = null;
+
+        int slot = takeSlot;
+        Integer size;
+        while ((size = filled.poll()) != null) {
+            if (size > 0) {
+                STATE.setRelease(states, slot * Integer.BYTES, SLOT_FREE);
+                slot = (slot + 1) % blocks.length;
+            }
+        }
+        fillSlot = takeSlot;
+        endCode = 0;
+    }
+
+    /**
+     * Waits for the next block.
+     *
+     * @return the number of bytes in the next slot, -1 at the end of the
+     * stream or -2 if reading failed.
+     */
+    int take() {
+        if (endCode != 0) {
+            return endCode;
+        }
+
+        int size;
+        try {
+            size = filled.take();
+        } catch (InterruptedException ex) {
+            Thread.currentThread().interrupt();
+            return READ_ERROR;
+        }
+
+        if (size < 0) {
+            endCode = size;
+        } else {
+            takeSlot = (takeSlot + 1) % blocks.length;
+        }
+        return size;
+    }
+
+    private void run() {
+        try {
+            while (running) {
+                if (filled.size() >= depth ||
+                        (int)STATE.getAcquire(states, fillSlot * Integer.BYTES) != SLOT_FREE) {
+                    LockSupport.parkNanos(WAIT_NANOS);
+                    continue;
+                }
+
+                ReadableByteChannel channel = holder.channel;
+                if (channel == null) {
+                    throw new ClosedChannelException();
+                }
+
+                ByteBuffer block = blocks[fillSlot];
+                block.clear();
+                int read = channel.read(block);
+                if (!running) {
+                    break;
+                }
+
+                if (read < 0) {
+                    filled.add(END_OF_STREAM);
+                    break;
+                } else if (read > 0) {
+                    STATE.setRelease(states, fillSlot * Integer.BYTES, SLOT_FILLED);
+                    filled.add(read);
+                    fillSlot = (fillSlot + 1) % blocks.length;
+                }
+            }
+        } catch (IOException ex) {
+            if (running) {
+                filled.add(READ_ERROR);
+            }
+        }
+    }
+}
@@ -49,6 +49,7 @@ public abstract class ConnectionHolder {
 
     ReadableByteChannel channel;
     ByteBuffer          buffer = ByteBuffer.allocateDirect(DEFAULT_BUFFER_SIZE);
+    private BlockPrefetcher prefetcher;
 
     static ConnectionHolder createMemoryConnectionHolder(ByteBuffer buffer) {
         return new MemoryConnectionHolder(buffer);
@@ -76,6 +77,10 @@ public abstract class ConnectionHolder {
      * closeConnection has been called
      */
     public int readNextBlock() throws IOException {
+        if (prefetcher != null) {
+            return prefetcher.take();
+        }
+
         buffer.rewind();
         if (buffer.limit() < buffer.capacity()) {
             buffer.limit(buffer.capacity());
@@ -91,6 +96,45 @@ public abstract class ConnectionHolder {
         return buffer;
     }
 
+    /**
+     * Starts reading ahead into a ring of direct buffers provided by the
+     * native source. From then on {@link #readNextBlock()} returns the size of
+     * the next ring slot instead of filling {@link #getBuffer()}.
+     *
+     * @param states one native order int per slot, shared with native code
+     * @param blocks the slots, blockSize bytes each
+     * @param blockSize size of one slot
+     * @return true if read-ahead has been started, false if it is not
+     * possible or disabled with the {@code jfxmedia.prefetch} system property
+     */
+    boolean startPrefetch(ByteBuffer states, ByteBuffer blocks, int blockSize) {
+        int depth = BlockPrefetcher.getDefaultDepth();
+        if (null == channel || null != prefetcher || depth == 0) {
+            return false;
+        }
+
+        prefetcher = new BlockPrefetcher(this, states, blocks, blockSize, depth);
+        prefetcher.start();
+        return true;
+    }
+
+    /**
+     * Performs a seek request on behalf of the native source. Read-ahead is
+     * suspended while the stream is repositioned.
+     *
+     * @return -1 if the seek request failed or new stream position
+     */
+    long seekStream(long position) {
+        if (null == prefetcher) {
+            return seek(position);
+        }
+
+        prefetcher.stop();
+        long result = seek(position);
+        prefetcher.start();
+        return result;
+    }
+
     /**
      * Reads a block of data from the arbitrary position of the opened stream.
      *
@@ -144,6 +188,11 @@ public abstract class ConnectionHolder {
         finally {
             channel = null;
         }
+
+        // Closing the channel ends a pending read, after this the native ring is not touched anymore.
+        if (prefetcher != null) {
+            prefetcher.stop();
+        }
     }
 
     /**
@@ -46,7 +46,10 @@ import java.util.concurrent.Semaphore;
 
 final class HLSConnectionHolder extends ConnectionHolder {
 
-    private URLConnection urlConnection = null;
+    private final SegmentPrefetcher segmentPrefetcher =
+            new SegmentPrefetcher(SegmentPrefetcher.getDefaultDepth());
+    private SegmentPrefetcher.Segment segment = null;
+    private int segmentLength = -1;
     private URLConnection headerConnection = null;
     private ReadableByteChannel headerChannel = null;
     private PlaylistThread playlistThread = new PlaylistThread();
@@ -57,7 +60,6 @@ final class HLSConnectionHolder extends ConnectionHolder {
     private Semaphore liveSemaphore = new Semaphore(0);
     private boolean isPlaylistClosed = false;
     private boolean isBitrateAdjustable = false;
-    private long startTime = -1;
     private boolean sendHeader = false;
     private static final long HLS_VALUE_FLOAT_MULTIPLIER = 1000;
     private static final int HLS_PROP_GET_DURATION = 1;
@@ -85,10 +87,6 @@ final class HLSConnectionHolder extends ConnectionHolder {
 
     @Override
     public int readNextBlock() throws IOException {
-        if (isBitrateAdjustable && startTime == -1) {
-            startTime = System.currentTimeMillis();
-        }
-
         if (headerChannel != null) {
             buffer.rewind();
             if (buffer.limit() < buffer.capacity()) {
@@ -103,10 +101,8 @@ final class HLSConnectionHolder extends ConnectionHolder {
         }
 
         int read = super.readNextBlock();
-        if (isBitrateAdjustable && read == -1) {
-            long readTime = System.currentTimeMillis() - startTime;
-            startTime = -1;
-            adjustBitrate(readTime);
+        if (isBitrateAdjustable && read == -1 && segment != null) {
+            adjustBitrate(segment.getDownloadMillis());
         }
 
         return read;
@@ -148,6 +144,7 @@ final class HLSConnectionHolder extends ConnectionHolder {
         currentPlaylist.close();
         super.closeConnection();
         resetConnection();
+        segmentPrefetcher.close();
         playlistThread.putState(PlaylistThread.STATE_EXIT);
     }
 
@@ -180,8 +177,11 @@ final class HLSConnectionHolder extends ConnectionHolder {
 
         resetHeaderConnection();
 
-        Locator.closeConnection(urlConnection);
-        urlConnection = null;
+        // Stops the download if the segment was left before its end.
+        if (segment != null) {
+            segment.cancel();
+            segment = null;
+        }
     }
 
     private void resetHeaderConnection() {
@@ -233,34 +233,37 @@ final class HLSConnectionHolder extends ConnectionHolder {
             return -1;
         }
 
+        segment = segmentPrefetcher.take(mediaFile);
+        if (segment == null) {
+            return -1;
+        }
+        segmentPrefetcher.schedule(currentPlaylist.getUpcomingMediaFiles(segmentPrefetcher.getDepth()));
+
         try {
-            URI uri = new URI(mediaFile);
-            urlConnection = uri.toURL().openConnection();
-            channel = openChannel();
-        } catch (IOException | URISyntaxException e) {
+            segmentLength = segment.awaitLength();
+            channel = segment.openChannel();
+        } catch (IOException e) {
             return -1;
         }
 
         if (currentPlaylist.isCurrentMediaFileDiscontinuity()) {
-            return (-1 * (urlConnection.getContentLength() + headerLength));
+            return (-1 * (segmentLength + headerLength));
         } else {
-            return (urlConnection.getContentLength() + headerLength);
+            return (segmentLength + headerLength);
         }
     }
 
-    private ReadableByteChannel openChannel() throws IOException {
-        return Channels.newChannel(urlConnection.getInputStream());
-    }
-
     private ReadableByteChannel openHeaderChannel() throws IOException {
         return Channels.newChannel(headerConnection.getInputStream());
     }
 
-    private void adjustBitrate(long readTime) {
-        int avgBitrate = (int)(((long) urlConnection.getContentLength() * 8 * 1000) / readTime);
+    private void adjustBitrate(long downloadTime) {
+        int avgBitrate = (int)(((long) segmentLength * 8 * 1000) / Math.max(downloadTime, 1));
 
         Playlist playlist = variantPlaylist.getPlaylistBasedOnBitrate(avgBitrate);
         if (playlist != null && playlist != currentPlaylist) {
+            // Segments fetched ahead belong to the old playlist.
+            segmentPrefetcher.cancel();
             if (currentPlaylist.isLive()) {
                 playlist.update(currentPlaylist.getNextMediaFile());
                 playlistThread.setReloadPlaylist(playlist);
@@ -402,6 +405,9 @@ final class HLSConnectionHolder extends ConnectionHolder {
                     sendHeader = true;
                     mediaFileIndex = 0;
                 }
+
+                // Start downloading while the pipeline is being built
+                segmentPrefetcher.schedule(currentPlaylist.getUpcomingMediaFiles(segmentPrefetcher.getDepth()));
             } finally {
                 readySignal.countDown();
             }
@@ -911,6 +917,20 @@ final class HLSConnectionHolder extends ConnectionHolder {
             }
         }
 
+        private List<String> getUpcomingMediaFiles(int count) {
+            List<String> upcoming = new ArrayList<>();
+            synchronized (lock) {
+                for (int i = mediaFileIndex + 1; i < mediaFiles.size() && upcoming.size() < count; i++) {
+                    if (baseURI != null) {
+                        upcoming.add(baseURI + mediaFiles.get(i));
+                    } else {
+                        upcoming.add(mediaFiles.get(i));
+                    }
+                }
+            }
+            return upcoming;
+        }
+
         private String getHeaderFile() {
             synchronized (lock) {
                 if (mediaFiles.size() > 0) {
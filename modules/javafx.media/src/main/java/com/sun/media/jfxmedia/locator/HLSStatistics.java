@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.media.jfxmedia.locator;
+
+/**
+ * A snapshot of the counters of HLS segment loading for all streams of the
+ * process. A rebuffer is a read which found the next media data not
+ * downloaded yet once playback data had started to flow; waits before that
+ * count as startup time. The number of segments fetched ahead is set with the
+ * {@code jfxmedia.hls.prefetch} system property.
+ */
+public final class HLSStatistics {
+    private final long segmentsLoaded;
+    private final long prefetchHits;
+    private final long startupMillis;
+    private final long rebufferCount;
+    private final long rebufferMillis;
+
+    public HLSStatistics(long segmentsLoaded, long prefetchHits, long startupMillis,
+                         long rebufferCount, long rebufferMillis) {
+        this.segmentsLoaded = segmentsLoaded;
+        this.prefetchHits = prefetchHits;
+        this.startupMillis = startupMillis;
+        this.rebufferCount = rebufferCount;
+        this.rebufferMillis = rebufferMillis;
+    }
+
+    /**
+     * Gets the number of media segments handed to the pipeline.
+     * @return the number of loaded segments
+     */
+    public long getSegmentsLoaded() {
+        return segmentsLoaded;
+    }
+
+    /**
+     * Gets the number of segments whose download had been started ahead.
+     * @return the number of prefetch hits
+     */
+    public long getPrefetchHits() {
+        return prefetchHits;
+    }
+
+    /**
+     * Gets the time from opening the most recent stream until its first media
+     * data could be read.
+     * @return the startup time in milliseconds, or -1 if no stream started
+     */
+    public long getStartupMillis() {
+        return startupMillis;
+    }
+
+    /**
+     * Gets the number of reads which had to wait for the network.
+     * @return the number of rebuffers
+     */
+    public long getRebufferCount() {
+        return rebufferCount;
+    }
+
+    /**
+     * Gets the total time reads waited for the network after startup.
+     * @return the rebuffer time in milliseconds
+     */
+    public long getRebufferMillis() {
+        return rebufferMillis;
+    }
+
+    @Override
+    public String toString() {
+        return "[HLSStatistics segmentsLoaded=" + segmentsLoaded
+                + ", prefetchHits=" + prefetchHits + ", startupMillis=" + startupMillis
+                + ", rebufferCount=" + rebufferCount + ", rebufferMillis=" + rebufferMillis + "]";
+    }
+}
@@ -640,6 +640,15 @@ public class Locator {
         return MediaUtils.fileSignatureToContentType(signature, size);
     }
 
+    /**
+     * Gets the counters of HLS segment loading for all streams played so far.
+     *
+     * @return a snapshot of the HLS counters
+     */
+    public static HLSStatistics getHLSStatistics() {
+        return SegmentPrefetcher.getStatistics();
+    }
+
     static void closeConnection(URLConnection connection) {
         if (connection instanceof HttpURLConnection) {
             HttpURLConnection httpConnection = (HttpURLConnection)connection;
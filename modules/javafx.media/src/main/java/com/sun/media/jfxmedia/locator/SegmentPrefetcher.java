@@ -0,0 +1,433 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.media.jfxmedia.locator;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.InterruptedIOException;
+import java.net.URI;
+import java.net.URISyntaxException;
+import java.net.URLConnection;
+import java.nio.ByteBuffer;
+import java.nio.channels.AsynchronousCloseException;
+import java.nio.channels.ClosedChannelException;
+import java.nio.channels.ReadableByteChannel;
+import java.util.ArrayDeque;
+import java.util.Arrays;
+import java.util.Deque;
+import java.util.List;
+import java.util.concurrent.LinkedBlockingQueue;
+import java.util.concurrent.ThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicLong;
+
+/**
+ * Downloads the media segments of an HLS stream ahead of playback. The segment
+ * being played and up to {@code depth} upcoming segments are fetched
+ * concurrently into memory, so the progress buffer finds the next segment
+ * already downloaded, or at least connected, when the current one ends and
+ * demuxing of the next segment overlaps playback of the current one.
+ *
+ * Segments are requested strictly in playlist order through
+ * {@link #take(String)}. A request for a URI which was not prefetched, after a
+ * seek or a bitrate switch, drops the segments queued ahead of it.
+ *
+ * The counters behind {@link HLSStatistics} are collected here for all HLS
+ * streams of the process.
+ */
+final class SegmentPrefetcher {
+    static final int DEFAULT_DEPTH = 3;
+
+    private static final int BLOCK_SIZE = 64 * 1024;
+    private static final long KEEP_ALIVE_SECONDS = 10;
+
+    private static final AtomicLong segmentsLoaded = new AtomicLong();
+    private static final AtomicLong prefetchHits = new AtomicLong();
+    private static final AtomicLong rebufferCount = new AtomicLong();
+    private static final AtomicLong rebufferNanos = new AtomicLong();
+    private static volatile long startupNanos = -1;
+
+    private final int depth;
+    private final long createNanos = System.nanoTime();
+    private final ThreadPoolExecutor executor;
+    private final Deque<Segment> queue = new ArrayDeque<>();
+    private Segment current;            // the segment last handed out by take()
+    private volatile boolean started;
+    private boolean closed;
+
+    /**
+     * Gets the number of segments to fetch ahead from the
+     * {@code jfxmedia.hls.prefetch} system property. Zero fetches each
+     * segment only when it is requested.
+     */
+    static int getDefaultDepth() {
+        Integer depth = Integer.getInteger("jfxmedia.hls.prefetch", DEFAULT_DEPTH);
+        return Math.max(0, depth);
+    }
+
+    static HLSStatistics getStatistics() {
+        return new HLSStatistics(segmentsLoaded.get(), prefetchHits.get(),
+                startupNanos < 0 ? -1 : TimeUnit.NANOSECONDS.toMillis(startupNanos),
+                rebufferCount.get(), TimeUnit.NANOSECONDS.toMillis(rebufferNanos.get()));
+    }
+
+    SegmentPrefetcher(int depth) {
+        this.depth = depth;
+        executor = new ThreadPoolExecutor(depth + 1, depth + 1,
+                KEEP_ALIVE_SECONDS, TimeUnit.SECONDS, new LinkedBlockingQueue<>(), r -> {
+                    Thread thread = new Thread(r);
+                    thread.setName("JFXMedia HLS Segment Thread");
+                    thread.setDaemon(true);
+                    return thread;
+                });
+        executor.allowCoreThreadTimeOut(true);
+    }
+
+    int getDepth() {
+        return depth;
+    }
+
+    /**
+     * Starts downloading the given upcoming segments, in playlist order,
+     * unless they are already queued. At most {@code depth} segments are
+     * queued ahead.
+     */
+    synchronized void schedule(List<String> uris) {
+        if (closed) {
+            return;
+        }
+
+        for (String uri : uris) {
+            if (queue.size() >= depth) {
+                break;
+            }
+            if (find(uri) == null) {
+                queue.add(submit(uri));
+            }
+        }
+    }
+
+    /**
+     * Gets the segment to play next. Segments queued before it are cancelled.
+     *
+     * @return the segment, which may still be downloading, or null once
+     * closed
+     */
+    synchronized Segment take(String uri) {
+        if (closed) {
+            return null;
+        }
+
+        Segment segment = null;
+        if (find(uri) != null) {
+            while ((segment = queue.poll()) != null && !segment.uri.equals(uri)) {
+                segment.cancel();
+            }
+            prefetchHits.incrementAndGet();
+        } else {
+            cancelQueued();
+            segment = submit(uri);
+        }
+        segmentsLoaded.incrementAndGet();
+        current = segment;
+        return segment;
+    }
+
+    /**
+     * Cancels all segments queued ahead, for instance when switching to
+     * another playlist.
+     */
+    synchronized void cancel() {
+        cancelQueued();
+    }
+
+    /**
+     * Cancels the segment being played and all segments queued ahead. Reads
+     * from a cancelled segment fail with a {@code ClosedChannelException}.
+     */
+    synchronized void close() {
+        closed = true;
+        if (current != null) {
+            current.cancel();
+            current = null;
+        }
+        cancelQueued();
+        executor.shutdownNow();
+    }
+
+    private Segment find(String uri) {
+        for (Segment segment : queue) {
+            if (segment.uri.equals(uri)) {
+                return segment;
+            }
+        }
+        return null;
+    }
+
+    private Segment submit(String uri) {
+        Segment segment = new Segment(uri);
+        executor.execute(segment::download);
+        return segment;
+    }
+
+    private void cancelQueued() {
+        Segment segment;
+        while ((segment = queue.poll()) != null) {
+            segment.cancel();
+        }
+    }
+
+    // Called with the first media data read, waits before are startup time.
+    private void dataRead() {
+        if (!started) {
+            started = true;
+            startupNanos = System.nanoTime() - createNanos;
+        }
+    }
+
+    private void waited(long nanos) {
+        if (started) {
+            rebufferCount.incrementAndGet();
+            rebufferNanos.addAndGet(nanos);
+        }
+    }
+
+    /**
+     * A segment downloaded on a prefetch thread. The data is kept in memory
+     * and is read through {@link #openChannel()} while it arrives.
+     */
+    final class Segment {
+        final String uri;
+
+        // Guarded by this.
+        private byte[] data = new byte[0];
+        private int length = -1;        // -1 until the response has started or failed
+        private int filled;
+        private boolean done;
+        private boolean cancelled;
+        private IOException error;
+        private InputStream stream;
+        private long downloadNanos;
+
+        private Segment(String uri) {
+            this.uri = uri;
+        }
+
+        /**
+         * Waits until the server has answered.
+         *
+         * @return the size of the segment as announced by the server, or as
+         * downloaded if the size was not announced
+         */
+        synchronized int awaitLength() throws IOException {
+            if (length < 0 && !done) {
+                long start = System.nanoTime();
+                try {
+                    while (length < 0 && !done) {
+                        wait();
+                    }
+                } catch (InterruptedException ex) {
+                    Thread.currentThread().interrupt();
+                    throw new InterruptedIOException();
+                } finally {
+                    waited(System.nanoTime() - start);
+                }
+            }
+
+            if (length < 0) {
+                throw error != null ? error : new ClosedChannelException();
+            }
+            return length;
+        }
+
+        /**
+         * Gets the time the download took, or has taken so far.
+         */
+        synchronized long getDownloadMillis() {
+            return TimeUnit.NANOSECONDS.toMillis(downloadNanos);
+        }
+
+        ReadableByteChannel openChannel() {
+            return new SegmentChannel();
+        }
+
+        synchronized void cancel() {
+            cancelled = true;
+            if (stream != null) {
+                try {
+                    stream.close(); // ends a blocked read on the download thread
+                } catch (IOException ex) {}
+            }
+            notifyAll();
+        }
+
+        private void download() {
+            long start = System.nanoTime();
+            InputStream in = null;
+            try {
+                URLConnection connection = new URI(uri).toURL().openConnection();
+                in = connection.getInputStream();
+                int contentLength = connection.getContentLength();
+                synchronized (this) {
+                    if (cancelled) {
+                        return;
+                    }
+                    stream = in;
+                    if (contentLength >= 0) {
+                        data = new byte[contentLength];
+                        length = contentLength;
+                    }
+                    notifyAll();
+                }
+
+                while (true) {
+                    byte[] buf;
+                    int offset;
+                    synchronized (this) {
+                        if (cancelled) {
+                            return;
+                        }
+                        if (filled == data.length) {
+                            if (length >= 0) {
+                                break;
+                            }
+                            // Readers keep using the old array for what it already holds.
+                            data = Arrays.copyOf(data, Math.max(BLOCK_SIZE, data.length * 2));
+                        }
+                        buf = data;
+                        offset = filled;
+                    }
+
+                    int read = in.read(buf, offset, Math.min(BLOCK_SIZE, buf.length - offset));
+                    if (read < 0) {
+                        if (length >= 0) {
+                            // Readers were told the announced length.
+                            throw new IOException("Segment " + uri + " ended after "
+                                    + offset + " of " + length + " bytes");
+                        }
+                        break;
+                    }
+                    synchronized (this) {
+                        filled += read;
+                        downloadNanos = System.nanoTime() - start;
+                        notifyAll();
+                    }
+                }
+            } catch (IOException ex) {
+                synchronized (this) {
+                    error = ex;
+                }
+            } catch (URISyntaxException ex) {
+                synchronized (this) {
+                    error = new IOException(ex);
+                }
+            } finally {
+                if (in != null) {
+                    try {
+                        in.close();
+                    } catch (IOException ex) {}
+                }
+                synchronized (this) {
+                    if (error == null || length >= 0) {
+                        length = filled;
+                    }
+                    downloadNanos = System.nanoTime() - start;
+                    done = true;
+                    stream = null;
+                    notifyAll();
+                }
+            }
+        }
+
+        private final class SegmentChannel implements ReadableByteChannel {
+            // Guarded by the segment.
+            private int position;
+            private boolean open = true;
+
+            @Override
+            public int read(ByteBuffer dst) throws IOException {
+                byte[] src;
+                int offset;
+                int count;
+                synchronized (Segment.this) {
+                    if (!open) {
+                        throw new ClosedChannelException();
+                    }
+
+                    if (position == filled && !done && !cancelled) {
+                        long start = System.nanoTime();
+                        try {
+                            while (position == filled && !done && !cancelled && open) {
+                                Segment.this.wait();
+                            }
+                        } catch (InterruptedException ex) {
+                            Thread.currentThread().interrupt();
+                            throw new InterruptedIOException();
+                        } finally {
+                            waited(System.nanoTime() - start);
+                        }
+                        if (!open) {
+                            throw new AsynchronousCloseException();
+                        }
+                    }
+
+                    if (position == filled) {
+                        if (cancelled) {
+                            throw new ClosedChannelException();
+                        } else if (error != null) {
+                            throw error;
+                        }
+                        return -1;
+                    }
+
+                    src = data;
+                    offset = position;
+                    count = Math.min(filled - position, dst.remaining());
+                    position += count;
+                }
+
+                dst.put(src, offset, count);
+                dataRead();
+                return count;
+            }
+
+            @Override
+            public boolean isOpen() {
+                synchronized (Segment.this) {
+                    return open;
+                }
+            }
+
+            @Override
+            public void close() {
+                synchronized (Segment.this) {
+                    open = false;
+                    Segment.this.notifyAll();
+                }
+            }
+        }
+    }
+}
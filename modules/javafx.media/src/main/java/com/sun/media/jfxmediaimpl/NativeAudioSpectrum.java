@@ -26,9 +26,12 @@
 package com.sun.media.jfxmediaimpl;
 
 import com.sun.media.jfxmedia.effects.AudioSpectrum;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.FloatBuffer;
 
 final class NativeAudioSpectrum implements AudioSpectrum {
-    private static final float[] EMPTY_FLOAT_ARRAY  = new float[0];
+    private static final FloatBuffer EMPTY_FLOAT_BUFFER = FloatBuffer.allocate(0);
     public static final int      DEFAULT_THRESHOLD = -60;
     public static final int      DEFAULT_BANDS = 128;
     public static final double   DEFAULT_INTERVAL = 0.1;
@@ -38,8 +41,12 @@ final class NativeAudioSpectrum implements AudioSpectrum {
      */
     private final long nativeRef;
 
-    private float[] magnitudes = EMPTY_FLOAT_ARRAY;
-    private float[] phases = EMPTY_FLOAT_ARRAY;
+    /**
+     * Views of one direct buffer which the native spectrum writes directly,
+     * magnitudes followed by phases.
+     */
+    private FloatBuffer magnitudes = EMPTY_FLOAT_BUFFER;
+    private FloatBuffer phases = EMPTY_FLOAT_BUFFER;
 
     //**************************************************************************
     //***** Constructors
@@ -73,23 +80,26 @@ final class NativeAudioSpectrum implements AudioSpectrum {
 
     @Override
     public int getBandCount() {
-        // just return the current size of one of the band arrays
-        return phases.length;
+        // just return the current size of one of the band buffers
+        return phases.capacity();
     }
 
     @Override
     public void setBandCount(int bands) {
         if (bands > 1) {
-            magnitudes = new float[bands];
-            for (int i = 0; i < magnitudes.length; i++) {
-                magnitudes[i] = DEFAULT_THRESHOLD;//Float.NEGATIVE_INFINITY;
+            ByteBuffer data = ByteBuffer.allocateDirect(2 * bands * Float.BYTES)
+                    .order(ByteOrder.nativeOrder());
+            FloatBuffer values = data.asFloatBuffer();
+            for (int i = 0; i < bands; i++) {
+                values.put(i, DEFAULT_THRESHOLD);//Float.NEGATIVE_INFINITY;
             }
 
-            phases = new float[bands];
-            nativeSetBands(nativeRef, bands, magnitudes, phases);
+            magnitudes = values.slice(0, bands);
+            phases = values.slice(bands, bands);
+            nativeSetBands(nativeRef, bands, data);
         } else {
-            magnitudes = EMPTY_FLOAT_ARRAY;
-            phases = EMPTY_FLOAT_ARRAY;
+            magnitudes = EMPTY_FLOAT_BUFFER;
+            phases = EMPTY_FLOAT_BUFFER;
 
             throw new IllegalArgumentException("Number of bands must at least be 2");
         }
@@ -125,21 +135,23 @@ final class NativeAudioSpectrum implements AudioSpectrum {
 
     @Override
     public float[] getMagnitudes(float[] mag) {
-        int size = magnitudes.length;
+        FloatBuffer values = magnitudes;
+        int size = values.capacity();
         if(mag == null || mag.length < size) {
             mag = new float[size];
         }
-        System.arraycopy(magnitudes, 0, mag, 0, size);
+        values.get(0, mag, 0, size);
         return mag;
     }
 
     @Override
     public float[] getPhases(float[] phs) {
-        int size = phases.length;
+        FloatBuffer values = phases;
+        int size = values.capacity();
         if(phs == null || phs.length < size) {
             phs = new float[size];
         }
-        System.arraycopy(phases, 0, phs, 0, size);
+        values.get(0, phs, 0, size);
         return phs;
     }
 
@@ -148,7 +160,7 @@ final class NativeAudioSpectrum implements AudioSpectrum {
     //**************************************************************************
     private native boolean nativeGetEnabled(long nativeRef);
     private native void    nativeSetEnabled(long nativeRef, boolean enable);
-    private native void    nativeSetBands(long nativeRef, int bands, float[] magnitudes, float[] phases);
+    private native void    nativeSetBands(long nativeRef, int bands, ByteBuffer data);
     private native double  nativeGetInterval(long nativeRef);
     private native void    nativeSetInterval(long nativeRef, double interval);
     private native int     nativeGetThreshold(long nativeRef);
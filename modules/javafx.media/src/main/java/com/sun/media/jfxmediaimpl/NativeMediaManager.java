@@ -28,6 +28,7 @@ package com.sun.media.jfxmediaimpl;
 import com.sun.glass.utils.NativeLibLoader;
 import com.sun.javafx.PlatformUtil;
 import com.sun.media.jfxmedia.*;
+import com.sun.media.jfxmedia.control.VideoFramePoolStatistics;
 import com.sun.media.jfxmedia.events.MediaErrorListener;
 import com.sun.media.jfxmedia.locator.Locator;
 import com.sun.media.jfxmedia.logging.Logger;
@@ -386,6 +387,16 @@ public class NativeMediaManager {
         return allPlayers;
     }
 
+    /**
+     * Gets the counters of the native pool that recycles converted video
+     * frames.
+     *
+     * @see MediaManager#getVideoFramePoolStatistics()
+     */
+    public VideoFramePoolStatistics getVideoFramePoolStatistics() {
+        return NativeVideoBuffer.getFramePoolStatistics();
+    }
+
     //**************************************************************************
     //***** Private functions
     //**************************************************************************
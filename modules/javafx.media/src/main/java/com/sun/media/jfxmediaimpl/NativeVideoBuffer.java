@@ -27,6 +27,7 @@ package com.sun.media.jfxmediaimpl;
 
 import com.sun.media.jfxmedia.control.VideoDataBuffer;
 import com.sun.media.jfxmedia.control.VideoFormat;
+import com.sun.media.jfxmedia.control.VideoFramePoolStatistics;
 import java.nio.ByteBuffer;
 import java.util.concurrent.atomic.AtomicInteger;
 
@@ -37,6 +38,8 @@ final class NativeVideoBuffer implements VideoDataBuffer {
     private long nativePeer;
     private final AtomicInteger holdCount;
     private NativeVideoBuffer cachedBGRARep;
+    // Direct buffers over the native planes, created once per frame
+    private ByteBuffer[] planeBuffers;
 
     private static native void nativeDisposeBuffer(long handle);
 
@@ -52,11 +55,25 @@ final class NativeVideoBuffer implements VideoDataBuffer {
     private native int[] nativeGetPlaneStrides(long handle);
     private native long nativeConvertToFormat(long handle, int formatType);
     private native void nativeSetDirty(long handle);
+    private static native void nativeGetFramePoolStatistics(long[] statistics);
+
+    // Must match MAX_PLANE_COUNT in VideoFrame.h
+    private static final int MAX_PLANE_COUNT = 4;
 
     // This causes methods to throw an NPE if the native handle is invalid
     private static final boolean DEBUG_DISPOSED_BUFFERS = false;
     private static final VideoBufferDisposer disposer = new VideoBufferDisposer();
 
+    /**
+     * Gets the counters of the native pool that converted frames are taken
+     * from and returned to when they are released.
+     */
+    public static VideoFramePoolStatistics getFramePoolStatistics() {
+        long[] statistics = new long[3];
+        nativeGetFramePoolStatistics(statistics);
+        return new VideoFramePoolStatistics(statistics[0], statistics[1], statistics[2]);
+    }
+
     public static NativeVideoBuffer createVideoBuffer(long nativePeer) {
         NativeVideoBuffer buffer = new NativeVideoBuffer(nativePeer);
         MediaDisposer.addResourceDisposer(buffer, nativePeer, disposer);
@@ -89,7 +106,9 @@ final class NativeVideoBuffer implements VideoDataBuffer {
                     cachedBGRARep = null;
                 }
 
-                // last reference released, dispose and clear our native handle
+                // last reference released, dispose and clear our native handle,
+                // converted frames go back to the native frame pool
+                planeBuffers = null;
                 MediaDisposer.removeResourceDisposer(nativePeer);
                 nativeDisposeBuffer(nativePeer);
                 nativePeer = 0;
@@ -112,11 +131,24 @@ final class NativeVideoBuffer implements VideoDataBuffer {
     @Override
     public ByteBuffer getBufferForPlane(int plane) {
         if (0 != nativePeer) {
-            ByteBuffer buffer = nativeGetBufferForPlane(nativePeer, plane);
-            // NewDirectByteBuffer sets BIG_ENDIAN to be consistent with ByteBuffer
-            // So we need to force native order
-            buffer.order(java.nio.ByteOrder.nativeOrder());
-            return buffer;
+            if (plane < 0 || plane >= MAX_PLANE_COUNT) {
+                return null;
+            }
+            if (null == planeBuffers) {
+                planeBuffers = new ByteBuffer[MAX_PLANE_COUNT];
+            }
+            ByteBuffer buffer = planeBuffers[plane];
+            if (null == buffer) {
+                buffer = nativeGetBufferForPlane(nativePeer, plane);
+                if (null == buffer) {
+                    return null;
+                }
+                planeBuffers[plane] = buffer;
+            }
+            // Each caller gets its own position and limit over the same memory.
+            // NewDirectByteBuffer and duplicate() set BIG_ENDIAN to be consistent
+            // with ByteBuffer, so we need to force native order
+            return buffer.duplicate().order(java.nio.ByteOrder.nativeOrder());
         } else if (DEBUG_DISPOSED_BUFFERS) {
             throw new NullPointerException("method called on disposed NativeVideoBuffer");
         }
@@ -29,6 +29,11 @@
 
 #include "audio-converter.h"
 #include "gstaudiopack.h"
+#ifdef GSTREAMER_LITE
+#include "gstaudiopack-simd.h"
+#define audio_orc_s32_to_double audio_simd_s32_to_double
+#define audio_orc_double_to_s32 audio_simd_double_to_s32
+#endif // GSTREAMER_LITE
 
 /**
  * SECTION:gstaudioconverter
@@ -29,6 +29,12 @@
 #include "gstaudiopack.h"
 #else // GSTREAMER_LITE
 #include "gstaudiopack-dist.h"
+#include "gstaudiopack-simd.h"
+/* Vector versions of the common formats, see gstaudiopack-simd.c */
+#define audio_orc_unpack_s16 audio_simd_unpack_s16
+#define audio_orc_pack_s16 audio_simd_pack_s16
+#define audio_orc_unpack_f32 audio_simd_unpack_f32
+#define audio_orc_pack_f32 audio_simd_pack_f32
 #endif // GSTREAMER_LITE
 
 #ifdef HAVE_ORC
@@ -34,6 +34,10 @@
 #include <math.h>
 
 #include "gstaudiopack.h"
+#ifdef GSTREAMER_LITE
+#include "gstaudiopack-simd.h"
+#define audio_orc_int_bias audio_simd_int_bias
+#endif // GSTREAMER_LITE
 #include "audio-quantize.h"
 
 typedef void (*QuantizeFunc) (GstAudioQuantize * quant, const gpointer src,
@@ -0,0 +1,537 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/* SSE2 and AVX2 versions of the hot gstaudiopack functions, used while
+ * ORC is disabled. Each kernel handles whole vectors and returns the
+ * number of samples done; the rest goes through the generated C code in
+ * gstaudiopack-dist.c, which the kernels match bit for bit, including
+ * the flushing of denormals. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstaudiopack-simd.h"
+#include "gstaudiopack-dist.h"
+
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AUDIO_SIMD_HAVE_SSE2 1
+#include <emmintrin.h>
+#else
+#define AUDIO_SIMD_HAVE_SSE2 0
+#endif
+
+/* AVX2 kernels are built next to the SSE2 ones and picked at runtime */
+#if AUDIO_SIMD_HAVE_SSE2 && (defined (_MSC_VER) || defined (__GNUC__))
+#define AUDIO_SIMD_HAVE_AVX2 1
+#include <immintrin.h>
+#if defined (_MSC_VER)
+#include <intrin.h>
+#define AVX2_TARGET
+#else
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#else
+#define AUDIO_SIMD_HAVE_AVX2 0
+#endif
+
+#if AUDIO_SIMD_HAVE_SSE2
+/* Clears all but the sign of zeros and denormals, as ORC_DENORMAL does */
+static inline __m128
+sse2_flush_ps (__m128 x)
+{
+  const __m128 abs_mask = _mm_castsi128_ps (_mm_set1_epi32 (0x7fffffff));
+  const __m128 min_normal = _mm_castsi128_ps (_mm_set1_epi32 (0x00800000));
+  __m128 tiny = _mm_cmplt_ps (_mm_and_ps (x, abs_mask), min_normal);
+
+  return _mm_andnot_ps (_mm_and_ps (tiny, abs_mask), x);
+}
+
+static inline __m128d
+sse2_flush_pd (__m128d x)
+{
+  const __m128d abs_mask =
+      _mm_castsi128_pd (_mm_set1_epi64x (G_GINT64_CONSTANT (0x7fffffffffffffff)));
+  const __m128d min_normal =
+      _mm_castsi128_pd (_mm_set1_epi64x (G_GINT64_CONSTANT (0x0010000000000000)));
+  __m128d tiny = _mm_cmplt_pd (_mm_and_pd (x, abs_mask), min_normal);
+
+  return _mm_andnot_pd (_mm_and_pd (tiny, abs_mask), x);
+}
+
+static int
+unpack_s16_sse2 (gint32 * d1, const guint8 * s1, int n)
+{
+  const __m128i bias = _mm_set1_epi16 ((gint16) 0x8000);
+  int i;
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    __m128i x = _mm_loadu_si128 ((const __m128i *) (s1 + 2 * i));
+    __m128i lo = _mm_xor_si128 (x, bias);
+
+    _mm_storeu_si128 ((__m128i *) (d1 + i), _mm_unpacklo_epi16 (lo, x));
+    _mm_storeu_si128 ((__m128i *) (d1 + i + 4), _mm_unpackhi_epi16 (lo, x));
+  }
+  return i;
+}
+
+static int
+pack_s16_sse2 (guint8 * d1, const gint32 * s1, int n)
+{
+  int i;
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    __m128i a = _mm_srai_epi32 (_mm_loadu_si128 ((const __m128i *) (s1 + i)),
+        16);
+    __m128i b =
+        _mm_srai_epi32 (_mm_loadu_si128 ((const __m128i *) (s1 + i + 4)), 16);
+
+    _mm_storeu_si128 ((__m128i *) (d1 + 2 * i), _mm_packs_epi32 (a, b));
+  }
+  return i;
+}
+
+static int
+unpack_f32_sse2 (gdouble * d1, const gfloat * s1, int n)
+{
+  int i;
+
+  for (i = 0; i + 4 <= n; i += 4) {
+    __m128 x = sse2_flush_ps (_mm_loadu_ps (s1 + i));
+
+    _mm_storeu_pd (d1 + i, _mm_cvtps_pd (x));
+    _mm_storeu_pd (d1 + i + 2, _mm_cvtps_pd (_mm_movehl_ps (x, x)));
+  }
+  return i;
+}
+
+static int
+pack_f32_sse2 (gfloat * d1, const gdouble * s1, int n)
+{
+  int i;
+
+  for (i = 0; i + 4 <= n; i += 4) {
+    __m128 a = _mm_cvtpd_ps (sse2_flush_pd (_mm_loadu_pd (s1 + i)));
+    __m128 b = _mm_cvtpd_ps (sse2_flush_pd (_mm_loadu_pd (s1 + i + 2)));
+
+    _mm_storeu_ps (d1 + i, sse2_flush_ps (_mm_movelh_ps (a, b)));
+  }
+  return i;
+}
+
+static int
+s32_to_double_sse2 (gdouble * d1, const gint32 * s1, int n)
+{
+  /* x / 2^31 is exact, so is the multiplication by 2^-31 */
+  const __m128d scale = _mm_set1_pd (1.0 / 2147483648.0);
+  int i;
+
+  for (i = 0; i + 4 <= n; i += 4) {
+    __m128i x = _mm_loadu_si128 ((const __m128i *) (s1 + i));
+
+    _mm_storeu_pd (d1 + i, _mm_mul_pd (_mm_cvtepi32_pd (x), scale));
+    _mm_storeu_pd (d1 + i + 2, _mm_mul_pd (_mm_cvtepi32_pd (_mm_srli_si128 (x,
+                    8)), scale));
+  }
+  return i;
+}
+
+/* Products that overflow or are NaN convert to 0x80000000, which the C
+ * code turns into 0x7fffffff when the product is positive */
+static inline __m128i
+sse2_saturate_high (__m128i r, __m128i high_words)
+{
+  __m128i overflow = _mm_cmpeq_epi32 (r, _mm_set1_epi32 (G_MININT32));
+  __m128i negative = _mm_srai_epi32 (high_words, 31);
+
+  return _mm_xor_si128 (r, _mm_andnot_si128 (negative, overflow));
+}
+
+static int
+double_to_s32_sse2 (gint32 * d1, const gdouble * s1, int n)
+{
+  const __m128d scale = _mm_set1_pd (2147483648.0);
+  int i;
+
+  /* Flushing the input, as the C code does, keeps denormals off the slow
+   * path; the products themselves are never denormal */
+  for (i = 0; i + 4 <= n; i += 4) {
+    __m128d a = _mm_mul_pd (sse2_flush_pd (_mm_loadu_pd (s1 + i)), scale);
+    __m128d b = _mm_mul_pd (sse2_flush_pd (_mm_loadu_pd (s1 + i + 2)), scale);
+    __m128i r = _mm_unpacklo_epi64 (_mm_cvttpd_epi32 (a), _mm_cvttpd_epi32 (b));
+    __m128i high = _mm_castps_si128 (_mm_shuffle_ps (_mm_castpd_ps (a),
+            _mm_castpd_ps (b), _MM_SHUFFLE (3, 1, 3, 1)));
+
+    _mm_storeu_si128 ((__m128i *) (d1 + i), sse2_saturate_high (r, high));
+  }
+  return i;
+}
+
+static int
+int_bias_sse2 (gint32 * d1, const gint32 * s1, int p1, int p2, int n)
+{
+  const __m128i bias = _mm_set1_epi32 (p1);
+  const __m128i mask = _mm_set1_epi32 (p2);
+  const __m128i max = _mm_set1_epi32 (G_MAXINT32);
+  int i;
+
+  for (i = 0; i + 4 <= n; i += 4) {
+    __m128i x = _mm_loadu_si128 ((const __m128i *) (s1 + i));
+    __m128i sum = _mm_add_epi32 (x, bias);
+    __m128i overflow = _mm_srai_epi32 (_mm_and_si128 (_mm_xor_si128 (x, sum),
+            _mm_xor_si128 (bias, sum)), 31);
+    __m128i limit = _mm_xor_si128 (_mm_srai_epi32 (x, 31), max);
+
+    sum = _mm_or_si128 (_mm_and_si128 (overflow, limit),
+        _mm_andnot_si128 (overflow, sum));
+    _mm_storeu_si128 ((__m128i *) (d1 + i), _mm_and_si128 (sum, mask));
+  }
+  return i;
+}
+#endif /* AUDIO_SIMD_HAVE_SSE2 */
+
+#if AUDIO_SIMD_HAVE_AVX2
+AVX2_TARGET static inline __m256
+avx2_flush_ps (__m256 x)
+{
+  const __m256 abs_mask = _mm256_castsi256_ps (_mm256_set1_epi32 (0x7fffffff));
+  const __m256 min_normal =
+      _mm256_castsi256_ps (_mm256_set1_epi32 (0x00800000));
+  __m256 tiny = _mm256_cmp_ps (_mm256_and_ps (x, abs_mask), min_normal,
+      _CMP_LT_OQ);
+
+  return _mm256_andnot_ps (_mm256_and_ps (tiny, abs_mask), x);
+}
+
+AVX2_TARGET static inline __m256d
+avx2_flush_pd (__m256d x)
+{
+  const __m256d abs_mask =
+      _mm256_castsi256_pd (_mm256_set1_epi64x (G_GINT64_CONSTANT
+          (0x7fffffffffffffff)));
+  const __m256d min_normal =
+      _mm256_castsi256_pd (_mm256_set1_epi64x (G_GINT64_CONSTANT
+          (0x0010000000000000)));
+  __m256d tiny = _mm256_cmp_pd (_mm256_and_pd (x, abs_mask), min_normal,
+      _CMP_LT_OQ);
+
+  return _mm256_andnot_pd (_mm256_and_pd (tiny, abs_mask), x);
+}
+
+AVX2_TARGET static int
+unpack_s16_avx2 (gint32 * d1, const guint8 * s1, int n)
+{
+  const __m256i bias = _mm256_set1_epi16 ((gint16) 0x8000);
+  int i;
+
+  for (i = 0; i + 16 <= n; i += 16) {
+    /* Reorder the quadwords so the in-lane unpacks come out in order */
+    __m256i x =
+        _mm256_permute4x64_epi64 (_mm256_loadu_si256 ((const __m256i *) (s1 +
+                2 * i)), _MM_SHUFFLE (3, 1, 2, 0));
+    __m256i lo = _mm256_xor_si256 (x, bias);
+
+    _mm256_storeu_si256 ((__m256i *) (d1 + i), _mm256_unpacklo_epi16 (lo, x));
+    _mm256_storeu_si256 ((__m256i *) (d1 + i + 8), _mm256_unpackhi_epi16 (lo,
+            x));
+  }
+  return i;
+}
+
+AVX2_TARGET static int
+pack_s16_avx2 (guint8 * d1, const gint32 * s1, int n)
+{
+  int i;
+
+  for (i = 0; i + 16 <= n; i += 16) {
+    __m256i a =
+        _mm256_srai_epi32 (_mm256_loadu_si256 ((const __m256i *) (s1 + i)), 16);
+    __m256i b =
+        _mm256_srai_epi32 (_mm256_loadu_si256 ((const __m256i *) (s1 + i + 8)),
+        16);
+
+    _mm256_storeu_si256 ((__m256i *) (d1 + 2 * i),
+        _mm256_permute4x64_epi64 (_mm256_packs_epi32 (a, b), _MM_SHUFFLE (3, 1,
+                2, 0)));
+  }
+  return i;
+}
+
+AVX2_TARGET static int
+unpack_f32_avx2 (gdouble * d1, const gfloat * s1, int n)
+{
+  int i;
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    __m256 x = avx2_flush_ps (_mm256_loadu_ps (s1 + i));
+
+    _mm256_storeu_pd (d1 + i, _mm256_cvtps_pd (_mm256_castps256_ps128 (x)));
+    _mm256_storeu_pd (d1 + i + 4,
+        _mm256_cvtps_pd (_mm256_extractf128_ps (x, 1)));
+  }
+  return i;
+}
+
+AVX2_TARGET static int
+pack_f32_avx2 (gfloat * d1, const gdouble * s1, int n)
+{
+  int i;
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    __m128 a = _mm256_cvtpd_ps (avx2_flush_pd (_mm256_loadu_pd (s1 + i)));
+    __m128 b = _mm256_cvtpd_ps (avx2_flush_pd (_mm256_loadu_pd (s1 + i + 4)));
+
+    _mm256_storeu_ps (d1 + i,
+        avx2_flush_ps (_mm256_insertf128_ps (_mm256_castps128_ps256 (a), b,
+                1)));
+  }
+  return i;
+}
+
+AVX2_TARGET static int
+s32_to_double_avx2 (gdouble * d1, const gint32 * s1, int n)
+{
+  const __m256d scale = _mm256_set1_pd (1.0 / 2147483648.0);
+  int i;
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    __m128i a = _mm_loadu_si128 ((const __m128i *) (s1 + i));
+    __m128i b = _mm_loadu_si128 ((const __m128i *) (s1 + i + 4));
+
+    _mm256_storeu_pd (d1 + i, _mm256_mul_pd (_mm256_cvtepi32_pd (a), scale));
+    _mm256_storeu_pd (d1 + i + 4, _mm256_mul_pd (_mm256_cvtepi32_pd (b),
+            scale));
+  }
+  return i;
+}
+
+AVX2_TARGET static int
+double_to_s32_avx2 (gint32 * d1, const gdouble * s1, int n)
+{
+  const __m256d scale = _mm256_set1_pd (2147483648.0);
+  const __m256i high_words = _mm256_setr_epi32 (1, 3, 5, 7, 1, 3, 5, 7);
+  const __m256i overflow_value = _mm256_set1_epi32 (G_MININT32);
+  int i;
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    __m256d a = _mm256_mul_pd (avx2_flush_pd (_mm256_loadu_pd (s1 + i)), scale);
+    __m256d b =
+        _mm256_mul_pd (avx2_flush_pd (_mm256_loadu_pd (s1 + i + 4)), scale);
+    __m256i r = _mm256_insertf128_si256 (_mm256_castsi128_si256
+        (_mm256_cvttpd_epi32 (a)), _mm256_cvttpd_epi32 (b), 1);
+    __m256i high = _mm256_permute2x128_si256 (_mm256_permutevar8x32_epi32
+        (_mm256_castpd_si256 (a), high_words),
+        _mm256_permutevar8x32_epi32 (_mm256_castpd_si256 (b), high_words),
+        0x20);
+    __m256i overflow = _mm256_cmpeq_epi32 (r, overflow_value);
+    __m256i negative = _mm256_srai_epi32 (high, 31);
+
+    _mm256_storeu_si256 ((__m256i *) (d1 + i), _mm256_xor_si256 (r,
+            _mm256_andnot_si256 (negative, overflow)));
+  }
+  return i;
+}
+
+AVX2_TARGET static int
+int_bias_avx2 (gint32 * d1, const gint32 * s1, int p1, int p2, int n)
+{
+  const __m256i bias = _mm256_set1_epi32 (p1);
+  const __m256i mask = _mm256_set1_epi32 (p2);
+  const __m256i max = _mm256_set1_epi32 (G_MAXINT32);
+  int i;
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    __m256i x = _mm256_loadu_si256 ((const __m256i *) (s1 + i));
+    __m256i sum = _mm256_add_epi32 (x, bias);
+    __m256i overflow =
+        _mm256_srai_epi32 (_mm256_and_si256 (_mm256_xor_si256 (x, sum),
+            _mm256_xor_si256 (bias, sum)), 31);
+    __m256i limit = _mm256_xor_si256 (_mm256_srai_epi32 (x, 31), max);
+
+    sum = _mm256_blendv_epi8 (sum, limit, overflow);
+    _mm256_storeu_si256 ((__m256i *) (d1 + i), _mm256_and_si256 (sum, mask));
+  }
+  return i;
+}
+
+static int
+audio_simd_cpu_has_avx2 (void)
+{
+#if defined (_MSC_VER)
+  int info[4];
+
+  __cpuid (info, 0);
+  if (info[0] < 7)
+    return 0;
+
+  /* AVX and OSXSAVE, and the OS saves the YMM registers */
+  __cpuid (info, 1);
+  if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0
+      || (_xgetbv (0) & 6) != 6)
+    return 0;
+
+  __cpuidex (info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  __builtin_cpu_init ();
+  return __builtin_cpu_supports ("avx2");
+#endif
+}
+#endif /* AUDIO_SIMD_HAVE_AVX2 */
+
+static volatile gint audio_simd_level = -1;
+
+static gboolean
+audio_simd_level_supported (gint level)
+{
+  switch (level) {
+    case AUDIO_SIMD_C:
+      return TRUE;
+#if AUDIO_SIMD_HAVE_SSE2
+    case AUDIO_SIMD_SSE2:
+      return TRUE;
+#endif
+#if AUDIO_SIMD_HAVE_AVX2
+    case AUDIO_SIMD_AVX2:
+      return audio_simd_cpu_has_avx2 ();
+#endif
+    default:
+      return FALSE;
+  }
+}
+
+gint
+audio_simd_get_level (void)
+{
+  gint level = audio_simd_level;
+
+  if (level < 0) {
+    for (level = AUDIO_SIMD_AVX2; level > AUDIO_SIMD_C; level--) {
+      if (audio_simd_level_supported (level))
+        break;
+    }
+    audio_simd_level = level;
+  }
+  return level;
+}
+
+gint
+audio_simd_set_level (gint level)
+{
+  if (audio_simd_level_supported (level))
+    audio_simd_level = level;
+  return audio_simd_get_level ();
+}
+
+#if AUDIO_SIMD_HAVE_SSE2
+#define SSE2_CASE(done,name,args) \
+    case AUDIO_SIMD_SSE2: done = name##_sse2 args; break;
+#else
+#define SSE2_CASE(done,name,args)
+#endif
+
+#if AUDIO_SIMD_HAVE_AVX2
+#define AVX2_CASE(done,name,args) \
+    case AUDIO_SIMD_AVX2: done = name##_avx2 args; break;
+#else
+#define AVX2_CASE(done,name,args)
+#endif
+
+#define RUN_KERNEL(done,name,args) \
+  switch (audio_simd_get_level ()) { \
+    AVX2_CASE (done, name, args) \
+    SSE2_CASE (done, name, args) \
+    default: done = 0; break; \
+  }
+
+void
+audio_simd_unpack_s16 (gint32 * d1, const guint8 * s1, int n)
+{
+  int i;
+
+  RUN_KERNEL (i, unpack_s16, (d1, s1, n));
+  if (i < n)
+    audio_orc_unpack_s16 (d1 + i, s1 + 2 * i, n - i);
+}
+
+void
+audio_simd_pack_s16 (guint8 * d1, const gint32 * s1, int n)
+{
+  int i;
+
+  RUN_KERNEL (i, pack_s16, (d1, s1, n));
+  if (i < n)
+    audio_orc_pack_s16 (d1 + 2 * i, s1 + i, n - i);
+}
+
+void
+audio_simd_unpack_f32 (gdouble * d1, const gfloat * s1, int n)
+{
+  int i;
+
+  RUN_KERNEL (i, unpack_f32, (d1, s1, n));
+  if (i < n)
+    audio_orc_unpack_f32 (d1 + i, s1 + i, n - i);
+}
+
+void
+audio_simd_pack_f32 (gfloat * d1, const gdouble * s1, int n)
+{
+  int i;
+
+  RUN_KERNEL (i, pack_f32, (d1, s1, n));
+  if (i < n)
+    audio_orc_pack_f32 (d1 + i, s1 + i, n - i);
+}
+
+void
+audio_simd_s32_to_double (gdouble * d1, const gint32 * s1, int n)
+{
+  int i;
+
+  RUN_KERNEL (i, s32_to_double, (d1, s1, n));
+  if (i < n)
+    audio_orc_s32_to_double (d1 + i, s1 + i, n - i);
+}
+
+void
+audio_simd_double_to_s32 (gint32 * d1, const gdouble * s1, int n)
+{
+  int i;
+
+  RUN_KERNEL (i, double_to_s32, (d1, s1, n));
+  if (i < n)
+    audio_orc_double_to_s32 (d1 + i, s1 + i, n - i);
+}
+
+void
+audio_simd_int_bias (gint32 * d1, const gint32 * s1, int p1, int p2, int n)
+{
+  int i;
+
+  RUN_KERNEL (i, int_bias, (d1, s1, p1, p2, n));
+  if (i < n)
+    audio_orc_int_bias (d1 + i, s1 + i, p1, p2, n - i);
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef __GST_AUDIO_PACK_SIMD_H__
+#define __GST_AUDIO_PACK_SIMD_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Instruction set levels of the audio_simd_* functions */
+enum
+{
+  AUDIO_SIMD_C = 0,
+  AUDIO_SIMD_SSE2,
+  AUDIO_SIMD_AVX2
+};
+
+/* Same results as the audio_orc_* functions of the same name in
+ * gstaudiopack-dist.c, which handle the tails and the C level. */
+void audio_simd_unpack_s16 (gint32 * d1, const guint8 * s1, int n);
+void audio_simd_pack_s16 (guint8 * d1, const gint32 * s1, int n);
+void audio_simd_unpack_f32 (gdouble * d1, const gfloat * s1, int n);
+void audio_simd_pack_f32 (gfloat * d1, const gdouble * s1, int n);
+void audio_simd_s32_to_double (gdouble * d1, const gint32 * s1, int n);
+void audio_simd_double_to_s32 (gint32 * d1, const gdouble * s1, int n);
+void audio_simd_int_bias (gint32 * d1, const gint32 * s1, int p1, int p2,
+    int n);
+
+/* Returns the level in use, the best one the CPU supports by default */
+gint audio_simd_get_level (void);
+
+/* Selects a level if the CPU supports it, returns the level in use */
+gint audio_simd_set_level (gint level);
+
+G_END_DECLS
+
+#endif /* __GST_AUDIO_PACK_SIMD_H__ */
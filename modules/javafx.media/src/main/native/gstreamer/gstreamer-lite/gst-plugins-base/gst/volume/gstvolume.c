@@ -58,6 +58,12 @@
 #include "gstvolumeorc.h"
 #else
 #include "gstvolumeorc-dist.h"
+#include "gstvolumesimd.h"
+/* Vector versions of the constant volume functions, see gstvolumesimd.c */
+#define volume_orc_scalarmultiply_f64_ns volume_simd_scalarmultiply_f64_ns
+#define volume_orc_scalarmultiply_f32_ns volume_simd_scalarmultiply_f32_ns
+#define volume_orc_process_int16 volume_simd_process_int16
+#define volume_orc_process_int16_clamp volume_simd_process_int16_clamp
 #endif
 #include "gstvolume.h"
 
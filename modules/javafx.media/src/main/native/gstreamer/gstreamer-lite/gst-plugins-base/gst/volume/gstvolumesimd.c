@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/* SSE2 and AVX2 versions of the constant volume functions, used while ORC
+ * is disabled. The kernels handle whole vectors and the rest goes through
+ * the generated C code in gstvolumeorc-dist.c, which they match bit for
+ * bit. The instruction set level is shared with gstaudiopack-simd.c. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/audio/gstaudiopack-simd.h>
+
+#include "gstvolumesimd.h"
+#include "gstvolumeorc-dist.h"
+
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VOLUME_SIMD_HAVE_SSE2 1
+#include <emmintrin.h>
+#else
+#define VOLUME_SIMD_HAVE_SSE2 0
+#endif
+
+#if VOLUME_SIMD_HAVE_SSE2 && (defined (_MSC_VER) || defined (__GNUC__))
+#define VOLUME_SIMD_HAVE_AVX2 1
+#include <immintrin.h>
+#if defined (_MSC_VER)
+#define AVX2_TARGET
+#else
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#else
+#define VOLUME_SIMD_HAVE_AVX2 0
+#endif
+
+#if VOLUME_SIMD_HAVE_SSE2
+/* Clears all but the sign of zeros and denormals, as ORC_DENORMAL does */
+static inline __m128
+sse2_flush_ps (__m128 x)
+{
+  const __m128 abs_mask = _mm_castsi128_ps (_mm_set1_epi32 (0x7fffffff));
+  const __m128 min_normal = _mm_castsi128_ps (_mm_set1_epi32 (0x00800000));
+  __m128 tiny = _mm_cmplt_ps (_mm_and_ps (x, abs_mask), min_normal);
+
+  return _mm_andnot_ps (_mm_and_ps (tiny, abs_mask), x);
+}
+
+static inline __m128d
+sse2_flush_pd (__m128d x)
+{
+  const __m128d abs_mask =
+      _mm_castsi128_pd (_mm_set1_epi64x (G_GINT64_CONSTANT (0x7fffffffffffffff)));
+  const __m128d min_normal =
+      _mm_castsi128_pd (_mm_set1_epi64x (G_GINT64_CONSTANT (0x0010000000000000)));
+  __m128d tiny = _mm_cmplt_pd (_mm_and_pd (x, abs_mask), min_normal);
+
+  return _mm_andnot_pd (_mm_and_pd (tiny, abs_mask), x);
+}
+
+static int
+scalarmultiply_f64_ns_sse2 (double *d1, double p1, int n)
+{
+  const __m128d volume = sse2_flush_pd (_mm_set1_pd (p1));
+  int i;
+
+  for (i = 0; i + 4 <= n; i += 4) {
+    __m128d a = sse2_flush_pd (_mm_loadu_pd (d1 + i));
+    __m128d b = sse2_flush_pd (_mm_loadu_pd (d1 + i + 2));
+
+    _mm_storeu_pd (d1 + i, sse2_flush_pd (_mm_mul_pd (a, volume)));
+    _mm_storeu_pd (d1 + i + 2, sse2_flush_pd (_mm_mul_pd (b, volume)));
+  }
+  return i;
+}
+
+static int
+scalarmultiply_f32_ns_sse2 (float *d1, float p1, int n)
+{
+  const __m128 volume = sse2_flush_ps (_mm_set1_ps (p1));
+  int i;
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    __m128 a = sse2_flush_ps (_mm_loadu_ps (d1 + i));
+    __m128 b = sse2_flush_ps (_mm_loadu_ps (d1 + i + 4));
+
+    _mm_storeu_ps (d1 + i, sse2_flush_ps (_mm_mul_ps (a, volume)));
+    _mm_storeu_ps (d1 + i + 4, sse2_flush_ps (_mm_mul_ps (b, volume)));
+  }
+  return i;
+}
+
+/* The C code keeps bits 11 to 26 of the 32 bit product */
+static int
+process_int16_sse2 (gint16 * d1, int p1, int n)
+{
+  const __m128i volume = _mm_set1_epi16 ((gint16) p1);
+  int i;
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    __m128i x = _mm_loadu_si128 ((const __m128i *) (d1 + i));
+    __m128i lo = _mm_srli_epi16 (_mm_mullo_epi16 (x, volume), 11);
+    __m128i hi = _mm_slli_epi16 (_mm_mulhi_epi16 (x, volume), 5);
+
+    _mm_storeu_si128 ((__m128i *) (d1 + i), _mm_or_si128 (lo, hi));
+  }
+  return i;
+}
+
+static int
+process_int16_clamp_sse2 (gint16 * d1, int p1, int n)
+{
+  const __m128i volume = _mm_set1_epi16 ((gint16) p1);
+  int i;
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    __m128i x = _mm_loadu_si128 ((const __m128i *) (d1 + i));
+    __m128i lo = _mm_mullo_epi16 (x, volume);
+    __m128i hi = _mm_mulhi_epi16 (x, volume);
+    __m128i a = _mm_srai_epi32 (_mm_unpacklo_epi16 (lo, hi), 11);
+    __m128i b = _mm_srai_epi32 (_mm_unpackhi_epi16 (lo, hi), 11);
+
+    _mm_storeu_si128 ((__m128i *) (d1 + i), _mm_packs_epi32 (a, b));
+  }
+  return i;
+}
+#endif /* VOLUME_SIMD_HAVE_SSE2 */
+
+#if VOLUME_SIMD_HAVE_AVX2
+AVX2_TARGET static inline __m256
+avx2_flush_ps (__m256 x)
+{
+  const __m256 abs_mask = _mm256_castsi256_ps (_mm256_set1_epi32 (0x7fffffff));
+  const __m256 min_normal =
+      _mm256_castsi256_ps (_mm256_set1_epi32 (0x00800000));
+  __m256 tiny = _mm256_cmp_ps (_mm256_and_ps (x, abs_mask), min_normal,
+      _CMP_LT_OQ);
+
+  return _mm256_andnot_ps (_mm256_and_ps (tiny, abs_mask), x);
+}
+
+AVX2_TARGET static inline __m256d
+avx2_flush_pd (__m256d x)
+{
+  const __m256d abs_mask =
+      _mm256_castsi256_pd (_mm256_set1_epi64x (G_GINT64_CONSTANT
+          (0x7fffffffffffffff)));
+  const __m256d min_normal =
+      _mm256_castsi256_pd (_mm256_set1_epi64x (G_GINT64_CONSTANT
+          (0x0010000000000000)));
+  __m256d tiny = _mm256_cmp_pd (_mm256_and_pd (x, abs_mask), min_normal,
+      _CMP_LT_OQ);
+
+  return _mm256_andnot_pd (_mm256_and_pd (tiny, abs_mask), x);
+}
+
+AVX2_TARGET static int
+scalarmultiply_f64_ns_avx2 (double *d1, double p1, int n)
+{
+  const __m256d volume = avx2_flush_pd (_mm256_set1_pd (p1));
+  int i;
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    __m256d a = avx2_flush_pd (_mm256_loadu_pd (d1 + i));
+    __m256d b = avx2_flush_pd (_mm256_loadu_pd (d1 + i + 4));
+
+    _mm256_storeu_pd (d1 + i, avx2_flush_pd (_mm256_mul_pd (a, volume)));
+    _mm256_storeu_pd (d1 + i + 4, avx2_flush_pd (_mm256_mul_pd (b, volume)));
+  }
+  return i;
+}
+
+AVX2_TARGET static int
+scalarmultiply_f32_ns_avx2 (float *d1, float p1, int n)
+{
+  const __m256 volume = avx2_flush_ps (_mm256_set1_ps (p1));
+  int i;
+
+  for (i = 0; i + 16 <= n; i += 16) {
+    __m256 a = avx2_flush_ps (_mm256_loadu_ps (d1 + i));
+    __m256 b = avx2_flush_ps (_mm256_loadu_ps (d1 + i + 8));
+
+    _mm256_storeu_ps (d1 + i, avx2_flush_ps (_mm256_mul_ps (a, volume)));
+    _mm256_storeu_ps (d1 + i + 8, avx2_flush_ps (_mm256_mul_ps (b, volume)));
+  }
+  return i;
+}
+
+AVX2_TARGET static int
+process_int16_avx2 (gint16 * d1, int p1, int n)
+{
+  const __m256i volume = _mm256_set1_epi16 ((gint16) p1);
+  int i;
+
+  for (i = 0; i + 16 <= n; i += 16) {
+    __m256i x = _mm256_loadu_si256 ((const __m256i *) (d1 + i));
+    __m256i lo = _mm256_srli_epi16 (_mm256_mullo_epi16 (x, volume), 11);
+    __m256i hi = _mm256_slli_epi16 (_mm256_mulhi_epi16 (x, volume), 5);
+
+    _mm256_storeu_si256 ((__m256i *) (d1 + i), _mm256_or_si256 (lo, hi));
+  }
+  return i;
+}
+
+AVX2_TARGET static int
+process_int16_clamp_avx2 (gint16 * d1, int p1, int n)
+{
+  const __m256i volume = _mm256_set1_epi16 ((gint16) p1);
+  int i;
+
+  /* The unpacks and the pack stay within lanes, so the order holds */
+  for (i = 0; i + 16 <= n; i += 16) {
+    __m256i x = _mm256_loadu_si256 ((const __m256i *) (d1 + i));
+    __m256i lo = _mm256_mullo_epi16 (x, volume);
+    __m256i hi = _mm256_mulhi_epi16 (x, volume);
+    __m256i a = _mm256_srai_epi32 (_mm256_unpacklo_epi16 (lo, hi), 11);
+    __m256i b = _mm256_srai_epi32 (_mm256_unpackhi_epi16 (lo, hi), 11);
+
+    _mm256_storeu_si256 ((__m256i *) (d1 + i), _mm256_packs_epi32 (a, b));
+  }
+  return i;
+}
+#endif /* VOLUME_SIMD_HAVE_AVX2 */
+
+#if VOLUME_SIMD_HAVE_SSE2
+#define SSE2_CASE(done,name,args) \
+    case AUDIO_SIMD_SSE2: done = name##_sse2 args; break;
+#else
+#define SSE2_CASE(done,name,args)
+#endif
+
+#if VOLUME_SIMD_HAVE_AVX2
+#define AVX2_CASE(done,name,args) \
+    case AUDIO_SIMD_AVX2: done = name##_avx2 args; break;
+#else
+#define AVX2_CASE(done,name,args)
+#endif
+
+#define RUN_KERNEL(done,name,args) \
+  switch (audio_simd_get_level ()) { \
+    AVX2_CASE (done, name, args) \
+    SSE2_CASE (done, name, args) \
+    default: done = 0; break; \
+  }
+
+void
+volume_simd_scalarmultiply_f64_ns (double *d1, double p1, int n)
+{
+  int i;
+
+  RUN_KERNEL (i, scalarmultiply_f64_ns, (d1, p1, n));
+  if (i < n)
+    volume_orc_scalarmultiply_f64_ns (d1 + i, p1, n - i);
+}
+
+void
+volume_simd_scalarmultiply_f32_ns (float *d1, float p1, int n)
+{
+  int i;
+
+  RUN_KERNEL (i, scalarmultiply_f32_ns, (d1, p1, n));
+  if (i < n)
+    volume_orc_scalarmultiply_f32_ns (d1 + i, p1, n - i);
+}
+
+void
+volume_simd_process_int16 (gint16 * d1, int p1, int n)
+{
+  int i;
+
+  RUN_KERNEL (i, process_int16, (d1, p1, n));
+  if (i < n)
+    volume_orc_process_int16 (d1 + i, p1, n - i);
+}
+
+void
+volume_simd_process_int16_clamp (gint16 * d1, int p1, int n)
+{
+  int i;
+
+  RUN_KERNEL (i, process_int16_clamp, (d1, p1, n));
+  if (i < n)
+    volume_orc_process_int16_clamp (d1 + i, p1, n - i);
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef __GST_VOLUME_SIMD_H__
+#define __GST_VOLUME_SIMD_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Same results as the volume_orc_* functions of the same name in
+ * gstvolumeorc-dist.c, at the level audio_simd_get_level() selects */
+void volume_simd_scalarmultiply_f64_ns (double *d1, double p1, int n);
+void volume_simd_scalarmultiply_f32_ns (float *d1, float p1, int n);
+void volume_simd_process_int16 (gint16 * d1, int p1, int n);
+void volume_simd_process_int16_clamp (gint16 * d1, int p1, int n);
+
+G_END_DECLS
+
+#endif /* __GST_VOLUME_SIMD_H__ */
@@ -36,6 +36,13 @@
 
 #include "gst/glib-compat-private.h"
 
+#ifdef GSTREAMER_LITE
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IIR_EQUALIZER_SSE2 1
+#include <emmintrin.h>
+#endif
+#endif // GSTREAMER_LITE
+
 GST_DEBUG_CATEGORY (equalizer_debug);
 #define GST_CAT_DEFAULT equalizer_debug
 
@@ -425,6 +432,9 @@ gst_iir_equalizer_finalize (GObject * object)
 
   g_free (equ->bands);
   g_free (equ->history);
+#ifdef GSTREAMER_LITE
+  g_free (equ->coefficients);
+#endif // GSTREAMER_LITE
 
   g_mutex_clear (&equ->bands_lock);
 
@@ -642,6 +652,19 @@ update_coefficients (GstIirEqualizer * equ)
       setup_high_shelf_filter (equ, equ->bands[i]);
   }
 
+#ifdef GSTREAMER_LITE
+  equ->coefficients = g_renew (gdouble, equ->coefficients, 5 * n);
+  for (i = 0; i < n; i++) {
+    gdouble *c = equ->coefficients + 5 * i;
+
+    c[0] = equ->bands[i]->a0;
+    c[1] = equ->bands[i]->a1;
+    c[2] = equ->bands[i]->a2;
+    c[3] = equ->bands[i]->b1;
+    c[4] = equ->bands[i]->b2;
+  }
+#endif // GSTREAMER_LITE
+
   equ->need_new_coefficients = FALSE;
 }
 
@@ -651,9 +674,16 @@ alloc_history (GstIirEqualizer * equ, const GstAudioInfo * info)
 {
   /* free + alloc = no memcpy */
   g_free (equ->history);
+#ifdef GSTREAMER_LITE
+  /* channels are filtered in pairs */
+  equ->history =
+      g_malloc0 (equ->history_size * GST_ROUND_UP_2 (GST_AUDIO_INFO_CHANNELS
+          (info)) * equ->freq_band_count);
+#else // GSTREAMER_LITE
   equ->history =
       g_malloc0 (equ->history_size * GST_AUDIO_INFO_CHANNELS (info) *
       equ->freq_band_count);
+#endif // GSTREAMER_LITE
 }
 
 void
@@ -746,6 +776,215 @@ gst_iir_equalizer_compute_frequencies (GstIirEqualizer * equ, guint new_count)
 
 /* start of code that is type specific */
 
+#ifdef GSTREAMER_LITE
+/* Samples are converted to double and filtered in blocks, two channels at a
+ * time in one SIMD register. The history is kept in double for all formats.
+ */
+#define BLOCK_FRAMES 256
+
+/* history of one band for two channels: x1, x2, y1, y2 */
+#define HISTORY_VALUES 8
+
+#if defined (IIR_EQUALIZER_SSE2)
+typedef __m128d Pair;
+#define PAIR_SET1(v)        _mm_set1_pd (v)
+#define PAIR_LOAD(p)        _mm_loadu_pd (p)
+#define PAIR_STORE(p, v)    _mm_storeu_pd (p, v)
+#define PAIR_ADD(a, b)      _mm_add_pd (a, b)
+#define PAIR_MUL(a, b)      _mm_mul_pd (a, b)
+#else
+typedef struct
+{
+  gdouble v[2];
+} Pair;
+
+static inline Pair
+pair_make (gdouble a, gdouble b)
+{
+  Pair r;
+
+  r.v[0] = a;
+  r.v[1] = b;
+  return r;
+}
+
+static inline void
+pair_store (gdouble * p, Pair x)
+{
+  p[0] = x.v[0];
+  p[1] = x.v[1];
+}
+
+static inline Pair
+pair_add (Pair a, Pair b)
+{
+  return pair_make (a.v[0] + b.v[0], a.v[1] + b.v[1]);
+}
+
+static inline Pair
+pair_mul (Pair a, Pair b)
+{
+  return pair_make (a.v[0] * b.v[0], a.v[1] * b.v[1]);
+}
+
+#define PAIR_SET1(v)        pair_make (v, v)
+#define PAIR_LOAD(p)        pair_make ((p)[0], (p)[1])
+#define PAIR_STORE(p, v)    pair_store (p, v)
+#define PAIR_ADD(a, b)      pair_add (a, b)
+#define PAIR_MUL(a, b)      pair_mul (a, b)
+#endif
+
+static const guint history_size_gint16 = HISTORY_VALUES / 2 * sizeof (gdouble);
+static const guint history_size_gfloat = HISTORY_VALUES / 2 * sizeof (gdouble);
+static const guint history_size_gdouble = HISTORY_VALUES / 2 * sizeof (gdouble);
+
+typedef struct
+{
+  Pair a0, a1, a2, b1, b2;
+  Pair x1, x2, y1, y2;
+} Biquad;
+
+static inline void
+biquad_load (Biquad * q, const gdouble * coefficients, const gdouble * history)
+{
+  q->a0 = PAIR_SET1 (coefficients[0]);
+  q->a1 = PAIR_SET1 (coefficients[1]);
+  q->a2 = PAIR_SET1 (coefficients[2]);
+  q->b1 = PAIR_SET1 (coefficients[3]);
+  q->b2 = PAIR_SET1 (coefficients[4]);
+  q->x1 = PAIR_LOAD (history + 0);
+  q->x2 = PAIR_LOAD (history + 2);
+  q->y1 = PAIR_LOAD (history + 4);
+  q->y2 = PAIR_LOAD (history + 6);
+}
+
+static inline void
+biquad_store (const Biquad * q, gdouble * history)
+{
+  PAIR_STORE (history + 0, q->x1);
+  PAIR_STORE (history + 2, q->x2);
+  PAIR_STORE (history + 4, q->y1);
+  PAIR_STORE (history + 6, q->y2);
+}
+
+static inline Pair
+biquad_step (Biquad * q, Pair x)
+{
+  /* same order of operations as the scalar filter */
+  Pair y = PAIR_ADD (PAIR_ADD (PAIR_ADD (PAIR_ADD (PAIR_MUL (q->a0, x),
+                  PAIR_MUL (q->a1, q->x1)), PAIR_MUL (q->a2, q->x2)),
+          PAIR_MUL (q->b1, q->y1)), PAIR_MUL (q->b2, q->y2));
+
+  q->x2 = q->x1;
+  q->x1 = x;
+  q->y2 = q->y1;
+  q->y1 = y;
+  return y;
+}
+
+static void
+gst_iir_equ_process_pairs (const gdouble * coefficients, gdouble * history,
+    guint nf, gdouble * block, guint frames)
+{
+  guint f, i;
+
+  /* Four bands at a time, staggered by one frame: while a band filters
+   * frame i the next one filters frame i - 1. The recursions of the four
+   * bands are independent and overlap in the pipeline.
+   */
+  for (f = 0; f + 4 <= nf && frames >= 4; f += 4) {
+    Biquad q0, q1, q2, q3;
+    Pair y0, y1, y2;
+
+    biquad_load (&q0, coefficients + 0, history + 0 * HISTORY_VALUES);
+    biquad_load (&q1, coefficients + 5, history + 1 * HISTORY_VALUES);
+    biquad_load (&q2, coefficients + 10, history + 2 * HISTORY_VALUES);
+    biquad_load (&q3, coefficients + 15, history + 3 * HISTORY_VALUES);
+
+    y0 = biquad_step (&q0, PAIR_LOAD (block));
+    y1 = biquad_step (&q1, y0);
+    y0 = biquad_step (&q0, PAIR_LOAD (block + 2));
+    y2 = biquad_step (&q2, y1);
+    y1 = biquad_step (&q1, y0);
+    y0 = biquad_step (&q0, PAIR_LOAD (block + 4));
+
+    for (i = 3; i < frames; i++) {
+      PAIR_STORE (block + 2 * (i - 3), biquad_step (&q3, y2));
+      y2 = biquad_step (&q2, y1);
+      y1 = biquad_step (&q1, y0);
+      y0 = biquad_step (&q0, PAIR_LOAD (block + 2 * i));
+    }
+
+    PAIR_STORE (block + 2 * (frames - 3), biquad_step (&q3, y2));
+    y2 = biquad_step (&q2, y1);
+    y1 = biquad_step (&q1, y0);
+    PAIR_STORE (block + 2 * (frames - 2), biquad_step (&q3, y2));
+    y2 = biquad_step (&q2, y1);
+    PAIR_STORE (block + 2 * (frames - 1), biquad_step (&q3, y2));
+
+    biquad_store (&q0, history + 0 * HISTORY_VALUES);
+    biquad_store (&q1, history + 1 * HISTORY_VALUES);
+    biquad_store (&q2, history + 2 * HISTORY_VALUES);
+    biquad_store (&q3, history + 3 * HISTORY_VALUES);
+
+    coefficients += 4 * 5;
+    history += 4 * HISTORY_VALUES;
+  }
+
+  for (; f < nf; f++) {
+    Biquad q;
+
+    biquad_load (&q, coefficients, history);
+    for (i = 0; i < frames; i++)
+      PAIR_STORE (block + 2 * i, biquad_step (&q, PAIR_LOAD (block + 2 * i)));
+    biquad_store (&q, history);
+
+    coefficients += 5;
+    history += HISTORY_VALUES;
+  }
+}
+
+#define CREATE_OPTIMIZED_FUNCTIONS(TYPE,STORE)                          \
+static void                                                             \
+gst_iir_equ_process_ ## TYPE (GstIirEqualizer *equ, guint8 *data,       \
+guint size, guint channels)                                             \
+{                                                                       \
+  guint frames = size / channels / sizeof (TYPE);                       \
+  guint nf = equ->freq_band_count;                                      \
+  guint start, n, i, c;                                                 \
+  gdouble block[2 * BLOCK_FRAMES];                                      \
+                                                                        \
+  for (start = 0; start < frames; start += n) {                         \
+    n = MIN (frames - start, BLOCK_FRAMES);                             \
+    for (c = 0; c < channels; c += 2) {                                 \
+      TYPE *samples = (TYPE *) data + start * channels + c;             \
+      gdouble *history = (gdouble *) equ->history +                     \
+          c / 2 * nf * HISTORY_VALUES;                                  \
+      gboolean pair = (c + 1 < channels);                               \
+                                                                        \
+      for (i = 0; i < n; i++) {                                         \
+        block[2 * i] = samples[i * channels];                           \
+        block[2 * i + 1] = pair ? samples[i * channels + 1] : 0.0;      \
+      }                                                                 \
+      gst_iir_equ_process_pairs (equ->coefficients, history, nf,        \
+          block, n);                                                    \
+      for (i = 0; i < n; i++) {                                         \
+        STORE (samples[i * channels], block[2 * i]);                    \
+        if (pair)                                                       \
+          STORE (samples[i * channels + 1], block[2 * i + 1]);          \
+      }                                                                 \
+    }                                                                   \
+  }                                                                     \
+}
+
+#define STORE_gint16(dst, v) dst = (gint16) floor (CLAMP (v, -32768.0, 32767.0))
+#define STORE_gfloat(dst, v) dst = (gfloat) (v)
+#define STORE_gdouble(dst, v) dst = (v)
+
+CREATE_OPTIMIZED_FUNCTIONS (gint16, STORE_gint16);
+CREATE_OPTIMIZED_FUNCTIONS (gfloat, STORE_gfloat);
+CREATE_OPTIMIZED_FUNCTIONS (gdouble, STORE_gdouble);
+#else // GSTREAMER_LITE
 #define CREATE_OPTIMIZED_FUNCTIONS_INT(TYPE,BIG_TYPE,MIN_VAL,MAX_VAL)   \
 typedef struct {                                                        \
   BIG_TYPE x1, x2;          /* history of input values for a filter */  \
@@ -848,6 +1087,7 @@ guint size, guint channels)                                             \
 CREATE_OPTIMIZED_FUNCTIONS_INT (gint16, gfloat, -32768.0, 32767.0);
 CREATE_OPTIMIZED_FUNCTIONS (gfloat);
 CREATE_OPTIMIZED_FUNCTIONS (gdouble);
+#endif // GSTREAMER_LITE
 
 static GstFlowReturn
 gst_iir_equalizer_transform_ip (GstBaseTransform * btrans, GstBuffer * buf)
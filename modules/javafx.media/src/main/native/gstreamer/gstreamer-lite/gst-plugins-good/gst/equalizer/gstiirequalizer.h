@@ -64,6 +64,10 @@ struct _GstIirEqualizer
   /* for each band and channel */
   gpointer history;
   guint history_size;
+#ifdef GSTREAMER_LITE
+  /* a0, a1, a2, b1, b2 for each band, updated with the bands */
+  gdouble *coefficients;
+#endif // GSTREAMER_LITE
 
   gboolean need_new_coefficients;
 
@@ -261,6 +261,24 @@ gst_spectrum_alloc_channel_data (GstSpectrum * spectrum)
     cd->spect_magnitude = g_new0 (gfloat, bands);
     cd->spect_phase = g_new0 (gfloat, bands);
   }
+
+#ifdef GSTREAMER_LITE
+  /* Posted messages hold on to their buffer until the application has
+   * handled them, the pool grows to the number of messages in flight. */
+  if (!spectrum->multi_channel) {
+    GstStructure *config;
+
+    spectrum->message_pool = gst_buffer_pool_new ();
+    config = gst_buffer_pool_get_config (spectrum->message_pool);
+    gst_buffer_pool_config_set_params (config, NULL,
+        2 * bands * sizeof (gfloat), 2, 0);
+    if (!gst_buffer_pool_set_config (spectrum->message_pool, config) ||
+        !gst_buffer_pool_set_active (spectrum->message_pool, TRUE)) {
+      gst_object_unref (spectrum->message_pool);
+      spectrum->message_pool = NULL;
+    }
+  }
+#endif // GSTREAMER_LITE
 }
 
 static void
@@ -286,6 +304,15 @@ gst_spectrum_free_channel_data (GstSpectrum * spectrum)
     g_free (spectrum->channel_data);
     spectrum->channel_data = NULL;
   }
+
+#ifdef GSTREAMER_LITE
+  if (spectrum->message_pool) {
+    /* buffers still in messages keep the pool alive */
+    gst_buffer_pool_set_active (spectrum->message_pool, FALSE);
+    gst_object_unref (spectrum->message_pool);
+    spectrum->message_pool = NULL;
+  }
+#endif // GSTREAMER_LITE
 }
 
 static void
@@ -723,6 +750,33 @@ gst_spectrum_message_new (GstSpectrum * spectrum, GstClockTime timestamp,
       "running-time", G_TYPE_UINT64, running_time,
       "duration", G_TYPE_UINT64, duration, NULL);
 
+#ifdef GSTREAMER_LITE
+  /* Magnitudes followed by phases in one buffer, instead of one GValue per
+   * band and value. */
+  if (!spectrum->multi_channel && spectrum->message_pool) {
+    GstBuffer *data = NULL;
+    GstMapInfo info;
+
+    cd = &spectrum->channel_data[0];
+
+    if (gst_buffer_pool_acquire_buffer (spectrum->message_pool, &data,
+            NULL) == GST_FLOW_OK) {
+      if (gst_buffer_map (data, &info, GST_MAP_WRITE)) {
+        gfloat *values = (gfloat *) info.data;
+
+        memcpy (values, cd->spect_magnitude, spectrum->bands * sizeof (gfloat));
+        memcpy (values + spectrum->bands, cd->spect_phase,
+            spectrum->bands * sizeof (gfloat));
+        gst_buffer_unmap (data, &info);
+
+        gst_structure_set (s, "bands-data", GST_TYPE_BUFFER, data, NULL);
+      }
+      gst_buffer_unref (data);
+    }
+    return gst_message_new_element (GST_OBJECT (spectrum), s);
+  }
+#endif // GSTREAMER_LITE
+
   if (!spectrum->multi_channel) {
     cd = &spectrum->channel_data[0];
 
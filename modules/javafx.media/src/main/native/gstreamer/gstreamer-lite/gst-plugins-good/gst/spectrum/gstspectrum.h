@@ -91,6 +91,10 @@ struct _GstSpectrum
 
   GstSpectrumInputData input_data;
 
+#ifdef GSTREAMER_LITE
+  GstBufferPool *message_pool;  /* buffers for the "bands-data" field */
+#endif // GSTREAMER_LITE
+
 #if defined (GSTREAMER_LITE) && defined (OSX)
   guint bps_user; // User provided values to avoid more complex spectrum initialization
   guint bpf_user;
@@ -53,5 +53,11 @@
 // Not required since 58 and removed in 59
 #define NO_REGISTER_ALL        (LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59,0,0))
 
+// Frames can be decoded into buffers handed out by a custom get_buffer2()
+// without reserving edges around them; CODEC_FLAG_EMU_EDGE is gone in 57
+#define DIRECT_RENDERING       (LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57,0,0))
+// Until 58.134 frame threads call get_buffer2() only if it is declared thread safe
+#define THREAD_SAFE_CALLBACKS  (LIBAVCODEC_VERSION_INT < AV_VERSION_INT(58,134,100))
+
 #endif  /* AVDEFINES_H */
 
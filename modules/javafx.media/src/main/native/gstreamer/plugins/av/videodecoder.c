@@ -45,8 +45,14 @@ enum
     PROP_0,
     PROP_CODEC_ID,
     PROP_IS_SUPPORTED,
+    PROP_MAX_THREADS,
+    PROP_THREAD_TYPE,
 };
 
+// Buffers handed to libavcodec and pushed downstream are aligned to this
+#define VIDEODECODER_ALIGN 64
+#define VIDEODECODER_ALIGN_UP(x, a) (((x) + (a) - 1) & ~((a) - 1))
+
 /*
  * The input capabilities.
  */
@@ -115,13 +121,18 @@ GType videodecoder_get_type (void)
 static GstStateChangeReturn videodecoder_change_state(GstElement* element, GstStateChange transition);
 static gboolean             videodecoder_sink_event(GstPad *pad, GstObject *parent, GstEvent *event);
 static GstFlowReturn        videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffer *buf);
+static void                 videodecoder_drain(VideoDecoder *decoder);
 
 static void                 videodecoder_init_state(VideoDecoder *decoder);
 static void                 videodecoder_state_reset(VideoDecoder *decoder);
 
 static gboolean videodecoder_configure(VideoDecoder *decoder, GstCaps *sink_caps);
 
+static void videodecoder_init_context(BaseDecoder *base);
+static void (*parent_init_context)(BaseDecoder *base) = NULL;
+
 static void videodecoder_dispose(GObject* object);
+static void videodecoder_finalize(GObject* object);
 static void videodecoder_set_property(GObject *object, guint property_id, const GValue *value, GParamSpec *pspec);
 static void videodecoder_get_property(GObject *object, guint property_id, GValue *value, GParamSpec *pspec);
 
@@ -129,6 +140,7 @@ static void videodecoder_class_init(VideoDecoderClass *klass)
 {
     GstElementClass *element_class = GST_ELEMENT_CLASS(klass);
     GObjectClass *gobject_class = (GObjectClass*)klass;
+    BaseDecoderClass *base_class = BASEDECODER_CLASS(klass);
 
     gst_element_class_set_metadata(element_class,
                 "Videodecoder",
@@ -144,6 +156,7 @@ static void videodecoder_class_init(VideoDecoderClass *klass)
     element_class->change_state = videodecoder_change_state;
 
     gobject_class->dispose = videodecoder_dispose;
+    gobject_class->finalize = videodecoder_finalize;
     gobject_class->set_property = videodecoder_set_property;
     gobject_class->get_property = videodecoder_get_property;
 
@@ -154,6 +167,18 @@ static void videodecoder_class_init(VideoDecoderClass *klass)
     g_object_class_install_property (gobject_class, PROP_IS_SUPPORTED,
         g_param_spec_boolean ("is-supported", "Is supported", "Is codec ID supported", FALSE,
         (GParamFlags)(G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property (gobject_class, PROP_MAX_THREADS,
+        g_param_spec_int ("max-threads", "Maximum threads", "Decoding threads, 0 for one per CPU core", 0, 64, 0,
+        (GParamFlags)(G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS)));
+
+    g_object_class_install_property (gobject_class, PROP_THREAD_TYPE,
+        g_param_spec_int ("thread-type", "Thread type", "1 - frame threading, 2 - slice threading, 3 - both",
+        0, VIDEODECODER_THREAD_FRAME | VIDEODECODER_THREAD_SLICE, VIDEODECODER_THREAD_FRAME | VIDEODECODER_THREAD_SLICE,
+        (GParamFlags)(G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS)));
+
+    parent_init_context = base_class->init_context;
+    base_class->init_context = videodecoder_init_context;
 }
 
 static void videodecoder_init(VideoDecoder *decoder)
@@ -170,6 +195,8 @@ static void videodecoder_init(VideoDecoder *decoder)
     base->srcpad = gst_pad_new_from_static_template(&source_template, "src");
     gst_pad_use_fixed_caps(base->srcpad);
     gst_element_add_pad(GST_ELEMENT(decoder), base->srcpad);
+
+    g_mutex_init(&decoder->pool_lock);
 }
 
 void videodecoder_close_decoder(VideoDecoder *decoder)
@@ -193,17 +220,39 @@ void videodecoder_close_decoder(VideoDecoder *decoder)
         decoder->swscale_module = NULL;
     }
 #endif // HEVC_SUPPORT
+
+    // Buffers still in use downstream keep the pool alive until they are released
+    g_mutex_lock(&decoder->pool_lock);
+    if (decoder->pool)
+    {
+        gst_buffer_pool_set_active(decoder->pool, FALSE);
+        gst_object_unref(decoder->pool);
+        decoder->pool = NULL;
+    }
+    decoder->pool_size = 0;
+    decoder->pool_width = decoder->pool_height = 0;
+    g_mutex_unlock(&decoder->pool_lock);
 }
 
 static void videodecoder_dispose(GObject* object)
 {
     VideoDecoder *decoder = VIDEODECODER(object);
 
-    basedecoder_close_decoder(decoder);
+    basedecoder_close_decoder(BASEDECODER(decoder));
+    videodecoder_close_decoder(decoder);
 
     G_OBJECT_CLASS(parent_class)->dispose(object);
 }
 
+static void videodecoder_finalize(GObject* object)
+{
+    VideoDecoder *decoder = VIDEODECODER(object);
+
+    g_mutex_clear(&decoder->pool_lock);
+
+    G_OBJECT_CLASS(parent_class)->finalize(object);
+}
+
 static gboolean videodecoder_is_decoder_by_codec_id_supported(gint codec_id)
 {
     switch(codec_id)
@@ -234,6 +283,12 @@ static void videodecoder_set_property(GObject *object, guint property_id, const
     case PROP_CODEC_ID:
         decoder->codec_id = g_value_get_int(value);
         break;
+    case PROP_MAX_THREADS:
+        decoder->max_threads = g_value_get_int(value);
+        break;
+    case PROP_THREAD_TYPE:
+        decoder->thread_type = g_value_get_int(value);
+        break;
     default:
         break;
     }
@@ -249,6 +304,12 @@ static void videodecoder_get_property(GObject *object, guint property_id, GValue
         is_supported = videodecoder_is_decoder_by_codec_id_supported(decoder->codec_id);
         g_value_set_boolean(value, is_supported);
         break;
+    case PROP_MAX_THREADS:
+        g_value_set_int(value, decoder->max_threads);
+        break;
+    case PROP_THREAD_TYPE:
+        g_value_set_int(value, decoder->thread_type);
+        break;
     default:
         break;
     }
@@ -284,6 +345,7 @@ videodecoder_change_state(GstElement* element, GstStateChange transition)
     {
         case GST_STATE_CHANGE_PAUSED_TO_READY:
             basedecoder_close_decoder(BASEDECODER(decoder));
+            videodecoder_close_decoder(decoder);
             break;
         default:
             break;
@@ -316,6 +378,13 @@ static gboolean videodecoder_sink_event(GstPad *pad, GstObject *parent, GstEvent
             BASEDECODER(decoder)->is_flushing = FALSE;
             break;
 
+        case GST_EVENT_EOS:
+            // With frame threading the decoder holds back up to one frame per
+            // thread, push them before EOS goes downstream.
+            if (BASEDECODER(decoder)->is_initialized && !BASEDECODER(decoder)->is_flushing)
+                videodecoder_drain(decoder);
+            break;
+
         case GST_EVENT_CAPS:
         {
             GstCaps *caps;
@@ -362,12 +431,20 @@ static gboolean videodecoder_sink_event(GstPad *pad, GstObject *parent, GstEvent
 static void videodecoder_init_state(VideoDecoder *decoder)
 {
     decoder->width = decoder->height = 0;
+    decoder->y_offset = 0;
     decoder->u_offset = 0;
     decoder->v_offset = 0;
     decoder->uv_blocksize = 0;
     decoder->frame_size = 0;
+    decoder->stride[0] = decoder->stride[1] = decoder->stride[2] = 0;
     decoder->discont = FALSE;
     decoder->codec_id = JFX_CODEC_ID_UNKNOWN;
+    decoder->pool = NULL;
+    decoder->pool_size = 0;
+    decoder->pool_width = decoder->pool_height = 0;
+    decoder->direct_rendering = FALSE;
+    decoder->direct_caps = FALSE;
+    decoder->last_duration = GST_CLOCK_TIME_NONE;
 #if HEVC_SUPPORT
     decoder->sws_context = NULL;
     decoder->dest_frame = NULL;
@@ -560,10 +637,190 @@ static gboolean videodecoder_convert_frame(VideoDecoder *decoder)
 }
 #endif // HEVC_SUPPORT
 
+/***********************************************************************************
+ * Output buffer pool
+ ***********************************************************************************/
+// Returns a buffer of at least size bytes, reallocating the pool if the size
+// changed. Called from libavcodec threads as well as the streaming thread.
+static GstBuffer* videodecoder_acquire_buffer(VideoDecoder *decoder, unsigned int size)
+{
+    GstBufferPool *pool = NULL;
+    GstBuffer *buffer = NULL;
+
+    g_mutex_lock(&decoder->pool_lock);
+    if (decoder->pool && decoder->pool_size != size)
+    {
+        gst_buffer_pool_set_active(decoder->pool, FALSE);
+        gst_object_unref(decoder->pool);
+        decoder->pool = NULL;
+    }
+
+    if (decoder->pool == NULL)
+    {
+        GstAllocationParams params;
+        gst_allocation_params_init(&params);
+        params.align = VIDEODECODER_ALIGN - 1;
+
+        pool = gst_buffer_pool_new();
+        GstStructure *config = gst_buffer_pool_get_config(pool);
+        gst_buffer_pool_config_set_params(config, NULL, size, 0, 0);
+        gst_buffer_pool_config_set_allocator(config, NULL, &params);
+        if (gst_buffer_pool_set_config(pool, config) && gst_buffer_pool_set_active(pool, TRUE))
+        {
+            decoder->pool = pool;
+            decoder->pool_size = size;
+        }
+        else
+            gst_object_unref(pool);
+    }
+
+    pool = decoder->pool ? gst_object_ref(decoder->pool) : NULL;
+    g_mutex_unlock(&decoder->pool_lock);
+
+    if (pool)
+    {
+        if (gst_buffer_pool_acquire_buffer(pool, &buffer, NULL) != GST_FLOW_OK)
+            buffer = NULL;
+        gst_object_unref(pool);
+    }
+
+    return buffer;
+}
+
+#if DIRECT_RENDERING
+typedef struct
+{
+    GstBuffer  *buffer;
+    GstMapInfo  info;
+} PooledFrame;
+
+static void videodecoder_release_pooled_frame(void *opaque, uint8_t *data)
+{
+    PooledFrame *pooled = (PooledFrame*)opaque;
+
+    gst_buffer_unmap(pooled->buffer, &pooled->info);
+    gst_buffer_unref(pooled->buffer); // Back to the pool
+    g_free(pooled);
+}
+
+static void videodecoder_free_frame(gpointer data)
+{
+    AVFrame *frame = (AVFrame*)data;
+    av_frame_free(&frame);
+}
+
+// YUV420P frames are decoded straight into pool buffers laid out the way
+// the source caps describe them, so pushing them downstream needs no copy.
+// Other formats go through libswscale and use the default allocator.
+static int videodecoder_get_buffer2(AVCodecContext *context, AVFrame *frame, int flags)
+{
+    VideoDecoder *decoder = (VideoDecoder*)context->opaque;
+    int linesize_align[AV_NUM_DATA_POINTERS];
+    int linesize[3];
+    unsigned int offset[3];
+    unsigned int size;
+    int i;
+
+    if (frame->format != AV_PIX_FMT_YUV420P)
+        return avcodec_default_get_buffer2(context, frame, flags);
+
+    int width = frame->width;
+    int height = frame->height;
+    avcodec_align_dimensions2(context, &width, &height, linesize_align);
+
+    g_mutex_lock(&decoder->pool_lock);
+    if (decoder->pool_width != width || decoder->pool_height != height)
+    {
+        int stride = VIDEODECODER_ALIGN_UP(width, 2 * VIDEODECODER_ALIGN);
+
+        decoder->pool_linesize[0] = stride;
+        decoder->pool_linesize[1] = decoder->pool_linesize[2] = stride / 2;
+        decoder->pool_offset[0] = 0;
+        decoder->pool_offset[1] = stride * height;
+        decoder->pool_offset[2] = decoder->pool_offset[1] + (stride / 2) * (height / 2);
+        decoder->pool_width = width;
+        decoder->pool_height = height;
+    }
+    for (i = 0; i < 3; i++)
+    {
+        linesize[i] = decoder->pool_linesize[i];
+        offset[i] = decoder->pool_offset[i];
+    }
+    g_mutex_unlock(&decoder->pool_lock);
+
+    // Motion compensation may read a little past the last chroma row
+    size = offset[2] + linesize[2] * (height / 2) + 2 * VIDEODECODER_ALIGN;
+
+    GstBuffer *buffer = videodecoder_acquire_buffer(decoder, size);
+    if (buffer == NULL)
+        return AVERROR(ENOMEM);
+
+    PooledFrame *pooled = g_new(PooledFrame, 1);
+    pooled->buffer = buffer;
+    if (!gst_buffer_map(buffer, &pooled->info, GST_MAP_READWRITE))
+    {
+        gst_buffer_unref(buffer);
+        g_free(pooled);
+        return AVERROR(ENOMEM);
+    }
+
+    frame->buf[0] = av_buffer_create(pooled->info.data, pooled->info.size,
+                                     videodecoder_release_pooled_frame, pooled, 0);
+    if (frame->buf[0] == NULL)
+    {
+        videodecoder_release_pooled_frame(pooled, NULL);
+        return AVERROR(ENOMEM);
+    }
+
+    for (i = 0; i < 3; i++)
+    {
+        frame->data[i] = pooled->info.data + offset[i];
+        frame->linesize[i] = linesize[i];
+    }
+    frame->extended_data = frame->data;
+
+    return 0;
+}
+
+static gboolean videodecoder_is_pooled_frame(VideoDecoder *decoder, AVFrame *frame)
+{
+    return decoder->direct_rendering && frame->format == AV_PIX_FMT_YUV420P &&
+           frame->buf[0] != NULL && frame->buf[1] == NULL;
+}
+#endif // DIRECT_RENDERING
+
+static void videodecoder_init_context(BaseDecoder *base)
+{
+    VideoDecoder *decoder = VIDEODECODER(base);
+
+    parent_init_context(base);
+
+    base->context->thread_count = decoder->max_threads;
+    base->context->thread_type = 0;
+    if (decoder->thread_type & VIDEODECODER_THREAD_FRAME)
+        base->context->thread_type |= FF_THREAD_FRAME;
+    if (decoder->thread_type & VIDEODECODER_THREAD_SLICE)
+        base->context->thread_type |= FF_THREAD_SLICE;
+
+#if DIRECT_RENDERING
+    base->context->opaque = decoder;
+    base->context->get_buffer2 = videodecoder_get_buffer2;
+#if THREAD_SAFE_CALLBACKS
+    base->context->thread_safe_callbacks = 1;
+#endif
+    decoder->direct_rendering = TRUE;
+#endif // DIRECT_RENDERING
+}
+
+/***********************************************************************************
+ * Source caps
+ ***********************************************************************************/
 static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
 {
     BaseDecoder *base = BASEDECODER(decoder);
     gboolean set_linesize = TRUE;
+    gboolean direct = FALSE;
+    gboolean layout_changed = FALSE;
     int linesize0 = 0;
     int linesize1 = 0;
     int linesize2 = 0;
@@ -578,8 +835,28 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
     int height = base->context->height;
 #endif // NEW_CODEC_ID
 
+#if DIRECT_RENDERING
+    // Pooled frames are pushed as they are, so the caps have to follow
+    // their layout, which includes any cropping applied by libavcodec.
+    PooledFrame *pooled = NULL;
+    direct = videodecoder_is_pooled_frame(decoder, base->frame);
+    if (direct)
+    {
+        pooled = (PooledFrame*)av_buffer_get_opaque(base->frame->buf[0]);
+        layout_changed =
+            decoder->y_offset != (unsigned int)(base->frame->data[0] - pooled->info.data) ||
+            decoder->u_offset != (unsigned int)(base->frame->data[1] - pooled->info.data) ||
+            decoder->v_offset != (unsigned int)(base->frame->data[2] - pooled->info.data) ||
+            decoder->stride[0] != base->frame->linesize[0] ||
+            decoder->stride[1] != base->frame->linesize[1] ||
+            decoder->stride[2] != base->frame->linesize[2] ||
+            decoder->frame_size != (unsigned int)pooled->info.size;
+    }
+#endif // DIRECT_RENDERING
+
     if (caps == NULL ||
-        decoder->width != width || decoder->height != height)
+        decoder->width != width || decoder->height != height ||
+        decoder->direct_caps != direct || layout_changed)
     {
         decoder->width = width;
         decoder->height = height;
@@ -626,11 +903,30 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
             linesize2 = base->frame->linesize[2];
         }
 
-        decoder->u_offset = linesize0 * decoder->height;
-        decoder->uv_blocksize = linesize1 * decoder->height / 2;
+#if DIRECT_RENDERING
+        if (direct)
+        {
+            decoder->y_offset = (unsigned int)(base->frame->data[0] - pooled->info.data);
+            decoder->u_offset = (unsigned int)(base->frame->data[1] - pooled->info.data);
+            decoder->v_offset = (unsigned int)(base->frame->data[2] - pooled->info.data);
+            decoder->uv_blocksize = linesize1 * decoder->height / 2;
+            decoder->frame_size = (unsigned int)pooled->info.size;
+        }
+        else
+#endif // DIRECT_RENDERING
+        {
+            decoder->y_offset = 0;
+            decoder->u_offset = linesize0 * decoder->height;
+            decoder->uv_blocksize = linesize1 * decoder->height / 2;
 
-        decoder->v_offset = decoder->u_offset + decoder->uv_blocksize;
-        decoder->frame_size = (linesize0 + linesize1) * decoder->height;
+            decoder->v_offset = decoder->u_offset + decoder->uv_blocksize;
+            decoder->frame_size = (linesize0 + linesize1) * decoder->height;
+        }
+
+        decoder->stride[0] = linesize0;
+        decoder->stride[1] = linesize1;
+        decoder->stride[2] = linesize2;
+        decoder->direct_caps = direct;
 
         GstCaps *src_caps = gst_caps_new_simple("video/x-raw-yuv",
                                                 "format", G_TYPE_STRING, "YV12",
@@ -639,7 +935,7 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
                                                 "stride-y", G_TYPE_INT, linesize0,
                                                 "stride-u", G_TYPE_INT, linesize1,
                                                 "stride-v", G_TYPE_INT, linesize2,
-                                                "offset-y", G_TYPE_INT, 0,
+                                                "offset-y", G_TYPE_INT, decoder->y_offset,
                                                 "offset-u", G_TYPE_INT, decoder->u_offset,
                                                 "offset-v", G_TYPE_INT, decoder->v_offset,
                                                 "framerate", GST_TYPE_FRACTION, 2997, 100,
@@ -666,6 +962,270 @@ static gboolean videodecoder_configure_sourcepad(VideoDecoder *decoder)
 
     return TRUE;
 }
+
+/***********************************************************************************
+ * Output
+ ***********************************************************************************/
+// Copies the decoded (or converted) frame into a pool buffer laid out as
+// the source caps describe.
+static GstBuffer* videodecoder_copy_frame(VideoDecoder *decoder, uint8_t *data0, uint8_t *data1, uint8_t *data2)
+{
+    GstMapInfo   info2;
+    unsigned int out_buf_size = 0;
+    gboolean     copy_error = FALSE;
+
+    GstBuffer *outbuf = videodecoder_acquire_buffer(decoder, decoder->frame_size);
+    if (outbuf == NULL)
+    {
+        gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
+                                 GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
+                                 g_strdup("Decoded video buffer allocation failed"), NULL,
+                                 ("videodecoder.c"), ("videodecoder_copy_frame"), 0);
+        return NULL;
+    }
+
+    if (!gst_buffer_map(outbuf, &info2, GST_MAP_WRITE))
+    {
+        // INLINE - gst_buffer_unref()
+        gst_buffer_unref(outbuf);
+        gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
+                         g_strdup("Decoded video buffer allocation failed"), NULL, ("videodecoder.c"), ("videodecoder_copy_frame"), 0);
+        return NULL;
+    }
+
+    // Copy image by parts from different arrays.
+    if (decoder->frame_size > (unsigned int)info2.maxsize) // maxsize should be same or more due to alignment
+    {
+        gst_buffer_unmap(outbuf, &info2);
+        // INLINE - gst_buffer_unref()
+        gst_buffer_unref(outbuf);
+        gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
+                         g_strdup("Wrong buffer size"), NULL, ("videodecoder.c"), ("videodecoder_copy_frame"), 0);
+        return NULL;
+    }
+
+    out_buf_size = decoder->frame_size;
+    if (out_buf_size >= decoder->u_offset)
+    {
+        memcpy(info2.data, data0, decoder->u_offset);
+        out_buf_size -= decoder->u_offset;
+        if (out_buf_size >= decoder->uv_blocksize &&
+            decoder->uv_blocksize <= decoder->frame_size &&
+            decoder->u_offset <= (decoder->frame_size - decoder->uv_blocksize))
+        {
+            memcpy(info2.data + decoder->u_offset, data1, decoder->uv_blocksize);
+            out_buf_size -= decoder->uv_blocksize;
+            if (out_buf_size >= decoder->uv_blocksize &&
+                decoder->uv_blocksize <= decoder->frame_size &&
+                decoder->v_offset <= (decoder->frame_size - decoder->uv_blocksize))
+            {
+                memcpy(info2.data + decoder->v_offset, data2, decoder->uv_blocksize);
+            }
+            else
+            {
+                copy_error = TRUE;
+            }
+        }
+        else
+        {
+            copy_error = TRUE;
+        }
+    }
+    else
+    {
+        copy_error = TRUE;
+    }
+
+    gst_buffer_unmap(outbuf, &info2);
+
+    if (copy_error)
+    {
+        // INLINE - gst_buffer_unref()
+        gst_buffer_unref(outbuf);
+        gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
+                         g_strdup("Copy data failed"), NULL, ("videodecoder.c"), ("videodecoder_copy_frame"), 0);
+        return NULL;
+    }
+
+    return outbuf;
+}
+
+// Pushes base->frame downstream.
+static GstFlowReturn videodecoder_push_frame(VideoDecoder *decoder, GstClockTime duration, gboolean discont)
+{
+    BaseDecoder   *base = BASEDECODER(decoder);
+    GstBuffer     *outbuf = NULL;
+    GstFlowReturn  result = GST_FLOW_OK;
+    int64_t        reordered_opaque = base->frame->reordered_opaque;
+
+    if (!videodecoder_configure_sourcepad(decoder))
+        return GST_FLOW_ERROR;
+
+#if DIRECT_RENDERING
+    if (decoder->direct_caps)
+    {
+        // The buffer keeps its own reference to the frame, which returns
+        // the pool buffer once downstream is done with it.
+        PooledFrame *pooled = (PooledFrame*)av_buffer_get_opaque(base->frame->buf[0]);
+        AVFrame *ref = av_frame_clone(base->frame);
+        if (ref != NULL)
+            outbuf = gst_buffer_new_wrapped_full(GST_MEMORY_FLAG_READONLY, pooled->info.data, pooled->info.size,
+                                                 0, pooled->info.size, ref, videodecoder_free_frame);
+        if (outbuf == NULL)
+        {
+            if (ref != NULL)
+                av_frame_free(&ref);
+            gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
+                                     GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
+                                     g_strdup("Decoded video buffer allocation failed"), NULL,
+                                     ("videodecoder.c"), ("videodecoder_push_frame"), 0);
+            return GST_FLOW_OK;
+        }
+    }
+    else
+#endif // DIRECT_RENDERING
+    {
+#if HEVC_SUPPORT
+        // Check to see if we need to convert frame to YUV420p
+        if (base->frame->format != AV_PIX_FMT_YUV420P)
+        {
+            if (!videodecoder_convert_frame(decoder))
+            {
+                gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
+                                         GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
+                                         g_strdup("Video frame conversion failed"), NULL,
+                                         ("videodecoder.c"), ("videodecoder_push_frame"), 0);
+                return GST_FLOW_ERROR;
+            }
+
+            reordered_opaque = decoder->dest_frame->reordered_opaque;
+            outbuf = videodecoder_copy_frame(decoder, decoder->dest_frame->data[0],
+                                             decoder->dest_frame->data[1], decoder->dest_frame->data[2]);
+        }
+        else
+#endif // HEVC_SUPPORT
+        {
+            outbuf = videodecoder_copy_frame(decoder, base->frame->data[0],
+                                             base->frame->data[1], base->frame->data[2]);
+        }
+
+        if (outbuf == NULL)
+            return GST_FLOW_OK;
+    }
+
+    GST_BUFFER_OFFSET(outbuf) = base->context->frame_number;
+    if (reordered_opaque != AV_NOPTS_VALUE)
+    {
+        GST_BUFFER_TIMESTAMP(outbuf) = reordered_opaque;
+        GST_BUFFER_DURATION(outbuf) = duration; // Duration for video usually same
+    }
+    GST_BUFFER_OFFSET_END(outbuf) = GST_BUFFER_OFFSET_NONE;
+
+    if (decoder->discont || discont)
+    {
+#ifdef DEBUG_OUTPUT
+        g_print("Video discont: frame size=%dx%d\n", base->context->width, base->context->height);
+#endif
+        GST_BUFFER_FLAG_SET(outbuf, GST_BUFFER_FLAG_DISCONT);
+        decoder->discont = FALSE;
+    }
+
+#ifdef VERBOSE_DEBUG
+    g_print("videodecoder: pushing buffer ts=%.4f sec", (double)GST_BUFFER_TIMESTAMP(outbuf)/GST_SECOND);
+#endif
+    result = gst_pad_push(base->srcpad, outbuf);
+#ifdef VERBOSE_DEBUG
+    g_print(" done, res=%s\n", gst_flow_get_name(result));
+#endif
+
+    return result;
+}
+
+#if USE_SEND_RECEIVE
+static GstFlowReturn videodecoder_receive_frames(VideoDecoder *decoder, GstClockTime duration, gboolean discont)
+{
+    BaseDecoder   *base = BASEDECODER(decoder);
+    GstFlowReturn  result = GST_FLOW_OK;
+
+    while (result == GST_FLOW_OK && avcodec_receive_frame(base->context, base->frame) == 0)
+    {
+        decoder->frame_finished = 1;
+        result = videodecoder_push_frame(decoder, duration, discont);
+        discont = FALSE;
+    }
+
+    return result;
+}
+#endif // USE_SEND_RECEIVE
+
+// Decodes one packet, or drains the decoder if packet has no data, and
+// pushes every frame that becomes available. With frame threading a packet
+// may yield no frame at all while the threads fill up.
+static GstFlowReturn videodecoder_decode_packet(VideoDecoder *decoder, AVPacket *packet, GstClockTime duration, gboolean discont)
+{
+    BaseDecoder   *base = BASEDECODER(decoder);
+    GstFlowReturn  result = GST_FLOW_OK;
+    int            num_dec = NO_DATA_USED;
+
+#if USE_SEND_RECEIVE
+    AVPacket *pkt = (packet != NULL && packet->data != NULL) ? packet : NULL;
+
+    num_dec = avcodec_send_packet(base->context, pkt);
+    if (num_dec == AVERROR(EAGAIN))
+    {
+        // Output is full, make room and try again
+        result = videodecoder_receive_frames(decoder, duration, discont);
+        discont = FALSE;
+        if (result != GST_FLOW_OK)
+            return result;
+        num_dec = avcodec_send_packet(base->context, pkt);
+    }
+
+    if (num_dec < 0 && num_dec != AVERROR_EOF)
+    {
+#ifdef DEBUG_OUTPUT
+        g_print ("videodecoder_chain error: %s\n", avelement_error_to_string(AVELEMENT(decoder), num_dec));
+#endif
+        return result;
+    }
+
+    result = videodecoder_receive_frames(decoder, duration, discont);
+#else
+    do
+    {
+        num_dec = avcodec_decode_video2(base->context, base->frame, &decoder->frame_finished, packet);
+        if (num_dec < 0)
+        {
+#ifdef DEBUG_OUTPUT
+            g_print ("videodecoder_chain error: %s\n", avelement_error_to_string(AVELEMENT(decoder), num_dec));
+#endif
+            break;
+        }
+
+        if (decoder->frame_finished > 0)
+            result = videodecoder_push_frame(decoder, duration, discont);
+    } while (packet->data == NULL && decoder->frame_finished > 0 && result == GST_FLOW_OK);
+#endif // USE_SEND_RECEIVE
+
+    return result;
+}
+
+static void videodecoder_drain(VideoDecoder *decoder)
+{
+#if USE_SEND_RECEIVE
+    videodecoder_decode_packet(decoder, NULL, decoder->last_duration, FALSE);
+#else
+    AVPacket packet;
+    av_init_packet(&packet);
+    packet.data = NULL;
+    packet.size = 0;
+    videodecoder_decode_packet(decoder, &packet, decoder->last_duration, FALSE);
+#endif // USE_SEND_RECEIVE
+
+    // Leave draining mode so that decoding can resume after a seek
+    basedecoder_flush(BASEDECODER(decoder));
+}
+
 /***********************************************************************************
  * chain
  ***********************************************************************************/
@@ -674,17 +1234,8 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
     VideoDecoder  *decoder = VIDEODECODER(parent);
     BaseDecoder   *base = BASEDECODER(decoder);
     GstFlowReturn  result = GST_FLOW_OK;
-    int            num_dec = NO_DATA_USED;
     GstMapInfo     info;
-    GstMapInfo     info2;
     gboolean       unmap_buf = FALSE;
-    gboolean       set_frame_values = TRUE;
-    int64_t        reordered_opaque = AV_NOPTS_VALUE;
-    unsigned int   out_buf_size = 0;
-    gboolean       copy_error = FALSE;
-    uint8_t*       data0 = NULL;
-    uint8_t*       data1 = NULL;
-    uint8_t*       data2 = NULL;
 
     if (base->is_flushing)  // Reject buffers in flushing state.
     {
@@ -706,6 +1257,10 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
 
     unmap_buf = TRUE;
 
+    // Frames still held by the decoder at EOS get the last known duration
+    if (GST_BUFFER_DURATION_IS_VALID(buf))
+        decoder->last_duration = GST_BUFFER_DURATION(buf);
+
     if (!base->is_hls)
     {
         if (av_new_packet(&decoder->packet, info.size) == 0)
@@ -715,19 +1270,9 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
                 base->context->reordered_opaque = GST_BUFFER_TIMESTAMP(buf);
             else
                 base->context->reordered_opaque = AV_NOPTS_VALUE;
-#if USE_SEND_RECEIVE
-            num_dec = avcodec_send_packet(base->context, &decoder->packet);
-            if (num_dec == 0)
-            {
-                num_dec = avcodec_receive_frame(base->context, base->frame);
-                if (num_dec == 0)
-                    decoder->frame_finished = 1;
-                else
-                    decoder->frame_finished = 0;
-            }
-#else
-            num_dec = avcodec_decode_video2(base->context, base->frame, &decoder->frame_finished, &decoder->packet);
-#endif
+
+            result = videodecoder_decode_packet(decoder, &decoder->packet,
+                                                GST_BUFFER_DURATION(buf), GST_BUFFER_IS_DISCONT(buf));
 
 #if PACKET_UNREF
             av_packet_unref(&decoder->packet);
@@ -751,171 +1296,8 @@ static GstFlowReturn videodecoder_chain(GstPad *pad, GstObject *parent, GstBuffe
         else
             base->context->reordered_opaque = AV_NOPTS_VALUE;
 
-#if USE_SEND_RECEIVE
-        num_dec = avcodec_send_packet(base->context, &decoder->packet);
-        if (num_dec == 0)
-        {
-            num_dec = avcodec_receive_frame(base->context, base->frame);
-            if (num_dec == 0)
-                decoder->frame_finished = 1;
-            else
-                decoder->frame_finished = 0;
-        }
-#else
-        num_dec = avcodec_decode_video2(base->context, base->frame, &decoder->frame_finished, &decoder->packet);
-#endif
-    }
-
-    if (num_dec < 0)
-    {
-        //        basedecoder_flush(base);
-#ifdef DEBUG_OUTPUT
-        g_print ("videodecoder_chain error: %s\n", avelement_error_to_string(AVELEMENT(decoder), num_dec));
-#endif
-        goto _exit;
-    }
-
-    if (decoder->frame_finished > 0)
-    {
-        if (!videodecoder_configure_sourcepad(decoder))
-            result = GST_FLOW_ERROR;
-        else
-        {
-#if HEVC_SUPPORT
-            // Check to see if we need to convert frame to YUV420p
-            if (base->frame->format != AV_PIX_FMT_YUV420P)
-            {
-                if (!videodecoder_convert_frame(decoder))
-                {
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
-                                             GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
-                                             g_strdup("Video frame conversion failed"), NULL,
-                                             ("videodecoder.c"), ("videodecoder_chain"), 0);
-
-                    result = GST_FLOW_ERROR;
-                    goto _exit;
-                }
-
-                reordered_opaque = decoder->dest_frame->reordered_opaque;
-                data0 = decoder->dest_frame->data[0];
-                data1 = decoder->dest_frame->data[1];
-                data2 = decoder->dest_frame->data[2];
-                set_frame_values = FALSE;
-            }
-#endif // HEVC_SUPPORTf
-
-            if (set_frame_values)
-            {
-                reordered_opaque = base->frame->reordered_opaque;
-                data0 = base->frame->data[0];
-                data1 = base->frame->data[1];
-                data2 = base->frame->data[2];
-            }
-
-            GstBuffer *outbuf = gst_buffer_new_allocate(NULL, decoder->frame_size, NULL);
-            if (outbuf == NULL)
-            {
-                if (result != GST_FLOW_FLUSHING)
-                {
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR,
-                                             GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
-                                             g_strdup("Decoded video buffer allocation failed"), NULL,
-                                             ("videodecoder.c"), ("videodecoder_chain"), 0);
-                }
-            }
-            else
-            {
-                GST_BUFFER_OFFSET(outbuf) = base->context->frame_number;
-                if (reordered_opaque != AV_NOPTS_VALUE)
-                {
-                    GST_BUFFER_TIMESTAMP(outbuf) = reordered_opaque;
-                    GST_BUFFER_DURATION(outbuf) = GST_BUFFER_DURATION(buf); // Duration for video usually same
-                }
-
-                if (!gst_buffer_map(outbuf, &info2, GST_MAP_WRITE))
-                {
-                    // INLINE - gst_buffer_unref()
-                    gst_buffer_unref(outbuf);
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
-                                     g_strdup("Decoded video buffer allocation failed"), NULL, ("videodecoder.c"), ("videodecoder_chain"), 0);
-                    goto _exit;
-                }
-
-                // Copy image by parts from different arrays.
-                if (decoder->frame_size > (unsigned int)info2.maxsize) // maxsize should be same or more due to alignment
-                {
-                    gst_buffer_unmap(outbuf, &info2);
-                    // INLINE - gst_buffer_unref()
-                    gst_buffer_unref(outbuf);
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
-                                     g_strdup("Wrong buffer size"), NULL, ("videodecoder.c"), ("videodecoder_chain"), 0);
-                    goto _exit;
-                }
-
-                out_buf_size = decoder->frame_size;
-                if (out_buf_size >= decoder->u_offset)
-                {
-                    memcpy(info2.data, data0, decoder->u_offset);
-                    out_buf_size -= decoder->u_offset;
-                    if (out_buf_size >= decoder->uv_blocksize &&
-                        decoder->uv_blocksize <= decoder->frame_size &&
-                        decoder->u_offset <= (decoder->frame_size - decoder->uv_blocksize))
-                    {
-                        memcpy(info2.data + decoder->u_offset, data1, decoder->uv_blocksize);
-                        out_buf_size -= decoder->uv_blocksize;
-                        if (out_buf_size >= decoder->uv_blocksize &&
-                            decoder->uv_blocksize <= decoder->frame_size &&
-                            decoder->v_offset <= (decoder->frame_size - decoder->uv_blocksize))
-                        {
-                            memcpy(info2.data + decoder->v_offset, data2, decoder->uv_blocksize);
-                        }
-                        else
-                        {
-                            copy_error = TRUE;
-                        }
-                    }
-                    else
-                    {
-                        copy_error = TRUE;
-                    }
-                }
-                else
-                {
-                    copy_error = TRUE;
-                }
-
-                gst_buffer_unmap(outbuf, &info2);
-
-                if (copy_error)
-                {
-                    // INLINE - gst_buffer_unref()
-                    gst_buffer_unref(outbuf);
-                    gst_element_message_full(GST_ELEMENT(decoder), GST_MESSAGE_ERROR, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_NO_SPACE_LEFT,
-                                     g_strdup("Copy data failed"), NULL, ("videodecoder.c"), ("videodecoder_chain"), 0);
-                    goto _exit;
-                }
-
-                GST_BUFFER_OFFSET_END(outbuf) = GST_BUFFER_OFFSET_NONE;
-
-                if (decoder->discont || GST_BUFFER_IS_DISCONT(buf))
-                {
-#ifdef DEBUG_OUTPUT
-                    g_print("Video discont: frame size=%dx%d\n", base->context->width, base->context->height);
-#endif
-                    GST_BUFFER_FLAG_SET(outbuf, GST_BUFFER_FLAG_DISCONT);
-                    decoder->discont = FALSE;
-                }
-
-
-#ifdef VERBOSE_DEBUG
-                g_print("videodecoder: pushing buffer ts=%.4f sec", (double)GST_BUFFER_TIMESTAMP(outbuf)/GST_SECOND);
-#endif
-                result = gst_pad_push(base->srcpad, outbuf);
-#ifdef VERBOSE_DEBUG
-                g_print(" done, res=%s\n", gst_flow_get_name(result));
-#endif
-            }
-        }
+        result = videodecoder_decode_packet(decoder, &decoder->packet,
+                                            GST_BUFFER_DURATION(buf), GST_BUFFER_IS_DISCONT(buf));
     }
 
 _exit:
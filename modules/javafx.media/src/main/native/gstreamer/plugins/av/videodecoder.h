@@ -46,6 +46,9 @@ G_BEGIN_DECLS
 
 #define AV_VIDEO_DECODER_PLUGIN_NAME "avvideodecoder"
 
+#define VIDEODECODER_THREAD_FRAME 1
+#define VIDEODECODER_THREAD_SLICE 2
+
 #if HEVC_SUPPORT
 // libswscale APIs
 typedef struct SwsContext *(*sws_getContext_ptr)(int srcW, int srcH,
@@ -73,14 +76,33 @@ struct _VideoDecoder {
     gboolean     discont;
 
     unsigned int frame_size;     // in bytes
+    unsigned int y_offset;
     unsigned int u_offset;
     unsigned int v_offset;
     unsigned int uv_blocksize;
+    int          stride[3];
 
     AVPacket     packet;
 
     gint         codec_id;
 
+    gint         max_threads;    // libavcodec threads, 0 for one per core
+    gint         thread_type;    // VIDEODECODER_THREAD_* flags
+
+    // Output frames. When direct_rendering is set, libavcodec decodes
+    // YUV420P frames straight into buffers from this pool.
+    GstBufferPool *pool;
+    GMutex       pool_lock;
+    unsigned int pool_size;
+    gint         pool_width;
+    gint         pool_height;
+    int          pool_linesize[3];
+    unsigned int pool_offset[3];
+    gboolean     direct_rendering;
+    gboolean     direct_caps;    // source caps describe the pool layout
+
+    GstClockTime last_duration;
+
 #if HEVC_SUPPORT
     struct SwsContext *sws_context;
     AVFrame           *dest_frame;
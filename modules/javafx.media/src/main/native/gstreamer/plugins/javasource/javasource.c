@@ -54,6 +54,7 @@ enum
     SIGNAL_COPY_BLOCK,
     SIGNAL_CLOSE_CONNECTION,
     SIGNAL_PROPERTY,
+    SIGNAL_START_PREFETCH,
     LAST_SIGNAL
 };
 
@@ -66,7 +67,9 @@ enum
     PROP_STOP_ON_PAUSE,
     PROP_LOCATION,
     PROP_MIMETYPE,
-    PROP_HLS_MODE
+    PROP_HLS_MODE,
+    PROP_BLOCK_SIZE,
+    PROP_PREFETCH_DEPTH
 };
 
 /***********************************************************************************
@@ -79,6 +82,35 @@ enum
     MODE_HLS_LIVE = 0x04
 };
 
+/***********************************************************************************
+* Prefetch ring
+***********************************************************************************/
+#define SLOT_FREE 0
+
+typedef struct _JavaSourceRing JavaSourceRing;
+
+typedef struct
+{
+    JavaSourceRing *ring;
+    gint            index;
+} JavaSourceSlot;
+
+/* Blocks read ahead by Java, see CStreamCallbacks::StartPrefetch(). Pushed buffers
+ * wrap the blocks and keep a reference to the ring, which therefore outlives the
+ * element and the connection.
+ */
+struct _JavaSourceRing
+{
+    gint            ref_count;
+    gint            outstanding; // blocks owned by downstream buffers
+    gint           *states;
+    guint8         *blocks;
+    JavaSourceSlot *slots;
+    gint            block_size;
+    gint            depth;
+    gint            next_slot;   // streaming thread only
+};
+
 /***********************************************************************************
 * Element structures are hidden from outside
 ***********************************************************************************/
@@ -106,6 +138,10 @@ struct _JavaSource
     gchar*        location; // property controlled
     gchar*        mimetype; // property controlled
     gdouble       rate;
+
+    gint            block_size; // property controlled
+    gint            prefetch_depth; // property controlled
+    JavaSourceRing *ring; // NULL unless Java reads ahead
 };
 
 struct _JavaSourceClass
@@ -162,6 +198,7 @@ static void java_source_set_property (GObject *object, guint prop_id,
 static void java_source_get_property (GObject *object, guint prop_id,
                                       GValue *value, GParamSpec *spec);
 static void                 java_source_finalize (GObject *object);
+static void                 java_source_ring_unref(JavaSourceRing *ring);
 static GstStateChangeReturn java_source_change_state (GstElement *element,
     GstStateChange transition);
 
@@ -217,6 +254,14 @@ static void java_source_class_init (JavaSourceClass *klass)
         g_param_spec_string ("location", "Source Location", "Location of the source to read", NULL,
         G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | GST_PARAM_MUTABLE_READY));
 
+    g_object_class_install_property (gobject_klass, PROP_BLOCK_SIZE,
+        g_param_spec_int ("block-size", "Block size", "Size of the blocks read ahead", 4096, 16*1024*1024, 65536,
+        G_PARAM_WRITABLE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
+
+    g_object_class_install_property (gobject_klass, PROP_PREFETCH_DEPTH,
+        g_param_spec_int ("prefetch-depth", "Prefetch depth", "Number of blocks read ahead, 0 disables read-ahead", 0, 256, 0,
+        G_PARAM_WRITABLE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
+
     g_object_class_install_property (gobject_klass, PROP_MIMETYPE,
         g_param_spec_string ("mimetype", "Source Mimetype", "Mimetype of the source", NULL,
         G_PARAM_WRITABLE | G_PARAM_STATIC_STRINGS | GST_PARAM_MUTABLE_READY));
@@ -284,6 +329,17 @@ static void java_source_class_init (JavaSourceClass *klass)
         G_TYPE_INT, /* return_type */
         2,    /* n_params */
         G_TYPE_INT, G_TYPE_INT);
+
+    klass->signals[SIGNAL_START_PREFETCH] = g_signal_new ("start-prefetch",
+        G_TYPE_FROM_CLASS (klass),
+        G_SIGNAL_RUN_LAST | G_SIGNAL_NO_HOOKS,
+        0,
+        NULL, /* accumulator */
+        NULL, /* accu_data */
+        source_marshal_BOOLEAN__POINTER_POINTER_INT_INT,
+        G_TYPE_BOOLEAN, /* return_type */
+        4,    /* n_params */
+        G_TYPE_POINTER, G_TYPE_POINTER, G_TYPE_INT, G_TYPE_INT);
 }
 
 static void java_source_init(JavaSource *element)
@@ -306,6 +362,8 @@ static void java_source_init(JavaSource *element)
     element->rate = 1.0; // Default to 1.0
 
     element->mimetype = NULL;
+
+    element->ring = NULL;
 }
 
 /***********************************************************************************
@@ -341,6 +399,12 @@ static void java_source_set_property (GObject *object, guint prop_id,
     case PROP_MIMETYPE:
         element->mimetype = g_strdup(g_value_get_string (value));
         break;
+    case PROP_BLOCK_SIZE:
+        element->block_size = g_value_get_int (value);
+        break;
+    case PROP_PREFETCH_DEPTH:
+        element->prefetch_depth = g_value_get_int (value);
+        break;
     default:
         break;
     }
@@ -366,9 +430,103 @@ static void java_source_finalize (GObject *object)
     g_free(element->location);
     if (element->mimetype)
         g_free(element->mimetype);
+    if (element->ring)
+        java_source_ring_unref(element->ring);
     G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+/***********************************************************************************
+* Prefetch ring
+***********************************************************************************/
+static JavaSourceRing* java_source_ring_new(gint block_size, gint depth)
+{
+    JavaSourceRing *ring = g_new(JavaSourceRing, 1);
+    gint i;
+
+    ring->ref_count = 1;
+    ring->outstanding = 0;
+    ring->states = g_new0(gint, depth);
+    ring->blocks = (guint8*)g_malloc((gsize)block_size * depth);
+    ring->slots = g_new(JavaSourceSlot, depth);
+    ring->block_size = block_size;
+    ring->depth = depth;
+    ring->next_slot = 0;
+
+    for (i = 0; i < depth; i++)
+    {
+        ring->slots[i].ring = ring;
+        ring->slots[i].index = i;
+    }
+    return ring;
+}
+
+static void java_source_ring_unref(JavaSourceRing *ring)
+{
+    if (g_atomic_int_dec_and_test(&ring->ref_count))
+    {
+        g_free(ring->states);
+        g_free(ring->blocks);
+        g_free(ring->slots);
+        g_free(ring);
+    }
+}
+
+static void java_source_ring_release_slot(JavaSourceSlot *slot)
+{
+    JavaSourceRing *ring = slot->ring;
+
+    g_atomic_int_set(&ring->states[slot->index], SLOT_FREE);
+    g_atomic_int_add(&ring->outstanding, -1);
+    java_source_ring_unref(ring);
+}
+
+/* Returns a buffer with the next size bytes read ahead by Java. The block is
+ * wrapped unless downstream already holds all the others, then it is copied and
+ * given back at once so Java can always read on.
+ */
+static GstBuffer* java_source_ring_take(JavaSourceRing *ring, gint size)
+{
+    JavaSourceSlot *slot = &ring->slots[ring->next_slot];
+    guint8 *data = ring->blocks + (gsize)slot->index * ring->block_size;
+    GstBuffer *buffer;
+
+    ring->next_slot = (ring->next_slot + 1) % ring->depth;
+
+    if (g_atomic_int_get(&ring->outstanding) < ring->depth - 1)
+    {
+        g_atomic_int_inc(&ring->outstanding);
+        g_atomic_int_inc(&ring->ref_count);
+        buffer = gst_buffer_new_wrapped_full(GST_MEMORY_FLAG_READONLY, data, ring->block_size, 0, size,
+                                             slot, (GDestroyNotify)java_source_ring_release_slot);
+    }
+    else
+    {
+        buffer = gst_buffer_new_allocate(NULL, size, NULL);
+        if (buffer)
+            gst_buffer_fill(buffer, 0, data, size);
+        g_atomic_int_set(&ring->states[slot->index], SLOT_FREE);
+    }
+    return buffer;
+}
+
+static void java_source_start_prefetch(JavaSource *element)
+{
+    gboolean started = FALSE;
+
+    if (element->ring != NULL || element->prefetch_depth <= 0 || element->is_random_access ||
+        (element->mode & MODE_DEFAULT) != MODE_DEFAULT)
+        return;
+
+    element->ring = java_source_ring_new(element->block_size, element->prefetch_depth);
+    g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_START_PREFETCH], 0,
+                  element->ring->states, element->ring->blocks, element->ring->block_size, element->ring->depth, &started);
+    if (!started)
+    {
+        java_source_ring_unref(element->ring);
+        element->ring = NULL;
+    }
+}
+
 /***********************************************************************************
 * activate_push handler. Called when the pipeline switches to or from push mode,
 * depending on the 'active' flag.
@@ -630,20 +788,27 @@ next_event:
                 g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_READ_NEXT_BLOCK], 0, &size);
                 if (size > 0)
                 {
-                    GstBuffer *buffer = gst_buffer_new_allocate(NULL, size, NULL);
+                    GstBuffer *buffer = NULL;
+                    if (element->ring)
+                        buffer = java_source_ring_take(element->ring, size);
+                    else
+                        buffer = gst_buffer_new_allocate(NULL, size, NULL);
                     if (buffer)
                     {
                         GST_BUFFER_OFFSET(buffer) = element->position;
 
-                        if (!gst_buffer_map(buffer, &info, GST_MAP_WRITE))
+                        if (!element->ring)
                         {
-                            result = GST_FLOW_ERROR;
-                            break;
-                        }
+                            if (!gst_buffer_map(buffer, &info, GST_MAP_WRITE))
+                            {
+                                result = GST_FLOW_ERROR;
+                                break;
+                            }
 
-                        g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_COPY_BLOCK], 0, info.data, size);
+                            g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_COPY_BLOCK], 0, info.data, size);
 
-                        gst_buffer_unmap(buffer, &info);
+                            gst_buffer_unmap(buffer, &info);
+                        }
 
                         if (element->discont)
                         {
@@ -890,6 +1055,7 @@ static GstStateChangeReturn java_source_change_state (GstElement *e,
                 element->update = FALSE;
             else
                 element->update = TRUE;
+            java_source_start_prefetch(element);
             GST_PAD_STREAM_UNLOCK(element->srcpad);
 
             g_mutex_lock(&element->lock);
@@ -929,6 +1095,12 @@ static GstStateChangeReturn java_source_change_state (GstElement *e,
             element->srcresult = GST_FLOW_FLUSHING;
         element->size = -1;
         g_signal_emit(element, JAVA_SOURCE_GET_CLASS(element)->signals[SIGNAL_CLOSE_CONNECTION], 0);
+        // Java does not read ahead anymore, buffers still downstream keep the ring alive.
+        if (element->ring)
+        {
+            java_source_ring_unref(element->ring);
+            element->ring = NULL;
+        }
         g_mutex_unlock(&element->lock);
         break;
 
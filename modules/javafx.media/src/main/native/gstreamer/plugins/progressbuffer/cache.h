@@ -35,10 +35,16 @@ void      cache_static_init(void); // Must be called only once from the Progress
 Cache*    create_cache();
 void      destroy_cache(Cache* instance);
 
-// Writes a buffer.
+/* The cache is sparse: every written byte range is remembered, so data written
+ * before a seek stays readable after it. Read buffers are views over the
+ * mapped cache file and hold no copy of the data.
+ */
+
+// Writes a buffer at the current write position and advances it.
 void           cache_write_buffer(Cache* cache, GstBuffer* buffer);
 
-/* Reads a buffer of the fixed size from the current read position.
+/* Reads a buffer of at most the fixed size from the current read position,
+ * never past the end of the present data.
  * Returns the read position after the operation has been made.
  * buffer parameter contains the target buffer with offset and size values set
  * This method is used in push mode.
@@ -46,8 +52,8 @@ void           cache_write_buffer(Cache* cache, GstBuffer* buffer);
 gint64         cache_read_buffer(Cache* cache, GstBuffer** buffer);
 
 /* Reads a buffer of the specified size and start position.
- * Returns GST_FLOW_OK if the seek operation and subsequent read operation
- * were successfull. GST_FLOW_ERROR otherwise.
+ * Returns GST_FLOW_OK if the whole range is present and was read.
+ * GST_FLOW_ERROR otherwise.
  */
 GstFlowReturn  cache_read_buffer_from_position(Cache* cache, gint64 start_position, guint size, GstBuffer** buffer);
 
@@ -57,7 +63,18 @@ gboolean       cache_set_write_position(Cache* cache, gint64 position);
 // Sets a new read position
 gboolean       cache_set_read_position(Cache* cache, gint64 position);
 
+// Returns the current read position
+gint64         cache_get_read_position(Cache* cache);
+
 // Returns true if the cache has enough data for fluent reading, but we can't expect more than total.
 gboolean       cache_has_enough_data(Cache* cache);
 
+/* Returns the end of the contiguous present data starting at position,
+ * or position itself if the byte at position has not been written.
+ */
+gint64         cache_get_range_end(Cache* cache, gint64 position);
+
+// Forgets all written data and resets both positions to 0.
+gboolean       cache_clear(Cache* cache);
+
 #endif // __CACHE_H__
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "cacheindex.h"
+
+typedef struct
+{
+    gint64 start;
+    gint64 stop;
+} CacheRange;
+
+struct _CacheIndex
+{
+    GArray* ranges; // CacheRange sorted by start, never overlapping or touching
+};
+
+CacheIndex* cache_index_new(void)
+{
+    CacheIndex* index = g_new(CacheIndex, 1);
+    index->ranges = g_array_new(FALSE, FALSE, sizeof(CacheRange));
+    return index;
+}
+
+void cache_index_free(CacheIndex* index)
+{
+    g_array_free(index->ranges, TRUE);
+    g_free(index);
+}
+
+void cache_index_clear(CacheIndex* index)
+{
+    g_array_set_size(index->ranges, 0);
+}
+
+// Returns the index of the first range whose stop is not below position.
+static guint cache_index_lookup(CacheIndex* index, gint64 position)
+{
+    guint low = 0, high = index->ranges->len;
+
+    while (low < high)
+    {
+        guint middle = low + (high - low) / 2;
+        if (g_array_index(index->ranges, CacheRange, middle).stop < position)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+void cache_index_add(CacheIndex* index, gint64 start, gint64 stop)
+{
+    guint first, last;
+    CacheRange range;
+
+    if (start >= stop)
+        return;
+
+    // All ranges from first up to, but not including, last touch [start, stop) and are merged into it.
+    first = cache_index_lookup(index, start);
+    for (last = first; last < index->ranges->len; last++)
+    {
+        CacheRange *r = &g_array_index(index->ranges, CacheRange, last);
+        if (r->start > stop)
+            break;
+    }
+
+    range.start = start;
+    range.stop = stop;
+    if (last > first)
+    {
+        range.start = MIN(start, g_array_index(index->ranges, CacheRange, first).start);
+        range.stop = MAX(stop, g_array_index(index->ranges, CacheRange, last - 1).stop);
+        g_array_remove_range(index->ranges, first, last - first);
+    }
+    g_array_insert_val(index->ranges, first, range);
+}
+
+gint64 cache_index_get_end(CacheIndex* index, gint64 position)
+{
+    guint i = cache_index_lookup(index, position);
+
+    if (i < index->ranges->len)
+    {
+        CacheRange *r = &g_array_index(index->ranges, CacheRange, i);
+        if (r->start <= position && position < r->stop)
+            return r->stop;
+    }
+    return position;
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef __CACHE_INDEX_H__
+#define __CACHE_INDEX_H__
+
+#include <glib.h>
+
+/* Sorted set of the byte ranges [start, stop) that are present in a cache.
+ * Adjacent and overlapping ranges are merged, so the number of entries equals
+ * the number of holes in the downloaded data plus one. Not thread safe, the
+ * owner serializes access.
+ */
+typedef struct _CacheIndex CacheIndex;
+
+CacheIndex* cache_index_new(void);
+void        cache_index_free(CacheIndex* index);
+
+// Forgets all ranges.
+void        cache_index_clear(CacheIndex* index);
+
+// Marks [start, stop) as present.
+void        cache_index_add(CacheIndex* index, gint64 start, gint64 stop);
+
+/* Returns the end of the contiguous present data which starts at position,
+ * or position itself if the byte at position is not present.
+ */
+gint64      cache_index_get_end(CacheIndex* index, gint64 position);
+
+#endif // __CACHE_INDEX_H__
@@ -24,54 +24,160 @@
  */
 
 #include <cache.h>
+#include <cacheindex.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <errno.h>
 
-#define DEFAULT_BUFFER_SIZE 4096
+#define DEFAULT_BUFFER_SIZE 32768
+#define CACHE_BLOCK_SIZE    (1 << 20) // Size of the file window mapped at once, multiple of any page size
 static const char *tempDir = NULL;
 
+/* A mapped window of the cache file. Buffers handed downstream keep a reference,
+ * so the window stays valid after the cache moves on or is destroyed.
+ */
+typedef struct
+{
+    gint    ref_count;
+    guint8* data;
+} CacheBlock;
+
 struct _Cache
 {
-    char*   filename;
-    int     readHandle;
-    int     writeHandle;
+    int         handle;
+    CacheIndex* index;
+
+    CacheBlock* block;       // Most recently used window, NULL if none
+    gint64      block_index;
 
     gint64  read_position;
     gint64  write_position;
 };
 
-void cache_static_init(void)
+static CacheBlock* cache_block_ref(CacheBlock* block)
 {
-    tempDir = g_get_tmp_dir();
+    g_atomic_int_inc(&block->ref_count);
+    return block;
 }
 
-Cache* create_cache()
+static void cache_block_unref(CacheBlock* block)
 {
-    Cache* result= (Cache*)g_try_malloc(sizeof(Cache));
-    if (result)
+    if (g_atomic_int_dec_and_test(&block->ref_count))
     {
-        result->filename = g_build_filename(tempDir, "jfxmpbXXXXXX", NULL);
-        if (result->filename == NULL)
-            goto _error_exit;
-        else
+        munmap(block->data, CACHE_BLOCK_SIZE);
+        g_free(block);
+    }
+}
+
+static void cache_release_block(Cache* cache)
+{
+    if (cache->block)
+    {
+        cache_block_unref(cache->block);
+        cache->block = NULL;
+    }
+}
+
+/* Returns the window of the given index, mapping it if needed. The window
+ * may extend past the end of the file, only present data is ever touched.
+ */
+static CacheBlock* cache_get_block(Cache* cache, gint64 block_index)
+{
+    if (cache->block == NULL || cache->block_index != block_index)
+    {
+        CacheBlock* block;
+        void* data = mmap(NULL, CACHE_BLOCK_SIZE, PROT_READ, MAP_SHARED, cache->handle,
+                          (off_t)(block_index * CACHE_BLOCK_SIZE));
+        if (data == MAP_FAILED)
+            return NULL;
+
+        block = g_try_new(CacheBlock, 1);
+        if (block == NULL)
         {
-        result->writeHandle = g_mkstemp_full(result->filename, O_RDWR, S_IRUSR|S_IWUSR);
-            result->readHandle = open(result->filename, O_RDONLY, 0);
+            munmap(data, CACHE_BLOCK_SIZE);
+            return NULL;
+        }
+        block->ref_count = 1;
+        block->data = (guint8*)data;
+
+        cache_release_block(cache);
+        cache->block = block;
+        cache->block_index = block_index;
+    }
+    return cache->block;
+}
 
-            if(result->writeHandle < 0 || result->readHandle < 0)
-                goto _error_exit;
+/* Wraps [start, start + size) into a buffer with one memory per window
+ * spanned. The range must be present.
+ */
+static GstBuffer* cache_create_buffer(Cache* cache, gint64 start, guint size)
+{
+    GstBuffer *buffer = gst_buffer_new();
+    gint64 position = start;
 
-        if (unlink(result->filename) < 0)
+    while (size > 0)
+    {
+        CacheBlock *block = cache_get_block(cache, position / CACHE_BLOCK_SIZE);
+        gsize offset = (gsize)(position % CACHE_BLOCK_SIZE);
+        gsize chunk = MIN(size, CACHE_BLOCK_SIZE - offset);
+
+        if (block == NULL)
         {
-            close (result->writeHandle);
-            close (result->readHandle);
-        goto _error_exit;
+            gst_buffer_unref(buffer);
+            return NULL;
         }
 
-            result->read_position = result->write_position = 0;
+        gst_buffer_append_memory(buffer, gst_memory_new_wrapped(GST_MEMORY_FLAG_READONLY, block->data,
+                                                                CACHE_BLOCK_SIZE, offset, chunk,
+                                                                cache_block_ref(block),
+                                                                (GDestroyNotify)cache_block_unref));
+        position += chunk;
+        size -= chunk;
+    }
+
+    GST_BUFFER_OFFSET(buffer) = start;
+    return buffer;
+}
+
+static gboolean cache_open_file(Cache* cache)
+{
+    char* filename = g_build_filename(tempDir, "jfxmpbXXXXXX", NULL);
+    gboolean result = FALSE;
+
+    if (filename != NULL)
+    {
+        cache->handle = g_mkstemp_full(filename, O_RDWR, S_IRUSR|S_IWUSR);
+        if (cache->handle >= 0)
+        {
+            result = unlink(filename) == 0;
+            if (!result)
+                close(cache->handle);
         }
+        g_free(filename);
+    }
+    return result;
+}
+
+void cache_static_init(void)
+{
+    tempDir = g_get_tmp_dir();
+}
+
+Cache* create_cache()
+{
+    Cache* result= (Cache*)g_try_malloc(sizeof(Cache));
+    if (result)
+    {
+        if (!cache_open_file(result))
+            goto _error_exit;
+
+        result->index = cache_index_new();
+        result->block = NULL;
+        result->block_index = 0;
+        result->read_position = result->write_position = 0;
     }
     return result;
 
@@ -82,9 +188,9 @@ _error_exit:
 
 void destroy_cache(Cache* instance)
 {
-    close(instance->writeHandle);
-    close(instance->readHandle);
-    g_free(instance->filename);
+    cache_release_block(instance);
+    close(instance->handle);
+    cache_index_free(instance->index);
 
     g_free(instance);
 }
@@ -94,39 +200,37 @@ void cache_write_buffer(Cache* cache, GstBuffer* buffer)
     GstMapInfo info;
     if (gst_buffer_map(buffer, &info, GST_MAP_READ))
     {
-        ssize_t written = write(cache->writeHandle, info.data, info.size);
-        if (written > 0)
-            cache->write_position += written;
+        gsize total = 0;
+        while (total < info.size)
+        {
+            ssize_t written = pwrite(cache->handle, info.data + total, info.size - total,
+                                     (off_t)(cache->write_position + total));
+            if (written > 0)
+                total += written;
+            else if (written < 0 && errno == EINTR)
+                continue;
+            else
+                break;
+        }
+        cache_index_add(cache->index, cache->write_position, cache->write_position + total);
+        cache->write_position += total;
         gst_buffer_unmap(buffer, &info);
     }
 }
 
 gint64 cache_read_buffer(Cache* cache, GstBuffer** buffer)
 {
-    guint8 *data = (guint8*)g_try_malloc(DEFAULT_BUFFER_SIZE);
+    gint64 available = cache_index_get_end(cache->index, cache->read_position) - cache->read_position;
     *buffer = NULL;
 
-    if (data)
+    if (available > 0)
     {
-        ssize_t size = 0;
-        if ((cache->write_position - cache->read_position) > 0 &&
-            (cache->write_position - cache->read_position) < DEFAULT_BUFFER_SIZE)
-            size = cache->write_position - cache->read_position;
-        else
-            size = DEFAULT_BUFFER_SIZE;
-
-        ssize_t read_bytes = read(cache->readHandle, data, size);
-        if (read_bytes > 0)
+        *buffer = cache_create_buffer(cache, cache->read_position, (guint)MIN(available, DEFAULT_BUFFER_SIZE));
+        if (*buffer != NULL)
         {
-            *buffer = gst_buffer_new_wrapped_full(0, data, DEFAULT_BUFFER_SIZE, 0, read_bytes, data, g_free);
-            if (*buffer != NULL)
-                GST_BUFFER_OFFSET(*buffer) = cache->read_position;
-
-            cache->read_position += read_bytes;
+            cache->read_position += gst_buffer_get_size(*buffer);
             return cache->read_position;
         }
-        else // read error, deleting buffer to avoid leaking.
-            g_free(data);
     }
 
     return 0;
@@ -137,60 +241,63 @@ GstFlowReturn cache_read_buffer_from_position(Cache* cache, gint64 start_positio
     GstFlowReturn result = GST_FLOW_ERROR;
     *buffer = NULL;
 
-    if (cache_set_read_position(cache, start_position))
-    {
-        guint8 *data = (guint8*)g_try_malloc(size);
-        if (data)
+    if (cache_index_get_end(cache->index, start_position) >= start_position + size)
     {
-        ssize_t read_bytes = read(cache->readHandle, data, size);
-            if (read_bytes == size)
-            {
-                *buffer = gst_buffer_new_wrapped_full(0, data, size, 0, read_bytes, data, g_free);
-                if (*buffer != NULL)
-                {
-                    GST_BUFFER_OFFSET(*buffer) = cache->read_position;
-                    result = GST_FLOW_OK;
-                }
-            }
-            else
-            g_free(data); // Wrong size, deleting buffer to avoid leaking.
-
-            cache->read_position += read_bytes;
-    }
+        *buffer = cache_create_buffer(cache, start_position, size);
+        if (*buffer != NULL)
+        {
+            cache->read_position = start_position + size;
+            result = GST_FLOW_OK;
+        }
     }
     return result;
 }
 
-static inline gboolean cache_set_handler_position(int handle, guint64 position)
+gboolean cache_set_write_position(Cache* cache, gint64 position)
 {
-    return lseek(handle, position, SEEK_SET) >= 0;
+    if (position < 0)
+        return FALSE;
+
+    cache->write_position = position;
+    return TRUE;
 }
 
-gboolean cache_set_write_position(Cache* cache, gint64 position)
+gboolean cache_set_read_position(Cache* cache, gint64 position)
 {
-    gboolean result = (position == cache->write_position);
-    if (!result)
-    {
-        result = cache_set_handler_position(cache->writeHandle, position);
-        if (result)
-            cache->write_position = position;
-    }
-    return result;
+    if (position < 0)
+        return FALSE;
+
+    cache->read_position = position;
+    return TRUE;
 }
 
-gboolean cache_set_read_position(Cache* cache, gint64 position)
+gint64 cache_get_read_position(Cache* cache)
 {
-    gboolean result = (position == cache->read_position);
-    if (!result)
-    {
-        result = cache_set_handler_position(cache->readHandle, position);
-        if (result)
-            cache->read_position = position;
-    }
-    return result;
+    return cache->read_position;
 }
 
 gboolean cache_has_enough_data(Cache* cache)
 {
-    return cache->read_position < cache->write_position;
+    return cache->read_position < cache_index_get_end(cache->index, cache->read_position);
+}
+
+gint64 cache_get_range_end(Cache* cache, gint64 position)
+{
+    return cache_index_get_end(cache->index, position);
+}
+
+gboolean cache_clear(Cache* cache)
+{
+    // Buffers still downstream may map the old file, so start over with a fresh one instead of truncating.
+    cache_release_block(cache);
+    close(cache->handle);
+    cache_index_clear(cache->index);
+    cache->read_position = cache->write_position = 0;
+
+    if (!cache_open_file(cache))
+    {
+        cache->handle = -1;
+        return FALSE;
+    }
+    return TRUE;
 }
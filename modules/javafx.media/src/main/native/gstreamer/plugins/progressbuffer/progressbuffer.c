@@ -75,7 +75,6 @@ struct _ProgressBuffer
     // Cache infrastructure
     Cache         *cache;
     GstEvent      *pending_src_event;
-    gint64         cache_read_offset;
 
     GstSegment    sink_segment;
     gdouble       last_update;
@@ -94,6 +93,7 @@ struct _ProgressBuffer
 
     gboolean      instant_seek;
     gboolean      is_source_seeking;
+    gboolean      seek_ahead; // The next segment continues the running one at a cache hole.
 
 #if ENABLE_PULL_MODE
     gint64       range_start;
@@ -256,11 +256,11 @@ static void progress_buffer_init(ProgressBuffer *element)
 
     element->srcpad = NULL;
     element->cache = NULL;
-    element->cache_read_offset = 0;
     g_mutex_init(&element->lock);
     g_cond_init(&element->add_cond);
     element->bandwidth_timer = g_timer_new();
     element->is_source_seeking = FALSE;
+    element->seek_ahead = FALSE;
 
 #if ENABLE_PULL_MODE
     element->monitor_thread = NULL;
@@ -573,6 +573,8 @@ static GstFlowReturn progress_buffer_enqueue_item(ProgressBuffer *element, GstMi
         if(element->sink_segment.stop < element->sink_segment.position) // This must never happen.
             return  GST_FLOW_ERROR;
 
+        // The cache is indexed by stream offset, so data around earlier seeks stays usable.
+        cache_set_write_position(element->cache, GST_BUFFER_OFFSET(GST_BUFFER(item)));
         cache_write_buffer(element->cache, GST_BUFFER(item));
 
         elapsed = g_timer_elapsed(element->bandwidth_timer, NULL);
@@ -651,14 +653,20 @@ static GstFlowReturn progress_buffer_enqueue_item(ProgressBuffer *element, GstMi
                     }
                 }
                 else
-                {
-                    cache_set_write_position(element->cache, 0);
-                    cache_set_read_position(element->cache, 0);
-                    element->cache_read_offset = segment.start;
-                }
+                    cache_set_write_position(element->cache, segment.start);
 
                 gst_segment_copy_into (&segment, &element->sink_segment);
-                progress_buffer_set_pending_event(element, event);
+                if (element->seek_ahead)
+                {
+                    // Downstream keeps reading where it was, it only waited for the hole to be filled.
+                    element->seek_ahead = FALSE;
+                    gst_event_unref(event); // INLINE - gst_event_unref()
+                }
+                else
+                {
+                    cache_set_read_position(element->cache, segment.start);
+                    progress_buffer_set_pending_event(element, event);
+                }
                 element->instant_seek = TRUE;
 
                 signal = send_position_message(element, TRUE);
@@ -725,12 +733,13 @@ static gboolean progress_buffer_perform_push_seek(ProgressBuffer *element, GstPa
     element->srcresult = GST_FLOW_OK;
 
 #ifdef ENABLE_SOURCE_SEEKING
-    element->instant_seek = (position >= element->sink_segment.start &&
+    element->instant_seek = cache_get_range_end(element->cache, position) > position ||
+                            (position >= element->sink_segment.start &&
                              (position - (gint64)element->sink_segment.position) <= element->bandwidth * element->wait_tolerance);
 
     if (element->instant_seek)
     {
-        cache_set_read_position(element->cache, position - element->cache_read_offset);
+        cache_set_read_position(element->cache, position);
         gst_segment_init(&segment, GST_FORMAT_BYTES);
         segment.rate = rate;
         segment.start = position;
@@ -742,9 +751,10 @@ static gboolean progress_buffer_perform_push_seek(ProgressBuffer *element, GstPa
     {
         // Clear any pending events, since we doing seek.
         reset_eos(element, TRUE);
+        element->seek_ahead = FALSE;
     }
 #else
-    cache_set_read_position(element->cache, position - element->cache_read_offset);
+    cache_set_read_position(element->cache, position);
     gst_segment_init(&segment, GST_FORMAT_BYTES);
     segment.rate = rate;
     segment.start = position;
@@ -764,7 +774,7 @@ static gboolean progress_buffer_perform_push_seek(ProgressBuffer *element, GstPa
         if (!gst_pad_push_event(element->sinkpad, e))
         {
             element->instant_seek = TRUE;
-            cache_set_read_position(element->cache, position - element->cache_read_offset);
+            cache_set_read_position(element->cache, position);
             gst_segment_init(&segment, GST_FORMAT_BYTES);
             segment.rate = rate;
             segment.start = position;
@@ -836,6 +846,50 @@ static void send_underrun_message(ProgressBuffer* element)
     gst_element_post_message(GST_ELEMENT(element), msg);
 }
 
+#ifdef ENABLE_SOURCE_SEEKING
+/**
+ * progress_buffer_needs_seek_ahead()
+ *
+ * Returns TRUE if the hole in the cache at the read position is not going to be filled by
+ * the running download soon, e.g. after an instant seek back into data fetched earlier.
+ * Must be called in the locked context.
+ */
+static gboolean progress_buffer_needs_seek_ahead(ProgressBuffer *element, gint64 position)
+{
+    return !element->seek_ahead && !element->is_source_seeking &&
+           position < element->sink_segment.stop &&
+           (element->eos_status.eos || position < element->sink_segment.start ||
+            (position - (gint64)element->sink_segment.position) > element->bandwidth * element->wait_tolerance);
+}
+
+/**
+ * progress_buffer_seek_ahead()
+ *
+ * Moves the source to the hole in the cache at the given position. The resulting segment
+ * only repositions the download, downstream keeps its segment. Must be called in the locked
+ * context, the lock is released while the source seeks.
+ */
+static gboolean progress_buffer_seek_ahead(ProgressBuffer *element, gint64 position)
+{
+    gboolean result;
+
+    element->seek_ahead = TRUE;
+    element->is_source_seeking = TRUE;
+    reset_eos(element, FALSE);
+    g_mutex_unlock(&element->lock);
+
+    result = gst_pad_push_event(element->sinkpad, gst_event_new_seek(element->sink_segment.rate, GST_FORMAT_BYTES, GST_SEEK_FLAG_NONE,
+                                                                     GST_SEEK_TYPE_SET, position, GST_SEEK_TYPE_NONE, 0));
+
+    g_mutex_lock(&element->lock);
+    element->is_source_seeking = FALSE;
+    if (!result)
+        element->seek_ahead = FALSE;
+
+    return result;
+}
+#endif
+
 /**
  * progress_buffer_loop()
  *
@@ -854,6 +908,12 @@ next_item:
            element->pending_src_event == NULL &&
            (!cache_has_enough_data(element->cache) || !element->instant_seek))
     {
+#ifdef ENABLE_SOURCE_SEEKING
+        if (element->instant_seek &&
+            progress_buffer_needs_seek_ahead(element, cache_get_read_position(element->cache)) &&
+            progress_buffer_seek_ahead(element, cache_get_read_position(element->cache)))
+            continue;
+#endif
         if (element->instant_seek)
             send_underrun_message(element);
         g_cond_wait(&element->add_cond, &element->lock);
@@ -892,8 +952,6 @@ next_item:
         {
             GstBuffer *buffer = NULL;
             guint64 read_position = cache_read_buffer(element->cache, &buffer);
-            read_position += element->cache_read_offset;
-            GST_BUFFER_OFFSET(buffer) = read_position - gst_buffer_get_size(buffer);
 
             if (read_position == element->sink_segment.stop)
                 progress_buffer_set_pending_event(element, gst_event_new_eos());
@@ -1058,21 +1116,23 @@ static GstFlowReturn progress_buffer_getrange(GstPad *pad, GstObject *parent, gu
     GstFlowReturn  result = GST_FLOW_OK;
     guint64        end_position = start_position + size;
     gboolean       needs_seeking = FALSE;
+    gint64         seek_position = start_position;
 
     g_mutex_lock(&element->lock); // Use one lock for push and pull modes
 
     if (element->sink_segment.stop < (gint64)end_position)
         result = GST_FLOW_EOS;
-    else if (element->sink_segment.start <= (gint64)start_position &&
-             element->sink_segment.position >= (gint64)end_position)
+    else if (cache_get_range_end(element->cache, start_position) >= (gint64)end_position)
         result = cache_read_buffer_from_position(element->cache, start_position, size, buffer);
     else
     {
+        // Only the part past the cached data has to be downloaded.
+        seek_position = cache_get_range_end(element->cache, start_position);
 #if ENABLE_SOURCE_SEEKING
-        needs_seeking = element->sink_segment.start > (gint64)start_position;
+        needs_seeking = element->sink_segment.start > seek_position;
         if (needs_seeking)
         {
-            element->range_start = start_position;
+            element->range_start = seek_position;
             reset_eos(element, TRUE);
         }
 #endif
@@ -1097,7 +1157,7 @@ static GstFlowReturn progress_buffer_getrange(GstPad *pad, GstObject *parent, gu
 
     if (needs_seeking)
         gst_pad_push_event(element->sinkpad, gst_event_new_seek(element->sink_segment.rate, GST_FORMAT_BYTES, GST_SEEK_FLAG_NONE,
-            GST_SEEK_TYPE_SET, start_position, GST_SEEK_TYPE_NONE, 0));
+            GST_SEEK_TYPE_SET, seek_position, GST_SEEK_TYPE_NONE, 0));
 
     return result;
 #else
@@ -24,21 +24,143 @@
  */
 
 #include <cache.h>
+#include <cacheindex.h>
 #include <windows.h>
 
-#define DEFAULT_BUFFER_SIZE 4096
+#define DEFAULT_BUFFER_SIZE 32768
+#define CACHE_BLOCK_SIZE    (1 << 20) // Size of the file window mapped at once, multiple of the allocation granularity
 static char tempDir[MAX_PATH];
 
+/* A mapped view of the cache file. Buffers handed downstream keep a reference,
+ * so the view stays valid after the cache moves on or is destroyed.
+ */
+typedef struct
+{
+    gint    ref_count;
+    guint8* data;
+} CacheBlock;
+
 struct _Cache
 {
-    char    filename[MAX_PATH];
-    HANDLE  readHandle;
-    HANDLE  writeHandle;
+    char        filename[MAX_PATH];
+    HANDLE      handle;
+    CacheIndex* index;
+
+    CacheBlock* block;       // Most recently used view, NULL if none
+    gint64      block_index;
 
     gint64  read_position;
     gint64  write_position;
 };
 
+static CacheBlock* cache_block_ref(CacheBlock* block)
+{
+    g_atomic_int_inc(&block->ref_count);
+    return block;
+}
+
+static void cache_block_unref(CacheBlock* block)
+{
+    if (g_atomic_int_dec_and_test(&block->ref_count))
+    {
+        UnmapViewOfFile(block->data);
+        g_free(block);
+    }
+}
+
+static void cache_release_block(Cache* cache)
+{
+    if (cache->block)
+    {
+        cache_block_unref(cache->block);
+        cache->block = NULL;
+    }
+}
+
+/* Returns the view of the given index, mapping it if needed. Creating the
+ * mapping grows the file to the end of the view, only present data is ever
+ * touched.
+ */
+static CacheBlock* cache_get_block(Cache* cache, gint64 block_index)
+{
+    if (cache->block == NULL || cache->block_index != block_index)
+    {
+        ULARGE_INTEGER offset, end;
+        CacheBlock* block;
+        HANDLE mapping;
+        void* data;
+
+        offset.QuadPart = block_index * CACHE_BLOCK_SIZE;
+        end.QuadPart = offset.QuadPart + CACHE_BLOCK_SIZE;
+        mapping = CreateFileMapping(cache->handle, NULL, PAGE_READWRITE, end.HighPart, end.LowPart, NULL);
+        if (mapping == NULL)
+            return NULL;
+
+        // The view keeps the mapping object alive.
+        data = MapViewOfFile(mapping, FILE_MAP_READ, offset.HighPart, offset.LowPart, CACHE_BLOCK_SIZE);
+        CloseHandle(mapping);
+        if (data == NULL)
+            return NULL;
+
+        block = g_try_new(CacheBlock, 1);
+        if (block == NULL)
+        {
+            UnmapViewOfFile(data);
+            return NULL;
+        }
+        block->ref_count = 1;
+        block->data = (guint8*)data;
+
+        cache_release_block(cache);
+        cache->block = block;
+        cache->block_index = block_index;
+    }
+    return cache->block;
+}
+
+/* Wraps [start, start + size) into a buffer with one memory per view
+ * spanned. The range must be present.
+ */
+static GstBuffer* cache_create_buffer(Cache* cache, gint64 start, guint size)
+{
+    GstBuffer *buffer = gst_buffer_new();
+    gint64 position = start;
+
+    while (size > 0)
+    {
+        CacheBlock *block = cache_get_block(cache, position / CACHE_BLOCK_SIZE);
+        gsize offset = (gsize)(position % CACHE_BLOCK_SIZE);
+        gsize chunk = MIN(size, CACHE_BLOCK_SIZE - offset);
+
+        if (block == NULL)
+        {
+            gst_buffer_unref(buffer);
+            return NULL;
+        }
+
+        gst_buffer_append_memory(buffer, gst_memory_new_wrapped(GST_MEMORY_FLAG_READONLY, block->data,
+                                                                CACHE_BLOCK_SIZE, offset, chunk,
+                                                                cache_block_ref(block),
+                                                                (GDestroyNotify)cache_block_unref));
+        position += chunk;
+        size -= chunk;
+    }
+
+    GST_BUFFER_OFFSET(buffer) = start;
+    return buffer;
+}
+
+static gboolean cache_open_file(Cache* cache)
+{
+    UINT uRetVal = GetTempFileName(tempDir, "jfx", 0, cache->filename);
+    if (uRetVal == 0)
+        return FALSE;
+
+    cache->handle = CreateFile(cache->filename, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ|FILE_SHARE_DELETE, NULL,
+                               CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY|FILE_FLAG_DELETE_ON_CLOSE, NULL);
+    return cache->handle != INVALID_HANDLE_VALUE;
+}
+
 void cache_static_init(void)
 {
     DWORD   dwRetVal = GetTempPath(MAX_PATH, tempDir);
@@ -54,20 +176,13 @@ Cache* create_cache()
     Cache* result= (Cache*)g_try_malloc(sizeof(Cache));
     if (result)
     {
-        UINT uRetVal = GetTempFileName(tempDir, "jfx", 0, result->filename);
-        if (uRetVal == 0)
+        if (!cache_open_file(result))
             goto _error_exit;
-        else
-        {
-            result->writeHandle = CreateFile(result->filename, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ|FILE_SHARE_DELETE, NULL,
-                                             CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY|FILE_FLAG_DELETE_ON_CLOSE, NULL);
-            result->readHandle = CreateFile(result->filename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE |FILE_SHARE_DELETE, NULL,
-                                            OPEN_EXISTING, FILE_ATTRIBUTE_TEMPORARY|FILE_FLAG_DELETE_ON_CLOSE, NULL);
-            if(result->writeHandle == INVALID_HANDLE_VALUE || result->readHandle == INVALID_HANDLE_VALUE)
-                goto _error_exit;
-
-            result->read_position = result->write_position = 0;
-        }
+
+        result->index = cache_index_new();
+        result->block = NULL;
+        result->block_index = 0;
+        result->read_position = result->write_position = 0;
     }
     return result;
 
@@ -78,47 +193,50 @@ _error_exit:
 
 void destroy_cache(Cache* instance)
 {
-    CloseHandle(instance->writeHandle);
-    CloseHandle(instance->readHandle);
+    cache_release_block(instance);
+    CloseHandle(instance->handle);
+    cache_index_free(instance->index);
 
     g_free(instance);
 }
 
 void cache_write_buffer(Cache* cache, GstBuffer* buffer)
 {
-    DWORD written = 0;
     GstMapInfo info;
     if (gst_buffer_map(buffer, &info, GST_MAP_READ))
     {
-        if (WriteFile(cache->writeHandle, info.data, info.size, &written, NULL))
+        OVERLAPPED overlapped;
+        ULARGE_INTEGER position;
+        DWORD written = 0;
+
+        ZeroMemory(&overlapped, sizeof(overlapped));
+        position.QuadPart = cache->write_position;
+        overlapped.Offset = position.LowPart;
+        overlapped.OffsetHigh = position.HighPart;
+
+        if (WriteFile(cache->handle, info.data, (DWORD)info.size, &written, &overlapped))
+        {
+            cache_index_add(cache->index, cache->write_position, cache->write_position + written);
             cache->write_position += written;
+        }
         gst_buffer_unmap(buffer, &info);
     }
 }
 
 gint64 cache_read_buffer(Cache* cache, GstBuffer** buffer)
 {
-    DWORD read = 0;
-    DWORD size = 0;
-    guint8 *data = (guint8*)g_try_malloc(DEFAULT_BUFFER_SIZE);
+    gint64 available = cache_index_get_end(cache->index, cache->read_position) - cache->read_position;
     *buffer = NULL;
 
-    if ((cache->write_position - cache->read_position) > 0 && (cache->write_position - cache->read_position) < DEFAULT_BUFFER_SIZE)
-        size = cache->write_position - cache->read_position;
-    else
-        size = DEFAULT_BUFFER_SIZE;
-
-    if (data && ReadFile(cache->readHandle, data, size, &read, NULL))
+    if (available > 0)
     {
-        *buffer = gst_buffer_new_wrapped_full(0, data, DEFAULT_BUFFER_SIZE, 0, read, data, g_free);
+        *buffer = cache_create_buffer(cache, cache->read_position, (guint)MIN(available, DEFAULT_BUFFER_SIZE));
         if (*buffer != NULL)
-            GST_BUFFER_OFFSET(*buffer) = cache->read_position;
-
-        cache->read_position += read;
-        return cache->read_position;
+        {
+            cache->read_position += gst_buffer_get_size(*buffer);
+            return cache->read_position;
+        }
     }
-    else if (data) // ReadError, deleting buffer to avoid leaking.
-        g_free(data);
 
     return 0;
 }
@@ -128,66 +246,58 @@ GstFlowReturn cache_read_buffer_from_position(Cache* cache, gint64 start_positio
     GstFlowReturn result = GST_FLOW_ERROR;
     *buffer = NULL;
 
-    if (cache_set_read_position(cache, start_position))
+    if (cache_index_get_end(cache->index, start_position) >= start_position + size)
     {
-        DWORD  read = 0;
-        guint8 *data = (guint8*)g_try_malloc(size);
-        if (data && ReadFile(cache->readHandle, data, size, &read, NULL))
+        *buffer = cache_create_buffer(cache, start_position, size);
+        if (*buffer != NULL)
         {
-            if (read == size)
-            {
-                *buffer = gst_buffer_new_wrapped_full(0, data, size, 0, read, data, g_free);
-                if (*buffer != NULL)
-                {
-                    GST_BUFFER_OFFSET(*buffer) = cache->read_position;
-                    result = GST_FLOW_OK;
-                }
-            }
-            else
-                g_free(data); // Wrong size, deleting buffer to avoid leaking.
-
-            cache->read_position += read;
+            cache->read_position = start_position + size;
+            result = GST_FLOW_OK;
         }
-        else if (data) // ReadError, deleting buffer to avoid leaking.
-            g_free(data);
     }
     return result;
 }
 
-static gboolean cache_set_handler_position(HANDLE handle, guint64 position)
+gboolean cache_set_write_position(Cache* cache, gint64 position)
 {
-    LARGE_INTEGER li;
-    li.QuadPart = position;
-    li.LowPart = SetFilePointer (handle, li.LowPart, &li.HighPart, FILE_BEGIN);
+    if (position < 0)
+        return FALSE;
 
-    return (li.LowPart != INVALID_SET_FILE_POINTER || GetLastError() == NO_ERROR);
+    cache->write_position = position;
+    return TRUE;
 }
 
-gboolean cache_set_write_position(Cache* cache, gint64 position)
+gboolean cache_set_read_position(Cache* cache, gint64 position)
 {
-    gboolean result = (position == cache->write_position);
-    if (!result)
-    {
-        result = cache_set_handler_position(cache->writeHandle, position);
-        if (result)
-            cache->write_position = position;
-    }
-    return result;
+    if (position < 0)
+        return FALSE;
+
+    cache->read_position = position;
+    return TRUE;
 }
 
-gboolean cache_set_read_position(Cache* cache, gint64 position)
+gint64 cache_get_read_position(Cache* cache)
 {
-    gboolean result = (position == cache->read_position);
-    if (!result)
-    {
-        result = cache_set_handler_position(cache->readHandle, position);
-        if (result)
-            cache->read_position = position;
-    }
-    return result;
+    return cache->read_position;
 }
 
 gboolean cache_has_enough_data(Cache* cache)
 {
-    return cache->read_position < cache->write_position;
+    return cache->read_position < cache_index_get_end(cache->index, cache->read_position);
+}
+
+gint64 cache_get_range_end(Cache* cache, gint64 position)
+{
+    return cache_index_get_end(cache->index, position);
+}
+
+gboolean cache_clear(Cache* cache)
+{
+    // Buffers still downstream may map the old file, so start over with a fresh one instead of truncating.
+    cache_release_block(cache);
+    CloseHandle(cache->handle);
+    cache_index_clear(cache->index);
+    cache->read_position = cache->write_position = 0;
+
+    return cache_open_file(cache);
 }
@@ -56,6 +56,15 @@ public:
     /* CopyBlock copies the data from whatever internal buffer to the destination.*/
     virtual void CopyBlock(void* destination, int size) = 0;
 
+    /* StartPrefetch makes the stream read ahead into a ring of depth blocks of
+    * blockSize bytes each, starting at blocks. states holds one int per block:
+    * the stream fills a block only while its state is 0 and sets it to 1 when
+    * filled, the caller resets it to 0 when done with the data. Blocks are filled
+    * and consumed in order, from then on ReadNextBlock returns the size of the
+    * next block and CopyBlock is not used.
+    * Returns false if the stream can't read ahead.*/
+    virtual bool StartPrefetch(void* states, void* blocks, int blockSize, int depth) = 0;
+
     /* Detects whether the source is seekable.*/
     virtual bool IsSeekable() = 0;
 
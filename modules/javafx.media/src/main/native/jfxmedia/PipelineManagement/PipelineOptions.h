@@ -43,12 +43,20 @@ public:
         kAudioPlaybackPipeline  = 0,
         kAVPlaybackPipeline     = 1
     };
+
+    enum
+    {
+        kDefaultStreamBlockSize     = 65536,
+        kDefaultStreamPrefetchDepth = 8
+    };
 public:
     CPipelineOptions(int pipelineType=kAVPlaybackPipeline, bool havePreferredFormat = false)
     :   m_PipelineType(pipelineType),
         m_bBufferingEnabled(false),
         m_StreamMimeType(-1),
-        m_bHLSModeEnabled(false)
+        m_bHLSModeEnabled(false),
+        m_StreamBlockSize(kDefaultStreamBlockSize),
+        m_StreamPrefetchDepth(kDefaultStreamPrefetchDepth)
     {}
 
     virtual ~CPipelineOptions() {}
@@ -64,11 +72,21 @@ public:
     inline void SetHLSModeEnabled(bool enabled) { m_bHLSModeEnabled = enabled; }
     inline bool GetHLSModeEnabled() { return m_bHLSModeEnabled; }
 
+    // Size of the blocks sequential Java streams are read ahead in.
+    inline void SetStreamBlockSize(int size) { m_StreamBlockSize = size; }
+    inline int GetStreamBlockSize() { return m_StreamBlockSize; }
+
+    // Number of blocks read ahead, 0 reads every block on demand.
+    inline void SetStreamPrefetchDepth(int depth) { m_StreamPrefetchDepth = depth; }
+    inline int GetStreamPrefetchDepth() { return m_StreamPrefetchDepth; }
+
 private:
     int         m_PipelineType;
     bool        m_bBufferingEnabled;
     int         m_StreamMimeType;
     bool        m_bHLSModeEnabled;
+    int         m_StreamBlockSize;
+    int         m_StreamPrefetchDepth;
 };
 
 #endif  //_PIPELINE_OPTIONS_H_
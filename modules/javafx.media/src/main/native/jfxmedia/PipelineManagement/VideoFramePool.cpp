@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "VideoFramePool.h"
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <jfxmedia_errors.h>
+#include <Utils/AutoLock.h>
+#include <Common/VSMemory.h>
+
+// Every block starts with this header, the aligned data follows it
+struct BlockHeader
+{
+    void*   pvAllocation;
+    size_t  size;
+};
+
+static inline BlockHeader *GetHeader(void *pvBlock)
+{
+    return (BlockHeader*)pvBlock - 1;
+}
+
+CVideoFramePool::VFPSingleton CVideoFramePool::s_Singleton;
+
+uint32_t CVideoFramePool::GetInstance(CVideoFramePool **ppPool)
+{
+    return s_Singleton.GetInstance(ppPool);
+}
+
+uint32_t CVideoFramePool::CreateInstance(CVideoFramePool **ppPool)
+{
+    CVideoFramePool *pPool = new(std::nothrow) CVideoFramePool();
+    if (NULL != pPool && NULL == pPool->m_pLock) {
+        delete pPool;
+        pPool = NULL;
+    }
+    *ppPool = pPool;
+    return NULL == pPool ? ERROR_MEMORY_ALLOCATION : ERROR_NONE;
+}
+
+CVideoFramePool::CVideoFramePool()
+:   m_pLock(CJfxCriticalSection::Create()),
+    m_CurrentSize(0),
+    m_uiFreeCount(0)
+{
+    memset(&m_Statistics, 0, sizeof(m_Statistics));
+}
+
+CVideoFramePool::~CVideoFramePool()
+{
+    while (m_uiFreeCount > 0)
+        FreeBlock(m_pvFree[--m_uiFreeCount]);
+    delete m_pLock;
+}
+
+void CVideoFramePool::FreeBlock(void *pvBlock)
+{
+    free(GetHeader(pvBlock)->pvAllocation);
+}
+
+void* CVideoFramePool::Acquire(size_t size)
+{
+    {
+        CAutoLock lock(m_pLock);
+
+        m_Statistics.framesConverted++;
+
+        // A new size means the stream changed, the kept blocks are useless
+        if (size != m_CurrentSize) {
+            while (m_uiFreeCount > 0)
+                FreeBlock(m_pvFree[--m_uiFreeCount]);
+            m_CurrentSize = size;
+        }
+
+        if (m_uiFreeCount > 0) {
+            m_Statistics.poolHits++;
+            return m_pvFree[--m_uiFreeCount];
+        }
+    }
+
+    if (size > SIZE_MAX - sizeof(BlockHeader) - 15)
+        return NULL;
+
+    void *pvAllocation = malloc(size + sizeof(BlockHeader) + 15);
+    if (NULL == pvAllocation)
+        return NULL;
+
+    void *pvBlock = (void*)(((uintptr_t)pvAllocation + sizeof(BlockHeader) + 15) & ~(uintptr_t)15);
+    GetHeader(pvBlock)->pvAllocation = pvAllocation;
+    GetHeader(pvBlock)->size = size;
+
+    CAutoLock lock(m_pLock);
+    m_Statistics.bytesAllocated += size;
+
+    return pvBlock;
+}
+
+void CVideoFramePool::Release(void *pvBlock)
+{
+    if (NULL == pvBlock)
+        return;
+
+    {
+        CAutoLock lock(m_pLock);
+
+        if (GetHeader(pvBlock)->size == m_CurrentSize && m_uiFreeCount < VIDEO_FRAME_POOL_MAX_FREE) {
+            m_pvFree[m_uiFreeCount++] = pvBlock;
+            return;
+        }
+    }
+
+    FreeBlock(pvBlock);
+}
+
+void CVideoFramePool::GetStatistics(Statistics *pStatistics)
+{
+    CAutoLock lock(m_pLock);
+    *pStatistics = m_Statistics;
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef _VIDEO_FRAME_POOL_H_
+#define _VIDEO_FRAME_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <Utils/Singleton.h>
+#include <Utils/JfxCriticalSection.h>
+
+#define VIDEO_FRAME_POOL_MAX_FREE 8
+
+/**
+ * class CVideoFramePool
+ *
+ * Recycles the memory of converted video frames. A stream converts frames
+ * of the same size over and over, so a released block is kept and handed
+ * out again for the next frame instead of going back to the heap. Only
+ * blocks of the most recently requested size are kept, at most
+ * VIDEO_FRAME_POOL_MAX_FREE of them.
+ */
+class CVideoFramePool
+{
+public:
+    struct Statistics
+    {
+        uint64_t framesConverted;   // blocks handed out
+        uint64_t poolHits;          // blocks handed out again after a release
+        uint64_t bytesAllocated;    // bytes taken from the heap
+    };
+
+    static uint32_t GetInstance(CVideoFramePool **ppPool);
+
+    // Returns a 16 byte aligned block of size bytes, NULL if out of memory.
+    void*   Acquire(size_t size);
+    // Returns a block from Acquire() to the pool.
+    void    Release(void *pvBlock);
+
+    void    GetStatistics(Statistics *pStatistics);
+
+private:
+    typedef Singleton<CVideoFramePool> VFPSingleton;
+    friend class Singleton<CVideoFramePool>;
+
+    CVideoFramePool();
+    ~CVideoFramePool();
+
+    static uint32_t CreateInstance(CVideoFramePool **ppPool);
+    static VFPSingleton s_Singleton;
+
+    static void FreeBlock(void *pvBlock);
+
+    CJfxCriticalSection *m_pLock;
+    size_t              m_CurrentSize;
+    void*               m_pvFree[VIDEO_FRAME_POOL_MAX_FREE];
+    unsigned int        m_uiFreeCount;
+    Statistics          m_Statistics;
+};
+
+#endif  //_VIDEO_FRAME_POOL_H_
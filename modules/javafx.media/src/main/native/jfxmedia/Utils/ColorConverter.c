@@ -27,7 +27,9 @@
 #include "ColorConverter.h"
 #include <stdio.h>
 
-#if (! TARGET_OS_LINUX || defined(__SSE2__))
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define ENABLE_SIMD_SSE2 0
+#elif (! TARGET_OS_LINUX || defined(__SSE2__))
 #if defined(TARGET_OS_MAC_ARM64)
 #define ENABLE_SIMD_SSE2 0
 #else
@@ -37,6 +39,13 @@
 #define ENABLE_SIMD_SSE2 0
 #endif
 
+// AVX2 kernels are built next to the SSE2 ones and picked at runtime
+#if ENABLE_SIMD_SSE2 && (defined(_MSC_VER) || defined(__GNUC__))
+#define ENABLE_SIMD_AVX2 1
+#else
+#define ENABLE_SIMD_AVX2 0
+#endif
+
 // --- Begin macros
 #define TCLAMP_U8(val, dst) dst = pClip[val]
 
@@ -380,2011 +389,537 @@ const uint16_t color_tBU[256] = {
 };
 // --- End tables
 
-// --- Begin YCbCr420p conversion functions
+/*
+ * The tables above as (i * M + R) >> S, exact for every i in 0..255, so
+ * that vector kernels produce the same pixels as the table lookups:
+ *   color_tYY[i] = (i * YY_M + YY_R) >> 12
+ *   color_tRV[i] = (i * RV_M + RV_R) >> 12
+ *   color_tGU[i] = 271 - ((i * GU_M + GU_R) >> 13)
+ *   color_tGV[i] = (i * GV_M + GV_R) >> 13
+ *   color_tBU[i] = (i * BU_M + BU_R) >> 12
+ * A channel is then clamp((Y + chroma term) >> 1) which is what
+ * TCLAMP_U8 and SCLAMP_U8 compute for the range of sums involved.
+ */
+#define YY_M 9539
+#define YY_R 2007
+#define RV_M 13079
+#define RV_R 2111
+#define GU_M 6423
+#define GU_R 1800
+#define GV_M 13323
+#define GV_R 4128
+#define BU_M 16535
+#define BU_R 2028
+
+#define RV_OFFSET 446
+#define GU_OFFSET 271
+#define BU_OFFSET 554
+
+/*
+ * A group of output rows sharing one row of chroma samples: two rows for
+ * 4:2:0, one for 4:2:2. Each chroma sample covers two pixels. In packed
+ * 4:2:2 frames luma samples are 2 bytes apart and chroma samples 4 bytes.
+ */
+typedef struct {
+    uint8_t       *dst[2];
+    const uint8_t *y[2];
+    const uint8_t *a[2];    // NULL if opaque
+    const uint8_t *u;
+    const uint8_t *v;
+    int32_t        rows;
+    int32_t        width;
+    int32_t        packed;
+    int32_t        bgra;    // BGRA with premultiplied alpha, else ARGB
+} ColorRows;
+
+// Converts the pixels from the start of the rows and returns how many were
+// done, always an even number. The rest is left to color_rows_c().
+typedef int32_t (*ColorRowsKernel)(const ColorRows *r);
+
+// --- Begin C conversion
+static void color_rows_c(const ColorRows *r, int32_t from)
+{
+    uint8_t *const pClip = (uint8_t *const)color_tClip + 288 * 2;
+    const int32_t y_step = r->packed ? 2 : 1;
+    const int32_t uv_step = r->packed ? 4 : 1;
+    int32_t i, k;
+
+    for (k = 0; k < r->rows; k++) {
+        const uint8_t *say = r->y[k];
+        const uint8_t *sa = r->a[k];
+        uint8_t *da = r->dst[k] + from * 4;
+
+        for (i = from; i < r->width; i++) {
+            int32_t sf0, sf1, sf2, sfr, sfg, sfb;
+            uint8_t cr, cg, cb, ca;
+
+            sf1 = r->u[(i >> 1) * uv_step];
+            sf2 = r->v[(i >> 1) * uv_step];
+
+            sfr = color_tRV[sf2] - RV_OFFSET;
+            sfg = color_tGU[sf1] - color_tGV[sf2];
+            sfb = color_tBU[sf1] - BU_OFFSET;
+
+            sf0 = color_tYY[say[i * y_step]];
+
+            TCLAMP_U8(sf0 + sfr, cr);
+            TCLAMP_U8(sf0 + sfg, cg);
+            SCLAMP_U8(sf0 + sfb, cb);
+
+            ca = sa ? sa[i] : 0xff;
+
+            if (r->bgra) {
+                if (sa) {
+                    cr = (uint8_t)((cr * (ca + 1)) >> 8);
+                    cg = (uint8_t)((cg * (ca + 1)) >> 8);
+                    cb = (uint8_t)((cb * (ca + 1)) >> 8);
+                }
+                da[0] = cb;
+                da[1] = cg;
+                da[2] = cr;
+                da[3] = ca;
+            } else {
+                da[0] = ca;
+                da[1] = cr;
+                da[2] = cg;
+                da[3] = cb;
+            }
+            da += 4;
+        }
+    }
+}
+// --- End C conversion
+
 #if ENABLE_SIMD_SSE2
-// --- Begin SSE2 YCbCr420p conversion functions
+// --- Begin SSE2 conversion
 #include <emmintrin.h>
 
-__m128i inline_load_si128(const __m128i *p)
+// (x * M + R) >> S for eight 16-bit lanes; mr holds M in the low and R in
+// the high half of every 32-bit lane
+static inline __m128i sse2_scale(__m128i x, __m128i mr, int s)
 {
-    return _mm_load_si128(p);
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i shift = _mm_cvtsi32_si128(s);
+    __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(x, one), mr);
+    __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi16(x, one), mr);
+    return _mm_packs_epi32(_mm_sra_epi32(lo, shift), _mm_sra_epi32(hi, shift));
 }
 
-__m128i inline_loadu_si128(const __m128i *p)
+// Chroma terms of eight samples, see color_rows_c()
+static inline void sse2_chroma(__m128i u, __m128i v, __m128i *cr, __m128i *cg, __m128i *cb)
 {
-    return _mm_loadu_si128(p);
+    *cr = _mm_sub_epi16(sse2_scale(v, _mm_set1_epi32((RV_R << 16) | RV_M), 12),
+                        _mm_set1_epi16(RV_OFFSET));
+    *cg = _mm_sub_epi16(_mm_set1_epi16(GU_OFFSET),
+                        _mm_add_epi16(sse2_scale(u, _mm_set1_epi32((GU_R << 16) | GU_M), 13),
+                                      sse2_scale(v, _mm_set1_epi32((GV_R << 16) | GV_M), 13)));
+    *cb = _mm_sub_epi16(sse2_scale(u, _mm_set1_epi32((BU_R << 16) | BU_M), 12),
+                        _mm_set1_epi16(BU_OFFSET));
 }
 
-#define    _mm_storeh_epi64(p, x_a)            \
-{                            \
-    __m128i x_ra = _mm_srli_si128(x_a, 8);        \
-    _mm_storel_epi64(p, x_ra);            \
+// 16 channel bytes from scaled luma of pixels 0-7 and 8-15 and the chroma
+// term of each pixel pair
+static inline __m128i sse2_channel(__m128i ylo, __m128i yhi, __m128i c)
+{
+    __m128i lo = _mm_srai_epi16(_mm_add_epi16(ylo, _mm_unpacklo_epi16(c, c)), 1);
+    __m128i hi = _mm_srai_epi16(_mm_add_epi16(yhi, _mm_unpackhi_epi16(c, c)), 1);
+    return _mm_packus_epi16(lo, hi);
 }
 
-#define    SAVE_ARGB1(argb, pd)                \
-{                            \
-    _mm_store_si128((__m128i*)pd, argb);        \
-    pd += 16;                    \
+static inline __m128i sse2_premultiply(__m128i c, __m128i a)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(c, zero),
+                                 _mm_add_epi16(_mm_unpacklo_epi8(a, zero), one));
+    __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(c, zero),
+                                 _mm_add_epi16(_mm_unpackhi_epi8(a, zero), one));
+    return _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
 }
 
-#define    SAVE_ARGB2(argb, pd)                \
-{                            \
-    _mm_storeu_si128((__m128i*)pd, argb);        \
-    pd += 16;                    \
+// Converts and stores 16 pixels
+static inline void sse2_pixels(uint8_t *dst, __m128i y, __m128i a, int has_alpha,
+                               __m128i cr, __m128i cg, __m128i cb, int bgra)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i yy = _mm_set1_epi32((YY_R << 16) | YY_M);
+    __m128i ylo = sse2_scale(_mm_unpacklo_epi8(y, zero), yy, 12);
+    __m128i yhi = sse2_scale(_mm_unpackhi_epi8(y, zero), yy, 12);
+    __m128i r = sse2_channel(ylo, yhi, cr);
+    __m128i g = sse2_channel(ylo, yhi, cg);
+    __m128i b = sse2_channel(ylo, yhi, cb);
+    __m128i c0, c1, c2, c3, lo01, hi01, lo23, hi23;
+
+    if (bgra) {
+        if (has_alpha) {
+            r = sse2_premultiply(r, a);
+            g = sse2_premultiply(g, a);
+            b = sse2_premultiply(b, a);
+        }
+        c0 = b; c1 = g; c2 = r; c3 = a;
+    } else {
+        c0 = a; c1 = r; c2 = g; c3 = b;
+    }
+
+    lo01 = _mm_unpacklo_epi8(c0, c1);
+    hi01 = _mm_unpackhi_epi8(c0, c1);
+    lo23 = _mm_unpacklo_epi8(c2, c3);
+    hi23 = _mm_unpackhi_epi8(c2, c3);
+    _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi16(lo01, lo23));
+    _mm_storeu_si128((__m128i*)(dst + 16), _mm_unpackhi_epi16(lo01, lo23));
+    _mm_storeu_si128((__m128i*)(dst + 32), _mm_unpacklo_epi16(hi01, hi23));
+    _mm_storeu_si128((__m128i*)(dst + 48), _mm_unpackhi_epi16(hi01, hi23));
 }
 
-#define SAVE_BGRA1(bgr, pd)             \
-{                           \
-    _mm_store_si128((__m128i*)pd, bgr);     \
-    pd += 16;                   \
+static int32_t color_rows_sse2(const ColorRows *r)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set1_epi8((char)0xff);
+    const __m128i even = _mm_set1_epi16(0xff);
+    const __m128i fourth = _mm_set1_epi32(0xff);
+    __m128i u, v, cr, cg, cb, y, a;
+    int32_t i = 0, k;
+
+    if (r->packed) {
+        // Loads reach into the next pixel pair
+        for (; i + 18 <= r->width; i += 16) {
+            const uint8_t *pu = r->u + i * 2;
+            const uint8_t *pv = r->v + i * 2;
+            const uint8_t *py = r->y[0] + i * 2;
+
+            u = _mm_packs_epi32(_mm_and_si128(_mm_loadu_si128((const __m128i*)pu), fourth),
+                                _mm_and_si128(_mm_loadu_si128((const __m128i*)(pu + 16)), fourth));
+            v = _mm_packs_epi32(_mm_and_si128(_mm_loadu_si128((const __m128i*)pv), fourth),
+                                _mm_and_si128(_mm_loadu_si128((const __m128i*)(pv + 16)), fourth));
+            y = _mm_packus_epi16(_mm_and_si128(_mm_loadu_si128((const __m128i*)py), even),
+                                 _mm_and_si128(_mm_loadu_si128((const __m128i*)(py + 16)), even));
+            sse2_chroma(u, v, &cr, &cg, &cb);
+            sse2_pixels(r->dst[0] + i * 4, y, opaque, 0, cr, cg, cb, r->bgra);
+        }
+        return i;
+    }
+
+    for (; i + 16 <= r->width; i += 16) {
+        u = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(r->u + i / 2)), zero);
+        v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(r->v + i / 2)), zero);
+        sse2_chroma(u, v, &cr, &cg, &cb);
+
+        for (k = 0; k < r->rows; k++) {
+            y = _mm_loadu_si128((const __m128i*)(r->y[k] + i));
+            a = r->a[k] ? _mm_loadu_si128((const __m128i*)(r->a[k] + i)) : opaque;
+            sse2_pixels(r->dst[k] + i * 4, y, a, r->a[k] != NULL, cr, cg, cb, r->bgra);
+        }
+    }
+    return i;
 }
+// --- End SSE2 conversion
+#endif // ENABLE_SIMD_SSE2
+
+#if ENABLE_SIMD_AVX2
+// --- Begin AVX2 conversion
+#include <immintrin.h>
 
-#define SAVE_BGRA2(bgr, pd)             \
-{                           \
-    _mm_storeu_si128((__m128i*)pd, bgr);        \
-    pd += 16;                   \
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define AVX2_TARGET
+#else
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+// Same as the SSE2 kernels with 32 pixels per step. Unpacking and packing
+// within 128-bit lanes keeps samples in order; only the final interleave
+// and the packed 4:2:2 loads need to cross lanes.
+AVX2_TARGET static inline __m256i avx2_scale(__m256i x, __m256i mr, int s)
+{
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m128i shift = _mm_cvtsi32_si128(s);
+    __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(x, one), mr);
+    __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(x, one), mr);
+    return _mm256_packs_epi32(_mm256_sra_epi32(lo, shift), _mm256_sra_epi32(hi, shift));
 }
 
-/*
- * cc = 16 color values
- * aa = 16 corresponding alpha values to premultiply with
- * tt = scratch register
- */
-#define PREMULTIPLY_ALPHA(cc,aa,tt) {\
-    x_temp = _mm_unpacklo_epi8(cc, x_zero); \
-    x_temp1 = _mm_unpacklo_epi8(aa, x_zero); \
-    x_temp1 = _mm_add_epi16(x_temp1, x_one); \
-    tt = _mm_mullo_epi16(x_temp, x_temp1); \
-    tt = _mm_srli_epi16(tt, 8); \
-    x_temp = _mm_unpackhi_epi8(cc, x_zero); \
-    x_temp1 = _mm_unpackhi_epi8(aa, x_zero); \
-    x_temp1 = _mm_add_epi16(x_temp1, x_one); \
-    x_temp1 = _mm_mullo_epi16(x_temp, x_temp1); \
-    x_temp1 = _mm_srli_epi16(x_temp1, 8); \
-    cc = _mm_packus_epi16(tt, x_temp1); \
+AVX2_TARGET static inline void avx2_chroma(__m256i u, __m256i v, __m256i *cr, __m256i *cg, __m256i *cb)
+{
+    *cr = _mm256_sub_epi16(avx2_scale(v, _mm256_set1_epi32((RV_R << 16) | RV_M), 12),
+                           _mm256_set1_epi16(RV_OFFSET));
+    *cg = _mm256_sub_epi16(_mm256_set1_epi16(GU_OFFSET),
+                           _mm256_add_epi16(avx2_scale(u, _mm256_set1_epi32((GU_R << 16) | GU_M), 13),
+                                            avx2_scale(v, _mm256_set1_epi32((GV_R << 16) | GV_M), 13)));
+    *cb = _mm256_sub_epi16(avx2_scale(u, _mm256_set1_epi32((BU_R << 16) | BU_M), 12),
+                           _mm256_set1_epi16(BU_OFFSET));
 }
 
-int ColorConvert_YCbCr420p_to_ARGB32(
-                               uint8_t *argb,
-                               int32_t argb_stride,
-                               int32_t width,
-                               int32_t height,
-                               const uint8_t *y,
-                               const uint8_t *v,
-                               const uint8_t *u,
-                               const uint8_t *a,
-                               int32_t y_stride,
-                               int32_t v_stride,
-                               int32_t u_stride,
-                               int32_t a_stride)
+AVX2_TARGET static inline __m256i avx2_channel(__m256i ylo, __m256i yhi, __m256i c)
 {
-    /* 1.1644  * 8192 */
-    const __m128i x_c0 = _mm_set1_epi16(0x2543);
-
-    /* 2.0184  * 8192 */
-    const __m128i x_c1 = _mm_set1_epi16(0x4097);
-    const int32_t ic1 = 0x4097;
-
-    /* abs( -0.3920 * 8192 ) */
-    const __m128i x_c4 = _mm_set1_epi16(0xc8b);
-    const int32_t ic4 = 0xc8b;
-
-    /* abs( -0.8132 * 8192 ) */
-    const __m128i x_c5 = _mm_set1_epi16(0x1a06);
-    const int32_t ic5 = 0x1a06;
-
-    /* 1.5966  * 8192 */
-    const __m128i x_c8 = _mm_set1_epi16(0x3317);
-    const int32_t ic8 = 0x3317;
-
-    /* -276.9856 * 32 */
-    const __m128i x_coff0 = _mm_set1_epi16(0xdd60);
-    const int32_t icoff0 = (int32_t)0xffffdd60;
-
-    /* 135.6352  * 32 */
-    const __m128i x_coff1 = _mm_set1_epi16(0x10f4);
-    const int32_t icoff1 = 0x10f4;
-
-    /* -222.9952 * 32 */
-    const __m128i x_coff2 = _mm_set1_epi16(0xe420);
-    const int32_t icoff2 = (int32_t)0xffffe420;
-
-    const __m128i x_zero = _mm_setzero_si128();
-    const __m128i x_one = _mm_set1_epi8(0xff);
-//    const __m128i x_aa = _mm_set1_epi8(0xff);
-
-    int32_t jH, iW;
-    int32_t iu, iv, ig, ir, ib, iTemp;
-    int32_t iu0, iu1, iv1, iv2;
-    __m128i x_u0, x_u1, x_v1, x_v2, x_temp, x_out, x_bak, x_temp1;
-    __m128i x_u, x_v, x_y1, x_y2, x_y3, x_y4, x_a1, x_a2;
-    __m128i x_r1, x_r2, x_r3, x_r4, x_g1, x_g2, x_g3, x_g4;
-    __m128i x_b1, x_b2, x_b3, x_b4, x_r, x_g, x_b;
-    __m128i x_arl, x_arh, x_gbl, x_gbh, x_argbh, x_argbl;
-    __m128i *px_y1, *px_y2, *px_a1, *px_a2;
-    __m64 *pm_u, *pm_v;
-    uint8_t *pY1, *pY2, *pU, *pV, *pA1, *pA2, *pD1, *pD2, *pd1, *pd2;
-
-    __m128i (*load_si128) (const __m128i*);
-    if (((intptr_t)y % 16) != 0 || ((intptr_t)u % 16) != 0 || ((intptr_t)v % 16) != 0 || ((intptr_t)a % 16) != 0 || (y_stride % 16) != 0 || (u_stride % 16) != 0 || (v_stride % 16) != 0 || (a_stride % 16) != 0)
-        load_si128 = &inline_loadu_si128;
-    else
-        load_si128 = &inline_load_si128;
-
-    pY1 = (uint8_t*)y;
-    pY2 = (uint8_t*)y + y_stride;
-    pU = (uint8_t*)u;
-    pV = (uint8_t*)v;
-    pA1 = (uint8_t*)a;
-    pA2 = (uint8_t*)a + a_stride;
-    pD1 = (uint8_t*)argb;
-    pD2 = (uint8_t*)argb + argb_stride;
-
-    for (jH = 0; jH < (height >> 1); jH++) {
-        px_y1 = (__m128i*)pY1;
-        px_y2 = (__m128i*)pY2;
-        pm_u = (__m64*)pU;
-        pm_v = (__m64*)pV;
-        px_a1 = (__m128i*)pA1;
-        px_a2 = (__m128i*)pA2;
-        pd1 = pD1;
-        pd2 = pD2;
-        iW = 0;
-
-        /* 32 pixels */
-        for (; iW <= width - 16; iW += 16) {
-            x_temp = _mm_loadl_epi64((__m128i*)pm_u);
-            x_u = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_u++;
-            x_temp = _mm_loadl_epi64((__m128i*)pm_v);
-            x_v = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_v++;
-            x_temp = load_si128(px_y1);
-            px_y1++;
-            x_temp1 = load_si128(px_y2);
-            px_y2++;
-            x_out = _mm_unpacklo_epi16(x_temp, x_temp1);
-            x_y1 = _mm_unpacklo_epi8(x_zero, x_out);
-            x_y2 = _mm_unpackhi_epi8(x_zero, x_out);
-            x_out = _mm_unpackhi_epi16(x_temp, x_temp1);
-            x_y3 = _mm_unpacklo_epi8(x_zero, x_out);
-            x_y4 = _mm_unpackhi_epi8(x_zero, x_out);
-            x_temp = load_si128(px_a1);             // top row (16 pix)
-            px_a1++;
-            x_temp1 = load_si128(px_a2);            // bottom row (16 pix)
-            px_a2++;
-            x_a1 = _mm_unpacklo_epi16(x_temp, x_temp1); // interleave top+bottom
-            x_a2 = _mm_unpackhi_epi16(x_temp, x_temp1);
-
-            /* pre calc x_[r/g/b][12] */
-            x_u0 = _mm_mulhi_epu16(x_u, x_c1);
-            x_b = _mm_add_epi16(x_u0, x_coff0); // 8 16 bit B
-
-            x_u1 = _mm_mulhi_epu16(x_u, x_c4);
-            x_v1 = _mm_mulhi_epu16(x_v, x_c5);
-            x_temp = _mm_add_epi16(x_u1, x_v1);
-            x_g = _mm_sub_epi16(x_coff1, x_temp);
-
-            x_v2 = _mm_mulhi_epu16(x_v, x_c8);
-            x_r = _mm_add_epi16(x_v2, x_coff2);
-
-            x_y1 = _mm_mulhi_epu16(x_y1, x_c0);
-            x_y2 = _mm_mulhi_epu16(x_y2, x_c0);
-            x_y3 = _mm_mulhi_epu16(x_y3, x_c0);
-            x_y4 = _mm_mulhi_epu16(x_y4, x_c0);
-
-            /* x_b[1/2/3/4] */
-            x_bak = _mm_unpacklo_epi16(x_b, x_b);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_b1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_b2 = _mm_add_epi16(x_y2, x_temp);
-
-            x_bak = _mm_unpackhi_epi16(x_b, x_b);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_b3 = _mm_add_epi16(x_y3, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_b4 = _mm_add_epi16(x_y4, x_temp);
-
-            /* x_g[1/2/3/4] */
-            x_bak = _mm_unpacklo_epi16(x_g, x_g);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_g1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_g2 = _mm_add_epi16(x_y2, x_temp);
-
-            x_bak = _mm_unpackhi_epi16(x_g, x_g);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_g3 = _mm_add_epi16(x_y3, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_g4 = _mm_add_epi16(x_y4, x_temp);
-
-            /* x_r[1/2/3/4] */
-            x_bak = _mm_unpacklo_epi16(x_r, x_r);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_r1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_r2 = _mm_add_epi16(x_y2, x_temp);
-
-            x_bak = _mm_unpackhi_epi16(x_r, x_r);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_r3 = _mm_add_epi16(x_y3, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_r4 = _mm_add_epi16(x_y4, x_temp);
-
-            x_b1 = _mm_srai_epi16(x_b1, 5);
-            x_b2 = _mm_srai_epi16(x_b2, 5);
-            x_b3 = _mm_srai_epi16(x_b3, 5);
-            x_b4 = _mm_srai_epi16(x_b4, 5);
-            x_g1 = _mm_srai_epi16(x_g1, 5);
-            x_g2 = _mm_srai_epi16(x_g2, 5);
-            x_g3 = _mm_srai_epi16(x_g3, 5);
-            x_g4 = _mm_srai_epi16(x_g4, 5);
-            x_r1 = _mm_srai_epi16(x_r1, 5);
-            x_r2 = _mm_srai_epi16(x_r2, 5);
-            x_r3 = _mm_srai_epi16(x_r3, 5);
-            x_r4 = _mm_srai_epi16(x_r4, 5);
-
-            /* pack: 16=>8 */
-            x_b = _mm_packus_epi16(x_b1, x_b2);
-            x_b1 = _mm_packus_epi16(x_b3, x_b4);
-            x_r = _mm_packus_epi16(x_r1, x_r2);
-            x_r1 = _mm_packus_epi16(x_r3, x_r4);
-            x_g = _mm_packus_epi16(x_g1, x_g2);
-            x_g1 = _mm_packus_epi16(x_g3, x_g4);
-
-            /* create argb sequences */
-            x_arl = _mm_unpacklo_epi8(x_a1, x_r); // XXXX xxxx xxxx xxxx - each X is top and bottom interleaved
-            x_arh = _mm_unpackhi_epi8(x_a1, x_r); // xxxx XXXX xxxx xxxx
-            x_gbl = _mm_unpacklo_epi8(x_g, x_b);
-            x_gbh = _mm_unpackhi_epi8(x_g, x_b);
-
-            x_argbl = _mm_unpacklo_epi16(x_arl, x_gbl);
-            x_argbh = _mm_unpackhi_epi16(x_arl, x_gbl);
-            x_temp = _mm_unpacklo_epi64(x_argbl, x_argbh);
-            x_temp1 = _mm_unpackhi_epi64(x_argbl, x_argbh);
-            SAVE_ARGB1(x_temp, pd1);
-            SAVE_ARGB1(x_temp1, pd2);
-
-            x_argbl = _mm_unpacklo_epi16(x_arh, x_gbh);
-            x_argbh = _mm_unpackhi_epi16(x_arh, x_gbh);
-            x_temp = _mm_unpacklo_epi64(x_argbl, x_argbh);
-            x_temp1 = _mm_unpackhi_epi64(x_argbl, x_argbh);
-            SAVE_ARGB1(x_temp, pd1);
-            SAVE_ARGB1(x_temp1, pd2);
-
-            /* create argb sequences */
-            x_arl = _mm_unpacklo_epi8(x_a2, x_r1); // xxxx xxxx xxxx XXXX
-            x_arh = _mm_unpackhi_epi8(x_a2, x_r1); // xxxx xxxx XXXX xxxx
-            x_gbl = _mm_unpacklo_epi8(x_g1, x_b1);
-            x_gbh = _mm_unpackhi_epi8(x_g1, x_b1);
-
-            x_argbl = _mm_unpacklo_epi16(x_arl, x_gbl);
-            x_argbh = _mm_unpackhi_epi16(x_arl, x_gbl);
-            x_temp = _mm_unpacklo_epi64(x_argbl, x_argbh);
-            x_temp1 = _mm_unpackhi_epi64(x_argbl, x_argbh);
-            SAVE_ARGB1(x_temp, pd1);
-            SAVE_ARGB1(x_temp1, pd2);
-
-            x_argbl = _mm_unpacklo_epi16(x_arh, x_gbh);
-            x_argbh = _mm_unpackhi_epi16(x_arh, x_gbh);
-            x_temp = _mm_unpacklo_epi64(x_argbl, x_argbh);
-            x_temp1 = _mm_unpackhi_epi64(x_argbl, x_argbh);
-            SAVE_ARGB1(x_temp, pd1);
-            SAVE_ARGB1(x_temp1, pd2);
-        }
-        /* 16 pixels - 8 byte chroma alignment */
-        if (iW <= width - 8) {
-            iTemp = *((int32_t *)pm_u);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_u = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_u = (__m64 *) (((int32_t *)pm_u) + 1);
-
-            iTemp = *((int32_t *)pm_v);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_v = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_v = (__m64 *) (((int32_t *)pm_v) + 1);
-
-            x_temp = _mm_loadl_epi64(px_y1);
-            px_y1 = (__m128i *) (((__m64 *)px_y1) + 1);
-            x_temp1 = _mm_loadl_epi64(px_y2);
-            px_y2 = (__m128i *) (((__m64 *)px_y2) + 1);
-            x_out = _mm_unpacklo_epi16(x_temp, x_temp1);
-            x_y1 = _mm_unpacklo_epi8(x_zero, x_out);
-            x_y2 = _mm_unpackhi_epi8(x_zero, x_out);
-
-            x_temp = _mm_loadl_epi64(px_a1);
-            px_a1 = (__m128i *) (((__m64 *)px_a1) + 1);
-            x_temp1 = _mm_loadl_epi64(px_a2);
-            px_a2 = (__m128i *) (((__m64 *)px_a2) + 1);
-            x_a1 = _mm_unpacklo_epi16(x_temp, x_temp1);
-
-            /* pre calc x_[r/g/b][12] */
-            x_u0 = _mm_mulhi_epu16(x_u, x_c1);
-            x_b = _mm_add_epi16(x_u0, x_coff0);
-
-            x_u1 = _mm_mulhi_epu16(x_u, x_c4);
-            x_v1 = _mm_mulhi_epu16(x_v, x_c5);
-            x_temp = _mm_add_epi16(x_u1, x_v1);
-            x_g = _mm_sub_epi16(x_coff1, x_temp);
-
-            x_v2 = _mm_mulhi_epu16(x_v, x_c8);
-            x_r = _mm_add_epi16(x_v2, x_coff2);
-
-            x_y1 = _mm_mulhi_epu16(x_y1, x_c0);
-            x_y2 = _mm_mulhi_epu16(x_y2, x_c0);
-
-            /* x_b[1/2] */
-            x_bak = _mm_unpacklo_epi16(x_b, x_b);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_b1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_b2 = _mm_add_epi16(x_y2, x_temp);
-
-            /* x_g[1/2] */
-            x_bak = _mm_unpacklo_epi16(x_g, x_g);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_g1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_g2 = _mm_add_epi16(x_y2, x_temp);
-
-            /* x_r[1/2] */
-            x_bak = _mm_unpacklo_epi16(x_r, x_r);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_r1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_r2 = _mm_add_epi16(x_y2, x_temp);
-
-            x_b1 = _mm_srai_epi16(x_b1, 5);
-            x_b2 = _mm_srai_epi16(x_b2, 5);
-            x_g1 = _mm_srai_epi16(x_g1, 5);
-            x_g2 = _mm_srai_epi16(x_g2, 5);
-            x_r1 = _mm_srai_epi16(x_r1, 5);
-            x_r2 = _mm_srai_epi16(x_r2, 5);
-
-            /* pack: 16=>8 */
-            x_b = _mm_packus_epi16(x_b1, x_b2);
-            x_r = _mm_packus_epi16(x_r1, x_r2);
-            x_g = _mm_packus_epi16(x_g1, x_g2);
-
-            /* create argb sequences */
-            x_arl = _mm_unpacklo_epi8(x_a1, x_r);
-            x_arh = _mm_unpackhi_epi8(x_a1, x_r);
-            x_gbl = _mm_unpacklo_epi8(x_g, x_b);
-            x_gbh = _mm_unpackhi_epi8(x_g, x_b);
-
-            x_argbl = _mm_unpacklo_epi16(x_arl, x_gbl);
-            x_argbh = _mm_unpackhi_epi16(x_arl, x_gbl);
-            x_temp = _mm_unpacklo_epi64(x_argbl, x_argbh);
-            x_temp1 = _mm_unpackhi_epi64(x_argbl, x_argbh);
-            SAVE_ARGB1(x_temp, pd1);
-            SAVE_ARGB1(x_temp1, pd2);
-
-            x_argbl = _mm_unpacklo_epi16(x_arh, x_gbh);
-            x_argbh = _mm_unpackhi_epi16(x_arh, x_gbh);
-            x_temp = _mm_unpacklo_epi64(x_argbl, x_argbh);
-            x_temp1 = _mm_unpackhi_epi64(x_argbl, x_argbh);
-            SAVE_ARGB1(x_temp, pd1);
-            SAVE_ARGB1(x_temp1, pd2);
-
-            iW += 8;
-        }
+    __m256i lo = _mm256_srai_epi16(_mm256_add_epi16(ylo, _mm256_unpacklo_epi16(c, c)), 1);
+    __m256i hi = _mm256_srai_epi16(_mm256_add_epi16(yhi, _mm256_unpackhi_epi16(c, c)), 1);
+    return _mm256_packus_epi16(lo, hi);
+}
 
-        /* 8 pixels */
-        if (iW <= width - 4) {
-            iTemp = *((uint16_t *)pm_u);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_u = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_u = (__m64 *) (((uint16_t *)pm_u) + 1);
-            iTemp = *((uint16_t *)pm_v);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_v = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_v = (__m64 *) (((uint16_t *)pm_v) + 1);
-
-            iTemp = *((int32_t *)px_y1);
-            px_y1 = (__m128i *) (((int32_t *)px_y1) + 1);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            iTemp = *((int32_t *)px_y2);
-            px_y2 = (__m128i *) (((int32_t *)px_y2) + 1);
-            x_temp1 = _mm_cvtsi32_si128(iTemp);
-            x_out = _mm_unpacklo_epi16(x_temp, x_temp1);
-            x_y1 = _mm_unpacklo_epi8(x_zero, x_out);
-
-            iTemp = *((int32_t *)px_a1);
-            px_a1 = (__m128i *) (((int32_t *)px_a1) + 1);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            iTemp = *((int32_t *)px_a2);
-            px_a2 = (__m128i *) (((int32_t *)px_a2) + 1);
-            x_temp1 = _mm_cvtsi32_si128(iTemp);
-            x_a1 = _mm_unpacklo_epi16(x_temp, x_temp1);
-
-            /* pre calc x_[r/g/b][1] */
-            x_u0 = _mm_mulhi_epu16(x_u, x_c1);
-            x_b = _mm_add_epi16(x_u0, x_coff0);
-
-            x_u1 = _mm_mulhi_epu16(x_u, x_c4);
-            x_v1 = _mm_mulhi_epu16(x_v, x_c5);
-            x_temp = _mm_add_epi16(x_u1, x_v1);
-            x_g = _mm_sub_epi16(x_coff1, x_temp);
-
-            x_v2 = _mm_mulhi_epu16(x_v, x_c8);
-            x_r = _mm_add_epi16(x_v2, x_coff2);
-
-            x_y1 = _mm_mulhi_epu16(x_y1, x_c0);
-            x_y2 = _mm_mulhi_epu16(x_y2, x_c0);
-
-            /* x_b[1] */
-            x_bak = _mm_unpacklo_epi16(x_b, x_b);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_b1 = _mm_add_epi16(x_y1, x_temp);
-
-            /* x_g[1] */
-            x_bak = _mm_unpacklo_epi16(x_g, x_g);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_g1 = _mm_add_epi16(x_y1, x_temp);
-
-            /* x_r[1] */
-            x_bak = _mm_unpacklo_epi16(x_r, x_r);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_r1 = _mm_add_epi16(x_y1, x_temp);
-
-            x_b1 = _mm_srai_epi16(x_b1, 5);
-            x_g1 = _mm_srai_epi16(x_g1, 5);
-            x_r1 = _mm_srai_epi16(x_r1, 5);
-
-            /* pack: 16=>8 */
-            x_b = _mm_packus_epi16(x_b1, x_zero);
-            x_r = _mm_packus_epi16(x_r1, x_zero);
-            x_g = _mm_packus_epi16(x_g1, x_zero);
-
-            /* create argb sequences */
-            x_arl = _mm_unpacklo_epi8(x_a1, x_r);
-            x_gbl = _mm_unpacklo_epi8(x_g, x_b);
-
-            x_argbl = _mm_unpacklo_epi16(x_arl, x_gbl);
-            x_argbh = _mm_unpackhi_epi16(x_arl, x_gbl);
-            x_temp = _mm_unpacklo_epi64(x_argbl, x_argbh);
-            x_temp1 = _mm_unpackhi_epi64(x_argbl, x_argbh);
-            SAVE_ARGB1(x_temp, pd1);
-            SAVE_ARGB1(x_temp1, pd2);
-
-            iW += 4;
-        }
+AVX2_TARGET static inline __m256i avx2_premultiply(__m256i c, __m256i a)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi16(1);
+    __m256i lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(c, zero),
+                                    _mm256_add_epi16(_mm256_unpacklo_epi8(a, zero), one));
+    __m256i hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(c, zero),
+                                    _mm256_add_epi16(_mm256_unpackhi_epi8(a, zero), one));
+    return _mm256_packus_epi16(_mm256_srli_epi16(lo, 8), _mm256_srli_epi16(hi, 8));
+}
 
-        /* 4 pixels */
-        if (iW <= width - 2) {
-            /* load y u v, and expand */
-            iu = *((uint8_t *)pm_u);
-            pm_u = (__m64 *) (((uint8_t *)pm_u) + 1);
-            iv = *((uint8_t *)pm_v);
-            pm_v = (__m64 *) (((uint8_t *)pm_v) + 1);
-
-            iTemp = (*((uint16_t *)px_y1)  & 0xffff) | (*((uint16_t *)px_y2)<<16);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_y1 = _mm_unpacklo_epi8(x_zero, x_temp);
-            px_y1 = (__m128i *) (((uint16_t *)px_y1) + 1);
-            px_y2 = (__m128i *) (((uint16_t *)px_y2) + 1);
-
-            iTemp = (*((uint16_t *)px_a1)  & 0xffff) | (*((uint16_t *)px_a2)<<16);
-            x_a1 = _mm_cvtsi32_si128(iTemp);
-            px_a1 = (__m128i *) (((uint16_t *)px_a1) + 1);
-            px_a2 = (__m128i *) (((uint16_t *)px_a2) + 1);
-
-            /* pre-calc d[r/g/b][1] */
-            iu0 = (iu * ic1) >> 8;
-            ib = icoff0 + iu0;
-
-            iu1 = (iu * ic4) >> 8;
-            iv1 = (iv * ic5) >> 8;
-            iTemp = iu1 + iv1;
-            ig = icoff1 - iTemp;
-
-            iv2 = (iv * ic8) >> 8;
-            ir = iv2 + icoff2;
-
-            x_y1 = _mm_mulhi_epu16(x_y1, x_c0);
-
-            /* db1 */
-            x_temp = _mm_set1_epi16(ib);
-            x_b1 = _mm_add_epi16(x_y1, x_temp);
-
-            /* dg1 */
-            x_temp = _mm_set1_epi16(ig);
-            x_g1 = _mm_add_epi16(x_y1, x_temp);
-
-            /* dr1 */
-            x_temp = _mm_set1_epi16(ir);
-            x_r1 = _mm_add_epi16(x_y1, x_temp);
-
-            x_b1 = _mm_srai_epi16(x_b1, 5);
-            x_g1 = _mm_srai_epi16(x_g1, 5);
-            x_r1 = _mm_srai_epi16(x_r1, 5);
-
-            /* pack: 16=>8 */
-            x_b = _mm_packus_epi16(x_b1, x_zero);
-            x_r = _mm_packus_epi16(x_r1, x_zero);
-            x_g = _mm_packus_epi16(x_g1, x_zero);
-
-            /* create argb sequences */
-            x_arl = _mm_unpacklo_epi8(x_a1, x_r);
-            x_gbl = _mm_unpacklo_epi8(x_g, x_b);
-
-            /* lower half of darl & dgbl */
-            x_argbl = _mm_unpacklo_epi16(x_arl, x_gbl);
-            _mm_storel_epi64((__m128i*)pd1, x_argbl);
-            _mm_storeh_epi64((__m128i*)pd2, x_argbl);
-
-            pd1 += 8;
-            pd2 += 8;
+// Converts and stores 32 pixels
+AVX2_TARGET static inline void avx2_pixels(uint8_t *dst, __m256i y, __m256i a, int has_alpha,
+                                           __m256i cr, __m256i cg, __m256i cb, int bgra)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i yy = _mm256_set1_epi32((YY_R << 16) | YY_M);
+    __m256i ylo = avx2_scale(_mm256_unpacklo_epi8(y, zero), yy, 12);
+    __m256i yhi = avx2_scale(_mm256_unpackhi_epi8(y, zero), yy, 12);
+    __m256i r = avx2_channel(ylo, yhi, cr);
+    __m256i g = avx2_channel(ylo, yhi, cg);
+    __m256i b = avx2_channel(ylo, yhi, cb);
+    __m256i c0, c1, c2, c3, lo01, hi01, lo23, hi23, p0, p1, p2, p3;
+
+    if (bgra) {
+        if (has_alpha) {
+            r = avx2_premultiply(r, a);
+            g = avx2_premultiply(g, a);
+            b = avx2_premultiply(b, a);
         }
-
-        pY1 += (2 * y_stride);
-        pY2 += (2 * y_stride);
-        pU += u_stride;
-        pV += v_stride;
-        pA1 += (2 * a_stride);
-        pA2 += (2 * a_stride);
-        pD1 += (2 * argb_stride);
-        pD2 += (2 * argb_stride);
+        c0 = b; c1 = g; c2 = r; c3 = a;
+    } else {
+        c0 = a; c1 = r; c2 = g; c3 = b;
     }
 
-    return 0;
+    lo01 = _mm256_unpacklo_epi8(c0, c1);
+    hi01 = _mm256_unpackhi_epi8(c0, c1);
+    lo23 = _mm256_unpacklo_epi8(c2, c3);
+    hi23 = _mm256_unpackhi_epi8(c2, c3);
+    p0 = _mm256_unpacklo_epi16(lo01, lo23);     // pixels 0-3, 16-19
+    p1 = _mm256_unpackhi_epi16(lo01, lo23);     // pixels 4-7, 20-23
+    p2 = _mm256_unpacklo_epi16(hi01, hi23);     // pixels 8-11, 24-27
+    p3 = _mm256_unpackhi_epi16(hi01, hi23);     // pixels 12-15, 28-31
+    _mm256_storeu_si256((__m256i*)dst, _mm256_permute2x128_si256(p0, p1, 0x20));
+    _mm256_storeu_si256((__m256i*)(dst + 32), _mm256_permute2x128_si256(p2, p3, 0x20));
+    _mm256_storeu_si256((__m256i*)(dst + 64), _mm256_permute2x128_si256(p0, p1, 0x31));
+    _mm256_storeu_si256((__m256i*)(dst + 96), _mm256_permute2x128_si256(p2, p3, 0x31));
 }
 
-int ColorConvert_YCbCr420p_to_ARGB32_no_alpha(
-                                     uint8_t *argb,
-                                     int32_t argb_stride,
-                                     int32_t width,
-                                     int32_t height,
-                                     const uint8_t *y,
-                                     const uint8_t *v,
-                                     const uint8_t *u,
-                                     int32_t y_stride,
-                                     int32_t v_stride,
-                                     int32_t u_stride)
+AVX2_TARGET static int32_t color_rows_avx2(const ColorRows *r)
 {
-    /* 1.1644  * 8192 */
-    const __m128i x_c0 = _mm_set1_epi16(0x2543);
-
-    /* 2.0184  * 8192 */
-    const __m128i x_c1 = _mm_set1_epi16(0x4097);
-    const int32_t ic1 = 0x4097;
-
-    /* abs( -0.3920 * 8192 ) */
-    const __m128i x_c4 = _mm_set1_epi16(0xc8b);
-    const int32_t ic4 = 0xc8b;
-
-    /* abs( -0.8132 * 8192 ) */
-    const __m128i x_c5 = _mm_set1_epi16(0x1a06);
-    const int32_t ic5 = 0x1a06;
-
-    /* 1.5966  * 8192 */
-    const __m128i x_c8 = _mm_set1_epi16(0x3317);
-    const int32_t ic8 = 0x3317;
-
-    /* -276.9856 * 32 */
-    const __m128i x_coff0 = _mm_set1_epi16(0xdd60);
-    const int32_t icoff0 = (int32_t)0xffffdd60;
-
-    /* 135.6352  * 32 */
-    const __m128i x_coff1 = _mm_set1_epi16(0x10f4);
-    const int32_t icoff1 = 0x10f4;
-
-    /* -222.9952 * 32 */
-    const __m128i x_coff2 = _mm_set1_epi16(0xe420);
-    const int32_t icoff2 = (int32_t)0xffffe420;
-
-    const __m128i x_zero = _mm_setzero_si128();
-    const __m128i x_aa = _mm_set1_epi8(0xff);
-
-    int32_t jH, iW;
-    int32_t iu, iv, ig, ir, ib, iTemp;
-    int32_t iu0, iu1, iv1, iv2;
-    __m128i x_u0, x_u1, x_v1, x_v2, x_temp, x_out, x_bak, x_temp1;
-    __m128i x_u, x_v, x_y1, x_y2, x_y3, x_y4;
-    __m128i x_r1, x_r2, x_r3, x_r4, x_g1, x_g2, x_g3, x_g4;
-    __m128i x_b1, x_b2, x_b3, x_b4, x_r, x_g, x_b;
-    __m128i x_arl, x_arh, x_gbl, x_gbh, x_argbh, x_argbl;
-    __m128i *px_y1, *px_y2;
-    __m64 *pm_u, *pm_v;
-    uint8_t *pY1, *pY2, *pU, *pV, *pD1, *pD2, *pd1, *pd2;
-
-    __m128i (*load_si128) (const __m128i*);
-    if (((intptr_t)y % 16) != 0 || ((intptr_t)u % 16) != 0 || ((intptr_t)v % 16) != 0 || (y_stride % 16) != 0 || (u_stride % 16) != 0 || (v_stride % 16) != 0)
-        load_si128 = &inline_loadu_si128;
-    else
-        load_si128 = &inline_load_si128;
-
-    pY1 = (uint8_t*)y;
-    pY2 = (uint8_t*)y + y_stride;
-    pU = (uint8_t*)u;
-    pV = (uint8_t*)v;
-    pD1 = (uint8_t*)argb;
-    pD2 = (uint8_t*)argb + argb_stride;
-
-    for (jH = 0; jH < (height >> 1); jH++) {
-        px_y1 = (__m128i*)pY1;
-        px_y2 = (__m128i*)pY2;
-        pm_u = (__m64*)pU;
-        pm_v = (__m64*)pV;
-        pd1 = pD1;
-        pd2 = pD2;
-        iW = 0;
-
-        /* 32 pixels */
-        for (; iW <= width - 16; iW += 16) {
-            x_temp = _mm_loadl_epi64((__m128i*)pm_u);
-            x_u = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_u++;
-            x_temp = _mm_loadl_epi64((__m128i*)pm_v);
-            x_v = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_v++;
-            x_temp = load_si128(px_y1);
-            px_y1++;
-            x_temp1 = load_si128(px_y2);
-            px_y2++;
-            x_out = _mm_unpacklo_epi16(x_temp, x_temp1);
-            x_y1 = _mm_unpacklo_epi8(x_zero, x_out);
-            x_y2 = _mm_unpackhi_epi8(x_zero, x_out);
-            x_out = _mm_unpackhi_epi16(x_temp, x_temp1);
-            x_y3 = _mm_unpacklo_epi8(x_zero, x_out);
-            x_y4 = _mm_unpackhi_epi8(x_zero, x_out);
-
-            /* pre calc x_[r/g/b][12] */
-            x_u0 = _mm_mulhi_epu16(x_u, x_c1);
-            x_b = _mm_add_epi16(x_u0, x_coff0);
-
-            x_u1 = _mm_mulhi_epu16(x_u, x_c4);
-            x_v1 = _mm_mulhi_epu16(x_v, x_c5);
-            x_temp = _mm_add_epi16(x_u1, x_v1);
-            x_g = _mm_sub_epi16(x_coff1, x_temp);
-
-            x_v2 = _mm_mulhi_epu16(x_v, x_c8);
-            x_r = _mm_add_epi16(x_v2, x_coff2);
-
-            x_y1 = _mm_mulhi_epu16(x_y1, x_c0);
-            x_y2 = _mm_mulhi_epu16(x_y2, x_c0);
-            x_y3 = _mm_mulhi_epu16(x_y3, x_c0);
-            x_y4 = _mm_mulhi_epu16(x_y4, x_c0);
-
-            /* x_b[1/2/3/4] */
-            x_bak = _mm_unpacklo_epi16(x_b, x_b);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_b1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_b2 = _mm_add_epi16(x_y2, x_temp);
-
-            x_bak = _mm_unpackhi_epi16(x_b, x_b);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_b3 = _mm_add_epi16(x_y3, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_b4 = _mm_add_epi16(x_y4, x_temp);
-
-            /* x_g[1/2/3/4] */
-            x_bak = _mm_unpacklo_epi16(x_g, x_g);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_g1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_g2 = _mm_add_epi16(x_y2, x_temp);
-
-            x_bak = _mm_unpackhi_epi16(x_g, x_g);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_g3 = _mm_add_epi16(x_y3, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_g4 = _mm_add_epi16(x_y4, x_temp);
-
-            /* x_r[1/2/3/4] */
-            x_bak = _mm_unpacklo_epi16(x_r, x_r);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_r1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_r2 = _mm_add_epi16(x_y2, x_temp);
-
-            x_bak = _mm_unpackhi_epi16(x_r, x_r);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_r3 = _mm_add_epi16(x_y3, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_r4 = _mm_add_epi16(x_y4, x_temp);
-
-            x_b1 = _mm_srai_epi16(x_b1, 5);
-            x_b2 = _mm_srai_epi16(x_b2, 5);
-            x_b3 = _mm_srai_epi16(x_b3, 5);
-            x_b4 = _mm_srai_epi16(x_b4, 5);
-            x_g1 = _mm_srai_epi16(x_g1, 5);
-            x_g2 = _mm_srai_epi16(x_g2, 5);
-            x_g3 = _mm_srai_epi16(x_g3, 5);
-            x_g4 = _mm_srai_epi16(x_g4, 5);
-            x_r1 = _mm_srai_epi16(x_r1, 5);
-            x_r2 = _mm_srai_epi16(x_r2, 5);
-            x_r3 = _mm_srai_epi16(x_r3, 5);
-            x_r4 = _mm_srai_epi16(x_r4, 5);
-
-            /* pack: 16=>8 */
-            x_b = _mm_packus_epi16(x_b1, x_b2);
-            x_b1 = _mm_packus_epi16(x_b3, x_b4);
-            x_r = _mm_packus_epi16(x_r1, x_r2);
-            x_r1 = _mm_packus_epi16(x_r3, x_r4);
-            x_g = _mm_packus_epi16(x_g1, x_g2);
-            x_g1 = _mm_packus_epi16(x_g3, x_g4);
-
-            /* create argb sequences */
-            x_arl = _mm_unpacklo_epi8(x_aa, x_r); // XXXX xxxx xxxx xxxx - each X is top and bottom interleaved
-            x_arh = _mm_unpackhi_epi8(x_aa, x_r); // xxxx XXXX xxxx xxxx
-            x_gbl = _mm_unpacklo_epi8(x_g, x_b);
-            x_gbh = _mm_unpackhi_epi8(x_g, x_b);
-
-            x_argbl = _mm_unpacklo_epi16(x_arl, x_gbl);
-            x_argbh = _mm_unpackhi_epi16(x_arl, x_gbl);
-            x_temp = _mm_unpacklo_epi64(x_argbl, x_argbh);
-            x_temp1 = _mm_unpackhi_epi64(x_argbl, x_argbh);
-            SAVE_ARGB1(x_temp, pd1);
-            SAVE_ARGB1(x_temp1, pd2);
-
-            x_argbl = _mm_unpacklo_epi16(x_arh, x_gbh);
-            x_argbh = _mm_unpackhi_epi16(x_arh, x_gbh);
-            x_temp = _mm_unpacklo_epi64(x_argbl, x_argbh);
-            x_temp1 = _mm_unpackhi_epi64(x_argbl, x_argbh);
-            SAVE_ARGB1(x_temp, pd1);
-            SAVE_ARGB1(x_temp1, pd2);
-
-            /* create argb sequences */
-            x_arl = _mm_unpacklo_epi8(x_aa, x_r1); // xxxx xxxx xxxx XXXX
-            x_arh = _mm_unpackhi_epi8(x_aa, x_r1); // xxxx xxxx XXXX xxxx
-            x_gbl = _mm_unpacklo_epi8(x_g1, x_b1);
-            x_gbh = _mm_unpackhi_epi8(x_g1, x_b1);
-
-            x_argbl = _mm_unpacklo_epi16(x_arl, x_gbl);
-            x_argbh = _mm_unpackhi_epi16(x_arl, x_gbl);
-            x_temp = _mm_unpacklo_epi64(x_argbl, x_argbh);
-            x_temp1 = _mm_unpackhi_epi64(x_argbl, x_argbh);
-            SAVE_ARGB1(x_temp, pd1);
-            SAVE_ARGB1(x_temp1, pd2);
-
-            x_argbl = _mm_unpacklo_epi16(x_arh, x_gbh);
-            x_argbh = _mm_unpackhi_epi16(x_arh, x_gbh);
-            x_temp = _mm_unpacklo_epi64(x_argbl, x_argbh);
-            x_temp1 = _mm_unpackhi_epi64(x_argbl, x_argbh);
-            SAVE_ARGB1(x_temp, pd1);
-            SAVE_ARGB1(x_temp1, pd2);
-        }
-        /* 16 pixels - 8 byte chroma alignment */
-        if (iW <= width - 8) {
-            iTemp = *((int32_t *)pm_u);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_u = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_u = (__m64 *) (((int32_t *)pm_u) + 1);
-
-            iTemp = *((int32_t *)pm_v);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_v = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_v = (__m64 *) (((int32_t *)pm_v) + 1);
-
-            x_temp = _mm_loadl_epi64(px_y1);
-            px_y1 = (__m128i *) (((__m64 *)px_y1) + 1);
-            x_temp1 = _mm_loadl_epi64(px_y2);
-            px_y2 = (__m128i *) (((__m64 *)px_y2) + 1);
-            x_out = _mm_unpacklo_epi16(x_temp, x_temp1);
-            x_y1 = _mm_unpacklo_epi8(x_zero, x_out);
-            x_y2 = _mm_unpackhi_epi8(x_zero, x_out);
-
-            /* pre calc x_[r/g/b][12] */
-            x_u0 = _mm_mulhi_epu16(x_u, x_c1);
-            x_b = _mm_add_epi16(x_u0, x_coff0);
-
-            x_u1 = _mm_mulhi_epu16(x_u, x_c4);
-            x_v1 = _mm_mulhi_epu16(x_v, x_c5);
-            x_temp = _mm_add_epi16(x_u1, x_v1);
-            x_g = _mm_sub_epi16(x_coff1, x_temp);
-
-            x_v2 = _mm_mulhi_epu16(x_v, x_c8);
-            x_r = _mm_add_epi16(x_v2, x_coff2);
-
-            x_y1 = _mm_mulhi_epu16(x_y1, x_c0);
-            x_y2 = _mm_mulhi_epu16(x_y2, x_c0);
-
-            /* x_b[1/2] */
-            x_bak = _mm_unpacklo_epi16(x_b, x_b);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_b1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_b2 = _mm_add_epi16(x_y2, x_temp);
-
-            /* x_g[1/2] */
-            x_bak = _mm_unpacklo_epi16(x_g, x_g);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_g1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_g2 = _mm_add_epi16(x_y2, x_temp);
-
-            /* x_r[1/2] */
-            x_bak = _mm_unpacklo_epi16(x_r, x_r);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_r1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_r2 = _mm_add_epi16(x_y2, x_temp);
-
-            x_b1 = _mm_srai_epi16(x_b1, 5);
-            x_b2 = _mm_srai_epi16(x_b2, 5);
-            x_g1 = _mm_srai_epi16(x_g1, 5);
-            x_g2 = _mm_srai_epi16(x_g2, 5);
-            x_r1 = _mm_srai_epi16(x_r1, 5);
-            x_r2 = _mm_srai_epi16(x_r2, 5);
-
-            /* pack: 16=>8 */
-            x_b = _mm_packus_epi16(x_b1, x_b2);
-            x_r = _mm_packus_epi16(x_r1, x_r2);
-            x_g = _mm_packus_epi16(x_g1, x_g2);
-
-            /* create argb sequences */
-            x_arl = _mm_unpacklo_epi8(x_aa, x_r);
-            x_arh = _mm_unpackhi_epi8(x_aa, x_r);
-            x_gbl = _mm_unpacklo_epi8(x_g, x_b);
-            x_gbh = _mm_unpackhi_epi8(x_g, x_b);
-
-            x_argbl = _mm_unpacklo_epi16(x_arl, x_gbl);
-            x_argbh = _mm_unpackhi_epi16(x_arl, x_gbl);
-            x_temp = _mm_unpacklo_epi64(x_argbl, x_argbh);
-            x_temp1 = _mm_unpackhi_epi64(x_argbl, x_argbh);
-            SAVE_ARGB1(x_temp, pd1);
-            SAVE_ARGB1(x_temp1, pd2);
-
-            x_argbl = _mm_unpacklo_epi16(x_arh, x_gbh);
-            x_argbh = _mm_unpackhi_epi16(x_arh, x_gbh);
-            x_temp = _mm_unpacklo_epi64(x_argbl, x_argbh);
-            x_temp1 = _mm_unpackhi_epi64(x_argbl, x_argbh);
-            SAVE_ARGB1(x_temp, pd1);
-            SAVE_ARGB1(x_temp1, pd2);
-
-            iW += 8;
+    const __m256i opaque = _mm256_set1_epi8((char)0xff);
+    const __m256i even = _mm256_set1_epi16(0xff);
+    const __m256i fourth = _mm256_set1_epi32(0xff);
+    __m256i u, v, cr, cg, cb, y, a;
+    int32_t i = 0, k;
+
+    if (r->packed) {
+        // Loads reach into the next pixel pair
+        for (; i + 34 <= r->width; i += 32) {
+            const uint8_t *pu = r->u + i * 2;
+            const uint8_t *pv = r->v + i * 2;
+            const uint8_t *py = r->y[0] + i * 2;
+
+            u = _mm256_packs_epi32(_mm256_and_si256(_mm256_loadu_si256((const __m256i*)pu), fourth),
+                                   _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(pu + 32)), fourth));
+            v = _mm256_packs_epi32(_mm256_and_si256(_mm256_loadu_si256((const __m256i*)pv), fourth),
+                                   _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(pv + 32)), fourth));
+            y = _mm256_packus_epi16(_mm256_and_si256(_mm256_loadu_si256((const __m256i*)py), even),
+                                    _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(py + 32)), even));
+            u = _mm256_permute4x64_epi64(u, 0xd8);
+            v = _mm256_permute4x64_epi64(v, 0xd8);
+            y = _mm256_permute4x64_epi64(y, 0xd8);
+            avx2_chroma(u, v, &cr, &cg, &cb);
+            avx2_pixels(r->dst[0] + i * 4, y, opaque, 0, cr, cg, cb, r->bgra);
         }
+        return i;
+    }
 
-        /* 8 pixels */
-        if (iW <= width - 4) {
-            iTemp = *((uint16_t *)pm_u);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_u = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_u = (__m64 *) (((uint16_t *)pm_u) + 1);
-            iTemp = *((uint16_t *)pm_v);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_v = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_v = (__m64 *) (((uint16_t *)pm_v) + 1);
-
-            iTemp = *((int32_t *)px_y1);
-            px_y1 = (__m128i *) (((int32_t *)px_y1) + 1);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            iTemp = *((int32_t *)px_y2);
-            px_y2 = (__m128i *) (((int32_t *)px_y2) + 1);
-            x_temp1 = _mm_cvtsi32_si128(iTemp);
-            x_out = _mm_unpacklo_epi16(x_temp, x_temp1);
-            x_y1 = _mm_unpacklo_epi8(x_zero, x_out);
-
-            /* pre calc x_[r/g/b][1] */
-            x_u0 = _mm_mulhi_epu16(x_u, x_c1);
-            x_b = _mm_add_epi16(x_u0, x_coff0);
-
-            x_u1 = _mm_mulhi_epu16(x_u, x_c4);
-            x_v1 = _mm_mulhi_epu16(x_v, x_c5);
-            x_temp = _mm_add_epi16(x_u1, x_v1);
-            x_g = _mm_sub_epi16(x_coff1, x_temp);
-
-            x_v2 = _mm_mulhi_epu16(x_v, x_c8);
-            x_r = _mm_add_epi16(x_v2, x_coff2);
-
-            x_y1 = _mm_mulhi_epu16(x_y1, x_c0);
-            x_y2 = _mm_mulhi_epu16(x_y2, x_c0);
-
-            /* x_b[1] */
-            x_bak = _mm_unpacklo_epi16(x_b, x_b);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_b1 = _mm_add_epi16(x_y1, x_temp);
-
-            /* x_g[1] */
-            x_bak = _mm_unpacklo_epi16(x_g, x_g);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_g1 = _mm_add_epi16(x_y1, x_temp);
-
-            /* x_r[1] */
-            x_bak = _mm_unpacklo_epi16(x_r, x_r);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_r1 = _mm_add_epi16(x_y1, x_temp);
-
-            x_b1 = _mm_srai_epi16(x_b1, 5);
-            x_g1 = _mm_srai_epi16(x_g1, 5);
-            x_r1 = _mm_srai_epi16(x_r1, 5);
-
-            /* pack: 16=>8 */
-            x_b = _mm_packus_epi16(x_b1, x_zero);
-            x_r = _mm_packus_epi16(x_r1, x_zero);
-            x_g = _mm_packus_epi16(x_g1, x_zero);
-
-            /* create argb sequences */
-            x_arl = _mm_unpacklo_epi8(x_aa, x_r);
-            x_gbl = _mm_unpacklo_epi8(x_g, x_b);
-
-            x_argbl = _mm_unpacklo_epi16(x_arl, x_gbl);
-            x_argbh = _mm_unpackhi_epi16(x_arl, x_gbl);
-            x_temp = _mm_unpacklo_epi64(x_argbl, x_argbh);
-            x_temp1 = _mm_unpackhi_epi64(x_argbl, x_argbh);
-            SAVE_ARGB1(x_temp, pd1);
-            SAVE_ARGB1(x_temp1, pd2);
-
-            iW += 4;
-        }
+    for (; i + 32 <= r->width; i += 32) {
+        u = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(r->u + i / 2)));
+        v = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(r->v + i / 2)));
+        avx2_chroma(u, v, &cr, &cg, &cb);
 
-        /* 4 pixels */
-        if (iW <= width - 2) {
-            /* load y u v, and expand */
-            iu = *((uint8_t *)pm_u);
-            pm_u = (__m64 *) (((uint8_t *)pm_u) + 1);
-            iv = *((uint8_t *)pm_v);
-            pm_v = (__m64 *) (((uint8_t *)pm_v) + 1);
-
-            iTemp = (*((uint16_t *)px_y1)  & 0xffff) | (*((uint16_t *)px_y2)<<16);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_y1 = _mm_unpacklo_epi8(x_zero, x_temp);
-            px_y1 = (__m128i *) (((uint16_t *)px_y1) + 1);
-            px_y2 = (__m128i *) (((uint16_t *)px_y2) + 1);
-
-            /* pre-calc d[r/g/b][1] */
-            iu0 = (iu * ic1) >> 8;
-            ib = icoff0 + iu0;
-
-            iu1 = (iu * ic4) >> 8;
-            iv1 = (iv * ic5) >> 8;
-            iTemp = iu1 + iv1;
-            ig = icoff1 - iTemp;
-
-            iv2 = (iv * ic8) >> 8;
-            ir = iv2 + icoff2;
-
-            x_y1 = _mm_mulhi_epu16(x_y1, x_c0);
-
-            /* db1 */
-            x_temp = _mm_set1_epi16(ib);
-            x_b1 = _mm_add_epi16(x_y1, x_temp);
-
-            /* dg1 */
-            x_temp = _mm_set1_epi16(ig);
-            x_g1 = _mm_add_epi16(x_y1, x_temp);
-
-            /* dr1 */
-            x_temp = _mm_set1_epi16(ir);
-            x_r1 = _mm_add_epi16(x_y1, x_temp);
-
-            x_b1 = _mm_srai_epi16(x_b1, 5);
-            x_g1 = _mm_srai_epi16(x_g1, 5);
-            x_r1 = _mm_srai_epi16(x_r1, 5);
-
-            /* pack: 16=>8 */
-            x_b = _mm_packus_epi16(x_b1, x_zero);
-            x_r = _mm_packus_epi16(x_r1, x_zero);
-            x_g = _mm_packus_epi16(x_g1, x_zero);
-
-            /* create argb sequences */
-            x_arl = _mm_unpacklo_epi8(x_aa, x_r);
-            x_gbl = _mm_unpacklo_epi8(x_g, x_b);
-
-            /* lower half of darl & dgbl */
-            x_argbl = _mm_unpacklo_epi16(x_arl, x_gbl);
-            _mm_storel_epi64((__m128i*)pd1, x_argbl);
-            _mm_storeh_epi64((__m128i*)pd2, x_argbl);
-
-            pd1 += 8;
-            pd2 += 8;
+        for (k = 0; k < r->rows; k++) {
+            y = _mm256_loadu_si256((const __m256i*)(r->y[k] + i));
+            a = r->a[k] ? _mm256_loadu_si256((const __m256i*)(r->a[k] + i)) : opaque;
+            avx2_pixels(r->dst[k] + i * 4, y, a, r->a[k] != NULL, cr, cg, cb, r->bgra);
         }
+    }
 
-        pY1 += (2 * y_stride);
-        pY2 += (2 * y_stride);
-        pU += u_stride;
-        pV += v_stride;
-        pD1 += (2 * argb_stride);
-        pD2 += (2 * argb_stride);
+    // Leave a remainder of 16 or more to the SSE2 kernel
+    if (i + 16 <= r->width) {
+        ColorRows rest = *r;
+        for (k = 0; k < r->rows; k++) {
+            rest.dst[k] += i * 4;
+            rest.y[k] += i;
+            if (rest.a[k])
+                rest.a[k] += i;
+        }
+        rest.u += i / 2;
+        rest.v += i / 2;
+        rest.width -= i;
+        i += color_rows_sse2(&rest);
     }
+    return i;
+}
 
-    return 0;
+static int color_cpu_has_avx2(void)
+{
+#if defined(_MSC_VER)
+    int info[4];
+
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return 0;
+
+    // AVX and OSXSAVE, and the OS saves the YMM registers
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6)
+        return 0;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
 }
+// --- End AVX2 conversion
+#endif // ENABLE_SIMD_AVX2
 
-int ColorConvert_YCbCr420p_to_BGRA32(
-                                     uint8_t *bgra,
-                                     int32_t bgra_stride,
-                                     int32_t width,
-                                     int32_t height,
-                                     const uint8_t *y,
-                                     const uint8_t *v,
-                                     const uint8_t *u,
-                                     const uint8_t *a,
-                                     int32_t y_stride,
-                                     int32_t v_stride,
-                                     int32_t u_stride,
-                                     int32_t a_stride)
+// --- Begin dispatch
+static volatile int color_level = -1;
+
+static int color_level_supported(int level)
 {
-    /* 1.1644  * 8192 */
-    const __m128i x_c0 = _mm_set1_epi16(0x2543);
-
-    /* 2.0184  * 8192 */
-    const __m128i x_c1 = _mm_set1_epi16(0x4097);
-    const int32_t ic1 = 0x4097;
-
-    /* abs( -0.3920 * 8192 ) */
-    const __m128i x_c4 = _mm_set1_epi16(0xc8b);
-    const int32_t ic4 = 0xc8b;
-
-    /* abs( -0.8132 * 8192 ) */
-    const __m128i x_c5 = _mm_set1_epi16(0x1a06);
-    const int32_t ic5 = 0x1a06;
-
-    /* 1.5966  * 8192 */
-    const __m128i x_c8 = _mm_set1_epi16(0x3317);
-    const int32_t ic8 = 0x3317;
-
-    /* -276.9856 * 32 */
-    const __m128i x_coff0 = _mm_set1_epi16(0xdd60);
-    const int32_t icoff0 = (int32_t)0xffffdd60;
-
-    /* 135.6352  * 32 */
-    const __m128i x_coff1 = _mm_set1_epi16(0x10f4);
-    const int32_t icoff1 = 0x10f4;
-
-    /* -222.9952 * 32 */
-    const __m128i x_coff2 = _mm_set1_epi16(0xe420);
-    const int32_t icoff2 = (int32_t)0xffffe420;
-
-    const __m128i x_zero = _mm_setzero_si128();
-    const __m128i x_one = _mm_set1_epi16(0x0001);
-    //    const __m128i x_aa = _mm_set1_epi8(0xff);
-
-    int32_t jH, iW;
-    int32_t iu, iv, ig, ir, ib, iTemp;
-    int32_t iu0, iu1, iv1, iv2;
-    __m128i x_u0, x_u1, x_v1, x_v2, x_temp, x_out, x_bak, x_temp1;
-    __m128i x_u, x_v, x_y1, x_y2, x_y3, x_y4, x_a1, x_a2;
-    __m128i x_r1, x_r2, x_r3, x_r4, x_g1, x_g2, x_g3, x_g4;
-    __m128i x_b1, x_b2, x_b3, x_b4, x_r, x_g, x_b;
-    __m128i x_ral, x_rah, x_bgl, x_bgh, x_bgrah, x_bgral;
-    __m128i *px_y1, *px_y2, *px_a1, *px_a2;
-    __m64 *pm_u, *pm_v;
-    uint8_t *pY1, *pY2, *pU, *pV, *pA1, *pA2, *pD1, *pD2, *pd1, *pd2;
-
-    __m128i (*load_si128) (const __m128i*);
-    if (((intptr_t)y % 16) != 0 || ((intptr_t)u % 16) != 0 || ((intptr_t)v % 16) != 0 || ((intptr_t)a % 16) != 0 || (y_stride % 16) != 0 || (u_stride % 16) != 0 || (v_stride % 16) != 0 || (a_stride % 16) != 0)
-        load_si128 = &inline_loadu_si128;
-    else
-        load_si128 = &inline_load_si128;
-
-#if 0
-    if ((intptr_t)bgra & 0xf)
-        fprintf(stderr, "bgra is unaligned! %p\n", bgra);
-    if ((intptr_t)y & 0xf)
-        fprintf(stderr, "luma is unaligned! %p\n", y);
-    if ((intptr_t)v & 0xf)
-        fprintf(stderr, "Cb is unaligned! %p\n", v);
-    if ((intptr_t)u & 0xf)
-        fprintf(stderr, "Cr is unaligned! %p\n", u);
-    if ((intptr_t)a & 0xf)
-        fprintf(stderr, "alpha is unaligned! %p\n", a);
+    switch (level) {
+        case COLOR_CONVERT_C:
+            return 1;
+#if ENABLE_SIMD_SSE2
+        case COLOR_CONVERT_SSE2:
+            return 1;
 #endif
-    pY1 = (uint8_t*)y;
-    pY2 = (uint8_t*)y + y_stride;
-    pU = (uint8_t*)u;
-    pV = (uint8_t*)v;
-    pA1 = (uint8_t*)a;
-    pA2 = (uint8_t*)a + a_stride;
-    pD1 = (uint8_t*)bgra;
-    pD2 = (uint8_t*)bgra + bgra_stride;
-
-    for (jH = 0; jH < (height >> 1); jH++) {
-        px_y1 = (__m128i*)pY1;
-        px_y2 = (__m128i*)pY2;
-        pm_u = (__m64*)pU;
-        pm_v = (__m64*)pV;
-        px_a1 = (__m128i*)pA1;
-        px_a2 = (__m128i*)pA2;
-        pd1 = pD1;
-        pd2 = pD2;
-        iW = 0;
-
-        /* 32 pixels */
-        for (; iW <= width - 16; iW += 16) {
-            x_temp = _mm_loadl_epi64((__m128i*)pm_u);
-            x_u = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_u++;
-            x_temp = _mm_loadl_epi64((__m128i*)pm_v);
-            x_v = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_v++;
-            x_temp = load_si128(px_y1);
-            px_y1++;
-            x_temp1 = load_si128(px_y2);
-            px_y2++;
-            x_out = _mm_unpacklo_epi16(x_temp, x_temp1);
-            x_y1 = _mm_unpacklo_epi8(x_zero, x_out);
-            x_y2 = _mm_unpackhi_epi8(x_zero, x_out);
-            x_out = _mm_unpackhi_epi16(x_temp, x_temp1);
-            x_y3 = _mm_unpacklo_epi8(x_zero, x_out);
-            x_y4 = _mm_unpackhi_epi8(x_zero, x_out);
-            x_temp = load_si128(px_a1);             // top row (16 pix)
-            px_a1++;
-            x_temp1 = load_si128(px_a2);            // bottom row (16 pix)
-            px_a2++;
-            x_a1 = _mm_unpacklo_epi16(x_temp, x_temp1); // interleave top+bottom
-            x_a2 = _mm_unpackhi_epi16(x_temp, x_temp1);
-
-            /* pre calc x_[r/g/b][12] */
-            x_u0 = _mm_mulhi_epu16(x_u, x_c1);
-            x_b = _mm_add_epi16(x_u0, x_coff0);
-
-            x_u1 = _mm_mulhi_epu16(x_u, x_c4);
-            x_v1 = _mm_mulhi_epu16(x_v, x_c5);
-            x_temp = _mm_add_epi16(x_u1, x_v1);
-            x_g = _mm_sub_epi16(x_coff1, x_temp);
-
-            x_v2 = _mm_mulhi_epu16(x_v, x_c8);
-            x_r = _mm_add_epi16(x_v2, x_coff2);
-
-            x_y1 = _mm_mulhi_epu16(x_y1, x_c0);
-            x_y2 = _mm_mulhi_epu16(x_y2, x_c0);
-            x_y3 = _mm_mulhi_epu16(x_y3, x_c0);
-            x_y4 = _mm_mulhi_epu16(x_y4, x_c0);
-
-            /* x_b[1/2/3/4] */
-            x_bak = _mm_unpacklo_epi16(x_b, x_b);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_b1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_b2 = _mm_add_epi16(x_y2, x_temp);
-
-            x_bak = _mm_unpackhi_epi16(x_b, x_b);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_b3 = _mm_add_epi16(x_y3, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_b4 = _mm_add_epi16(x_y4, x_temp);
-
-            /* x_g[1/2/3/4] */
-            x_bak = _mm_unpacklo_epi16(x_g, x_g);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_g1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_g2 = _mm_add_epi16(x_y2, x_temp);
-
-            x_bak = _mm_unpackhi_epi16(x_g, x_g);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_g3 = _mm_add_epi16(x_y3, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_g4 = _mm_add_epi16(x_y4, x_temp);
-
-            /* x_r[1/2/3/4] */
-            x_bak = _mm_unpacklo_epi16(x_r, x_r);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_r1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_r2 = _mm_add_epi16(x_y2, x_temp);
-
-            x_bak = _mm_unpackhi_epi16(x_r, x_r);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_r3 = _mm_add_epi16(x_y3, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_r4 = _mm_add_epi16(x_y4, x_temp);
-
-            x_b1 = _mm_srai_epi16(x_b1, 5);
-            x_b2 = _mm_srai_epi16(x_b2, 5);
-            x_b3 = _mm_srai_epi16(x_b3, 5);
-            x_b4 = _mm_srai_epi16(x_b4, 5);
-            x_g1 = _mm_srai_epi16(x_g1, 5);
-            x_g2 = _mm_srai_epi16(x_g2, 5);
-            x_g3 = _mm_srai_epi16(x_g3, 5);
-            x_g4 = _mm_srai_epi16(x_g4, 5);
-            x_r1 = _mm_srai_epi16(x_r1, 5);
-            x_r2 = _mm_srai_epi16(x_r2, 5);
-            x_r3 = _mm_srai_epi16(x_r3, 5);
-            x_r4 = _mm_srai_epi16(x_r4, 5);
-
-            /* pack: 16=>8 */
-            x_b = _mm_packus_epi16(x_b1, x_b2);
-            PREMULTIPLY_ALPHA(x_b, x_a1, x_b2);
-            x_b1 = _mm_packus_epi16(x_b3, x_b4);
-            PREMULTIPLY_ALPHA(x_b1, x_a2, x_b2);
-            x_r = _mm_packus_epi16(x_r1, x_r2);
-            PREMULTIPLY_ALPHA(x_r, x_a1, x_r2);
-            x_r1 = _mm_packus_epi16(x_r3, x_r4);
-            PREMULTIPLY_ALPHA(x_r1, x_a2, x_r2);
-            x_g = _mm_packus_epi16(x_g1, x_g2);
-            PREMULTIPLY_ALPHA(x_g, x_a1, x_g2);
-            x_g1 = _mm_packus_epi16(x_g3, x_g4);
-            PREMULTIPLY_ALPHA(x_g1, x_a2, x_g2);
-
-            /* create bgra sequences */
-            x_bgl = _mm_unpacklo_epi8(x_b, x_g);
-            x_bgh = _mm_unpackhi_epi8(x_b, x_g);
-            x_ral = _mm_unpacklo_epi8(x_r, x_a1);
-            x_rah = _mm_unpackhi_epi8(x_r, x_a1);
-
-            x_bgral = _mm_unpacklo_epi16(x_bgl, x_ral);
-            x_bgrah = _mm_unpackhi_epi16(x_bgl, x_ral);
-            x_temp = _mm_unpacklo_epi64(x_bgral, x_bgrah);
-            x_temp1 = _mm_unpackhi_epi64(x_bgral, x_bgrah);
-            SAVE_BGRA1(x_temp, pd1);
-            SAVE_BGRA1(x_temp1, pd2);
-
-            x_bgral = _mm_unpacklo_epi16(x_bgh, x_rah);
-            x_bgrah = _mm_unpackhi_epi16(x_bgh, x_rah);
-            x_temp = _mm_unpacklo_epi64(x_bgral, x_bgrah);
-            x_temp1 = _mm_unpackhi_epi64(x_bgral, x_bgrah);
-            SAVE_BGRA1(x_temp, pd1);
-            SAVE_BGRA1(x_temp1, pd2);
-
-            /* create bgra sequences */
-            x_bgl = _mm_unpacklo_epi8(x_b1, x_g1);
-            x_bgh = _mm_unpackhi_epi8(x_b1, x_g1);
-            x_ral = _mm_unpacklo_epi8(x_r1, x_a2);
-            x_rah = _mm_unpackhi_epi8(x_r1, x_a2);
-
-            x_bgral = _mm_unpacklo_epi16(x_bgl, x_ral);
-            x_bgrah = _mm_unpackhi_epi16(x_bgl, x_ral);
-            x_temp = _mm_unpacklo_epi64(x_bgral, x_bgrah);
-            x_temp1 = _mm_unpackhi_epi64(x_bgral, x_bgrah);
-            SAVE_BGRA1(x_temp, pd1);
-            SAVE_BGRA1(x_temp1, pd2);
-
-            x_bgral = _mm_unpacklo_epi16(x_bgh, x_rah);
-            x_bgrah = _mm_unpackhi_epi16(x_bgh, x_rah);
-            x_temp = _mm_unpacklo_epi64(x_bgral, x_bgrah);
-            x_temp1 = _mm_unpackhi_epi64(x_bgral, x_bgrah);
-            SAVE_BGRA1(x_temp, pd1);
-            SAVE_BGRA1(x_temp1, pd2);
-        }
-        /* 16 pixels - 8 byte chroma alignment */
-        if (iW <= width - 8) {
-            iTemp = *((int32_t *)pm_u);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_u = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_u = (__m64 *) (((int32_t *)pm_u) + 1);
-
-            iTemp = *((int32_t *)pm_v);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_v = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_v = (__m64 *) (((int32_t *)pm_v) + 1);
-
-            x_temp = _mm_loadl_epi64(px_y1);
-            px_y1 = (__m128i *) (((__m64 *)px_y1) + 1);
-            x_temp1 = _mm_loadl_epi64(px_y2);
-            px_y2 = (__m128i *) (((__m64 *)px_y2) + 1);
-            x_out = _mm_unpacklo_epi16(x_temp, x_temp1);
-            x_y1 = _mm_unpacklo_epi8(x_zero, x_out);
-            x_y2 = _mm_unpackhi_epi8(x_zero, x_out);
-
-            x_temp = _mm_loadl_epi64(px_a1);
-            px_a1 = (__m128i *) (((__m64 *)px_a1) + 1);
-            x_temp1 = _mm_loadl_epi64(px_a2);
-            px_a2 = (__m128i *) (((__m64 *)px_a2) + 1);
-            x_a1 = _mm_unpacklo_epi16(x_temp, x_temp1);
-
-            /* pre calc x_[r/g/b][12] */
-            x_u0 = _mm_mulhi_epu16(x_u, x_c1);
-            x_b = _mm_add_epi16(x_u0, x_coff0);
-
-            x_u1 = _mm_mulhi_epu16(x_u, x_c4);
-            x_v1 = _mm_mulhi_epu16(x_v, x_c5);
-            x_temp = _mm_add_epi16(x_u1, x_v1);
-            x_g = _mm_sub_epi16(x_coff1, x_temp);
-
-            x_v2 = _mm_mulhi_epu16(x_v, x_c8);
-            x_r = _mm_add_epi16(x_v2, x_coff2);
-
-            x_y1 = _mm_mulhi_epu16(x_y1, x_c0);
-            x_y2 = _mm_mulhi_epu16(x_y2, x_c0);
-
-            /* x_b[1/2] */
-            x_bak = _mm_unpacklo_epi16(x_b, x_b);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_b1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_b2 = _mm_add_epi16(x_y2, x_temp);
-
-            /* x_g[1/2] */
-            x_bak = _mm_unpacklo_epi16(x_g, x_g);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_g1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_g2 = _mm_add_epi16(x_y2, x_temp);
-
-            /* x_r[1/2] */
-            x_bak = _mm_unpacklo_epi16(x_r, x_r);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_r1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_r2 = _mm_add_epi16(x_y2, x_temp);
-
-            x_b1 = _mm_srai_epi16(x_b1, 5);
-            x_b2 = _mm_srai_epi16(x_b2, 5);
-            x_g1 = _mm_srai_epi16(x_g1, 5);
-            x_g2 = _mm_srai_epi16(x_g2, 5);
-            x_r1 = _mm_srai_epi16(x_r1, 5);
-            x_r2 = _mm_srai_epi16(x_r2, 5);
-
-            /* pack: 16=>8 */
-            x_b = _mm_packus_epi16(x_b1, x_b2);
-            PREMULTIPLY_ALPHA(x_b, x_a1, x_b2);
-            x_r = _mm_packus_epi16(x_r1, x_r2);
-            PREMULTIPLY_ALPHA(x_r, x_a1, x_r2);
-            x_g = _mm_packus_epi16(x_g1, x_g2);
-            PREMULTIPLY_ALPHA(x_g, x_a1, x_g2);
-
-            /* create bgra sequences */
-            x_bgl = _mm_unpacklo_epi8(x_b, x_g);
-            x_bgh = _mm_unpackhi_epi8(x_b, x_g);
-            x_ral = _mm_unpacklo_epi8(x_r, x_a1);
-            x_rah = _mm_unpackhi_epi8(x_r, x_a1);
-
-            x_bgral = _mm_unpacklo_epi16(x_bgl, x_ral);
-            x_bgrah = _mm_unpackhi_epi16(x_bgl, x_ral);
-            x_temp = _mm_unpacklo_epi64(x_bgral, x_bgrah);
-            x_temp1 = _mm_unpackhi_epi64(x_bgral, x_bgrah);
-            SAVE_BGRA1(x_temp, pd1);
-            SAVE_BGRA1(x_temp1, pd2);
-
-            x_bgral = _mm_unpacklo_epi16(x_bgh, x_rah);
-            x_bgrah = _mm_unpackhi_epi16(x_bgh, x_rah);
-            x_temp = _mm_unpacklo_epi64(x_bgral, x_bgrah);
-            x_temp1 = _mm_unpackhi_epi64(x_bgral, x_bgrah);
-            SAVE_BGRA1(x_temp, pd1);
-            SAVE_BGRA1(x_temp1, pd2);
-
-            iW += 8;
-        }
+#if ENABLE_SIMD_AVX2
+        case COLOR_CONVERT_AVX2:
+            return color_cpu_has_avx2();
+#endif
+        default:
+            return 0;
+    }
+}
 
-        /* 8 pixels */
-        if (iW <= width - 4) {
-            iTemp = *((uint16_t *)pm_u);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_u = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_u = (__m64 *) (((uint16_t *)pm_u) + 1);
-            iTemp = *((uint16_t *)pm_v);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_v = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_v = (__m64 *) (((uint16_t *)pm_v) + 1);
-
-            iTemp = *((int32_t *)px_y1);
-            px_y1 = (__m128i *) (((int32_t *)px_y1) + 1);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            iTemp = *((int32_t *)px_y2);
-            px_y2 = (__m128i *) (((int32_t *)px_y2) + 1);
-            x_temp1 = _mm_cvtsi32_si128(iTemp);
-            x_out = _mm_unpacklo_epi16(x_temp, x_temp1);
-            x_y1 = _mm_unpacklo_epi8(x_zero, x_out);
-
-            iTemp = *((int32_t *)px_a1);
-            px_a1 = (__m128i *) (((int32_t *)px_a1) + 1);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            iTemp = *((int32_t *)px_a2);
-            px_a2 = (__m128i *) (((int32_t *)px_a2) + 1);
-            x_temp1 = _mm_cvtsi32_si128(iTemp);
-            x_a1 = _mm_unpacklo_epi16(x_temp, x_temp1);
-
-            /* pre calc x_[r/g/b][1] */
-            x_u0 = _mm_mulhi_epu16(x_u, x_c1);
-            x_b = _mm_add_epi16(x_u0, x_coff0);
-
-            x_u1 = _mm_mulhi_epu16(x_u, x_c4);
-            x_v1 = _mm_mulhi_epu16(x_v, x_c5);
-            x_temp = _mm_add_epi16(x_u1, x_v1);
-            x_g = _mm_sub_epi16(x_coff1, x_temp);
-
-            x_v2 = _mm_mulhi_epu16(x_v, x_c8);
-            x_r = _mm_add_epi16(x_v2, x_coff2);
-
-            x_y1 = _mm_mulhi_epu16(x_y1, x_c0);
-            x_y2 = _mm_mulhi_epu16(x_y2, x_c0);
-
-            /* x_b[1] */
-            x_bak = _mm_unpacklo_epi16(x_b, x_b);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_b1 = _mm_add_epi16(x_y1, x_temp);
-
-            /* x_g[1] */
-            x_bak = _mm_unpacklo_epi16(x_g, x_g);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_g1 = _mm_add_epi16(x_y1, x_temp);
-
-            /* x_r[1] */
-            x_bak = _mm_unpacklo_epi16(x_r, x_r);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_r1 = _mm_add_epi16(x_y1, x_temp);
-
-            x_b1 = _mm_srai_epi16(x_b1, 5);
-            x_g1 = _mm_srai_epi16(x_g1, 5);
-            x_r1 = _mm_srai_epi16(x_r1, 5);
-
-            /* pack: 16=>8 */
-            x_b = _mm_packus_epi16(x_b1, x_zero);
-            PREMULTIPLY_ALPHA(x_b, x_a1, x_b2);
-            x_r = _mm_packus_epi16(x_r1, x_zero);
-            PREMULTIPLY_ALPHA(x_r, x_a1, x_r2);
-            x_g = _mm_packus_epi16(x_g1, x_zero);
-            PREMULTIPLY_ALPHA(x_g, x_a1, x_g2);
-
-            /* create bgra sequences */
-            x_bgl = _mm_unpacklo_epi8(x_b, x_g);
-            x_ral = _mm_unpacklo_epi8(x_r, x_a1);
-
-            x_bgral = _mm_unpacklo_epi16(x_bgl, x_ral);
-            x_bgrah = _mm_unpackhi_epi16(x_bgl, x_ral);
-            x_temp = _mm_unpacklo_epi64(x_bgral, x_bgrah);
-            x_temp1 = _mm_unpackhi_epi64(x_bgral, x_bgrah);
-            SAVE_BGRA1(x_temp, pd1);
-            SAVE_BGRA1(x_temp1, pd2);
-
-            iW += 4;
-        }
+int ColorConvert_GetLevel(void)
+{
+    int level = color_level;
 
-        /* 4 pixels */
-        if (iW <= width - 2) {
-            /* load y u v, and expand */
-            iu = *((uint8_t *)pm_u);
-            pm_u = (__m64 *) (((uint8_t *)pm_u) + 1);
-            iv = *((uint8_t *)pm_v);
-            pm_v = (__m64 *) (((uint8_t *)pm_v) + 1);
-
-            iTemp = (*((uint16_t *)px_y1)  & 0xffff) | (*((uint16_t *)px_y2)<<16);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_y1 = _mm_unpacklo_epi8(x_zero, x_temp);
-            px_y1 = (__m128i *) (((uint16_t *)px_y1) + 1);
-            px_y2 = (__m128i *) (((uint16_t *)px_y2) + 1);
-
-            iTemp = (*((uint16_t *)px_a1)  & 0xffff) | (*((uint16_t *)px_a2)<<16);
-            x_a1 = _mm_cvtsi32_si128(iTemp);
-            px_a1 = (__m128i *) (((uint16_t *)px_a1) + 1);
-            px_a2 = (__m128i *) (((uint16_t *)px_a2) + 1);
-
-            /* pre-calc d[r/g/b][1] */
-            iu0 = (iu * ic1) >> 8;
-            ib = icoff0 + iu0;
-
-            iu1 = (iu * ic4) >> 8;
-            iv1 = (iv * ic5) >> 8;
-            iTemp = iu1 + iv1;
-            ig = icoff1 - iTemp;
-
-            iv2 = (iv * ic8) >> 8;
-            ir = iv2 + icoff2;
-
-            x_y1 = _mm_mulhi_epu16(x_y1, x_c0);
-
-            /* db1 */
-            x_temp = _mm_set1_epi16(ib);
-            x_b1 = _mm_add_epi16(x_y1, x_temp);
-
-            /* dg1 */
-            x_temp = _mm_set1_epi16(ig);
-            x_g1 = _mm_add_epi16(x_y1, x_temp);
-
-            /* dr1 */
-            x_temp = _mm_set1_epi16(ir);
-            x_r1 = _mm_add_epi16(x_y1, x_temp);
-
-            x_b1 = _mm_srai_epi16(x_b1, 5);
-            x_g1 = _mm_srai_epi16(x_g1, 5);
-            x_r1 = _mm_srai_epi16(x_r1, 5);
-
-            /* pack: 16=>8 */
-            x_b = _mm_packus_epi16(x_b1, x_zero);
-            PREMULTIPLY_ALPHA(x_b, x_a1, x_b2);
-            x_r = _mm_packus_epi16(x_r1, x_zero);
-            PREMULTIPLY_ALPHA(x_r, x_a1, x_r2);
-            x_g = _mm_packus_epi16(x_g1, x_zero);
-            PREMULTIPLY_ALPHA(x_g, x_a1, x_g2);
-
-            /* create bgra sequences */
-            x_bgl = _mm_unpacklo_epi8(x_b, x_g);
-            x_ral = _mm_unpacklo_epi8(x_r, x_a1);
-
-            /* lower half of darl & dgbl */
-            x_bgral = _mm_unpacklo_epi16(x_bgl, x_ral);
-            _mm_storel_epi64((__m128i*)pd1, x_bgral);
-            _mm_storeh_epi64((__m128i*)pd2, x_bgral);
-
-            pd1 += 8;
-            pd2 += 8;
+    if (level < 0) {
+        for (level = COLOR_CONVERT_AVX2; level > COLOR_CONVERT_C; level--) {
+            if (color_level_supported(level))
+                break;
         }
-
-        pY1 += (2 * y_stride);
-        pY2 += (2 * y_stride);
-        pU += u_stride;
-        pV += v_stride;
-        pA1 += (2 * a_stride);
-        pA2 += (2 * a_stride);
-        pD1 += (2 * bgra_stride);
-        pD2 += (2 * bgra_stride);
+        color_level = level;
     }
+    return level;
+}
 
-    return 0;
+int ColorConvert_SetLevel(int level)
+{
+    if (color_level_supported(level))
+        color_level = level;
+    return ColorConvert_GetLevel();
 }
 
-int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
-                                              uint8_t *bgra,
-                                              int32_t bgra_stride,
-                                              int32_t width,
-                                              int32_t height,
-                                              const uint8_t *y,
-                                              const uint8_t *v,
-                                              const uint8_t *u,
-                                              int32_t y_stride,
-                                              int32_t v_stride,
-                                              int32_t u_stride)
+static ColorRowsKernel color_kernel(void)
 {
-    /* 1.1644  * 8192 */
-    const __m128i x_c0 = _mm_set1_epi16(0x2543);
-
-    /* 2.0184  * 8192 */
-    const __m128i x_c1 = _mm_set1_epi16(0x4097);
-    const int32_t ic1 = 0x4097;
-
-    /* abs( -0.3920 * 8192 ) */
-    const __m128i x_c4 = _mm_set1_epi16(0xc8b);
-    const int32_t ic4 = 0xc8b;
-
-    /* abs( -0.8132 * 8192 ) */
-    const __m128i x_c5 = _mm_set1_epi16(0x1a06);
-    const int32_t ic5 = 0x1a06;
-
-    /* 1.5966  * 8192 */
-    const __m128i x_c8 = _mm_set1_epi16(0x3317);
-    const int32_t ic8 = 0x3317;
-
-    /* -276.9856 * 32 */
-    const __m128i x_coff0 = _mm_set1_epi16(0xdd60);
-    const int32_t icoff0 = (int32_t)0xffffdd60;
-
-    /* 135.6352  * 32 */
-    const __m128i x_coff1 = _mm_set1_epi16(0x10f4);
-    const int32_t icoff1 = 0x10f4;
-
-    /* -222.9952 * 32 */
-    const __m128i x_coff2 = _mm_set1_epi16(0xe420);
-    const int32_t icoff2 = (int32_t)0xffffe420;
-
-    const __m128i x_zero = _mm_setzero_si128();
-    const __m128i x_aa = _mm_set1_epi8(0xff);
-
-    int32_t jH, iW;
-    int32_t iu, iv, ig, ir, ib, iTemp;
-    int32_t iu0, iu1, iv1, iv2;
-    __m128i x_u0, x_u1, x_v1, x_v2, x_temp, x_out, x_bak, x_temp1;
-    __m128i x_u, x_v, x_y1, x_y2, x_y3, x_y4;
-    __m128i x_r1, x_r2, x_r3, x_r4, x_g1, x_g2, x_g3, x_g4;
-    __m128i x_b1, x_b2, x_b3, x_b4, x_r, x_g, x_b;
-    __m128i x_ral, x_rah, x_bgl, x_bgh, x_bgrah, x_bgral;
-    __m128i *px_y1, *px_y2;
-    __m64 *pm_u, *pm_v;
-    uint8_t *pY1, *pY2, *pU, *pV, *pD1, *pD2, *pd1, *pd2;
-
-    __m128i (*load_si128) (const __m128i*);
-    if (((intptr_t)y % 16) != 0 || ((intptr_t)u % 16) != 0 || ((intptr_t)v % 16) != 0 || (y_stride % 16) != 0 || (u_stride % 16) != 0 || (v_stride % 16) != 0)
-        load_si128 = &inline_loadu_si128;
-    else
-        load_si128 = &inline_load_si128;
-
-    pY1 = (uint8_t*)y;
-    pY2 = (uint8_t*)y + y_stride;
-    pU = (uint8_t*)u;
-    pV = (uint8_t*)v;
-    pD1 = (uint8_t*)bgra;
-    pD2 = (uint8_t*)bgra + bgra_stride;
-
-    for (jH = 0; jH < (height >> 1); jH++) {
-        px_y1 = (__m128i*)pY1;
-        px_y2 = (__m128i*)pY2;
-        pm_u = (__m64*)pU;
-        pm_v = (__m64*)pV;
-        pd1 = pD1;
-        pd2 = pD2;
-        iW = 0;
-
-        /* 32 pixels */
-        for (; iW <= width - 16; iW += 16) {
-            x_temp = _mm_loadl_epi64((__m128i*)pm_u);
-            x_u = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_u++;
-            x_temp = _mm_loadl_epi64((__m128i*)pm_v);
-            x_v = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_v++;
-            x_temp = load_si128(px_y1);
-            px_y1++;
-            x_temp1 = load_si128(px_y2);
-            px_y2++;
-            x_out = _mm_unpacklo_epi16(x_temp, x_temp1);
-            x_y1 = _mm_unpacklo_epi8(x_zero, x_out);
-            x_y2 = _mm_unpackhi_epi8(x_zero, x_out);
-            x_out = _mm_unpackhi_epi16(x_temp, x_temp1);
-            x_y3 = _mm_unpacklo_epi8(x_zero, x_out);
-            x_y4 = _mm_unpackhi_epi8(x_zero, x_out);
-
-            /* pre calc x_[r/g/b][12] */
-            x_u0 = _mm_mulhi_epu16(x_u, x_c1);
-            x_b = _mm_add_epi16(x_u0, x_coff0);
-
-            x_u1 = _mm_mulhi_epu16(x_u, x_c4);
-            x_v1 = _mm_mulhi_epu16(x_v, x_c5);
-            x_temp = _mm_add_epi16(x_u1, x_v1);
-            x_g = _mm_sub_epi16(x_coff1, x_temp);
-
-            x_v2 = _mm_mulhi_epu16(x_v, x_c8);
-            x_r = _mm_add_epi16(x_v2, x_coff2);
-
-            x_y1 = _mm_mulhi_epu16(x_y1, x_c0);
-            x_y2 = _mm_mulhi_epu16(x_y2, x_c0);
-            x_y3 = _mm_mulhi_epu16(x_y3, x_c0);
-            x_y4 = _mm_mulhi_epu16(x_y4, x_c0);
-
-            /* x_b[1/2/3/4] */
-            x_bak = _mm_unpacklo_epi16(x_b, x_b);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_b1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_b2 = _mm_add_epi16(x_y2, x_temp);
-
-            x_bak = _mm_unpackhi_epi16(x_b, x_b);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_b3 = _mm_add_epi16(x_y3, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_b4 = _mm_add_epi16(x_y4, x_temp);
-
-            /* x_g[1/2/3/4] */
-            x_bak = _mm_unpacklo_epi16(x_g, x_g);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_g1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_g2 = _mm_add_epi16(x_y2, x_temp);
-
-            x_bak = _mm_unpackhi_epi16(x_g, x_g);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_g3 = _mm_add_epi16(x_y3, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_g4 = _mm_add_epi16(x_y4, x_temp);
-
-            /* x_r[1/2/3/4] */
-            x_bak = _mm_unpacklo_epi16(x_r, x_r);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_r1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_r2 = _mm_add_epi16(x_y2, x_temp);
-
-            x_bak = _mm_unpackhi_epi16(x_r, x_r);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_r3 = _mm_add_epi16(x_y3, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_r4 = _mm_add_epi16(x_y4, x_temp);
-
-            x_b1 = _mm_srai_epi16(x_b1, 5);
-            x_b2 = _mm_srai_epi16(x_b2, 5);
-            x_b3 = _mm_srai_epi16(x_b3, 5);
-            x_b4 = _mm_srai_epi16(x_b4, 5);
-            x_g1 = _mm_srai_epi16(x_g1, 5);
-            x_g2 = _mm_srai_epi16(x_g2, 5);
-            x_g3 = _mm_srai_epi16(x_g3, 5);
-            x_g4 = _mm_srai_epi16(x_g4, 5);
-            x_r1 = _mm_srai_epi16(x_r1, 5);
-            x_r2 = _mm_srai_epi16(x_r2, 5);
-            x_r3 = _mm_srai_epi16(x_r3, 5);
-            x_r4 = _mm_srai_epi16(x_r4, 5);
-
-            /* pack: 16=>8 */
-            x_b = _mm_packus_epi16(x_b1, x_b2);
-            x_b1 = _mm_packus_epi16(x_b3, x_b4);
-            x_r = _mm_packus_epi16(x_r1, x_r2);
-            x_r1 = _mm_packus_epi16(x_r3, x_r4);
-            x_g = _mm_packus_epi16(x_g1, x_g2);
-            x_g1 = _mm_packus_epi16(x_g3, x_g4);
-
-            /* create bgra sequences */
-            x_bgl = _mm_unpacklo_epi8(x_b, x_g);
-            x_bgh = _mm_unpackhi_epi8(x_b, x_g);
-            x_ral = _mm_unpacklo_epi8(x_r, x_aa);
-            x_rah = _mm_unpackhi_epi8(x_r, x_aa);
-
-            x_bgral = _mm_unpacklo_epi16(x_bgl, x_ral);
-            x_bgrah = _mm_unpackhi_epi16(x_bgl, x_ral);
-            x_temp = _mm_unpacklo_epi64(x_bgral, x_bgrah);
-            x_temp1 = _mm_unpackhi_epi64(x_bgral, x_bgrah);
-            SAVE_BGRA1(x_temp, pd1);
-            SAVE_BGRA1(x_temp1, pd2);
-
-            x_bgral = _mm_unpacklo_epi16(x_bgh, x_rah);
-            x_bgrah = _mm_unpackhi_epi16(x_bgh, x_rah);
-            x_temp = _mm_unpacklo_epi64(x_bgral, x_bgrah);
-            x_temp1 = _mm_unpackhi_epi64(x_bgral, x_bgrah);
-            SAVE_BGRA1(x_temp, pd1);
-            SAVE_BGRA1(x_temp1, pd2);
-
-            /* create bgra sequences */
-            x_bgl = _mm_unpacklo_epi8(x_b1, x_g1);
-            x_bgh = _mm_unpackhi_epi8(x_b1, x_g1);
-            x_ral = _mm_unpacklo_epi8(x_r1, x_aa);
-            x_rah = _mm_unpackhi_epi8(x_r1, x_aa);
-
-            x_bgral = _mm_unpacklo_epi16(x_bgl, x_ral);
-            x_bgrah = _mm_unpackhi_epi16(x_bgl, x_ral);
-            x_temp = _mm_unpacklo_epi64(x_bgral, x_bgrah);
-            x_temp1 = _mm_unpackhi_epi64(x_bgral, x_bgrah);
-            SAVE_BGRA1(x_temp, pd1);
-            SAVE_BGRA1(x_temp1, pd2);
-
-            x_bgral = _mm_unpacklo_epi16(x_bgh, x_rah);
-            x_bgrah = _mm_unpackhi_epi16(x_bgh, x_rah);
-            x_temp = _mm_unpacklo_epi64(x_bgral, x_bgrah);
-            x_temp1 = _mm_unpackhi_epi64(x_bgral, x_bgrah);
-            SAVE_BGRA1(x_temp, pd1);
-            SAVE_BGRA1(x_temp1, pd2);
-        }
-        /* 16 pixels - 8 byte chroma alignment */
-        if (iW <= width - 8) {
-            iTemp = *((int32_t *)pm_u);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_u = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_u = (__m64 *) (((int32_t *)pm_u) + 1);
-
-            iTemp = *((int32_t *)pm_v);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_v = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_v = (__m64 *) (((int32_t *)pm_v) + 1);
-
-            x_temp = _mm_loadl_epi64(px_y1);
-            px_y1 = (__m128i *) (((__m64 *)px_y1) + 1);
-            x_temp1 = _mm_loadl_epi64(px_y2);
-            px_y2 = (__m128i *) (((__m64 *)px_y2) + 1);
-            x_out = _mm_unpacklo_epi16(x_temp, x_temp1);
-            x_y1 = _mm_unpacklo_epi8(x_zero, x_out);
-            x_y2 = _mm_unpackhi_epi8(x_zero, x_out);
-
-            /* pre calc x_[r/g/b][12] */
-            x_u0 = _mm_mulhi_epu16(x_u, x_c1);
-            x_b = _mm_add_epi16(x_u0, x_coff0);
-
-            x_u1 = _mm_mulhi_epu16(x_u, x_c4);
-            x_v1 = _mm_mulhi_epu16(x_v, x_c5);
-            x_temp = _mm_add_epi16(x_u1, x_v1);
-            x_g = _mm_sub_epi16(x_coff1, x_temp);
-
-            x_v2 = _mm_mulhi_epu16(x_v, x_c8);
-            x_r = _mm_add_epi16(x_v2, x_coff2);
-
-            x_y1 = _mm_mulhi_epu16(x_y1, x_c0);
-            x_y2 = _mm_mulhi_epu16(x_y2, x_c0);
-
-            /* x_b[1/2] */
-            x_bak = _mm_unpacklo_epi16(x_b, x_b);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_b1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_b2 = _mm_add_epi16(x_y2, x_temp);
-
-            /* x_g[1/2] */
-            x_bak = _mm_unpacklo_epi16(x_g, x_g);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_g1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_g2 = _mm_add_epi16(x_y2, x_temp);
-
-            /* x_r[1/2] */
-            x_bak = _mm_unpacklo_epi16(x_r, x_r);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_r1 = _mm_add_epi16(x_y1, x_temp);
-            x_temp = _mm_unpackhi_epi32(x_bak, x_bak);
-            x_r2 = _mm_add_epi16(x_y2, x_temp);
-
-            x_b1 = _mm_srai_epi16(x_b1, 5);
-            x_b2 = _mm_srai_epi16(x_b2, 5);
-            x_g1 = _mm_srai_epi16(x_g1, 5);
-            x_g2 = _mm_srai_epi16(x_g2, 5);
-            x_r1 = _mm_srai_epi16(x_r1, 5);
-            x_r2 = _mm_srai_epi16(x_r2, 5);
-
-            /* pack: 16=>8 */
-            x_b = _mm_packus_epi16(x_b1, x_b2);
-            x_r = _mm_packus_epi16(x_r1, x_r2);
-            x_g = _mm_packus_epi16(x_g1, x_g2);
-
-            /* create bgra sequences */
-            x_bgl = _mm_unpacklo_epi8(x_b, x_g);
-            x_bgh = _mm_unpackhi_epi8(x_b, x_g);
-            x_ral = _mm_unpacklo_epi8(x_r, x_aa);
-            x_rah = _mm_unpackhi_epi8(x_r, x_aa);
-
-            x_bgral = _mm_unpacklo_epi16(x_bgl, x_ral);
-            x_bgrah = _mm_unpackhi_epi16(x_bgl, x_ral);
-            x_temp = _mm_unpacklo_epi64(x_bgral, x_bgrah);
-            x_temp1 = _mm_unpackhi_epi64(x_bgral, x_bgrah);
-            SAVE_BGRA1(x_temp, pd1);
-            SAVE_BGRA1(x_temp1, pd2);
-
-            x_bgral = _mm_unpacklo_epi16(x_bgh, x_rah);
-            x_bgrah = _mm_unpackhi_epi16(x_bgh, x_rah);
-            x_temp = _mm_unpacklo_epi64(x_bgral, x_bgrah);
-            x_temp1 = _mm_unpackhi_epi64(x_bgral, x_bgrah);
-            SAVE_BGRA1(x_temp, pd1);
-            SAVE_BGRA1(x_temp1, pd2);
-
-            iW += 8;
-        }
+    switch (ColorConvert_GetLevel()) {
+#if ENABLE_SIMD_SSE2
+        case COLOR_CONVERT_SSE2:
+            return color_rows_sse2;
+#endif
+#if ENABLE_SIMD_AVX2
+        case COLOR_CONVERT_AVX2:
+            return color_rows_avx2;
+#endif
+        default:
+            return NULL;
+    }
+}
 
-        /* 8 pixels */
-        if (iW <= width - 4) {
-            iTemp = *((uint16_t *)pm_u);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_u = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_u = (__m64 *) (((uint16_t *)pm_u) + 1);
-            iTemp = *((uint16_t *)pm_v);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_v = _mm_unpacklo_epi8(x_zero, x_temp);
-            pm_v = (__m64 *) (((uint16_t *)pm_v) + 1);
-
-            iTemp = *((int32_t *)px_y1);
-            px_y1 = (__m128i *) (((int32_t *)px_y1) + 1);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            iTemp = *((int32_t *)px_y2);
-            px_y2 = (__m128i *) (((int32_t *)px_y2) + 1);
-            x_temp1 = _mm_cvtsi32_si128(iTemp);
-            x_out = _mm_unpacklo_epi16(x_temp, x_temp1);
-            x_y1 = _mm_unpacklo_epi8(x_zero, x_out);
-
-            /* pre calc x_[r/g/b][1] */
-            x_u0 = _mm_mulhi_epu16(x_u, x_c1);
-            x_b = _mm_add_epi16(x_u0, x_coff0);
-
-            x_u1 = _mm_mulhi_epu16(x_u, x_c4);
-            x_v1 = _mm_mulhi_epu16(x_v, x_c5);
-            x_temp = _mm_add_epi16(x_u1, x_v1);
-            x_g = _mm_sub_epi16(x_coff1, x_temp);
-
-            x_v2 = _mm_mulhi_epu16(x_v, x_c8);
-            x_r = _mm_add_epi16(x_v2, x_coff2);
-
-            x_y1 = _mm_mulhi_epu16(x_y1, x_c0);
-            x_y2 = _mm_mulhi_epu16(x_y2, x_c0);
-
-            /* x_b[1] */
-            x_bak = _mm_unpacklo_epi16(x_b, x_b);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_b1 = _mm_add_epi16(x_y1, x_temp);
-
-            /* x_g[1] */
-            x_bak = _mm_unpacklo_epi16(x_g, x_g);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_g1 = _mm_add_epi16(x_y1, x_temp);
-
-            /* x_r[1] */
-            x_bak = _mm_unpacklo_epi16(x_r, x_r);
-            x_temp = _mm_unpacklo_epi32(x_bak, x_bak);
-            x_r1 = _mm_add_epi16(x_y1, x_temp);
-
-            x_b1 = _mm_srai_epi16(x_b1, 5);
-            x_g1 = _mm_srai_epi16(x_g1, 5);
-            x_r1 = _mm_srai_epi16(x_r1, 5);
-
-            /* pack: 16=>8 */
-            x_b = _mm_packus_epi16(x_b1, x_zero);
-            x_r = _mm_packus_epi16(x_r1, x_zero);
-            x_g = _mm_packus_epi16(x_g1, x_zero);
-
-            /* create bgra sequences */
-            x_bgl = _mm_unpacklo_epi8(x_b, x_g);
-            x_ral = _mm_unpacklo_epi8(x_r, x_aa);
-
-            x_bgral = _mm_unpacklo_epi16(x_bgl, x_ral);
-            x_bgrah = _mm_unpackhi_epi16(x_bgl, x_ral);
-            x_temp = _mm_unpacklo_epi64(x_bgral, x_bgrah);
-            x_temp1 = _mm_unpackhi_epi64(x_bgral, x_bgrah);
-            SAVE_BGRA1(x_temp, pd1);
-            SAVE_BGRA1(x_temp1, pd2);
-
-            iW += 4;
-        }
+/*
+ * Converts a frame one chroma row at a time. rows_per_chroma is 2 for 4:2:0
+ * and 1 for 4:2:2; an odd last row of a 4:2:0 frame uses the last chroma row.
+ */
+static int color_convert(uint8_t *dst, int32_t dst_stride, int32_t width, int32_t height,
+                         const uint8_t *y, const uint8_t *v, const uint8_t *u, const uint8_t *a,
+                         int32_t y_stride, int32_t v_stride, int32_t u_stride, int32_t a_stride,
+                         int32_t rows_per_chroma, int32_t packed, int32_t bgra)
+{
+    ColorRowsKernel kernel = color_kernel();
+    ColorRows rows;
+    int32_t j, k;
 
-        /* 4 pixels */
-        if (iW <= width - 2) {
-            /* load y u v, and expand */
-            iu = *((uint8_t *)pm_u);
-            pm_u = (__m64 *) (((uint8_t *)pm_u) + 1);
-            iv = *((uint8_t *)pm_v);
-            pm_v = (__m64 *) (((uint8_t *)pm_v) + 1);
-
-            iTemp = (*((uint16_t *)px_y1)  & 0xffff) | (*((uint16_t *)px_y2)<<16);
-            x_temp = _mm_cvtsi32_si128(iTemp);
-            x_y1 = _mm_unpacklo_epi8(x_zero, x_temp);
-            px_y1 = (__m128i *) (((uint16_t *)px_y1) + 1);
-            px_y2 = (__m128i *) (((uint16_t *)px_y2) + 1);
-
-            /* pre-calc d[r/g/b][1] */
-            iu0 = (iu * ic1) >> 8;
-            ib = icoff0 + iu0;
-
-            iu1 = (iu * ic4) >> 8;
-            iv1 = (iv * ic5) >> 8;
-            iTemp = iu1 + iv1;
-            ig = icoff1 - iTemp;
-
-            iv2 = (iv * ic8) >> 8;
-            ir = iv2 + icoff2;
-
-            x_y1 = _mm_mulhi_epu16(x_y1, x_c0);
-
-            /* db1 */
-            x_temp = _mm_set1_epi16(ib);
-            x_b1 = _mm_add_epi16(x_y1, x_temp);
-
-            /* dg1 */
-            x_temp = _mm_set1_epi16(ig);
-            x_g1 = _mm_add_epi16(x_y1, x_temp);
-
-            /* dr1 */
-            x_temp = _mm_set1_epi16(ir);
-            x_r1 = _mm_add_epi16(x_y1, x_temp);
-
-            x_b1 = _mm_srai_epi16(x_b1, 5);
-            x_g1 = _mm_srai_epi16(x_g1, 5);
-            x_r1 = _mm_srai_epi16(x_r1, 5);
-
-            /* pack: 16=>8 */
-            x_b = _mm_packus_epi16(x_b1, x_zero);
-            x_r = _mm_packus_epi16(x_r1, x_zero);
-            x_g = _mm_packus_epi16(x_g1, x_zero);
-
-            /* create bgra sequences */
-            x_bgl = _mm_unpacklo_epi8(x_b, x_g);
-            x_ral = _mm_unpacklo_epi8(x_r, x_aa);
-
-            /* lower half of darl & dgbl */
-            x_bgral = _mm_unpacklo_epi16(x_bgl, x_ral);
-            _mm_storel_epi64((__m128i*)pd1, x_bgral);
-            _mm_storeh_epi64((__m128i*)pd2, x_bgral);
-
-            pd1 += 8;
-            pd2 += 8;
+    if (dst == NULL || y == NULL || u == NULL || v == NULL)
+        return 1;
+
+    if (width <= 0 || height <= 0)
+        return 1;
+
+    rows.width = width;
+    rows.packed = packed;
+    rows.bgra = bgra;
+
+    for (j = 0; j < height; j += rows_per_chroma) {
+        rows.rows = (height - j < rows_per_chroma) ? height - j : rows_per_chroma;
+        for (k = 0; k < rows.rows; k++) {
+            rows.dst[k] = dst + (intptr_t)(j + k) * dst_stride;
+            rows.y[k] = y + (intptr_t)(j + k) * y_stride;
+            rows.a[k] = a ? a + (intptr_t)(j + k) * a_stride : NULL;
         }
+        rows.u = u + (intptr_t)(j / rows_per_chroma) * u_stride;
+        rows.v = v + (intptr_t)(j / rows_per_chroma) * v_stride;
 
-        pY1 += (2 * y_stride);
-        pY2 += (2 * y_stride);
-        pU += u_stride;
-        pV += v_stride;
-        pD1 += (2 * bgra_stride);
-        pD2 += (2 * bgra_stride);
+        color_rows_c(&rows, kernel ? kernel(&rows) : 0);
     }
 
     return 0;
 }
-// --- End SSE2 YCbCr420p conversion functions
-
-#else // Generic C implementation
-
-// --- Begin C YCbCr420p conversion functions
-int ColorConvert_YCbCr420p_to_ARGB32(
-                               uint8_t *argb,
-                               int32_t argb_stride,
-                               int32_t width,
-                               int32_t height,
-                               const uint8_t *y,
-                               const uint8_t *v,
-                               const uint8_t *u,
-                               const uint8_t *a,
-                               int32_t y_stride,
-                               int32_t v_stride,
-                               int32_t u_stride,
-                               int32_t a_stride)
-{
-    return 1; // NOTE: Not implemented
-}
+// --- End dispatch
 
-int ColorConvert_YCbCr420p_to_ARGB32_no_alpha(
-                                     uint8_t *argb,
+// --- Begin YCbCr420p conversion functions
+int ColorConvert_YCbCr420p_to_ARGB32(uint8_t *argb,
                                      int32_t argb_stride,
                                      int32_t width,
                                      int32_t height,
                                      const uint8_t *y,
                                      const uint8_t *v,
                                      const uint8_t *u,
+                                     const uint8_t *a,
                                      int32_t y_stride,
                                      int32_t v_stride,
-                                     int32_t u_stride)
+                                     int32_t u_stride,
+                                     int32_t a_stride)
+{
+    if (a == NULL)
+        return 1;
+
+    return color_convert(argb, argb_stride, width, height, y, v, u, a,
+                         y_stride, v_stride, u_stride, a_stride, 2, 0, 0);
+}
+
+int ColorConvert_YCbCr420p_to_ARGB32_no_alpha(uint8_t *argb,
+                                              int32_t argb_stride,
+                                              int32_t width,
+                                              int32_t height,
+                                              const uint8_t *y,
+                                              const uint8_t *v,
+                                              const uint8_t *u,
+                                              int32_t y_stride,
+                                              int32_t v_stride,
+                                              int32_t u_stride)
 {
-    return 1; // NOTE: Not implemented
+    return color_convert(argb, argb_stride, width, height, y, v, u, NULL,
+                         y_stride, v_stride, u_stride, 0, 2, 0, 0);
 }
 
 int ColorConvert_YCbCr420p_to_BGRA32(uint8_t *bgra,
@@ -2400,105 +935,14 @@ int ColorConvert_YCbCr420p_to_BGRA32(uint8_t *bgra,
                                      int32_t u_stride,
                                      int32_t a_stride)
 {
-    int32_t i, j;
-    const uint8_t *say1, *say2, *sau, *sav, *sly1, *sly2, *slu, *slv;
-    uint8_t *da1, *dl1, *da2, *dl2;
-
-    int32_t BBi = 554;
-    int32_t RRi = 446;
-
-    uint8_t *const pClip = (uint8_t *const)color_tClip + 288 * 2;
-
-    if (bgra == NULL || y == NULL || u == NULL || v == NULL)
+    if (a == NULL)
         return 1;
 
-    if (width <= 0 || height <= 0)
-        return 1;
-
-    if ((width | height) & 1)
-        return 1;
-
-    sly1 = say1 = y;
-    sly2 = say2 = y + y_stride;
-    slu = sau = u;
-    slv = sav = v;
-    dl1 = da1 = bgra;
-    dl2 = da2 = bgra + bgra_stride;
-
-    // non aligned case
-
-    uint8_t *a_row1 = (uint8_t*)a;
-    uint8_t *a_row2 = (uint8_t*)(a + a_stride);
-
-    for (j = 0; j < (height >> 1); j++) {
-        uint8_t *a_col1 = a_row1;
-        uint8_t *a_col2 = a_row2;
-        for (i = 0; i < (width >> 1); i++) {
-            int32_t sf01, sf02, sf03, sf04, sf1, sf2, sfr,
-            sfg, sfb;
-
-            sf1 = sau[0];
-            sf2 = sav[0];
-
-            sf01 = say1[0];
-            sf03 = say1[1];
-            sf02 = say2[0];
-            sf04 = say2[1];
-
-            sfr = color_tRV[sf2] - RRi;
-            sfg = color_tGU[sf1] - color_tGV[sf2];
-            sfb = color_tBU[sf1] - BBi;
-
-            sf01 = color_tYY[sf01];
-            sf03 = color_tYY[sf03];
-            sf02 = color_tYY[sf02];
-            sf04 = color_tYY[sf04];
-
-            TCLAMP_U8(sf01 + sfr, da1[2]);
-            TCLAMP_U8(sf01 + sfg, da1[1]);
-            SCLAMP_U8(sf01 + sfb, da1[0]);
-            TCLAMP_U8(sf03 + sfr, da1[6]);
-            TCLAMP_U8(sf03 + sfg, da1[5]);
-            SCLAMP_U8(sf03 + sfb, da1[4]);
-            TCLAMP_U8(sf02 + sfr, da2[2]);
-            TCLAMP_U8(sf02 + sfg, da2[1]);
-            SCLAMP_U8(sf02 + sfb, da2[0]);
-            TCLAMP_U8(sf04 + sfr, da2[6]);
-            SCLAMP_U8(sf04 + sfg, da2[5]);
-            TCLAMP_U8(sf04 + sfb, da2[4]);
-
-            da1[3] = a_col1[0];
-            da1[7] = a_col1[1];
-            da2[3] = a_col2[0];
-            da2[7] = a_col2[1];
-
-            say1 += 2;
-            say2 += 2;
-            sau++;
-            sav++;
-            da1 += 8;
-            da2 += 8;
-
-            a_col1 += 2;
-            a_col2 += 2;
-        }
-
-        sly1 = say1 = ((uint8_t *)sly1 + 2 * y_stride);
-        sly2 = say2 = ((uint8_t *)sly2 + 2 * y_stride);
-        slu = sau = ((uint8_t *)slu + u_stride);
-        slv = sav = ((uint8_t *)slv + v_stride);
-        dl1 = da1 = ((uint8_t *)dl1 + 2 * bgra_stride);
-        dl2 = da2 = ((uint8_t *)dl2 + 2 * bgra_stride);
-
-        a_row1 += (a_stride << 1);
-        a_row2 += (a_stride << 1);
-    }
-
-    return 0;
+    return color_convert(bgra, bgra_stride, width, height, y, v, u, a,
+                         y_stride, v_stride, u_stride, a_stride, 2, 0, 1);
 }
 
-int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
-                                              uint8_t *bgra,
+int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(uint8_t *bgra,
                                               int32_t bgra_stride,
                                               int32_t width,
                                               int32_t height,
@@ -2509,94 +953,12 @@ int ColorConvert_YCbCr420p_to_BGRA32_no_alpha(
                                               int32_t v_stride,
                                               int32_t u_stride)
 {
-    int32_t i, j;
-    const uint8_t *say1, *say2, *sau, *sav, *sly1, *sly2, *slu, *slv;
-    uint8_t *da1, *dl1, *da2, *dl2;
-
-    int32_t BBi = 554;
-    int32_t RRi = 446;
-
-    uint8_t *const pClip = (uint8_t *const)color_tClip + 288 * 2;
-
-    if (bgra == NULL || y == NULL || u == NULL || v == NULL)
-        return 1;
-
-    if (width <= 0 || height <= 0)
-        return 1;
-
-    if ((width | height) & 1)
-        return 1;
-
-    sly1 = say1 = y;
-    sly2 = say2 = y + y_stride;
-    slu = sau = u;
-    slv = sav = v;
-    dl1 = da1 = bgra;
-    dl2 = da2 = bgra + bgra_stride;
-
-    // non aligned case
-
-    for (j = 0; j < (height >> 1); j++) {
-        for (i = 0; i < (width >> 1); i++) {
-            int32_t sf01, sf02, sf03, sf04, sf1, sf2, sfr,
-            sfg, sfb;
-
-            sf1 = sau[0];
-            sf2 = sav[0];
-
-            sf01 = say1[0];
-            sf03 = say1[1];
-            sf02 = say2[0];
-            sf04 = say2[1];
-
-            sfr = color_tRV[sf2] - RRi;
-            sfg = color_tGU[sf1] - color_tGV[sf2];
-            sfb = color_tBU[sf1] - BBi;
-
-            sf01 = color_tYY[sf01];
-            sf03 = color_tYY[sf03];
-            sf02 = color_tYY[sf02];
-            sf04 = color_tYY[sf04];
-
-            TCLAMP_U8(sf01 + sfr, da1[2]);
-            TCLAMP_U8(sf01 + sfg, da1[1]);
-            SCLAMP_U8(sf01 + sfb, da1[0]);
-            TCLAMP_U8(sf03 + sfr, da1[6]);
-            TCLAMP_U8(sf03 + sfg, da1[5]);
-            SCLAMP_U8(sf03 + sfb, da1[4]);
-            TCLAMP_U8(sf02 + sfr, da2[2]);
-            TCLAMP_U8(sf02 + sfg, da2[1]);
-            SCLAMP_U8(sf02 + sfb, da2[0]);
-            TCLAMP_U8(sf04 + sfr, da2[6]);
-            SCLAMP_U8(sf04 + sfg, da2[5]);
-            TCLAMP_U8(sf04 + sfb, da2[4]);
-
-            da1[3] = da1[7] = da2[3] = da2[7] = 0xff;
-
-            say1 += 2;
-            say2 += 2;
-            sau++;
-            sav++;
-            da1 += 8;
-            da2 += 8;
-        }
-
-        sly1 = say1 = ((uint8_t *)sly1 + 2 * y_stride);
-        sly2 = say2 = ((uint8_t *)sly2 + 2 * y_stride);
-        slu = sau = ((uint8_t *)slu + u_stride);
-        slv = sav = ((uint8_t *)slv + v_stride);
-        dl1 = da1 = ((uint8_t *)dl1 + 2 * bgra_stride);
-        dl2 = da2 = ((uint8_t *)dl2 + 2 * bgra_stride);
-    }
-
-    return 0;
+    return color_convert(bgra, bgra_stride, width, height, y, v, u, NULL,
+                         y_stride, v_stride, u_stride, 0, 2, 0, 1);
 }
-// --- End C YCbCr420p conversion functions
-#endif // ENABLE_SIMD_SSE2
 // --- End YCbCr420p conversion functions
 
 // --- Begin YCbCr422p conversion functions
-
 int ColorConvert_YCbCr422p_to_ARGB32_no_alpha(uint8_t *argb,
                                               int32_t argb_stride,
                                               int32_t width,
@@ -2607,7 +969,8 @@ int ColorConvert_YCbCr422p_to_ARGB32_no_alpha(uint8_t *argb,
                                               int32_t y_stride,
                                               int32_t uv_stride)
 {
-    return 1; // NOTE: Not implemented
+    return color_convert(argb, argb_stride, width, height, y, v, u, NULL,
+                         y_stride, uv_stride, uv_stride, 0, 1, 1, 0);
 }
 
 int ColorConvert_YCbCr422p_to_BGRA32_no_alpha(uint8_t *bgra,
@@ -2620,67 +983,7 @@ int ColorConvert_YCbCr422p_to_BGRA32_no_alpha(uint8_t *bgra,
                                               int32_t y_stride,
                                               int32_t uv_stride)
 {
-    int32_t i, j;
-    const uint8_t *say1, *sau, *sav, *sly1, *slu, *slv;
-    uint8_t *da1, *dl1;
-
-    int32_t BBi = 554;
-    int32_t RRi = 446;
-
-    uint8_t *const pClip = (uint8_t *const)color_tClip + 288 * 2;
-
-    if (bgra == NULL || y == NULL || u == NULL || v == NULL)
-        return 1;
-
-    if (width <= 0 || height <= 0)
-        return 1;
-
-    if (width & 1)
-        return 1;
-
-    sly1 = say1 = y;
-    slu = sau = u;
-    slv = sav = v;
-    dl1 = da1 = bgra;
-
-    for (j = 0; j < height; j++) {
-        for (i = 0; i < (width >> 1); i++) {
-            int32_t sf01, sf03, sf1, sf2, sfr, sfg, sfb;
-
-            sf1 = sau[0];
-            sf2 = sav[0];
-
-            sf01 = say1[0];
-            sf03 = say1[2];
-
-            sfr = color_tRV[sf2] - RRi;
-            sfg = color_tGU[sf1] - color_tGV[sf2];
-            sfb = color_tBU[sf1] - BBi;
-
-            sf01 = color_tYY[sf01];
-            sf03 = color_tYY[sf03];
-
-            TCLAMP_U8(sf01 + sfr, da1[2]);
-            TCLAMP_U8(sf01 + sfg, da1[1]);
-            SCLAMP_U8(sf01 + sfb, da1[0]);
-            TCLAMP_U8(sf03 + sfr, da1[6]);
-            TCLAMP_U8(sf03 + sfg, da1[5]);
-            SCLAMP_U8(sf03 + sfb, da1[4]);
-
-            da1[3] = da1[7] = 0xff;
-
-            say1 += 4;
-            sau += 4;
-            sav += 4;
-            da1 += 8;
-        }
-
-        sly1 = say1 = ((uint8_t *)sly1 + y_stride);
-        slu = sau = ((uint8_t *)slu + uv_stride);
-        slv = sav = ((uint8_t *)slv + uv_stride);
-        dl1 = da1 = ((uint8_t *)dl1 + bgra_stride);
-    }
-
-    return 0;
+    return color_convert(bgra, bgra_stride, width, height, y, v, u, NULL,
+                         y_stride, uv_stride, uv_stride, 0, 1, 1, 1);
 }
 // --- End YCbCr422p conversion functions
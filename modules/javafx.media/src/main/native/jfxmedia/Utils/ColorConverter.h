@@ -32,6 +32,20 @@
 extern "C" {
 #endif
 
+    // Instruction sets the converters can use. All of them produce the
+    // same pixels; the best one available is used unless overridden.
+    enum {
+        COLOR_CONVERT_C = 0,
+        COLOR_CONVERT_SSE2,
+        COLOR_CONVERT_AVX2
+    };
+
+    int ColorConvert_GetLevel(void);
+
+    // Returns the level in use, which stays unchanged if the requested one
+    // is not supported on this machine
+    int ColorConvert_SetLevel(int level);
+
     int ColorConvert_YCbCr420p_to_ARGB32(uint8_t *argb,
                                          int32_t argb_stride,
                                          int32_t width,
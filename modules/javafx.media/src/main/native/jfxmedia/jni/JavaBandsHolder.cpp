@@ -25,8 +25,14 @@
 
 #include "JavaBandsHolder.h"
 #include "JniUtils.h"
+#include <string.h>
 
 CJavaBandsHolder::CJavaBandsHolder()
+: m_jvm(NULL),
+  m_Bands(0),
+  m_Data(NULL),
+  m_Magnitudes(NULL),
+  m_Phases(NULL)
 {
 }
 
@@ -36,21 +42,14 @@ CJavaBandsHolder::~CJavaBandsHolder()
         CJavaEnvironment jenv(m_jvm);
         JNIEnv *pEnv = jenv.getEnvironment();
 
-        if (pEnv) {
-            if (m_Magnitudes) {
-                pEnv->DeleteGlobalRef(m_Magnitudes);
-                m_Magnitudes = NULL;
-            }
-
-            if (m_Phases) {
-                pEnv->DeleteGlobalRef(m_Phases);
-                m_Phases = NULL;
-            }
+        if (pEnv && m_Data) {
+            pEnv->DeleteGlobalRef(m_Data);
+            m_Data = NULL;
         }
     }
 }
 
-bool CJavaBandsHolder::Init(JNIEnv* env, int bands, jfloatArray magnitudes, jfloatArray phases)
+bool CJavaBandsHolder::Init(JNIEnv* env, int bands, jobject data)
 {
     env->GetJavaVM(&m_jvm);
     if (env->ExceptionCheck()) {
@@ -59,9 +58,16 @@ bool CJavaBandsHolder::Init(JNIEnv* env, int bands, jfloatArray magnitudes, jflo
         return false;
     }
 
+    float *values = (float*)env->GetDirectBufferAddress(data);
+    if (values == NULL || env->GetDirectBufferCapacity(data) < (jlong)(2 * bands * sizeof(float))) {
+        m_jvm = NULL;
+        return false;
+    }
+
     m_Bands = bands;
-    m_Magnitudes = (jfloatArray)env->NewGlobalRef(magnitudes);
-    m_Phases = (jfloatArray)env->NewGlobalRef(phases);
+    m_Data = env->NewGlobalRef(data);
+    m_Magnitudes = values;
+    m_Phases = values + bands;
 
     InitRef(this);
 
@@ -70,25 +76,10 @@ bool CJavaBandsHolder::Init(JNIEnv* env, int bands, jfloatArray magnitudes, jflo
 
 void CJavaBandsHolder::UpdateBands(int size, const float* magnitudes, const float* phases)
 {
-    if (m_Bands != size || m_jvm == NULL)
+    if (m_Bands != size || m_Data == NULL)
         return;
 
-    CJavaEnvironment jenv(m_jvm);
-    JNIEnv *pEnv = jenv.getEnvironment();
-    if (pEnv) {
-        // use local references due to threading issues
-        jfloatArray localMagnitudes = (jfloatArray)pEnv->NewLocalRef(m_Magnitudes);
-        jfloatArray localPhases = (jfloatArray)pEnv->NewLocalRef(m_Phases);
-
-        if (localMagnitudes && localPhases) {
-            pEnv->SetFloatArrayRegion(localMagnitudes, 0, size, magnitudes);
-            if (!jenv.clearException()) {
-                pEnv->SetFloatArrayRegion(localPhases, 0, size, phases);
-                jenv.clearException();
-            }
-        }
-
-        pEnv->DeleteLocalRef(localMagnitudes);
-        pEnv->DeleteLocalRef(localPhases);
-    }
+    // The buffer is kept alive by m_Data, Java reads it when the spectrum event arrives
+    memcpy(m_Magnitudes, magnitudes, size * sizeof(float));
+    memcpy(m_Phases, phases, size * sizeof(float));
 }
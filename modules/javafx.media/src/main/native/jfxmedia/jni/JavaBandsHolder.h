@@ -36,14 +36,15 @@ public:
     ~CJavaBandsHolder();
 
 public:
-    bool Init(JNIEnv* env, int bands, jfloatArray magnitudes, jfloatArray phases);
+    bool Init(JNIEnv* env, int bands, jobject data);
     void UpdateBands(int size, const float* magnitudes, const float* phases);
 
 private:
     JavaVM      *m_jvm;
     int         m_Bands;
-    jfloatArray m_Magnitudes;
-    jfloatArray m_Phases;
+    jobject     m_Data;       // direct buffer, magnitudes followed by phases
+    float       *m_Magnitudes;
+    float       *m_Phases;
 };
 
 #endif // _JAVA_SPECTRUM_UPDATER_H_
@@ -35,6 +35,7 @@ jfieldID  CJavaInputStreamCallbacks::m_BufferFID = 0;
 jmethodID CJavaInputStreamCallbacks::m_NeedBufferMID = 0;
 jmethodID CJavaInputStreamCallbacks::m_ReadNextBlockMID = 0;
 jmethodID CJavaInputStreamCallbacks::m_ReadBlockMID = 0;
+jmethodID CJavaInputStreamCallbacks::m_StartPrefetchMID = 0;
 jmethodID CJavaInputStreamCallbacks::m_IsSeekableMID = 0;
 jmethodID CJavaInputStreamCallbacks::m_IsRandomAccessMID = 0;
 jmethodID CJavaInputStreamCallbacks::m_SeekMID = 0;
@@ -114,6 +115,12 @@ bool CJavaInputStreamCallbacks::Init(JNIEnv *env, jobject jLocator)
             hasException = (javaEnv.reportException() || (NULL == m_ReadBlockMID));
         }
 
+        if (!hasException)
+        {
+            m_StartPrefetchMID = env->GetMethodID(klass, "startPrefetch", "(Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;I)Z");
+            hasException = (javaEnv.reportException() || (NULL == m_StartPrefetchMID));
+        }
+
         if (!hasException)
         {
             m_IsSeekableMID = env->GetMethodID(klass, "isSeekable", "()Z");
@@ -128,7 +135,7 @@ bool CJavaInputStreamCallbacks::Init(JNIEnv *env, jobject jLocator)
 
         if (!hasException)
         {
-            m_SeekMID = env->GetMethodID(klass, "seek", "(J)J");
+            m_SeekMID = env->GetMethodID(klass, "seekStream", "(J)J");
             hasException = (javaEnv.reportException() || (NULL == m_SeekMID));
         }
 
@@ -229,6 +236,34 @@ void CJavaInputStreamCallbacks::CopyBlock(void* destination, int size)
     }
  }
 
+bool CJavaInputStreamCallbacks::StartPrefetch(void* states, void* blocks, int blockSize, int depth)
+{
+    CJavaEnvironment javaEnv(m_jvm);
+    JNIEnv *pEnv = javaEnv.getEnvironment();
+    bool result = false;
+
+    if (pEnv) {
+        jobject connection = pEnv->NewLocalRef(m_ConnectionHolder);
+        if (connection) {
+            // The ring is owned by the native source and outlives the connection.
+            jobject jStates = pEnv->NewDirectByteBuffer(states, (jlong)depth * sizeof(jint));
+            jobject jBlocks = pEnv->NewDirectByteBuffer(blocks, (jlong)depth * blockSize);
+
+            if (jStates && jBlocks)
+                result = (pEnv->CallBooleanMethod(connection, m_StartPrefetchMID, jStates, jBlocks, (jint)blockSize) == JNI_TRUE);
+            javaEnv.clearException();
+
+            if (jStates)
+                pEnv->DeleteLocalRef(jStates);
+            if (jBlocks)
+                pEnv->DeleteLocalRef(jBlocks);
+            pEnv->DeleteLocalRef(connection);
+        }
+    }
+
+    return result;
+}
+
 bool CJavaInputStreamCallbacks::IsSeekable()
 {
     CJavaEnvironment javaEnv(m_jvm);
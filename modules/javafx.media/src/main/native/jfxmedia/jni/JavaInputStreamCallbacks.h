@@ -41,6 +41,7 @@ virtual ~CJavaInputStreamCallbacks();
     int  ReadNextBlock();
     int  ReadBlock(int64_t position, int size);
     void CopyBlock(void* destination, int size);
+    bool StartPrefetch(void* states, void* blocks, int blockSize, int depth);
     bool IsSeekable();
     bool IsRandomAccess();
     int64_t Seek(int64_t position);
@@ -55,6 +56,7 @@ private:
     static jmethodID m_NeedBufferMID;
     static jmethodID m_ReadNextBlockMID;
     static jmethodID m_ReadBlockMID;
+    static jmethodID m_StartPrefetchMID;
     static jmethodID m_IsSeekableMID;
     static jmethodID m_IsRandomAccessMID;
     static jmethodID m_SeekMID;
@@ -51,7 +51,7 @@ Java_com_sun_media_jfxmediaimpl_NativeAudioSpectrum_nativeSetEnabled(JNIEnv *env
 
 JNIEXPORT void JNICALL
 Java_com_sun_media_jfxmediaimpl_NativeAudioSpectrum_nativeSetBands(JNIEnv *env, jobject obj, jlong nativeRef,
-                                                                                jint bands, jfloatArray magnitudes, jfloatArray phases)
+                                                                                jint bands, jobject data)
 {
     CAudioSpectrum *pSpectrum = (CAudioSpectrum*)jlong_to_ptr(nativeRef);
     CJavaBandsHolder *pHolder = new (std::nothrow) CJavaBandsHolder();
@@ -59,7 +59,7 @@ Java_com_sun_media_jfxmediaimpl_NativeAudioSpectrum_nativeSetBands(JNIEnv *env,
         return;
     }
 
-    if (!pHolder->Init(env, bands, magnitudes, phases)) {
+    if (!pHolder->Init(env, bands, data)) {
         delete pHolder;
         pHolder = NULL;
     }
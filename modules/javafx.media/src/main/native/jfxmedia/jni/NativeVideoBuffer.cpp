@@ -28,6 +28,7 @@
 #include "com_sun_media_jfxmediaimpl_NativeVideoBuffer.h"
 
 #include <PipelineManagement/VideoFrame.h>
+#include <PipelineManagement/VideoFramePool.h>
 #include "JniUtils.h"
 
 /*
@@ -260,3 +261,28 @@ JNIEXPORT void JNICALL Java_com_sun_media_jfxmediaimpl_NativeVideoBuffer_nativeS
         frame->SetFrameDirty(true);
     }
 }
+
+/*
+ * Class:     com_sun_media_jfxmediaimpl_NativeVideoBuffer
+ * Method:    nativeGetFramePoolStatistics
+ * Signature: ([J)V
+ */
+JNIEXPORT void JNICALL Java_com_sun_media_jfxmediaimpl_NativeVideoBuffer_nativeGetFramePoolStatistics
+    (JNIEnv *env, jclass klass, jlongArray statistics)
+{
+    CVideoFramePool *pool = NULL;
+    CVideoFramePool::Statistics stats;
+
+    if (CVideoFramePool::GetInstance(&pool) != ERROR_NONE || env->GetArrayLength(statistics) < 3) {
+        return;
+    }
+
+    pool->GetStatistics(&stats);
+
+    jlong values[3] = {
+        (jlong)stats.framesConverted,
+        (jlong)stats.poolHits,
+        (jlong)stats.bytesAllocated
+    };
+    env->SetLongArrayRegion(statistics, 0, 3, values);
+}
@@ -1468,24 +1468,20 @@ gboolean CGstAudioPlaybackPipeline::BusCallback(GstBus* bus, GstMessage* msg, sB
                 if (!gst_structure_get_clock_time (pStr, "duration", &duration))
                     duration = GST_CLOCK_TIME_NONE;
 
-                size_t bandsNum = pPipeline->GetAudioSpectrum()->GetBands();
+                // Magnitudes followed by phases, see gst_spectrum_message_new()
+                const GValue *data_value = gst_structure_get_value(pStr, "bands-data");
+                GstBuffer *data = (data_value != NULL) ? gst_value_get_buffer(data_value) : NULL;
+                GstMapInfo info;
 
-                if (bandsNum > 0)
+                if (data != NULL && gst_buffer_map(data, &info, GST_MAP_READ))
                 {
-                    float *magnitudes = new float[bandsNum];
-                    float *phases = new float[bandsNum];
+                    int bandsNum = (int)(info.size / (2 * sizeof(float)));
+                    const float *magnitudes = (const float*)info.data;
 
-                    const GValue *magnitudes_value = gst_structure_get_value(pStr, "magnitude");
-                    const GValue *phases_value = gst_structure_get_value(pStr, "phase");
-                    for (int i=0; i < bandsNum; i++)
-                    {
-                        magnitudes[i] = g_value_get_float( gst_value_list_get_value (magnitudes_value, i));
-                        phases[i] = g_value_get_float( gst_value_list_get_value (phases_value, i));
-                    }
-                    pPipeline->GetAudioSpectrum()->UpdateBands((int)bandsNum, magnitudes, phases);
+                    if (bandsNum > 0)
+                        pPipeline->GetAudioSpectrum()->UpdateBands(bandsNum, magnitudes, magnitudes + bandsNum);
 
-                    delete [] magnitudes;
-                    delete [] phases;
+                    gst_buffer_unmap(data, &info);
                 }
 
                 if (!pPipeline->m_pEventDispatcher->SendAudioSpectrumEvent(GST_TIME_AS_SECONDS((double)timestamp),
@@ -213,6 +213,15 @@ uint32_t CGstPipelineFactory::CreateSourceElement(CLocator* locator, GstElement*
 
             if (isRandomAccess)
                 g_signal_connect (javaSource, "read-block", G_CALLBACK (SourceReadBlock), callbacks);
+            else if (hlsMode != 1 && pOptions->GetStreamPrefetchDepth() > 0)
+            {
+                // Sequential streams are read ahead on a Java thread into buffers pushed without copying.
+                g_signal_connect (javaSource, "start-prefetch", G_CALLBACK (SourceStartPrefetch), callbacks);
+                g_object_set (javaSource,
+                    "block-size", pOptions->GetStreamBlockSize(),
+                    "prefetch-depth", pOptions->GetStreamPrefetchDepth(),
+                    NULL);
+            }
 
             if (hlsMode == 1)
                 g_object_set (javaSource, "hls-mode", TRUE, NULL);
@@ -297,6 +306,11 @@ gint CGstPipelineFactory::SourceReadBlock(GstElement *src, guint64 position, gui
     return ((CStreamCallbacks*)data)->ReadBlock(position, size);
 }
 
+gboolean CGstPipelineFactory::SourceStartPrefetch(GstElement *src, gpointer states, gpointer blocks, gint block_size, gint depth, gpointer data)
+{
+    return ((CStreamCallbacks*)data)->StartPrefetch(states, blocks, block_size, depth);
+}
+
 void CGstPipelineFactory::SourceCopyBlock(GstElement *src, gpointer buffer, int size, gpointer data)
 {
     ((CStreamCallbacks*)data)->CopyBlock(buffer, size);
@@ -318,6 +332,7 @@ void CGstPipelineFactory::SourceCloseConnection(GstElement *src, gpointer data)
     callbacks->CloseConnection();
     g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceReadNextBlock), callbacks);
     g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceReadBlock), callbacks);
+    g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceStartPrefetch), callbacks);
     g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceCopyBlock), callbacks);
     g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceSeekData), callbacks);
     g_signal_handlers_disconnect_by_func (src, (void*)G_CALLBACK (SourceCloseConnection), callbacks);
@@ -30,6 +30,7 @@
 #include <Common/VSMemory.h>
 #include <Utils/LowLevelPerf.h>
 #include <Utils/ColorConverter.h>
+#include <PipelineManagement/VideoFramePool.h>
 
 static inline guint32 swap_uint32(guint32 x)
 {
@@ -42,34 +43,30 @@ static inline guint32 swap_uint32(guint32 x)
 
 static void free_aligned_buffer(gpointer ptr)
 {
-    if (ptr != NULL) {
-        g_free(ptr);
+    CVideoFramePool *pool = NULL;
+
+    if (ptr != NULL && CVideoFramePool::GetInstance(&pool) == ERROR_NONE) {
+        pool->Release(ptr);
     }
 }
 
 static GstBuffer *alloc_aligned_buffer(guint size)
 {
-    // allocate a new GstBuffer of the given size plus some for padding and alignment
-    guint8 *newData;
-    guint8 *alignedData;
-    guint alignedSize;
-
-    // allocate a buffer large enough to accommodate 16 byte alignment
-    alignedSize = size;
-    if (size <= (G_MAXUINT - 16)) {
-        size += 16;
-    } else {
+    // take a 16 byte aligned block from the frame pool, it goes back there
+    // when the converted frame is released
+    CVideoFramePool *pool = NULL;
+    void *alignedData;
+
+    if (CVideoFramePool::GetInstance(&pool) != ERROR_NONE) {
         return NULL;
     }
 
-    newData = (guint8*)g_try_malloc(size);
-    if (NULL == newData) {
+    alignedData = pool->Acquire(size);
+    if (NULL == alignedData) {
         return NULL;
     }
 
-    alignedData = (guint8*)(((intptr_t)newData + 15) & ~15);
-
-    return gst_buffer_new_wrapped_full((GstMemoryFlags)0, alignedData, alignedSize, 0, alignedSize, newData, free_aligned_buffer);
+    return gst_buffer_new_wrapped_full((GstMemoryFlags)0, alignedData, size, 0, size, alignedData, free_aligned_buffer);
 }
 
 GstCaps *create_RGB_caps(CVideoFrame::FrameType type, guint width, guint height, guint encodedWidth, guint encodedHeight, guint stride)
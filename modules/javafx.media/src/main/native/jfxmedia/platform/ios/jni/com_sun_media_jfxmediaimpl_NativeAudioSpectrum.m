@@ -49,10 +49,10 @@ extern "C" {
     /*
      * Class:     com_sun_media_jfxmediaimpl_NativeAudioSpectrum
      * Method:    nativeSetBands
-     * Signature: (JI[F[F)V
+     * Signature: (JILjava/nio/ByteBuffer;)V
      */
     JNIEXPORT void JNICALL Java_com_sun_media_jfxmediaimpl_NativeAudioSpectrum_nativeSetBands
-    (JNIEnv *env, jobject obj, jlong jl, jint ji, jfloatArray jfa1, jfloatArray jfa2);
+    (JNIEnv *env, jobject obj, jlong jl, jint ji, jobject jo);
 
     /*
      * Class:     com_sun_media_jfxmediaimpl_NativeAudioSpectrum
@@ -239,22 +239,20 @@ static gboolean PostMessageCallback(GstElement * element, GstMessage * message)
         if (!gst_structure_get_clock_time(pStr, "duration", &duration))
             duration = GST_CLOCK_TIME_NONE;
 
-        size_t bandsNum = pSpectrumUnit->GetBands();
+        // Magnitudes followed by phases, see gst_spectrum_message_new()
+        const GValue *data_value = gst_structure_get_value(pStr, "bands-data");
+        GstBuffer *data = (data_value != NULL) ? gst_value_get_buffer(data_value) : NULL;
+        GstMapInfo info;
 
-        if (bandsNum > 0) {
-            float *magnitudes = new float[bandsNum];
-            float *phases = new float[bandsNum];
+        if (data != NULL && gst_buffer_map(data, &info, GST_MAP_READ)) {
+            int bandsNum = (int) (info.size / (2 * sizeof(float)));
+            const float *magnitudes = (const float*) info.data;
 
-            const GValue *magnitudes_value = gst_structure_get_value(pStr, "magnitude");
-            const GValue *phases_value = gst_structure_get_value(pStr, "phase");
-            for (int i = 0; i < bandsNum; i++) {
-                magnitudes[i] = g_value_get_float(gst_value_list_get_value(magnitudes_value, i));
-                phases[i] = g_value_get_float(gst_value_list_get_value(phases_value, i));
+            if (bandsNum > 0) {
+                pSpectrumUnit->UpdateBands(bandsNum, magnitudes, magnitudes + bandsNum);
             }
-            pSpectrumUnit->UpdateBands((int) bandsNum, magnitudes, phases);
 
-            delete [] magnitudes;
-            delete [] phases;
+            gst_buffer_unmap(data, &info);
         }
     }
 
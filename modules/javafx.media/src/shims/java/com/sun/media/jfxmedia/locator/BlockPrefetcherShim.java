@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.media.jfxmedia.locator;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+public class BlockPrefetcherShim {
+
+    private final ConnectionHolder holder;
+    private final ByteBuffer states;
+    private final ByteBuffer blocks;
+    private final int blockSize;
+
+    public BlockPrefetcherShim(File file, int slots, int blockSize) throws IOException {
+        holder = ConnectionHolder.createFileConnectionHolder(file.toURI());
+        states = ByteBuffer.allocateDirect(slots * Integer.BYTES).order(ByteOrder.nativeOrder());
+        blocks = ByteBuffer.allocateDirect(slots * blockSize);
+        this.blockSize = blockSize;
+    }
+
+    public boolean startPrefetch() {
+        return holder.startPrefetch(states, blocks, blockSize);
+    }
+
+    public int readNextBlock() throws IOException {
+        return holder.readNextBlock();
+    }
+
+    public int filledSlots() {
+        int count = 0;
+        for (int i = 0; i < states.capacity(); i += Integer.BYTES) {
+            if (states.getInt(i) == BlockPrefetcher.SLOT_FILLED) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    public void close() {
+        holder.closeConnection();
+    }
+
+    public static int getDefaultDepth() {
+        return BlockPrefetcher.getDefaultDepth();
+    }
+}
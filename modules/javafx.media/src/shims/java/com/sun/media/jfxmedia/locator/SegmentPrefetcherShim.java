@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package com.sun.media.jfxmedia.locator;
+
+import java.io.IOException;
+import java.nio.channels.ReadableByteChannel;
+import java.util.List;
+
+public class SegmentPrefetcherShim {
+
+    private final SegmentPrefetcher prefetcher;
+
+    public SegmentPrefetcherShim(int depth) {
+        prefetcher = new SegmentPrefetcher(depth);
+    }
+
+    public void schedule(List<String> uris) {
+        prefetcher.schedule(uris);
+    }
+
+    public SegmentShim take(String uri) {
+        SegmentPrefetcher.Segment segment = prefetcher.take(uri);
+        return segment == null ? null : new SegmentShim(segment);
+    }
+
+    public void cancel() {
+        prefetcher.cancel();
+    }
+
+    public void close() {
+        prefetcher.close();
+    }
+
+    public static HLSStatistics getStatistics() {
+        return SegmentPrefetcher.getStatistics();
+    }
+
+    public static class SegmentShim {
+        private final SegmentPrefetcher.Segment segment;
+
+        private SegmentShim(SegmentPrefetcher.Segment segment) {
+            this.segment = segment;
+        }
+
+        public int awaitLength() throws IOException {
+            return segment.awaitLength();
+        }
+
+        public ReadableByteChannel openChannel() {
+            return segment.openChannel();
+        }
+
+        public void cancel() {
+            segment.cancel();
+        }
+    }
+}
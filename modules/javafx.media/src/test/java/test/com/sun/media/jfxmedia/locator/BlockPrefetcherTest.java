@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.media.jfxmedia.locator;
+
+import com.sun.media.jfxmedia.locator.BlockPrefetcherShim;
+import java.io.File;
+import java.io.IOException;
+import java.nio.file.Files;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+public class BlockPrefetcherTest {
+    private static final String PREFETCH_PROPERTY = "jfxmedia.prefetch";
+    private static final int SLOTS = 8;
+    private static final int BLOCK_SIZE = 1024;
+    private static final long TIMEOUT_MILLIS = 10000;
+
+    private File file;
+    private BlockPrefetcherShim prefetcher;
+
+    @Before
+    public void setUp() throws IOException {
+        file = File.createTempFile("prefetch", ".bin");
+        Files.write(file.toPath(), new byte[4 * SLOTS * BLOCK_SIZE]);
+    }
+
+    @After
+    public void tearDown() {
+        System.clearProperty(PREFETCH_PROPERTY);
+        if (prefetcher != null) {
+            prefetcher.close();
+        }
+        file.delete();
+    }
+
+    private void awaitFilledSlots(int expected) throws InterruptedException {
+        long deadline = System.currentTimeMillis() + TIMEOUT_MILLIS;
+        while (prefetcher.filledSlots() < expected) {
+            assertTrue("Timeout waiting for " + expected + " filled slots",
+                    System.currentTimeMillis() < deadline);
+            Thread.sleep(10);
+        }
+        // Give the reader a chance to go past the limit
+        Thread.sleep(200);
+        assertEquals(expected, prefetcher.filledSlots());
+    }
+
+    @Test
+    public void testDefaultDepth() {
+        assertEquals(8, BlockPrefetcherShim.getDefaultDepth());
+        System.setProperty(PREFETCH_PROPERTY, "2");
+        assertEquals(2, BlockPrefetcherShim.getDefaultDepth());
+        System.setProperty(PREFETCH_PROPERTY, "-1");
+        assertEquals(0, BlockPrefetcherShim.getDefaultDepth());
+    }
+
+    @Test
+    public void testDisabled() throws IOException {
+        System.setProperty(PREFETCH_PROPERTY, "0");
+        prefetcher = new BlockPrefetcherShim(file, SLOTS, BLOCK_SIZE);
+        assertFalse(prefetcher.startPrefetch());
+        assertEquals(0, prefetcher.filledSlots());
+    }
+
+    @Test
+    public void testDepthLimitsReadAhead() throws Exception {
+        System.setProperty(PREFETCH_PROPERTY, "3");
+        prefetcher = new BlockPrefetcherShim(file, SLOTS, BLOCK_SIZE);
+        assertTrue(prefetcher.startPrefetch());
+        awaitFilledSlots(3);
+
+        // A taken slot stays filled until native code frees it
+        assertEquals(BLOCK_SIZE, prefetcher.readNextBlock());
+        awaitFilledSlots(4);
+    }
+
+    @Test
+    public void testDepthLimitedToRing() throws Exception {
+        System.setProperty(PREFETCH_PROPERTY, "100");
+        prefetcher = new BlockPrefetcherShim(file, SLOTS, BLOCK_SIZE);
+        assertTrue(prefetcher.startPrefetch());
+        awaitFilledSlots(SLOTS);
+    }
+}
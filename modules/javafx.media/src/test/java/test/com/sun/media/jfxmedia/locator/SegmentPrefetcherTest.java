@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.media.jfxmedia.locator;
+
+import com.sun.media.jfxmedia.locator.SegmentPrefetcherShim;
+import com.sun.media.jfxmedia.locator.SegmentPrefetcherShim.SegmentShim;
+import java.io.ByteArrayOutputStream;
+import java.io.File;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.net.InetAddress;
+import java.net.ServerSocket;
+import java.net.Socket;
+import java.nio.ByteBuffer;
+import java.nio.channels.ClosedChannelException;
+import java.nio.channels.ReadableByteChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+
+public class SegmentPrefetcherTest {
+    private static final long TIMEOUT = 10;
+
+    private SegmentServer server;
+    private SegmentPrefetcherShim prefetcher;
+
+    @Before
+    public void setUp() throws IOException {
+        server = new SegmentServer();
+    }
+
+    @After
+    public void tearDown() throws IOException {
+        if (prefetcher != null) {
+            prefetcher.close();
+        }
+        server.close();
+    }
+
+    private static byte[] data(int size, int seed) {
+        byte[] data = new byte[size];
+        for (int i = 0; i < size; i++) {
+            data[i] = (byte) (i * 31 + seed);
+        }
+        return data;
+    }
+
+    private static byte[] readAll(SegmentShim segment) throws IOException {
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        ByteBuffer buffer = ByteBuffer.allocate(1000);
+        try (ReadableByteChannel channel = segment.openChannel()) {
+            while (channel.read(buffer) >= 0) {
+                buffer.flip();
+                out.write(buffer.array(), 0, buffer.limit());
+                buffer.clear();
+            }
+        }
+        return out.toByteArray();
+    }
+
+    @Test
+    public void testTakeWithoutPrefetch() throws IOException {
+        byte[] data = data(200_000, 1);
+        String a = server.add("a.ts", data);
+        String b = server.add("b.ts", data(100, 2));
+        prefetcher = new SegmentPrefetcherShim(0);
+
+        prefetcher.schedule(List.of(b));
+        SegmentShim segment = prefetcher.take(a);
+        assertEquals(data.length, segment.awaitLength());
+        assertArrayEquals(data, readAll(segment));
+        // Depth 0 fetches nothing ahead.
+        assertEquals(0, server.requests("b.ts"));
+    }
+
+    @Test
+    public void testPrefetchedSegmentsAreReused() throws IOException {
+        byte[][] data = { data(1000, 1), data(70_000, 2), data(5, 3) };
+        String[] uris = new String[data.length];
+        for (int i = 0; i < data.length; i++) {
+            uris[i] = server.add(i + ".ts", data[i]);
+        }
+        prefetcher = new SegmentPrefetcherShim(2);
+        long hits = SegmentPrefetcherShim.getStatistics().getPrefetchHits();
+
+        SegmentShim segment = prefetcher.take(uris[0]);
+        prefetcher.schedule(List.of(uris[1], uris[2]));
+        assertArrayEquals(data[0], readAll(segment));
+        for (int i = 1; i < data.length; i++) {
+            segment = prefetcher.take(uris[i]);
+            assertEquals(data[i].length, segment.awaitLength());
+            assertArrayEquals(data[i], readAll(segment));
+            assertEquals(1, server.requests(i + ".ts"));
+        }
+        assertEquals(hits + 2, SegmentPrefetcherShim.getStatistics().getPrefetchHits());
+    }
+
+    @Test
+    public void testFilePlaylist() throws IOException {
+        File dir = Files.createTempDirectory("hls").toFile();
+        try {
+            byte[][] data = { data(3000, 4), data(0, 5), data(100_000, 6) };
+            String[] uris = new String[data.length];
+            for (int i = 0; i < data.length; i++) {
+                File file = new File(dir, i + ".ts");
+                Files.write(file.toPath(), data[i]);
+                uris[i] = file.toURI().toString();
+            }
+            prefetcher = new SegmentPrefetcherShim(2);
+            prefetcher.schedule(List.of(uris));
+            for (int i = 0; i < data.length; i++) {
+                SegmentShim segment = prefetcher.take(uris[i]);
+                assertEquals(data[i].length, segment.awaitLength());
+                assertArrayEquals(data[i], readAll(segment));
+            }
+        } finally {
+            for (File file : dir.listFiles()) {
+                file.delete();
+            }
+            dir.delete();
+        }
+    }
+
+    @Test(timeout = 30000)
+    public void testSeekCancelsQueuedSegments() throws Exception {
+        String a = server.addStalled("a.ts", 1000, 10);
+        String b = server.addStalled("b.ts", 1000, 10);
+        String c = server.add("c.ts", data(10, 7));
+        prefetcher = new SegmentPrefetcherShim(2);
+
+        prefetcher.schedule(List.of(a, b));
+        assertTrue(server.awaitRequest("a.ts"));
+        assertTrue(server.awaitRequest("b.ts"));
+        SegmentShim segment = prefetcher.take(c);
+        assertTrue(server.awaitDisconnect("a.ts"));
+        assertTrue(server.awaitDisconnect("b.ts"));
+        assertArrayEquals(data(10, 7), readAll(segment));
+    }
+
+    @Test(timeout = 30000)
+    public void testCloseCancelsTakenSegment() throws Exception {
+        String a = server.addStalled("a.ts", 1000, 10);
+        prefetcher = new SegmentPrefetcherShim(1);
+
+        SegmentShim segment = prefetcher.take(a);
+        assertEquals(1000, segment.awaitLength());
+        prefetcher.close();
+        assertTrue(server.awaitDisconnect("a.ts"));
+        try {
+            readAll(segment);
+            fail("read from a closed prefetcher");
+        } catch (ClosedChannelException expected) {
+        }
+    }
+
+    @Test(timeout = 30000)
+    public void testShortBody() throws Exception {
+        String a = server.addTruncated("a.ts", 1000, 600);
+        prefetcher = new SegmentPrefetcherShim(0);
+
+        SegmentShim segment = prefetcher.take(a);
+        assertEquals(1000, segment.awaitLength());
+        try {
+            readAll(segment);
+            fail("short body not reported");
+        } catch (IOException expected) {
+            assertNotNull(expected.getMessage());
+        }
+    }
+
+    /**
+     * A minimal HTTP server. Every response closes its connection. A stalled
+     * segment sends the headers and part of the body, then waits for the
+     * client to disconnect. A truncated segment announces more data than it
+     * sends.
+     */
+    private static final class SegmentServer implements AutoCloseable {
+        private final ServerSocket socket;
+        private final Map<String, byte[]> bodies = new ConcurrentHashMap<>();
+        private final Map<String, Integer> lengths = new ConcurrentHashMap<>();
+        private final Map<String, Boolean> stalled = new ConcurrentHashMap<>();
+        private final Map<String, AtomicInteger> requests = new ConcurrentHashMap<>();
+        private final Map<String, CountDownLatch> requested = new ConcurrentHashMap<>();
+        private final Map<String, CountDownLatch> disconnected = new ConcurrentHashMap<>();
+
+        SegmentServer() throws IOException {
+            socket = new ServerSocket(0, 50, InetAddress.getLoopbackAddress());
+            Thread thread = new Thread(this::accept, "SegmentServer");
+            thread.setDaemon(true);
+            thread.start();
+        }
+
+        String add(String name, byte[] body) {
+            return add(name, body, body.length, false);
+        }
+
+        String addStalled(String name, int length, int sent) {
+            return add(name, data(sent, 0), length, true);
+        }
+
+        String addTruncated(String name, int length, int sent) {
+            return add(name, data(sent, 0), length, false);
+        }
+
+        private String add(String name, byte[] body, int length, boolean stall) {
+            bodies.put(name, body);
+            lengths.put(name, length);
+            stalled.put(name, stall);
+            requests.put(name, new AtomicInteger());
+            requested.put(name, new CountDownLatch(1));
+            disconnected.put(name, new CountDownLatch(1));
+            return "http://" + socket.getInetAddress().getHostAddress() + ":"
+                    + socket.getLocalPort() + "/" + name;
+        }
+
+        int requests(String name) {
+            return requests.get(name).get();
+        }
+
+        boolean awaitRequest(String name) throws InterruptedException {
+            return requested.get(name).await(TIMEOUT, TimeUnit.SECONDS);
+        }
+
+        boolean awaitDisconnect(String name) throws InterruptedException {
+            return disconnected.get(name).await(TIMEOUT, TimeUnit.SECONDS);
+        }
+
+        private void accept() {
+            while (!socket.isClosed()) {
+                try {
+                    Socket client = socket.accept();
+                    Thread thread = new Thread(() -> serve(client), "SegmentServer client");
+                    thread.setDaemon(true);
+                    thread.start();
+                } catch (IOException ex) {
+                    return;
+                }
+            }
+        }
+
+        private void serve(Socket client) {
+            String name = null;
+            try (client) {
+                InputStream in = client.getInputStream();
+                StringBuilder request = new StringBuilder();
+                int c;
+                while ((c = in.read()) >= 0) {
+                    request.append((char) c);
+                    if (request.toString().endsWith("\r\n\r\n")) {
+                        break;
+                    }
+                }
+                String path = request.toString().split(" ")[1];
+                name = path.substring(path.lastIndexOf('/') + 1);
+                byte[] body = bodies.get(name);
+                OutputStream out = client.getOutputStream();
+                if (body == null) {
+                    out.write("HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"
+                            .getBytes(StandardCharsets.US_ASCII));
+                    return;
+                }
+                requests.get(name).incrementAndGet();
+                requested.get(name).countDown();
+                out.write(("HTTP/1.1 200 OK\r\nContent-Type: video/MP2T\r\nContent-Length: "
+                        + lengths.get(name) + "\r\nConnection: close\r\n\r\n")
+                        .getBytes(StandardCharsets.US_ASCII));
+                out.write(body);
+                out.flush();
+                if (stalled.get(name)) {
+                    // Returns once the client has closed the connection.
+                    while (in.read() >= 0) {
+                    }
+                }
+            } catch (IOException ex) {
+                // client went away
+            } finally {
+                if (name != null && disconnected.containsKey(name)) {
+                    disconnected.get(name).countDown();
+                }
+            }
+        }
+
+        @Override
+        public void close() throws IOException {
+            socket.close();
+        }
+    }
+}
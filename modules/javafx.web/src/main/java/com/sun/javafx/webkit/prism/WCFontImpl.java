@@ -115,6 +115,23 @@ final class WCFontImpl extends WCFont {
         return new float[]{bb[0], -bb[3], bb[2], bb[3] - bb[1]};
     }
 
+    @Override public float[] getGlyphMetrics(int[] glyphs) {
+        FontResource fr = getFontStrike().getFontResource();
+        float size = font.getSize();
+        float[] bb = new float[4];
+        float[] metrics = new float[glyphs.length * GLYPH_METRICS_SIZE];
+        for (int i = 0; i < glyphs.length; i++) {
+            int j = i * GLYPH_METRICS_SIZE;
+            metrics[j] = fr.getAdvance(glyphs[i], size);
+            bb = fr.getGlyphBoundingBox(glyphs[i], size, bb);
+            metrics[j + 1] = bb[0];
+            metrics[j + 2] = -bb[3];
+            metrics[j + 3] = bb[2];
+            metrics[j + 4] = bb[3] - bb[1];
+        }
+        return metrics;
+    }
+
     @Override public float getXHeight() {
         return getFontStrike().getMetrics().getXHeight();
     }
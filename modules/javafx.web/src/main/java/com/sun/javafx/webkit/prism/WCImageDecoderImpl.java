@@ -41,6 +41,12 @@ import java.io.ByteArrayInputStream;
 import java.io.IOException;
 import java.io.InputStream;
 import java.util.Arrays;
+import java.util.concurrent.CancellationException;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.Future;
+import java.util.concurrent.LinkedBlockingQueue;
+import java.util.concurrent.ThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
 import javafx.concurrent.Service;
 import javafx.concurrent.Task;
 
@@ -48,7 +54,12 @@ final class WCImageDecoderImpl extends WCImageDecoder {
 
     private final static PlatformLogger log;
 
+    // Complete images are decoded here as soon as their last byte arrives,
+    // so that by the time WebKit asks for a frame it is usually ready.
+    private final static ThreadPoolExecutor decodeExecutor;
+
     private Service<ImageFrame[]> loader;
+    private Future<ImageFrame[]> decodeTask;
 
     private int imageWidth = 0;
     private int imageHeight = 0;
@@ -63,6 +74,16 @@ final class WCImageDecoderImpl extends WCImageDecoder {
 
     static {
         log = PlatformLogger.getLogger(WCImageDecoderImpl.class.getName());
+
+        int threads = Math.max(1, Math.min(4,
+                Runtime.getRuntime().availableProcessors() - 1));
+        decodeExecutor = new ThreadPoolExecutor(threads, threads,
+                10L, TimeUnit.SECONDS, new LinkedBlockingQueue<>(), r -> {
+                    Thread t = new Thread(r, "WebKit Image Decoder");
+                    t.setDaemon(true);
+                    return t;
+                });
+        decodeExecutor.allowCoreThreadTimeOut(true);
     }
 
     /*
@@ -77,6 +98,7 @@ final class WCImageDecoderImpl extends WCImageDecoder {
         }
 
         destroyLoader();
+        cancelDecoding();
         frames = null;
         images = null;
         framesDecoded = false;
@@ -93,6 +115,7 @@ final class WCImageDecoderImpl extends WCImageDecoder {
     @Override protected void addImageData(byte[] dataPortion) {
         if (dataPortion != null) {
             fullDataReceived = false;
+            cancelDecoding();
             if (data == null) {
                 data = Arrays.copyOf(dataPortion, dataPortion.length * 2);
                 dataSize = dataPortion.length;
@@ -104,8 +127,9 @@ final class WCImageDecoderImpl extends WCImageDecoder {
                 System.arraycopy(dataPortion, 0, data, dataSize, dataPortion.length);
                 dataSize = newDataSize;
             }
-            // Try to decode the partial data until we get image size.
-            if (!imageSizeAvilable()) {
+            // Try to get the image size from the partial data, falling
+            // back to decoding it for formats we can't read the header of.
+            if (!imageSizeAvilable() && !readImageHeader()) {
                 loadFrames();
             }
         } else if (data != null && !fullDataReceived) {
@@ -114,7 +138,154 @@ final class WCImageDecoderImpl extends WCImageDecoder {
                 resizeDataArray(dataSize);
             }
             fullDataReceived = true;
+            startDecoding();
+        }
+    }
+
+    private synchronized Future<ImageFrame[]> startDecoding() {
+        if (decodeTask == null) {
+            final byte[] bytes = data;
+            final int size = dataSize;
+            decodeTask = decodeExecutor.submit(() ->
+                    decodeFrames(new ByteArrayInputStream(bytes, 0, size)));
+        }
+        return decodeTask;
+    }
+
+    private synchronized void cancelDecoding() {
+        if (decodeTask != null) {
+            decodeTask.cancel(false);
+            decodeTask = null;
+        }
+    }
+
+    private static ImageFrame[] awaitDecoding(Future<ImageFrame[]> task) {
+        try {
+            return task.get();
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+        } catch (ExecutionException | CancellationException e) {
+            // consider image missing
+        }
+        return null;
+    }
+
+    /*
+     * Reads the image size straight from the header of the data received
+     * so far. Returns false if the format is not one of the common ones
+     * or the header is not complete yet.
+     */
+    private boolean readImageHeader() {
+        final byte[] d = data;
+        final int n = dataSize;
+        if (n >= 24 && (d[0] & 0xFF) == 0x89
+                && d[1] == 'P' && d[2] == 'N' && d[3] == 'G') {
+            // IHDR is always the first chunk
+            return setHeaderSize("png", readInt(d, 16, 4, true), readInt(d, 20, 4, true));
+        }
+        if (n >= 10 && d[0] == 'G' && d[1] == 'I' && d[2] == 'F') {
+            return setHeaderSize("gif", readInt(d, 6, 2, false), readInt(d, 8, 2, false));
+        }
+        if (n >= 26 && d[0] == 'B' && d[1] == 'M') {
+            if (readInt(d, 14, 4, false) == 12) {
+                // OS/2 BITMAPCOREHEADER
+                return setHeaderSize("bmp", readInt(d, 18, 2, false), readInt(d, 20, 2, false));
+            }
+            // height is negative for top-down bitmaps
+            return setHeaderSize("bmp", readInt(d, 18, 4, false), Math.abs(readInt(d, 22, 4, false)));
+        }
+        if (n >= 4 && (d[0] & 0xFF) == 0xFF && (d[1] & 0xFF) == 0xD8) {
+            int p = 2;
+            while (p + 4 <= n) {
+                if ((d[p] & 0xFF) != 0xFF) {
+                    return false;
+                }
+                int marker = d[p + 1] & 0xFF;
+                if (marker == 0xFF) {
+                    p++;
+                } else if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7)) {
+                    p += 2;
+                } else if (marker >= 0xC0 && marker <= 0xCF
+                        && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) {
+                    // start of frame
+                    return p + 9 <= n && setHeaderSize("jpg",
+                            readInt(d, p + 7, 2, true), readInt(d, p + 5, 2, true));
+                } else {
+                    p += 2 + readInt(d, p + 2, 2, true);
+                }
+            }
+        }
+        return false;
+    }
+
+    private boolean setHeaderSize(String extension, int width, int height) {
+        if (width <= 0 || height <= 0) {
+            return false;
         }
+        if (log.isLoggable(Level.FINE)) {
+            log.fine(String.format("%X Image size %dx%d from header",
+                    hashCode(), width, height));
+        }
+        imageWidth = Math.max(imageWidth, width);
+        imageHeight = Math.max(imageHeight, height);
+        fileNameExtension = extension;
+        return true;
+    }
+
+    private static int readInt(byte[] d, int offset, int length, boolean bigEndian) {
+        int value = 0;
+        for (int i = 0; i < length; i++) {
+            int b = d[offset + (bigEndian ? i : length - 1 - i)] & 0xFF;
+            value = (value << 8) | b;
+        }
+        return value;
+    }
+
+    /*
+     * Counts the frames of a complete GIF image by walking its blocks,
+     * which is much cheaper than decoding them. Returns 0 if the data
+     * can't be parsed.
+     */
+    private int countGIFFrames() {
+        final byte[] d = data;
+        final int n = dataSize;
+        if (n < 13) {
+            return 0;
+        }
+        int p = 13;
+        if ((d[10] & 0x80) != 0) {
+            p += 3 << ((d[10] & 7) + 1);
+        }
+        int count = 0;
+        while (p < n) {
+            switch (d[p++] & 0xFF) {
+                case 0x2C: // image descriptor
+                    if (p + 9 > n) {
+                        return count;
+                    }
+                    int flags = d[p + 8] & 0xFF;
+                    p += 9;
+                    if ((flags & 0x80) != 0) {
+                        p += 3 << ((flags & 7) + 1);
+                    }
+                    p++; // LZW minimum code size
+                    count++;
+                    break;
+                case 0x21: // extension
+                    p++; // label
+                    break;
+                case 0x3B: // trailer
+                    return count;
+                default:
+                    return 0;
+            }
+            // skip data sub-blocks
+            while (p < n && d[p] != 0) {
+                p += (d[p] & 0xFF) + 1;
+            }
+            p++;
+        }
+        return count;
     }
 
     private void destroyLoader() {
@@ -174,6 +345,10 @@ final class WCImageDecoderImpl extends WCImageDecoder {
     }
 
     private synchronized ImageFrame[] loadFrames(InputStream in) {
+        return decodeFrames(in);
+    }
+
+    private ImageFrame[] decodeFrames(InputStream in) {
         if (log.isLoggable(Level.FINE)) {
             log.fine(String.format("%X Decoding frames", hashCode()));
         }
@@ -257,20 +432,26 @@ final class WCImageDecoderImpl extends WCImageDecoder {
     }
 
     @Override protected int getFrameCount() {
-        // Initiate full decode to get frame count.
-        // NOTE: This method will be called just before
-        // rendering the given image, so there will not
-        // be any performance degrade while initiating a
-        // full decode.
         if (fullDataReceived) {
+            synchronized (this) {
+                // Only GIF images have more than one frame; count them
+                // without waiting for the background decode to finish.
+                if (!framesDecoded && decodeTask != null) {
+                    int count = "gif".equals(fileNameExtension) ? countGIFFrames() : 1;
+                    if (count > 0) {
+                        return count;
+                    }
+                }
+            }
             getImageFrame(0);
         }
         return frameCount;
     }
 
-    // Avoid redundant decoding by async decoder threads, currently we don't
+    // All full decodes go through decodeTask, so concurrent callers wait for
+    // the same decode rather than starting their own; currently we don't
     // support per frame decoding.
-    @Override protected synchronized WCImageFrame getFrame(int idx) {
+    @Override protected WCImageFrame getFrame(int idx) {
         ImageFrame frame = getImageFrame(idx);
         if (frame != null) {
             if (log.isLoggable(Level.FINE)) {
@@ -292,6 +473,10 @@ final class WCImageDecoderImpl extends WCImageDecoder {
     }
 
     @Override protected int getFrameDuration(int idx) {
+        if (fullDataReceived && !framesDecoded && getFrameCount() > 1) {
+            // frame delays of animated images come with the decoded frames
+            getImageFrame(idx);
+        }
         final ImageMetadata meta = getFrameMetadata(idx);
         int dur = (meta == null || meta.delayTime == null) ? 0 : meta.delayTime;
         // Many annoying ads try to animate too fast.
@@ -326,20 +511,75 @@ final class WCImageDecoderImpl extends WCImageDecoder {
         return getFrameMetadata(idx) != null && framesDecoded;
     }
 
-    private synchronized ImageFrame getImageFrame(int idx) {
-        if (!fullDataReceived) {
-            startLoader();
-        } else if (fullDataReceived && !framesDecoded) {
-            destroyLoader();
-            setFrames(loadFrames()); // re-decode frames if they have been destroyed
-            framesDecoded = true;
+    @Override protected WCImageFrame getFrame(int idx, int subsamplingLevel) {
+        if (subsamplingLevel <= 0 || !imageSizeAvilable() || getFrameCount() > 1) {
+            return getFrame(idx);
         }
+        final byte[] bytes;
+        final int size;
+        synchronized (this) {
+            if (!fullDataReceived) {
+                return getFrame(idx);
+            }
+            bytes = data;
+            size = dataSize;
+        }
+        // Subsampled frames are decoded straight at the reduced size and
+        // are not kept here; WebCore caches the resulting image.
+        int scale = 1 << subsamplingLevel;
+        int width = Math.max(1, (imageWidth + scale - 1) >> subsamplingLevel);
+        int height = Math.max(1, (imageHeight + scale - 1) >> subsamplingLevel);
+        try {
+            ImageFrame[] subsampled = ImageStorage.getInstance().loadAll(
+                    new ByteArrayInputStream(bytes, 0, size), null,
+                    width, height, false, 1.0f, true);
+            if (subsampled != null && subsampled.length > 0 && subsampled[0] != null) {
+                return new Frame(new WCImageImpl(subsampled[0]), fileNameExtension);
+            }
+        } catch (ImageStorageException e) {
+            // fall back to the full size frame
+        }
+        return getFrame(idx);
+    }
+
+    private ImageFrame getImageFrame(int idx) {
+        final Future<ImageFrame[]> task;
+        synchronized (this) {
+            if (!fullDataReceived) {
+                startLoader();
+                return frameAt(idx);
+            }
+            if (framesDecoded) {
+                return frameAt(idx);
+            }
+            // re-decode frames if they have been destroyed
+            task = startDecoding();
+        }
+        // Wait outside the lock so that metadata queries from other
+        // threads are not blocked by the decode.
+        ImageFrame[] decoded = awaitDecoding(task);
+        synchronized (this) {
+            if (!framesDecoded && decodeTask == task) {
+                destroyLoader();
+                setFrames(decoded);
+                framesDecoded = true;
+                decodeTask = null;
+            }
+            return frameAt(idx);
+        }
+    }
+
+    private synchronized ImageFrame frameAt(int idx) {
         return (idx >= 0) && (this.frames != null) && (this.frames.length > idx)
                 ? this.frames[idx]
                 : null;
     }
 
     private synchronized PrismImage getPrismImage(int idx, ImageFrame frame) {
+        if (this.frames == null || this.frames.length <= idx) {
+            // frames were destroyed while this one was being decoded
+            return new WCImageImpl(frame);
+        }
         if (this.images == null) {
             this.images = new PrismImage[this.frames.length];
         }
@@ -169,7 +169,7 @@ final class WCPathImpl extends WCPath<Path2D> {
                     new Object[] {getID(), rule, x, y});
         }
         final int savedRule = path.getWindingRule();
-        path.setWindingRule(rule);
+        path.setWindingRule(1 - rule); // convert webkit to prism
         final boolean res = path.contains((float)x, (float)y);
         path.setWindingRule(savedRule);
 
@@ -25,17 +25,45 @@
 
 package com.sun.webkit;
 
+import java.util.concurrent.ScheduledThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
+
 /**
  * The class reflects the native webkit module.
  */
 final class MainThread {
 
+    /**
+     * Delays the wake-ups of the native main thread run loop, which has
+     * timers of its own besides the shared WebCore timer (see Timer).
+     */
+    private static ScheduledThreadPoolExecutor runLoopTimer;
+
     private static void fwkScheduleDispatchFunctions() {
         Invoker.getInvoker().postOnEventThread(() -> {
             twkScheduleDispatchFunctions();
         });
     }
 
+    /**
+     * @param delay time to wait in nanoseconds
+     */
+    private static synchronized void fwkScheduleDispatchFunctionsAfter(long delay) {
+        if (delay <= 0) {
+            fwkScheduleDispatchFunctions();
+            return;
+        }
+        if (runLoopTimer == null) {
+            runLoopTimer = new ScheduledThreadPoolExecutor(1, r -> {
+                Thread t = new Thread(r, "WebKit-RunLoop-Timer");
+                t.setDaemon(true);
+                return t;
+            });
+        }
+        runLoopTimer.schedule(MainThread::fwkScheduleDispatchFunctions,
+                              delay, TimeUnit.NANOSECONDS);
+    }
+
     private static native void twkScheduleDispatchFunctions();
     static native void twkSetShutdown(boolean isShutdown);
 }
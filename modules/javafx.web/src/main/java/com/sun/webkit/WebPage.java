@@ -152,6 +152,11 @@ public final class WebPage {
                     "com.sun.webkit.useJIT", "true"));
             final boolean useDFGJIT = Boolean.valueOf(System.getProperty(
                     "com.sun.webkit.useDFGJIT", "false"));
+            // FTL tiers up from DFG, so it follows useDFGJIT unless set.
+            final boolean useFTLJIT = Boolean.valueOf(System.getProperty(
+                    "com.sun.webkit.useFTLJIT", String.valueOf(useDFGJIT)));
+            final boolean useWebAssembly = Boolean.valueOf(System.getProperty(
+                    "com.sun.webkit.useWebAssembly", "true"));
 
             // TODO: Enable CSS3D by default once it is stabilized.
             boolean useCSS3D = Boolean.valueOf(System.getProperty(
@@ -159,7 +164,7 @@ public final class WebPage {
             useCSS3D = useCSS3D && Platform.isSupported(ConditionalFeature.SCENE3D);
 
             // Initialize WTF, WebCore and JavaScriptCore.
-            twkInitWebCore(useJIT, useDFGJIT, useCSS3D);
+            twkInitWebCore(useJIT, useDFGJIT, useFTLJIT, useWebAssembly, useCSS3D);
 
             // Inform the native webkit code when either the JVM or the
             // JavaFX runtime is being shutdown
@@ -383,6 +388,21 @@ public final class WebPage {
             }
         }
 
+        if (paintLog.isLoggable(Level.FINE)) {
+            long[] stats = WCRenderQueue.getAndResetStatistics();
+            paintLog.fine("Render queue: {0} bytes queued, {1} buffers flushed, "
+                    + "{2} stalls, {3} buffers allocated",
+                    new Object[] {stats[WCRenderQueue.STAT_BYTES_QUEUED],
+                                  stats[WCRenderQueue.STAT_BUFFERS_FLUSHED],
+                                  stats[WCRenderQueue.STAT_STALLS],
+                                  stats[WCRenderQueue.STAT_BUFFERS_ALLOCATED]});
+            long[] fontStats = WCFont.getAndResetGlyphMetricsStatistics();
+            paintLog.fine("Glyph metrics: {0} hits, {1} misses, {2} upcalls",
+                    new Object[] {fontStats[WCFont.STAT_METRICS_HITS],
+                                  fontStats[WCFont.STAT_METRICS_MISSES],
+                                  fontStats[WCFont.STAT_METRICS_UPCALLS]});
+        }
+
         if (paintLog.isLoggable(Level.FINEST)) {
             paintLog.finest("Exiting, dirtyRects: {0}, currentFrame: {1}",
                     new Object[] {dirtyRects, currentFrame});
@@ -786,6 +806,7 @@ public final class WebPage {
                 gc.restoreState();
             }
         }
+        GraphicsDecoder.logAndResetHistogram();
         paintLog.finest("Exiting");
     }
 
@@ -2621,7 +2642,8 @@ public final class WebPage {
     // Native methods
     // *************************************************************************
 
-    private static native void twkInitWebCore(boolean useJIT, boolean useDFGJIT, boolean useCSS3D);
+    private static native void twkInitWebCore(boolean useJIT, boolean useDFGJIT, boolean useFTLJIT,
+                                              boolean useWebAssembly, boolean useCSS3D);
     private native long twkCreatePage(boolean editable);
     private native void twkInit(long pPage, boolean usePlugins, float devicePixelScale);
     private native void twkDestroyPage(long pPage);
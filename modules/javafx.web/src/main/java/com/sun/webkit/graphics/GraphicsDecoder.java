@@ -26,11 +26,15 @@
 package com.sun.webkit.graphics;
 
 import com.sun.javafx.logging.PlatformLogger;
+import com.sun.javafx.logging.PlatformLogger.Level;
 import com.sun.prism.paint.Color;
 
 import java.lang.annotation.Native;
+import java.lang.reflect.Field;
+import java.lang.reflect.Modifier;
 import java.nio.ByteBuffer;
 import java.nio.ByteOrder;
+import java.util.Arrays;
 
 public final class GraphicsDecoder  {
     @Native public final static int FILLRECT_FFFFI         = 0;
@@ -86,10 +90,26 @@ public final class GraphicsDecoder  {
     @Native public final static int SET_MITER_LIMIT        = 54;
     @Native public final static int SET_TEXT_MODE          = 55;
     @Native public final static int SET_PERSPECTIVE_TRANSFORM = 56;
+    @Native public final static int FILLRECT_FFFFC         = 57;
+    @Native public final static int SETFILLCOLOR_C         = 58;
+    @Native public final static int SETSTROKECOLOR_C       = 59;
+    @Native public final static int DRAWSTRING_GLYPHS      = 60;
+
+    private final static int OPCODE_COUNT = 61;
 
     private final static PlatformLogger log =
             PlatformLogger.getLogger(GraphicsDecoder.class.getName());
 
+    // When enabled at FINE level, the number of commands and the number of
+    // queue bytes are collected per opcode and logged after each paint.
+    private final static PlatformLogger histogramLog =
+            PlatformLogger.getLogger(GraphicsDecoder.class.getName() + ".histogram");
+
+    // The histogram is only updated and read on the event thread.
+    final static long[] opCounts = new long[OPCODE_COUNT];
+    final static long[] opBytes = new long[OPCODE_COUNT];
+    private static String[] opNames;
+
     static void decode(WCGraphicsManager gm, WCGraphicsContext gc, BufferData bdata) {
         if (gc == null || !gc.isValid()) {
             log.fine("GraphicsDecoder::decode : GC is " +
@@ -100,7 +120,9 @@ public final class GraphicsDecoder  {
 
         ByteBuffer buf = bdata.getBuffer();
         buf.order(ByteOrder.nativeOrder());
+        boolean histogram = histogramLog.isLoggable(Level.FINE);
         while (buf.remaining() > 0) {
+            int start = buf.position();
             int op = buf.getInt();
             switch(op) {
                 case FILLRECT_FFFF:
@@ -119,6 +141,14 @@ public final class GraphicsDecoder  {
                         buf.getFloat(),
                         getColor(buf));
                     break;
+                case FILLRECT_FFFFC:
+                    gc.fillRect(
+                        buf.getFloat(),
+                        buf.getFloat(),
+                        buf.getFloat(),
+                        buf.getFloat(),
+                        getPackedColor(buf));
+                    break;
                 case FILL_ROUNDED_RECT:
                     gc.fillRoundedRect(
                         // base rectangle
@@ -147,6 +177,9 @@ public final class GraphicsDecoder  {
                 case SETFILLCOLOR:
                     gc.setFillColor(getColor(buf));
                     break;
+                case SETFILLCOLOR_C:
+                    gc.setFillColor(getPackedColor(buf));
+                    break;
                 case SET_TEXT_MODE:
                     gc.setTextMode(getBoolean(buf), getBoolean(buf), getBoolean(buf));
                     break;
@@ -156,6 +189,9 @@ public final class GraphicsDecoder  {
                 case SETSTROKECOLOR:
                     gc.setStrokeColor(getColor(buf));
                     break;
+                case SETSTROKECOLOR_C:
+                    gc.setStrokeColor(getPackedColor(buf));
+                    break;
                 case SETSTROKEWIDTH:
                     gc.setStrokeWidth(buf.getFloat());
                     break;
@@ -310,6 +346,20 @@ public final class GraphicsDecoder  {
                         buf.getFloat(),
                         buf.getFloat());
                     break;
+                case DRAWSTRING_GLYPHS: {
+                    WCFont font = (WCFont) gm.getRef(buf.getInt());
+                    float x = buf.getFloat();
+                    float y = buf.getFloat();
+                    int n = buf.getInt();   // number of glyphs
+                    int[] glyphs = new int[n];
+                    buf.asIntBuffer().get(glyphs);
+                    buf.position(buf.position() + n*4);
+                    float[] advances = new float[n];
+                    buf.asFloatBuffer().get(advances);
+                    buf.position(buf.position() + n*4);
+                    gc.drawString(font, glyphs, advances, x, y);
+                    break;
+                }
                 case DRAWWIDGET:
                     gc.drawWidget((RenderTheme)(gm.getRef(buf.getInt())),
                         gm.getRef(buf.getInt()), buf.getInt(), buf.getInt());
@@ -392,9 +442,60 @@ public final class GraphicsDecoder  {
                     log.fine("ERROR. Unknown primitive found");
                     break;
             }
+            if (histogram && op >= 0 && op < OPCODE_COUNT) {
+                opCounts[op]++;
+                opBytes[op] += buf.position() - start;
+            }
         }
     }
 
+    /**
+     * Logs the opcode histogram collected since the previous call and
+     * resets it. Does nothing unless the histogram logger is enabled.
+     */
+    public static void logAndResetHistogram() {
+        if (!histogramLog.isLoggable(Level.FINE)) {
+            return;
+        }
+        if (opNames == null) {
+            opNames = new String[OPCODE_COUNT];
+            for (Field f : GraphicsDecoder.class.getDeclaredFields()) {
+                int m = f.getModifiers();
+                if (Modifier.isPublic(m) && Modifier.isStatic(m)
+                        && f.getType() == int.class) {
+                    try {
+                        int op = f.getInt(null);
+                        if (op >= 0 && op < OPCODE_COUNT) {
+                            opNames[op] = f.getName();
+                        }
+                    } catch (IllegalAccessException e) {
+                        // ignore, the opcode is logged by its number
+                    }
+                }
+            }
+        }
+        long totalCount = 0;
+        long totalBytes = 0;
+        StringBuilder sb = new StringBuilder();
+        for (int op = 0; op < OPCODE_COUNT; op++) {
+            if (opCounts[op] == 0) {
+                continue;
+            }
+            totalCount += opCounts[op];
+            totalBytes += opBytes[op];
+            sb.append("\n    ")
+              .append(opNames[op] != null ? opNames[op] : String.valueOf(op))
+              .append(": ").append(opCounts[op])
+              .append(" ops, ").append(opBytes[op]).append(" bytes");
+        }
+        if (totalCount > 0) {
+            histogramLog.fine("Decoded " + totalCount + " ops, "
+                    + totalBytes + " bytes" + sb);
+        }
+        Arrays.fill(opCounts, 0);
+        Arrays.fill(opBytes, 0);
+    }
+
 
     private static void drawPattern(
             WCGraphicsContext gc,
@@ -485,6 +586,15 @@ public final class GraphicsDecoder  {
                          buf.getFloat());
     }
 
+    // The color is packed as 8-bit RGBA components, see GraphicsContextJava.cpp.
+    private static Color getPackedColor(ByteBuffer buf) {
+        int rgba = buf.getInt();
+        return new Color(((rgba >>> 24) & 0xFF) / 255f,
+                         ((rgba >>> 16) & 0xFF) / 255f,
+                         ((rgba >>> 8) & 0xFF) / 255f,
+                         (rgba & 0xFF) / 255f);
+    }
+
     private static WCGradient getGradient(WCGraphicsContext gc, ByteBuffer buf) {
         WCPoint p1 = getPoint(buf);
         WCPoint p2 = getPoint(buf);
@@ -25,8 +25,19 @@
 
 package com.sun.webkit.graphics;
 
+import java.lang.annotation.Native;
+
 public abstract class WCFont extends Ref {
 
+    // Number of floats per glyph in the array returned by getGlyphMetrics()
+    @Native public final static int GLYPH_METRICS_SIZE = 5;
+
+    // Indices into the array filled by getAndResetGlyphMetricsStatistics()
+    @Native public final static int STAT_METRICS_HITS = 0;
+    @Native public final static int STAT_METRICS_MISSES = 1;
+    @Native public final static int STAT_METRICS_UPCALLS = 2;
+    @Native public final static int STAT_COUNT = 3;
+
     public abstract Object getPlatformFont();
 
     public abstract WCFont deriveFont(float size);
@@ -41,6 +52,34 @@ public abstract class WCFont extends Ref {
 
     public abstract float[] getGlyphBoundingBox(int glyph);
 
+    /**
+     * Returns the metrics of the given glyphs packed as
+     * {@code GLYPH_METRICS_SIZE} floats per glyph: the advance width
+     * followed by the bounding box as returned by getGlyphBoundingBox().
+     * NB: This method is called from native code!
+     */
+    public float[] getGlyphMetrics(int[] glyphs) {
+        float[] metrics = new float[glyphs.length * GLYPH_METRICS_SIZE];
+        for (int i = 0; i < glyphs.length; i++) {
+            int j = i * GLYPH_METRICS_SIZE;
+            metrics[j] = (float) getGlyphWidth(glyphs[i]);
+            System.arraycopy(getGlyphBoundingBox(glyphs[i]), 0, metrics, j + 1, 4);
+        }
+        return metrics;
+    }
+
+    /**
+     * Returns the native glyph metrics cache counters accumulated since
+     * the previous call, indexed by the {@code STAT_*} constants.
+     */
+    public static long[] getAndResetGlyphMetricsStatistics() {
+        long[] stats = new long[STAT_COUNT];
+        twkGetAndResetGlyphMetricsStatistics(stats);
+        return stats;
+    }
+
+    private static native void twkGetAndResetGlyphMetricsStatistics(long[] stats);
+
     /**
      * Returns a hash code value for the object.
      * NB: This method is called from native code!
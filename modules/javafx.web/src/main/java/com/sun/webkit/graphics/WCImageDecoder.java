@@ -54,6 +54,16 @@ public abstract class WCImageDecoder {
      */
     protected abstract WCImageFrame getFrame(int index);
 
+    /**
+     * Returns image frame at the specified index, downscaled by
+     * {@code 2^subsamplingLevel} in each dimension.
+     * @param index frame index
+     * @param subsamplingLevel subsampling level, 0 for the full size frame
+     */
+    protected WCImageFrame getFrame(int index, int subsamplingLevel) {
+        return getFrame(index);
+    }
+
     /**
      * Returns frame duration in ms
      * @param index frame index
@@ -25,10 +25,14 @@
 
 package com.sun.webkit.graphics;
 
+import com.sun.javafx.logging.PlatformLogger;
 import java.lang.annotation.Native;
 
 public abstract class WCPath<P> extends Ref {
 
+    private final static PlatformLogger log =
+            PlatformLogger.getLogger(WCPath.class.getName());
+
     /* The WindRule should be compliant with
      * WebCore/platform/graphics/Path.h
      */
@@ -53,6 +57,19 @@ public abstract class WCPath<P> extends Ref {
      */
     @Native public static final int RULE_EVENODD = 1;
 
+    /* Segment types used by appendSegments(), followed by
+     * the number of coordinates each of them consumes.
+     */
+    @Native public static final int SEGMENT_MOVETO  = 0; // x, y
+    @Native public static final int SEGMENT_LINETO  = 1; // x, y
+    @Native public static final int SEGMENT_QUADTO  = 2; // x0, y0, x1, y1
+    @Native public static final int SEGMENT_CUBICTO = 3; // x0, y0, x1, y1, x2, y2
+    @Native public static final int SEGMENT_CLOSE   = 4; //
+    @Native public static final int SEGMENT_ARCTO   = 5; // x1, y1, x2, y2, r
+    @Native public static final int SEGMENT_ARC     = 6; // x, y, r, sa, ea, aclockwise
+    @Native public static final int SEGMENT_ELLIPSE = 7; // x, y, w, h
+    @Native public static final int SEGMENT_RECT    = 8; // x, y, w, h
+
     public abstract void addRect(double x, double y, double w, double h);
 
     public abstract void addEllipse(double x, double y, double w, double h);
@@ -98,6 +115,64 @@ public abstract class WCPath<P> extends Ref {
 
     public abstract WCPathIterator getPathIterator();
 
+    /**
+     * Appends a batch of segments recorded on the native side.
+     * A failure to append one segment does not prevent the following
+     * segments from being appended, the same as for individual calls.
+     */
+    public void appendSegments(int[] segments, int count, float[] coords) {
+        int ci = 0;
+        for (int i = 0; i < count; i++) {
+            int type = segments[i];
+            if (type < 0 || type >= SEGMENT_COORDS.length) {
+                throw new IllegalArgumentException("Unknown segment type: " + type);
+            }
+            try {
+                switch (type) {
+                    case SEGMENT_MOVETO:
+                        moveTo(coords[ci], coords[ci + 1]);
+                        break;
+                    case SEGMENT_LINETO:
+                        addLineTo(coords[ci], coords[ci + 1]);
+                        break;
+                    case SEGMENT_QUADTO:
+                        addQuadCurveTo(coords[ci], coords[ci + 1],
+                                       coords[ci + 2], coords[ci + 3]);
+                        break;
+                    case SEGMENT_CUBICTO:
+                        addBezierCurveTo(coords[ci], coords[ci + 1],
+                                         coords[ci + 2], coords[ci + 3],
+                                         coords[ci + 4], coords[ci + 5]);
+                        break;
+                    case SEGMENT_CLOSE:
+                        closeSubpath();
+                        break;
+                    case SEGMENT_ARCTO:
+                        addArcTo(coords[ci], coords[ci + 1],
+                                 coords[ci + 2], coords[ci + 3], coords[ci + 4]);
+                        break;
+                    case SEGMENT_ARC:
+                        addArc(coords[ci], coords[ci + 1], coords[ci + 2],
+                               coords[ci + 3], coords[ci + 4], coords[ci + 5] != 0);
+                        break;
+                    case SEGMENT_ELLIPSE:
+                        addEllipse(coords[ci], coords[ci + 1],
+                                   coords[ci + 2], coords[ci + 3]);
+                        break;
+                    case SEGMENT_RECT:
+                        addRect(coords[ci], coords[ci + 1],
+                                coords[ci + 2], coords[ci + 3]);
+                        break;
+                }
+            } catch (RuntimeException ex) {
+                log.warning("Failed to append path segment " + type, ex);
+            }
+            ci += SEGMENT_COORDS[type];
+        }
+    }
+
+    private static final int[] SEGMENT_COORDS = { 2, 2, 4, 6, 0, 5, 6, 4, 4 };
+
     public abstract boolean strokeContains(double x, double y,
                                            double thickness, double miterLimit,
                                            int cap, int join, double dashOffset,
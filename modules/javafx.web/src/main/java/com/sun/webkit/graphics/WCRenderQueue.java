@@ -40,6 +40,13 @@ public abstract class WCRenderQueue extends Ref {
             PlatformLogger.getLogger(WCRenderQueue.class.getName());
     @Native public final static int MAX_QUEUE_SIZE = 0x80000;
 
+    // Indices into the array filled by getAndResetStatistics()
+    @Native public final static int STAT_BYTES_QUEUED = 0;
+    @Native public final static int STAT_BUFFERS_FLUSHED = 1;
+    @Native public final static int STAT_STALLS = 2;
+    @Native public final static int STAT_BUFFERS_ALLOCATED = 3;
+    @Native public final static int STAT_COUNT = 4;
+
     private final LinkedList<BufferData> buffers = new LinkedList<>();
     private BufferData currentBuffer = new BufferData();
     private final WCRectangle clip;
@@ -73,7 +80,7 @@ public abstract class WCRenderQueue extends Ref {
         currentBuffer.setBuffer(buffer);
         buffers.addLast(currentBuffer);
         currentBuffer = new BufferData();
-        size += buffer.capacity();
+        size += buffer.limit();
         if (size > MAX_QUEUE_SIZE && gc!=null) {
             // It is isolated queue over the canvas image [image-gc!=null].
             // We need to flush the changes periodically
@@ -127,7 +134,11 @@ public abstract class WCRenderQueue extends Ref {
         flush();
     }
 
-    private void fwkAddBuffer(ByteBuffer buffer) {
+    private void fwkAddBuffer(ByteBuffer buffer, int length) {
+        // Native buffers are recycled once released, so the direct buffer
+        // may have been decoded before.
+        buffer.clear();
+        buffer.limit(length);
         addBuffer(buffer);
     }
 
@@ -163,6 +174,19 @@ public abstract class WCRenderQueue extends Ref {
 
     private native void twkRelease(Object[] bufs);
 
+    /**
+     * Returns the native rendering queue counters accumulated since the
+     * previous call, indexed by the {@code STAT_*} constants.
+     * Must be called on the Event thread.
+     */
+    public static long[] getAndResetStatistics() {
+        long[] stats = new long[STAT_COUNT];
+        twkGetAndResetStatistics(stats);
+        return stats;
+    }
+
+    private static native void twkGetAndResetStatistics(long[] stats);
+
     /*is called from native*/
     private int refString(String str) {
         return currentBuffer.addString(str);
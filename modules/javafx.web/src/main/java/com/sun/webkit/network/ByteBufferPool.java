@@ -29,6 +29,7 @@ import java.nio.ByteBuffer;
 import java.util.Queue;
 import java.util.concurrent.ConcurrentLinkedQueue;
 import java.util.concurrent.Semaphore;
+import java.util.concurrent.atomic.AtomicInteger;
 
 /**
  * A pool of byte buffers that can be shared by multiple concurrent
@@ -42,6 +43,18 @@ final class ByteBufferPool {
     private final Queue<ByteBuffer> byteBuffers =
             new ConcurrentLinkedQueue<>();
 
+    /**
+     * The maximum number of idle buffers kept in the pool. Buffers
+     * handed back in excess of this number are left to the garbage
+     * collector.
+     */
+    private static final int MAX_POOLED_COUNT = 64;
+
+    /**
+     * The number of idle buffers currently in the pool.
+     */
+    private final AtomicInteger pooledCount = new AtomicInteger();
+
     /**
      * The size of each byte buffer.
      */
@@ -74,6 +87,23 @@ final class ByteBufferPool {
         return new ByteBufferAllocatorImpl(maxBufferCount);
     }
 
+    private ByteBuffer poll() {
+        ByteBuffer byteBuffer = byteBuffers.poll();
+        if (byteBuffer != null) {
+            pooledCount.decrementAndGet();
+        }
+        return byteBuffer;
+    }
+
+    private void recycle(ByteBuffer byteBuffer) {
+        if (pooledCount.incrementAndGet() <= MAX_POOLED_COUNT) {
+            byteBuffer.clear();
+            byteBuffers.add(byteBuffer);
+        } else {
+            pooledCount.decrementAndGet();
+        }
+    }
+
     /**
      * The allocator implementation.
      */
@@ -100,7 +130,7 @@ final class ByteBufferPool {
         @Override
         public ByteBuffer allocate() throws InterruptedException {
             semaphore.acquire();
-            ByteBuffer byteBuffer = byteBuffers.poll();
+            ByteBuffer byteBuffer = poll();
             if (byteBuffer == null) {
                 byteBuffer = ByteBuffer.allocateDirect(bufferSize);
             }
@@ -112,10 +142,18 @@ final class ByteBufferPool {
          */
         @Override
         public void release(ByteBuffer byteBuffer) {
-            byteBuffer.clear();
-            byteBuffers.add(byteBuffer);
+            recycle(byteBuffer);
             semaphore.release();
         }
+
+        /**
+         * {@inheritDoc}
+         */
+        @Override
+        public Runnable detach(ByteBuffer byteBuffer) {
+            semaphore.release();
+            return () -> recycle(byteBuffer);
+        }
     }
 }
 
@@ -133,4 +171,12 @@ interface ByteBufferAllocator {
      * Releases a byte buffer.
      */
     void release(ByteBuffer byteBuffer);
+
+    /**
+     * Detaches a byte buffer from this allocator so that its contents
+     * can outlive the current read. The allocator slot is freed
+     * immediately; the returned action puts the buffer back into the
+     * pool and must be run once the contents are no longer referenced.
+     */
+    Runnable detach(ByteBuffer byteBuffer);
 }
@@ -527,15 +527,43 @@ final class HTTP2Loader extends URLLoaderBase {
     // another variant to use from createZIPEncodedBodySubscriber
     private void didReceiveData(final byte[] bytes, int size) {
         callBackIfNotCanceled(() -> {
-            notifyDidReceiveData(getDirectBuffer(size).put(bytes, 0, size).flip());
+            notifyDidReceiveData(bytes, 0, size);
         });
     }
 
     private void didReceiveData(final List<ByteBuffer> bytes) {
-        callBackIfNotCanceled(() -> bytes.stream()
-                                          .map(this::copyToDirectBuffer)
-                                          .forEach(this::notifyDidReceiveData)
-        );
+        callBackIfNotCanceled(() -> bytes.forEach(this::notifyDidReceiveBuffer));
+    }
+
+    // The buffers belong to the HttpClient and may be reused once onNext
+    // returns, so they are always copied. Direct and array backed buffers
+    // are read by the native side in place; anything else goes through
+    // the shared direct buffer.
+    private void notifyDidReceiveBuffer(ByteBuffer byteBuffer) {
+        if (byteBuffer.hasArray()) {
+            notifyDidReceiveData(byteBuffer.array(),
+                    byteBuffer.arrayOffset() + byteBuffer.position(),
+                    byteBuffer.remaining());
+        } else if (byteBuffer.isDirect()) {
+            notifyDidReceiveData(byteBuffer);
+        } else {
+            notifyDidReceiveData(copyToDirectBuffer(byteBuffer));
+        }
+    }
+
+    private void notifyDidReceiveData(byte[] bytes, int offset, int length) {
+        Invoker.getInvoker().checkEventThread();
+        if (logger.isLoggable(Level.FINEST)) {
+            logger.finest(String.format(
+                    "offset: [%s], "
+                    + "length: [%s], "
+                    + "data: [0x%016X]",
+                    offset,
+                    length,
+                    data));
+        }
+        twkDidReceiveDataArray(bytes, offset, length, data);
+        countCopied(length);
     }
 
     private void notifyDidReceiveData(ByteBuffer byteBuffer) {
@@ -552,6 +580,7 @@ final class HTTP2Loader extends URLLoaderBase {
                     data));
         }
         twkDidReceiveData(byteBuffer, byteBuffer.position(), byteBuffer.remaining(), data);
+        countCopied(byteBuffer.remaining());
     }
 
     private void didFinishLoading() {
@@ -563,6 +592,7 @@ final class HTTP2Loader extends URLLoaderBase {
         if (logger.isLoggable(Level.FINEST)) {
             logger.finest(String.format("data: [0x%016X]", data));
         }
+        logTransferStatistics(logger, url);
         twkDidFinishLoading(data);
     }
 
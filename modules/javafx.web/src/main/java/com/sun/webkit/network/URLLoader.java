@@ -737,15 +737,18 @@ final class URLLoader extends URLLoaderBase implements Runnable {
                 notifyDidReceiveData(
                         byteBuffer,
                         byteBuffer.position(),
-                        byteBuffer.remaining());
+                        byteBuffer.remaining(),
+                        allocator);
+            } else {
+                allocator.release(byteBuffer);
             }
-            allocator.release(byteBuffer);
         });
     }
 
     private void notifyDidReceiveData(ByteBuffer byteBuffer,
                                       int position,
-                                      int remaining)
+                                      int remaining,
+                                      ByteBufferAllocator allocator)
     {
         if (logger.isLoggable(Level.FINEST)) {
             logger.finest(String.format(
@@ -758,7 +761,21 @@ final class URLLoader extends URLLoaderBase implements Runnable {
                     remaining,
                     data));
         }
-        twkDidReceiveData(byteBuffer, position, remaining, data);
+        // Mostly full buffers are handed over to WebCore as they are;
+        // copying short tails is cheaper than pinning a whole buffer.
+        if (remaining >= byteBuffer.capacity() / 2) {
+            Runnable release = allocator.detach(byteBuffer);
+            if (twkDidReceiveOwnedData(byteBuffer, position, remaining,
+                                       release, data)) {
+                countAdopted(remaining);
+                return;
+            }
+            release.run();
+        } else {
+            twkDidReceiveData(byteBuffer, position, remaining, data);
+            allocator.release(byteBuffer);
+        }
+        countCopied(remaining);
     }
 
     private void didFinishLoading() {
@@ -773,6 +790,7 @@ final class URLLoader extends URLLoaderBase implements Runnable {
         if (logger.isLoggable(Level.FINEST)) {
             logger.finest(String.format("data: [0x%016X]", data));
         }
+        logTransferStatistics(logger, url);
         twkDidFinishLoading(data);
     }
 
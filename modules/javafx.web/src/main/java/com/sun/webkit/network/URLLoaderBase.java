@@ -25,6 +25,8 @@
 
 package com.sun.webkit.network;
 
+import com.sun.javafx.logging.PlatformLogger;
+import com.sun.javafx.logging.PlatformLogger.Level;
 import java.lang.annotation.Native;
 import java.nio.ByteBuffer;
 
@@ -36,6 +38,46 @@ abstract class URLLoaderBase {
      */
     protected abstract void fwkCancel();
 
+    // Body transfer counters, updated on the event thread only
+    private int chunkCount;
+    private long bytesCopied;
+    private long bytesAdopted;
+
+    /**
+     * Records a body chunk that the native side copied.
+     */
+    protected final void countCopied(int length) {
+        chunkCount++;
+        bytesCopied += length;
+    }
+
+    /**
+     * Records a body chunk whose buffer the native side adopted
+     * without copying.
+     */
+    protected final void countAdopted(int length) {
+        chunkCount++;
+        bytesAdopted += length;
+    }
+
+    /**
+     * Logs the body transfer counters of this loader at {@code FINE}.
+     */
+    protected final void logTransferStatistics(PlatformLogger logger,
+                                               String url)
+    {
+        if (logger.isLoggable(Level.FINE)) {
+            logger.fine(String.format(
+                    "url: [%s], chunks: [%d], bytes: [%d], "
+                    + "copied: [%d], adopted: [%d]",
+                    url,
+                    chunkCount,
+                    bytesCopied + bytesAdopted,
+                    bytesCopied,
+                    bytesAdopted));
+        }
+    }
+
     protected static native void twkDidSendData(long totalBytesSent,
                                               long totalBytesToBeSent,
                                               long data);
@@ -61,6 +103,23 @@ abstract class URLLoaderBase {
                                                  int remaining,
                                                  long data);
 
+    protected static native void twkDidReceiveDataArray(byte[] array,
+                                                      int offset,
+                                                      int length,
+                                                      long data);
+
+    /**
+     * Hands {@code byteBuffer} over to the native side, which keeps it
+     * alive for as long as WebCore references its contents and then runs
+     * {@code release}. Returns {@code false} if the native side copied
+     * the contents instead, in which case {@code release} is not run.
+     */
+    protected static native boolean twkDidReceiveOwnedData(ByteBuffer byteBuffer,
+                                                        int position,
+                                                        int remaining,
+                                                        Runnable release,
+                                                        long data);
+
     protected static native void twkDidFinishLoading(long data);
 
     protected static native void twkDidFail(int errorCode,
@@ -28,6 +28,7 @@
 #include <wtf/RunLoop.h>
 
 #include <wtf/DataLog.h>
+#include <wtf/MainThread.h>
 #include <wtf/NeverDestroyed.h>
 #include <wtf/ProcessID.h>
 
@@ -267,10 +268,57 @@ void RunLoop::wakeUpWithLock()
         m_wakeUpCallback();
 }
 
+#if PLATFORM(JAVA)
+// The main thread is the JavaFX event thread, which never calls run().
+// Expired timers and dispatched functions are processed when Java calls
+// dispatchFunctionsFromMainThread(), and Java is asked to call it again
+// once the earliest timer is due. Must be called without m_loopLock held,
+// the upcall into Java may block on the event queue.
+void RunLoop::scheduleMainThreadWakeUp()
+{
+    if (this != &RunLoop::main())
+        return;
+
+    Seconds delay;
+    {
+        Locker locker { m_loopLock };
+        if (m_schedules.isEmpty())
+            return;
+
+        MonotonicTime fireTime = m_schedules.first()->scheduledTimePoint();
+        if (fireTime >= m_scheduledWakeUpTime)
+            return;
+
+        m_scheduledWakeUpTime = fireTime;
+        delay = std::max(fireTime - MonotonicTime::now(), 0_s);
+    }
+    scheduleDispatchFunctionsOnMainThread(delay);
+}
+
+void RunLoop::dispatchFunctionsFromMainThread()
+{
+    ASSERT(this == &RunLoop::main());
+    {
+        Locker locker { m_loopLock };
+        if (m_scheduledWakeUpTime <= MonotonicTime::now())
+            m_scheduledWakeUpTime = MonotonicTime::infinity();
+    }
+
+    runImpl(RunMode::Iterate);
+
+    scheduleMainThreadWakeUp();
+}
+#endif
+
 void RunLoop::wakeUp()
 {
-    Locker locker { m_loopLock };
-    wakeUpWithLock();
+    {
+        Locker locker { m_loopLock };
+        wakeUpWithLock();
+    }
+#if PLATFORM(JAVA)
+    scheduleMainThreadWakeUp();
+#endif
 }
 
 RunLoop::CycleResult RunLoop::cycle(RunLoopMode)
@@ -311,11 +359,16 @@ RunLoop::TimerBase::~TimerBase()
 
 void RunLoop::TimerBase::start(Seconds interval, bool repeating)
 {
-    Locker locker { m_runLoop->m_loopLock };
-    stopWithLock();
-    m_scheduledTask->activate(interval, repeating);
-    m_runLoop->scheduleWithLock(m_scheduledTask.get());
-    m_runLoop->wakeUpWithLock();
+    {
+        Locker locker { m_runLoop->m_loopLock };
+        stopWithLock();
+        m_scheduledTask->activate(interval, repeating);
+        m_runLoop->scheduleWithLock(m_scheduledTask.get());
+        m_runLoop->wakeUpWithLock();
+    }
+#if PLATFORM(JAVA)
+    m_runLoop->scheduleMainThreadWakeUp();
+#endif
 }
 
 void RunLoop::TimerBase::stopWithLock()
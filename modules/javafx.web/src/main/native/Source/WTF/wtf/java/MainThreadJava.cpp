@@ -37,6 +37,7 @@
 namespace WTF {
 static JGClass jMainThreadCls;
 static jmethodID fwkScheduleDispatchFunctions;
+static jmethodID fwkScheduleDispatchFunctionsAfter;
 
 #if OS(UNIX)
 static pthread_t s_mainThread;
@@ -54,6 +55,17 @@ void scheduleDispatchFunctionsOnMainThread()
     }
 }
 
+void scheduleDispatchFunctionsOnMainThread(Seconds delay)
+{
+    AttachThreadAsNonDaemonToJavaEnv autoAttach;
+    JNIEnv* env = autoAttach.env();
+    if (env) {
+        env->CallStaticVoidMethod(jMainThreadCls, fwkScheduleDispatchFunctionsAfter,
+                                  (jlong)std::min(std::ceil(delay.nanoseconds()), 1e18));
+        WTF::CheckAndClearException(env);
+    }
+}
+
 void initializeMainThreadPlatform()
 {
     // Initialize the class reference and methodids for the MainThread. The
@@ -88,6 +100,13 @@ void initializeMainThreadPlatform()
 
     ASSERT(fwkScheduleDispatchFunctions);
 
+    fwkScheduleDispatchFunctionsAfter = env->GetStaticMethodID(
+            jMainThreadCls,
+            "fwkScheduleDispatchFunctionsAfter",
+            "(J)V");
+
+    ASSERT(fwkScheduleDispatchFunctionsAfter);
+
 #if OS(UNIX)
     s_mainThread = pthread_self();
 #elif OS(WINDOWS)
@@ -27,20 +27,68 @@
 
 #include "TextBreakIteratorInternalICU.h"
 
+#include <mutex>
+#include <unicode/uloc.h>
+#include <wtf/NeverDestroyed.h>
 #include <wtf/StdLibExtras.h>
+#include <wtf/java/JavaEnv.h>
 #include <wtf/text/WTFString.h>
 #include <wtf/text/CString.h>
 
 
 namespace WTF {
 
+static CString defaultJavaLocale()
+{
+    JNIEnv* env = jvm ? GetJavaEnv() : nullptr;
+    if (!env)
+        return "en";
+
+    JLClass localeClass(env->FindClass("java/util/Locale"));
+    CheckAndClearException(env);
+    if (!localeClass)
+        return "en";
+
+    jmethodID getDefaultMID = env->GetStaticMethodID(localeClass, "getDefault", "()Ljava/util/Locale;");
+    jmethodID toLanguageTagMID = env->GetMethodID(localeClass, "toLanguageTag", "()Ljava/lang/String;");
+    ASSERT(getDefaultMID && toLanguageTagMID);
+
+    JLObject locale(env->CallStaticObjectMethod(localeClass, getDefaultMID));
+    CheckAndClearException(env);
+    if (!locale)
+        return "en";
+
+    JLString tag(static_cast<jstring>(env->CallObjectMethod(locale, toLanguageTagMID)));
+    CheckAndClearException(env);
+    if (!tag)
+        return "en";
+
+    // ICU takes locale IDs ("zh_Hant_TW"), not BCP 47 tags ("zh-Hant-TW").
+    // Keywords from -u- extensions are dropped, since the search locale
+    // gets "@collation=search" appended to it.
+    String language(env, tag);
+    char localeID[ULOC_FULLNAME_CAPACITY];
+    UErrorCode status = U_ZERO_ERROR;
+    int32_t length = uloc_forLanguageTag(language.utf8().data(), localeID, sizeof(localeID), nullptr, &status);
+    if (U_FAILURE(status) || status == U_STRING_NOT_TERMINATED_WARNING)
+        return "en";
+    if (char* keywords = strchr(localeID, '@'))
+        length = keywords - localeID;
+    if (length <= 0)
+        return "en";
+    return CString(localeID, length);
+}
+
 static const char* UILanguage()
 {
-    // Chrome's UI language can be different from the OS UI language on Windows.
-    // We want to return Chrome's UI language here.
-    // DEPRECATED_DEFINE_STATIC_LOCAL(CString, locale, (WebCore::defaultLanguage().latin1()));
-    // FIXME-java: Get default language from Java using Locale.getDefault()
-    return "en";
+    // The break iterators themselves are ICU ones and never call into
+    // Java; only the default locale is taken from Java, once.
+    static LazyNeverDestroyed<CString> locale;
+    static std::once_flag onceKey;
+    std::call_once(onceKey, [] {
+        locale.construct(defaultJavaLocale());
+    });
+    return locale->data();
 }
 
 const char* currentSearchLocaleID()
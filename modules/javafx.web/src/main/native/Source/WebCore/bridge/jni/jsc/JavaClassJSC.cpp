@@ -135,6 +135,7 @@ JavaClass::~JavaClass()
         delete methodList;
     }
     m_methods.clear();
+    m_resolvedMethods.clear();
 }
 
 jobject JavaClass::createDummyObject()
@@ -165,8 +166,22 @@ Method* JavaClass::methodNamed(PropertyName propertyName, Instance*) const
     const String name(propertyName.publicName());
     if (name.isNull())
         return nullptr;
+
+    // Overload resolution only depends on the requested name and parameter
+    // list, so resolve each distinct method name once per class. Misses are
+    // not cached since scripts may probe arbitrary property names.
+    if (Method* method = m_resolvedMethods.get(name))
+        return method;
+
+    Method* method = resolveMethod(name);
+    if (method)
+        m_resolvedMethods.add(name, method);
+    return method;
+}
+
+Method* JavaClass::resolveMethod(const String& name) const
+{
     unsigned nameLength = name.length();
-    MethodList* methodList;
     size_t i;
     if (nameLength >= 3 && name[nameLength-1] == ')'
         && (i = name.find('(', 1)) != WTF::notFound) {
@@ -185,19 +200,14 @@ Method* JavaClass::methodNamed(PropertyName propertyName, Instance*) const
         size_t plen = pnames.size();
         MethodList* allMethods
             = m_methods.get(name.substringSharingImpl(0, i).impl());
-        methodList = nullptr;
         size_t numMethods = allMethods == nullptr ? 0 : allMethods->size();
         for (size_t methodIndex = 0; methodIndex < numMethods; methodIndex++) {
             JavaMethod* jMethod = static_cast<JavaMethod*>(allMethods->at(methodIndex));
             if (size_t(jMethod->numParameters()) == plen) {
                 // Iterate over parameters.
                 for (size_t i = 0;  ;  i++) {
-                    if (i == plen) {
-                        if (methodList == nullptr)
-                            methodList = new MethodList();
-                        methodList->append(jMethod);
-                        break;
-                    }
+                    if (i == plen)
+                        return jMethod;
                     String methodParam = jMethod->parameterAt(i);
                     size_t methodParamLength = methodParam.length();
                     String pname = pnames[i];
@@ -258,9 +268,9 @@ Method* JavaClass::methodNamed(PropertyName propertyName, Instance*) const
                 }
             }
         }
-    } else {
-        methodList = m_methods.get(name.impl());
+        return nullptr;
     }
+    MethodList* methodList = m_methods.get(name.impl());
     if (methodList)
         return methodList->at(0);
     return nullptr;
@@ -50,9 +50,11 @@ public:
 
 private:
     jobject createDummyObject();
+    Method* resolveMethod(const String&) const;
     const char* m_name;
     mutable FieldMap m_fields;
     mutable MethodListMap m_methods;
+    mutable HashMap<String, Method*> m_resolvedMethods;
 };
 
 } // namespace Bindings
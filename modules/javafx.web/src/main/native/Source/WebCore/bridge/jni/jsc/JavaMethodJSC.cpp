@@ -65,7 +65,11 @@ JavaMethod::JavaMethod(JNIEnv* env, jobject aMethod)
             jstring parameterName = static_cast<jstring>(callJNIMethod<jobject>(aParameter, "getName", "()Ljava/lang/String;"));
             if (!parameterName)
                 parameterName = env->NewStringUTF("<Unknown>");
-            m_parameters.append(JavaString(env, parameterName).impl());
+            String parameter = JavaString(env, parameterName).impl();
+            CString parameterClassName = parameter.utf8();
+            m_parameterTypes.append(javaTypeFromClassName(parameterClassName.data()));
+            m_parameterClassNames.append(WTFMove(parameterClassName));
+            m_parameters.append(WTFMove(parameter));
             env->DeleteLocalRef(aParameter);
             env->DeleteLocalRef(parameterName);
         }
@@ -74,6 +78,7 @@ JavaMethod::JavaMethod(JNIEnv* env, jobject aMethod)
 
     // Created lazily.
     m_signature = 0;
+    m_methodID = 0;
 
     jint modifiers = callJNIMethod<jint>(aMethod, "getModifiers", "()I");
     m_isStatic = (modifiers & 0x8) != 0;
@@ -111,14 +116,14 @@ const char* JavaMethod::signature() const
         StringBuilder signatureBuilder;
         signatureBuilder.append('(');
         for (unsigned int i = 0; i < m_parameters.size(); i++) {
-            CString javaClassName = parameterAt(i).utf8();
-            JavaType type = javaTypeFromClassName(javaClassName.data());
+            const char* javaClassName = parameterClassNameAt(i);
+            JavaType type = parameterTypeAt(i);
             if (type == JavaTypeArray)
-                appendClassName(signatureBuilder, javaClassName.data());
+                appendClassName(signatureBuilder, javaClassName);
             else {
                 signatureBuilder.append(signatureFromJavaType(type));
                 if (type == JavaTypeObject) {
-                    appendClassName(signatureBuilder, javaClassName.data());
+                    appendClassName(signatureBuilder, javaClassName);
                     signatureBuilder.append(';');
                 }
             }
@@ -143,4 +148,11 @@ const char* JavaMethod::signature() const
     return m_signature;
 }
 
+jmethodID JavaMethod::methodID(jobject obj) const
+{
+    if (!m_methodID)
+        m_methodID = getMethodID(obj, m_name.utf8(), signature());
+    return m_methodID;
+}
+
 #endif // ENABLE(JAVA_BRIDGE)
@@ -47,17 +47,26 @@ public:
     const String name() const { return m_name.impl(); }
     RuntimeType returnTypeClassName() const { return m_returnTypeClassName.utf8(); }
     const String parameterAt(int i) const { return m_parameters[i]; }
+    const char* parameterClassNameAt(int i) const { return m_parameterClassNames[i].data(); }
+    JavaType parameterTypeAt(int i) const { return m_parameterTypes[i]; }
     const char* signature() const;
     JavaType returnType() const { return m_returnType; }
     bool isStatic() const { return m_isStatic; }
 
+    // Resolved on the first call against an instance of the declaring class
+    // and reused afterwards, so hot JS->Java calls skip the JNI lookup.
+    jmethodID methodID(jobject obj) const;
+
     // Method implementation
     int numParameters() const { return m_parameters.size(); }
 
 private:
     Vector<WTF::String> m_parameters;
+    Vector<CString> m_parameterClassNames;
+    Vector<JavaType> m_parameterTypes;
     JavaString m_name;
     mutable char* m_signature;
+    mutable jmethodID m_methodID;
     JavaString m_returnTypeClassName;
     JavaType m_returnType;
     bool m_isStatic;
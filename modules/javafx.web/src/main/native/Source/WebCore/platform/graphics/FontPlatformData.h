@@ -52,6 +52,7 @@
 #endif
 
 #if PLATFORM(JAVA)
+#include "GlyphMetricsCacheJava.h"
 #include "PlatformJavaClasses.h"
 #include "RQRef.h"
 #endif
@@ -226,6 +227,7 @@ public:
 
 #if PLATFORM(JAVA)
     RefPtr<RQRef> nativeFontData() const { return m_jFont; }
+    GlyphMetricsCacheJava* glyphMetricsCache() const { return m_glyphMetricsCache.get(); }
 #endif
 
     unsigned hash() const;
@@ -313,6 +315,7 @@ private:
 
 #if PLATFORM(JAVA)
     RefPtr<RQRef> m_jFont;
+    RefPtr<GlyphMetricsCacheJava> m_glyphMetricsCache;
 #endif
 
     float m_size { 0 };
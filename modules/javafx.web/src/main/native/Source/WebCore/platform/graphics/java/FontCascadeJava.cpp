@@ -40,6 +40,23 @@ namespace WebCore {
 void FontCascade::drawGlyphs(GraphicsContext& context, const Font& font, const GlyphBufferGlyph* glyphs,
     const GlyphBufferAdvance* advances, unsigned numGlyphs, const FloatPoint& point, FontSmoothingMode)
 {
+    // Runs that fit into a single queue buffer are written inline, which
+    // avoids creating and registering two Java arrays per run.
+    size_t inlineSize = 20 + static_cast<size_t>(numGlyphs) * (sizeof(jint) + sizeof(jfloat));
+    if (inlineSize <= static_cast<size_t>(context.platformContext()->rq().capacity())) {
+        RenderingQueue& rq = context.platformContext()->rq().freeSpace(inlineSize);
+        rq  << (jint)com_sun_webkit_graphics_GraphicsDecoder_DRAWSTRING_GLYPHS
+            << font.platformData().nativeFontData()
+            << (jfloat)point.x()
+            << (jfloat)point.y()
+            << (jint)numGlyphs;
+        for (unsigned i = 0; i < numGlyphs; ++i)
+            rq << (jint)glyphs[i];
+        for (unsigned i = 0; i < numGlyphs; ++i)
+            rq << (jfloat)advances[i].width();
+        return;
+    }
+
     // we need to call freeSpace() before refIntArr() and refFloatArr(), see RT-19695.
     RenderingQueue& rq = context.platformContext()->rq().freeSpace(24);
 
@@ -60,6 +60,7 @@ RefPtr<RQRef> getJavaFont(const String& family, float size, bool italic, bool bo
 
 FontPlatformData::FontPlatformData(RefPtr<RQRef> font, float size)
     : m_jFont(font)
+    , m_glyphMetricsCache(GlyphMetricsCacheJava::create())
     , m_size(size)
 {
 }
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "config.h"
+#include "GlyphMetricsCacheJava.h"
+
+#include "PlatformJavaClasses.h"
+#include <wtf/HashSet.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/Vector.h>
+
+#include "com_sun_webkit_graphics_WCFont.h"
+
+namespace WebCore {
+
+/*static*/
+GlyphMetricsCacheJava::Statistics& GlyphMetricsCacheJava::statistics()
+{
+    static NeverDestroyed<Statistics> statistics;
+    return statistics;
+}
+
+void GlyphMetricsCacheJava::prefetch(RQRef& font, const Glyph* glyphs, unsigned count)
+{
+    Vector<Glyph> missing;
+    {
+        Locker locker { m_lock };
+        HashSet<unsigned, IntHash<unsigned>, WTF::UnsignedWithZeroKeyHashTraits<unsigned>> seen;
+        for (unsigned i = 0; i < count; ++i) {
+            Glyph glyph = glyphs[i];
+            if (glyph && !m_metrics.contains(glyph) && seen.add(glyph).isNewEntry)
+                missing.append(glyph);
+        }
+    }
+    if (!missing.isEmpty())
+        fetch(font, missing);
+}
+
+GlyphMetricsCacheJava::Metrics GlyphMetricsCacheJava::metricsForGlyph(RQRef& font, Glyph glyph)
+{
+    {
+        Locker locker { m_lock };
+        auto it = m_metrics.find(glyph);
+        if (it != m_metrics.end()) {
+            ++statistics().hits;
+            return it->value;
+        }
+    }
+
+    ++statistics().misses;
+    if (!fetch(font, Vector<Glyph> { glyph }))
+        return { };
+
+    Locker locker { m_lock };
+    return m_metrics.get(glyph);
+}
+
+bool GlyphMetricsCacheJava::fetch(RQRef& font, const Vector<Glyph>& glyphs)
+{
+    JNIEnv* env = WTF::GetJavaEnv();
+
+    JLocalRef<jintArray> jglyphs(env->NewIntArray(glyphs.size()));
+    WTF::CheckAndClearException(env); // OOME
+    if (!jglyphs)
+        return false;
+    env->SetIntArrayRegion(jglyphs, 0, glyphs.size(), glyphs.data());
+
+    static jmethodID mid = env->GetMethodID(PG_GetFontClass(env), "getGlyphMetrics", "([I)[F");
+    ASSERT(mid);
+    JLocalRef<jfloatArray> jmetrics(static_cast<jfloatArray>(env->CallObjectMethod(font, mid, (jintArray)jglyphs)));
+    WTF::CheckAndClearException(env);
+    ++statistics().upcalls;
+    if (!jmetrics)
+        return false;
+
+    constexpr unsigned metricsSize = com_sun_webkit_graphics_WCFont_GLYPH_METRICS_SIZE;
+    Vector<jfloat> values(glyphs.size() * metricsSize);
+    env->GetFloatArrayRegion(jmetrics, 0, values.size(), values.data());
+
+    Locker locker { m_lock };
+    for (size_t i = 0; i < glyphs.size(); ++i) {
+        const jfloat* v = values.data() + i * metricsSize;
+        m_metrics.set(glyphs[i], Metrics { v[0], FloatRect { v[1], v[2], v[3], v[4] } });
+    }
+    return true;
+}
+
+} // namespace WebCore
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_graphics_WCFont_twkGetAndResetGlyphMetricsStatistics
+    (JNIEnv* env, jclass, jlongArray stats)
+{
+    using namespace WebCore;
+
+    GlyphMetricsCacheJava::Statistics& statistics = GlyphMetricsCacheJava::statistics();
+    jlong values[com_sun_webkit_graphics_WCFont_STAT_COUNT];
+    values[com_sun_webkit_graphics_WCFont_STAT_METRICS_HITS] = statistics.hits.exchange(0);
+    values[com_sun_webkit_graphics_WCFont_STAT_METRICS_MISSES] = statistics.misses.exchange(0);
+    values[com_sun_webkit_graphics_WCFont_STAT_METRICS_UPCALLS] = statistics.upcalls.exchange(0);
+    env->SetLongArrayRegion(stats, 0, com_sun_webkit_graphics_WCFont_STAT_COUNT, values);
+}
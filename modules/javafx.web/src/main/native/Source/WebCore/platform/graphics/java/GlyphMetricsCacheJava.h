@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#pragma once
+
+#include "FloatRect.h"
+#include "Glyph.h"
+#include "RQRef.h"
+
+#include <atomic>
+#include <jni.h>
+#include <wtf/HashMap.h>
+#include <wtf/Lock.h>
+#include <wtf/ThreadSafeRefCounted.h>
+
+namespace WebCore {
+
+// Caches the advances and bounding boxes of the glyphs of one Java font.
+// The metrics of a whole glyph page are fetched with a single upcall when
+// the page is filled, so text layout does not call into Java per glyph.
+// The cache is held by FontPlatformData and shared by all the Font
+// objects created from it.
+class GlyphMetricsCacheJava : public ThreadSafeRefCounted<GlyphMetricsCacheJava> {
+public:
+    static Ref<GlyphMetricsCacheJava> create()
+    {
+        return adoptRef(*new GlyphMetricsCacheJava);
+    }
+
+    struct Metrics {
+        float width { 0 };
+        FloatRect bounds;
+    };
+
+    // Fetches the metrics of the non-zero glyphs that are not cached yet.
+    void prefetch(RQRef& font, const Glyph* glyphs, unsigned count);
+    Metrics metricsForGlyph(RQRef& font, Glyph);
+
+    struct Statistics {
+        std::atomic<uint64_t> hits { 0 };
+        std::atomic<uint64_t> misses { 0 };
+        std::atomic<uint64_t> upcalls { 0 };
+    };
+    static Statistics& statistics();
+
+private:
+    GlyphMetricsCacheJava() = default;
+
+    bool fetch(RQRef& font, const Vector<Glyph>& glyphs);
+
+    Lock m_lock;
+    HashMap<unsigned, Metrics, IntHash<unsigned>, WTF::UnsignedWithZeroKeyHashTraits<unsigned>> m_metrics WTF_GUARDED_BY_LOCK(m_lock);
+};
+
+} // namespace WebCore
@@ -81,6 +81,17 @@ bool GlyphPage::fill(UChar* buffer, unsigned bufferLength)
     }
     env->ReleasePrimitiveArrayCritical(jglyphs, glyphs, JNI_ABORT);
 
+    // Fetch the metrics of the whole page at once, so that measuring the
+    // text does not need an upcall per glyph.
+    if (haveGlyphs) {
+        if (auto* cache = this->font().platformData().glyphMetricsCache()) {
+            Vector<Glyph, GlyphPage::size> pageGlyphs;
+            for (unsigned i = 0; i < GlyphPage::size; i++)
+                pageGlyphs.append(glyphForIndex(i));
+            cache->prefetch(*jFont, pageGlyphs.data(), pageGlyphs.size());
+        }
+    }
+
     return haveGlyphs;
 }
 
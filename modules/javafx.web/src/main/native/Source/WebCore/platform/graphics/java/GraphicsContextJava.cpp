@@ -64,6 +64,18 @@
 
 namespace WebCore {
 
+// Colors that are stored as 8-bit sRGB are sent packed into a single int,
+// the same way DisplayListRecorder records inline colors.
+static std::optional<jint> packedColor(const Color& color)
+{
+    auto bytes = color.tryGetAsSRGBABytes();
+    if (!bytes)
+        return std::nullopt;
+    auto [r, g, b, a] = *bytes;
+    return static_cast<jint>((static_cast<uint32_t>(r) << 24) | (static_cast<uint32_t>(g) << 16)
+        | (static_cast<uint32_t>(b) << 8) | static_cast<uint32_t>(a));
+}
+
 static void setGradient(Gradient &gradient,
     const AffineTransform& gradientSpaceTransformation, PlatformGraphicsContext* context, jint id)
 {
@@ -93,6 +105,12 @@ static void setGradient(Gradient &gradient,
     p0 = gradientSpaceTransformation.mapPoint(p0);
     p1 = gradientSpaceTransformation.mapPoint(p1);
 
+    // The gradient replaces the paint on the Java side.
+    if (id == com_sun_webkit_graphics_GraphicsDecoder_SET_FILL_GRADIENT)
+        context->javaState().fillColor = std::nullopt;
+    else
+        context->javaState().strokeColor = std::nullopt;
+
     context->rq().freeSpace(4 * 11 + 20 * nStops)
     << id
     << (jfloat)p0.x()
@@ -163,6 +181,7 @@ void GraphicsContextJava::savePlatformState()
 
     platformContext()->rq().freeSpace(4)
     << (jint)com_sun_webkit_graphics_GraphicsDecoder_SAVESTATE;
+    platformContext()->saveJavaState();
 }
 
 void GraphicsContextJava::restore() {
@@ -177,6 +196,7 @@ void GraphicsContextJava::restorePlatformState()
 
     platformContext()->rq().freeSpace(4)
     << (jint)com_sun_webkit_graphics_GraphicsDecoder_RESTORESTATE;
+    platformContext()->restoreJavaState();
 }
 
 // Draws a filled rectangle with a stroked border.
@@ -230,6 +250,15 @@ void GraphicsContextJava::fillRect(const FloatRect& rect, const Color& color)
     if (paintingDisabled())
         return;
 
+    if (auto packed = packedColor(color)) {
+        platformContext()->rq().freeSpace(24)
+        << (jint)com_sun_webkit_graphics_GraphicsDecoder_FILLRECT_FFFFC
+        << rect.x() << rect.y()
+        << rect.width() << rect.height()
+        << *packed;
+        return;
+    }
+
     auto [r, g, b, a] = color.toColorTypeLossy<SRGBA<float>>().resolved();
     platformContext()->rq().freeSpace(36)
     << (jint)com_sun_webkit_graphics_GraphicsDecoder_FILLRECT_FFFFI
@@ -498,6 +527,16 @@ void GraphicsContextJava::setPlatformFillColor(const Color& color)
     if (paintingDisabled())
         return;
 
+    if (!PlatformContextJava::updateJavaState(platformContext()->javaState().fillColor, color))
+        return;
+
+    if (auto packed = packedColor(color)) {
+        platformContext()->rq().freeSpace(8)
+        << (jint)com_sun_webkit_graphics_GraphicsDecoder_SETFILLCOLOR_C
+        << *packed;
+        return;
+    }
+
     auto [r, g, b, a] = color.toColorTypeLossy<SRGBA<float>>().resolved();
     platformContext()->rq().freeSpace(20)
     << (jint)com_sun_webkit_graphics_GraphicsDecoder_SETFILLCOLOR
@@ -509,6 +548,9 @@ void GraphicsContextJava::setPlatformTextDrawingMode(TextDrawingModeFlags mode)
     if (paintingDisabled())
         return;
 
+    if (!PlatformContextJava::updateJavaState(platformContext()->javaState().textDrawingMode, mode))
+        return;
+
     platformContext()->rq().freeSpace(16)
     << (jint)com_sun_webkit_graphics_GraphicsDecoder_SET_TEXT_MODE
     << (jint)(mode.contains(TextDrawingMode::Fill))
@@ -523,6 +565,9 @@ void GraphicsContextJava::setPlatformStrokeStyle(StrokeStyle style)
     if (paintingDisabled())
         return;
 
+    if (!PlatformContextJava::updateJavaState(platformContext()->javaState().strokeStyle, style))
+        return;
+
     platformContext()->rq().freeSpace(8)
     << (jint)com_sun_webkit_graphics_GraphicsDecoder_SETSTROKESTYLE
     << (jint)style;
@@ -533,6 +578,16 @@ void GraphicsContextJava::setPlatformStrokeColor(const Color& color)
     if (paintingDisabled())
         return;
 
+    if (!PlatformContextJava::updateJavaState(platformContext()->javaState().strokeColor, color))
+        return;
+
+    if (auto packed = packedColor(color)) {
+        platformContext()->rq().freeSpace(8)
+        << (jint)com_sun_webkit_graphics_GraphicsDecoder_SETSTROKECOLOR_C
+        << *packed;
+        return;
+    }
+
     auto [r, g, b, a] = color.toColorTypeLossy<SRGBA<float>>().resolved();
     platformContext()->rq().freeSpace(20)
     << (jint)com_sun_webkit_graphics_GraphicsDecoder_SETSTROKECOLOR
@@ -544,6 +599,9 @@ void GraphicsContextJava::setPlatformStrokeThickness(float strokeThickness)
     if (paintingDisabled())
         return;
 
+    if (!PlatformContextJava::updateJavaState(platformContext()->javaState().strokeThickness, strokeThickness))
+        return;
+
     platformContext()->rq().freeSpace(8)
     << (jint)com_sun_webkit_graphics_GraphicsDecoder_SETSTROKEWIDTH
     << strokeThickness;
@@ -617,6 +675,10 @@ void GraphicsContextJava::beginTransparencyLayer(float opacity)
     platformContext()->rq().freeSpace(8)
     << (jint)com_sun_webkit_graphics_GraphicsDecoder_BEGINTRANSPARENCYLAYER
     << opacity;
+
+    // The layer works as a saved state and resets the composite operation.
+    platformContext()->saveJavaState();
+    platformContext()->javaState().compositeOperator = CompositeOperator::SourceOver;
 }
 
 void GraphicsContextJava::endTransparencyLayer()
@@ -626,6 +688,7 @@ void GraphicsContextJava::endTransparencyLayer()
 
     platformContext()->rq().freeSpace(4)
     << (jint)com_sun_webkit_graphics_GraphicsDecoder_ENDTRANSPARENCYLAYER;
+    platformContext()->restoreJavaState();
 
     GraphicsContext::endTransparencyLayer();
 }
@@ -685,11 +748,14 @@ void GraphicsContextJava::setLineCap(LineCap cap)
       return;
     }
 
+    platformContext()->setLineCap(cap);
+    if (!PlatformContextJava::updateJavaState(platformContext()->javaState().lineCap, cap)) {
+      return;
+    }
+
     platformContext()->rq().freeSpace(8)
     << (jint)com_sun_webkit_graphics_GraphicsDecoder_SET_LINE_CAP
     << (jint)cap;
-
-    platformContext()->setLineCap(cap);
 }
 
 void GraphicsContextJava::setLineJoin(LineJoin join)
@@ -697,11 +763,13 @@ void GraphicsContextJava::setLineJoin(LineJoin join)
     if (paintingDisabled())
         return;
 
+    platformContext()->setLineJoin(join);
+    if (!PlatformContextJava::updateJavaState(platformContext()->javaState().lineJoin, join))
+        return;
+
     platformContext()->rq().freeSpace(8)
     << (jint)com_sun_webkit_graphics_GraphicsDecoder_SET_LINE_JOIN
     << (jint)join;
-
-    platformContext()->setLineJoin(join);
 }
 
 void GraphicsContextJava::setMiterLimit(float limit)
@@ -709,15 +777,20 @@ void GraphicsContextJava::setMiterLimit(float limit)
     if (paintingDisabled())
         return;
 
+    platformContext()->setMiterLimit(limit);
+    if (!PlatformContextJava::updateJavaState(platformContext()->javaState().miterLimit, limit))
+        return;
+
     platformContext()->rq().freeSpace(8)
     << (jint)com_sun_webkit_graphics_GraphicsDecoder_SET_MITER_LIMIT
     << (jfloat)limit;
-
-    platformContext()->setMiterLimit(limit);
 }
 
 void GraphicsContextJava::setPlatformAlpha(float alpha)
 {
+    if (!PlatformContextJava::updateJavaState(platformContext()->javaState().alpha, alpha))
+        return;
+
     platformContext()->rq().freeSpace(8)
     << (jint)com_sun_webkit_graphics_GraphicsDecoder_SETALPHA
     << alpha;
@@ -728,6 +801,9 @@ void GraphicsContextJava::setPlatformCompositeOperation(CompositeOperator op, Bl
     if (paintingDisabled())
         return;
 
+    if (!PlatformContextJava::updateJavaState(platformContext()->javaState().compositeOperator, op))
+        return;
+
     platformContext()->rq().freeSpace(8)
     << (jint)com_sun_webkit_graphics_GraphicsDecoder_SETCOMPOSITE
     << (jint)op;
@@ -800,8 +876,14 @@ void GraphicsContextJava::drawPlatformImage(const PlatformImagePtr& image, const
     if (!image || !image->getImage())
         return;
 
-    savePlatformState();
-    setCompositeOperation(options.compositeOperator(), options.blendMode());
+    // The state round trip is only needed when the image changes the
+    // composite operation or the transform on the Java side.
+    bool needsStateChange = options.orientation() != ImageOrientation::Orientation::None
+        || platformContext()->javaState().compositeOperator != options.compositeOperator();
+    if (needsStateChange) {
+        savePlatformState();
+        setCompositeOperation(options.compositeOperator(), options.blendMode());
+    }
 
     FloatRect adjustedSrcRect(srcRect);
     FloatRect adjustedDestRect(destRect);
@@ -825,7 +907,8 @@ void GraphicsContextJava::drawPlatformImage(const PlatformImagePtr& image, const
         << adjustedDestRect.width() << adjustedDestRect.height()
         << adjustedSrcRect.x() << adjustedSrcRect.y()
         << adjustedSrcRect.width() << adjustedSrcRect.height();
-    restorePlatformState();
+    if (needsStateChange)
+        restorePlatformState();
 }
 
 void GraphicsContextJava::drawPlatformPattern(const PlatformImagePtr& image, const FloatRect& destRect, const FloatRect& tileRect, const AffineTransform& patternTransform, const FloatPoint& phase, const FloatSize&, const ImagePaintingOptions&)
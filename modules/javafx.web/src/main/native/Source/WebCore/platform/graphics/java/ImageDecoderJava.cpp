@@ -110,17 +110,24 @@ void ImageDecoderJava::setData(const FragmentedSharedBuffer& data, bool allDataR
         "([B)V");
     ASSERT(midAddImageData);
 
-    while (m_receivedDataSize < data.size()) {
-        const auto& someData = data.getSomeData(m_receivedDataSize);
-        unsigned length = someData.size();
+    // Hand everything received since the last call over in one array
+    // rather than one per segment.
+    if (m_receivedDataSize < data.size()) {
+        size_t length = data.size() - m_receivedDataSize;
         JLByteArray jArray(env->NewByteArray(length));
         if (jArray && !WTF::CheckAndClearException(env)) {
             // not OOME in Java
-            env->SetByteArrayRegion(jArray, 0, length, (const jbyte*)someData.data());
+            jsize offset = 0;
+            while (m_receivedDataSize < data.size()) {
+                const auto& someData = data.getSomeData(m_receivedDataSize);
+                env->SetByteArrayRegion(jArray, offset, someData.size(), (const jbyte*)someData.data());
+                offset += someData.size();
+                m_receivedDataSize += someData.size();
+            }
             env->CallVoidMethod(m_nativeDecoder, midAddImageData, (jbyteArray)jArray);
             WTF::CheckAndClearException(env);
         }
-        m_receivedDataSize += length;
+        m_receivedDataSize = data.size();
     }
 
     if (allDataReceived) {
@@ -176,7 +183,7 @@ size_t ImageDecoderJava::frameCount() const
         : count;
 }
 
-PlatformImagePtr ImageDecoderJava::createFrameImageAtIndex(size_t idx, SubsamplingLevel, const DecodingOptions&)
+PlatformImagePtr ImageDecoderJava::createFrameImageAtIndex(size_t idx, SubsamplingLevel subsamplingLevel, const DecodingOptions&)
 {
     JNIEnv* env = WTF::GetJavaEnv();
     if (!env || !m_nativeDecoder) {
@@ -186,13 +193,16 @@ PlatformImagePtr ImageDecoderJava::createFrameImageAtIndex(size_t idx, Subsampli
     static jmethodID midGetFrame = env->GetMethodID(
         PG_GetGraphicsImageDecoderClass(env),
         "getFrame",
-        "(I)Lcom/sun/webkit/graphics/WCImageFrame;");
+        "(II)Lcom/sun/webkit/graphics/WCImageFrame;");
     ASSERT(midGetFrame);
 
+    // May run on the ImageSource decoding queue; the Java decoder is
+    // thread safe and decodes complete images off the main thread.
     JLObject frame(env->CallObjectMethod(
         m_nativeDecoder,
         midGetFrame,
-        idx));
+        (jint)idx,
+        (jint)subsamplingLevel));
     WTF::CheckAndClearException(env);
 
     if(!frame)
@@ -214,6 +224,11 @@ PlatformImagePtr ImageDecoderJava::createFrameImageAtIndex(size_t idx, Subsampli
     IntSize frameSize(size[0], size[1]);
     env->ReleasePrimitiveArrayCritical(jsize, size, 0);
 
+    if (!idx && subsamplingLevel != SubsamplingLevel::Default) {
+        Locker locker { m_decodedSizeLock };
+        m_decodedSizes[static_cast<size_t>(subsamplingLevel)] = frameSize;
+    }
+
     return ImageJava::create(RQRef::create(frame), nullptr, frameSize.width(), frameSize.height());
 }
 
@@ -248,8 +263,18 @@ IntSize ImageDecoderJava::size() const
     return m_size;
 }
 
-IntSize ImageDecoderJava::frameSizeAtIndex(size_t idx, SubsamplingLevel) const
+IntSize ImageDecoderJava::frameSizeAtIndex(size_t idx, SubsamplingLevel subsamplingLevel) const
 {
+    // Only single frame images are ever subsampled, and only if the
+    // subsampled decode succeeds. Until a frame has been decoded at this
+    // level, report the full size that every other path returns.
+    if (!idx && subsamplingLevel != SubsamplingLevel::Default) {
+        Locker locker { m_decodedSizeLock };
+        IntSize decodedSize = m_decodedSizes[static_cast<size_t>(subsamplingLevel)];
+        if (!decodedSize.isEmpty())
+            return decodedSize;
+    }
+
     JNIEnv* env = WTF::GetJavaEnv();
     if (!env || !m_nativeDecoder) {
         return { };
@@ -276,7 +301,6 @@ IntSize ImageDecoderJava::frameSizeAtIndex(size_t idx, SubsamplingLevel) const
 
 bool ImageDecoderJava::frameAllowSubsamplingAtIndex(size_t) const
 {
-    notImplemented();
     return true;
 }
 
@@ -32,6 +32,8 @@
 #include "RQRef.h"
 
 #include <jni.h>
+#include <array>
+#include <wtf/Lock.h>
 
 namespace WebCore {
 
@@ -85,6 +87,11 @@ protected:
     // Native Handle for Java object.
     JGObject m_nativeDecoder;
     mutable IntSize m_size;
+    // Size of the first frame as last decoded at each subsampling level.
+    // The Java decoder falls back to a full size decode when it cannot
+    // subsample, so the size is only known once the frame is decoded.
+    mutable Lock m_decodedSizeLock;
+    std::array<IntSize, static_cast<size_t>(SubsamplingLevel::Max)> m_decodedSizes WTF_GUARDED_BY_LOCK(m_decodedSizeLock);
 };
 
 } // namespace WebCore
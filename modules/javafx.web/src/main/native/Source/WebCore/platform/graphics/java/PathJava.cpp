@@ -39,6 +39,7 @@
 #include <wtf/text/WTFString.h>
 #include <wtf/java/JavaRef.h>
 
+#include "com_sun_webkit_graphics_WCPath.h"
 #include "com_sun_webkit_graphics_WCPathIterator.h"
 
 namespace WebCore {
@@ -98,102 +99,169 @@ RefPtr<RQRef> copyPath(RefPtr<RQRef> p)
     return RQRef::create(ref);
 }
 
+static bool isEmptyPath(const RefPtr<RQRef>& p)
+{
+    JNIEnv* env = WTF::GetJavaEnv();
+
+    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
+                                            "isEmpty", "()Z");
+    ASSERT(mid);
+
+    jboolean res = env->CallBooleanMethod(*p, mid);
+    WTF::CheckAndClearException(env);
+
+    return jbool_to_bool(res);
+}
+
 UniqueRef<PathJava> PathJava::create(RefPtr<RQRef>&& platformPath, std::unique_ptr<PathStream>&& elementsStream)
 {
     return makeUniqueRef<PathJava>(WTFMove(platformPath), WTFMove(elementsStream));
 }
 
 PathJava::PathJava()
-    : m_platformPath(createEmptyPath())
-    , m_elementsStream(PathStream::create().moveToUniquePtr())
+    : m_elementsStream(PathStream::create().moveToUniquePtr())
 {
 }
 
 PathJava::PathJava(RefPtr<RQRef>&& platformPath, std::unique_ptr<PathStream>&& elementsStream)
     : m_platformPath(WTFMove(platformPath))
     , m_elementsStream(WTFMove(elementsStream))
+    , m_hasNativeGeometry(false)
 {
     ASSERT(m_platformPath);
+
+    m_hasCurrentPoint = !isEmptyPath(m_platformPath);
 }
 
 UniqueRef<PathImpl> PathJava::clone() const
 {
-    RefPtr<RQRef> platformPathCopy(copyPath(platformPath()));
+    // Only copy the Java path if one exists already; otherwise the clone
+    // just replays the recorded segments when it is first used.
+    RefPtr<RQRef> platformPathCopy;
+    if (m_platformPath)
+        platformPathCopy = copyPath(platformPath());
 
     auto elementsStream = m_elementsStream ? m_elementsStream->clone().moveToUniquePtr() : nullptr;
 
-    return PathJava::create(WTFMove(platformPathCopy), std::unique_ptr<PathStream> { downcast<PathStream>(elementsStream.release()) });
+    auto path = makeUniqueRef<PathJava>();
+    path->m_platformPath = WTFMove(platformPathCopy);
+    path->m_elementsStream = std::unique_ptr<PathStream> { downcast<PathStream>(elementsStream.release()) };
+    path->m_pendingSegments = m_pendingSegments;
+    path->m_pendingCoords = m_pendingCoords;
+    path->m_types = m_types;
+    path->m_coords = m_coords;
+    path->m_hasNativeGeometry = m_hasNativeGeometry;
+    path->m_hasCurrentPoint = m_hasCurrentPoint;
+    return path;
 }
 
 PlatformPathPtr PathJava::platformPath() const
 {
+    if (!m_platformPath)
+        m_platformPath = createEmptyPath();
+    flushSegments();
     return m_platformPath.get();
 }
 
 bool PathJava::operator==(const PathImpl& other) const
 {
-    if (!is<PathJava>(other))
-        return false;
-    return m_platformPath == downcast<PathJava>(other).m_platformPath;
+    return this == &other;
 }
 
-void PathJava::moveTo(const FloatPoint& p)
+void PathJava::appendPendingSegment(jint type, std::initializer_list<float> coords)
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "moveTo",
-        "(DD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid, (jdouble)p.x(), (jdouble)p.y());
-    WTF::CheckAndClearException(env);
+    m_pendingSegments.append(type);
+    m_pendingCoords.append(coords.begin(), coords.size());
 }
 
-void PathJava::addLineTo(const FloatPoint& p)
+// Mirrors Path2D: a moveTo replaces a trailing moveTo, segments without an
+// initial moveTo are rejected and consecutive closes are collapsed.
+void PathJava::appendToNativeGeometry(uint8_t type, std::initializer_list<float> coords)
 {
-    ASSERT(m_platformPath);
+    if (!m_hasNativeGeometry)
+        return;
 
-    JNIEnv* env = WTF::GetJavaEnv();
+    if (type == com_sun_webkit_graphics_WCPathIterator_SEG_MOVETO) {
+        if (!m_types.isEmpty() && m_types.last() == com_sun_webkit_graphics_WCPathIterator_SEG_MOVETO) {
+            m_coords[m_coords.size() - 2] = coords.begin()[0];
+            m_coords[m_coords.size() - 1] = coords.begin()[1];
+            return;
+        }
+    } else if (m_types.isEmpty())
+        return;
+    else if (type == com_sun_webkit_graphics_WCPathIterator_SEG_CLOSE
+        && m_types.last() == com_sun_webkit_graphics_WCPathIterator_SEG_CLOSE)
+        return;
 
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addLineTo",
-        "(DD)V");
-    ASSERT(mid);
+    m_types.append(type);
+    m_coords.append(coords.begin(), coords.size());
+}
 
-    env->CallVoidMethod(*m_platformPath, mid, (jdouble)p.x(), (jdouble)p.y());
-    WTF::CheckAndClearException(env);
+void PathJava::invalidateNativeGeometry()
+{
+    m_hasNativeGeometry = false;
+    m_types.clear();
+    m_coords.clear();
 }
 
-void PathJava::addQuadCurveTo(const FloatPoint& cp, const FloatPoint& p)
+void PathJava::flushSegments() const
 {
     ASSERT(m_platformPath);
 
+    if (m_pendingSegments.isEmpty())
+        return;
+
     JNIEnv* env = WTF::GetJavaEnv();
 
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addQuadCurveTo",
-                                            "(DDDD)V");
+    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
+        "appendSegments", "([II[F)V");
     ASSERT(mid);
 
-    env->CallVoidMethod(*m_platformPath, mid, (jdouble)cp.x(), (jdouble)cp.y(), (jdouble)p.x(), (jdouble)p.y());
+    JLocalRef<jintArray> segments(env->NewIntArray(m_pendingSegments.size()));
+    env->SetIntArrayRegion(segments, 0, m_pendingSegments.size(), m_pendingSegments.data());
+    JLocalRef<jfloatArray> coords(env->NewFloatArray(m_pendingCoords.size()));
+    env->SetFloatArrayRegion(coords, 0, m_pendingCoords.size(), m_pendingCoords.data());
+
+    env->CallVoidMethod(*m_platformPath, mid, (jintArray)segments,
+        (jint)m_pendingSegments.size(), (jfloatArray)coords);
     WTF::CheckAndClearException(env);
+
+    m_pendingSegments.clear();
+    m_pendingCoords.clear();
 }
 
-void PathJava::addBezierCurveTo(const FloatPoint& controlPoint1, const FloatPoint& controlPoint2, const FloatPoint& endPoint)
+void PathJava::moveTo(const FloatPoint& p)
 {
-    ASSERT(m_platformPath);
+    m_hasCurrentPoint = true;
+    appendPendingSegment(com_sun_webkit_graphics_WCPath_SEGMENT_MOVETO, { p.x(), p.y() });
+    appendToNativeGeometry(com_sun_webkit_graphics_WCPathIterator_SEG_MOVETO, { p.x(), p.y() });
+}
 
-    JNIEnv* env = WTF::GetJavaEnv();
+void PathJava::addLineTo(const FloatPoint& p)
+{
+    m_hasCurrentPoint = true;
+    appendPendingSegment(com_sun_webkit_graphics_WCPath_SEGMENT_LINETO, { p.x(), p.y() });
+    appendToNativeGeometry(com_sun_webkit_graphics_WCPathIterator_SEG_LINETO, { p.x(), p.y() });
+}
 
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-        "addBezierCurveTo", "(DDDDDD)V");
-    ASSERT(mid);
+void PathJava::addQuadCurveTo(const FloatPoint& cp, const FloatPoint& p)
+{
+    m_hasCurrentPoint = true;
+    appendPendingSegment(com_sun_webkit_graphics_WCPath_SEGMENT_QUADTO, { cp.x(), cp.y(), p.x(), p.y() });
+    appendToNativeGeometry(com_sun_webkit_graphics_WCPathIterator_SEG_QUADTO, { cp.x(), cp.y(), p.x(), p.y() });
+}
 
-    env->CallVoidMethod(*m_platformPath, mid,
-                        (jdouble)controlPoint1.x(), (jdouble)controlPoint1.y(),
-                        (jdouble)controlPoint2.x(), (jdouble)controlPoint2.y(),
-                        (jdouble)endPoint.x(), (jdouble)endPoint.y());
-    WTF::CheckAndClearException(env);
+void PathJava::addBezierCurveTo(const FloatPoint& controlPoint1, const FloatPoint& controlPoint2, const FloatPoint& endPoint)
+{
+    m_hasCurrentPoint = true;
+    appendPendingSegment(com_sun_webkit_graphics_WCPath_SEGMENT_CUBICTO, {
+        controlPoint1.x(), controlPoint1.y(),
+        controlPoint2.x(), controlPoint2.y(),
+        endPoint.x(), endPoint.y() });
+    appendToNativeGeometry(com_sun_webkit_graphics_WCPathIterator_SEG_CUBICTO, {
+        controlPoint1.x(), controlPoint1.y(),
+        controlPoint2.x(), controlPoint2.y(),
+        endPoint.x(), endPoint.y() });
 }
 
 static inline float areaOfTriangleFormedByPoints(const FloatPoint& p1, const FloatPoint& p2, const FloatPoint& p3)
@@ -203,23 +271,13 @@ static inline float areaOfTriangleFormedByPoints(const FloatPoint& p1, const Flo
 
 void PathJava::addArcTo(const FloatPoint& p1, const FloatPoint& p2, float radius)
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addArcTo",
-        "(DDDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid,
-                        (jdouble)p1.x(), (jdouble)p1.y(),
-                        (jdouble)p2.x(), (jdouble)p2.y(), (jdouble)radius);
-    WTF::CheckAndClearException(env);
+    m_hasCurrentPoint = true;
+    appendPendingSegment(com_sun_webkit_graphics_WCPath_SEGMENT_ARCTO, { p1.x(), p1.y(), p2.x(), p2.y(), radius });
+    invalidateNativeGeometry();
 }
 
 void PathJava::addArc(const FloatPoint& p, float radius, float startAngle, float endAngle, RotationDirection direction)
 {
-    ASSERT(m_platformPath);
     bool clockwise = false;
     if (direction == RotationDirection::Counterclockwise) {
         clockwise = true;
@@ -227,16 +285,10 @@ void PathJava::addArc(const FloatPoint& p, float radius, float startAngle, float
         clockwise = false;
     }
 
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addArc",
-        "(DDDDDZ)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid, (jdouble)p.x(), (jdouble)p.y(),
-        (jdouble)radius, (jdouble)startAngle, (jdouble)endAngle,
-        bool_to_jbool(clockwise));
-    WTF::CheckAndClearException(env);
+    m_hasCurrentPoint = true;
+    appendPendingSegment(com_sun_webkit_graphics_WCPath_SEGMENT_ARC, {
+        p.x(), p.y(), radius, startAngle, endAngle, clockwise ? 1.f : 0.f });
+    invalidateNativeGeometry();
 }
 
 void PathJava::addEllipse(const FloatPoint& point, float radiusX, float radiusY, float rotation, float startAngle, float endAngle, RotationDirection direction)
@@ -246,32 +298,44 @@ void PathJava::addEllipse(const FloatPoint& point, float radiusX, float radiusY,
 
 void PathJava::addEllipseInRect(const FloatRect& r)
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addEllipse",
-        "(DDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid,
-                        (jdouble)r.x(), (jdouble)r.y(),
-                        (jdouble)r.width(), (jdouble)r.height());
-    WTF::CheckAndClearException(env);
+    m_hasCurrentPoint = true;
+    appendPendingSegment(com_sun_webkit_graphics_WCPath_SEGMENT_ELLIPSE, { r.x(), r.y(), r.width(), r.height() });
+    invalidateNativeGeometry();
 }
 
 void PathJava::addRect(const FloatRect& r)
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "addRect",
-        "(DDDD)V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid, (jdouble)r.x(), (jdouble)r.y(),
-                              (jdouble)r.width(), (jdouble)r.height());
-    WTF::CheckAndClearException(env);
+    m_hasCurrentPoint = true;
+    appendPendingSegment(com_sun_webkit_graphics_WCPath_SEGMENT_RECT, { r.x(), r.y(), r.width(), r.height() });
+
+    if (!m_hasNativeGeometry)
+        return;
+
+    // Same outline, computed with the same double precision arithmetic, as
+    // the RoundRectangle2D iterator used by WCPathImpl.addRect. Note that
+    // WCPathImpl passes the height through an int.
+    double h = r.height();
+    jint ih = std::isnan(h) ? 0 : static_cast<jint>(std::clamp<double>(h, INT_MIN, INT_MAX));
+    double x = r.x();
+    double y = r.y();
+    double w = r.width();
+    h = static_cast<float>(ih);
+    double aw = std::min(w, 0.0);
+    double ah = std::min(h, 0.0);
+    if (aw < 0 || ah < 0)
+        return;
+
+    auto appendPoint = [&](uint8_t type, double v0, double v1, double v2, double v3) {
+        appendToNativeGeometry(type, {
+            static_cast<float>(x + v0 * w + v1 * aw),
+            static_cast<float>(y + v2 * h + v3 * ah) });
+    };
+    appendPoint(com_sun_webkit_graphics_WCPathIterator_SEG_MOVETO, 0.0, 0.0, 0.0, 0.5);
+    appendPoint(com_sun_webkit_graphics_WCPathIterator_SEG_LINETO, 0.0, 0.0, 1.0, -0.5);
+    appendPoint(com_sun_webkit_graphics_WCPathIterator_SEG_LINETO, 1.0, -0.5, 1.0, 0.0);
+    appendPoint(com_sun_webkit_graphics_WCPathIterator_SEG_LINETO, 1.0, 0.0, 0.0, 0.5);
+    appendPoint(com_sun_webkit_graphics_WCPathIterator_SEG_LINETO, 0.0, 0.5, 0.0, 0.0);
+    appendToNativeGeometry(com_sun_webkit_graphics_WCPathIterator_SEG_CLOSE, { });
 }
 
 void PathJava::addRoundedRect(const FloatRoundedRect& roundedRect, PathRoundedRect::Strategy)
@@ -281,16 +345,8 @@ void PathJava::addRoundedRect(const FloatRoundedRect& roundedRect, PathRoundedRe
 
 void PathJava::closeSubpath()
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-        "closeSubpath", "()V");
-    ASSERT(mid);
-
-    env->CallVoidMethod(*m_platformPath, mid);
-    WTF::CheckAndClearException(env);
+    appendPendingSegment(com_sun_webkit_graphics_WCPath_SEGMENT_CLOSE, { });
+    appendToNativeGeometry(com_sun_webkit_graphics_WCPathIterator_SEG_CLOSE, { });
 }
 
 void PathJava::addPath(const PathJava& path, const AffineTransform& transform)
@@ -333,18 +389,7 @@ bool PathJava::applyElements(const PathElementApplier& applier) const
 
 bool PathJava::isEmpty() const
 {
-    ASSERT(m_platformPath);
-
-    JNIEnv* env = WTF::GetJavaEnv();
-
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env),
-                                            "isEmpty", "()Z");
-    ASSERT(mid);
-
-    jboolean res = env->CallBooleanMethod(*m_platformPath, mid);
-    WTF::CheckAndClearException(env);
-
-    return jbool_to_bool(res);
+    return !m_hasCurrentPoint;
 }
 
 FloatPoint PathJava::currentPoint() const
@@ -356,7 +401,7 @@ FloatPoint PathJava::currentPoint() const
 
 bool PathJava::transform(const AffineTransform& transform)
 {
-    ASSERT(m_platformPath);
+    invalidateNativeGeometry();
 
     JNIEnv* env = WTF::GetJavaEnv();
 
@@ -364,7 +409,7 @@ bool PathJava::transform(const AffineTransform& transform)
         "transform", "(DDDDDD)V");
     ASSERT(mid);
 
-    env->CallVoidMethod(*m_platformPath, mid,
+    env->CallVoidMethod(platformPath(), mid,
                         (jdouble)transform.a(), (jdouble)transform.b(),
                         (jdouble)transform.c(), (jdouble)transform.d(),
                         (jdouble)transform.e(), (jdouble)transform.f());
@@ -372,12 +417,142 @@ bool PathJava::transform(const AffineTransform& transform)
     return true;
 }
 
+// The crossing counts below follow Shape.pointCrossingsFor* in
+// com.sun.javafx.geom so that native hit testing matches Path2D.contains.
+static int pointCrossingsForLine(float px, float py, float x0, float y0, float x1, float y1)
+{
+    if (py <  y0 && py <  y1) return 0;
+    if (py >= y0 && py >= y1) return 0;
+    if (px >= x0 && px >= x1) return 0;
+    if (px <  x0 && px <  x1) return (y0 < y1) ? 1 : -1;
+    float xintercept = x0 + (py - y0) * (x1 - x0) / (y1 - y0);
+    if (px >= xintercept) return 0;
+    return (y0 < y1) ? 1 : -1;
+}
+
+static int pointCrossingsForQuad(float px, float py, float x0, float y0, float xc, float yc, float x1, float y1, int level)
+{
+    if (py <  y0 && py <  yc && py <  y1) return 0;
+    if (py >= y0 && py >= yc && py >= y1) return 0;
+    if (px >= x0 && px >= xc && px >= x1) return 0;
+    if (px <  x0 && px <  xc && px <  x1) {
+        if (py >= y0) {
+            if (py < y1) return 1;
+        } else {
+            if (py >= y1) return -1;
+        }
+        return 0;
+    }
+    if (level > 52) return pointCrossingsForLine(px, py, x0, y0, x1, y1);
+    float x0c = (x0 + xc) / 2;
+    float y0c = (y0 + yc) / 2;
+    float xc1 = (xc + x1) / 2;
+    float yc1 = (yc + y1) / 2;
+    xc = (x0c + xc1) / 2;
+    yc = (y0c + yc1) / 2;
+    if (std::isnan(xc) || std::isnan(yc))
+        return 0;
+    return pointCrossingsForQuad(px, py, x0, y0, x0c, y0c, xc, yc, level + 1)
+        + pointCrossingsForQuad(px, py, xc, yc, xc1, yc1, x1, y1, level + 1);
+}
+
+static int pointCrossingsForCubic(float px, float py, float x0, float y0, float xc0, float yc0, float xc1, float yc1, float x1, float y1, int level)
+{
+    if (py <  y0 && py <  yc0 && py <  yc1 && py <  y1) return 0;
+    if (py >= y0 && py >= yc0 && py >= yc1 && py >= y1) return 0;
+    if (px >= x0 && px >= xc0 && px >= xc1 && px >= x1) return 0;
+    if (px <  x0 && px <  xc0 && px <  xc1 && px <  x1) {
+        if (py >= y0) {
+            if (py < y1) return 1;
+        } else {
+            if (py >= y1) return -1;
+        }
+        return 0;
+    }
+    if (level > 52) return pointCrossingsForLine(px, py, x0, y0, x1, y1);
+    float xmid = (xc0 + xc1) / 2;
+    float ymid = (yc0 + yc1) / 2;
+    xc0 = (x0 + xc0) / 2;
+    yc0 = (y0 + yc0) / 2;
+    xc1 = (xc1 + x1) / 2;
+    yc1 = (yc1 + y1) / 2;
+    float xc0m = (xc0 + xmid) / 2;
+    float yc0m = (yc0 + ymid) / 2;
+    float xmc1 = (xmid + xc1) / 2;
+    float ymc1 = (ymid + yc1) / 2;
+    xmid = (xc0m + xmc1) / 2;
+    ymid = (yc0m + ymc1) / 2;
+    if (std::isnan(xmid) || std::isnan(ymid))
+        return 0;
+    return pointCrossingsForCubic(px, py, x0, y0, xc0, yc0, xc0m, yc0m, xmid, ymid, level + 1)
+        + pointCrossingsForCubic(px, py, xmid, ymid, xmc1, ymc1, xc1, yc1, x1, y1, level + 1);
+}
+
+int PathJava::pointCrossings(float px, float py) const
+{
+    const float* coords = m_coords.data();
+    float movx, movy, curx, cury, endx, endy;
+    curx = movx = coords[0];
+    cury = movy = coords[1];
+    int crossings = 0;
+    size_t ci = 2;
+    for (size_t i = 1; i < m_types.size(); i++) {
+        switch (m_types[i]) {
+        case com_sun_webkit_graphics_WCPathIterator_SEG_MOVETO:
+            if (cury != movy)
+                crossings += pointCrossingsForLine(px, py, curx, cury, movx, movy);
+            movx = curx = coords[ci++];
+            movy = cury = coords[ci++];
+            break;
+        case com_sun_webkit_graphics_WCPathIterator_SEG_LINETO:
+            endx = coords[ci++];
+            endy = coords[ci++];
+            crossings += pointCrossingsForLine(px, py, curx, cury, endx, endy);
+            curx = endx;
+            cury = endy;
+            break;
+        case com_sun_webkit_graphics_WCPathIterator_SEG_QUADTO:
+            endx = coords[ci + 2];
+            endy = coords[ci + 3];
+            crossings += pointCrossingsForQuad(px, py, curx, cury,
+                coords[ci], coords[ci + 1], endx, endy, 0);
+            ci += 4;
+            curx = endx;
+            cury = endy;
+            break;
+        case com_sun_webkit_graphics_WCPathIterator_SEG_CUBICTO:
+            endx = coords[ci + 4];
+            endy = coords[ci + 5];
+            crossings += pointCrossingsForCubic(px, py, curx, cury,
+                coords[ci], coords[ci + 1], coords[ci + 2], coords[ci + 3], endx, endy, 0);
+            ci += 6;
+            curx = endx;
+            cury = endy;
+            break;
+        case com_sun_webkit_graphics_WCPathIterator_SEG_CLOSE:
+            if (cury != movy)
+                crossings += pointCrossingsForLine(px, py, curx, cury, movx, movy);
+            curx = movx;
+            cury = movy;
+            break;
+        }
+    }
+    if (cury != movy)
+        crossings += pointCrossingsForLine(px, py, curx, cury, movx, movy);
+    return crossings;
+}
+
 bool PathJava::contains(const FloatPoint &point, WindRule rule) const
 {
     if (isEmpty() || !std::isfinite(point.x()) || !std::isfinite(point.y()))
         return false;
 
-    ASSERT(m_platformPath);
+    if (m_hasNativeGeometry) {
+        if (m_types.size() < 2)
+            return false;
+        int mask = rule == WindRule::NonZero ? -1 : 1;
+        return (pointCrossings(point.x(), point.y()) & mask) != 0;
+    }
 
     JNIEnv* env = WTF::GetJavaEnv();
 
@@ -385,7 +560,7 @@ bool PathJava::contains(const FloatPoint &point, WindRule rule) const
         "(IDD)Z");
     ASSERT(mid);
 
-    jboolean res = env->CallBooleanMethod(*m_platformPath, mid, (jint)rule,
+    jboolean res = env->CallBooleanMethod(platformPath(), mid, (jint)rule,
         (jdouble)point.x(), (jdouble)point.y());
     WTF::CheckAndClearException(env);
 
@@ -394,7 +569,6 @@ bool PathJava::contains(const FloatPoint &point, WindRule rule) const
 
 bool PathJava::strokeContains(const FloatPoint& p, const Function<void(GraphicsContext&)>& strokeStyleApplier) const
 {
-    ASSERT(m_platformPath);
     ASSERT(strokeStyleApplier);
 
     GraphicsContext& gc = scratchContext();
@@ -426,7 +600,7 @@ bool PathJava::strokeContains(const FloatPoint& p, const Function<void(GraphicsC
     JLocalRef<jdoubleArray> dashArray(env->NewDoubleArray(size));
     env->SetDoubleArrayRegion(dashArray, 0, size, dashes.data());
 
-    jboolean res = env->CallBooleanMethod(*m_platformPath, mid, (jdouble)p.x(),
+    jboolean res = env->CallBooleanMethod(platformPath(), mid, (jdouble)p.x(),
         (jdouble)p.y(), (jdouble) thickness, (jdouble) miterLimit,
         (jint) cap, (jint) join, (jdouble) dashOffset, (jdoubleArray) dashArray);
 
@@ -447,17 +621,35 @@ FloatRect PathJava::boundingRect() const
 
 FloatRect PathJava::strokeBoundingRect(const Function<void(GraphicsContext&)>& strokeStyleApplier) const
 {
-    ASSERT(m_platformPath);
+    FloatRect bounds;
+    if (m_hasNativeGeometry) {
+        // Same control point bounds as Path2D.getBounds().
+        if (!m_coords.isEmpty()) {
+            float x1, y1, x2, y2;
+            x1 = x2 = m_coords[0];
+            y1 = y2 = m_coords[1];
+            for (size_t i = 2; i < m_coords.size(); i += 2) {
+                float x = m_coords[i];
+                float y = m_coords[i + 1];
+                if (x < x1) x1 = x;
+                if (y < y1) y1 = y;
+                if (x > x2) x2 = x;
+                if (y > y2) y2 = y;
+            }
+            bounds = FloatRect(x1, y1, x2 - x1, y2 - y1);
+        }
+    } else {
+        JNIEnv* env = WTF::GetJavaEnv();
 
-    JNIEnv* env = WTF::GetJavaEnv();
+        static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "getBounds",
+                "()Lcom/sun/webkit/graphics/WCRectangle;");
+        ASSERT(mid);
 
-    static jmethodID mid = env->GetMethodID(PG_GetPathClass(env), "getBounds",
-            "()Lcom/sun/webkit/graphics/WCRectangle;");
-    ASSERT(mid);
+        JLObject rect(env->CallObjectMethod(platformPath(), mid));
+        WTF::CheckAndClearException(env);
+        if (!rect)
+            return FloatRect();
 
-    JLObject rect(env->CallObjectMethod(*m_platformPath, mid));
-    WTF::CheckAndClearException(env);
-    if (rect) {
         static jfieldID rectxFID = env->GetFieldID(PG_GetRectangleClass(env), "x", "F");
         ASSERT(rectxFID);
         static jfieldID rectyFID = env->GetFieldID(PG_GetRectangleClass(env), "y", "F");
@@ -467,26 +659,23 @@ FloatRect PathJava::strokeBoundingRect(const Function<void(GraphicsContext&)>& s
         static jfieldID recthFID = env->GetFieldID(PG_GetRectangleClass(env), "h", "F");
         ASSERT(recthFID);
 
-        FloatRect bounds(
+        bounds = FloatRect(
             float(env->GetFloatField(rect, rectxFID)),
             float(env->GetFloatField(rect, rectyFID)),
             float(env->GetFloatField(rect, rectwFID)),
             float(env->GetFloatField(rect, recthFID)));
         WTF::CheckAndClearException(env);
+    }
 
-        float thickness;
-        if (strokeStyleApplier) {
-            GraphicsContext& gc = scratchContext();
-            gc.save();
-            strokeStyleApplier(gc);
-            thickness = gc.strokeThickness();
-            gc.restore();
-            bounds.inflate(thickness / 2);
-        }
-        return bounds;
-    } else {
-        return FloatRect();
+    if (strokeStyleApplier) {
+        GraphicsContext& gc = scratchContext();
+        gc.save();
+        strokeStyleApplier(gc);
+        float thickness = gc.strokeThickness();
+        gc.restore();
+        bounds.inflate(thickness / 2);
     }
+    return bounds;
 }
 
 } // namespace WebCore
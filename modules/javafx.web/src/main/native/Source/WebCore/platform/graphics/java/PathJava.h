@@ -87,8 +87,28 @@ private:
     FloatRect fastBoundingRect() const final;
     FloatRect boundingRect() const final;
 
-    RefPtr<RQRef> m_platformPath;
+    void appendPendingSegment(jint type, std::initializer_list<float> coords);
+    void appendToNativeGeometry(uint8_t type, std::initializer_list<float> coords);
+    void invalidateNativeGeometry();
+    void flushSegments() const;
+    int pointCrossings(float px, float py) const;
+
+    mutable RefPtr<RQRef> m_platformPath;
     std::unique_ptr<PathStream> m_elementsStream;
+
+    // Segments recorded since the Java WCPath was last updated. They are
+    // handed over in a single call when the path is actually used by Java.
+    mutable Vector<jint> m_pendingSegments;
+    mutable Vector<float> m_pendingCoords;
+
+    // Native copy of the Java Path2D geometry, in Path2D segment types,
+    // used to answer isEmpty, bounds and contains queries without JNI.
+    // It is dropped once the path is modified in a way that is computed
+    // on the Java side (arcs, ellipses, transforms).
+    Vector<uint8_t> m_types;
+    Vector<float> m_coords;
+    bool m_hasNativeGeometry { true };
+    bool m_hasCurrentPoint { false };
 };
 
 } // namespace WebCore
@@ -30,6 +30,7 @@
 #include "RenderingQueue.h"
 #include "com_sun_webkit_graphics_WCRenderQueue.h"
 #include <jni.h>
+#include <optional>
 #include <wtf/Noncopyable.h>
 
 namespace WebCore {
@@ -119,6 +120,45 @@ namespace WebCore {
         void setMiterLimit(float miterLimit) {
             m_miterLimit = miterLimit;
         }
+
+        // The state last sent to the Java graphics context. A member is
+        // std::nullopt while its value on the Java side is unknown.
+        struct JavaState {
+            std::optional<Color> fillColor;
+            std::optional<Color> strokeColor;
+            std::optional<float> strokeThickness;
+            std::optional<StrokeStyle> strokeStyle;
+            std::optional<float> alpha;
+            std::optional<CompositeOperator> compositeOperator;
+            std::optional<TextDrawingModeFlags> textDrawingMode;
+            std::optional<LineCap> lineCap;
+            std::optional<LineJoin> lineJoin;
+            std::optional<float> miterLimit;
+        };
+
+        JavaState& javaState() {
+            return m_javaState;
+        }
+
+        // Records that |value| is about to be sent to Java. Returns false if
+        // Java already has that value, so the state change can be dropped.
+        template<typename T>
+        static bool updateJavaState(std::optional<T>& current, const T& value) {
+            if (current && *current == value) {
+                return false;
+            }
+            current = value;
+            return true;
+        }
+
+        // Mirror the Java SAVESTATE/RESTORESTATE stack.
+        void saveJavaState() {
+            m_javaStateStack.append(m_javaState);
+        }
+
+        void restoreJavaState() {
+            m_javaState = m_javaStateStack.isEmpty() ? JavaState() : m_javaStateStack.takeLast();
+        }
     private:
         RefPtr<RenderingQueue> m_rq;
         RefPtr<RQRef> m_jRenderTheme;
@@ -130,5 +170,7 @@ namespace WebCore {
         LineCap m_lineCap { };
         LineJoin m_lineJoin { };
         float m_miterLimit { };
+        JavaState m_javaState;
+        Vector<JavaState> m_javaStateStack;
     };
 }
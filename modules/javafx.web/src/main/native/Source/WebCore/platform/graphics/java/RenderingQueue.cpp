@@ -45,6 +45,55 @@ static Addr2ByteBuffer& getAddr2ByteBuffer()
     return container.get();
 }
 
+/*
+ * Buffers of the default capacity that Java has handed back through
+ * [twkRelease]. Reusing them avoids a malloc and a new direct ByteBuffer
+ * per flushed buffer during steady-state painting.
+ */
+static Vector<RefPtr<ByteBuffer>>& getFreeBuffers()
+{
+    static NeverDestroyed<Vector<RefPtr<ByteBuffer>>> freeBuffers;
+    return freeBuffers.get();
+}
+
+static constexpr int pooledBufferCapacity =
+    com_sun_webkit_graphics_WCRenderQueue_MAX_QUEUE_SIZE / RenderingQueue::MAX_BUFFER_COUNT;
+
+static RefPtr<ByteBuffer> acquireBuffer(int capacity)
+{
+    Vector<RefPtr<ByteBuffer>>& freeBuffers = getFreeBuffers();
+    if (capacity == pooledBufferCapacity && !freeBuffers.isEmpty()) {
+        return freeBuffers.takeLast();
+    }
+    ++RenderingQueue::statistics().buffersAllocated;
+    return ByteBuffer::create(capacity);
+}
+
+static void recycleBuffer(RefPtr<ByteBuffer>&& buffer)
+{
+    // Releases the resources referenced from the buffer, so this has to
+    // happen on the Event thread.
+    buffer->reset();
+    Vector<RefPtr<ByteBuffer>>& freeBuffers = getFreeBuffers();
+    if (buffer->capacity() == pooledBufferCapacity
+        && freeBuffers.size() < RenderingQueue::MAX_POOLED_BUFFER_COUNT) {
+        freeBuffers.append(WTFMove(buffer));
+    }
+}
+
+/*static*/
+RenderingQueue::Statistics& RenderingQueue::statistics()
+{
+    static Statistics statistics;
+    return statistics;
+}
+
+/*static*/
+void RenderingQueue::resetStatistics()
+{
+    statistics() = Statistics();
+}
+
 /*static*/
 RefPtr<RenderingQueue> RenderingQueue::create(
     const JLObject &jRQ,
@@ -59,13 +108,14 @@ RefPtr<RenderingQueue> RenderingQueue::create(
 
 RenderingQueue& RenderingQueue::freeSpace(int size) {
     if (m_buffer && !m_buffer->hasFreeSpace(size)) {
+        ++statistics().stalls;
         flushBuffer();
         if (m_autoFlush) {
             flush();
         }
     }
     if (!m_buffer) {
-        m_buffer = RefPtr<ByteBuffer>(ByteBuffer::create(std::max(m_capacity, size)));
+        m_buffer = acquireBuffer(std::max(m_capacity, size));
     }
     return *this;
 }
@@ -106,15 +156,20 @@ RenderingQueue& RenderingQueue::flushBuffer() {
     JNIEnv* env = WTF::GetJavaEnv();
 
     static jmethodID midFwkAddBuffer = env->GetMethodID(PG_GetRenderQueueClass(env),
-        "fwkAddBuffer", "(Ljava/nio/ByteBuffer;)V");
+        "fwkAddBuffer", "(Ljava/nio/ByteBuffer;I)V");
     ASSERT(midFwkAddBuffer);
 
+    Statistics& stats = statistics();
+    stats.bytesQueued += m_buffer->position();
+    ++stats.buffersFlushed;
+
     Addr2ByteBuffer &a2bb = getAddr2ByteBuffer();
     a2bb.set(m_buffer->bufferAddress(), m_buffer);
     env->CallVoidMethod(
         getWCRenderingQueue(),
         midFwkAddBuffer,
-        (jobject)(m_buffer->createDirectByteBuffer(env)));
+        (jobject)(m_buffer->directByteBuffer(env)),
+        (jint)m_buffer->position());
     WTF::CheckAndClearException(env);
 
     m_buffer = nullptr;
@@ -139,7 +194,25 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_graphics_WCRenderQueue_twkRelease
         char *key = (char *)env->GetDirectBufferAddress(
             JLObject(env->GetObjectArrayElement(bufs, i)));
         if (key != 0) {
-            a2bb.remove(key);
+            RefPtr<ByteBuffer> buffer = a2bb.take(key);
+            if (buffer) {
+                recycleBuffer(WTFMove(buffer));
+            }
         }
     }
 }
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_graphics_WCRenderQueue_twkGetAndResetStatistics
+    (JNIEnv* env, jclass, jlongArray stats)
+{
+    using namespace WebCore;
+
+    const RenderingQueue::Statistics& statistics = RenderingQueue::statistics();
+    jlong values[com_sun_webkit_graphics_WCRenderQueue_STAT_COUNT];
+    values[com_sun_webkit_graphics_WCRenderQueue_STAT_BYTES_QUEUED] = statistics.bytesQueued;
+    values[com_sun_webkit_graphics_WCRenderQueue_STAT_BUFFERS_FLUSHED] = statistics.buffersFlushed;
+    values[com_sun_webkit_graphics_WCRenderQueue_STAT_STALLS] = statistics.stalls;
+    values[com_sun_webkit_graphics_WCRenderQueue_STAT_BUFFERS_ALLOCATED] = statistics.buffersAllocated;
+    env->SetLongArrayRegion(stats, 0, com_sun_webkit_graphics_WCRenderQueue_STAT_COUNT, values);
+    RenderingQueue::resetStatistics();
+}
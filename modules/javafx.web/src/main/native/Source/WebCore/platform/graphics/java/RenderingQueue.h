@@ -44,15 +44,29 @@ public:
         return adoptRef(new ByteBuffer(capacity));
     }
 
-    JLObject createDirectByteBuffer(JNIEnv* env) {
+    // The direct buffer spans the whole capacity and is created only once,
+    // so that a recycled ByteBuffer is handed to Java without new JNI
+    // allocations. Java limits it to position() when the buffer is added.
+    JLObject directByteBuffer(JNIEnv* env) {
         ASSERT(!isEmpty());
-        JLObject ret(env->NewDirectByteBuffer(m_buffer, m_position));
-        m_nio_holder = ret;
-        return ret;
+        if (!m_nio_holder)
+            m_nio_holder = JLObject(env->NewDirectByteBuffer(m_buffer, m_capacity));
+        return m_nio_holder;
     }
 
     char* bufferAddress() { return m_buffer; }
 
+    int capacity() const { return m_capacity; }
+
+    int position() const { return m_position; }
+
+    // Drops the references collected while recording, so that the buffer
+    // can be reused for another sequence of operations.
+    void reset() {
+        m_refList.clear();
+        m_position = 0;
+    }
+
     void putRef(RefPtr<RQRef> ref) {
         ASSERT(m_position + sizeof(jint) <= m_capacity);
         RefPtr<RQRef> repeatable_use_holder(ref);
@@ -108,6 +122,19 @@ class RenderingQueue : public RefCounted<RenderingQueue> {
     RQ_LOG_INSTANCE_COUNT(RenderingQueue)
 public:
     static const size_t MAX_BUFFER_COUNT = 8;
+    static const size_t MAX_POOLED_BUFFER_COUNT = 32;
+
+    struct Statistics {
+        uint64_t bytesQueued { 0 };
+        uint64_t buffersFlushed { 0 };
+        uint64_t stalls { 0 };
+        uint64_t buffersAllocated { 0 };
+    };
+
+    // Counters since the last call to resetStatistics(). They are only
+    // updated and read on the Event thread.
+    static Statistics& statistics();
+    static void resetStatistics();
 
     static RefPtr<RenderingQueue> create(
         const JLObject &jRQ,
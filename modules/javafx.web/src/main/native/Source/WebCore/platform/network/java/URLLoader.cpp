@@ -47,6 +47,8 @@
 #include "com_sun_webkit_LoadListenerClient.h"
 #include "com_sun_webkit_network_URLLoaderBase.h"
 #include <wtf/CompletionHandler.h>
+#include <wtf/ThreadSafeRefCounted.h>
+#include <wtf/java/JavaEnv.h>
 
 namespace WebCore {
 class Page;
@@ -66,6 +68,65 @@ static JGClass formDataElementClass;
 static jmethodID createFromFileMethod;
 static jmethodID createFromByteArrayMethod;
 
+// Keeps a direct ByteBuffer handed over by URLLoader alive for as long as
+// WebCore references its bytes, and hands it back to the Java buffer pool
+// once the last SharedBuffer segment wrapping it is gone. The total amount
+// of memory adopted this way is bounded so that a slow consumer cannot pin
+// an unbounded number of network buffers.
+class AdoptedJavaBuffer : public ThreadSafeRefCounted<AdoptedJavaBuffer> {
+public:
+    static constexpr size_t maxAdoptedBytes = 32 * 1024 * 1024;
+
+    static bool reserve(size_t size)
+    {
+        size_t current = s_adoptedBytes.load();
+        do {
+            if (current + size > maxAdoptedBytes)
+                return false;
+        } while (!s_adoptedBytes.compare_exchange_weak(current, current + size));
+        return true;
+    }
+
+    static Ref<AdoptedJavaBuffer> create(JNIEnv* env, jobject release, size_t size)
+    {
+        return adoptRef(*new AdoptedJavaBuffer(env, release, size));
+    }
+
+    ~AdoptedJavaBuffer()
+    {
+        s_adoptedBytes -= m_size;
+        WTF::AttachThreadAsDaemonToJavaEnv autoAttach;
+        JNIEnv* env = autoAttach.env();
+        if (!env)
+            return;
+        env->CallVoidMethod(m_release, s_runMethod);
+        WTF::CheckAndClearException(env);
+        env->DeleteGlobalRef(m_release);
+    }
+
+private:
+    AdoptedJavaBuffer(JNIEnv* env, jobject release, size_t size)
+        : m_release(env->NewGlobalRef(release))
+        , m_size(size)
+    {
+        if (!s_runMethod) {
+            JLClass runnableClass(env->FindClass("java/lang/Runnable"));
+            ASSERT(runnableClass);
+            s_runMethod = env->GetMethodID(runnableClass, "run", "()V");
+            ASSERT(s_runMethod);
+        }
+    }
+
+    jobject m_release;
+    size_t m_size;
+
+    static std::atomic<size_t> s_adoptedBytes;
+    static jmethodID s_runMethod;
+};
+
+std::atomic<size_t> AdoptedJavaBuffer::s_adoptedBytes { 0 };
+jmethodID AdoptedJavaBuffer::s_runMethod { nullptr };
+
 static void initRefs(JNIEnv* env)
 {
     if (!networkContextClass) {
@@ -508,9 +569,52 @@ JNIEXPORT void JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkDidReceiveDa
     ASSERT(target);
     const uint8_t* address =
             static_cast<const uint8_t*>(env->GetDirectBufferAddress(byteBuffer));
-    Ref<FragmentedSharedBuffer> tmp_buf = FragmentedSharedBuffer::create(address,remaining);
-    target->didReceiveData(tmp_buf->makeContiguous().ptr() + position, remaining);
-    //target->didReceiveData((SharedBuffer*)(address) + position, remaining);
+    Ref<SharedBuffer> buffer = SharedBuffer::create(address + position, remaining);
+    target->didReceiveData(buffer.ptr(), remaining);
+}
+
+JNIEXPORT void JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkDidReceiveDataArray
+  (JNIEnv* env, jclass, jbyteArray array, jint offset, jint length,
+   jlong data)
+{
+    using namespace WebCore;
+    URLLoader::Target* target =
+            static_cast<URLLoader::Target*>(jlong_to_ptr(data));
+    ASSERT(target);
+    Vector<uint8_t> bytes(length);
+    env->GetByteArrayRegion(array, offset, length, reinterpret_cast<jbyte*>(bytes.data()));
+    Ref<SharedBuffer> buffer = SharedBuffer::create(WTFMove(bytes));
+    target->didReceiveData(buffer.ptr(), length);
+}
+
+JNIEXPORT jboolean JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkDidReceiveOwnedData
+  (JNIEnv* env, jclass, jobject byteBuffer, jint position, jint remaining,
+   jobject release, jlong data)
+{
+    using namespace WebCore;
+    using namespace URLLoaderJavaInternal;
+    URLLoader::Target* target =
+            static_cast<URLLoader::Target*>(jlong_to_ptr(data));
+    ASSERT(target);
+    const uint8_t* address =
+            static_cast<const uint8_t*>(env->GetDirectBufferAddress(byteBuffer));
+    jlong capacity = env->GetDirectBufferCapacity(byteBuffer);
+
+    if (!AdoptedJavaBuffer::reserve(capacity)) {
+        Ref<SharedBuffer> buffer = SharedBuffer::create(address + position, remaining);
+        target->didReceiveData(buffer.ptr(), remaining);
+        return JNI_FALSE;
+    }
+
+    Ref<AdoptedJavaBuffer> owner = AdoptedJavaBuffer::create(env, release, capacity);
+    const uint8_t* bytes = address + position;
+    size_t size = remaining;
+    Ref<SharedBuffer> buffer = SharedBuffer::create(DataSegment::Provider {
+        [owner = WTFMove(owner), bytes] { return bytes; },
+        [size] { return size; }
+    });
+    target->didReceiveData(buffer.ptr(), remaining);
+    return JNI_TRUE;
 }
 
 JNIEXPORT void JNICALL Java_com_sun_webkit_network_URLLoaderBase_twkDidFinishLoading
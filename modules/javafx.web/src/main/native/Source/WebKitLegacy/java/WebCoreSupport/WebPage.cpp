@@ -115,6 +115,7 @@
 // FIXME: Move dependency of runtime_root to BridgeUtils
 #include <WebCore/runtime_root.h>
 #if OS(UNIX)
+#include <sys/resource.h>
 #include <sys/utsname.h>
 #endif
 #if OS(WINDOWS)
@@ -860,6 +861,8 @@ namespace {
 
 bool s_useJIT;
 bool s_useDFGJIT;
+bool s_useFTLJIT;
+bool s_useWebAssembly;
 bool s_useCSS3D;
 
 }  // namespace
@@ -867,9 +870,12 @@ bool s_useCSS3D;
 extern "C" {
 
 JNIEXPORT void JNICALL Java_com_sun_webkit_WebPage_twkInitWebCore
-    (JNIEnv* env, jclass self, jboolean useJIT, jboolean useDFGJIT, jboolean useCSS3D) {
+    (JNIEnv* env, jclass self, jboolean useJIT, jboolean useDFGJIT, jboolean useFTLJIT,
+     jboolean useWebAssembly, jboolean useCSS3D) {
     s_useJIT = useJIT;
     s_useDFGJIT = useDFGJIT;
+    s_useFTLJIT = useFTLJIT;
+    s_useWebAssembly = useWebAssembly;
     s_useCSS3D = useCSS3D;
 }
 
@@ -899,6 +905,20 @@ JNIEXPORT jlong JNICALL Java_com_sun_webkit_WebPage_twkCreatePage
         JSC::Options::useJIT() = s_useJIT;
         // Enable DFG only if JIT is enabled.
         JSC::Options::useDFGJIT() = s_useJIT && s_useDFGJIT;
+        // FTL tiers up from DFG, so it is only enabled along with DFG.
+        JSC::Options::useFTLJIT() = s_useJIT && s_useDFGJIT && s_useFTLJIT;
+#if ENABLE(WEBASSEMBLY)
+        JSC::Options::useWebAssembly() = s_useJIT && s_useWebAssembly;
+#if OS(UNIX)
+        // Each fast memory reserves more than 4GB of address space and relies
+        // on the access fault handler for bounds checks. If the address space
+        // of the process is limited, leave it to the JVM heap and thread
+        // stacks, and use explicitly bounds checked memories instead.
+        struct rlimit addressSpaceLimit;
+        if (!getrlimit(RLIMIT_AS, &addressSpaceLimit) && addressSpaceLimit.rlim_cur != RLIM_INFINITY)
+            JSC::Options::useWebAssemblyFastMemory() = false;
+#endif
+#endif
     });
 
     JLObject jlself(self, true);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2016, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -23,44 +23,22 @@
  * questions.
  */
 
-#include "config.h"
-#include "RunLoop.h"
+package com.sun.webkit.graphics;
 
-namespace WTF {
+import java.util.Arrays;
 
-// JDK-8146878
-//XXX: implement these stubs?
+public class GraphicsDecoderShim {
 
-RunLoop::RunLoop() {}
-RunLoop::~RunLoop() {}
+    /**
+     * The counts are only collected while the
+     * com.sun.webkit.graphics.GraphicsDecoder.histogram logger is at FINE.
+     */
+    public static long getCount(int op) {
+        return GraphicsDecoder.opCounts[op];
+    }
 
-void RunLoop::TimerBase::fired() {}
-
-void RunLoop::run() {}
-void RunLoop::stop() {}
-void RunLoop::wakeUp() {}
-
-RunLoop::TimerBase::TimerBase(RunLoop& runLoop)
-    : m_runLoop(runLoop)
-{
-}
-
-RunLoop::TimerBase::~TimerBase()
-{
-    stop();
-}
-
-void RunLoop::TimerBase::start(double fireInterval, bool repeat)
-{
+    public static void resetCounts() {
+        Arrays.fill(GraphicsDecoder.opCounts, 0);
+        Arrays.fill(GraphicsDecoder.opBytes, 0);
+    }
 }
-
-void RunLoop::TimerBase::stop()
-{
-}
-
-bool RunLoop::TimerBase::isActive() const
-{
-  return true;
-}
-
-} // namespace WTF
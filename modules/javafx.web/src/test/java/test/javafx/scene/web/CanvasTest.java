@@ -245,6 +245,44 @@ public class CanvasTest extends TestBase {
         assertTrue("Color should be transparent black:" + pixelAt75x25, isColorsSimilar(Color.BLACK, pixelAt75x25, 1));
     }
 
+    @Test
+    public void testCanvasIsPointInPath() {
+        loadContent("<canvas id='canvas' width='200' height='200'></canvas> <script>" +
+                "var ctx = document.getElementById('canvas').getContext('2d');" +
+                "ctx.beginPath();" +
+                // Both subpaths run clockwise, so the inner one is only a
+                // hole under the evenodd rule.
+                "ctx.moveTo(0, 0);" +
+                "ctx.lineTo(100, 0);" +
+                "ctx.lineTo(100, 100);" +
+                "ctx.lineTo(0, 100);" +
+                "ctx.closePath();" +
+                "ctx.moveTo(25, 25);" +
+                "ctx.lineTo(75, 25);" +
+                "ctx.bezierCurveTo(80, 40, 80, 60, 75, 75);" +
+                "ctx.lineTo(25, 75);" +
+                "ctx.closePath();" +
+                "</script>");
+        submit(() -> {
+            assertEquals(Boolean.TRUE, getEngine().executeScript("ctx.isPointInPath(50, 50)"));
+            assertEquals(Boolean.TRUE, getEngine().executeScript("ctx.isPointInPath(50, 50, 'nonzero')"));
+            assertEquals(Boolean.FALSE, getEngine().executeScript("ctx.isPointInPath(50, 50, 'evenodd')"));
+            assertEquals(Boolean.TRUE, getEngine().executeScript("ctx.isPointInPath(10, 10, 'evenodd')"));
+            assertEquals(Boolean.FALSE, getEngine().executeScript("ctx.isPointInPath(150, 150)"));
+
+            // Arcs are computed by the Java path, the result must not change.
+            getEngine().executeScript("ctx.moveTo(170, 150); ctx.arc(150, 150, 20, 0, 2 * Math.PI, false)");
+            assertEquals(Boolean.TRUE, getEngine().executeScript("ctx.isPointInPath(150, 150)"));
+            assertEquals(Boolean.FALSE, getEngine().executeScript("ctx.isPointInPath(50, 50, 'evenodd')"));
+
+            // A lone rect() does not depend on its winding.
+            getEngine().executeScript("ctx.beginPath(); ctx.rect(120, 0, 50, 50)");
+            assertEquals(Boolean.TRUE, getEngine().executeScript("ctx.isPointInPath(140, 20)"));
+            assertEquals(Boolean.TRUE, getEngine().executeScript("ctx.isPointInPath(140, 20, 'evenodd')"));
+            assertEquals(Boolean.FALSE, getEngine().executeScript("ctx.isPointInPath(50, 50)"));
+        });
+    }
+
     @After
     public void resetSystemErr() {
         System.setErr(ERR);
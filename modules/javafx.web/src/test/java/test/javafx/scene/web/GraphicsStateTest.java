@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.javafx.scene.web;
+
+import com.sun.webkit.graphics.GraphicsDecoder;
+import com.sun.webkit.graphics.GraphicsDecoderShim;
+import java.util.logging.Level;
+import java.util.logging.Logger;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+/**
+ * Tests that the native side only sends graphics state changes that Java
+ * does not have yet, and that its record of the Java state follows
+ * save() and restore(). The commands are counted by the GraphicsDecoder
+ * histogram. The canvases are not attached to the document, so no page
+ * painting is counted with them.
+ */
+public class GraphicsStateTest extends TestBase {
+
+    // Held so that the level is not lost when the logger is collected
+    private static final Logger histogramLogger =
+            Logger.getLogger(GraphicsDecoder.class.getName() + ".histogram");
+
+    private Level histogramLevel;
+
+    @Before
+    public void setUp() {
+        histogramLevel = histogramLogger.getLevel();
+        histogramLogger.setLevel(Level.FINE);
+        loadContent("<script>" +
+                "function createContext() {" +
+                "    var canvas = document.createElement('canvas');" +
+                "    canvas.width = 50;" +
+                "    canvas.height = 10;" +
+                "    return canvas.getContext('2d');" +
+                "}" +
+                "function pixel(ctx, x, y) {" +
+                "    return Array.prototype.join.call(ctx.getImageData(x, y, 1, 1).data);" +
+                "}" +
+                "</script>");
+    }
+
+    @After
+    public void tearDown() {
+        histogramLogger.setLevel(histogramLevel);
+    }
+
+    private long countFillColors() {
+        return GraphicsDecoderShim.getCount(GraphicsDecoder.SETFILLCOLOR)
+                + GraphicsDecoderShim.getCount(GraphicsDecoder.SETFILLCOLOR_C);
+    }
+
+    @Test
+    public void testRedundantFillColorIsDropped() {
+        long[] counts = submit(() -> {
+            GraphicsDecoderShim.resetCounts();
+            // Reading the pixels decodes the queue
+            getEngine().executeScript("var ctx = createContext();" +
+                    "ctx.fillStyle = 'rgb(255, 0, 0)';" +
+                    "for (var i = 0; i < 20; i++) {" +
+                    "    ctx.globalAlpha = (i % 2) ? 0.5 : 1;" +
+                    "    ctx.fillRect(0, 0, 10, 10);" +
+                    "}" +
+                    "pixel(ctx, 0, 0)");
+            return new long[] {
+                countFillColors(),
+                GraphicsDecoderShim.getCount(GraphicsDecoder.SETALPHA)
+            };
+        });
+        assertTrue("Fill color was sent " + counts[0] + " times", counts[0] <= 2);
+        assertTrue("Alpha was sent " + counts[1] + " times", counts[1] >= 19);
+    }
+
+    @Test
+    public void testRedundantAlphaIsDropped() {
+        long[] counts = submit(() -> {
+            GraphicsDecoderShim.resetCounts();
+            getEngine().executeScript("var ctx = createContext();" +
+                    "ctx.globalAlpha = 0.5;" +
+                    "for (var i = 0; i < 20; i++) {" +
+                    "    ctx.fillStyle = (i % 2) ? 'rgb(0, 0, 255)' : 'rgb(255, 0, 0)';" +
+                    "    ctx.fillRect(0, 0, 10, 10);" +
+                    "}" +
+                    "pixel(ctx, 0, 0)");
+            return new long[] {
+                countFillColors(),
+                GraphicsDecoderShim.getCount(GraphicsDecoder.SETALPHA)
+            };
+        });
+        assertTrue("Fill color was sent " + counts[0] + " times", counts[0] >= 20);
+        assertTrue("Alpha was sent " + counts[1] + " times", counts[1] <= 2);
+    }
+
+    @Test
+    public void testStateIsRestored() {
+        executeScript("var ctx = createContext();" +
+                "ctx.fillStyle = 'rgb(255, 0, 0)';" +
+                "ctx.fillRect(0, 0, 10, 10);" +
+                "ctx.save();" +
+                "ctx.fillStyle = 'rgb(0, 0, 255)';" +
+                "ctx.globalAlpha = 0.5;" +
+                "ctx.fillRect(10, 0, 10, 10);" +
+                "ctx.restore();" +
+                // Red and opaque again, without being set
+                "ctx.fillRect(20, 0, 10, 10);" +
+                "ctx.save();" +
+                "ctx.fillStyle = 'rgb(0, 0, 255)';" +
+                "ctx.fillRect(30, 0, 10, 10);" +
+                "ctx.restore();" +
+                // Blue was current before the restore, it must be sent again
+                "ctx.fillStyle = 'rgb(0, 0, 255)';" +
+                "ctx.fillRect(40, 0, 10, 10);");
+
+        assertEquals("255,0,0,255", executeScript("pixel(ctx, 5, 5)"));
+        String[] blended = ((String) executeScript("pixel(ctx, 15, 5)")).split(",");
+        assertEquals("0", blended[0]);
+        assertTrue("Not translucent: " + blended[3], Integer.parseInt(blended[3]) < 200);
+        assertEquals("255,0,0,255", executeScript("pixel(ctx, 25, 5)"));
+        assertEquals("0,0,255,255", executeScript("pixel(ctx, 35, 5)"));
+        assertEquals("0,0,255,255", executeScript("pixel(ctx, 45, 5)"));
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.javafx.scene.web;
+
+import com.sun.webkit.WebPage;
+import com.sun.webkit.WebPageShim;
+import java.awt.Color;
+import java.awt.image.BufferedImage;
+import javafx.scene.web.WebEngineShim;
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertTrue;
+
+public class ImageDecoderTest extends TestBase {
+    // 3x2 red RGBA PNG
+    private static final String PNG = "data:image/png;base64,"
+            + "iVBORw0KGgoAAAANSUhEUgAAAAMAAAACCAYAAACddGYaAAAAEUlEQVR4nGP4z8DwH4YZkDkAm34L9XKwuTwAAAAASUVORK5CYII=";
+    // 5x4 GIF with a red and a blue frame
+    private static final String GIF = "data:image/gif;base64,"
+            + "R0lGODlhBQAEAIAAAP8AAAAA/yH/C05FVFNDQVBFMi4wAwEAAAAh+QQACgAAACwAAAAABQAEAAACEARBEARBEARBEARBEARBEAUA"
+            + "IfkEAAoAAAAsAAAAAAUABAAAAhAMwzAMwzAMwzAMwzAMwzAFADs=";
+    // 7x3 red 24 bit BMP
+    private static final String BMP = "data:image/bmp;base64,"
+            + "Qk1+AAAAAAAAADYAAAAoAAAABwAAAAMAAAABABgAAAAAAEgAAAATCwAAEwsAAAAAAAAAAAAAAAD/AAD/AAD/AAD/AAD/AAD/AAD/"
+            + "AAAAAAD/AAD/AAD/AAD/AAD/AAD/AAD/AAAAAAD/AAD/AAD/AAD/AAD/AAD/AAD/AAAA";
+
+    private void assertNaturalSize(String id, int width, int height) {
+        assertEquals(id + " width", width,
+                ((Number) executeScript("document.getElementById('" + id + "').naturalWidth")).intValue());
+        assertEquals(id + " height", height,
+                ((Number) executeScript("document.getElementById('" + id + "').naturalHeight")).intValue());
+    }
+
+    /**
+     * The image size is taken from the header before the image is decoded.
+     */
+    @Test public void testNaturalSize() {
+        loadContent("<html><body>"
+                + "<img id='png' src='" + PNG + "'>"
+                + "<img id='gif' src='" + GIF + "'>"
+                + "<img id='bmp' src='" + BMP + "'>"
+                + "</body></html>");
+        assertNaturalSize("png", 3, 2);
+        assertNaturalSize("gif", 5, 4);
+        assertNaturalSize("bmp", 7, 3);
+    }
+
+    /**
+     * The decoded frame is drawn once the background decode completes.
+     */
+    @Test public void testDecodedImagePainted() {
+        loadContent("<html><body style='margin: 0px 0px;'>"
+                + "<img src='" + PNG + "' style='width: 30px; height: 20px'>"
+                + "<img src='" + BMP + "' style='width: 70px; height: 30px'>"
+                + "</body></html>");
+        submit(() -> {
+            final WebPage webPage = WebEngineShim.getPage(getEngine());
+            assertNotNull(webPage);
+            final BufferedImage img = WebPageShim.paint(webPage, 0, 0, 200, 100);
+            assertNotNull(img);
+
+            final Color png = new Color(img.getRGB(15, 10), true);
+            assertTrue("PNG should be red:" + png, isColorsSimilar(Color.RED, png, 1));
+            final Color bmp = new Color(img.getRGB(65, 15), true);
+            assertTrue("BMP should be red:" + bmp, isColorsSimilar(Color.RED, bmp, 1));
+        });
+    }
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.javafx.scene.web;
+
+import com.sun.webkit.graphics.WCRenderQueue;
+import org.junit.Before;
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+/**
+ * Tests the recycling of the native buffers of the rendering queues. Each
+ * canvas records into a queue of its own, which hands full buffers to Java
+ * and gets them back once they are decoded.
+ */
+public class RenderingQueueTest extends TestBase {
+
+    private static final int WIDTH = 100;
+    private static final int HEIGHT = 80;
+
+    @Before
+    public void setUp() {
+        // One fillRect per pixel records far more than one buffer holds.
+        loadContent("<body><script>" +
+                "function createCanvas() {" +
+                "    var canvas = document.createElement('canvas');" +
+                "    canvas.width = " + WIDTH + ";" +
+                "    canvas.height = " + HEIGHT + ";" +
+                "    document.body.appendChild(canvas);" +
+                "    return canvas;" +
+                "}" +
+                "function fillPixels(canvas, color) {" +
+                "    var ctx = canvas.getContext('2d');" +
+                "    ctx.fillStyle = color;" +
+                "    for (var y = 0; y < canvas.height; y++) {" +
+                "        for (var x = 0; x < canvas.width; x++) {" +
+                "            ctx.fillRect(x, y, 1, 1);" +
+                "        }" +
+                "    }" +
+                "}" +
+                // Returns how many pixels differ from the color
+                "function countOtherPixels(canvas, r, g, b) {" +
+                "    var data = canvas.getContext('2d').getImageData(0, 0, canvas.width, canvas.height).data;" +
+                "    var count = 0;" +
+                "    for (var i = 0; i < data.length; i += 4) {" +
+                "        if (data[i] != r || data[i + 1] != g || data[i + 2] != b || data[i + 3] != 255) {" +
+                "            count++;" +
+                "        }" +
+                "    }" +
+                "    return count;" +
+                "}" +
+                "</script></body>");
+    }
+
+    private long[] getAndResetStatistics() {
+        return submit(() -> WCRenderQueue.getAndResetStatistics());
+    }
+
+    @Test
+    public void testReleasedBuffersAreReused() {
+        executeScript("var canvas = createCanvas();" +
+                "fillPixels(canvas, 'rgb(0, 0, 255)');" +
+                "countOtherPixels(canvas, 0, 0, 255)");
+        getAndResetStatistics();
+
+        for (int frame = 0; frame < 5; frame++) {
+            assertEquals(0, executeScript(
+                    "fillPixels(canvas, 'rgb(0, 255, 0)');" +
+                    "countOtherPixels(canvas, 0, 255, 0)"));
+        }
+
+        long[] stats = getAndResetStatistics();
+        assertTrue("No buffer was flushed",
+                stats[WCRenderQueue.STAT_BUFFERS_FLUSHED] > 5);
+        assertEquals("Buffers were allocated instead of reused",
+                0, stats[WCRenderQueue.STAT_BUFFERS_ALLOCATED]);
+    }
+
+    @Test
+    public void testBuffersInUseAreNotReused() {
+        // The buffers of the first canvas stay queued in Java until its
+        // pixels are read. Meanwhile the second canvas is reset, which
+        // disposes its queue with flushed buffers still queued, and both
+        // canvases record again.
+        executeScript("var first = createCanvas();" +
+                "var second = createCanvas();" +
+                "fillPixels(first, 'rgb(255, 0, 0)');" +
+                "fillPixels(second, 'rgb(0, 0, 255)');" +
+                "second.width = second.width;" +
+                "fillPixels(second, 'rgb(0, 255, 0)');");
+
+        assertEquals("Pixels of the first canvas were overwritten",
+                0, executeScript("countOtherPixels(first, 255, 0, 0)"));
+        assertEquals("Pixels of the reset canvas are wrong",
+                0, executeScript("countOtherPixels(second, 0, 255, 0)"));
+
+        // Once the queues are released their buffers are taken again
+        executeScript("fillPixels(first, 'rgb(0, 0, 255)')");
+        assertEquals(0, executeScript("countOtherPixels(first, 0, 0, 255)"));
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.javafx.scene.web;
+
+import org.junit.Before;
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assume.assumeTrue;
+
+/**
+ * Tests that timers of the native main thread run loop fire. The JavaFX
+ * event thread never runs that loop, it is woken up through
+ * MainThread.fwkScheduleDispatchFunctionsAfter once the earliest timer is
+ * due. Atomics.waitAsync timeouts are such timers; the shared memory they
+ * need comes from WebAssembly, so the tests only run where it is enabled.
+ */
+public class RunLoopTimerTest extends TestBase {
+
+    private static final long TIMEOUT_MILLIS = 10000;
+
+    @Before
+    public void setUp() {
+        loadContent("<script>" +
+                "var results = [];" +
+                "function waitFor(timeout) {" +
+                "    var memory = new WebAssembly.Memory({ initial: 1, maximum: 1, shared: true });" +
+                "    var cells = new Int32Array(memory.buffer);" +
+                "    var start = performance.now();" +
+                "    // A zero timeout gives the result at once instead of a promise" +
+                "    return Promise.resolve(Atomics.waitAsync(cells, 0, 0, timeout).value).then(function(result) {" +
+                "        results.push(timeout + ':' + result + ':' + (performance.now() - start >= timeout - 1));" +
+                "    });" +
+                "}" +
+                "</script>");
+        assumeTrue("WebAssembly is not enabled",
+                (Boolean) executeScript("typeof WebAssembly !== 'undefined'"));
+    }
+
+    private String awaitResults(int count) throws InterruptedException {
+        long deadline = System.currentTimeMillis() + TIMEOUT_MILLIS;
+        while ((Integer) executeScript("results.length") < count) {
+            assertTrue("Timeout waiting for run loop timers: " + executeScript("results.join()"),
+                    System.currentTimeMillis() < deadline);
+            Thread.sleep(20);
+        }
+        return (String) executeScript("results.join()");
+    }
+
+    @Test
+    public void testTimersFireInOrder() throws InterruptedException {
+        // Each timer started after the first one changes the earliest
+        // wake-up, and each one that fires re-arms the wake-up for the next.
+        executeScript("waitFor(300); waitFor(100); waitFor(200); waitFor(0)");
+        assertEquals("0:timed-out:true,100:timed-out:true,200:timed-out:true,300:timed-out:true",
+                awaitResults(4));
+    }
+
+    @Test
+    public void testTimersStartedFromTimers() throws InterruptedException {
+        // Every timer is started while the run loop is iterating.
+        executeScript("waitFor(50).then(function() {" +
+                "    return waitFor(50);" +
+                "}).then(function() {" +
+                "    return waitFor(50);" +
+                "})");
+        assertEquals("50:timed-out:true,50:timed-out:true,50:timed-out:true",
+                awaitResults(3));
+    }
+}
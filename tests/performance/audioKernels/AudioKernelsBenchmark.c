@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Measures the gstreamer-lite audio kernels that replace ORC at every
+ * instruction set level this machine supports and checks that each level
+ * writes the same bits as the generated C code in the -dist.c files. Only
+ * the glib headers are needed, for example on Linux
+ *
+ *   M=modules/javafx.media/src/main/native/gstreamer
+ *   A=$M/gstreamer-lite/gst-plugins-base/gst-libs/gst/audio
+ *   V=$M/gstreamer-lite/gst-plugins-base/gst/volume
+ *   cc -O2 -DGSTREAMER_LITE -DDISABLE_ORC $(pkg-config --cflags glib-2.0) \
+ *      -I$M/gstreamer-lite/gst-plugins-base/gst-libs -I$A -I$V \
+ *      tests/performance/audioKernels/AudioKernelsBenchmark.c \
+ *      $A/gstaudiopack-simd.c $A/gstaudiopack-dist.c \
+ *      $V/gstvolumesimd.c $V/gstvolumeorc-dist.c
+ *
+ * and run it with an optional number of samples per call, 4096 by default.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "gstaudiopack-simd.h"
+#include "gstaudiopack-dist.h"
+#include "gstvolumesimd.h"
+#include "gstvolumeorc-dist.h"
+
+#define ITERATIONS 2000
+
+static const char *level_names[] = { "C", "SSE2", "AVX2" };
+
+/* Bit patterns the kernels must treat like the C code */
+static const guint32 special_f32[] = {
+    0x00000000, 0x80000000, 0x00000001, 0x807fffff, 0x00800000, 0x80800000,
+    0x7f7fffff, 0xff7fffff, 0x7f800000, 0xff800000, 0x7fc00000, 0xffc00001,
+    0x3f800000, 0xbf800000
+};
+static const guint64 special_f64[] = {
+    G_GUINT64_CONSTANT (0x0000000000000000),
+    G_GUINT64_CONSTANT (0x8000000000000000),
+    G_GUINT64_CONSTANT (0x0000000000000001),
+    G_GUINT64_CONSTANT (0x800fffffffffffff),
+    G_GUINT64_CONSTANT (0x0010000000000000),
+    G_GUINT64_CONSTANT (0x3810000000000000),
+    G_GUINT64_CONSTANT (0x3800000000000000),
+    G_GUINT64_CONSTANT (0x7fefffffffffffff),
+    G_GUINT64_CONSTANT (0x7ff0000000000000),
+    G_GUINT64_CONSTANT (0xfff0000000000000),
+    G_GUINT64_CONSTANT (0x7ff8000000000000),
+    G_GUINT64_CONSTANT (0xfff8000000000001),
+    G_GUINT64_CONSTANT (0x3ff0000000000000),
+    G_GUINT64_CONSTANT (0xbff0000000000000),
+    G_GUINT64_CONSTANT (0x3fefffffffffffff),
+    G_GUINT64_CONSTANT (0xbff0000000000001)
+};
+static const guint32 special_s32[] = {
+    0x00000000, 0x7fffffff, 0x80000000, 0x80000001, 0x7fff0000, 0xffffffff,
+    0x00008000, 0xffff8000
+};
+
+#define SPECIALS(a) (int) (sizeof (a) / sizeof (a[0]))
+
+typedef struct
+{
+  const char *name;
+  size_t in_size, out_size;
+  /* Fills the input, the output buffer is updated in place when in_size is 0 */
+  void (*fill) (void *in, int n);
+  void (*simd) (void *out, const void *in, int n);
+  void (*dist) (void *out, const void *in, int n);
+} Kernel;
+
+static double
+now (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static guint32
+random32 (void)
+{
+  return ((guint32) rand () << 16) ^ (guint32) rand ();
+}
+
+static void
+fill_s16 (void *in, int n)
+{
+  gint16 *p = in;
+  int i;
+  for (i = 0; i < n; i++)
+    p[i] = (gint16) random32 ();
+  if (n > 2) {
+    p[0] = G_MININT16;
+    p[1] = G_MAXINT16;
+  }
+}
+
+static void
+fill_s32 (void *in, int n)
+{
+  guint32 *p = in;
+  int i;
+  for (i = 0; i < n; i++)
+    p[i] = (i % 3 == 0) ? special_s32[i / 3 % SPECIALS (special_s32)]
+        : random32 ();
+}
+
+static void
+fill_f32 (void *in, int n)
+{
+  guint32 *p = in;
+  int i;
+  for (i = 0; i < n; i++) {
+    union { gfloat f; guint32 i; } u;
+    u.f = (gfloat) (rand () / (double) RAND_MAX * 2.0 - 1.0);
+    p[i] = (i % 3 == 0) ? special_f32[i / 3 % SPECIALS (special_f32)] : u.i;
+  }
+}
+
+static void
+fill_f64 (void *in, int n)
+{
+  guint64 *p = in;
+  int i;
+  for (i = 0; i < n; i++) {
+    union { gdouble f; guint64 i; } u;
+    u.f = rand () / (double) RAND_MAX * 2.2 - 1.1;
+    p[i] = (i % 3 == 0) ? special_f64[i / 3 % SPECIALS (special_f64)] : u.i;
+  }
+}
+
+#define WRAP(name, out_type, in_type, call) \
+static void name (void *out, const void *in, int n) \
+{ \
+  out_type *d = out; \
+  const in_type *s = in; \
+  (void) s; \
+  call; \
+}
+
+WRAP (simd_unpack_s16, gint32, guint8, audio_simd_unpack_s16 (d, s, n))
+WRAP (dist_unpack_s16, gint32, guint8, audio_orc_unpack_s16 (d, s, n))
+WRAP (simd_pack_s16, guint8, gint32, audio_simd_pack_s16 (d, s, n))
+WRAP (dist_pack_s16, guint8, gint32, audio_orc_pack_s16 (d, s, n))
+WRAP (simd_unpack_f32, gdouble, gfloat, audio_simd_unpack_f32 (d, s, n))
+WRAP (dist_unpack_f32, gdouble, gfloat, audio_orc_unpack_f32 (d, s, n))
+WRAP (simd_pack_f32, gfloat, gdouble, audio_simd_pack_f32 (d, s, n))
+WRAP (dist_pack_f32, gfloat, gdouble, audio_orc_pack_f32 (d, s, n))
+WRAP (simd_s32_to_double, gdouble, gint32, audio_simd_s32_to_double (d, s, n))
+WRAP (dist_s32_to_double, gdouble, gint32, audio_orc_s32_to_double (d, s, n))
+WRAP (simd_double_to_s32, gint32, gdouble, audio_simd_double_to_s32 (d, s, n))
+WRAP (dist_double_to_s32, gint32, gdouble, audio_orc_double_to_s32 (d, s, n))
+WRAP (simd_int_bias, gint32, gint32,
+    audio_simd_int_bias (d, s, 0x12345, 0xffff0000, n))
+WRAP (dist_int_bias, gint32, gint32,
+    audio_orc_int_bias (d, s, 0x12345, 0xffff0000, n))
+WRAP (simd_volume_f64, gdouble, void,
+    volume_simd_scalarmultiply_f64_ns (d, 0.7, n))
+WRAP (dist_volume_f64, gdouble, void,
+    volume_orc_scalarmultiply_f64_ns (d, 0.7, n))
+WRAP (simd_volume_f32, gfloat, void,
+    volume_simd_scalarmultiply_f32_ns (d, 0.7f, n))
+WRAP (dist_volume_f32, gfloat, void,
+    volume_orc_scalarmultiply_f32_ns (d, 0.7f, n))
+WRAP (simd_volume_s16, gint16, void, volume_simd_process_int16 (d, 3000, n))
+WRAP (dist_volume_s16, gint16, void, volume_orc_process_int16 (d, 3000, n))
+WRAP (simd_volume_s16_clamp, gint16, void,
+    volume_simd_process_int16_clamp (d, 3000, n))
+WRAP (dist_volume_s16_clamp, gint16, void,
+    volume_orc_process_int16_clamp (d, 3000, n))
+
+static const Kernel kernels[] = {
+  {"unpack_s16", 2, 4, fill_s16, simd_unpack_s16, dist_unpack_s16},
+  {"pack_s16", 4, 2, fill_s32, simd_pack_s16, dist_pack_s16},
+  {"unpack_f32", 4, 8, fill_f32, simd_unpack_f32, dist_unpack_f32},
+  {"pack_f32", 8, 4, fill_f64, simd_pack_f32, dist_pack_f32},
+  {"s32_to_double", 4, 8, fill_s32, simd_s32_to_double, dist_s32_to_double},
+  {"double_to_s32", 8, 4, fill_f64, simd_double_to_s32, dist_double_to_s32},
+  {"int_bias", 4, 4, fill_s32, simd_int_bias, dist_int_bias},
+  {"volume_f64", 0, 8, fill_f64, simd_volume_f64, dist_volume_f64},
+  {"volume_f32", 0, 4, fill_f32, simd_volume_f32, dist_volume_f32},
+  {"volume_s16", 0, 2, fill_s16, simd_volume_s16, dist_volume_s16},
+  {"volume_s16_clamp", 0, 2, fill_s16, simd_volume_s16_clamp,
+      dist_volume_s16_clamp},
+};
+
+#define KERNELS (int) (sizeof (kernels) / sizeof (kernels[0]))
+
+/* Runs both versions on every length up to 67 and on odd offsets */
+static int
+check (const Kernel * k, int level)
+{
+  size_t in_size = k->in_size ? k->in_size : k->out_size;
+  guint8 *in = malloc (in_size * 80);
+  guint8 *expected = malloc (k->out_size * 80);
+  guint8 *actual = malloc (k->out_size * 80);
+  int n, offset, errors = 0;
+
+  for (n = 0; n < 68; n++) {
+    for (offset = 0; offset < 3; offset++) {
+      void *src = in + offset * in_size;
+
+      k->fill (src, n);
+      memset (expected, 0x55, k->out_size * 80);
+      memset (actual, 0x55, k->out_size * 80);
+      if (k->in_size) {
+        k->dist (expected + offset * k->out_size, src, n);
+        audio_simd_set_level (level);
+        k->simd (actual + offset * k->out_size, src, n);
+      } else {
+        memcpy (expected + offset * k->out_size, src, n * k->out_size);
+        memcpy (actual + offset * k->out_size, src, n * k->out_size);
+        k->dist (expected + offset * k->out_size, NULL, n);
+        audio_simd_set_level (level);
+        k->simd (actual + offset * k->out_size, NULL, n);
+      }
+      if (memcmp (expected, actual, k->out_size * 80) != 0)
+        errors++;
+    }
+  }
+  free (in);
+  free (expected);
+  free (actual);
+  return errors;
+}
+
+static double
+measure (const Kernel * k, int n, gboolean simd)
+{
+  size_t in_size = k->in_size ? k->in_size : k->out_size;
+  void *in = malloc (in_size * n);
+  void *out = malloc (k->out_size * n);
+  double start;
+  int i;
+
+  k->fill (in, n);
+  memcpy (out, in, k->in_size ? 0 : k->out_size * n);
+  start = now ();
+  for (i = 0; i < ITERATIONS; i++) {
+    if (k->in_size)
+      (simd ? k->simd : k->dist) (out, in, n);
+    else
+      (simd ? k->simd : k->dist) (out, NULL, n);
+  }
+  start = now () - start;
+  free (in);
+  free (out);
+  return start;
+}
+
+int
+main (int argc, char **argv)
+{
+  int n = argc > 1 ? atoi (argv[1]) : 4096;
+  int best = audio_simd_get_level ();
+  int level, i, failures = 0;
+
+  if (n <= 0) {
+    fprintf (stderr, "usage: %s [samples]\n", argv[0]);
+    return 2;
+  }
+
+  for (level = AUDIO_SIMD_SSE2; level <= best; level++) {
+    for (i = 0; i < KERNELS; i++) {
+      int errors = check (&kernels[i], level);
+      if (errors) {
+        printf ("%s %s: %d mismatching runs\n", level_names[level],
+            kernels[i].name, errors);
+        failures++;
+      }
+    }
+  }
+  if (failures)
+    return 1;
+  printf ("All levels up to %s match the C code\n\n", level_names[best]);
+
+  printf ("%-18s %10s", "Msamples/s", "C");
+  for (level = AUDIO_SIMD_SSE2; level <= best; level++)
+    printf (" %10s", level_names[level]);
+  printf ("\n");
+  for (i = 0; i < KERNELS; i++) {
+    double samples = (double) n * ITERATIONS / 1e6;
+
+    printf ("%-18s %10.0f", kernels[i].name,
+        samples / measure (&kernels[i], n, FALSE));
+    for (level = AUDIO_SIMD_SSE2; level <= best; level++) {
+      audio_simd_set_level (level);
+      printf (" %10.0f", samples / measure (&kernels[i], n, TRUE));
+    }
+    printf ("\n");
+  }
+  return 0;
+}
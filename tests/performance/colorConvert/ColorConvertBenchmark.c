@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Measures the media color converters at every instruction set level this
+ * machine supports and checks that each level produces the same pixels as
+ * the table based C code. Build it next to the converter, for example
+ *
+ *   cc -O2 -DLINUX -I modules/javafx.media/src/main/native/jfxmedia \
+ *      tests/performance/colorConvert/ColorConvertBenchmark.c \
+ *      modules/javafx.media/src/main/native/jfxmedia/Utils/ColorConverter.c
+ *
+ * and run it with an optional frame size, 1920x1080 by default.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <Utils/ColorConverter.h>
+
+#define FRAMES 100
+
+typedef struct {
+    int32_t width, height;
+    uint8_t *y, *u, *v, *a, *packed;
+    int32_t y_stride, uv_stride, a_stride, packed_stride;
+    uint8_t *dst;
+    int32_t dst_stride;
+} Frame;
+
+static const char *level_names[] = { "C", "SSE2", "AVX2" };
+static const char *case_names[] = {
+    "420 ARGB", "420 ARGB no alpha", "420 BGRA", "420 BGRA no alpha",
+    "422 ARGB no alpha", "422 BGRA no alpha"
+};
+#define CASES (int)(sizeof(case_names) / sizeof(case_names[0]))
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void fill(uint8_t *p, size_t size)
+{
+    size_t i;
+    for (i = 0; i < size; i++)
+        p[i] = (uint8_t)rand();
+}
+
+static Frame *frame_new(int32_t width, int32_t height)
+{
+    Frame *f = calloc(1, sizeof(Frame));
+    int32_t chroma_height = (height + 1) / 2;
+
+    f->width = width;
+    f->height = height;
+    // Odd strides so that no kernel relies on alignment
+    f->y_stride = width + 3;
+    f->uv_stride = (width + 1) / 2 + 5;
+    f->a_stride = width + 7;
+    f->packed_stride = ((width + 1) / 2) * 4 + 1;
+    f->dst_stride = width * 4 + 4;
+
+    f->y = malloc((size_t)f->y_stride * height);
+    f->u = malloc((size_t)f->uv_stride * chroma_height);
+    f->v = malloc((size_t)f->uv_stride * chroma_height);
+    f->a = malloc((size_t)f->a_stride * height);
+    f->packed = malloc((size_t)f->packed_stride * height);
+    f->dst = malloc((size_t)f->dst_stride * height);
+
+    fill(f->y, (size_t)f->y_stride * height);
+    fill(f->u, (size_t)f->uv_stride * chroma_height);
+    fill(f->v, (size_t)f->uv_stride * chroma_height);
+    fill(f->a, (size_t)f->a_stride * height);
+    fill(f->packed, (size_t)f->packed_stride * height);
+    return f;
+}
+
+static void frame_free(Frame *f)
+{
+    free(f->y);
+    free(f->u);
+    free(f->v);
+    free(f->a);
+    free(f->packed);
+    free(f->dst);
+    free(f);
+}
+
+static int convert(Frame *f, int which)
+{
+    // Packed 4:2:2 is laid out as U Y V Y
+    switch (which) {
+        case 0:
+            return ColorConvert_YCbCr420p_to_ARGB32(f->dst, f->dst_stride, f->width, f->height,
+                    f->y, f->v, f->u, f->a, f->y_stride, f->uv_stride, f->uv_stride, f->a_stride);
+        case 1:
+            return ColorConvert_YCbCr420p_to_ARGB32_no_alpha(f->dst, f->dst_stride, f->width, f->height,
+                    f->y, f->v, f->u, f->y_stride, f->uv_stride, f->uv_stride);
+        case 2:
+            return ColorConvert_YCbCr420p_to_BGRA32(f->dst, f->dst_stride, f->width, f->height,
+                    f->y, f->v, f->u, f->a, f->y_stride, f->uv_stride, f->uv_stride, f->a_stride);
+        case 3:
+            return ColorConvert_YCbCr420p_to_BGRA32_no_alpha(f->dst, f->dst_stride, f->width, f->height,
+                    f->y, f->v, f->u, f->y_stride, f->uv_stride, f->uv_stride);
+        case 4:
+            return ColorConvert_YCbCr422p_to_ARGB32_no_alpha(f->dst, f->dst_stride, f->width, f->height,
+                    f->packed + 1, f->packed + 2, f->packed, f->packed_stride, f->packed_stride);
+        default:
+            return ColorConvert_YCbCr422p_to_BGRA32_no_alpha(f->dst, f->dst_stride, f->width, f->height,
+                    f->packed + 1, f->packed + 2, f->packed, f->packed_stride, f->packed_stride);
+    }
+}
+
+// Compares every level against the C code on a few awkward frame sizes
+static int verify(void)
+{
+    static const int32_t sizes[][2] = { { 2, 2 }, { 17, 3 }, { 33, 5 }, { 70, 9 }, { 641, 7 } };
+    int failures = 0;
+    size_t s;
+    int level, which;
+    int32_t row;
+
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        Frame *f = frame_new(sizes[s][0], sizes[s][1]);
+        size_t size = (size_t)f->dst_stride * f->height;
+        uint8_t *expected = malloc(size);
+
+        for (which = 0; which < CASES; which++) {
+            ColorConvert_SetLevel(COLOR_CONVERT_C);
+            memset(f->dst, 0, size);
+            convert(f, which);
+            memcpy(expected, f->dst, size);
+
+            for (level = COLOR_CONVERT_SSE2; level <= COLOR_CONVERT_AVX2; level++) {
+                if (ColorConvert_SetLevel(level) != level)
+                    continue;
+                memset(f->dst, 0, size);
+                convert(f, which);
+                for (row = 0; row < f->height; row++) {
+                    if (memcmp(expected + (size_t)row * f->dst_stride,
+                               f->dst + (size_t)row * f->dst_stride, (size_t)f->width * 4) != 0) {
+                        printf("MISMATCH %s %s %dx%d row %d\n", level_names[level], case_names[which],
+                               f->width, f->height, row);
+                        failures++;
+                        break;
+                    }
+                }
+            }
+        }
+        free(expected);
+        frame_free(f);
+    }
+    return failures;
+}
+
+int main(int argc, char **argv)
+{
+    int32_t width = 1920, height = 1080;
+    int best, level, which, i;
+    Frame *f;
+
+    if (argc > 1 && sscanf(argv[1], "%dx%d", &width, &height) != 2) {
+        fprintf(stderr, "Usage: %s [WIDTHxHEIGHT]\n", argv[0]);
+        return 1;
+    }
+
+    best = ColorConvert_GetLevel();
+    if (verify() != 0)
+        return 1;
+
+    f = frame_new(width, height);
+    printf("%dx%d, %d frames, Mpixel/s\n", width, height, FRAMES);
+    printf("%-20s", "");
+    for (level = COLOR_CONVERT_C; level <= COLOR_CONVERT_AVX2; level++) {
+        if (ColorConvert_SetLevel(level) == level)
+            printf("%10s", level_names[level]);
+    }
+    printf("\n");
+
+    for (which = 0; which < CASES; which++) {
+        printf("%-20s", case_names[which]);
+        for (level = COLOR_CONVERT_C; level <= COLOR_CONVERT_AVX2; level++) {
+            double start;
+            if (ColorConvert_SetLevel(level) != level)
+                continue;
+            convert(f, which);  // warm up
+            start = now();
+            for (i = 0; i < FRAMES; i++)
+                convert(f, which);
+            printf("%10.1f", (double)width * height * FRAMES / (now() - start) / 1e6);
+        }
+        printf("\n");
+    }
+
+    ColorConvert_SetLevel(best);
+    frame_free(f);
+    return 0;
+}
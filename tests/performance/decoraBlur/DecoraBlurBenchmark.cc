@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Measures the separable Decora blur, shadow and convolve kernels of the SSE
+ * peers at every SIMD level this machine supports, on one thread and on the
+ * worker pool, and checks that each run produces the same pixels as the
+ * scalar code on one thread. Build it next to the kernels, for example
+ *
+ *   c++ -O2 -ffast-math -pthread -I $JAVA_HOME/include \
+ *      -I $JAVA_HOME/include/linux \
+ *      -I modules/javafx.graphics/src/main/native-decora \
+ *      tests/performance/decoraBlur/DecoraBlurBenchmark.cc \
+ *      modules/javafx.graphics/src/main/native-decora/SSEFilters.cc \
+ *      modules/javafx.graphics/src/main/native-decora/SSEWorkers.cc
+ *
+ * and run it with an optional image size and radius, 1024x1024 and 10 by
+ * default.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+#include "SSEFilters.h"
+
+#define PASSES 10
+
+enum { BOX_BLUR, BOX_SHADOW, CONVOLVE, CONVOLVE_SHADOW, FILTERS };
+
+static const char *filterNames[] = {
+    "box blur", "box shadow", "convolve", "convolve shadow"
+};
+static const char *levelNames[] = { "C", "SSE4.1", "AVX2" };
+
+struct Image {
+    jint w, h;
+    jint *pixels;
+};
+
+struct FilterRun {
+    int filter;
+    jint radius;
+    bool parallel;
+    Image src;
+    Image tmp;
+    Image dst;
+    jfloat kvals[2 * 256];
+    jint kernelSize;
+    jint shadowRGBs[256];
+    jfloat shadowColor[4];
+};
+
+struct RowPass {
+    FilterRun *run;
+    jint *dst;
+    jint dstw, dsth, dstscan;
+    jint *src;
+    jint srcw, srch, srcscan;
+    bool vertical;
+    bool last;
+};
+
+static void allocate(Image *image, jint w, jint h)
+{
+    image->w = w;
+    image->h = h;
+    image->pixels = (jint *) calloc((size_t) w * h, sizeof(jint));
+}
+
+static void fillPremultiplied(Image *image, unsigned seed)
+{
+    jint n = image->w * image->h;
+    for (jint i = 0; i < n; i++) {
+        seed = seed * 1103515245u + 12345u;
+        jint a = (seed >> 8) & 0xff;
+        // Mix in transparent and opaque runs to cover the edge cases.
+        if ((i / 37) % 5 == 0) a = 0;
+        if ((i / 53) % 7 == 0) a = 0xff;
+        jint r = a ? (jint) ((seed >> 16) % (a + 1)) : 0;
+        jint g = a ? (jint) ((seed >> 4) % (a + 1)) : 0;
+        jint b = a ? (jint) ((seed >> 20) % (a + 1)) : 0;
+        image->pixels[i] = (a << 24) | (r << 16) | (g << 8) | b;
+    }
+}
+
+static void passBody(void *ctx, jint start, jint end)
+{
+    RowPass *p = (RowPass *) ctx;
+    FilterRun *run = p->run;
+    switch (run->filter) {
+    case BOX_BLUR:
+        if (p->vertical) {
+            boxBlurColumns(p->dst, p->dsth, p->dstscan,
+                           p->src, p->srch, p->srcscan, start, end);
+        } else {
+            boxBlurRows(p->dst, p->dstw, p->dstscan,
+                        p->src, p->srcw, p->srcscan, start, end);
+        }
+        break;
+    case BOX_SHADOW:
+        if (p->vertical) {
+            boxShadowColumns(p->dst, p->dsth, p->dstscan,
+                             p->src, p->srch, p->srcscan, 0.25f,
+                             p->last ? run->shadowColor : NULL, start, end);
+        } else {
+            boxShadowRowsBlack(p->dst, p->dstw, p->dstscan,
+                               p->src, p->srcw, p->srcscan, 0.25f, start, end);
+        }
+        break;
+    case CONVOLVE:
+        if (p->vertical) {
+            convolveRows(p->dst, p->dsth, p->dstscan, 1,
+                         p->src, p->srch, p->srcscan, 1,
+                         run->kvals, run->kernelSize, start, end);
+        } else {
+            convolveRows(p->dst, p->dstw, 1, p->dstscan,
+                         p->src, p->srcw, 1, p->srcscan,
+                         run->kvals, run->kernelSize, start, end);
+        }
+        break;
+    case CONVOLVE_SHADOW:
+        if (p->vertical) {
+            convolveShadowRows(p->dst, p->dsth, p->dstscan, 1,
+                               p->src, p->srch, p->srcscan, 1,
+                               run->kvals, run->kernelSize, run->shadowRGBs,
+                               start, end);
+        } else {
+            convolveRows(p->dst, p->dstw, 1, p->dstscan,
+                         p->src, p->srcw, 1, p->srcscan,
+                         run->kvals, run->kernelSize, start, end);
+        }
+        break;
+    }
+}
+
+static void runPass(FilterRun *run, Image *dst, Image *src, bool vertical, bool last)
+{
+    RowPass p;
+    p.run = run;
+    p.dst = dst->pixels;
+    p.dstw = dst->w;
+    p.dsth = dst->h;
+    p.dstscan = dst->w;
+    p.src = src->pixels;
+    p.srcw = src->w;
+    p.srch = src->h;
+    p.srcscan = src->w;
+    p.vertical = vertical;
+    p.last = last;
+    jint count = vertical ? dst->w : dst->h;
+    jint grain = (vertical && run->filter <= BOX_SHADOW) ? FILTER_COLUMN_BLOCK
+                 : (run->filter >= CONVOLVE) ? FILTER_ROW_GROUP : 4;
+    if (run->parallel) {
+        parallelFor(count, grain, (jlong) dst->w * dst->h * 2 * run->radius,
+                    passBody, &p);
+    } else {
+        passBody(&p, 0, count);
+    }
+}
+
+/* Runs the horizontal and the vertical pass, leaving the result in dst. */
+static void runFilter(FilterRun *run)
+{
+    runPass(run, &run->tmp, &run->src, false, false);
+    runPass(run, &run->dst, &run->tmp, true, true);
+}
+
+static void setup(FilterRun *run, int filter, jint w, jint h, jint radius,
+                  bool parallel, Image *src)
+{
+    memset(run, 0, sizeof(*run));
+    run->filter = filter;
+    run->radius = radius;
+    run->parallel = parallel;
+    run->src = *src;
+    jint grow = 2 * radius;
+    allocate(&run->tmp, w + grow, h);
+    allocate(&run->dst, w + grow, h + grow);
+    run->kernelSize = 2 * radius + 1;
+    jfloat total = 0.0f;
+    for (jint i = 0; i < run->kernelSize; i++) {
+        jfloat d = (jfloat) (i - radius) / (radius + 1);
+        run->kvals[i] = 1.0f - d * d;
+        total += run->kvals[i];
+    }
+    for (jint i = 0; i < run->kernelSize; i++) {
+        run->kvals[i] /= total;
+        run->kvals[i + run->kernelSize] = run->kvals[i];
+    }
+    run->shadowColor[0] = 0.25f;
+    run->shadowColor[1] = 0.5f;
+    run->shadowColor[2] = 0.75f;
+    run->shadowColor[3] = 1.0f;
+    for (jint a = 0; a < 256; a++) {
+        run->shadowRGBs[a] = (a << 24) | ((a / 4) << 16) | ((a / 2) << 8) | (a * 3 / 4);
+    }
+}
+
+static void release(FilterRun *run)
+{
+    free(run->tmp.pixels);
+    free(run->dst.pixels);
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/* Checks the filters against the scalar code on awkward sizes. */
+static int checkEdgeCases()
+{
+    static const jint sizes[][2] = {
+        { 1, 1 }, { 3, 2 }, { 7, 13 }, { 17, 9 }, { 65, 33 }, { 130, 71 }, { 257, 5 }
+    };
+    static const jint radii[] = { 1, 2, 3, 7, 16, 40 };
+    jint best = getSIMDLevel();
+    int failures = 0;
+    for (const jint *size : sizes) {
+        Image src;
+        allocate(&src, size[0], size[1]);
+        fillPremultiplied(&src, (unsigned) (size[0] * 31 + size[1]));
+        for (jint radius : radii) {
+            for (int filter = 0; filter < FILTERS; filter++) {
+                FilterRun ref;
+                setSIMDLevel(DECORA_SIMD_C);
+                setup(&ref, filter, size[0], size[1], radius, false, &src);
+                runFilter(&ref);
+                for (jint level = DECORA_SIMD_C; level <= best; level++) {
+                    for (int parallel = 0; parallel < 2; parallel++) {
+                        FilterRun run;
+                        setSIMDLevel(level);
+                        setup(&run, filter, size[0], size[1], radius, parallel != 0, &src);
+                        runFilter(&run);
+                        size_t n = (size_t) run.dst.w * run.dst.h;
+                        if (memcmp(run.dst.pixels, ref.dst.pixels, n * sizeof(jint)) != 0 ||
+                            memcmp(run.tmp.pixels, ref.tmp.pixels,
+                                   (size_t) run.tmp.w * run.tmp.h * sizeof(jint)) != 0)
+                        {
+                            printf("MISMATCH %s %s%s %dx%d radius %d\n",
+                                   filterNames[filter], levelNames[level],
+                                   parallel ? " parallel" : "",
+                                   size[0], size[1], radius);
+                            failures++;
+                        }
+                        release(&run);
+                    }
+                }
+                release(&ref);
+            }
+        }
+        free(src.pixels);
+    }
+    setSIMDLevel(best);
+    return failures;
+}
+
+int main(int argc, char **argv)
+{
+    jint w = 1024, h = 1024, radius = 10;
+    if (argc > 1 && sscanf(argv[1], "%dx%d", &w, &h) != 2) {
+        fprintf(stderr, "usage: %s [WIDTHxHEIGHT] [RADIUS]\n", argv[0]);
+        return 2;
+    }
+    if (argc > 2) {
+        radius = atoi(argv[2]);
+    }
+    if (w <= 0 || h <= 0 || radius < 1 || radius > 127) {
+        fprintf(stderr, "bad size or radius\n");
+        return 2;
+    }
+
+    jint best = getSIMDLevel();
+    printf("best SIMD level: %s\n", levelNames[best]);
+    int failures = checkEdgeCases();
+
+    Image src;
+    allocate(&src, w, h);
+    fillPremultiplied(&src, 1);
+    printf("%dx%d radius %d, %d passes, Mpixel/s of output\n", w, h, radius, PASSES);
+    printf("%-16s %-8s %12s %12s\n", "filter", "level", "1 thread", "pool");
+    for (int filter = 0; filter < FILTERS; filter++) {
+        FilterRun ref;
+        setSIMDLevel(DECORA_SIMD_C);
+        setup(&ref, filter, w, h, radius, false, &src);
+        runFilter(&ref);
+        for (jint level = DECORA_SIMD_C; level <= best; level++) {
+            double rate[2];
+            for (int parallel = 0; parallel < 2; parallel++) {
+                FilterRun run;
+                setSIMDLevel(level);
+                setup(&run, filter, w, h, radius, parallel != 0, &src);
+                runFilter(&run);
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                for (int i = 0; i < PASSES; i++) {
+                    runFilter(&run);
+                }
+                double seconds = secondsSince(start);
+                rate[parallel] = (double) run.dst.w * run.dst.h * PASSES / seconds / 1e6;
+                if (memcmp(run.dst.pixels, ref.dst.pixels,
+                           (size_t) run.dst.w * run.dst.h * sizeof(jint)) != 0)
+                {
+                    printf("MISMATCH %s %s%s\n", filterNames[filter],
+                           levelNames[level], parallel ? " parallel" : "");
+                    failures++;
+                }
+                release(&run);
+            }
+            printf("%-16s %-8s %12.1f %12.1f\n", filterNames[filter],
+                   levelNames[level], rate[0], rate[1]);
+        }
+        release(&ref);
+    }
+    setSIMDLevel(best);
+    free(src.pixels);
+
+    printf(failures ? "%d mismatches\n" : "all levels match the C code\n", failures);
+    return failures ? 1 : 0;
+}
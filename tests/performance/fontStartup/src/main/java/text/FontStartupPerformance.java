@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package text;
+
+import java.io.BufferedReader;
+import java.io.IOException;
+import java.io.InputStreamReader;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.scene.text.Font;
+import javafx.scene.text.Text;
+import javafx.stage.Stage;
+
+/**
+ * Measures how long the font subsystem takes to initialise in a new
+ * process: listing the font families, creating the default and a named
+ * font and laying out a string. Each measurement runs in a fresh JVM,
+ * first with the fontconfig cache disabled, then with it enabled. The
+ * first cached run writes the cache if there is none yet, the following
+ * runs read it. Run it
+ * with the same module path and options as any JavaFX application,
+ * optionally with the number of runs per mode as argument.
+ */
+public class FontStartupPerformance extends Application {
+    private static final String CHILD = "--child";
+    private static final String RESULT = "font startup ms ";
+
+    @Override
+    public void start(Stage primaryStage) {
+        long t0 = System.nanoTime();
+        List<String> families = Font.getFamilies();
+        Font font = Font.font(families.get(families.size() / 2), 14);
+        Text text = new Text("The quick brown fox jumps over the lazy dog");
+        text.setFont(Font.getDefault());
+        text.getLayoutBounds();
+        text.setFont(font);
+        text.getLayoutBounds();
+        long t1 = System.nanoTime();
+        System.out.println(RESULT + (t1 - t0) / 1e6 + " " + families.size());
+        Platform.exit();
+    }
+
+    private static double[] runChild(boolean cache) throws IOException, InterruptedException {
+        List<String> cmd = new ArrayList<>();
+        cmd.add(ProcessHandle.current().info().command().orElse("java"));
+        String modulePath = System.getProperty("jdk.module.path");
+        if (modulePath != null) {
+            cmd.add("--module-path");
+            cmd.add(modulePath);
+            cmd.add("--add-modules");
+            cmd.add("javafx.graphics");
+        }
+        cmd.add("-cp");
+        cmd.add(System.getProperty("java.class.path"));
+        cmd.add("-Dprism.fontconfigCache=" + cache);
+        cmd.add(FontStartupPerformance.class.getName());
+        cmd.add(CHILD);
+        Process p = new ProcessBuilder(cmd).redirectErrorStream(true).start();
+        double[] result = null;
+        try (BufferedReader r = new BufferedReader(new InputStreamReader(p.getInputStream()))) {
+            String line;
+            while ((line = r.readLine()) != null) {
+                if (line.startsWith(RESULT)) {
+                    String[] f = line.substring(RESULT.length()).split(" ");
+                    result = new double[] { Double.parseDouble(f[0]), Double.parseDouble(f[1]) };
+                } else {
+                    System.out.println("  " + line);
+                }
+            }
+        }
+        p.waitFor();
+        if (result == null) {
+            throw new IOException("No result from child process, exit code " + p.exitValue());
+        }
+        return result;
+    }
+
+    public static void main(String[] args) throws Exception {
+        if (args.length > 0 && CHILD.equals(args[0])) {
+            Application.launch(args);
+            return;
+        }
+        int runs = args.length > 0 ? Integer.parseInt(args[0]) : 5;
+        for (boolean cache : new boolean[] { false, true }) {
+            double[] times = new double[runs];
+            int families = 0;
+            for (int i = 0; i < runs; i++) {
+                double[] r = runChild(cache);
+                times[i] = r[0];
+                families = (int) r[1];
+            }
+            double first = times[0];
+            Arrays.sort(times);
+            System.out.printf("fontconfig cache %-5s first %8.1f ms, median %8.1f ms (%d runs, %d families)\n",
+                    cache, first, times[runs / 2], runs, families);
+        }
+    }
+}
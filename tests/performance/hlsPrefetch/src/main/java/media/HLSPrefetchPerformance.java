@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package media;
+
+import com.sun.media.jfxmedia.MediaManager;
+import com.sun.media.jfxmedia.MediaPlayer;
+import com.sun.media.jfxmedia.events.PlayerStateEvent;
+import com.sun.media.jfxmedia.events.PlayerStateListener;
+import com.sun.media.jfxmedia.locator.HLSStatistics;
+import com.sun.media.jfxmedia.locator.Locator;
+import com.sun.net.httpserver.HttpExchange;
+import com.sun.net.httpserver.HttpServer;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.net.InetAddress;
+import java.net.InetSocketAddress;
+import java.net.URI;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.Executors;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Plays a file based HLS stream through a local HTTP server which adds a
+ * fixed latency to every request and limits the bandwidth of every
+ * connection, and reports the startup time, the stalls seen by the player and
+ * the HLS segment counters for each prefetch depth. Depth 0 loads one segment
+ * at a time as before prefetching. Segment files must be small enough to be
+ * played within the timeout. It uses the internal media API, so it needs
+ * <pre>
+ * --add-exports javafx.media/com.sun.media.jfxmedia=ALL-UNNAMED
+ * --add-exports javafx.media/com.sun.media.jfxmedia.events=ALL-UNNAMED
+ * --add-exports javafx.media/com.sun.media.jfxmedia.locator=ALL-UNNAMED
+ * </pre>
+ * and takes the playlist as argument, for instance one written by
+ * {@code ffmpeg -i in.mp4 -c copy -hls_time 2 -hls_list_size 0 out.m3u8},
+ * optionally after {@code --latency <ms>}, {@code --kbps <n>} and
+ * {@code --depths <d,d,...>}.
+ */
+public class HLSPrefetchPerformance {
+    private static final long TIMEOUT_SECONDS = 600;
+    private static final int CHUNK_SIZE = 16 * 1024;
+
+    private static long latencyMillis = 100;
+    private static long kbps = 8000;
+
+    private static final class Monitor implements PlayerStateListener {
+        final CountDownLatch done = new CountDownLatch(1);
+        volatile long startNanos;
+        volatile long playingNanos = -1;
+        volatile int stalls;
+
+        @Override public void onReady(PlayerStateEvent evt) {}
+        @Override
+        public void onPlaying(PlayerStateEvent evt) {
+            if (playingNanos < 0) {
+                playingNanos = System.nanoTime();
+            }
+        }
+        @Override public void onPause(PlayerStateEvent evt) {}
+        @Override public void onStop(PlayerStateEvent evt) { done.countDown(); }
+        @Override public void onStall(PlayerStateEvent evt) { stalls++; }
+        @Override public void onFinish(PlayerStateEvent evt) { done.countDown(); }
+        @Override public void onHalt(PlayerStateEvent evt) { done.countDown(); }
+    }
+
+    private static void serve(Path root, HttpExchange exchange) throws IOException {
+        try {
+            Path file = root.resolve(exchange.getRequestURI().getPath().substring(1)).normalize();
+            if (!file.startsWith(root) || !Files.isRegularFile(file)) {
+                exchange.sendResponseHeaders(404, -1);
+                return;
+            }
+
+            byte[] data = Files.readAllBytes(file);
+            String name = file.getFileName().toString();
+            exchange.getResponseHeaders().set("Content-Type",
+                    name.endsWith(".m3u8") ? "application/vnd.apple.mpegurl" : "video/MP2T");
+            sleep(latencyMillis * 1_000_000L);
+            exchange.sendResponseHeaders(200, data.length);
+
+            // Paces every connection to the given bandwidth.
+            long start = System.nanoTime();
+            OutputStream out = exchange.getResponseBody();
+            for (int offset = 0; offset < data.length; offset += CHUNK_SIZE) {
+                int count = Math.min(CHUNK_SIZE, data.length - offset);
+                out.write(data, offset, count);
+                long due = (offset + count) * 8L * 1_000_000L / kbps;
+                sleep(due - (System.nanoTime() - start));
+            }
+        } finally {
+            exchange.close();
+        }
+    }
+
+    private static void sleep(long nanos) {
+        if (nanos > 0) {
+            try {
+                TimeUnit.NANOSECONDS.sleep(nanos);
+            } catch (InterruptedException ex) {
+                Thread.currentThread().interrupt();
+            }
+        }
+    }
+
+    private static void run(URI uri, int depth) throws Exception {
+        System.setProperty("jfxmedia.hls.prefetch", Integer.toString(depth));
+        HLSStatistics before = MediaManager.getHLSStatistics();
+
+        Monitor monitor = new Monitor();
+        monitor.startNanos = System.nanoTime();
+        Locator locator = new Locator(uri);
+        locator.init();
+        MediaPlayer player = MediaManager.getPlayer(locator);
+        try {
+            player.addMediaPlayerListener(monitor);
+            player.setMute(true);
+            player.play();
+            if (!monitor.done.await(TIMEOUT_SECONDS, TimeUnit.SECONDS)) {
+                System.out.println("depth " + depth + ": timed out");
+            }
+        } finally {
+            player.dispose();
+        }
+
+        HLSStatistics after = MediaManager.getHLSStatistics();
+        long segments = after.getSegmentsLoaded() - before.getSegmentsLoaded();
+        System.out.printf("depth %d: playing after %.1f ms, %d stalls, %d segments, %d prefetched,"
+                + " first data after %d ms, %d rebuffers for %d ms%n",
+                depth,
+                monitor.playingNanos < 0 ? -1.0 : (monitor.playingNanos - monitor.startNanos) / 1e6,
+                monitor.stalls, segments, after.getPrefetchHits() - before.getPrefetchHits(),
+                after.getStartupMillis(),
+                after.getRebufferCount() - before.getRebufferCount(),
+                after.getRebufferMillis() - before.getRebufferMillis());
+    }
+
+    public static void main(String[] args) throws Exception {
+        String depths = "0,3";
+        int i = 0;
+        for (; i + 1 < args.length && args[i].startsWith("--"); i += 2) {
+            switch (args[i]) {
+                case "--latency" -> latencyMillis = Long.parseLong(args[i + 1]);
+                case "--kbps" -> kbps = Long.parseLong(args[i + 1]);
+                case "--depths" -> depths = args[i + 1];
+                default -> i = args.length;
+            }
+        }
+        if (i != args.length - 1 || kbps <= 0) {
+            System.err.println("Usage: HLSPrefetchPerformance [--latency <ms>] [--kbps <n>]"
+                    + " [--depths <d,d,...>] <playlist.m3u8>");
+            System.exit(1);
+        }
+
+        Path playlist = Path.of(args[i]).toAbsolutePath().normalize();
+        Path root = playlist.getParent();
+        HttpServer server = HttpServer.create(new InetSocketAddress(InetAddress.getLoopbackAddress(), 0), 0);
+        server.createContext("/", exchange -> serve(root, exchange));
+        server.setExecutor(Executors.newCachedThreadPool());
+        server.start();
+
+        URI uri = new URI("http", null, "127.0.0.1", server.getAddress().getPort(),
+                "/" + root.relativize(playlist).toString().replace('\\', '/'), null, null);
+        try {
+            for (String depth : depths.split(",")) {
+                run(uri, Integer.parseInt(depth.trim()));
+            }
+        } finally {
+            server.stop(0);
+        }
+        System.exit(0);
+    }
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package jsc;
+
+import java.io.BufferedReader;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.InputStreamReader;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * Runs the tiers.js kernels in the {@code jsc} shell built alongside the
+ * Java WebKit port, once per JIT tier configuration, so the throughput of
+ * the DFG and FTL tiers can be compared. A WebView deployment selects its
+ * tier with the {@code com.sun.webkit.useDFGJIT} and
+ * {@code com.sun.webkit.useFTLJIT} system properties. Both are off by
+ * default; FTL needs DFG and follows it unless set on its own.
+ *
+ * Usage: java jsc.CompareTierPerformance path/to/jsc [path/to/tiers.js]
+ */
+public class CompareTierPerformance {
+    private static final String[][] CONFIGURATIONS = {
+        { "Baseline", "--useDFGJIT=false" },
+        { "DFG", "--useFTLJIT=false" },
+        { "FTL", "--useFTLJIT=true" },
+    };
+
+    public static void main(String[] args) throws Exception {
+        if (args.length < 1) {
+            System.err.println("Usage: CompareTierPerformance <jsc> [tiers.js]");
+            System.exit(1);
+        }
+
+        String jsc = args[0];
+        Path script = args.length > 1 ? Path.of(args[1]) : extractScript("tiers.js");
+
+        for (String[] configuration : CONFIGURATIONS) {
+            System.out.println(configuration[0] + " (" + configuration[1] + ")");
+            run(jsc, script, configuration[1]);
+            System.out.println();
+        }
+    }
+
+    static Path extractScript(String name) throws IOException {
+        Path script = Files.createTempFile(name, null);
+        script.toFile().deleteOnExit();
+        try (InputStream in = CompareTierPerformance.class.getResourceAsStream(name)) {
+            if (in == null) {
+                throw new IOException(name + " not found");
+            }
+            Files.copy(in, script, StandardCopyOption.REPLACE_EXISTING);
+        }
+        return script;
+    }
+
+    static boolean run(String jsc, Path script, String... options) throws IOException, InterruptedException {
+        List<String> command = new ArrayList<>();
+        command.add(jsc);
+        command.addAll(List.of(options));
+        command.add(script.toString());
+        ProcessBuilder builder = new ProcessBuilder(command);
+        builder.redirectErrorStream(true);
+        Process process = builder.start();
+        try (BufferedReader reader = new BufferedReader(
+                new InputStreamReader(process.getInputStream(), StandardCharsets.UTF_8))) {
+            String line;
+            while ((line = reader.readLine()) != null) {
+                System.out.println("    " + line);
+            }
+        }
+        int exitCode = process.waitFor();
+        if (exitCode != 0) {
+            System.out.println("    jsc exited with code " + exitCode);
+        }
+        return exitCode == 0;
+    }
+}
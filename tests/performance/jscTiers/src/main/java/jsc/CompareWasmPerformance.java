@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package jsc;
+
+import java.nio.file.Path;
+
+/**
+ * Runs the wasm.js conformance checks and throughput kernel in the
+ * {@code jsc} shell once per WebAssembly tier configuration. The process
+ * exits with a non-zero status if any configuration fails conformance.
+ *
+ * Usage: java jsc.CompareWasmPerformance path/to/jsc [path/to/wasm.js]
+ */
+public class CompareWasmPerformance {
+    private static final String[][] CONFIGURATIONS = {
+        { "LLInt", "--useBBQJIT=false", "--useOMGJIT=false" },
+        { "BBQ", "--useOMGJIT=false" },
+        { "BBQ+OMG" },
+        { "BBQ+OMG, bounds checked memory", "--useWebAssemblyFastMemory=false" },
+    };
+
+    public static void main(String[] args) throws Exception {
+        if (args.length < 1) {
+            System.err.println("Usage: CompareWasmPerformance <jsc> [wasm.js]");
+            System.exit(1);
+        }
+
+        String jsc = args[0];
+        Path script = args.length > 1 ? Path.of(args[1]) : CompareTierPerformance.extractScript("wasm.js");
+
+        boolean passed = true;
+        for (String[] configuration : CONFIGURATIONS) {
+            String[] options = new String[configuration.length - 1];
+            System.arraycopy(configuration, 1, options, 0, options.length);
+            System.out.println(configuration[0] + " " + String.join(" ", options));
+            passed &= CompareTierPerformance.run(jsc, script, options);
+            System.out.println();
+        }
+        System.exit(passed ? 0 : 1);
+    }
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+// Compute-bound JavaScript kernels modelled on the workloads seen in
+// WebView-based applications: numeric charting code, client-side data
+// grids and crypto polyfills. Each kernel runs long enough to tier up
+// through Baseline and DFG, so the reported times reflect the highest
+// tier enabled in the jsc shell that runs this script.
+//
+// Usage: jsc [--useFTLJIT=false] tiers.js
+
+"use strict";
+
+const now = typeof preciseTime === "function"
+    ? () => preciseTime() * 1000
+    : () => Date.now();
+
+function matrixMultiply() {
+    const n = 96;
+    const a = new Float64Array(n * n);
+    const b = new Float64Array(n * n);
+    const c = new Float64Array(n * n);
+    for (let i = 0; i < n * n; ++i) {
+        a[i] = (i % 17) * 0.25;
+        b[i] = (i % 13) * 0.5;
+    }
+    for (let iter = 0; iter < 40; ++iter) {
+        for (let i = 0; i < n; ++i) {
+            for (let j = 0; j < n; ++j) {
+                let sum = 0;
+                for (let k = 0; k < n; ++k)
+                    sum += a[i * n + k] * b[k * n + j];
+                c[i * n + j] = sum;
+            }
+        }
+    }
+    return c[n + 1];
+}
+
+function chartSeries() {
+    // Smoothing and min/max decimation as done by charting libraries.
+    const length = 1 << 16;
+    const values = new Float64Array(length);
+    let result = 0;
+    for (let iter = 0; iter < 60; ++iter) {
+        for (let i = 0; i < length; ++i)
+            values[i] = Math.sin(i * 0.001 + iter) * 100 + Math.cos(i * 0.017) * 10;
+        let smoothed = values[0];
+        let min = Infinity;
+        let max = -Infinity;
+        for (let i = 0; i < length; ++i) {
+            smoothed = smoothed * 0.9 + values[i] * 0.1;
+            min = Math.min(min, smoothed);
+            max = Math.max(max, smoothed);
+        }
+        result += max - min;
+    }
+    return result;
+}
+
+function dataGrid() {
+    // Object-heavy row filtering, sorting and aggregation.
+    const rows = [];
+    for (let i = 0; i < 20000; ++i) {
+        rows.push({
+            id: i,
+            name: "row" + (i * 7919 % 20000),
+            price: (i * 31 % 1000) / 10,
+            quantity: i % 50,
+        });
+    }
+    let total = 0;
+    for (let iter = 0; iter < 15; ++iter) {
+        const filtered = rows.filter(row => row.quantity > iter);
+        filtered.sort((x, y) => x.price - y.price || (x.name < y.name ? -1 : x.name > y.name ? 1 : 0));
+        for (const row of filtered)
+            total += row.price * row.quantity;
+    }
+    return total;
+}
+
+const SHA256_K = new Uint32Array([
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+]);
+
+function sha256Blocks(words, state) {
+    const w = new Uint32Array(64);
+    for (let offset = 0; offset < words.length; offset += 16) {
+        for (let i = 0; i < 16; ++i)
+            w[i] = words[offset + i];
+        for (let i = 16; i < 64; ++i) {
+            const s0 = ((w[i - 15] >>> 7) | (w[i - 15] << 25)) ^ ((w[i - 15] >>> 18) | (w[i - 15] << 14)) ^ (w[i - 15] >>> 3);
+            const s1 = ((w[i - 2] >>> 17) | (w[i - 2] << 15)) ^ ((w[i - 2] >>> 19) | (w[i - 2] << 13)) ^ (w[i - 2] >>> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        let a = state[0], b = state[1], c = state[2], d = state[3];
+        let e = state[4], f = state[5], g = state[6], h = state[7];
+        for (let i = 0; i < 64; ++i) {
+            const s1 = ((e >>> 6) | (e << 26)) ^ ((e >>> 11) | (e << 21)) ^ ((e >>> 25) | (e << 7));
+            const ch = (e & f) ^ (~e & g);
+            const t1 = (h + s1 + ch + SHA256_K[i] + w[i]) | 0;
+            const s0 = ((a >>> 2) | (a << 30)) ^ ((a >>> 13) | (a << 19)) ^ ((a >>> 22) | (a << 10));
+            const maj = (a & b) ^ (a & c) ^ (b & c);
+            const t2 = (s0 + maj) | 0;
+            h = g; g = f; f = e; e = (d + t1) | 0;
+            d = c; c = b; b = a; a = (t1 + t2) | 0;
+        }
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+}
+
+function cryptoPolyfill() {
+    const words = new Uint32Array(16 * 1024);
+    for (let i = 0; i < words.length; ++i)
+        words[i] = Math.imul(i, 0x9e3779b1);
+    const state = new Uint32Array([
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    ]);
+    for (let iter = 0; iter < 40; ++iter)
+        sha256Blocks(words, state);
+    return state[0];
+}
+
+const kernels = [matrixMultiply, chartSeries, dataGrid, cryptoPolyfill];
+let totalTime = 0;
+for (const kernel of kernels) {
+    // Warm up once so that every tier has a chance to compile the kernel.
+    kernel();
+    const start = now();
+    const result = kernel();
+    const elapsed = now() - start;
+    totalTime += elapsed;
+    print(kernel.name + ": " + elapsed.toFixed(1) + "ms (" + result + ")");
+}
+print("Total: " + totalTime.toFixed(1) + "ms");
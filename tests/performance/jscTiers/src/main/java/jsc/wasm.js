@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+// WebAssembly conformance checks and a throughput kernel for the jsc shell
+// built with the Java WebKit port. The conformance part exercises module
+// validation, exports, linear memory growth and out-of-bounds traps, so it
+// also covers the bounds-checked memory mode that is used when fast memory
+// cannot be reserved. The throughput part compares a wasm loop with the
+// equivalent JavaScript.
+//
+// Usage: jsc [--useBBQJIT=false] [--useOMGJIT=false] wasm.js
+
+"use strict";
+
+const now = typeof preciseTime === "function"
+    ? () => preciseTime() * 1000
+    : () => Date.now();
+
+// (memory (export "memory") 1 16)
+// (func (export "add") (param i32 i32) (result i32))
+// (func (export "sum") (param $n i32) (result i32))  ;; sum of memory[0 .. n) as i32
+// (func (export "fill") (param $n i32))              ;; memory[i] = i for i < n
+// (func (export "load") (param $address i32) (result i32))
+const moduleBytes = new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+    // Type section.
+    0x01, 0x10, 0x03,
+    0x60, 0x02, 0x7f, 0x7f, 0x01, 0x7f,
+    0x60, 0x01, 0x7f, 0x01, 0x7f,
+    0x60, 0x01, 0x7f, 0x00,
+    // Function section.
+    0x03, 0x05, 0x04, 0x00, 0x01, 0x02, 0x01,
+    // Memory section.
+    0x05, 0x04, 0x01, 0x01, 0x01, 0x10,
+    // Export section.
+    0x07, 0x24, 0x05,
+    0x06, 0x6d, 0x65, 0x6d, 0x6f, 0x72, 0x79, 0x02, 0x00,
+    0x03, 0x61, 0x64, 0x64, 0x00, 0x00,
+    0x03, 0x73, 0x75, 0x6d, 0x00, 0x01,
+    0x04, 0x66, 0x69, 0x6c, 0x6c, 0x00, 0x02,
+    0x04, 0x6c, 0x6f, 0x61, 0x64, 0x00, 0x03,
+    // Code section.
+    0x0a, 0x60, 0x04,
+    // add
+    0x07, 0x00, 0x20, 0x00, 0x20, 0x01, 0x6a, 0x0b,
+    // sum
+    0x29, 0x01, 0x02, 0x7f,
+    0x02, 0x40, 0x03, 0x40,
+    0x20, 0x01, 0x20, 0x00, 0x4e, 0x0d, 0x01,
+    0x20, 0x02, 0x20, 0x01, 0x41, 0x02, 0x74, 0x28, 0x02, 0x00, 0x6a, 0x21, 0x02,
+    0x20, 0x01, 0x41, 0x01, 0x6a, 0x21, 0x01,
+    0x0c, 0x00, 0x0b, 0x0b,
+    0x20, 0x02, 0x0b,
+    // fill
+    0x24, 0x01, 0x01, 0x7f,
+    0x02, 0x40, 0x03, 0x40,
+    0x20, 0x01, 0x20, 0x00, 0x4e, 0x0d, 0x01,
+    0x20, 0x01, 0x41, 0x02, 0x74, 0x20, 0x01, 0x36, 0x02, 0x00,
+    0x20, 0x01, 0x41, 0x01, 0x6a, 0x21, 0x01,
+    0x0c, 0x00, 0x0b, 0x0b,
+    0x0b,
+    // load
+    0x07, 0x00, 0x20, 0x00, 0x28, 0x02, 0x00, 0x0b,
+]);
+
+let failures = 0;
+
+function check(condition, message) {
+    if (!condition) {
+        ++failures;
+        print("FAIL: " + message);
+    }
+}
+
+function expectTrap(fn, message) {
+    try {
+        fn();
+        check(false, message + " did not trap");
+    } catch (e) {
+        check(e instanceof WebAssembly.RuntimeError, message + " threw " + e);
+    }
+}
+
+function conformance() {
+    check(WebAssembly.validate(moduleBytes), "module validates");
+    check(!WebAssembly.validate(moduleBytes.subarray(0, moduleBytes.length - 1)), "truncated module is rejected");
+
+    const instance = new WebAssembly.Instance(new WebAssembly.Module(moduleBytes));
+    const { memory, add, sum, fill, load } = instance.exports;
+
+    check(add(2, 3) === 5, "add");
+    check(add(0x7fffffff, 1) === -0x80000000, "add wraps");
+
+    const pageSize = 64 * 1024;
+    check(memory.buffer.byteLength === pageSize, "initial memory size");
+    fill(pageSize / 4);
+    const view = new Int32Array(memory.buffer);
+    check(view[123] === 123, "stores are visible to JavaScript");
+    check(sum(100) === 4950, "sum");
+
+    expectTrap(() => load(pageSize), "load past the end of memory");
+    expectTrap(() => load(-1), "load at a negative address");
+
+    check(memory.grow(3) === 1, "grow returns the previous size");
+    check(memory.buffer.byteLength === 4 * pageSize, "memory size after grow");
+    check(load(pageSize) === 0, "grown memory is zeroed");
+    check(load(4 * pageSize - 4) === 0, "last word of grown memory is accessible");
+    expectTrap(() => load(4 * pageSize), "load past the end of grown memory");
+
+    let threw = false;
+    try {
+        memory.grow(16);
+    } catch (e) {
+        threw = e instanceof RangeError;
+    }
+    check(threw, "grow beyond the maximum throws RangeError");
+
+    print("Conformance: " + (failures ? failures + " failure(s)" : "passed"));
+}
+
+function throughput() {
+    const instance = new WebAssembly.Instance(new WebAssembly.Module(moduleBytes));
+    const { memory, sum, fill } = instance.exports;
+    memory.grow(15);
+    const count = memory.buffer.byteLength / 4;
+    fill(count);
+
+    const view = new Int32Array(memory.buffer);
+    function jsSum(n) {
+        let result = 0;
+        for (let i = 0; i < n; ++i)
+            result = (result + view[i]) | 0;
+        return result;
+    }
+
+    const iterations = 200;
+    const kernels = [["wasm", sum], ["js", jsSum]];
+    for (const [name, kernel] of kernels) {
+        // Warm up so that the kernel has tiered up.
+        for (let i = 0; i < 20; ++i)
+            kernel(count);
+        let result = 0;
+        const start = now();
+        for (let i = 0; i < iterations; ++i)
+            result = kernel(count);
+        const elapsed = now() - start;
+        const mbPerSecond = (iterations * count * 4) / (1024 * 1024) / (elapsed / 1000);
+        print(name + " sum: " + elapsed.toFixed(1) + "ms, " + mbPerSecond.toFixed(0) + " MB/s (" + result + ")");
+    }
+}
+
+conformance();
+throughput();
+if (failures)
+    throw new Error(failures + " WebAssembly conformance failure(s)");
@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Measures the blend, gradient and texture loops of the software pipeline
+ * at every SIMD level this machine supports, on rows of common widths, and
+ * checks that each level produces the same pixels as the scalar code. The
+ * cases follow what fillRect, fillAlphaMask, shape fills and drawImage do
+ * for each band of rows. Build it with the native-prism-sw sources, for
+ * example
+ *
+ *   N=modules/javafx.graphics/src/main/native-prism-sw
+ *   cc -O2 -DINLINE=inline -I $JAVA_HOME/include \
+ *      -I $JAVA_HOME/include/linux -I $N -I build/headers/PrismSW \
+ *      tests/performance/piscesBlend/PiscesBlendBenchmark.c \
+ *      $N/PiscesBlit.c $N/PiscesPaint.c $N/PiscesSIMD.c $N/PiscesMath.c \
+ *      $N/PiscesUtil.c $N/PiscesSysutils.c -lm
+ *
+ * where build/headers/PrismSW holds the javah headers of com.sun.pisces.
+ * It takes an optional number of passes, 20 by default. A "-" marks a
+ * level that has no loop of its own for the case and runs the C one.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <PiscesBlit.h>
+#include <PiscesSIMD.h>
+
+#define BAND 8
+#define MAX_WIDTH 1920
+#define TEXTURE_SIZE 512
+
+enum {
+    FILL_ALPHA, FILL_MASK, FILL_SHAPE, FILL_LINEAR, FILL_RADIAL,
+    IMAGE_SCALED, IMAGE_ROTATED, IMAGE_MASK, FILL_MASK_SRC, IMAGE_MASK_SRC,
+    FILL_LCD, CASES
+};
+
+static const char *caseNames[] = {
+    "fillRect alpha", "fillAlphaMask", "shape coverage", "linear gradient",
+    "radial gradient", "image scaled", "image rotated", "image masked",
+    "Src mask", "Src image mask", "LCD text"
+};
+// Lowest SIMD level with a loop of its own; below it the C loop runs
+static const jint caseLevels[] = {
+    PISCES_SIMD_SSE2, PISCES_SIMD_SSE2, PISCES_SIMD_SSE2, PISCES_SIMD_SSE2,
+    PISCES_SIMD_SSE2, PISCES_SIMD_SSE2, PISCES_SIMD_SSE2, PISCES_SIMD_SSE2,
+    PISCES_SIMD_SSE2, PISCES_SIMD_SSE2, PISCES_SIMD_AVX2
+};
+static const char *levelNames[] = { "C", "SSE2", "AVX2" };
+static const jint widths[] = { 64, 256, 1024, MAX_WIDTH };
+
+static jint surface[MAX_WIDTH * BAND];
+static jint original[MAX_WIDTH * BAND];
+static jint reference[MAX_WIDTH * BAND];
+static jint paint[MAX_WIDTH * BAND];
+static jint rowAA[MAX_WIDTH + 1];
+static jbyte mask[MAX_WIDTH * BAND];
+static jbyte alphaMap[256];
+static jint texture[TEXTURE_SIZE * TEXTURE_SIZE];
+
+static unsigned seed = 12345;
+
+static jint nextRandom() {
+    seed = seed * 1103515245u + 12345u;
+    return (jint)(seed >> 8);
+}
+
+static jint randomPremultiplied() {
+    jint a = nextRandom() & 0xff;
+    jint r, g, b;
+    if (a < 40) a = 0;
+    if (a > 200) a = 0xff;
+    r = a ? nextRandom() % (a + 1) : 0;
+    g = a ? nextRandom() % (a + 1) : 0;
+    b = a ? nextRandom() % (a + 1) : 0;
+    return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+static void setup() {
+    jint i, m;
+    for (i = 0; i < MAX_WIDTH * BAND; i++) {
+        original[i] = randomPremultiplied();
+        // glyph like coverage: mostly empty or full, with soft edges
+        m = nextRandom() & 0xff;
+        mask[i] = (jbyte)((m < 100) ? 0 : (m > 180) ? 0xff : m);
+    }
+    for (i = 0; i < TEXTURE_SIZE * TEXTURE_SIZE; i++) {
+        texture[i] = randomPremultiplied();
+    }
+    for (i = 0; i < 256; i++) {
+        alphaMap[i] = (jbyte)i;
+    }
+}
+
+static void initRenderer(Renderer *rdr, jint w) {
+    jint i;
+
+    memset(rdr, 0, sizeof(*rdr));
+    rdr->_data = surface;
+    rdr->_imageScanlineStride = w;
+    rdr->_imagePixelStride = 1;
+    rdr->_alphaWidth = w;
+    rdr->_minTouched = 0;
+    rdr->_maxTouched = w - 1;
+    rdr->_currX = 0;
+    rdr->_currY = 0;
+    rdr->_paint = paint;
+    rdr->_paint_length = MAX_WIDTH * BAND;
+    rdr->_rowAAInt = rowAA;
+    rdr->alphaMap = alphaMap;
+    rdr->_mask_byteData = mask;
+    rdr->_calpha = 0xc0;
+    rdr->_cred = 0x20;
+    rdr->_cgreen = 0x80;
+    rdr->_cblue = 0xe0;
+
+    rdr->_gradient_cycleMethod = CYCLE_REFLECT;
+    for (i = 0; i < GRADIENT_MAP_SIZE; i++) {
+        jint a = 0x80 + i / 2;
+        rdr->_gradient_colors[i] = (a << 24) | ((i * a / 255) << 16) | (((255 - i) * a / 255) << 8);
+    }
+    rdr->_lg_mx = 65536.0f / w;
+    rdr->_lg_my = 65536.0f / 500;
+    rdr->_lg_b = 0;
+    rdr->_rg_a00 = 1;
+    rdr->_rg_a11 = 1;
+    rdr->_rg_cx = w / 2.0f;
+    rdr->_rg_cy = 100;
+    rdr->_rg_fx = w / 3.0f;
+    rdr->_rg_fy = 80;
+    rdr->_rg_r = w / 2.0f;
+    rdr->_rg_rsq = rdr->_rg_r * rdr->_rg_r;
+    rdr->_rg_a00a00 = 1;
+    rdr->_rg_a10a10 = 0;
+    rdr->_rg_a00a10 = 0;
+
+    rdr->_texture_intData = texture;
+    rdr->_texture_imageWidth = TEXTURE_SIZE;
+    rdr->_texture_imageHeight = TEXTURE_SIZE;
+    rdr->_texture_stride = TEXTURE_SIZE;
+    rdr->_texture_txMax = TEXTURE_SIZE - 1;
+    rdr->_texture_tyMax = TEXTURE_SIZE - 1;
+    rdr->_texture_hasAlpha = XNI_TRUE;
+    rdr->_texture_interpolate = XNI_TRUE;
+}
+
+// Renders one band of BAND rows the way the JNI fills do
+static void renderBand(Renderer *rdr, jint c, jint y) {
+    jint w = rdr->_alphaWidth;
+    jint j, i;
+
+    rdr->_currY = y;
+    rdr->_currImageOffset = 0;
+    switch (c) {
+    case FILL_ALPHA:
+        emitLineSourceOver8888_pre(rdr, BAND, 0x9000);
+        break;
+    case FILL_MASK:
+        rdr->_maskOffset = 0;
+        blitSrcOverMask8888_pre(rdr, BAND);
+        break;
+    case FILL_SHAPE:
+        // one row at a time, as emitAndClearAlphaRow does
+        for (j = 0; j < BAND; j++) {
+            for (i = 0; i < w; i++) {
+                rowAA[i] = ((i + j) % 97 == 0) ? 255 : ((i + j) % 97 == 60) ? -255 : 0;
+            }
+            rowAA[0] += (j & 1) ? 128 : 255;
+            blitSrcOver8888_pre(rdr, 1);
+            rdr->_currImageOffset += w;
+        }
+        break;
+    case FILL_LINEAR:
+        genLinearGradientPaint(rdr, BAND);
+        emitLinePTSourceOver8888_pre(rdr, BAND, 0x10000);
+        break;
+    case FILL_RADIAL:
+        genRadialGradientPaint(rdr, BAND);
+        emitLinePTSourceOver8888_pre(rdr, BAND, 0x10000);
+        break;
+    case IMAGE_SCALED:
+    case IMAGE_ROTATED:
+        genTexturePaint(rdr, BAND);
+        emitLinePTSourceOver8888_pre(rdr, BAND, 0x10000);
+        break;
+    case IMAGE_MASK:
+        genTexturePaint(rdr, 1);
+        rdr->_maskOffset = 0;
+        blitPTSrcOverMask8888_pre(rdr, 1);
+        break;
+    case FILL_MASK_SRC:
+        rdr->_maskOffset = 0;
+        blitSrcMask8888_pre(rdr, BAND);
+        break;
+    case IMAGE_MASK_SRC:
+        genTexturePaint(rdr, 1);
+        rdr->_maskOffset = 0;
+        blitPTSrcMask8888_pre(rdr, 1);
+        break;
+    case FILL_LCD:
+        rdr->_maskOffset = 0;
+        blitSrcOverLCDMask8888_pre(rdr, 1);
+        break;
+    }
+}
+
+static void setTransform(Renderer *rdr, jint c) {
+    if (c == IMAGE_SCALED) {
+        rdr->_texture_transformType = TEXTURE_TRANSFORM_SCALE_TRANSLATE;
+        rdr->_texture_m00 = 0x9a00;
+        rdr->_texture_m11 = 0x9a00;
+        rdr->_texture_m02 = 0x1234;
+        rdr->_texture_m12 = 0x5678;
+    } else {
+        // about 20 degrees, with repeat
+        rdr->_texture_transformType = TEXTURE_TRANSFORM_GENERIC;
+        rdr->_texture_repeat = XNI_TRUE;
+        rdr->_texture_m00 = 61584;
+        rdr->_texture_m01 = -22415;
+        rdr->_texture_m10 = 22415;
+        rdr->_texture_m11 = 61584;
+        rdr->_texture_m02 = 0x30000;
+        rdr->_texture_m12 = 0x8000;
+    }
+}
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Returns Mpixel/s of passes bands, leaving the pixels of the first in surface
+static double run(jint c, jint w, jint level, jint passes) {
+    Renderer rdr;
+    jint bands = (jint)(4000000 / ((jlong)w * BAND)) + 1;
+    double start, time;
+    jint pass, band;
+
+    piscessimd_setLevel(level);
+    initRenderer(&rdr, w);
+    setTransform(&rdr, c);
+    memcpy(surface, original, sizeof(surface));
+    renderBand(&rdr, c, 0);
+    start = now();
+    for (pass = 0; pass < passes; pass++) {
+        for (band = 0; band < bands; band++) {
+            // blend over fresh pixels now and then so they do not saturate
+            if ((band & 15) == 0) {
+                memcpy(surface + w, original, sizeof(jint) * w * (BAND - 1));
+            }
+            renderBand(&rdr, c, band * BAND);
+        }
+    }
+    time = now() - start;
+    memcpy(surface, original, sizeof(surface));
+    renderBand(&rdr, c, 0);
+    return (double)passes * bands * BAND * w / time / 1e6;
+}
+
+int main(int argc, char **argv) {
+    jint passes = (argc > 1) ? atoi(argv[1]) : 20;
+    jint best, level, c, k, failures = 0;
+
+    if (passes <= 0) {
+        fprintf(stderr, "usage: %s [PASSES]\n", argv[0]);
+        return 2;
+    }
+    setup();
+    initGammaArrays(1.4f);
+    piscessimd_setLevel(PISCES_SIMD_AVX2);
+    best = piscessimd_getLevel();
+    printf("best SIMD level: %s\n", levelNames[best]);
+    printf("Mpixel/s, %d passes of about 4 Mpixel\n", passes);
+    printf("%-16s %6s", "case", "width");
+    for (level = 0; level <= best; level++) {
+        printf(" %10s", levelNames[level]);
+    }
+    printf("\n");
+
+    for (c = 0; c < CASES; c++) {
+        for (k = 0; k < (jint)(sizeof(widths) / sizeof(widths[0])); k++) {
+            jint w = widths[k];
+            printf("%-16s %6d", caseNames[c], w);
+            for (level = 0; level <= best; level++) {
+                double rate;
+                if (level != PISCES_SIMD_C && level < caseLevels[c]) {
+                    printf(" %10s", "-");
+                    continue;
+                }
+                rate = run(c, w, level, passes);
+                if (level == PISCES_SIMD_C) {
+                    memcpy(reference, surface, sizeof(reference));
+                } else if (memcmp(reference, surface, sizeof(reference)) != 0) {
+                    failures++;
+                }
+                printf(" %10.1f", rate);
+            }
+            printf("\n");
+        }
+    }
+    printf(failures ? "%d mismatches\n" : "all levels match the C code\n", failures);
+    return failures ? 1 : 0;
+}
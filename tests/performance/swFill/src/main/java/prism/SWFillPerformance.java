@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package prism;
+
+import java.nio.IntBuffer;
+import java.util.zip.CRC32;
+
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.scene.Group;
+import javafx.scene.Scene;
+import javafx.scene.SnapshotParameters;
+import javafx.scene.image.ImageView;
+import javafx.scene.image.PixelFormat;
+import javafx.scene.image.WritableImage;
+import javafx.scene.paint.Color;
+import javafx.scene.paint.CycleMethod;
+import javafx.scene.paint.LinearGradient;
+import javafx.scene.paint.RadialGradient;
+import javafx.scene.paint.Stop;
+import javafx.scene.shape.Rectangle;
+import javafx.scene.text.Font;
+import javafx.scene.text.Text;
+import javafx.stage.Stage;
+
+/**
+ * Measures snapshots of a large scene of gradient fills, scaled images and
+ * text on the software pipeline, and prints a checksum of the pixels. Run it
+ * with -Dprism.order=sw, once with -Dprism.sw.threads=1 and once without,
+ * to compare the time per snapshot; the checksums must be the same.
+ */
+public class SWFillPerformance extends Application {
+    private static final int WIDTH = 1920;
+    private static final int HEIGHT = 1080;
+    private static final int WARMUP = 10;
+    private static final int SNAPSHOTS = 50;
+
+    @Override
+    public void start(Stage stage) {
+        Group root = createScene();
+        stage.setScene(new Scene(root, WIDTH, HEIGHT));
+
+        WritableImage image = new WritableImage(WIDTH, HEIGHT);
+        SnapshotParameters params = new SnapshotParameters();
+        params.setFill(Color.WHITE);
+        for (int i = 0; i < WARMUP; i++) {
+            root.snapshot(params, image);
+        }
+
+        long start = System.nanoTime();
+        for (int i = 0; i < SNAPSHOTS; i++) {
+            root.snapshot(params, image);
+        }
+        long elapsed = System.nanoTime() - start;
+
+        int[] pixels = new int[WIDTH * HEIGHT];
+        image.getPixelReader().getPixels(0, 0, WIDTH, HEIGHT,
+                PixelFormat.getIntArgbPreInstance(), pixels, 0, WIDTH);
+        CRC32 crc = new CRC32();
+        for (int p : pixels) {
+            crc.update(p >>> 24);
+            crc.update(p >>> 16);
+            crc.update(p >>> 8);
+            crc.update(p);
+        }
+
+        System.out.printf("pipeline %s, threads %s\n",
+                System.getProperty("prism.order", "default"),
+                System.getProperty("prism.sw.threads", "default"));
+        System.out.printf("%dx%d snapshot %.2f ms, checksum %08x\n",
+                WIDTH, HEIGHT, elapsed / 1e6 / SNAPSHOTS, crc.getValue());
+        Platform.exit();
+    }
+
+    private static Group createScene() {
+        Group root = new Group();
+
+        Rectangle background = new Rectangle(WIDTH, HEIGHT);
+        background.setFill(new LinearGradient(0, 0, 1, 1, true, CycleMethod.NO_CYCLE,
+                new Stop(0, Color.LIGHTSTEELBLUE), new Stop(1, Color.DARKSLATEBLUE)));
+        root.getChildren().add(background);
+
+        for (int i = 0; i < 6; i++) {
+            Rectangle r = new Rectangle(80 + i * 250, 60 + i * 90, 700, 500);
+            r.setFill(new RadialGradient(0, 0, 0.4, 0.4, 0.6, true, CycleMethod.REFLECT,
+                    new Stop(0, Color.color(1, 0.2 * i, 0, 0.8)),
+                    new Stop(1, Color.color(0, 0.5, 1 - 0.1 * i, 0.4))));
+            r.setArcWidth(60);
+            r.setArcHeight(60);
+            r.setRotate(i * 7);
+            root.getChildren().add(r);
+        }
+
+        WritableImage texture = new WritableImage(320, 240);
+        int[] pixels = new int[320 * 240];
+        for (int y = 0; y < 240; y++) {
+            for (int x = 0; x < 320; x++) {
+                int a = 128 + (x ^ y) % 128;
+                pixels[y * 320 + x] = (a << 24) | ((x * a / 320) << 16) | ((y * a / 240) << 8) | (a / 2);
+            }
+        }
+        texture.getPixelWriter().setPixels(0, 0, 320, 240,
+                PixelFormat.getIntArgbPreInstance(), pixels, 0, 320);
+        for (int i = 0; i < 3; i++) {
+            ImageView view = new ImageView(texture);
+            view.setSmooth(true);
+            view.setFitWidth(900 - i * 150);
+            view.setFitHeight(640 - i * 100);
+            view.setX(200 + i * 400);
+            view.setY(150 + i * 120);
+            view.setRotate(i * 15);
+            view.setOpacity(0.9);
+            root.getChildren().add(view);
+        }
+
+        for (int i = 0; i < 20; i++) {
+            Text text = new Text(40, 60 + i * 50,
+                    "The software pipeline renders large fills in bands " + i);
+            text.setFont(Font.font(36));
+            text.setFill(Color.color(1, 1, 1, 0.85));
+            root.getChildren().add(text);
+        }
+        return root;
+    }
+
+    public static void main(String[] args) {
+        Application.launch(args);
+    }
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package text;
+
+import java.io.IOException;
+import java.nio.charset.Charset;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Arrays;
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.concurrent.Worker;
+import javafx.scene.web.WebEngine;
+import javafx.stage.Stage;
+
+/**
+ * Measures how fast WebView decodes documents in different encodings.
+ * Each document is several megabytes of text inside an HTML comment, so
+ * that loading it is dominated by the TextResourceDecoder rather than by
+ * parsing or layout. Run it against two builds to compare the decode
+ * throughput before and after a change to the text codecs.
+ */
+public class TextDecodingPerformance extends Application {
+    private static final int DOCUMENT_SIZE = 8 << 20;
+    private static final int WARMUP_RUNS = 2;
+    private static final int RUNS = 5;
+
+    private static final String CYRILLIC =
+            "Съешь же ещё "
+            + "этих мягких "
+            + "французских "
+            + "булок. ";
+    private static final String JAPANESE =
+            "いろはにほへと ちりぬるを "
+            + "わかよたれそ つねならむ。 ";
+    private static final String LATIN =
+            "Où est la fenêtre ? Ça dépend. "
+            + "Grüße aus München, señor. ";
+    private static final String ASCII =
+            "The quick brown fox jumps over the lazy dog. ";
+
+    // The first three encodings are decoded by native codecs, the others
+    // are legacy encodings.
+    private static final String[][] CASES = {
+        { "UTF-8", ASCII },
+        { "UTF-8", ASCII + CYRILLIC + JAPANESE },
+        { "ISO-8859-1", ASCII + LATIN },
+        { "UTF-16LE", ASCII + CYRILLIC + JAPANESE },
+        { "windows-1251", ASCII + CYRILLIC },
+        { "Shift_JIS", ASCII + JAPANESE },
+    };
+
+    private WebEngine engine;
+    private Path document;
+    private long documentSize;
+    private int caseIndex = -1;
+    private int run;
+    private long startTime;
+    private final long[] times = new long[RUNS];
+
+    @Override
+    public void start(Stage primaryStage) throws Exception {
+        engine = new WebEngine();
+        engine.getLoadWorker().stateProperty().addListener((ov, o, n) -> {
+            if (n == Worker.State.SUCCEEDED) {
+                long time = System.nanoTime() - startTime;
+                if (run >= WARMUP_RUNS) {
+                    times[run - WARMUP_RUNS] = time;
+                }
+                run++;
+                next();
+            } else if (n == Worker.State.FAILED) {
+                System.err.println("Failed to load " + document);
+                Platform.exit();
+            }
+        });
+        next();
+    }
+
+    private void next() {
+        try {
+            if (caseIndex < 0 || run == WARMUP_RUNS + RUNS) {
+                if (caseIndex >= 0) {
+                    report();
+                    Files.deleteIfExists(document);
+                }
+                if (++caseIndex == CASES.length) {
+                    Platform.exit();
+                    return;
+                }
+                run = 0;
+                document = createDocument(CASES[caseIndex][0], CASES[caseIndex][1]);
+                documentSize = Files.size(document);
+            }
+        } catch (IOException e) {
+            e.printStackTrace();
+            Platform.exit();
+            return;
+        }
+        // Load from the event queue so that the previous load is complete.
+        Platform.runLater(() -> {
+            startTime = System.nanoTime();
+            // The query keeps the load from being served from the cache.
+            engine.load(document.toUri() + "?" + run);
+        });
+    }
+
+    private void report() {
+        long[] sorted = times.clone();
+        Arrays.sort(sorted);
+        double seconds = sorted[RUNS / 2] / 1e9;
+        String name = CASES[caseIndex][0]
+                + (CASES[caseIndex][1] == ASCII ? " (ASCII)" : "");
+        System.out.printf("%-20s %8.1f MB/s\n", name, documentSize / seconds / (1 << 20));
+    }
+
+    private static Path createDocument(String encoding, String sample) throws IOException {
+        Charset charset = Charset.forName(encoding);
+        StringBuilder sb = new StringBuilder(DOCUMENT_SIZE + 256);
+        if (encoding.startsWith("UTF-16")) {
+            sb.append('﻿');
+        }
+        sb.append("<!DOCTYPE html><html><head><meta charset=\"")
+          .append(encoding).append("\"></head><body><!--\n");
+        while (sb.length() < DOCUMENT_SIZE) {
+            sb.append(sample);
+        }
+        sb.append("\n--></body></html>\n");
+
+        Path path = Files.createTempFile("decode", ".html");
+        Files.write(path, sb.toString().getBytes(charset));
+        return path;
+    }
+
+    public static void main(String[] args) {
+        Application.launch(args);
+    }
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package text;
+
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.concurrent.Worker;
+import javafx.scene.Scene;
+import javafx.scene.web.WebView;
+import javafx.stage.Stage;
+
+/**
+ * Measures line breaking and caret movement over long paragraphs in
+ * several scripts. The page is laid out at a range of widths, which
+ * re-runs the line break iterator over all of the text, and the caret is
+ * moved by characters, which uses the grapheme cluster iterator. Run it
+ * against two builds to compare the text break iterators.
+ */
+public class TextLayoutPerformance extends Application {
+    private static final int PARAGRAPHS = 20;
+    private static final int PARAGRAPH_LENGTH = 20_000;
+    private static final int LAYOUT_PASSES = 50;
+    private static final int CARET_MOVES = 20_000;
+
+    private static final String[][] CASES = {
+        { "English", "en", "Line breaking long paragraphs should not depend "
+                + "on the number of break opportunities in the text. " },
+        { "Russian", "ru",
+                "Русский текст "
+                + "содержит длинные "
+                + "слова, которые "
+                + "переносятся по "
+                + "правилам. " },
+        { "Thai", "th",
+                "ภาษาไทยไม่มี"
+                + "การเว้นวรรค"
+                + "ระหว่างคำ ทำให้"
+                + "การตัดบรรทัด"
+                + "ต้องใช้พจนานุกรม " },
+        { "Japanese", "ja",
+                "日本語の文章は単語の間に"
+                + "空白を入れずに書かれるため、"
+                + "行分割の規則が異なります。" },
+        { "Arabic", "ar",
+                "النص العربي "
+                + "يكتب من اليمين "
+                + "إلى اليسار ويحتوي "
+                + "على حروف متصلة. " },
+    };
+
+    private static final String SCRIPT =
+            "(function(passes, moves) {"
+            + "  var body = document.body;"
+            + "  var t0 = Date.now();"
+            + "  for (var i = 0; i < passes; i++) {"
+            + "    body.style.width = (300 + (i % 10) * 50) + 'px';"
+            + "    body.offsetHeight;"
+            + "  }"
+            + "  var t1 = Date.now();"
+            + "  var sel = window.getSelection();"
+            + "  sel.collapse(body.firstChild.firstChild, 0);"
+            + "  for (var j = 0; j < moves; j++) {"
+            + "    sel.modify('move', 'forward', 'character');"
+            + "  }"
+            + "  var t2 = Date.now();"
+            + "  return (t1 - t0) + ' ' + (t2 - t1);"
+            + "})(%d, %d)";
+
+    private WebView view;
+    private int caseIndex;
+
+    @Override
+    public void start(Stage primaryStage) {
+        view = new WebView();
+        primaryStage.setScene(new Scene(view, 800, 600));
+        primaryStage.show();
+
+        view.getEngine().getLoadWorker().stateProperty().addListener((ov, o, n) -> {
+            if (n == Worker.State.SUCCEEDED) {
+                // Warm up, then measure.
+                view.getEngine().executeScript(String.format(SCRIPT, 5, 100));
+                String[] times = ((String) view.getEngine().executeScript(
+                        String.format(SCRIPT, LAYOUT_PASSES, CARET_MOVES))).split(" ");
+                System.out.printf("%-10s layout %6s ms (%d passes), caret %6s ms (%d moves)\n",
+                        CASES[caseIndex][0], times[0], LAYOUT_PASSES, times[1], CARET_MOVES);
+                caseIndex++;
+                Platform.runLater(this::next);
+            }
+        });
+        next();
+    }
+
+    private void next() {
+        if (caseIndex == CASES.length) {
+            Platform.exit();
+            return;
+        }
+        view.getEngine().loadContent(createDocument(CASES[caseIndex][1], CASES[caseIndex][2]));
+    }
+
+    private static String createDocument(String language, String sample) {
+        StringBuilder sb = new StringBuilder();
+        sb.append("<!DOCTYPE html><html lang=\"").append(language)
+          .append("\"><body style=\"margin:0\">");
+        for (int i = 0; i < PARAGRAPHS; i++) {
+            sb.append("<p>");
+            int start = sb.length();
+            while (sb.length() - start < PARAGRAPH_LENGTH) {
+                sb.append(sample);
+            }
+            sb.append("</p>");
+        }
+        sb.append("</body></html>");
+        return sb.toString();
+    }
+
+    public static void main(String[] args) {
+        Application.launch(args);
+    }
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package media;
+
+import com.sun.media.jfxmedia.MediaManager;
+import com.sun.media.jfxmedia.MediaPlayer;
+import com.sun.media.jfxmedia.control.VideoDataBuffer;
+import com.sun.media.jfxmedia.control.VideoFormat;
+import com.sun.media.jfxmedia.control.VideoFramePoolStatistics;
+import com.sun.media.jfxmedia.events.NewFrameEvent;
+import com.sun.media.jfxmedia.events.PlayerStateEvent;
+import com.sun.media.jfxmedia.events.PlayerStateListener;
+import com.sun.media.jfxmedia.events.VideoRendererListener;
+import com.sun.media.jfxmedia.locator.Locator;
+import java.io.File;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Plays local video files at the highest playback rate with no renderer
+ * attached and reports how many frames reach the sink per second, how long
+ * the first frame takes and how far frames fall behind their presentation
+ * time. Run it against two builds, or with different libavcodec versions,
+ * to compare decoder throughput. With {@code --convert} every frame is also
+ * converted to BGRA as the renderer does, and the frame pool counters show
+ * how many conversions reused released memory and how much was allocated
+ * after the first second of playback. It uses the internal media API, so it
+ * needs
+ * <pre>
+ * --add-exports javafx.media/com.sun.media.jfxmedia=ALL-UNNAMED
+ * --add-exports javafx.media/com.sun.media.jfxmedia.control=ALL-UNNAMED
+ * --add-exports javafx.media/com.sun.media.jfxmedia.events=ALL-UNNAMED
+ * --add-exports javafx.media/com.sun.media.jfxmedia.locator=ALL-UNNAMED
+ * </pre>
+ * and takes the files to play as arguments, optionally after {@code --convert}.
+ */
+public class VideoDecodePerformance {
+    private static final float RATE = 8.0f;
+    private static final long TIMEOUT_SECONDS = 600;
+
+    private static boolean convert;
+
+    private static final class Counter implements VideoRendererListener, PlayerStateListener {
+        final CountDownLatch done = new CountDownLatch(1);
+        volatile long startNanos;
+        long firstFrameNanos = -1;
+        long lastFrameNanos;
+        double firstTimestamp;
+        double maxLagMillis;
+        int frames;
+        VideoFramePoolStatistics warmPool;
+
+        @Override
+        public synchronized void videoFrameUpdated(NewFrameEvent event) {
+            long now = System.nanoTime();
+            VideoDataBuffer frame = event.getFrameData();
+            double timestamp = frame.getTimestamp();
+            if (convert && frame.getFormat() != VideoFormat.BGRA_PRE) {
+                VideoDataBuffer converted = frame.convertToFormat(VideoFormat.BGRA_PRE);
+                converted.getBufferForPlane(VideoDataBuffer.PACKED_FORMAT_PLANE);
+                converted.releaseFrame();
+            }
+            if (firstFrameNanos < 0) {
+                firstFrameNanos = now;
+                firstTimestamp = timestamp;
+            } else {
+                if (convert && warmPool == null && now - firstFrameNanos >= 1_000_000_000L) {
+                    warmPool = MediaManager.getVideoFramePoolStatistics();
+                }
+                double due = (timestamp - firstTimestamp) * 1000 / RATE;
+                double lag = (now - firstFrameNanos) / 1e6 - due;
+                maxLagMillis = Math.max(maxLagMillis, lag);
+            }
+            lastFrameNanos = now;
+            frames++;
+        }
+
+        @Override public void releaseVideoFrames() {}
+        @Override public void onReady(PlayerStateEvent evt) {}
+        @Override public void onPlaying(PlayerStateEvent evt) {}
+        @Override public void onPause(PlayerStateEvent evt) {}
+        @Override public void onStop(PlayerStateEvent evt) { done.countDown(); }
+        @Override public void onStall(PlayerStateEvent evt) {}
+        @Override public void onFinish(PlayerStateEvent evt) { done.countDown(); }
+        @Override public void onHalt(PlayerStateEvent evt) { done.countDown(); }
+    }
+
+    private static void run(File file) throws Exception {
+        Locator locator = new Locator(file.toURI());
+        locator.init();
+        MediaPlayer player = MediaManager.getPlayer(locator);
+        Counter counter = new Counter();
+        try {
+            player.addMediaPlayerListener(counter);
+            player.getVideoRenderControl().addVideoRendererListener(counter);
+            player.setMute(true);
+            player.setRate(RATE);
+            counter.startNanos = System.nanoTime();
+            player.play();
+            if (!counter.done.await(TIMEOUT_SECONDS, TimeUnit.SECONDS)) {
+                System.out.println(file.getName() + ": timed out");
+            }
+        } finally {
+            player.dispose();
+        }
+
+        synchronized (counter) {
+            if (counter.frames == 0) {
+                System.out.println(file.getName() + ": no frames");
+                return;
+            }
+            double seconds = (counter.lastFrameNanos - counter.firstFrameNanos) / 1e9;
+            System.out.printf("%s: %d frames, %.1f fps, first frame %.1f ms, max lag %.1f ms%n",
+                    file.getName(), counter.frames,
+                    seconds > 0 ? (counter.frames - 1) / seconds : 0.0,
+                    (counter.firstFrameNanos - counter.startNanos) / 1e6,
+                    counter.maxLagMillis);
+            if (counter.warmPool != null) {
+                VideoFramePoolStatistics pool = MediaManager.getVideoFramePoolStatistics();
+                long converted = pool.getFramesConverted() - counter.warmPool.getFramesConverted();
+                long hits = pool.getPoolHits() - counter.warmPool.getPoolHits();
+                System.out.printf("    after 1 s: %d frames converted, %d pool hits, %.1f MB allocated%n",
+                        converted, hits,
+                        (pool.getBytesAllocated() - counter.warmPool.getBytesAllocated()) / 1e6);
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        int first = 0;
+        if (args.length > 0 && args[0].equals("--convert")) {
+            convert = true;
+            first = 1;
+        }
+        if (args.length == first) {
+            System.err.println("Usage: VideoDecodePerformance [--convert] <video file>...");
+            System.exit(1);
+        }
+        for (int i = first; i < args.length; i++) {
+            run(new File(args[i]));
+        }
+        System.exit(0);
+    }
+}
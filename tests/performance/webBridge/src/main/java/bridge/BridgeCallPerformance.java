@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package bridge;
+
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.concurrent.Worker;
+import javafx.scene.web.WebEngine;
+import javafx.stage.Stage;
+import netscape.javascript.JSObject;
+
+/**
+ * Measures the throughput of JavaScript to Java calls through an object
+ * bound with {@code JSObject.setMember}. Run it against two builds to
+ * compare calls per second before and after a change to the bridge.
+ */
+public class BridgeCallPerformance extends Application {
+    private static final int WARMUP_CALLS = 100_000;
+    private static final int CALLS = 1_000_000;
+
+    public static class Sink {
+        private long total;
+
+        public void noArgs() {
+            total++;
+        }
+
+        public void intArg(int value) {
+            total += value;
+        }
+
+        public void mixedArgs(int i, double d, String s) {
+            total += i + (long) d + s.length();
+        }
+
+        public int intResult(int value) {
+            return value + 1;
+        }
+
+        public long getTotal() {
+            return total;
+        }
+    }
+
+    @Override
+    public void start(Stage primaryStage) throws Exception {
+        WebEngine engine = new WebEngine();
+        engine.getLoadWorker().stateProperty().addListener((ov, o, n) -> {
+            if (n == Worker.State.SUCCEEDED) {
+                JSObject window = (JSObject) engine.executeScript("window");
+                window.setMember("sink", new Sink());
+
+                run(engine, "sink.noArgs()");
+                run(engine, "sink.intArg(i)");
+                run(engine, "sink.mixedArgs(i, 0.5, 'abc')");
+                run(engine, "sink.intResult(i)");
+                run(engine, "sink['intArg(int)'](i)");
+
+                Platform.exit();
+            }
+        });
+        engine.loadContent("<html><body></body></html>");
+    }
+
+    private static void run(WebEngine engine, String call) {
+        String loop = "for (var i = 0; i < %d; i++) { " + call + "; }";
+        engine.executeScript(String.format(loop, WARMUP_CALLS));
+
+        long t0 = System.nanoTime();
+        engine.executeScript(String.format(loop, CALLS));
+        long t1 = System.nanoTime();
+
+        double seconds = (t1 - t0) / 1e9;
+        System.out.printf("%-28s %12.0f calls/s\n", call, CALLS / seconds);
+    }
+
+    public static void main(String[] args) {
+        Application.launch(args);
+    }
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.com.sun.pisces;
+
+import com.sun.glass.utils.NativeLibLoader;
+import com.sun.pisces.GradientColorMap;
+import com.sun.pisces.JavaSurface;
+import com.sun.pisces.PiscesRenderer;
+import com.sun.pisces.RendererBase;
+import com.sun.pisces.Transform6;
+import java.util.Random;
+import java.util.function.Consumer;
+import org.junit.BeforeClass;
+import org.junit.Test;
+import static org.junit.Assert.assertArrayEquals;
+
+/**
+ * Checks that fills split across the native worker threads of the software
+ * renderer produce the same pixels as fills rendered on the calling thread.
+ */
+public class PiscesWorkersTest {
+
+    private static final int WIDTH = 613;
+    private static final int HEIGHT = 487;
+    private static final int THREADS = 4;
+
+    private static int[] background;
+    private static byte[] mask;
+    private static int[] texture;
+
+    @BeforeClass
+    public static void setupOnce() {
+        NativeLibLoader.loadLibrary("prism_sw");
+        // Start the workers even on a single processor machine
+        PiscesRenderer.setRenderThreads(THREADS);
+
+        Random random = new Random(20260101L);
+        background = new int[WIDTH * HEIGHT];
+        for (int i = 0; i < background.length; i++) {
+            background[i] = randomPremultiplied(random);
+        }
+        mask = new byte[WIDTH * HEIGHT * 3];
+        random.nextBytes(mask);
+        texture = new int[97 * 61];
+        for (int i = 0; i < texture.length; i++) {
+            texture[i] = randomPremultiplied(random);
+        }
+    }
+
+    private static int randomPremultiplied(Random random) {
+        int a = random.nextInt(256);
+        int r = random.nextInt(a + 1);
+        int g = random.nextInt(a + 1);
+        int b = random.nextInt(a + 1);
+        return (a << 24) | (r << 16) | (g << 8) | b;
+    }
+
+    private static int[] render(int threads, Consumer<PiscesRenderer> fill) {
+        JavaSurface surface = new JavaSurface(background.clone(), RendererBase.TYPE_INT_ARGB_PRE,
+                WIDTH, HEIGHT);
+        PiscesRenderer renderer = new PiscesRenderer(surface);
+        PiscesRenderer.setRenderThreads(threads);
+        try {
+            fill.accept(renderer);
+        } finally {
+            PiscesRenderer.setRenderThreads(THREADS);
+        }
+        int[] pixels = new int[WIDTH * HEIGHT];
+        surface.getRGB(pixels, 0, WIDTH, 0, 0, WIDTH, HEIGHT);
+        return pixels;
+    }
+
+    private static void checkSerialOutput(Consumer<PiscesRenderer> fill) {
+        int[] threaded = render(THREADS, fill);
+        int[] serial = render(1, fill);
+        assertArrayEquals(serial, threaded);
+        // again, now that the workers are running
+        assertArrayEquals(serial, render(THREADS, fill));
+    }
+
+    // A rectangle with fractional edges, in 16.16 coordinates
+    private static void fillRect(PiscesRenderer renderer) {
+        renderer.fillRect(0x28000, 0x1c000, (WIDTH - 5) << 16, (HEIGHT - 3) << 16);
+    }
+
+    private static Transform6 scale(double s) {
+        int m = (int) (s * 0x10000);
+        return new Transform6(m, 0, 0, m, 0x8000, 0x4000);
+    }
+
+    @Test
+    public void testColorFill() {
+        checkSerialOutput(r -> {
+            r.setColor(40, 120, 200, 170);
+            fillRect(r);
+        });
+    }
+
+    @Test
+    public void testColorFillSrc() {
+        checkSerialOutput(r -> {
+            r.setCompositeRule(RendererBase.COMPOSITE_SRC);
+            r.setColor(200, 30, 90, 120);
+            fillRect(r);
+        });
+    }
+
+    @Test
+    public void testGradientFill() {
+        checkSerialOutput(r -> {
+            r.setLinearGradient(0, 0, WIDTH << 16, HEIGHT << 16,
+                    new int[] { 0, 0x8000, 0x10000 },
+                    new int[] { 0x80ff0000, 0xff00ff00, 0x400000ff },
+                    GradientColorMap.CYCLE_REFLECT, null);
+            fillRect(r);
+        });
+    }
+
+    @Test
+    public void testRadialGradientFill() {
+        checkSerialOutput(r -> {
+            r.setRadialGradient(WIDTH << 15, HEIGHT << 15, WIDTH << 14, HEIGHT << 14, 150 << 16,
+                    new int[] { 0, 0x10000 },
+                    new int[] { 0xffffffff, 0x80203040 },
+                    GradientColorMap.CYCLE_REPEAT, null);
+            fillRect(r);
+        });
+    }
+
+    @Test
+    public void testTextureFill() {
+        checkSerialOutput(r -> {
+            r.setTexture(RendererBase.TYPE_INT_ARGB_PRE, texture, 97, 61, 97,
+                    scale(0.37), true, true, true);
+            fillRect(r);
+        });
+    }
+
+    @Test
+    public void testAlphaMask() {
+        checkSerialOutput(r -> {
+            r.setColor(10, 220, 130, 230);
+            r.fillAlphaMask(mask, 3, 2, WIDTH - 7, HEIGHT - 4, 0, WIDTH - 7);
+        });
+    }
+
+    @Test
+    public void testAlphaMaskSrc() {
+        checkSerialOutput(r -> {
+            r.setCompositeRule(RendererBase.COMPOSITE_SRC);
+            r.setColor(250, 20, 60, 90);
+            r.fillAlphaMask(mask, 0, 0, WIDTH, HEIGHT, 0, WIDTH);
+        });
+    }
+
+    @Test
+    public void testLCDAlphaMask() {
+        checkSerialOutput(r -> {
+            r.setLCDGammaCorrection(1.4f);
+            r.setColor(30, 30, 30, 255);
+            // three bytes per pixel
+            r.fillLCDAlphaMask(mask, 1, 1, 3 * (WIDTH - 2), HEIGHT - 2, 0, 3 * (WIDTH - 2));
+        });
+    }
+}
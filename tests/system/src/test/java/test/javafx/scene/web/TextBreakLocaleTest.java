@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+package test.javafx.scene.web;
+
+import static javafx.concurrent.Worker.State.SUCCEEDED;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+import java.util.Locale;
+import java.util.concurrent.CountDownLatch;
+
+import javafx.application.Application;
+import javafx.application.Platform;
+import javafx.scene.Scene;
+import javafx.scene.web.WebView;
+import javafx.stage.Stage;
+
+import org.junit.AfterClass;
+import org.junit.Before;
+import org.junit.BeforeClass;
+import org.junit.Test;
+
+import test.util.Util;
+
+/**
+ * Tests WebKit's text break iterators under a non-English default locale.
+ * WebKit reads the default locale once, so it is set before the toolkit
+ * starts; the -u- extension checks that a BCP 47 tag with keywords still
+ * reaches ICU as a valid locale ID.
+ */
+public class TextBreakLocaleTest {
+    private static final CountDownLatch launchLatch = new CountDownLatch(1);
+
+    // "Hello" and "welcome" in Thai, written without a space between words
+    private static final String THAI_TEXT = "สวัสดีครับ";
+
+    private static Locale defaultLocale;
+
+    private static TextBreakLocaleTestApp textBreakLocaleTestApp;
+
+    private WebView webView;
+
+    public static class TextBreakLocaleTestApp extends Application {
+        private Stage primaryStage = null;
+
+        @Override
+        public void init() {
+            TextBreakLocaleTest.textBreakLocaleTestApp = this;
+        }
+
+        @Override
+        public void start(Stage primaryStage) throws Exception {
+            Platform.setImplicitExit(false);
+            this.primaryStage = primaryStage;
+            launchLatch.countDown();
+        }
+    }
+
+    @BeforeClass
+    public static void setupOnce() {
+        defaultLocale = Locale.getDefault();
+        Locale.setDefault(Locale.forLanguageTag("th-TH-u-nu-thai"));
+        Util.launch(launchLatch, TextBreakLocaleTestApp.class);
+    }
+
+    @AfterClass
+    public static void tearDownOnce() {
+        Util.shutdown();
+        Locale.setDefault(defaultLocale);
+    }
+
+    @Before
+    public void setupTestObjects() {
+        final CountDownLatch loadLatch = new CountDownLatch(1);
+        Util.runAndWait(() -> {
+            webView = new WebView();
+            textBreakLocaleTestApp.primaryStage.setScene(new Scene(webView, 400, 300));
+            textBreakLocaleTestApp.primaryStage.show();
+            webView.getEngine().getLoadWorker().stateProperty().
+                addListener((observable, oldValue, newValue) -> {
+                if (newValue == SUCCEEDED) {
+                    loadLatch.countDown();
+                }
+            });
+            webView.getEngine().loadContent("<body><p id='text'>" + THAI_TEXT + "</p></body>");
+        });
+        assertTrue("Timeout waiting for succeeded state", Util.await(loadLatch));
+    }
+
+    @Test public void testWordBreakInThaiText() {
+        Util.runAndWait(() -> {
+            Object word = webView.getEngine().executeScript(
+                    "var text = document.getElementById('text').firstChild;" +
+                    "var selection = window.getSelection();" +
+                    "selection.collapse(text, 0);" +
+                    "selection.modify('extend', 'forward', 'word');" +
+                    "selection.toString()");
+            String selected = String.valueOf(word);
+            assertTrue("Word was empty", selected.length() > 0);
+            assertTrue("Word was not broken inside the Thai run: " + selected,
+                    selected.length() < THAI_TEXT.length());
+            assertTrue("Word was not a prefix of the text: " + selected,
+                    THAI_TEXT.startsWith(selected));
+        });
+    }
+
+    @Test public void testLineBreakInThaiText() {
+        Util.runAndWait(() -> {
+            Object lines = webView.getEngine().executeScript(
+                    "var text = document.getElementById('text');" +
+                    "var oneLine = text.offsetHeight;" +
+                    "text.style.width = '1px';" +
+                    "text.offsetHeight / oneLine");
+            assertTrue("Thai text was not broken into lines: " + lines,
+                    ((Number) lines).doubleValue() > 1);
+        });
+    }
+
+    @Test public void testFindInThaiText() {
+        Util.runAndWait(() -> {
+            Object found = webView.getEngine().executeScript(
+                    "window.find('ครับ')");
+            assertEquals("Thai word was not found", Boolean.TRUE, found);
+        });
+    }
+}